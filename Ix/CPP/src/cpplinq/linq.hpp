@@ -34,6 +34,18 @@
 /// 
 /// 
 /// 
+/// from(std::move(container))
+/// ============================
+/// -   Result: Query
+/// -   Powers: input
+/// 
+/// Construct a new query that owns the collection. Elements are moved out of the collection as 
+/// they are read, so the query should be run once. Functions that only inspect an element, such 
+/// as the predicate of `where`, are given an lvalue, and `to_vector` or `groupby` at the end of 
+/// the query move the elements into their storage.
+/// 
+/// 
+/// 
 /// from(iter, iter)
 /// ================
 /// -   Result: Query
@@ -63,11 +75,125 @@
 /// 
 /// 
 /// 
-/// query.groupby(keymap [, keyequal])
-/// ====================================
+/// query.groupby(keymap [, keyhash, keyequal])
+/// ==============================================
 /// Result: Query of groups. Each group has a 'key' field, and is a query of elements from the input.
 /// Powers: forward
 /// 
+/// Groups are found by a hash of the key, `std::hash` unless keyhash is given. The input is read 
+/// lazily: moving to the next group or the next element of a group reads only as far into the 
+/// input as is needed to find it. Elements read so far are copied into their groups.
+/// 
+/// 
+/// 
+/// query.groupby_adjacent(keymap [, keyequal])
+/// ==============================================
+/// Result: Query of groups. Each group has a 'key' field, and is a query of elements from the input.
+/// Powers: forward
+/// 
+/// Each run of adjacent elements with equal keys forms a group, so input ordered by key groups 
+/// as with groupby. Groups do not store elements and the memory used does not depend on the 
+/// length of the input. Requires forward input.
+/// 
+/// 
+/// 
+/// query.order_by(keymap [, less]), query.order_by_descending(keymap [, less])
+/// ==============================================================================
+/// -   Result: Ordered query
+/// -   Powers: random access
+/// 
+/// Sorts the input by `keymap(x)`, using `less` when given. The sort is stable. Elements are 
+/// collected when the query is enumerated, and an index of their positions is sorted, so 
+/// elements are not moved. `query.order_by(keymap).take(n)` sorts only the first `n` elements.
+/// 
+/// 
+/// 
+/// query.then_by(keymap [, less]), query.then_by_descending(keymap [, less])
+/// ============================================================================
+/// -   Result: Ordered query
+/// -   Powers: random access
+/// 
+/// Only available on an ordered query. Orders elements with equal keys in the preceding ordering 
+/// by `keymap(x)`. All keys are compared in a single sort.
+/// 
+/// 
+/// 
+/// query.distinct([hash, equal])
+/// ================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// The elements of the input, leaving out any element equal to an earlier one. Elements seen so 
+/// far are kept in a hash set, `std::hash` and `==` unless hash and equal are given. Each copy 
+/// of a cursor holds its own copy of the set.
+/// 
+/// 
+/// 
+/// query.union_with(second [, hash, equal])
+/// ==========================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// The distinct elements of the input followed by those of `second` not already produced. 
+/// 
+/// 
+/// 
+/// query.intersect(second [, hash, equal]), query.except(second [, hash, equal])
+/// ================================================================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// The distinct elements of the input that are (intersect) or are not (except) in `second`, in 
+/// input order. A hash set is built from `second`, or from the input when both are random access 
+/// and the input is smaller, and the input is then streamed against the set.
+/// 
+/// 
+/// 
+/// query.join(inner, outerkey, innerkey, result)
+/// ================================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// For each element `x` of the input and each element `y` of `inner` where `outerkey(x)` equals 
+/// `innerkey(y)`, computes `result(x, y)`. `inner` is read into a hash index of its keys, and the 
+/// input is streamed against it.
+/// 
+/// 
+/// 
+/// query.group_join(inner, outerkey, innerkey, result)
+/// =====================================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// For each element `x` of the input, computes `result(x, g)` where `g` is the group of elements 
+/// `y` of `inner` with `innerkey(y)` equal to `outerkey(x)`. `g` has a 'key' field, is a query of 
+/// elements and may be empty.
+/// 
+/// 
+/// 
+/// query.merge_join(inner, outerkey, innerkey, result [, less])
+/// ==============================================================
+/// -   Result: Query
+/// -   Powers: forward
+/// 
+/// Same result as join, for an input and `inner` that are both ordered by key according to `less`. 
+/// Walks both sequences together without storing elements. Requires forward `inner`.
+/// 
+/// 
+/// 
+/// query.parallel([threads])
+/// ============================
+/// -   Result: Parallel query
+/// 
+/// Only available on random access queries. Splits the input into `threads` consecutive 
+/// partitions, one per hardware thread when `threads` is 0. The parallel query supports 
+/// `where` and `select`, which run on every partition, and the terminal operators `aggregate`, 
+/// `count`, `sum` and `to_vector`, which run each partition on a thread of its own and merge the 
+/// results in partition order. `aggregate(fn)` also merges partitions with `fn`, and 
+/// `aggregate(seed, fn, combine)` merges partitions with `combine`.
+/// 
+/// Functions given to a parallel query are called from several threads at once.
+/// 
 /// 
 /// 
 /// query.any([pred])
@@ -109,6 +235,70 @@
 /// Note: begin() takes O(n) time when input iteration power is weaker than random access.
 /// 
 /// 
+/// query.take_while(pred)
+/// ======================
+/// -   Result: query
+/// -   Powers: input, forward
+/// 
+/// Returns the leading elements of the original sequence for which `pred(element)` is true. The input 
+/// is not read past the first element for which `pred` is false, and `pred` is called once per element.
+/// 
+/// 
+/// 
+/// query.skip_while(pred)
+/// ======================
+/// -   Result: query
+/// -   Powers: input, forward, bidirectional, random access
+/// 
+/// Returns the elements of the original sequence from the first element for which `pred(element)` is 
+/// false.
+/// 
+/// Note: begin() takes O(n) time, as the leading elements are tested when the cursor is requested.
+/// 
+/// 
+/// 
+/// query.zip(second, map)
+/// ===========================
+/// -   Result: Query
+/// -   Powers: input, forward, bidirectional, random access
+/// 
+/// Computes `map(x, y)` for the elements `x` of the input and `y` of `second` at each position, up to 
+/// the length of the shorter sequence. Both sequences are read in lockstep.
+/// 
+/// 
+/// 
+/// query.sequence_equal(second [, equal])
+/// ========================================
+/// -   Result: bool
+/// 
+/// Returns true if both sequences have the same length and equal elements at each position. Stops 
+/// at the first difference. Random access sequences of different sizes are unequal without reading 
+/// them, and vectors or arrays of the same integral type are compared with `memcmp` when `equal` 
+/// is not given.
+/// 
+/// 
+/// 
+/// query.sum([map]), query.average([map])
+/// =========================================
+/// -   Result: element, or double for average of integral elements
+/// 
+/// (Zero-argument) Returns the sum or mean of the elements. sum returns `element_type()` on an
+/// empty sequence, average throws.
+/// 
+/// (One-argument) Equivalent to `query.select(map).sum()` and `query.select(map).average()`.
+/// 
+/// When the query reads a vector or array of arithmetic elements directly, sum runs over the 
+/// memory with several partial sums, which may round floating point sums differently.
+/// 
+/// 
+/// 
+/// query.min([less]), query.max([less])
+/// ======================================
+/// -   Result: element
+/// 
+/// Returns the first least or greatest element. Throws on an empty sequence. Requires forward input.
+/// 
+/// 
 /// 
 /// query.count([pred])
 /// ===================
@@ -117,7 +307,7 @@
 /// _TODO: should use inner container's iterator distance type instead._
 /// 
 /// (Zero-argument) Returns the number of elements in the range. 
-/// Equivalent to `std::distance(query.begin(), query.end())`
+/// Equivalent to `std::distance(query.begin(), query.end())`, but takes constant time on random access input.
 /// 
 /// (One-argument) Returns the number of elements for whicht `pred(element)` is true.
 /// Equivalent to `query.where(pred).count()`
@@ -138,12 +328,18 @@
 #include <iterator>
 #include <algorithm>
 #include <numeric>
+#include <deque>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <utility>
 #include <type_traits>
 #include <vector>
+#include <cstring>
+#include <thread>
+#include <exception>
 
 
 
@@ -174,8 +370,14 @@
 #include "linq_take.hpp"
 #include "linq_skip.hpp"
 #include "linq_groupby.hpp"
+#include "linq_orderby.hpp"
+#include "linq_setops.hpp"
+#include "linq_join.hpp"
+#include "linq_parallel.hpp"
 #include "linq_where.hpp"
 #include "linq_last.hpp"
+#include "linq_numeric.hpp"
+#include "linq_zip.hpp"
 #include "linq_selectmany.hpp"
 
 
@@ -212,6 +414,16 @@ namespace detail {
     };
 }
 
+template <class Collection>
+class linq_driver;
+
+namespace detail {
+    template <class T>
+    struct is_linq_driver : std::false_type {};
+    template <class Collection>
+    struct is_linq_driver<linq_driver<Collection>> : std::true_type {};
+}
+
 template <class Collection>
 class linq_driver
 {
@@ -224,6 +436,8 @@ public:
         iterator;
 
     linq_driver(Collection c) : c(c) {}
+    linq_driver(const linq_driver& other) : c(other.c) {}
+    linq_driver(linq_driver&& other) : c(std::move(other.c)) {}
 
 
     // -------------------- linq core methods --------------------
@@ -234,9 +448,55 @@ public:
         return linq_groupby<Collection, KeyFn>(c, std::move(fn) );
     }
 
-    // TODO: groupby(keyfn, eq)
+    template <class KeyFn, class Hash, class Equal>
+    linq_driver< linq_groupby<Collection, KeyFn, Hash, Equal> > groupby(KeyFn fn, Hash hash, Equal equal)
+    {
+        return linq_groupby<Collection, KeyFn, Hash, Equal>(c, std::move(fn), std::move(hash), std::move(equal) );
+    }
+
+    template <class KeyFn>
+    linq_driver< linq_groupby_adjacent<Collection, KeyFn> > groupby_adjacent(KeyFn fn)
+    {
+        return linq_groupby_adjacent<Collection, KeyFn>(c, std::move(fn) );
+    }
 
-    // TODO: join...
+    template <class KeyFn, class Equal>
+    linq_driver< linq_groupby_adjacent<Collection, KeyFn, Equal> > groupby_adjacent(KeyFn fn, Equal equal)
+    {
+        return linq_groupby_adjacent<Collection, KeyFn, Equal>(c, std::move(fn), std::move(equal) );
+    }
+
+    template <class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn>
+    linq_driver< linq_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn> > 
+        join(const linq_driver<Inner>& inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result) const
+    {
+        return linq_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn>(
+            c, inner, std::move(outerKey), std::move(innerKey), std::move(result));
+    }
+
+    template <class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn>
+    linq_driver< linq_group_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn> > 
+        group_join(const linq_driver<Inner>& inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result) const
+    {
+        return linq_group_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn>(
+            c, inner, std::move(outerKey), std::move(innerKey), std::move(result));
+    }
+
+    template <class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn>
+    linq_driver< linq_merge_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn> > 
+        merge_join(const linq_driver<Inner>& inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result) const
+    {
+        return linq_merge_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn>(
+            c, inner, std::move(outerKey), std::move(innerKey), std::move(result));
+    }
+
+    template <class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn, class Less>
+    linq_driver< linq_merge_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn, Less> > 
+        merge_join(const linq_driver<Inner>& inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result, Less less) const
+    {
+        return linq_merge_join<Collection, linq_driver<Inner>, OuterKeyFn, InnerKeyFn, ResultFn, Less>(
+            c, inner, std::move(outerKey), std::move(innerKey), std::move(result), std::move(less));
+    }
 
     template <class Selector>
     linq_driver< linq_select<Collection, Selector> > select(Selector sel) const {
@@ -296,7 +556,25 @@ public:
         return it == end();
     }
 
-    // TODO: average
+    // integral elements are averaged as double
+    typename std::conditional<std::is_integral<element_type>::value, double, element_type>::type
+        average() const
+    {
+        typedef typename std::conditional<std::is_integral<element_type>::value, double, element_type>::type
+            result_type;
+        auto n = count();
+        if (n == 0) 
+            throw std::logic_error("average performed on empty range");
+
+        return static_cast<result_type>(sum()) / static_cast<result_type>(n);
+    }
+
+    template <class Selector>
+    auto average(Selector sel) const
+    -> decltype(std::declval<const linq_driver<linq_select<Collection, Selector>>&>().average())
+    {
+        return this->select(std::move(sel)).average();
+    }
 
 #if !defined(__clang__)
     // Clang complains that linq_driver is not complete until the closing brace 
@@ -316,7 +594,7 @@ public:
     }
 
     typename std::iterator_traits<iterator>::difference_type count() const {
-        return std::distance(begin(), end());
+        return linq_count_(c.get_cursor(), typename Collection::cursor::cursor_category());
     }
 
     template <class Predicate>
@@ -327,35 +605,49 @@ public:
 
     // TODO: default_if_empty
     
-    // TODO: distinct()
-    // TODO: distinct(cmp)
+    linq_driver< linq_distinct<Collection> > distinct() const
+    {
+        return linq_distinct<Collection>(c);
+    }
+
+    template <class Hash, class Equal>
+    linq_driver< linq_distinct<Collection, Hash, Equal> > distinct(Hash hash, Equal equal) const
+    {
+        return linq_distinct<Collection, Hash, Equal>(c, std::move(hash), std::move(equal));
+    }
 
     reference_type element_at(size_t ix) const {
         auto cur = c.get_cursor();
-        while(ix && !cur.empty()) {
-            cur.inc();
-            --ix;
+        if (!linq_advance_(cur, ix, typename Collection::cursor::cursor_category())) { 
+            throw std::logic_error("index out of bounds"); 
         }
-        if (cur.empty()) { throw std::logic_error("index out of bounds"); }
-        else             { return cur.get(); }
+        return cur.get();
     }
 
     element_type element_at_or_default(size_t ix) const {
         auto cur = c.get_cursor();
-        while(ix && !cur.empty()) {
-            cur.inc();
-            -- ix;
+        if (!linq_advance_(cur, ix, typename Collection::cursor::cursor_category())) { 
+            return element_type(); 
         }
-        if (cur.empty()) { return element_type(); }
-        else             { return cur.get(); }
+        return cur.get();
     }
 
     bool empty() const {
         return !this->any();
     }
 
-    // TODO: except(second)
-    // TODO: except(second, eq)
+    template <class Second>
+    linq_driver< linq_except<Collection, linq_driver<Second>> > except(const linq_driver<Second>& second) const
+    {
+        return linq_except<Collection, linq_driver<Second>>(c, second);
+    }
+
+    template <class Second, class Hash, class Equal>
+    linq_driver< linq_except<Collection, linq_driver<Second>, Hash, Equal> > 
+        except(const linq_driver<Second>& second, Hash hash, Equal equal) const
+    {
+        return linq_except<Collection, linq_driver<Second>, Hash, Equal>(c, second, std::move(hash), std::move(equal));
+    }
 
     reference_type first() const {
         auto cur = c.get_cursor();
@@ -366,7 +658,7 @@ public:
     template <class Predicate>
     reference_type first(Predicate pred) const {
         auto cur = c.get_cursor();
-        while (!cur.empty() && !pred(cur.get())) {
+        while (!cur.empty() && !pred(util::as_lvalue(cur.get()))) {
             cur.inc();
         }
         if (cur.empty()) { throw std::logic_error("index out of bounds"); }
@@ -382,15 +674,25 @@ public:
     template <class Predicate>
     element_type first_or_default(Predicate pred) const {
         auto cur = c.get_cursor();
-        while (!cur.empty() && !pred(cur.get())) {
+        while (!cur.empty() && !pred(util::as_lvalue(cur.get()))) {
             cur.inc();
         }
         if (cur.empty()) { return element_type(); }
         else             { return cur.get(); }
     }
     
-    // TODO: intersect(second)
-    // TODO: intersect(second, eq)
+    template <class Second>
+    linq_driver< linq_intersect<Collection, linq_driver<Second>> > intersect(const linq_driver<Second>& second) const
+    {
+        return linq_intersect<Collection, linq_driver<Second>>(c, second);
+    }
+
+    template <class Second, class Hash, class Equal>
+    linq_driver< linq_intersect<Collection, linq_driver<Second>, Hash, Equal> > 
+        intersect(const linq_driver<Second>& second, Hash hash, Equal equal) const
+    {
+        return linq_intersect<Collection, linq_driver<Second>, Hash, Equal>(c, second, std::move(hash), std::move(equal));
+    }
 
     // note: forward cursors and beyond can provide a clone, so we can refer to the element directly
     typename std::conditional< 
@@ -431,11 +733,7 @@ public:
     template <class Compare>
     reference_type max(Compare less) const
     {
-        auto it = std::max_element(begin(), end(), less);
-        if (it == end()) 
-            throw std::logic_error("max performed on empty range");
-
-        return *it;
+        return linq_max_(c.get_cursor(), less);
     }
 
     reference_type min() const
@@ -446,20 +744,47 @@ public:
     template <class Compare>
     reference_type min(Compare less) const
     {
-        auto it = std::min_element(begin(), end(), less);
-        if (it == end()) 
-            throw std::logic_error("max performed on empty range");
+        return linq_min_(c.get_cursor(), less);
+    }
+
+    template <class KeyFn>
+    linq_driver< linq_orderby<Collection, detail::key_order<KeyFn, default_less>> > order_by(KeyFn fn) const
+    {
+        return order_by(std::move(fn), default_less());
+    }
 
-        return *it;
+    template <class KeyFn, class Less>
+    linq_driver< linq_orderby<Collection, detail::key_order<KeyFn, Less>> > order_by(KeyFn fn, Less less) const
+    {
+        typedef detail::key_order<KeyFn, Less> order;
+        return linq_orderby<Collection, order>(c, order(std::move(fn), std::move(less)));
     }
 
-    // TODO: order_by(sel)
-    // TODO: order_by(sel, less)
-    // TODO: order_by_descending(sel)
-    // TODO: order_by_descending(sel, less)
+    template <class KeyFn>
+    linq_driver< linq_orderby<Collection, detail::key_order<KeyFn, detail::reverse_less<default_less>>> > 
+        order_by_descending(KeyFn fn) const
+    {
+        return order_by(std::move(fn), detail::reverse_less<default_less>(default_less()));
+    }
 
-    // TODO: sequence_equal(second)
-    // TODO: sequence_equal(second, eq)
+    template <class KeyFn, class Less>
+    linq_driver< linq_orderby<Collection, detail::key_order<KeyFn, detail::reverse_less<Less>>> > 
+        order_by_descending(KeyFn fn, Less less) const
+    {
+        return order_by(std::move(fn), detail::reverse_less<Less>(std::move(less)));
+    }
+
+    template <class Second>
+    bool sequence_equal(const linq_driver<Second>& second) const
+    {
+        return linq_sequence_equal_(c.get_cursor(), second.get_cursor(), default_equality());
+    }
+
+    template <class Second, class Equal>
+    bool sequence_equal(const linq_driver<Second>& second, Equal equal) const
+    {
+        return linq_sequence_equal_(c.get_cursor(), second.get_cursor(), std::move(equal));
+    }
 
     // TODO: single / single_or_default
 
@@ -467,30 +792,110 @@ public:
         return linq_skip<Collection>(c, n);
     }
 
-    // TODO: skip_while(pred)
+    template <class Predicate>
+    linq_driver<linq_skip_while<Collection, Predicate>> skip_while(Predicate pred) const {
+        return linq_skip_while<Collection, Predicate>(c, std::move(pred));
+    }
 
-    // TODO: sum
+    // returns element_type() on an empty range
+    element_type sum() const
+    {
+        return linq_sum_(c.get_cursor());
+    }
+
+    template <class Selector>
+    auto sum(Selector sel) const
+    -> decltype(std::declval<const linq_driver<linq_select<Collection, Selector>>&>().sum())
+    {
+        return this->select(std::move(sel)).sum();
+    }
 
     linq_driver<linq_take<Collection>> take(size_t n) const {
         return linq_take<Collection>(c, n);
     }
 
-    // TODO: take_while
+    template <class Predicate>
+    linq_driver<linq_take_while<Collection, Predicate>> take_while(Predicate pred) const {
+        return linq_take_while<Collection, Predicate>(c, std::move(pred));
+    }
+
+    // then_by is only available on ordered queries. C defers the 
+    //   lookup of Collection::then_by until then_by is called.
+    template <class KeyFn, class C = Collection>
+    auto then_by(KeyFn fn) const
+    -> linq_driver<decltype(std::declval<const C&>().then_by(fn, default_less()))>
+    {
+        return c.then_by(std::move(fn), default_less());
+    }
+
+    template <class KeyFn, class Less, class C = Collection>
+    auto then_by(KeyFn fn, Less less) const
+    -> linq_driver<decltype(std::declval<const C&>().then_by(fn, less))>
+    {
+        return c.then_by(std::move(fn), std::move(less));
+    }
+
+    template <class KeyFn, class C = Collection>
+    auto then_by_descending(KeyFn fn) const
+    -> linq_driver<decltype(std::declval<const C&>().then_by(fn, detail::reverse_less<default_less>(default_less())))>
+    {
+        return c.then_by(std::move(fn), detail::reverse_less<default_less>(default_less()));
+    }
 
-    // TODO: then_by / then_by_descending ?
+    template <class KeyFn, class Less, class C = Collection>
+    auto then_by_descending(KeyFn fn, Less less) const
+    -> linq_driver<decltype(std::declval<const C&>().then_by(fn, detail::reverse_less<Less>(less)))>
+    {
+        return c.then_by(std::move(fn), detail::reverse_less<Less>(std::move(less)));
+    }
 
     // TODO: to_...
 
-    // TODO: union(second)
-    // TODO: union(eq)
+    // note: 'union' is a keyword
+    template <class Second>
+    linq_driver< linq_union<Collection, linq_driver<Second>> > union_with(const linq_driver<Second>& second) const
+    {
+        return linq_union<Collection, linq_driver<Second>>(c, second);
+    }
 
-    // TODO: zip
+    template <class Second, class Hash, class Equal>
+    linq_driver< linq_union<Collection, linq_driver<Second>, Hash, Equal> > 
+        union_with(const linq_driver<Second>& second, Hash hash, Equal equal) const
+    {
+        return linq_union<Collection, linq_driver<Second>, Hash, Equal>(c, second, std::move(hash), std::move(equal));
+    }
+
+    template <class Second, class Selector>
+    linq_driver< linq_zip<Collection, linq_driver<Second>, Selector> > 
+        zip(const linq_driver<Second>& second, Selector sel) const
+    {
+        return linq_zip<Collection, linq_driver<Second>, Selector>(c, second, std::move(sel));
+    }
     
+    // -------------------- parallel execution --------------------
+
+    // threads == 0 uses one thread per hardware thread
+    linq_parallel<Collection> parallel(size_t threads = 0) const
+    {
+        return linq_parallel<Collection>(c, detail::build_identity(), threads);
+    }
+
     // -------------------- conversion methods --------------------
 
+    // reads the cursor once. elements the cursor gives up, or produces as 
+    //   values, are moved into the vector rather than copied.
     std::vector<typename Collection::cursor::element_type> to_vector() const 
     {
-        return std::vector<typename Collection::cursor::element_type>(begin(), end());
+        auto cur = c.get_cursor();
+        std::vector<typename Collection::cursor::element_type> result;
+        size_t size = detail::known_size(cur);
+        if (size != size_t(-1)) {
+            result.reserve(size);
+        }
+        for (; !cur.empty(); cur.inc()) {
+            result.push_back(cur.get());
+        }
+        return result;
     }
 
     // -------------------- container/range methods --------------------
@@ -498,6 +903,7 @@ public:
     iterator begin() const  { auto cur = c.get_cursor(); return !cur.empty() ? iterator(cur) : iterator(); }
     iterator end() const    { return iterator(); }
     linq_driver& operator=(const linq_driver& other) { c = other.c; return *this; }
+    linq_driver& operator=(linq_driver&& other) { c = std::move(other.c); return *this; }
     template <class TC2> 
     linq_driver& operator=(const linq_driver<TC2>& other) { c = other.c; return *this; }
 
@@ -509,7 +915,7 @@ public:
     // -------------------- collection methods (leaky abstraction) --------------------
 
     typedef typename Collection::cursor cursor;
-    cursor get_cursor() { return c.get_cursor(); }
+    cursor get_cursor() const { return c.get_cursor(); }
 
     linq_driver< dynamic_collection<typename Collection::cursor::reference_type> >
         late_bind() const
@@ -522,10 +928,26 @@ private:
 };
  
 // TODO: should probably use reference-wrapper instead? 
+namespace detail {
+    template <class Iter>
+    iter_cursor<Iter> container_cursor_(Iter start, Iter finish, size_t, random_access_cursor_tag)
+    {
+        return iter_cursor<Iter>(start, finish);
+    }
+    // the size of the container is the size hint of a cursor that cannot 
+    //   measure itself
+    template <class Iter>
+    iter_cursor<Iter> container_cursor_(Iter start, Iter finish, size_t count, onepass_cursor_tag)
+    {
+        return count != size_t(-1) ? iter_cursor<Iter>::counted(start, finish, count) : iter_cursor<Iter>(start, finish);
+    }
+}
+
 template <class TContainer>
 linq_driver<iter_cursor<typename util::container_traits<TContainer>::iterator>> from(TContainer& c)
 { 
-    auto cur = iter_cursor<typename util::container_traits<TContainer>::iterator>(begin(c), end(c));
+    typedef typename util::container_traits<TContainer>::iterator iterator;
+    auto cur = detail::container_cursor_(begin(c), end(c), detail::container_size(c, 0), typename iter_cursor<iterator>::cursor_category());
     return cur;
 }
 template <class T>
@@ -533,6 +955,15 @@ const linq_driver<T>& from(const linq_driver<T>& c)
 { 
     return c; 
 }
+// Construct a new query that owns the container. The query moves elements 
+//   out of the container as it reads them, so it should be run once.
+template <class TContainer>
+typename std::enable_if<!std::is_reference<TContainer>::value && !detail::is_linq_driver<TContainer>::value,
+    linq_driver<owned_collection<TContainer>>>::type 
+    from(TContainer&& c)
+{
+    return owned_collection<TContainer>(std::move(c));
+}
 template <class Iter>
 linq_driver<iter_cursor<Iter>> from(Iter start, Iter finish)
 {
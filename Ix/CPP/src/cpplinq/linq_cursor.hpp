@@ -41,14 +41,20 @@
 /// Random access cursor
 /// ====================
 /// -   skip(cur, n)
-/// -   position(cur) -> n
-/// -   size(cur)     -> n
+/// -   position(cur) -> n   : elements between the 'begin' point and the current element
+/// -   size(cur)     -> n   : elements from the 'begin' point on, so size - position remain
 /// -   truncate(n)         : keep only n more elements
 /// 
+/// Any cursor may also define
+/// -   size_hint(cur) -> size_hint : how many elements remain, exactly or at most, when that is 
+///                        known without walking the cursor. random access cursors know theirs 
+///                        from size and position.
+/// 
 /// As well, cursors must define the appropriate type/typedefs:
 /// -   cursor_category  :: { onepass_cursor_tag, forward_cursor_tag, bidirectional_cursor_tag, random_access_cursor_tag }
 /// -   element_type
-/// -   reference_type   : if writable, element_type& or such. else, == element_type
+/// -   reference_type   : if writable, element_type& or such. element_type&& if the cursor gives up 
+///                        its elements as it reads them. else, == element_type
 /// -   
 
 
@@ -69,6 +75,59 @@ namespace cpplinq {
 
 
 
+    // how many elements a cursor has left, when that is known without walking it: 
+    //   exactly size, at most size, or unknown
+    struct size_hint
+    {
+        enum kind_type { unknown, at_most, exact };
+
+        size_hint() : kind(unknown), size(0) {}
+        size_hint(kind_type kind, size_t size) : kind(kind), size(size) {}
+
+        static size_hint exactly(size_t n) { return size_hint(exact, n); }
+        static size_hint up_to(size_t n) { return size_hint(at_most, n); }
+
+        bool is_exact() const { return kind == exact; }
+        bool is_known() const { return kind != unknown; }
+
+        // the hint once at most n elements are taken
+        size_hint taken(size_t n) const {
+            if (kind == unknown) { return up_to(n); }
+            return size_hint(kind, (std::min)(size, n));
+        }
+        // the hint once some elements may be dropped
+        size_hint filtered() const {
+            return kind == unknown ? *this : up_to(size);
+        }
+
+        kind_type kind;
+        size_t size;
+    };
+
+    namespace detail
+    {
+        template <class Cursor>
+        size_hint get_size_hint_(const Cursor&, onepass_cursor_tag) { return size_hint(); }
+
+        template <class Cursor>
+        size_hint get_size_hint_(const Cursor& cur, random_access_cursor_tag) { return size_hint::exactly(cur.size() - cur.position()); }
+
+        template <class Cursor>
+        auto get_size_hint(const Cursor& cur, int) -> decltype(cur.size_hint()) { return cur.size_hint(); }
+
+        template <class Cursor>
+        size_hint get_size_hint(const Cursor& cur, long) { return get_size_hint_(cur, typename Cursor::cursor_category()); }
+
+        template <class Cursor>
+        size_hint get_size_hint(const Cursor& cur) { return get_size_hint(cur, 0); }
+
+        template <class Container>
+        auto container_size(const Container& c, int) -> decltype(size_t(c.size())) { return c.size(); }
+
+        template <class Container>
+        size_t container_size(const Container&, long) { return size_t(-1); }
+    }
+
     // standard cursor adaptors
 
     namespace util 
@@ -156,6 +215,7 @@ namespace cpplinq {
             if (current == fin)
                 throw std::logic_error("inc past end");
             ++current; 
+            if (left != size_t(-1)) --left;
         }
         typename std::iterator_traits<Iterator>::reference get() const { return *current; }
 
@@ -164,22 +224,26 @@ namespace cpplinq {
             if (current == start) 
                 throw std::logic_error("dec past begin");
             --current; 
+            if (left != size_t(-1)) ++left;
         }
         
         void skip(ptrdiff_t n) { current += n; }
-        size_t size() { return fin-start; }
-        void position() { return current-start; }
+        size_t size() const { return fin-start; }
+        size_t position() const { return current-start; }
         void truncate(size_t n) {
-            if (n > fin-current) {
+            if (n < static_cast<size_t>(fin-current)) {
                 fin = current + n;
             }
         }
 
 
+        cpplinq::size_hint size_hint() const { return size_hint_(cursor_category()); }
+
         iter_cursor(Iterator start, Iterator fin)
         : current(start)
         , start(start)
         , fin(std::move(fin))
+        , left(size_t(-1))
         {
         }
 
@@ -187,14 +251,124 @@ namespace cpplinq {
         : current(std::move(current))
         , start(std::move(start))
         , fin(std::move(fin))
+        , left(size_t(-1))
         {
         }
 
+        // a cursor over the count elements from start, for iterators that cannot 
+        //   tell the distance to fin themselves
+        static iter_cursor counted(Iterator start, Iterator fin, size_t count)
+        {
+            iter_cursor result(std::move(start), std::move(fin));
+            result.left = count;
+            return result;
+        }
+
         iter_cursor get_cursor() const { return *this; }
 
+        // the underlying range that remains, for operators that can work 
+        //   on iterators directly
+        Iterator current_iterator() const { return current; }
+        Iterator end_iterator() const { return fin; }
+
     private:
+        cpplinq::size_hint size_hint_(onepass_cursor_tag) const { 
+            return left != size_t(-1) ? cpplinq::size_hint::exactly(left) : cpplinq::size_hint(); 
+        }
+        cpplinq::size_hint size_hint_(random_access_cursor_tag) const { 
+            return cpplinq::size_hint::exactly(fin - current); 
+        }
+
         Iterator current;
         Iterator start, fin;
+        // elements from current to fin, when known and not random access
+        size_t left;
+    };
+
+    // a collection that owns its container, taken with from(std::move(c)).
+    //   Its cursors move the elements out as they read them, so each element
+    //   should be read once and the query should be run once. The cursor has
+    //   the category of the container's iterators, like the cursor of a 
+    //   borrowed container, so skip and element_at move past elements 
+    //   without reading them. Operators that look at an element before 
+    //   passing it on, such as where, give their functions an lvalue, so only
+    //   the final consumer of an element moves from it.
+    template <class Container>
+    class owned_collection
+    {
+        typedef typename Container::iterator
+            iterator;
+    public:
+        struct cursor {
+            typedef typename std::iterator_traits<iterator>::value_type
+                element_type;
+            // iterators that make their elements, such as a counting
+            //   iterator, give them by value: there is nothing to move from.
+            typedef typename std::conditional<
+                    std::is_lvalue_reference<typename std::iterator_traits<iterator>::reference>::value,
+                    element_type&&,
+                    typename std::iterator_traits<iterator>::reference>::type
+                reference_type;
+            typedef typename util::iter_to_cursor_category<iterator>::type
+                cursor_category;
+
+            explicit cursor(std::shared_ptr<Container> c) 
+            : current(c->begin()), start(current), fin(c->end()), left(detail::container_size(*c, 0)), container(std::move(c))
+            {
+            }
+
+            void forget() { start = current; }
+            bool empty() const { return current == fin; }
+            void inc() { 
+                if (current == fin)
+                    throw std::logic_error("inc past end");
+                ++current; 
+                if (left != size_t(-1)) --left;
+            }
+            reference_type get() const { return std::move(*current); }
+
+            bool atbegin() const { return current == start; }
+            void dec() { 
+                if (current == start) 
+                    throw std::logic_error("dec past begin");
+                --current; 
+                if (left != size_t(-1)) ++left;
+            }
+
+            void skip(ptrdiff_t n) { current += n; }
+            size_t size() const { return fin-start; }
+            size_t position() const { return current-start; }
+            void truncate(size_t n) {
+                if (n < static_cast<size_t>(fin-current)) {
+                    fin = current + n;
+                }
+            }
+
+            cpplinq::size_hint size_hint() const { return size_hint_(cursor_category()); }
+
+        private:
+            cpplinq::size_hint size_hint_(onepass_cursor_tag) const {
+                return left != size_t(-1) ? cpplinq::size_hint::exactly(left) : cpplinq::size_hint();
+            }
+            cpplinq::size_hint size_hint_(random_access_cursor_tag) const { 
+                return cpplinq::size_hint::exactly(fin - current); 
+            }
+
+            iterator current, start, fin;
+            // elements from current to fin, when known and not random access
+            size_t left;
+            std::shared_ptr<Container> container;
+        };
+
+        explicit owned_collection(Container c) 
+        : container(std::make_shared<Container>(std::move(c)))
+        {
+        }
+
+        cursor get_cursor() const { return cursor(container); }
+
+    private:
+        std::shared_ptr<Container> container;
     };
 
 
@@ -42,9 +42,19 @@ struct default_less
     }
 };
 
-// progressively constructs grouping as user iterates over groups and elements
-//   within each group. Performs this task by building a std::list of element 
-//   iterators with equal elements within each group.
+struct default_hash
+{
+    template <class T>
+    size_t operator()(const T& a) const {
+        return std::hash<T>()(a);
+    }
+};
+
+// builds the grouping progressively, pulling from the inner cursor only as 
+//   far as is needed to find the next group or the next element of a group 
+//   that was asked for. Groups are found by key in a hash index and each 
+//   group stores its elements in a chunked sequence of its own, so 
+//   references to elements stay valid while the grouping grows.
 // 
 // invariants:
 //   - relative order of groups corresponds to relative order of each group's first 
@@ -53,8 +63,8 @@ struct default_less
 //     as they appeared in the input sequence.
 // 
 // requires:
-//   Iter must be a forward iterator.
-template <class Collection, class KeyFn, class Compare = default_less>
+//   key_type must be hashable by Hash and comparable by Equal.
+template <class Collection, class KeyFn, class Hash = default_hash, class Equal = default_equality>
 class linq_groupby
 {
     typedef typename Collection::cursor 
@@ -63,77 +73,272 @@ class linq_groupby
     typedef typename util::result_of<KeyFn(typename inner_cursor::element_type)>::type
         key_type;
 
-    typedef std::list<typename inner_cursor::element_type>
-        element_list_type;
+    typedef typename inner_cursor::element_type
+        element_type;
 
-    typedef group<typename element_list_type::iterator, key_type> 
-        group_type;
+    struct impl_t;
 
-    typedef std::list<group_type>
-        group_list_type;
+    // iterates the elements of one group, pulling more of the input 
+    //   when it runs past the elements found so far
+    class group_iterator 
+        : public std::iterator<std::forward_iterator_tag, element_type>
+    {
+    public:
+        CPPLINQ_USE_DEFAULT_ITERATOR_OPERATORS;
+
+        group_iterator() : groupIx(0), elementIx(0) {}
+
+        group_iterator(std::shared_ptr<impl_t> impl, size_t groupIx) 
+        : impl(std::move(impl)), groupIx(groupIx), elementIx(0) 
+        {
+        }
+
+        bool operator==(const group_iterator& other) const {
+            bool fin = at_end(), otherFin = other.at_end();
+            return fin || otherFin ? fin == otherFin : elementIx == other.elementIx;
+        }
+
+        element_type& operator*() const {
+            if (at_end()) {
+                throw std::logic_error("attempt to dereference past end of group");
+            }
+            return impl->groups[groupIx].elements[elementIx];
+        }
+
+        element_type* operator->() const {
+            return &**this;
+        }
+
+        group_iterator& operator++() {
+            ++elementIx;
+            return *this;
+        }
+
+    private:
+        bool at_end() const {
+            return !impl || !impl->has_element(groupIx, elementIx);
+        }
+
+        std::shared_ptr<impl_t> impl;
+        size_t groupIx;
+        size_t elementIx;
+    };
+
+    typedef group<group_iterator, key_type> 
+        group_type;
 
-private:
     struct impl_t
     {
-        // TODO: would be faster to use a chunked list, where
-        //   pointers are invalidated but iterators are not. Need 
-        //   benchmarks first
-
-        element_list_type                           elements;
-        std::list<group_type>                       groups;
-        std::map<key_type, group_type*, Compare>    groupIndex;
+        struct group_data 
+        {
+            key_type                    key;
+            std::deque<element_type>    elements;
 
+            explicit group_data(const key_type& key) : key(key) {}
+        };
 
+        // deques, so that growing them leaves references to 
+        //   earlier groups and elements intact
+        std::deque<group_data>                                  groups;
+        std::unordered_map<key_type, size_t, Hash, Equal>       groupIndex;
 
+        util::maybe<inner_cursor> cur;
         KeyFn keySelector;
-        Compare comp;
         
         impl_t(inner_cursor cur,
                KeyFn keySelector,
-               Compare comp = Compare()) 
-        : keySelector(keySelector)
-        , groupIndex(comp)
+               Hash hash = Hash(),
+               Equal equal = Equal()) 
+        : groupIndex(0, hash, equal)
+        , cur(std::move(cur))
+        , keySelector(keySelector)
         {
-            // TODO: make lazy
-            insert_all(std::move(cur));
         }
 
-        void insert_all(inner_cursor cur)
+        bool has_group(size_t groupIx) 
         {
-            while(!cur.empty()) {
-                insert(cur.get());
-                cur.inc();
+            while(groups.size() <= groupIx && pull()) {}
+            return groupIx < groups.size();
+        }
+        bool has_element(size_t groupIx, size_t elementIx) 
+        {
+            while(groups[groupIx].elements.size() <= elementIx && pull()) {}
+            return elementIx < groups[groupIx].elements.size();
+        }
+
+        // moves one element of the input into its group. returns 
+        //   false when the input is exhausted.
+        bool pull()
+        {
+            if (!cur) { 
+                return false; 
+            }
+            if (cur->empty()) {
+                // drop the inner cursor along with any state it holds
+                cur.reset();
+                return false;
             }
+            insert(cur->get());
+            cur->inc();
+            return true;
         }
+        // the element is moved into its group when the cursor gives it up 
+        //   or produced it as a value
         void insert(typename inner_cursor::reference_type element)
         {
-            key_type key = keySelector(element);
+            key_type key = keySelector(util::as_lvalue(element));
             auto groupPos = groupIndex.find(key);
             if(groupPos == groupIndex.end()) {
                 // new group
-                bool firstGroup = groups.empty();
+                groupPos = groupIndex.insert(std::make_pair(key, groups.size())).first;
+                groups.push_back(group_data(key));
+            }
+            groups[groupPos->second].elements.push_back(std::forward<typename inner_cursor::reference_type>(element));
+        }
+    };
 
-                elements.push_back(element);
-                if(!firstGroup) {
-                    // pop new element out of previous group
-                    --groups.back().fin; 
-                }
+public:
+    struct cursor {
+        typedef group_type
+            element_type;
 
-                // build new group
-                groups.push_back(group_type(key));
-                group_type& newGroup = groups.back();
+        typedef element_type
+            reference_type;
 
-                groupIndex.insert( std::make_pair(key, &newGroup) );
+        typedef forward_cursor_tag
+            cursor_category;
+
+        cursor(inner_cursor   cur, 
+               KeyFn          keyFn,
+               Hash           hash = Hash(),
+               Equal          equal = Equal()) 
+        : impl(new impl_t(cur, keyFn, hash, equal))
+        , pos(0)
+        {
+        }
 
-                newGroup.fin = elements.end();
-                --(newGroup.start = newGroup.fin);
-            } else {
-                // add to existing group at end
-                elements.insert(groupPos->second->end(), element);
+        void forget() { } // nop on forward-only cursors
+        bool empty() const {
+            return !impl->has_group(pos);
+        }
+        void inc() {
+            if (empty()) {
+                throw std::logic_error("attempt to iterate past end of range");
             }
+            ++pos;
         }
+        reference_type get() const {
+            group_type result(impl->groups[pos].key);
+            result.start = group_iterator(impl, pos);
+            return result;
+        }
+        
+    private:
+        std::shared_ptr<impl_t> impl;
+        size_t pos;
     };
 
+    linq_groupby(Collection     c, 
+                 KeyFn          keyFn,
+                 Hash           hash = Hash(),
+                 Equal          equal = Equal()) 
+    : c(c), keyFn(keyFn), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const { return cursor(c.get_cursor(), keyFn, hash, equal); }
+
+private:
+    Collection c;
+    KeyFn keyFn;
+    Hash hash;
+    Equal equal;
+};
+
+// groups runs of adjacent elements with equal keys, for input that is 
+//   already ordered by key. Holds no elements: each group is a view over 
+//   the inner cursor from the first element of its run, so memory use 
+//   does not depend on the length of the input.
+// 
+// invariants:
+//   - a key that reappears after a different key starts a new group.
+// 
+// requires:
+//   inner cursor must be a forward cursor, since each group and the 
+//   cursor over the groups walk the same run independently.
+template <class Collection, class KeyFn, class Equal = default_equality>
+class linq_groupby_adjacent
+{
+    typedef typename Collection::cursor 
+        inner_cursor;
+
+    typedef typename util::result_of<KeyFn(typename inner_cursor::element_type)>::type
+        key_type;
+
+    struct run_t
+    {
+        key_type key;
+        KeyFn keySelector;
+        Equal equal;
+
+        run_t(key_type key, KeyFn keySelector, Equal equal) 
+        : key(std::move(key)), keySelector(std::move(keySelector)), equal(std::move(equal)) 
+        {
+        }
+
+        bool contains(const inner_cursor& cur) const {
+            return !cur.empty() && equal(key, keySelector(cur.get()));
+        }
+    };
+
+    class group_iterator 
+        : public std::iterator<std::forward_iterator_tag, 
+                typename inner_cursor::element_type,
+                ptrdiff_t,
+                typename std::conditional<std::is_reference<typename inner_cursor::reference_type>::value,
+                                          typename std::add_pointer<typename inner_cursor::element_type>::type,
+                                          util::value_ptr<typename inner_cursor::element_type>>::type,
+                typename inner_cursor::reference_type>
+    {
+    public:
+        CPPLINQ_USE_DEFAULT_ITERATOR_OPERATORS;
+
+        group_iterator() : pos(0) {}
+
+        group_iterator(inner_cursor cur, std::shared_ptr<const run_t> run) 
+        : cur(std::move(cur)), run(std::move(run)), pos(0)
+        {
+        }
+
+        bool operator==(const group_iterator& other) const {
+            return !cur || !other.cur ? !cur == !other.cur : pos == other.pos;
+        }
+
+        typename inner_cursor::reference_type operator*() const {
+            return cur->get();
+        }
+
+        typename group_iterator::pointer operator->() const {
+            auto& v = **this;
+            return &v;
+        }
+
+        group_iterator& operator++() {
+            cur->inc();
+            ++pos;
+            if (!run->contains(*cur)) { cur.reset(); }
+            return *this;
+        }
+
+    private:
+        util::maybe<inner_cursor> cur;
+        std::shared_ptr<const run_t> run;
+        size_t pos;
+    };
+
+    typedef group<group_iterator, key_type> 
+        group_type;
+
 public:
     struct cursor {
         typedef group_type
@@ -147,46 +352,50 @@ public:
 
         cursor(inner_cursor   cur, 
                KeyFn          keyFn,
-               Compare        comp = Compare()) 
+               Equal          equal = Equal()) 
+        : cur(std::move(cur)), keyFn(std::move(keyFn)), equal(std::move(equal))
         {
-            impl.reset(new impl_t(cur, keyFn, comp));
-            inner   = impl->groups.begin();
-            fin     = impl->groups.end();
         }
 
         void forget() { } // nop on forward-only cursors
         bool empty() const {
-            return inner == fin;
+            return cur.empty();
         }
         void inc() {
-            if (inner == fin) {
+            if (cur.empty()) {
                 throw std::logic_error("attempt to iterate past end of range");
             }
-            ++inner;
+            run_t run(keyFn(cur.get()), keyFn, equal);
+            do {
+                cur.inc();
+            } while (run.contains(cur));
         }
         reference_type get() const {
-            return *inner;
+            auto run = std::make_shared<const run_t>(keyFn(cur.get()), keyFn, equal);
+            group_type result(run->key);
+            result.start = group_iterator(cur, run);
+            return result;
         }
         
     private:
-        std::shared_ptr<impl_t> impl;
-        typename std::list<group_type>::iterator inner;
-        typename std::list<group_type>::iterator fin;
+        inner_cursor cur;
+        KeyFn keyFn;
+        Equal equal;
     };
 
-    linq_groupby(Collection     c, 
-                 KeyFn          keyFn,
-                 Compare        comp = Compare()) 
-    : c(c), keyFn(keyFn), comp(comp)
+    linq_groupby_adjacent(Collection     c, 
+                          KeyFn          keyFn,
+                          Equal          equal = Equal()) 
+    : c(c), keyFn(keyFn), equal(equal)
     {
     }
 
-    cursor get_cursor() const { return cursor(c.get_cursor(), keyFn, comp); }
+    cursor get_cursor() const { return cursor(c.get_cursor(), keyFn, equal); }
 
 private:
     Collection c;
     KeyFn keyFn;
-    Compare comp;
+    Equal equal;
 };
 
 }
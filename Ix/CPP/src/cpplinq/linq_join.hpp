@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_JOIN_HPP)
+#define CPPLINQ_LINQ_JOIN_HPP
+#pragma once
+
+namespace cpplinq
+{
+// the elements of the inner sequence, grouped by key. Built once per cursor
+//   and shared by its copies, as it does not change after it is built.
+template <class InnerCursor, class InnerKeyFn, class Hash, class Equal>
+struct linq_join_index
+{
+    typedef typename InnerCursor::element_type
+        element_type;
+
+    typedef typename util::result_of<InnerKeyFn(element_type)>::type
+        key_type;
+
+    typedef std::vector<element_type>
+        element_list_type;
+
+    std::unordered_map<key_type, element_list_type, Hash, Equal> groups;
+
+    // stands in for the group of a key that has no inner elements
+    element_list_type none;
+
+    linq_join_index(InnerCursor cur, const InnerKeyFn& innerKey, const Hash& hash, const Equal& equal)
+    : groups(0, hash, equal)
+    {
+        for (; !cur.empty(); cur.inc()) {
+            typename InnerCursor::reference_type element = cur.get();
+            auto& group = groups[innerKey(util::as_lvalue(element))];
+            group.push_back(std::forward<typename InnerCursor::reference_type>(element));
+        }
+    }
+
+    template <class Key>
+    const element_list_type& find(const Key& key) const {
+        auto found = groups.find(key);
+        return found == groups.end() ? none : found->second;
+    }
+};
+
+// pairs each outer element with each inner element of equal key. The inner
+//   sequence is read into a hash index when a cursor is requested and the
+//   outer sequence is streamed against it.
+//
+// invariants:
+//   - results are ordered by outer element, then by inner element, as they
+//     appeared in their input sequences.
+template <class Collection, class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn,
+          class Hash = default_hash, class Equal = default_equality>
+class linq_join
+{
+    typedef typename Collection::cursor
+        outer_cursor;
+
+    typedef linq_join_index<typename Inner::cursor, InnerKeyFn, Hash, Equal>
+        index_type;
+
+public:
+    struct cursor {
+        typedef typename util::result_of<ResultFn(typename outer_cursor::element_type, typename index_type::element_type)>::type
+            reference_type;
+        typedef typename std::remove_reference<reference_type>::type
+            element_type;
+        typedef typename util::min_cursor_category<typename outer_cursor::cursor_category, forward_cursor_tag>::type
+            cursor_category;
+
+        cursor(outer_cursor outer, std::shared_ptr<const index_type> index, OuterKeyFn outerKey, ResultFn result)
+        : outer(std::move(outer)), index(std::move(index)), matches(nullptr), pos(0)
+        , outerKey(std::move(outerKey)), result(std::move(result))
+        {
+            seek();
+        }
+
+        bool empty() const { return outer.empty(); }
+        void inc() {
+            if (++pos == matches->size()) {
+                outer.inc();
+                seek();
+            }
+        }
+        reference_type get() const { return result(outer.get(), (*matches)[pos]); }
+
+    private:
+        // moves to the next outer element with inner elements of equal key
+        void seek() {
+            for (pos = 0; !outer.empty(); outer.inc()) {
+                matches = &index->find(outerKey(outer.get()));
+                if (!matches->empty()) {
+                    break;
+                }
+            }
+        }
+
+        outer_cursor outer;
+        std::shared_ptr<const index_type> index;
+        const typename index_type::element_list_type* matches;
+        size_t pos;
+        OuterKeyFn outerKey;
+        ResultFn result;
+    };
+
+    linq_join(Collection c, Inner inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result,
+              Hash hash = Hash(), Equal equal = Equal())
+    : c(c), inner(inner), outerKey(outerKey), innerKey(innerKey), result(result), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        auto index = std::make_shared<const index_type>(inner.get_cursor(), innerKey, hash, equal);
+        return cursor(c.get_cursor(), std::move(index), outerKey, result);
+    }
+
+private:
+    Collection c;
+    Inner inner;
+    OuterKeyFn outerKey;
+    InnerKeyFn innerKey;
+    ResultFn result;
+    Hash hash;
+    Equal equal;
+};
+
+// pairs each outer element with the group of inner elements of equal key,
+//   which is empty when there are none. Groups refer to the hash index,
+//   which lives as long as the cursor that produced them.
+template <class Collection, class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn,
+          class Hash = default_hash, class Equal = default_equality>
+class linq_group_join
+{
+    typedef typename Collection::cursor
+        outer_cursor;
+
+    typedef linq_join_index<typename Inner::cursor, InnerKeyFn, Hash, Equal>
+        index_type;
+
+    typedef typename util::result_of<OuterKeyFn(typename outer_cursor::element_type)>::type
+        key_type;
+
+    typedef group<typename index_type::element_list_type::const_iterator, key_type>
+        group_type;
+
+public:
+    struct cursor {
+        typedef typename util::result_of<ResultFn(typename outer_cursor::element_type, group_type)>::type
+            reference_type;
+        typedef typename std::remove_reference<reference_type>::type
+            element_type;
+        typedef typename util::min_cursor_category<typename outer_cursor::cursor_category, forward_cursor_tag>::type
+            cursor_category;
+
+        cursor(outer_cursor outer, std::shared_ptr<const index_type> index, OuterKeyFn outerKey, ResultFn result)
+        : outer(std::move(outer)), index(std::move(index))
+        , outerKey(std::move(outerKey)), result(std::move(result))
+        {
+        }
+
+        bool empty() const { return outer.empty(); }
+        void inc() { outer.inc(); }
+        reference_type get() const {
+            typename outer_cursor::reference_type element = outer.get();
+            group_type matches(outerKey(element));
+            auto& inner = index->find(matches.key);
+            matches.start = inner.begin();
+            matches.fin = inner.end();
+            return result(element, matches);
+        }
+
+    private:
+        outer_cursor outer;
+        std::shared_ptr<const index_type> index;
+        OuterKeyFn outerKey;
+        ResultFn result;
+    };
+
+    linq_group_join(Collection c, Inner inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result,
+                    Hash hash = Hash(), Equal equal = Equal())
+    : c(c), inner(inner), outerKey(outerKey), innerKey(innerKey), result(result), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        auto index = std::make_shared<const index_type>(inner.get_cursor(), innerKey, hash, equal);
+        return cursor(c.get_cursor(), std::move(index), outerKey, result);
+    }
+
+private:
+    Collection c;
+    Inner inner;
+    OuterKeyFn outerKey;
+    InnerKeyFn innerKey;
+    ResultFn result;
+    Hash hash;
+    Equal equal;
+};
+
+// the join of two sequences that are both ordered by key, ascending
+//   according to Less. Walks the two sequences together and stores no
+//   elements. Outer elements with equal keys each walk the same run of
+//   inner elements.
+//
+// requires:
+//   inner cursor must be a forward cursor.
+template <class Collection, class Inner, class OuterKeyFn, class InnerKeyFn, class ResultFn,
+          class Less = default_less>
+class linq_merge_join
+{
+    typedef typename Collection::cursor
+        outer_cursor;
+
+    typedef typename Inner::cursor
+        inner_cursor;
+
+public:
+    struct cursor {
+        typedef typename util::result_of<ResultFn(typename outer_cursor::element_type, typename inner_cursor::element_type)>::type
+            reference_type;
+        typedef typename std::remove_reference<reference_type>::type
+            element_type;
+        typedef typename util::min_cursor_category<
+            typename outer_cursor::cursor_category,
+            typename inner_cursor::cursor_category,
+            forward_cursor_tag>::type
+            cursor_category;
+
+        cursor(outer_cursor outer, inner_cursor inner,
+               OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result, Less less)
+        : outer(std::move(outer)), run(std::move(inner)), done(false)
+        , outerKey(std::move(outerKey)), innerKey(std::move(innerKey)), result(std::move(result)), less(std::move(less))
+        {
+            seek();
+        }
+
+        bool empty() const { return done || outer.empty(); }
+        void inc() {
+            current->inc();
+            // inner keys in the run are not less than the outer key
+            if (current->empty() || less(outerKey(outer.get()), innerKey(current->get()))) {
+                outer.inc();
+                seek();
+            }
+        }
+        reference_type get() const { return result(outer.get(), current->get()); }
+
+    private:
+        // moves to the next outer element with a run of inner elements
+        //   of equal key, and to the start of that run
+        void seek() {
+            for (; !outer.empty(); outer.inc()) {
+                auto key = outerKey(outer.get());
+                while (!run.empty() && less(innerKey(run.get()), key)) {
+                    run.inc();
+                }
+                if (run.empty()) {
+                    // no outer element that remains can match
+                    done = true;
+                    return;
+                }
+                if (!less(key, innerKey(run.get()))) {
+                    current.set(run);
+                    return;
+                }
+            }
+        }
+
+        outer_cursor outer;
+        // the first inner element whose key is not less than the outer key
+        inner_cursor run;
+        util::maybe<inner_cursor> current;
+        bool done;
+        OuterKeyFn outerKey;
+        InnerKeyFn innerKey;
+        ResultFn result;
+        Less less;
+    };
+
+    linq_merge_join(Collection c, Inner inner, OuterKeyFn outerKey, InnerKeyFn innerKey, ResultFn result,
+                    Less less = Less())
+    : c(c), inner(inner), outerKey(outerKey), innerKey(innerKey), result(result), less(less)
+    {
+    }
+
+    cursor get_cursor() const {
+        return cursor(c.get_cursor(), inner.get_cursor(), outerKey, innerKey, result, less);
+    }
+
+private:
+    Collection c;
+    Inner inner;
+    OuterKeyFn outerKey;
+    InnerKeyFn innerKey;
+    ResultFn result;
+    Less less;
+};
+
+}
+
+#endif // !defined(CPPLINQ_LINQ_JOIN_HPP)
+
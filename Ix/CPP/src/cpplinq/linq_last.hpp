@@ -22,6 +22,46 @@ namespace cpplinq {
 
     // TODO: bidirectional iterator in constant time
 
+    // moves the cursor n elements on. returns false if fewer than n+1
+    //   elements remained, in which case the cursor may be left anywhere.
+    template <class Cursor>
+    bool linq_advance_(Cursor& c, size_t n, onepass_cursor_tag)
+    {
+        while(n && !c.empty()) {
+            c.inc();
+            --n;
+        }
+        return !c.empty();
+    }
+
+    template <class Cursor>
+    bool linq_advance_(Cursor& c, size_t n, random_access_cursor_tag)
+    {
+        if (n >= c.size()-c.position()) { return false; }
+        c.skip(n);
+        return true;
+    }
+
+    template <class Cursor>
+    size_t linq_count_(Cursor c, onepass_cursor_tag)
+    {
+        auto hint = detail::get_size_hint(c);
+        if (hint.is_exact()) {
+            return hint.size;
+        }
+        size_t n = 0;
+        for(; !c.empty(); c.inc()) {
+            ++n;
+        }
+        return n;
+    }
+
+    template <class Cursor>
+    size_t linq_count_(Cursor c, random_access_cursor_tag)
+    {
+        return c.size()-c.position();
+    }
+
     template <class Cursor>
     typename Cursor::reference_type
         linq_last_(Cursor c, forward_cursor_tag)
@@ -41,7 +81,7 @@ namespace cpplinq {
         linq_last_(Cursor c, random_access_cursor_tag)
     {
         if (c.empty()) { throw std::logic_error("last() out of bounds"); }
-        c.skip(c.size()-1);
+        c.skip(c.size()-c.position()-1);
         return c.get();
     }
 
@@ -76,7 +116,7 @@ namespace cpplinq {
         linq_last_or_default_(Cursor c, random_access_cursor_tag)
     {
         if (c.empty()) { return typename Cursor::element_type(); }
-        c.skip(c.size()-1);
+        c.skip(c.size()-c.position()-1);
         return c.get();
     }
 
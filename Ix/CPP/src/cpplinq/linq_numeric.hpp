@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_NUMERIC_HPP)
+#define CPPLINQ_LINQ_NUMERIC_HPP
+#pragma once
+
+namespace cpplinq {
+
+    namespace util {
+        // true for iterators over elements that are adjacent in memory.
+        //   conservative: pointers and std::vector iterators only.
+        template <class Iter>
+        struct is_contiguous_iterator
+        {
+            typedef typename std::remove_cv<typename std::iterator_traits<Iter>::value_type>::type
+                value_type;
+
+            enum { value =
+                       std::is_pointer<Iter>::value
+                       || (!std::is_same<value_type, bool>::value
+                           && (std::is_same<Iter, typename std::vector<value_type>::iterator>::value
+                               || std::is_same<Iter, typename std::vector<value_type>::const_iterator>::value))
+            };
+        };
+    }
+
+    namespace detail {
+        // sums with four independent partial sums, which the compiler can
+        //   keep in vector registers. floating point results may differ from
+        //   a sum in input order by rounding.
+        template <class T>
+        T sum_contiguous(const T* first, const T* last)
+        {
+            T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+            for (; last - first >= 4; first += 4) {
+                s0 += first[0];
+                s1 += first[1];
+                s2 += first[2];
+                s3 += first[3];
+            }
+            for (; first != last; ++first) {
+                s0 += *first;
+            }
+            return (s0 + s1) + (s2 + s3);
+        }
+
+        template <class Iter>
+        typename std::iterator_traits<Iter>::value_type
+            sum_iterators_(Iter first, Iter last, std::true_type)
+        {
+            return first == last
+                ? typename std::iterator_traits<Iter>::value_type()
+                : sum_contiguous(&*first, &*first + (last - first));
+        }
+
+        template <class Iter>
+        typename std::iterator_traits<Iter>::value_type
+            sum_iterators_(Iter first, Iter last, std::false_type)
+        {
+            return std::accumulate(first, last, typename std::iterator_traits<Iter>::value_type());
+        }
+    }
+
+    template <class Cursor>
+    typename Cursor::element_type
+        linq_sum_(Cursor c)
+    {
+        typename Cursor::element_type sum = typename Cursor::element_type();
+        for(; !c.empty(); c.inc()) {
+            sum += c.get();
+        }
+        return sum;
+    }
+
+    // iterates the underlying iterators directly
+    template <class Iter>
+    typename iter_cursor<Iter>::element_type
+        linq_sum_(iter_cursor<Iter> c)
+    {
+        typedef typename iter_cursor<Iter>::element_type element_type;
+        return detail::sum_iterators_(c.current_iterator(), c.end_iterator(),
+            std::integral_constant<bool,
+                util::is_contiguous_iterator<Iter>::value && std::is_arithmetic<element_type>::value>());
+    }
+
+    // the least element according to less. keeps a copy of the cursor at
+    //   the best element so far, which requires a forward cursor.
+    template <class Cursor, class Compare>
+    typename Cursor::reference_type
+        linq_min_(Cursor c, Compare less)
+    {
+        if (c.empty()) { throw std::logic_error("min performed on empty range"); }
+        util::maybe<Cursor> best(c);
+        for(c.inc(); !c.empty(); c.inc()) {
+            if (less(c.get(), best->get())) {
+                best.set(c);
+            }
+        }
+        return best->get();
+    }
+
+    template <class Iter, class Compare>
+    typename iter_cursor<Iter>::reference_type
+        linq_min_(iter_cursor<Iter> c, Compare less)
+    {
+        auto it = std::min_element(c.current_iterator(), c.end_iterator(), less);
+        if (it == c.end_iterator()) { throw std::logic_error("min performed on empty range"); }
+        return *it;
+    }
+
+    // the first of the greatest elements according to less, as with 
+    //   std::max_element
+    template <class Cursor, class Compare>
+    typename Cursor::reference_type
+        linq_max_(Cursor c, Compare less)
+    {
+        if (c.empty()) { throw std::logic_error("max performed on empty range"); }
+        util::maybe<Cursor> best(c);
+        for(c.inc(); !c.empty(); c.inc()) {
+            if (less(best->get(), c.get())) {
+                best.set(c);
+            }
+        }
+        return best->get();
+    }
+
+    template <class Iter, class Compare>
+    typename iter_cursor<Iter>::reference_type
+        linq_max_(iter_cursor<Iter> c, Compare less)
+    {
+        auto it = std::max_element(c.current_iterator(), c.end_iterator(), less);
+        if (it == c.end_iterator()) { throw std::logic_error("max performed on empty range"); }
+        return *it;
+    }
+
+}
+
+#endif // CPPLINQ_LINQ_NUMERIC_HPP
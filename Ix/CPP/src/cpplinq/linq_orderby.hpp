@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_ORDERBY_HPP)
+#define CPPLINQ_LINQ_ORDERBY_HPP
+#pragma once
+
+namespace cpplinq
+{
+namespace detail
+{
+    template <class Less>
+    struct reverse_less
+    {
+        Less less;
+
+        reverse_less(Less less) : less(std::move(less)) {}
+
+        template <class T>
+        bool operator()(const T& a, const T& b) const {
+            return less(b, a);
+        }
+    };
+
+    // orders elements by comparing the key of each
+    template <class KeyFn, class Less>
+    struct key_order
+    {
+        KeyFn keyFn;
+        Less less;
+
+        key_order(KeyFn keyFn, Less less) : keyFn(std::move(keyFn)), less(std::move(less)) {}
+
+        template <class T>
+        bool operator()(const T& a, const T& b) const {
+            return less(keyFn(a), keyFn(b));
+        }
+    };
+
+    // orders elements by First, and elements that First finds
+    //   equivalent by Second
+    template <class First, class Second>
+    struct then_order
+    {
+        First first;
+        Second second;
+
+        then_order(First first, Second second) : first(std::move(first)), second(std::move(second)) {}
+
+        template <class T>
+        bool operator()(const T& a, const T& b) const {
+            if (first(a, b)) return true;
+            if (first(b, a)) return false;
+            return second(a, b);
+        }
+    };
+}
+
+// collects the input when a cursor is requested and sorts a permutation of
+//   element indices, so the elements themselves are never moved. Sorting
+//   waits until the first element is read, and only the positions that the
+//   cursor can reach are sorted. take(n) truncates the cursor before that,
+//   so order_by(...).take(n) performs a partial sort of n elements.
+//
+// invariants:
+//   - elements that Order finds equivalent keep their relative input order.
+//
+// requires:
+//   element_type must be copy constructible.
+template <class Collection, class Order>
+class linq_orderby
+{
+    typedef typename Collection::cursor
+        inner_cursor;
+
+    typedef typename inner_cursor::element_type
+        element_type;
+
+    struct impl_t
+    {
+        std::vector<element_type>   elements;
+        std::vector<size_t>         order;
+
+        // leading positions of order that hold their final index
+        size_t sorted;
+
+        Order ord;
+
+        impl_t(inner_cursor cur, const Order& ord)
+        : sorted(0)
+        , ord(ord)
+        {
+            while(!cur.empty()) {
+                elements.push_back(cur.get());
+                cur.inc();
+            }
+            order.resize(elements.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+        }
+
+        void sort_prefix(size_t n)
+        {
+            if (n <= sorted) {
+                return;
+            }
+            // ties are broken by input position, which makes both
+            //   sorts stable
+            auto less = [this](size_t a, size_t b) {
+                if (ord(elements[a], elements[b])) return true;
+                if (ord(elements[b], elements[a])) return false;
+                return a < b;
+            };
+            if (n < order.size()) {
+                std::partial_sort(order.begin(), order.begin() + n, order.end(), less);
+                sorted = n;
+            } else {
+                std::sort(order.begin(), order.end(), less);
+                sorted = order.size();
+            }
+        }
+    };
+
+public:
+    struct cursor {
+        typedef typename linq_orderby::element_type
+            element_type;
+
+        typedef element_type
+            reference_type;
+
+        typedef random_access_cursor_tag
+            cursor_category;
+
+        cursor(inner_cursor cur, const Order& ord)
+        : impl(new impl_t(std::move(cur), ord))
+        , start(0)
+        , current(0)
+        , fin(impl->elements.size())
+        {
+        }
+
+        void forget() { start = current; }
+        bool empty() const { return current == fin; }
+        void inc() {
+            if (current == fin) {
+                throw std::logic_error("attempt to iterate past end of range");
+            }
+            ++current;
+        }
+        reference_type get() const {
+            impl->sort_prefix(fin);
+            return impl->elements[impl->order[current]];
+        }
+
+        bool atbegin() const { return current == start; }
+        void dec() {
+            if (current == start) {
+                throw std::logic_error("attempt to iterate past begin of range");
+            }
+            --current;
+        }
+
+        void skip(ptrdiff_t n) { current += n; }
+        size_t position() const { return current - start; }
+        size_t size() const { return fin - start; }
+        void truncate(size_t n) {
+            if (n < fin - current) {
+                fin = current + n;
+            }
+        }
+
+    private:
+        std::shared_ptr<impl_t> impl;
+        size_t start;
+        size_t current;
+        size_t fin;
+    };
+
+    linq_orderby(Collection c, Order ord)
+    : c(c), ord(ord)
+    {
+    }
+
+    // extends the ordering with a further key in place of sorting again
+    template <class KeyFn, class Less>
+    linq_orderby<Collection, detail::then_order<Order, detail::key_order<KeyFn, Less>>>
+        then_by(KeyFn fn, Less less) const
+    {
+        typedef detail::then_order<Order, detail::key_order<KeyFn, Less>> then_order;
+        return linq_orderby<Collection, then_order>(c, then_order(ord, detail::key_order<KeyFn, Less>(std::move(fn), std::move(less))));
+    }
+
+    cursor get_cursor() const { return cursor(c.get_cursor(), ord); }
+
+private:
+    Collection c;
+    Order ord;
+};
+
+}
+
+#endif // !defined(CPPLINQ_LINQ_ORDERBY_HPP)
+
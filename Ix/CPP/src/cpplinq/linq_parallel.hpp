@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_PARALLEL_HPP)
+#define CPPLINQ_LINQ_PARALLEL_HPP
+#pragma once
+
+namespace cpplinq
+{
+template <class Collection>
+class linq_driver;
+
+namespace detail
+{
+    // a collection of one partition of a random access cursor
+    template <class Cursor>
+    struct cursor_range
+    {
+        typedef Cursor cursor;
+
+        cursor_range(Cursor cur) : cur(std::move(cur)) {}
+
+        cursor get_cursor() const { return cur; }
+
+    private:
+        Cursor cur;
+    };
+
+    // steps that rebuild a query over each partition
+    struct build_identity
+    {
+        template <class Query>
+        Query operator()(const Query& q) const { return q; }
+    };
+
+    template <class Predicate>
+    struct build_where
+    {
+        Predicate pred;
+
+        build_where(Predicate pred) : pred(std::move(pred)) {}
+
+        template <class Query>
+        auto operator()(const Query& q) const
+        -> decltype(q.where(std::declval<const Predicate&>()))
+        {
+            return q.where(pred);
+        }
+    };
+
+    template <class Selector>
+    struct build_select
+    {
+        Selector sel;
+
+        build_select(Selector sel) : sel(std::move(sel)) {}
+
+        template <class Query>
+        auto operator()(const Query& q) const
+        -> decltype(q.select(std::declval<const Selector&>()))
+        {
+            return q.select(sel);
+        }
+    };
+
+    template <class First, class Second>
+    struct build_then
+    {
+        First first;
+        Second second;
+
+        build_then(First first, Second second) : first(std::move(first)), second(std::move(second)) {}
+
+        template <class Query>
+        auto operator()(const Query& q) const
+        -> decltype(std::declval<const Second&>()(std::declval<const First&>()(q)))
+        {
+            return second(first(q));
+        }
+    };
+}
+
+// runs a query over a random access source by splitting the source into
+//   consecutive partitions. Each partition runs the same where and select
+//   steps on a thread of its own, and terminal operators merge the partial
+//   results in partition order.
+//
+// requires:
+//   the source cursor must be a random access cursor, and the functions
+//   given to the query must be safe to call from several threads at once.
+template <class Source, class Builder = detail::build_identity>
+class linq_parallel
+{
+    typedef typename Source::cursor
+        source_cursor;
+
+    typedef linq_driver<detail::cursor_range<source_cursor>>
+        partition_type;
+
+    typedef typename util::result_of<Builder(partition_type)>::type
+        query_type;
+
+    typedef typename query_type::cursor::element_type
+        element_type;
+
+public:
+    linq_parallel(Source source, Builder builder, size_t threads)
+    : source(source), builder(builder), threads(threads)
+    {
+    }
+
+    template <class Predicate>
+    linq_parallel<Source, detail::build_then<Builder, detail::build_where<Predicate>>> where(Predicate p) const
+    {
+        typedef detail::build_then<Builder, detail::build_where<Predicate>> build;
+        return linq_parallel<Source, build>(source, build(builder, detail::build_where<Predicate>(std::move(p))), threads);
+    }
+
+    template <class Selector>
+    linq_parallel<Source, detail::build_then<Builder, detail::build_select<Selector>>> select(Selector sel) const
+    {
+        typedef detail::build_then<Builder, detail::build_select<Selector>> build;
+        return linq_parallel<Source, build>(source, build(builder, detail::build_select<Selector>(std::move(sel))), threads);
+    }
+
+    // returns element_type() on an empty sequence. fn must be associative,
+    //   as it also combines the results of the partitions.
+    template <class Fn>
+    element_type aggregate(Fn fn) const
+    {
+        auto partials = run([&](const query_type& q) {
+            return q.any()
+                ? std::make_pair(true, q.aggregate(fn))
+                : std::make_pair(false, element_type());
+        });
+        util::maybe<element_type> result;
+        for (auto& partial : partials) {
+            if (!partial.first) {
+                continue;
+            }
+            if (result) { result.set(fn(*result, partial.second)); }
+            else        { result.set(partial.second); }
+        }
+        return result ? *result : element_type();
+    }
+
+    // each partition folds its elements into initialValue with fn, and
+    //   combine folds the results of the partitions together
+    template <class T, class Fn, class Combine>
+    T aggregate(T initialValue, Fn fn, Combine combine) const
+    {
+        auto partials = run([&](const query_type& q) {
+            return q.aggregate(initialValue, fn);
+        });
+        T result = partials.front();
+        for (auto partial = partials.begin() + 1; partial != partials.end(); ++partial) {
+            result = combine(result, *partial);
+        }
+        return result;
+    }
+
+    size_t count() const
+    {
+        auto partials = run([](const query_type& q) {
+            return static_cast<size_t>(q.count());
+        });
+        return std::accumulate(partials.begin(), partials.end(), size_t(0));
+    }
+
+    template <class Predicate>
+    size_t count(Predicate p) const
+    {
+        return this->where(std::move(p)).count();
+    }
+
+    element_type sum() const
+    {
+        auto partials = run([](const query_type& q) {
+            return q.sum();
+        });
+        return std::accumulate(partials.begin(), partials.end(), element_type());
+    }
+
+    std::vector<element_type> to_vector() const
+    {
+        auto partials = run([](const query_type& q) {
+            return q.to_vector();
+        });
+        std::vector<element_type> result;
+        for (auto& partial : partials) {
+            result.insert(result.end(), partial.begin(), partial.end());
+        }
+        return result;
+    }
+
+private:
+    // calls fn with the query over each partition, the last on the calling
+    //   thread. returns the results in partition order, or rethrows the
+    //   first exception thrown by a partition.
+    template <class Fn>
+    std::vector<typename util::result_of<Fn(query_type)>::type> run(Fn fn) const
+    {
+        typedef typename util::result_of<Fn(query_type)>::type result_type;
+
+        auto cur = source.get_cursor();
+        size_t size = cur.size();
+        size_t parts = threads ? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        parts = std::max<size_t>(std::min(parts, size), 1);
+
+        std::vector<query_type> queries;
+        queries.reserve(parts);
+        for (size_t part = 0; part < parts; ++part) {
+            auto partition = cur;
+            partition.skip(size * part / parts);
+            partition.truncate(size * (part + 1) / parts - size * part / parts);
+            queries.push_back(builder(partition_type(detail::cursor_range<source_cursor>(partition))));
+        }
+
+        std::vector<util::maybe<result_type>> results(parts);
+        std::vector<std::exception_ptr> errors(parts);
+        auto work = [&](size_t part) {
+            try {
+                results[part].set(fn(queries[part]));
+            } catch(...) {
+                errors[part] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t part = 0; part + 1 < parts; ++part) {
+            workers.push_back(std::thread(work, part));
+        }
+        work(parts - 1);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::vector<result_type> partials;
+        partials.reserve(parts);
+        for (size_t part = 0; part < parts; ++part) {
+            if (errors[part]) {
+                std::rethrow_exception(errors[part]);
+            }
+            partials.push_back(*results[part]);
+        }
+        return partials;
+    }
+
+    Source source;
+    Builder builder;
+    size_t threads;
+};
+
+}
+
+#endif // !defined(CPPLINQ_LINQ_PARALLEL_HPP)
+
@@ -33,6 +33,9 @@ namespace cpplinq
             void skip(size_t n) { cur.skip(n); }
             size_t position() const { return cur.position(); }
             size_t size() const { return cur.size(); }
+            void truncate(size_t n) { cur.truncate(n); }
+
+            cpplinq::size_hint size_hint() const { return detail::get_size_hint(cur); }
         private:
             inner_cursor    cur;
             Selector        sel;
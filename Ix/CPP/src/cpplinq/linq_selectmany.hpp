@@ -18,6 +18,57 @@ namespace cpplinq
                 return std::forward<T2>(t2);
             }
         };
+
+        // iterators over storage that is one array, which the flat cursor of 
+        //   select_many walks as raw pointers
+        template <class Iter, class Value = typename std::iterator_traits<Iter>::value_type>
+        struct is_contiguous_iterator
+            : std::integral_constant<bool,
+                std::is_pointer<Iter>::value ||
+                (!std::is_same<Value, bool>::value &&
+                    (std::is_same<Iter, typename std::vector<Value>::iterator>::value ||
+                     std::is_same<Iter, typename std::vector<Value>::const_iterator>::value))>
+        {
+        };
+
+        template <class Iter, bool Contiguous = is_contiguous_iterator<Iter>::value>
+        struct flat_range
+        {
+            typedef Iter iterator;
+            static iterator begin(const iter_cursor<Iter>& cur) { return cur.current_iterator(); }
+            static iterator end(const iter_cursor<Iter>& cur) { return cur.end_iterator(); }
+        };
+
+        template <class Iter>
+        struct flat_range<Iter, true>
+        {
+            typedef typename std::remove_reference<typename std::iterator_traits<Iter>::reference>::type* iterator;
+            static iterator begin(const iter_cursor<Iter>& cur) { 
+                return cur.current_iterator() == cur.end_iterator() ? nullptr : &*cur.current_iterator(); 
+            }
+            static iterator end(const iter_cursor<Iter>& cur) { 
+                return begin(cur) + (cur.end_iterator() - cur.current_iterator()); 
+            }
+        };
+
+        // the inner cursors that the flat cursor of select_many can walk 
+        //   directly: random access cursors over iterators of a container that 
+        //   outlives the call of the selector
+        template <class Cursor>
+        struct select_many_flat : std::false_type
+        {
+            typedef void* iterator;
+        };
+
+        template <class Iter>
+        struct select_many_flat<iter_cursor<Iter>>
+            : std::integral_constant<bool, 
+                util::less_or_equal_cursor_category<
+                    random_access_cursor_tag,
+                    typename iter_cursor<Iter>::cursor_category>::value>
+        {
+            typedef flat_range<Iter> range;
+        };
     }
 
     // cur<T> -> (T -> cur<element_type>) -> cur<element_type>
@@ -31,11 +82,11 @@ namespace cpplinq
         Fn2             fn2;
 
         typedef typename Container1::cursor Cur1;
-        typedef decltype(from(instance<Fn>()(instance<Cur1>().get()))) Container2;
+        typedef typename std::decay<decltype(from(instance<Fn>()(instance<Cur1>().get())))>::type Container2;
         typedef typename Container2::cursor Cur2;
 
     public:
-        class cursor
+        class generic_cursor
         {
         public:
             typedef typename util::min_cursor_category<typename Cur1::cursor_category,
@@ -53,7 +104,7 @@ namespace cpplinq
             Fn2                             fn2;
 
         public:
-            cursor(Cur1 cur1, const Fn& fn, const Fn2& fn2)
+            generic_cursor(Cur1 cur1, const Fn& fn, const Fn2& fn2)
             : cur1(std::move(cur1)), fn(fn), fn2(fn2)
             {
                 auto container2 = fn(cur1.get());
@@ -91,6 +142,102 @@ namespace cpplinq
             }
         };
 
+        // when each outer element selects a range of a vector or other random 
+        //   access container, the inner range is held as two iterators, raw 
+        //   pointers for contiguous storage, instead of a dynamic_cursor made 
+        //   for each outer element. the outer cursor must be at least forward 
+        //   for size_hint, which sums the inner sizes without walking them.
+        class flat_cursor
+        {
+            typedef typename detail::select_many_flat<Cur2>::range range;
+            typedef typename range::iterator iterator;
+
+        public:
+            typedef typename util::min_cursor_category<typename Cur1::cursor_category,
+                                                       forward_cursor_tag>::type
+                cursor_category;
+            // what fn2 returns, a selector that makes a value from the pair 
+            //   does not return a reference to it
+            typedef decltype(instance<Fn2>()(instance<Cur1>().get(), *instance<iterator>())) reference_type;
+            typedef typename std::remove_cv<typename std::remove_reference<reference_type>::type>::type element_type;
+
+        private:
+            Cur1        cur1;
+            iterator    current, fin;
+            Fn          fn;
+            Fn2         fn2;
+
+            void load(const Cur1& outer, iterator& b, iterator& e) const
+            {
+                auto inner = from(fn(outer.get())).get_cursor();
+                b = range::begin(inner);
+                e = range::end(inner);
+            }
+            // moves to the next outer element that has inner elements
+            void settle()
+            {
+                while (current == fin) {
+                    cur1.inc();
+                    if (cur1.empty())
+                        break;
+                    load(cur1, current, fin);
+                }
+            }
+
+            size_t rest_size(onepass_cursor_tag) const { return size_t(-1); }
+            size_t rest_size(forward_cursor_tag) const
+            {
+                size_t n = fin - current;
+                if (cur1.empty()) 
+                    return n;
+                auto outer = cur1;
+                for (outer.inc(); !outer.empty(); outer.inc()) {
+                    iterator b, e;
+                    load(outer, b, e);
+                    n += e - b;
+                }
+                return n;
+            }
+
+        public:
+            flat_cursor(Cur1 outer, const Fn& fn, const Fn2& fn2)
+            : cur1(std::move(outer)), current(), fin(), fn(fn), fn2(fn2)
+            {
+                if (!cur1.empty()) {
+                    load(cur1, current, fin);
+                    settle();
+                }
+            }
+
+            bool empty() const 
+            {
+                return current == fin;
+            }
+
+            void inc() 
+            {
+                ++current;
+                settle();
+            }
+
+            reference_type get() const 
+            {
+                return fn2(cur1.get(), *current);
+            }
+
+            cpplinq::size_hint size_hint() const
+            {
+                size_t n = rest_size(typename Cur1::cursor_category());
+                return n != size_t(-1) ? cpplinq::size_hint::exactly(n) : cpplinq::size_hint();
+            }
+        };
+
+        typedef typename std::conditional<
+                detail::select_many_flat<Cur2>::value,
+                flat_cursor,
+                generic_cursor>::type
+            cursor;
+
         linq_select_many(Container1 c1, Fn fn, Fn2 fn2) 
         : c1(std::move(c1)), fn(std::move(fn)), fn2(std::move(fn2))
         {
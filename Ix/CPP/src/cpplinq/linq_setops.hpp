@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_SETOPS_HPP)
+#define CPPLINQ_LINQ_SETOPS_HPP
+#pragma once
+
+namespace cpplinq
+{
+namespace detail
+{
+    // number of elements a cursor has left to produce, when it is known 
+    //   exactly without walking the cursor
+    template <class Cursor>
+    size_t known_size(const Cursor& cur) {
+        auto hint = get_size_hint(cur);
+        return hint.is_exact() ? hint.size : size_t(-1);
+    }
+
+    // the elements of the first cursor followed by the elements of the second
+    template <class Cursor1, class Cursor2>
+    struct concat_cursor
+    {
+        typedef typename Cursor1::element_type element_type;
+        typedef element_type reference_type;
+        typedef typename util::min_cursor_category<
+            typename Cursor1::cursor_category, 
+            typename Cursor2::cursor_category, 
+            forward_cursor_tag>::type cursor_category;
+
+        concat_cursor(Cursor1 cur1, Cursor2 cur2) : cur1(std::move(cur1)), cur2(std::move(cur2)) {}
+
+        bool empty() const { return cur1.empty() && cur2.empty(); }
+        void inc() {
+            if (!cur1.empty()) { cur1.inc(); }
+            else               { cur2.inc(); }
+        }
+        reference_type get() const { return !cur1.empty() ? cur1.get() : cur2.get(); }
+
+    private:
+        Cursor1 cur1;
+        Cursor2 cur2;
+    };
+}
+
+// streams the inner cursor, checking each element against a hash set. When
+//   keep is set an element passes if it is removed from the set, otherwise
+//   it passes if it is added to the set. Either way an element passes at
+//   most once. Each copy of the cursor owns a copy of the set, so that
+//   copies advance independently.
+template <class Cursor, class Hash, class Equal>
+class linq_set_cursor
+{
+public:
+    typedef typename Cursor::element_type
+        element_type;
+
+    typedef typename Cursor::reference_type
+        reference_type;
+
+    typedef typename util::min_cursor_category<typename Cursor::cursor_category, forward_cursor_tag>::type
+        cursor_category;
+
+    typedef std::unordered_set<element_type, Hash, Equal>
+        set_type;
+
+    linq_set_cursor(Cursor cur, set_type set, bool keep)
+    : cur(std::move(cur)), set(std::move(set)), keep(keep)
+    {
+        settle();
+    }
+
+    bool empty() const { return cur.empty(); }
+    void inc() {
+        cur.inc();
+        settle();
+    }
+    reference_type get() const { return cur.get(); }
+
+private:
+    // moves to the next element that passes
+    void settle() {
+        while (!cur.empty()) {
+            if (keep ? set.erase(cur.get()) != 0 : set.insert(util::as_lvalue(cur.get())).second) {
+                break;
+            }
+            cur.inc();
+        }
+    }
+
+    Cursor cur;
+    set_type set;
+    bool keep;
+};
+
+template <class Collection, class Hash = default_hash, class Equal = default_equality>
+class linq_distinct
+{
+    typedef typename Collection::cursor
+        inner_cursor;
+public:
+    typedef linq_set_cursor<inner_cursor, Hash, Equal>
+        cursor;
+
+    linq_distinct(Collection c, Hash hash = Hash(), Equal equal = Equal())
+    : c(c), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        return cursor(c.get_cursor(), typename cursor::set_type(0, hash, equal), false);
+    }
+
+private:
+    Collection c;
+    Hash hash;
+    Equal equal;
+};
+
+template <class Collection, class Second, class Hash = default_hash, class Equal = default_equality>
+class linq_union
+{
+    typedef detail::concat_cursor<typename Collection::cursor, typename Second::cursor>
+        inner_cursor;
+public:
+    typedef linq_set_cursor<inner_cursor, Hash, Equal>
+        cursor;
+
+    linq_union(Collection c, Second second, Hash hash = Hash(), Equal equal = Equal())
+    : c(c), second(second), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        return cursor(inner_cursor(c.get_cursor(), second.get_cursor()), typename cursor::set_type(0, hash, equal), false);
+    }
+
+private:
+    Collection c;
+    Second second;
+    Hash hash;
+    Equal equal;
+};
+
+// the set is built from whichever input is known to be smaller, and
+//   the first input is then streamed against it
+template <class Collection, class Second, class Hash = default_hash, class Equal = default_equality>
+class linq_intersect
+{
+    typedef typename Collection::cursor
+        inner_cursor;
+public:
+    typedef linq_set_cursor<inner_cursor, Hash, Equal>
+        cursor;
+
+    linq_intersect(Collection c, Second second, Hash hash = Hash(), Equal equal = Equal())
+    : c(c), second(second), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        auto cur = c.get_cursor();
+        auto other = second.get_cursor();
+        typename cursor::set_type members(0, hash, equal);
+        if (detail::known_size(cur) < detail::known_size(other)) {
+            // the members of the first input that the second contains
+            typename cursor::set_type candidates(0, hash, equal);
+            for (auto first = cur; !first.empty(); first.inc()) {
+                candidates.insert(first.get());
+            }
+            for (; !other.empty() && !candidates.empty(); other.inc()) {
+                auto found = candidates.find(other.get());
+                if (found != candidates.end()) {
+                    members.insert(*found);
+                    candidates.erase(found);
+                }
+            }
+        } else {
+            for (; !other.empty(); other.inc()) {
+                members.insert(other.get());
+            }
+        }
+        return cursor(std::move(cur), std::move(members), true);
+    }
+
+private:
+    Collection c;
+    Second second;
+    Hash hash;
+    Equal equal;
+};
+
+// the set is built from whichever input is known to be smaller, and
+//   the first input is then streamed against it
+template <class Collection, class Second, class Hash = default_hash, class Equal = default_equality>
+class linq_except
+{
+    typedef typename Collection::cursor
+        inner_cursor;
+public:
+    typedef linq_set_cursor<inner_cursor, Hash, Equal>
+        cursor;
+
+    linq_except(Collection c, Second second, Hash hash = Hash(), Equal equal = Equal())
+    : c(c), second(second), hash(hash), equal(equal)
+    {
+    }
+
+    cursor get_cursor() const {
+        auto cur = c.get_cursor();
+        auto other = second.get_cursor();
+        typename cursor::set_type set(0, hash, equal);
+        if (detail::known_size(cur) < detail::known_size(other)) {
+            // keep the members of the first input that the second lacks
+            for (auto first = cur; !first.empty(); first.inc()) {
+                set.insert(first.get());
+            }
+            for (; !other.empty() && !set.empty(); other.inc()) {
+                set.erase(other.get());
+            }
+            return cursor(std::move(cur), std::move(set), true);
+        }
+        // skip the members of the second input
+        for (; !other.empty(); other.inc()) {
+            set.insert(other.get());
+        }
+        return cursor(std::move(cur), std::move(set), false);
+    }
+
+private:
+    Collection c;
+    Second second;
+    Hash hash;
+    Equal equal;
+};
+
+}
+
+#endif // !defined(CPPLINQ_LINQ_SETOPS_HPP)
+
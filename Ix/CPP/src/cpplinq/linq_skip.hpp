@@ -6,6 +6,26 @@
 
 namespace cpplinq 
 {
+    namespace detail {
+        template <class Cursor>
+        Cursor skip_get_cursor_(Cursor cur, size_t n, onepass_cursor_tag)
+        {
+            while(n-- && !cur.empty()) {
+                cur.inc();
+            }
+            cur.forget();
+            return cur;
+        }
+
+        template <class Cursor>
+        Cursor skip_get_cursor_(Cursor cur, size_t n, random_access_cursor_tag)
+        {
+            cur.skip(std::min(n, cur.size() - cur.position()));
+            cur.forget();
+            return cur;
+        }
+    }
+
     template <class Collection>
     struct linq_skip
     {
@@ -15,10 +35,27 @@ namespace cpplinq
         linq_skip(const Collection& c, size_t n) : c(c), n(n) {}
 
         cursor get_cursor() const {
-            size_t rem = n;
+            return detail::skip_get_cursor_(c.get_cursor(), n, typename cursor::cursor_category());
+        }
 
+    private:
+        Collection  c;
+        size_t      n;
+    };
+
+    // skips the leading elements for which the predicate is true when the 
+    //   cursor is requested, and keeps the powers of the input
+    template <class Collection, class Predicate>
+    struct linq_skip_while
+    {
+    public:
+        typedef typename Collection::cursor cursor;
+
+        linq_skip_while(const Collection& c, Predicate pred) : c(c), pred(pred) {}
+
+        cursor get_cursor() const {
             auto cur = c.get_cursor();
-            while(rem-- && !cur.empty()) {
+            while (!cur.empty() && pred(util::as_lvalue(cur.get()))) {
                 cur.inc();
             }
             cur.forget();
@@ -27,7 +64,7 @@ namespace cpplinq
 
     private:
         Collection  c;
-        size_t      n;
+        Predicate   pred;
     };
 }
 #endif // !defined(CPPLINQ_LINQ_SKIP_HPP)
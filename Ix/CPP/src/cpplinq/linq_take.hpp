@@ -26,6 +26,8 @@ namespace cpplinq
         void skip(size_t n) { cur.skip(n); rem -= n; }
         size_t position() const { return cur.position(); }
         size_t size() const { return cur.size(); }
+
+        cpplinq::size_hint size_hint() const { return detail::get_size_hint(cur).taken(rem); }
             
     private:
         InnerCursor cur;
@@ -53,9 +55,7 @@ namespace cpplinq
                 )
         {
             auto cur = c.get_cursor();
-            if (cur.size() > n) {
-                cur.truncate(n);
-            }
+            cur.truncate(n);
             return cur;
         }
     }
@@ -91,6 +91,52 @@ namespace cpplinq
     }
 
 
+    // ends at the first element for which the predicate is false. The 
+    //   predicate is called once per element, and the inner cursor is not 
+    //   read past that element.
+    template <class InnerCursor, class Predicate>
+    struct linq_take_while_cursor
+    {
+        typedef typename InnerCursor::element_type element_type;
+        typedef typename InnerCursor::reference_type reference_type;
+        typedef typename util::min_cursor_category<
+            typename InnerCursor::cursor_category, 
+            forward_cursor_tag>::type cursor_category;
+
+        linq_take_while_cursor(const InnerCursor& cur, const Predicate& pred) 
+        : cur(cur), pred(pred), done(false) 
+        {
+            settle();
+        }
+
+        void forget() { cur.forget(); }
+        bool empty() const { return done; }
+        void inc() { cur.inc(); settle(); }
+        reference_type get() const { return cur.get(); }
+
+    private:
+        void settle() { done = cur.empty() || !pred(util::as_lvalue(cur.get())); }
+
+        InnerCursor cur;
+        Predicate   pred;
+        bool        done;
+    };
+
+    template <class Collection, class Predicate>
+    struct linq_take_while
+    {
+        typedef linq_take_while_cursor<typename Collection::cursor, Predicate> 
+            cursor;
+
+        linq_take_while(const Collection& c, Predicate pred) : c(c), pred(pred) {}
+
+        cursor get_cursor() const {
+            return cursor(c.get_cursor(), pred);
+        }
+
+        Collection  c;
+        Predicate   pred;
+    };
 }
 #endif // !defined(CPPLINQ_LINQ_TAKE_HPP)
 
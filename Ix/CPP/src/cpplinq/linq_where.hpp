@@ -24,7 +24,7 @@ namespace cpplinq
 
             cursor(const inner_cursor& cur, const Predicate& p) : cur(cur), pred(p)
             {
-                if (!cur.empty() && !pred(cur.get())) {
+                if (!cur.empty() && !pred(util::as_lvalue(cur.get()))) {
                     this->inc();
                 }
             }
@@ -34,7 +34,7 @@ namespace cpplinq
             void inc() { 
                 for (;;) {
                     cur.inc();
-                    if (cur.empty() || pred(cur.get())) break;
+                    if (cur.empty() || pred(util::as_lvalue(cur.get()))) break;
                 }
             }
             reference_type get() const { 
@@ -45,9 +45,12 @@ namespace cpplinq
             void dec() {
                 for (;;) {
                     cur.dec();
-                    if (pred(cur.get())) break;
+                    if (pred(util::as_lvalue(cur.get()))) break;
                 }
             }
+
+            // the predicate may drop any of the elements that remain
+            cpplinq::size_hint size_hint() const { return detail::get_size_hint(cur).filtered(); }
         private:
             inner_cursor cur;
             Predicate pred;
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_ZIP_HPP)
+#define CPPLINQ_LINQ_ZIP_HPP
+#pragma once
+
+namespace cpplinq
+{
+    // moves two cursors in lockstep, ending with the shorter one
+    template <class Collection, class Second, class Selector>
+    class linq_zip
+    {
+        typedef typename Collection::cursor
+            cursor1;
+        typedef typename Second::cursor
+            cursor2;
+    public:
+        struct cursor {
+            typedef typename util::result_of<Selector(typename cursor1::element_type, typename cursor2::element_type)>::type
+                reference_type;
+            typedef typename std::remove_reference<reference_type>::type
+                element_type;
+            typedef typename util::min_cursor_category<
+                typename cursor1::cursor_category,
+                typename cursor2::cursor_category>::type
+                cursor_category;
+
+            cursor(cursor1 cur1, cursor2 cur2, Selector sel)
+            : cur1(std::move(cur1)), cur2(std::move(cur2)), sel(std::move(sel))
+            {
+            }
+
+            void forget() { cur1.forget(); cur2.forget(); }
+            bool empty() const { return cur1.empty() || cur2.empty(); }
+            void inc() { cur1.inc(); cur2.inc(); }
+            reference_type get() const { return sel(cur1.get(), cur2.get()); }
+
+            bool atbegin() const { return cur1.atbegin(); }
+            void dec() { cur1.dec(); cur2.dec(); }
+
+            void skip(size_t n) { cur1.skip(n); cur2.skip(n); }
+            size_t position() const { return cur1.position(); }
+            size_t size() const {
+                return cur1.position() + std::min(cur1.size() - cur1.position(), cur2.size() - cur2.position());
+            }
+            void truncate(size_t n) { cur1.truncate(n); cur2.truncate(n); }
+
+        private:
+            cursor1     cur1;
+            cursor2     cur2;
+            Selector    sel;
+        };
+
+        linq_zip(const Collection& c, const Second& second, Selector sel)
+        : c(c), second(second), sel(sel)
+        {
+        }
+
+        cursor get_cursor() const { return cursor(c.get_cursor(), second.get_cursor(), sel); }
+
+    private:
+        Collection c;
+        Second second;
+        Selector sel;
+    };
+
+    namespace detail {
+        template <class Cursor1, class Cursor2, class Equal>
+        bool sequence_equal_walk_(Cursor1 cur1, Cursor2 cur2, Equal equal)
+        {
+            for (; !cur1.empty() && !cur2.empty(); cur1.inc(), cur2.inc()) {
+                if (!equal(cur1.get(), cur2.get())) {
+                    return false;
+                }
+            }
+            return cur1.empty() && cur2.empty();
+        }
+
+        template <class Cursor1, class Cursor2, class Equal>
+        bool sequence_equal_(Cursor1 cur1, Cursor2 cur2, Equal equal, onepass_cursor_tag)
+        {
+            return sequence_equal_walk_(std::move(cur1), std::move(cur2), std::move(equal));
+        }
+
+        // sequences of different length are never equal
+        template <class Cursor1, class Cursor2, class Equal>
+        bool sequence_equal_(Cursor1 cur1, Cursor2 cur2, Equal equal, random_access_cursor_tag)
+        {
+            if (cur1.size() - cur1.position() != cur2.size() - cur2.position()) {
+                return false;
+            }
+            return sequence_equal_walk_(std::move(cur1), std::move(cur2), std::move(equal));
+        }
+
+        // true when elements of both can be compared as bytes
+        template <class Iter1, class Iter2>
+        struct is_memcmp_comparable
+        {
+            typedef typename std::remove_cv<typename std::iterator_traits<Iter1>::value_type>::type
+                value_type;
+
+            enum { value =
+                       util::is_contiguous_iterator<Iter1>::value
+                       && util::is_contiguous_iterator<Iter2>::value
+                       && std::is_same<value_type, typename std::remove_cv<typename std::iterator_traits<Iter2>::value_type>::type>::value
+                       && (std::is_integral<value_type>::value || std::is_enum<value_type>::value || std::is_pointer<value_type>::value)
+            };
+        };
+
+        template <class Iter1, class Iter2>
+        bool sequence_equal_memory_(iter_cursor<Iter1> cur1, iter_cursor<Iter2> cur2, std::true_type)
+        {
+            auto n = cur1.end_iterator() - cur1.current_iterator();
+            if (n != cur2.end_iterator() - cur2.current_iterator()) {
+                return false;
+            }
+            return n == 0 ||
+                std::memcmp(&*cur1.current_iterator(), &*cur2.current_iterator(), n * sizeof(*cur1.current_iterator())) == 0;
+        }
+
+        template <class Iter1, class Iter2>
+        bool sequence_equal_memory_(iter_cursor<Iter1> cur1, iter_cursor<Iter2> cur2, std::false_type)
+        {
+            return sequence_equal_(std::move(cur1), std::move(cur2), default_equality(),
+                typename util::min_cursor_category<
+                    typename iter_cursor<Iter1>::cursor_category,
+                    typename iter_cursor<Iter2>::cursor_category>::type());
+        }
+    }
+
+    template <class Cursor1, class Cursor2, class Equal>
+    bool linq_sequence_equal_(Cursor1 cur1, Cursor2 cur2, Equal equal)
+    {
+        return detail::sequence_equal_(std::move(cur1), std::move(cur2), std::move(equal),
+            typename util::min_cursor_category<
+                typename Cursor1::cursor_category,
+                typename Cursor2::cursor_category>::type());
+    }
+
+    // with the default equality, vectors and arrays of integral elements
+    //   are compared as memory
+    template <class Iter1, class Iter2>
+    bool linq_sequence_equal_(iter_cursor<Iter1> cur1, iter_cursor<Iter2> cur2, default_equality)
+    {
+        return detail::sequence_equal_memory_(std::move(cur1), std::move(cur2),
+            std::integral_constant<bool, detail::is_memcmp_comparable<Iter1, Iter2>::value>());
+    }
+}
+
+#endif // !defined(CPPLINQ_LINQ_ZIP_HPP)
+
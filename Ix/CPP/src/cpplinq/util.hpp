@@ -111,6 +111,11 @@ namespace cpplinq { namespace util {
     using std::result_of;
 #endif
 
+    // an element as an lvalue, so that a function that only looks at it 
+    //   cannot move from it, even when the cursor gives up its elements
+    template <class T>
+    T& as_lvalue(T&& t) { return t; }
+
     template<class Type>
     struct identity 
     {
@@ -192,13 +197,12 @@ namespace cpplinq { namespace util {
             return is_set ? reinterpret_cast<const T*>(&storage) : 0;
         }
 
+        // constructs rather than assigns, as cursors holding lambdas 
+        //   cannot be assigned
         void set(T value) {
-            if (is_set) {
-                *reinterpret_cast<T*>(&storage) = std::move(value);
-            } else {
-                new (reinterpret_cast<T*>(&storage)) T(std::move(value));
-                is_set = true;
-            }
+            reset();
+            new (reinterpret_cast<T*>(&storage)) T(std::move(value));
+            is_set = true;
         }
 
         T& operator*() { return *get(); }
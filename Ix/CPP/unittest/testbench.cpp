@@ -259,6 +259,571 @@ TEST(test_groupby)
     }
 }
 
+TEST(test_groupby_order)
+{
+    int data[] = {5, 12, 7, 22, 15, 2, 17};
+    std::vector<int> xs(std::begin(data), std::end(data));
+    auto grouped = 
+        from(xs)
+        .groupby([](int i){return i % 10; });
+
+    VERIFY_EQ(3, from(grouped).count());
+
+    std::vector<int> keys, firsts, sizes;
+    for(auto group = begin(grouped); group != end(grouped); ++group) {
+        auto g = *group;
+        keys.push_back(g.key);
+        firsts.push_back(*g.begin());
+        sizes.push_back(static_cast<int>(std::distance(g.begin(), g.end())));
+    }
+    // groups in the order of their first element, elements in input order
+    VERIFY_EQ(5, keys[0]);  VERIFY_EQ(5, firsts[0]);  VERIFY_EQ(2, sizes[0]);
+    VERIFY_EQ(2, keys[1]);  VERIFY_EQ(12, firsts[1]); VERIFY_EQ(3, sizes[1]);
+    VERIFY_EQ(7, keys[2]);  VERIFY_EQ(7, firsts[2]);  VERIFY_EQ(2, sizes[2]);
+}
+
+struct mod3_hash
+{
+    size_t operator()(int i) const { return i % 3; }
+};
+struct mod3_equal
+{
+    bool operator()(int a, int b) const { return a % 3 == b % 3; }
+};
+
+TEST(test_groupby_hash)
+{
+    int data[] = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<int> xs(std::begin(data), std::end(data));
+    auto grouped = 
+        from(xs)
+        .groupby([](int i){return i; }, mod3_hash(), mod3_equal());
+
+    VERIFY_EQ(3, from(grouped).count());
+    auto first = grouped.first();
+    VERIFY_EQ(1, first.key);
+    VERIFY_EQ(3, std::distance(first.begin(), first.end()));
+}
+
+TEST(test_groupby_lazy)
+{
+    int data[] = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<int> xs(std::begin(data), std::end(data));
+    int pulled = 0;
+    auto grouped = 
+        from(xs)
+        .select([&](int i){ ++pulled; return i; })
+        .groupby([](int i){return i % 3; });
+
+    auto first = grouped.first();
+    VERIFY_EQ(1, first.key);
+    VERIFY_EQ(1, pulled);
+
+    auto elem = first.begin();
+    VERIFY_EQ(1, *elem);
+    ++elem;
+    VERIFY_EQ(4, *elem);
+    VERIFY_EQ(4, pulled);
+
+    VERIFY_EQ(3, std::distance(first.begin(), first.end()));
+    VERIFY_EQ(7, pulled);
+}
+
+TEST(test_groupby_adjacent)
+{
+    int data[] = {1, 1, 2, 3, 3, 3, 1};
+    std::vector<int> xs(std::begin(data), std::end(data));
+    auto grouped = 
+        from(xs)
+        .groupby_adjacent([](int i){return i; });
+
+    VERIFY_EQ(4, from(grouped).count());
+
+    std::vector<int> keys, sizes;
+    for(auto group = begin(grouped); group != end(grouped); ++group) {
+        auto g = *group;
+        keys.push_back(g.key);
+        sizes.push_back(static_cast<int>(std::distance(g.begin(), g.end())));
+    }
+    // a key that reappears later starts a new group
+    VERIFY_EQ(1, keys[0]); VERIFY_EQ(2, sizes[0]);
+    VERIFY_EQ(2, keys[1]); VERIFY_EQ(1, sizes[1]);
+    VERIFY_EQ(3, keys[2]); VERIFY_EQ(3, sizes[2]);
+    VERIFY_EQ(1, keys[3]); VERIFY_EQ(1, sizes[3]);
+
+    // groups refer to the elements of the input
+    auto third = grouped.element_at(2);
+    VERIFY_EQ(&xs[3], &*third.begin());
+}
+
+TEST(test_orderby)
+{
+    int data[] = {5, 12, 7, 22, 15, 2, 17};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    // stable: elements with equal keys stay in input order
+    auto ordered = from(xs).order_by([](int i){return i % 10; }).to_vector();
+    int expected[] = {12, 22, 2, 5, 15, 7, 17};
+    VERIFY(std::equal(ordered.begin(), ordered.end(), std::begin(expected)));
+
+    auto descending = from(xs).order_by_descending([](int i){return i; }).to_vector();
+    int expectedDescending[] = {22, 17, 15, 12, 7, 5, 2};
+    VERIFY(std::equal(descending.begin(), descending.end(), std::begin(expectedDescending)));
+
+    // the input is left as it was
+    VERIFY(std::equal(xs.begin(), xs.end(), std::begin(data)));
+}
+
+TEST(test_orderby_then_by)
+{
+    int data[] = {5, 12, 7, 22, 15, 2, 17};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    auto ordered = 
+        from(xs)
+        .order_by([](int i){return i % 10; })
+        .then_by_descending([](int i){return i; })
+        .to_vector();
+    int expected[] = {22, 12, 2, 15, 5, 17, 7};
+    VERIFY(std::equal(ordered.begin(), ordered.end(), std::begin(expected)));
+
+    auto reordered = 
+        from(xs)
+        .order_by_descending([](int i){return i % 10; })
+        .then_by([](int i){return i; })
+        .to_vector();
+    int expectedReordered[] = {7, 17, 5, 15, 2, 12, 22};
+    VERIFY(std::equal(reordered.begin(), reordered.end(), std::begin(expectedReordered)));
+}
+
+TEST(test_orderby_take)
+{
+    int data[] = {5, 12, 7, 22, 15, 2, 17};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    auto top = from(xs).order_by([](int i){return i; }).take(3).to_vector();
+    VERIFY_EQ(3, top.size());
+    int expected[] = {2, 5, 7};
+    VERIFY(std::equal(top.begin(), top.end(), std::begin(expected)));
+
+    auto ordered = from(xs).order_by([](int i){return i; });
+    VERIFY_EQ(2, ordered.first());
+    VERIFY_EQ(22, ordered.last());
+    VERIFY_EQ(15, ordered.element_at(4));
+    VERIFY_EQ(7, ordered.count());
+}
+
+TEST(test_distinct)
+{
+    int data[] = {3, 1, 3, 2, 1, 4};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    auto unique = from(xs).distinct().to_vector();
+    int expected[] = {3, 1, 2, 4};
+    VERIFY_EQ(4, unique.size());
+    VERIFY(std::equal(unique.begin(), unique.end(), std::begin(expected)));
+
+    VERIFY_EQ(3, from(xs).distinct(mod3_hash(), mod3_equal()).count());
+}
+
+TEST(test_union_with)
+{
+    int data1[] = {3, 1, 3, 2};
+    int data2[] = {2, 5, 1, 6, 5};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    auto both = from(xs).union_with(from(ys)).to_vector();
+    int expected[] = {3, 1, 2, 5, 6};
+    VERIFY_EQ(5, both.size());
+    VERIFY(std::equal(both.begin(), both.end(), std::begin(expected)));
+}
+
+TEST(test_intersect_except)
+{
+    int data1[] = {4, 1, 3, 4, 2, 7};
+    int data2[] = {2, 9, 4, 8, 4, 10, 11, 12};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    // the set is built from the first input, which is smaller
+    auto common = from(xs).intersect(from(ys)).to_vector();
+    int expectedCommon[] = {4, 2};
+    VERIFY_EQ(2, common.size());
+    VERIFY(std::equal(common.begin(), common.end(), std::begin(expectedCommon)));
+
+    auto rest = from(xs).except(from(ys)).to_vector();
+    int expectedRest[] = {1, 3, 7};
+    VERIFY_EQ(3, rest.size());
+    VERIFY(std::equal(rest.begin(), rest.end(), std::begin(expectedRest)));
+
+    // the set is built from the second input, which is smaller
+    auto commonReversed = from(ys).intersect(from(xs)).to_vector();
+    int expectedCommonReversed[] = {2, 4};
+    VERIFY_EQ(2, commonReversed.size());
+    VERIFY(std::equal(commonReversed.begin(), commonReversed.end(), std::begin(expectedCommonReversed)));
+
+    auto restReversed = from(ys).except(from(xs)).to_vector();
+    int expectedRestReversed[] = {9, 8, 10, 11, 12};
+    VERIFY_EQ(5, restReversed.size());
+    VERIFY(std::equal(restReversed.begin(), restReversed.end(), std::begin(expectedRestReversed)));
+}
+
+TEST(test_join)
+{
+    int data1[] = {13, 4, 21, 7, 33};
+    int data2[] = {1, 2, 11, 3, 31, 5};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    // pairs with equal last digits
+    auto joined = 
+        from(xs)
+        .join(from(ys), 
+              [](int i){return i % 10; }, 
+              [](int i){return i % 10; }, 
+              [](int x, int y){return x * 100 + y; })
+        .to_vector();
+    int expected[] = {1303, 2101, 2111, 2131, 3303};
+    VERIFY_EQ(5, joined.size());
+    VERIFY(std::equal(joined.begin(), joined.end(), std::begin(expected)));
+}
+
+TEST(test_group_join)
+{
+    int data1[] = {13, 4, 21};
+    int data2[] = {1, 3, 11, 23};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    auto counts = 
+        from(xs)
+        .group_join(from(ys), 
+              [](int i){return i % 10; }, 
+              [](int i){return i % 10; }, 
+              [](int x, group<std::vector<int>::const_iterator, int> g){
+                  return static_cast<int>(std::distance(g.begin(), g.end())); })
+        .to_vector();
+    int expected[] = {2, 0, 2};
+    VERIFY_EQ(3, counts.size());
+    VERIFY(std::equal(counts.begin(), counts.end(), std::begin(expected)));
+}
+
+TEST(test_merge_join)
+{
+    int data1[] = {1, 2, 2, 4, 6, 9};
+    int data2[] = {2, 2, 3, 4, 4, 6, 7};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    auto joined = 
+        from(xs)
+        .merge_join(from(ys), 
+              [](int i){return i; }, 
+              [](int i){return i; }, 
+              [](int x, int y){return x * 10 + y; })
+        .to_vector();
+    // each outer element walks its run of inner elements
+    int expected[] = {22, 22, 22, 22, 44, 44, 66};
+    VERIFY_EQ(7, joined.size());
+    VERIFY(std::equal(joined.begin(), joined.end(), std::begin(expected)));
+
+    auto hashed = 
+        from(xs)
+        .join(from(ys), 
+              [](int i){return i; }, 
+              [](int i){return i; }, 
+              [](int x, int y){return x * 10 + y; })
+        .to_vector();
+    VERIFY(hashed == joined);
+}
+
+TEST(test_parallel)
+{
+    std::vector<int> xs(1000);
+    std::iota(xs.begin(), xs.end(), 1);
+
+    auto evens = from(xs).parallel(4).where([](int i){return i % 2 == 0; });
+    VERIFY_EQ(500, evens.count());
+    VERIFY_EQ(250500, evens.sum());
+    VERIFY_EQ(1000, evens.aggregate([](int a, int b){return std::max(a, b); }));
+
+    // partial results are merged in input order
+    auto squares = from(xs).parallel(3).select([](int i){return i * i; }).to_vector();
+    VERIFY_EQ(1000, squares.size());
+    VERIFY(from(xs).select([](int i){return i * i; }).to_vector() == squares);
+
+    auto total = 
+        from(xs).parallel()
+        .aggregate(0LL, 
+                   [](long long sum, int i){return sum + i; }, 
+                   [](long long a, long long b){return a + b; });
+    VERIFY_EQ(500500LL, total);
+
+    // more threads than elements
+    std::vector<int> few(2, 7);
+    VERIFY_EQ(14, from(few).parallel(8).sum());
+}
+
+TEST(test_random_access)
+{
+    std::vector<int> xs(1000);
+    std::iota(xs.begin(), xs.end(), 0);
+    int selected = 0;
+    auto q = 
+        from(xs)
+        .select([&](int i){ ++selected; return i * 2; });
+
+    // random access passes through select, skip and take, so the
+    //   selector only runs for the elements that are read
+    VERIFY_EQ(1800, q.element_at(900));
+    VERIFY_EQ(1, selected);
+
+    auto middle = q.skip(100).take(50);
+    VERIFY_EQ(50, middle.count());
+    VERIFY_EQ(200, middle.first());
+    VERIFY_EQ(298, middle.last());
+    VERIFY_EQ(240, middle.element_at(20));
+    VERIFY_EQ(4, selected);
+
+    VERIFY_EQ(0, q.skip(2000).count());
+    VERIFY_EQ(1000, q.take(2000).count());
+    VERIFY_EQ(0, q.skip(10).element_at_or_default(990));
+    VERIFY_EQ(4, selected);
+}
+
+TEST(test_sum_average)
+{
+    std::vector<int> xs(1001);
+    std::iota(xs.begin(), xs.end(), 0);
+
+    VERIFY_EQ(500500, from(xs).sum());
+    VERIFY_EQ(500.0, from(xs).average());
+    VERIFY_EQ(250500, from(xs).where([](int i){return i % 2 == 0; }).sum());
+    VERIFY_EQ(1001000, from(xs).sum([](int i){return 2 * i; }));
+    VERIFY_EQ(0.5, from(xs).average([](int i){return i % 2; }) + 0.5 / 1001);
+
+    std::vector<double> ds(10, 0.25);
+    VERIFY_EQ(2.5, from(ds).sum());
+    VERIFY_EQ(0.25, from(ds).average());
+
+    std::vector<int> none;
+    VERIFY_EQ(0, from(none).sum());
+    bool thrown = false;
+    try { from(none).average(); } catch (std::logic_error&) { thrown = true; }
+    VERIFY(thrown);
+}
+
+TEST(test_min_max)
+{
+    int data[] = {4, 9, 1, 9, 1, 3};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    VERIFY_EQ(1, from(xs).min());
+    VERIFY_EQ(9, from(xs).max());
+    // the first of equal elements, as std::max_element
+    VERIFY_EQ(&xs[1], &from(xs).max());
+    VERIFY_EQ(&xs[2], &from(xs).min());
+
+    auto q = from(xs).where([](int i){return i != 9; });
+    VERIFY_EQ(4, q.max());
+    VERIFY_EQ(1, q.min());
+    VERIFY_EQ(-9, from(xs).select([](int i){return -i; }).min());
+
+    std::vector<int> none;
+    bool thrown = false;
+    try { from(none).max(); } catch (std::logic_error&) { thrown = true; }
+    VERIFY(thrown);
+}
+
+TEST(test_zip)
+{
+    int data1[] = {1, 2, 3, 4};
+    int data2[] = {10, 20, 30};
+    std::vector<int> xs(std::begin(data1), std::end(data1));
+    std::vector<int> ys(std::begin(data2), std::end(data2));
+
+    auto sums = from(xs).zip(from(ys), [](int x, int y){return x + y; });
+    VERIFY_EQ(3, sums.count());
+    VERIFY_EQ(33, sums.last());
+    VERIFY_EQ(22, sums.element_at(1));
+    int expected[] = {11, 22, 33};
+    auto v = sums.to_vector();
+    VERIFY(std::equal(v.begin(), v.end(), std::begin(expected)));
+
+    auto odd = from(xs).where([](int i){return i % 2 == 1; })
+               .zip(from(ys), [](int x, int y){return x * y; })
+               .to_vector();
+    VERIFY_EQ(2, odd.size());
+    VERIFY_EQ(10, odd[0]);
+    VERIFY_EQ(60, odd[1]);
+}
+
+TEST(test_sequence_equal)
+{
+    int data[] = {1, 2, 3, 4};
+    std::vector<int> xs(std::begin(data), std::end(data));
+    std::vector<int> ys(xs);
+    std::vector<int> shorter(xs.begin(), xs.end() - 1);
+
+    VERIFY(from(xs).sequence_equal(from(ys)));
+    VERIFY(from(xs).sequence_equal(from(std::begin(data), std::end(data))));
+    VERIFY(!from(xs).sequence_equal(from(shorter)));
+    ys[3] = 5;
+    VERIFY(!from(xs).sequence_equal(from(ys)));
+
+    // equal after a projection, compared through the cursors
+    std::vector<int> tens;
+    for (int i : xs) { tens.push_back(i + 10); }
+    VERIFY(from(xs).sequence_equal(from(tens).select([](int i){return i - 10; })));
+    VERIFY(from(xs).sequence_equal(from(ys), [](int a, int b){return a % 5 == b % 5 || a == 4; }));
+
+    int pulled = 0;
+    auto counted = from(xs).where([&](int){ ++pulled; return true; });
+    VERIFY(!counted.sequence_equal(from(ys).where([](int){ return true; }), 
+                                   [](int a, int b){return a == b && a != 1; }));
+    VERIFY_EQ(1, pulled);
+}
+
+TEST(test_owned_move)
+{
+    std::vector<std::string> words;
+    words.push_back(std::string(100, 'a'));
+    words.push_back(std::string(100, 'b'));
+    words.push_back(std::string(100, 'c'));
+    const char* first = words[0].data();
+
+    // elements are moved out of an owned container, and the predicate of 
+    //   where only looks at them
+    auto v = from(std::move(words))
+             .where([](std::string s){ return s[0] != 'b'; })
+             .to_vector();
+    VERIFY_EQ(2, v.size());
+    VERIFY_EQ(std::string(100, 'a'), v[0]);
+    VERIFY_EQ(std::string(100, 'c'), v[1]);
+    VERIFY_EQ(first, v[0].data());
+
+    std::vector<std::string> names;
+    names.push_back("ann");
+    names.push_back("bob");
+    names.push_back("amy");
+    auto groups = from(std::move(names))
+                  .groupby([](std::string s){ return s[0]; })
+                  .to_vector();
+    VERIFY_EQ(2, groups.size());
+    VERIFY_EQ('a', groups[0].key);
+    auto as = from(groups[0]).to_vector();
+    VERIFY_EQ(2, as.size());
+    VERIFY_EQ(std::string("ann"), as[0]);
+    VERIFY_EQ(std::string("amy"), as[1]);
+
+    // lvalue containers are still read without being changed
+    std::vector<std::string> kept(2, "x");
+    VERIFY_EQ(2, from(kept).to_vector().size());
+    VERIFY_EQ(std::string("x"), kept[0]);
+}
+
+TEST(test_owned_skip)
+{
+    int data[] = {1, 2, 3, 4, 5};
+
+    // an owned container has the cursor category of its iterators
+    auto rest = from(std::vector<int>(std::begin(data), std::end(data))).skip(1).to_vector();
+    VERIFY_EQ(4, rest.size());
+    VERIFY_EQ(2, rest[0]);
+    VERIFY_EQ(5, rest[3]);
+
+    VERIFY_EQ(2, from(std::vector<int>(std::begin(data), std::end(data)))[1]);
+    VERIFY_EQ(4, from(std::vector<int>(std::begin(data), std::end(data))).element_at(3));
+    VERIFY_EQ(0, from(std::vector<int>(std::begin(data), std::end(data))).skip(10).count());
+
+    // the skipped elements are passed over without being moved from
+    std::vector<std::string> words(3, std::string(100, 'w'));
+    const char* last = words[2].data();
+    auto tail = from(std::move(words)).skip(2).to_vector();
+    VERIFY_EQ(1, tail.size());
+    VERIFY_EQ(last, tail[0].data());
+
+    std::list<int> xs(std::begin(data), std::end(data));
+    auto from_list = from(std::move(xs)).skip(3).to_vector();
+    VERIFY_EQ(2, from_list.size());
+    VERIFY_EQ(4, from_list[0]);
+}
+
+TEST(test_take_skip_while)
+{
+    int data[] = {1, 3, 5, 6, 7, 9};
+    std::vector<int> xs(std::begin(data), std::end(data));
+
+    // the input is not tested past the first even element
+    int tested = 0;
+    auto odd = from(xs).take_while([&](int i){ ++tested; return i % 2 == 1; }).to_vector();
+    VERIFY_EQ(3, odd.size());
+    VERIFY_EQ(5, odd[2]);
+    VERIFY_EQ(4, tested);
+
+    auto rest = from(xs).skip_while([](int i){ return i % 2 == 1; }).to_vector();
+    VERIFY_EQ(3, rest.size());
+    VERIFY_EQ(6, rest[0]);
+    VERIFY_EQ(9, rest[2]);
+
+    // skip_while keeps random access
+    VERIFY_EQ(7, from(xs).skip_while([](int i){ return i < 6; }).element_at(1));
+
+    VERIFY_EQ(0, from(xs).take_while([](int i){ return i > 1; }).count());
+    VERIFY_EQ(0, from(xs).skip_while([](int){ return true; }).count());
+    VERIFY_EQ(6, from(xs).take_while([](int){ return true; }).count());
+
+    // take_while stops at the same element when composed with where
+    auto small = from(xs).where([](int i){ return i != 3; })
+                 .take_while([](int i){ return i < 7; })
+                 .to_vector();
+    VERIFY_EQ(3, small.size());
+    VERIFY_EQ(6, small[2]);
+}
+
+TEST(test_size_hint)
+{
+    int data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::list<int> xs(std::begin(data), std::end(data));
+
+    // a list cannot measure itself, from() takes its size
+    auto all = cpplinq::detail::get_size_hint(from(xs).get_cursor());
+    VERIFY(all.is_exact());
+    VERIFY_EQ(8, all.size);
+
+    auto doubled = from(xs).select([](int i){ return i * 2; });
+    VERIFY(cpplinq::detail::get_size_hint(doubled.get_cursor()).is_exact());
+    VERIFY_EQ(8, doubled.count());
+
+    auto first = cpplinq::detail::get_size_hint(doubled.take(3).get_cursor());
+    VERIFY(first.is_exact());
+    VERIFY_EQ(3, first.size);
+
+    // where can only tell an upper bound, the elements from the first match on, 
+    //   and take keeps the smaller one
+    auto even = from(xs).where([](int i){ return i % 2 == 0; });
+    auto bound = cpplinq::detail::get_size_hint(even.get_cursor());
+    VERIFY(bound.is_known() && !bound.is_exact());
+    VERIFY_EQ(7, bound.size);
+    VERIFY_EQ(4, even.count());
+    VERIFY_EQ(5, cpplinq::detail::get_size_hint(even.take(5).get_cursor()).size);
+
+    // to_vector reserves once for an exact hint
+    auto taken = from(xs).take(5).to_vector();
+    VERIFY_EQ(5, taken.size());
+    VERIFY_EQ(5, taken.capacity());
+
+    // an owned container knows how many elements are left as they are moved out
+    auto cur = from(std::vector<int>(std::begin(data), std::end(data))).get_cursor();
+    cur.inc();
+    VERIFY_EQ(7, cpplinq::detail::get_size_hint(cur).size);
+
+    auto taken_even = even.take(3).to_vector();
+    VERIFY_EQ(3, taken_even.size());
+    VERIFY_EQ(6, taken_even[2]);
+}
+
 TEST(test_symbolname)
 {
     auto complexQuery = 
@@ -404,6 +969,43 @@ TEST(test_cursor_selectmany2)
     VERIFY( result.second == range2.end());
 }
 
+TEST(test_selectmany_flat)
+{
+    struct row { int key; std::vector<int> items; };
+    std::vector<row> rows;
+    rows.push_back(row{1, std::vector<int>()});
+    rows.push_back(row{2, std::vector<int>{1, 2}});
+    rows.push_back(row{3, std::vector<int>()});
+    rows.push_back(row{4, std::vector<int>{3, 4, 5}});
+
+    auto flat = from(rows).select_many([](const row& r){ return from(r.items); });
+
+    // the inner vectors are walked as pointers and skipped when empty
+    VERIFY_EQ(15, flat.sum());
+
+    // the size is the sum of the inner sizes
+    auto hint = cpplinq::detail::get_size_hint(flat.get_cursor());
+    VERIFY(hint.is_exact());
+    VERIFY_EQ(5, hint.size);
+
+    auto all = flat.to_vector();
+    VERIFY_EQ(5, all.size());
+    VERIFY_EQ(5, all.capacity());
+    VERIFY_EQ(1, all[0]);
+    VERIFY_EQ(5, all[4]);
+
+    auto keyed = from(rows)
+        .select_many([](const row& r){ return from(r.items); },
+                     [](const row& r, int i){ return r.key * 10 + i; })
+        .to_vector();
+    VERIFY_EQ(5, keyed.size());
+    VERIFY_EQ(21, keyed[0]);
+    VERIFY_EQ(45, keyed[4]);
+
+    std::vector<row> none;
+    VERIFY_EQ(0, from(none).select_many([](const row& r){ return from(r.items); }).count());
+}
+
 TEST(test_late_bind)
 {
     int_range range1(0, 100);
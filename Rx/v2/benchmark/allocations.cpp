@@ -0,0 +1,29 @@
+// replaces the global operator new to count the allocations of the
+// benchmarks. it is only linked into rxcppv2_bench_allocations so that the
+// timings of rxcppv2_bench do not include the count.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::uint64_t> allocations(0);
+}
+
+std::uint64_t allocation_count() {
+    return allocations.load();
+}
+
+// new[] and the nothrow forms call this one
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,17 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxs=rxcpp::sources;
+
+// each form of combine_latest with four sources
+
+void combine_latest() {
+    auto a = rxs::range(1, 10);
+    auto b = rxs::range(1L, 10L);
+    auto c = rxs::range(1.0, 10.0);
+    auto d = rxs::range(1, 10).map([](int v){return std::to_string(v);});
+
+    a.combine_latest(b, c, d).subscribe([](std::tuple<int, long, double, std::string>){});
+    a.combine_latest([](int, long, double, std::string s){return s;}, b, c, d).subscribe([](std::string){});
+    a.combine_latest(rx::identity_current_thread(), b, c, d).subscribe([](std::tuple<int, long, double, std::string>){});
+    a.combine_latest(rx::identity_current_thread(), [](int v, long, double, std::string){return v;}, b, c, d).subscribe([](int){});
+}
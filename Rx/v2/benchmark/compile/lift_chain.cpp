@@ -0,0 +1,22 @@
+#include "rxcpp/rx.hpp"
+namespace rxs=rxcpp::sources;
+
+// a chain of lifted operators, each adds a level to the type of the observable
+
+void lift_chain() {
+    rxs::range(1, 100)
+        .map([](int v){return v + 1;})
+        .filter([](int v){return v % 2 == 0;})
+        .map([](int v){return v * 3;})
+        .take(50)
+        .map([](int v){return long(v);})
+        .filter([](long v){return v != 0;})
+        .scan(0L, [](long s, long v){return s + v;})
+        .map([](long v){return v - 1;})
+        .skip(1)
+        .distinct_until_changed()
+        .map([](long v){return v / 2;})
+        .filter([](long v){return v > 10;})
+        .take(10)
+        .subscribe([](long){});
+}
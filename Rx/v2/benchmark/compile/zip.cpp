@@ -0,0 +1,17 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxs=rxcpp::sources;
+
+// each form of zip with four sources
+
+void zip() {
+    auto a = rxs::range(1, 10);
+    auto b = rxs::range(1L, 10L);
+    auto c = rxs::range(1.0, 10.0);
+    auto d = rxs::range(1, 10).map([](int v){return std::to_string(v);});
+
+    a.zip(b, c, d).subscribe([](std::tuple<int, long, double, std::string>){});
+    a.zip([](int, long, double, std::string s){return s;}, b, c, d).subscribe([](std::string){});
+    a.zip(rx::identity_current_thread(), b, c, d).subscribe([](std::tuple<int, long, double, std::string>){});
+    a.zip(rx::identity_current_thread(), [](int v, long, double, std::string){return v;}, b, c, d).subscribe([](int){});
+}
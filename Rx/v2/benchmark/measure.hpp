@@ -0,0 +1,37 @@
+#pragma once
+
+#if !defined(RXCPP_BENCHMARK_MEASURE_HPP)
+#define RXCPP_BENCHMARK_MEASURE_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#if defined(RXCPP_BENCHMARK_ALLOCATIONS)
+// the calls to operator new so far, on all threads. see allocations.cpp
+std::uint64_t allocation_count();
+#endif
+
+// calls run(count) in each iteration and reports the items per second. when
+// allocations are counted, it also reports the allocations of a subscribe and
+// of each item, from one run with one item and one with count + 1 items.
+template<class Run>
+void measure(benchmark::State& state, Run run, long count) {
+    for (auto _ : state) {
+        run(count);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+#if defined(RXCPP_BENCHMARK_ALLOCATIONS)
+    auto allocations = [&](long n){
+        auto before = allocation_count();
+        run(n);
+        return double(allocation_count() - before);
+    };
+    auto one = allocations(1);
+    auto per_item = (allocations(count + 1) - one) / count;
+    state.counters["allocs_per_subscribe"] = one - per_item;
+    state.counters["allocs_per_item"] = per_item;
+#endif
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxs=rxcpp::sources;
+
+#include "measure.hpp"
+
+// each benchmark sends range(0) values through one operator. the items/s
+// counter is the throughput of the operator.
+
+static void operator_map(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .map([](long v){return v * 2;})
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_map)->Arg(1000)->Arg(100000);
+
+static void operator_filter(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .filter([](long v){return v % 2 == 0;})
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_filter)->Arg(1000)->Arg(100000);
+
+// merges two sources of range(0) values each
+static void operator_merge(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .merge(rxs::range<long>(1, count))
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(operator_merge)->Arg(1000)->Arg(100000);
+
+// merges 16 sources of range(0) values, each on its own thread, through one
+// serializing coordination
+template<class Coordination>
+static void merge_serialized(benchmark::State& state, Coordination so) {
+    long sum = 0;
+    measure(state, [&](long count){
+        std::vector<rx::observable<long>> sources;
+        for (int i = 0; i != 16; ++i) {
+            sources.push_back(rxs::range<long>(1, count, 1, rx::observe_on_new_thread()).as_dynamic());
+        }
+        rxs::iterate(sources)
+            .merge(so)
+            .as_blocking()
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 16);
+}
+
+static void operator_merge_serialize(benchmark::State& state) {
+    merge_serialized(state, rx::serialize_event_loop());
+}
+BENCHMARK(operator_merge_serialize)->Arg(10000)->UseRealTime();
+
+static void operator_merge_serialize_drain(benchmark::State& state) {
+    merge_serialized(state, rx::serialize_drain_event_loop());
+}
+BENCHMARK(operator_merge_serialize_drain)->Arg(10000)->UseRealTime();
+
+static void operator_zip(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .zip(rxs::range<long>(1, count))
+            .subscribe([&](std::tuple<long, long> v){sum += std::get<0>(v) + std::get<1>(v);});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_zip)->Arg(1000)->Arg(100000);
+
+static void operator_group_by(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .group_by([](long v){return v % 16;}, [](long v){return v;})
+            .subscribe([&](const rx::grouped_observable<long, long>& g){
+                g.subscribe([&](long v){sum += v;});
+            });
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_group_by)->Arg(1000)->Arg(100000);
+
+static void operator_observe_on(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .observe_on(rx::observe_on_event_loop())
+            .as_blocking()
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_observe_on)->Arg(1000)->Arg(100000)->UseRealTime();
+
+// range(0) values produced on a new thread and delivered on an event loop
+// thread, so the producer and the consumer share the observe_on state from
+// different cores
+static void cross_core_observe_on(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .subscribe_on(rx::observe_on_new_thread())
+            .observe_on(rx::observe_on_event_loop())
+            .as_blocking()
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(cross_core_observe_on)->Arg(100000)->UseRealTime();
+
+// switches to a new inner for each of range(0) values
+static void operator_switch_map(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .switch_map([](long v){return rxs::range<long>(v, v);})
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_switch_map)->Arg(1000)->Arg(100000);
+
+// maps range(0) values on 4 event loop threads in order
+static void operator_parallel_map(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .parallel_map([](long v){return v * 2;}, rx::observe_on_event_loop(), 4)
+            .as_blocking()
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_parallel_map)->Arg(1000)->Arg(100000)->UseRealTime();
+
+// the same work with an inner observable for each value
+static void operator_parallel_map_flat_map(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .flat_map([](long v){
+                return rxs::range<long>(v, v)
+                    .subscribe_on(rx::observe_on_event_loop())
+                    .map([](long u){return u * 2;});
+            }, [](long, long u){return u;}, rx::serialize_event_loop())
+            .as_blocking()
+            .subscribe([&](long v){sum += v;});
+    }, state.range(0));
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(operator_parallel_map_flat_map)->Arg(1000)->Arg(100000)->UseRealTime();
@@ -0,0 +1,247 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+
+// each benchmark here is swept from 1 to 16 threads on one side of one of
+//   one_to_n - one producer sends to n consumers in turn
+//   n_to_one - n producers send to one consumer
+//   n_to_n   - n producers each send to a consumer of their own
+// besides the items per second, each reports
+//   items_per_core - the items per second divided by the threads that send
+//                    or consume
+//   p50_ns, p99_ns - the time from sending an item until it is consumed, of
+//                    one in sample_every items
+// the producers are the threads of the benchmark library, so that all of
+// them start and stop together.
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+const long items_per_producer = 1000;
+const long sample_every = 16;
+const int max_threads = 16;
+
+// the receiving end of the items of one producer. ran is read by the
+// producer, the rest is only used on the thread that consumes.
+struct consumer
+{
+    consumer()
+        : ran(0)
+        , seen(0)
+    {
+    }
+
+    void reset() {
+        ran = 0;
+        seen = 0;
+        latencies.clear();
+    }
+
+    void consume(clock_type::time_point sent) {
+        if (seen++ % sample_every == 0) {
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - sent).count());
+        }
+        ++ran;
+    }
+
+    void wait(long expected) const {
+        while (ran.load() != expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<long> ran;
+    rxu::detail::cache_line_pad ran_pad;
+    long seen;
+    std::vector<long long> latencies;
+    rxu::detail::cache_line_pad latencies_pad;
+};
+
+consumer consumers[max_threads];
+
+struct item
+{
+    clock_type::time_point sent;
+    consumer* to;
+};
+
+struct consume_item
+{
+    void operator()(const item& v) const {
+        v.to->consume(v.sent);
+    }
+};
+
+// call once all the items have been consumed, on one thread only
+void report(benchmark::State& state, int used, int cores, long items) {
+    std::vector<long long> all;
+    for (int i = 0; i != used; ++i) {
+        all.insert(all.end(), consumers[i].latencies.begin(), consumers[i].latencies.end());
+    }
+    state.SetItemsProcessed(items);
+    state.counters["items_per_core"] = benchmark::Counter(double(items) / cores, benchmark::Counter::kIsRate);
+    if (!all.empty()) {
+        std::sort(all.begin(), all.end());
+        state.counters["p50_ns"] = double(all[all.size() / 2]);
+        state.counters["p99_ns"] = double(all[all.size() * 99 / 100]);
+    }
+}
+
+}
+
+// one producer that sends to range(0) workers of sc in turn
+static void one_to_n(benchmark::State& state, rxsc::scheduler sc) {
+    int n = int(state.range(0));
+    std::vector<rxsc::worker> workers;
+    std::vector<long> expected(n, 0);
+    for (int i = 0; i != n; ++i) {
+        workers.push_back(sc.create_worker());
+        consumers[i].reset();
+    }
+    for (auto _ : state) {
+        for (long i = 0; i != items_per_producer; ++i) {
+            auto& c = consumers[i % n];
+            auto sent = clock_type::now();
+            workers[i % n].schedule([&c, sent](const rxsc::schedulable&){c.consume(sent);});
+            ++expected[i % n];
+        }
+        for (int i = 0; i != n; ++i) {
+            consumers[i].wait(expected[i]);
+        }
+    }
+    report(state, n, 1 + n, state.iterations() * items_per_producer);
+    for (auto& w : workers) {
+        w.unsubscribe();
+    }
+}
+
+// the producer threads send to one worker of sc
+static void n_to_one(benchmark::State& state, rxsc::scheduler sc) {
+    static rxu::maybe<rxsc::worker> target;
+    auto& c = consumers[state.thread_index()];
+    c.reset();
+    if (state.thread_index() == 0) {
+        target.reset(sc.create_worker());
+    }
+    long expected = 0;
+    for (auto _ : state) {
+        auto& w = target.get();
+        for (long i = 0; i != items_per_producer; ++i) {
+            auto sent = clock_type::now();
+            w.schedule([&c, sent](const rxsc::schedulable&){c.consume(sent);});
+        }
+        expected += items_per_producer;
+        c.wait(expected);
+    }
+    if (state.thread_index() == 0) {
+        report(state, state.threads(), state.threads() + 1, state.iterations() * items_per_producer * state.threads());
+        target.get().unsubscribe();
+        target.reset();
+    }
+}
+
+// each producer thread sends to a worker of sc of its own
+static void n_to_n(benchmark::State& state, rxsc::scheduler sc) {
+    auto& c = consumers[state.thread_index()];
+    c.reset();
+    auto w = sc.create_worker();
+    long expected = 0;
+    for (auto _ : state) {
+        for (long i = 0; i != items_per_producer; ++i) {
+            auto sent = clock_type::now();
+            w.schedule([&c, sent](const rxsc::schedulable&){c.consume(sent);});
+        }
+        expected += items_per_producer;
+        c.wait(expected);
+    }
+    w.unsubscribe();
+    if (state.thread_index() == 0) {
+        report(state, state.threads(), 2 * state.threads(), state.iterations() * items_per_producer * state.threads());
+    }
+}
+
+// the producer threads call on_next on one subscriber serialized by cn. the
+// calls are made on the producer threads, so the cores are the producers.
+template<class Coordination>
+static void serialize_n_to_one(benchmark::State& state, Coordination cn) {
+    typedef decltype(cn.create_coordinator().out(rx::make_subscriber<item>(consume_item()))) output_type;
+    static rxu::maybe<output_type> output;
+    auto& c = consumers[state.thread_index()];
+    c.reset();
+    if (state.thread_index() == 0) {
+        output.reset(cn.create_coordinator().out(rx::make_subscriber<item>(consume_item())));
+    }
+    long expected = 0;
+    for (auto _ : state) {
+        auto& o = output.get();
+        for (long i = 0; i != items_per_producer; ++i) {
+            item v = {clock_type::now(), &c};
+            o.on_next(v);
+        }
+        expected += items_per_producer;
+        c.wait(expected);
+    }
+    if (state.thread_index() == 0) {
+        report(state, state.threads(), state.threads(), state.iterations() * items_per_producer * state.threads());
+        output.get().unsubscribe();
+        output.reset();
+    }
+}
+
+// one producer sends to a subject with range(0) subscribers that each
+// observe on the event loop
+static void subject_one_to_n(benchmark::State& state) {
+    int n = int(state.range(0));
+    rxsub::subject<clock_type::time_point> sub;
+    for (int i = 0; i != n; ++i) {
+        auto& c = consumers[i];
+        c.reset();
+        sub.get_observable()
+            .observe_on(rx::observe_on_event_loop())
+            .subscribe([&c](clock_type::time_point sent){c.consume(sent);});
+    }
+    auto o = sub.get_subscriber();
+    long expected = 0;
+    for (auto _ : state) {
+        for (long i = 0; i != items_per_producer; ++i) {
+            o.on_next(clock_type::now());
+        }
+        expected += items_per_producer;
+        for (int i = 0; i != n; ++i) {
+            consumers[i].wait(expected);
+        }
+    }
+    report(state, n, 1 + n, state.iterations() * items_per_producer * n);
+    o.on_completed();
+}
+
+#define RXCPP_SCALING_SCHEDULER(Name, Make) \
+    static void one_to_n_##Name(benchmark::State& state) { one_to_n(state, Make()); } \
+    BENCHMARK(one_to_n_##Name)->RangeMultiplier(2)->Range(1, max_threads)->UseRealTime(); \
+    static void n_to_one_##Name(benchmark::State& state) { n_to_one(state, Make()); } \
+    BENCHMARK(n_to_one_##Name)->ThreadRange(1, max_threads)->UseRealTime(); \
+    static void n_to_n_##Name(benchmark::State& state) { n_to_n(state, Make()); } \
+    BENCHMARK(n_to_n_##Name)->ThreadRange(1, max_threads)->UseRealTime();
+
+RXCPP_SCALING_SCHEDULER(event_loop, rxsc::make_event_loop)
+RXCPP_SCALING_SCHEDULER(new_thread, rxsc::make_new_thread)
+RXCPP_SCALING_SCHEDULER(work_stealing, rxsc::make_work_stealing_pool)
+
+#define RXCPP_SCALING_SERIALIZE(Name) \
+    static void n_to_one_##Name(benchmark::State& state) { serialize_n_to_one(state, rx::Name()); } \
+    BENCHMARK(n_to_one_##Name)->ThreadRange(1, max_threads)->UseRealTime();
+
+RXCPP_SCALING_SERIALIZE(serialize_event_loop)
+RXCPP_SCALING_SERIALIZE(serialize_new_thread)
+RXCPP_SCALING_SERIALIZE(serialize_drain_event_loop)
+RXCPP_SCALING_SERIALIZE(serialize_drain_new_thread)
+
+BENCHMARK(subject_one_to_n)->RangeMultiplier(2)->Range(1, max_threads)->UseRealTime();
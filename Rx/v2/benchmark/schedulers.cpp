@@ -0,0 +1,153 @@
+#include "rxcpp/rx.hpp"
+#include "rxcpp/rx-test.hpp"
+namespace rx=rxcpp;
+namespace rxsc=rxcpp::schedulers;
+
+#include "measure.hpp"
+
+// the time from scheduling an action on another thread until it has run
+static void handoff(benchmark::State& state, rxsc::scheduler sc) {
+    auto w = sc.create_worker();
+    std::atomic<long> ran(0);
+    long expected = 0;
+    measure(state, [&](long count){
+        for (long i = 0; i != count; ++i) {
+            w.schedule([&](const rxsc::schedulable&){++ran;});
+            ++expected;
+            while (ran.load() != expected) {
+                std::this_thread::yield();
+            }
+        }
+    }, 1);
+    w.unsubscribe();
+}
+
+static void handoff_new_thread(benchmark::State& state) {
+    handoff(state, rxsc::make_new_thread());
+}
+BENCHMARK(handoff_new_thread)->UseRealTime();
+
+static void handoff_event_loop(benchmark::State& state) {
+    handoff(state, rxsc::make_event_loop());
+}
+BENCHMARK(handoff_event_loop)->UseRealTime();
+
+static void handoff_work_stealing(benchmark::State& state) {
+    handoff(state, rxsc::make_work_stealing_pool());
+}
+BENCHMARK(handoff_work_stealing)->UseRealTime();
+
+// schedules range(0) actions on another thread, one at a time or as a
+// batch, and waits until they have run
+static void fan_out(benchmark::State& state, rxsc::scheduler sc, bool batched) {
+    auto w = sc.create_worker();
+    std::atomic<long> ran(0);
+    long expected = 0;
+    measure(state, [&](long count){
+        if (batched) {
+            std::vector<rxsc::schedulable> batch;
+            for (long i = 0; i != count; ++i) {
+                batch.push_back(rxsc::make_schedulable(w, [&](const rxsc::schedulable&){++ran;}));
+            }
+            w.schedule_batch(batch);
+        } else {
+            for (long i = 0; i != count; ++i) {
+                w.schedule([&](const rxsc::schedulable&){++ran;});
+            }
+        }
+        expected += count;
+        while (ran.load() != expected) {
+            std::this_thread::yield();
+        }
+    }, state.range(0));
+    w.unsubscribe();
+}
+
+static void fan_out_event_loop(benchmark::State& state) {
+    fan_out(state, rxsc::make_event_loop(), false);
+}
+BENCHMARK(fan_out_event_loop)->Arg(100)->UseRealTime();
+
+static void fan_out_event_loop_batch(benchmark::State& state) {
+    fan_out(state, rxsc::make_event_loop(), true);
+}
+BENCHMARK(fan_out_event_loop_batch)->Arg(100)->UseRealTime();
+
+static void fan_out_work_stealing(benchmark::State& state) {
+    fan_out(state, rxsc::make_work_stealing_pool(), false);
+}
+BENCHMARK(fan_out_work_stealing)->Arg(100)->UseRealTime();
+
+static void fan_out_work_stealing_batch(benchmark::State& state) {
+    fan_out(state, rxsc::make_work_stealing_pool(), true);
+}
+BENCHMARK(fan_out_work_stealing_batch)->Arg(100)->UseRealTime();
+
+// schedules range(0) actions, spread over range(0) / 4 times, on a test
+// scheduler and then runs them in virtual time
+static void virtual_time_run(benchmark::State& state) {
+    long ran = 0;
+    measure(state, [&](long count){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        for (long i = 0; i != count; ++i) {
+            w.schedule_absolute(1 + (i * 7) % (count / 4 + 1), [&](const rxsc::schedulable&){++ran;});
+        }
+        w.start();
+    }, state.range(0));
+    benchmark::DoNotOptimize(ran);
+}
+BENCHMARK(virtual_time_run)->Arg(1000)->Arg(100000);
+
+// runs range(0) actions on the current_thread trampoline, one action that
+// schedules the rest
+template<class Scheduler>
+static void trampoline(benchmark::State& state, const Scheduler& sc) {
+    long ran = 0;
+    auto w = sc.create_worker();
+    measure(state, [&](long count){
+        w.schedule([&](const rxsc::schedulable&){
+            for (long i = 1; i < count; ++i) {
+                w.schedule([&](const rxsc::schedulable&){++ran;});
+            }
+            ++ran;
+        });
+    }, state.range(0));
+    benchmark::DoNotOptimize(ran);
+}
+
+static void current_thread_trampoline(benchmark::State& state) {
+    trampoline(state, rxsc::make_current_thread());
+}
+BENCHMARK(current_thread_trampoline)->Arg(1)->Arg(1000);
+
+// the same through a typed_worker, without the virtual calls
+static void current_thread_trampoline_typed(benchmark::State& state) {
+    trampoline(state, rxsc::make_typed_current_thread());
+}
+BENCHMARK(current_thread_trampoline_typed)->Arg(1)->Arg(1000);
+
+// creates a worker, runs one action on it and stops it
+static void worker_lifetime(benchmark::State& state, rxsc::scheduler sc) {
+    measure(state, [&](long count){
+        for (long i = 0; i != count; ++i) {
+            auto w = sc.create_worker();
+            std::atomic<bool> ran(false);
+            w.schedule([&](const rxsc::schedulable&){ran = true;});
+            while (!ran) {
+                std::this_thread::yield();
+            }
+            w.unsubscribe();
+        }
+    }, 1);
+}
+
+static void worker_lifetime_new_thread(benchmark::State& state) {
+    worker_lifetime(state, rxsc::make_new_thread());
+}
+BENCHMARK(worker_lifetime_new_thread)->UseRealTime();
+
+static void worker_lifetime_cached_new_thread(benchmark::State& state) {
+    worker_lifetime(state, rxsc::make_cached_new_thread());
+}
+BENCHMARK(worker_lifetime_cached_new_thread)->UseRealTime();
@@ -0,0 +1,82 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxs=rxcpp::sources;
+namespace rxsub=rxcpp::subjects;
+
+#include "measure.hpp"
+
+// the cost of a subscription that completes as it is subscribed
+static void subscribe_complete(benchmark::State& state) {
+    long sum = 0;
+    measure(state, [&](long count){
+        rxs::range<long>(1, count)
+            .map([](long v){return v + 1;})
+            .subscribe([&](long v){sum += v;});
+    }, 1);
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(subscribe_complete);
+// the same on several threads at once, each subscription has its own state
+// but the threads share the allocator and the trace id counter
+BENCHMARK(subscribe_complete)->ThreadRange(2, 8)->UseRealTime();
+
+// the cost of adding a subscriber to a subject and then removing it
+static void subscribe_unsubscribe(benchmark::State& state) {
+    rxsub::subject<long> sub;
+    auto values = sub.get_observable();
+    long sum = 0;
+    measure(state, [&](long count){
+        for (long i = 0; i != count; ++i) {
+            auto cs = values.subscribe([&](long v){sum += v;});
+            cs.unsubscribe();
+        }
+    }, 1);
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(subscribe_unsubscribe);
+
+// each value sent to a subject is delivered to range(0) subscribers
+static void subject_fan_out(benchmark::State& state) {
+    auto subscribers = state.range(0);
+    rxsub::subject<long> sub;
+    long sum = 0;
+    for (long i = 0; i != subscribers; ++i) {
+        sub.get_observable().subscribe([&](long v){sum += v;});
+    }
+    auto o = sub.get_subscriber();
+    long v = 0;
+    measure(state, [&](long count){
+        for (long i = 0; i != count; ++i) {
+            o.on_next(++v);
+        }
+    }, 1);
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * subscribers);
+}
+BENCHMARK(subject_fan_out)->Arg(1)->Arg(16)->Arg(256);
+
+// values sent to a subject on one thread while another thread keeps adding
+// and removing a subscriber
+static void subject_next_while_subscribing(benchmark::State& state) {
+    rxsub::subject<long> sub;
+    long sum = 0;
+    sub.get_observable().subscribe([&](long v){sum += v;});
+    std::atomic<bool> done(false);
+    std::thread churn([&](){
+        auto values = sub.get_observable();
+        while (!done) {
+            values.subscribe([](long){}).unsubscribe();
+        }
+    });
+    auto o = sub.get_subscriber();
+    long v = 0;
+    measure(state, [&](long count){
+        for (long i = 0; i != count; ++i) {
+            o.on_next(++v);
+        }
+    }, 1000);
+    done = true;
+    churn.join();
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(subject_next_while_subscribing)->UseRealTime();
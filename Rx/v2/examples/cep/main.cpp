@@ -5,6 +5,7 @@
 // conflicts can be managed by the user.
 namespace rx=rxcpp;
 namespace rxsub=rxcpp::subjects;
+namespace rxo=rxcpp::operators;
 namespace rxu=rxcpp::util;
 
 #include <cctype>
@@ -36,6 +37,18 @@ int main()
             std::cout << key << std::endl;
         });
 
+    // an 'a' followed by a 'g' within 5 seconds, without a 'q' between them
+    auto a_then_g = rxo::pattern<int>().
+        followed_by([](int key){return std::tolower(key) == 'a';}).
+        followed_by([](int key){return std::tolower(key) == 'g';},
+                    [](int key){return std::tolower(key) == 'q';});
+
+    keys.
+        match(a_then_g, std::chrono::seconds(5)).
+        subscribe([](const std::vector<int>& keys){
+            std::cout << "matched " << char(keys.front()) << " then " << char(keys.back()) << std::endl;
+        });
+
     // run the loop in create
     keys.connect();
 
@@ -0,0 +1,159 @@
+#include "rxcpp/rx-trace_metrics.hpp"
+#include "rxcpp/rx.hpp"
+// create alias' to simplify code
+// these are owned by the user so that
+// conflicts can be managed by the user.
+namespace rx=rxcpp;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// At this time, RxCpp will fail to compile if the contents
+// of the std namespace are merged into the global namespace
+// DO NOT USE: 'using namespace std;'
+
+//
+// measures the latency of handing a value to observe_on for each scheduler.
+//
+//     latency [count] [period in microseconds]
+//
+// one-way: a value is sent every period and carries the time that it was
+// meant to be sent. the latency is from that time until the value arrives on
+// the scheduler thread, so a sender that falls behind while the scheduler is
+// slow is counted as latency rather than hidden (coordinated omission).
+//
+// ping-pong: a value is sent and the next is not sent until the scheduler
+// thread has received it. the sender waits out each stall, so for each round
+// trip that took longer than the period the samples that a sender on a fixed
+// period would have seen are added, as in HdrHistogram recordCorrectedValue.
+//
+
+typedef std::chrono::steady_clock clock_type;
+
+std::uint64_t elapsed_ns(clock_type::time_point from, clock_type::time_point to) {
+    return to < from ? 0 : std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+void wait_until(clock_type::time_point at) {
+    while (clock_type::now() < at) {
+        std::this_thread::yield();
+    }
+}
+
+rx::trace_histogram one_way(rx::observe_on_one_worker cn, int count, clock_type::duration period) {
+    rx::trace_histogram latency;
+    std::promise<void> done;
+    rxsub::subject<clock_type::time_point> sub;
+    sub.get_observable()
+        .observe_on(cn)
+        .subscribe(
+            [&](clock_type::time_point intended){
+                latency.record(elapsed_ns(intended, clock_type::now()));
+            },
+            [&](){
+                done.set_value();
+            });
+
+    auto o = sub.get_subscriber();
+    auto start = clock_type::now() + std::chrono::milliseconds(10);
+    for (int i = 0; i != count; ++i) {
+        auto intended = start + i * period;
+        wait_until(intended);
+        o.on_next(intended);
+    }
+    o.on_completed();
+    done.get_future().wait();
+    return latency;
+}
+
+rx::trace_histogram ping_pong(rx::observe_on_one_worker cn, int count, clock_type::duration period) {
+    rx::trace_histogram latency;
+    std::atomic<int> received(0);
+    rxsub::subject<int> sub;
+    sub.get_observable()
+        .observe_on(cn)
+        .subscribe([&](int i){
+            received.store(i + 1);
+        });
+
+    auto o = sub.get_subscriber();
+    auto interval = elapsed_ns(clock_type::time_point(), clock_type::time_point(period));
+    auto next = clock_type::now() + std::chrono::milliseconds(10);
+    for (int i = 0; i != count; ++i) {
+        wait_until(next);
+        auto sent = clock_type::now();
+        o.on_next(i);
+        while (received.load() != i + 1) {
+            std::this_thread::yield();
+        }
+        auto now = clock_type::now();
+        auto value = elapsed_ns(sent, now);
+        latency.record(value);
+        for (auto missed = interval; interval > 0 && value > missed; missed += interval) {
+            latency.record(value - missed);
+        }
+        next = (std::max)(next + period, now);
+    }
+    o.on_completed();
+    return latency;
+}
+
+void print_header() {
+    std::cout << std::left << std::setw(24) << "scheduler"
+              << std::setw(12) << "test"
+              << std::right
+              << std::setw(10) << "samples"
+              << std::setw(12) << "p50 us"
+              << std::setw(12) << "p99 us"
+              << std::setw(12) << "p99.9 us"
+              << std::setw(12) << "max us" << std::endl;
+}
+
+void print_row(const std::string& scheduler, const std::string& test, const rx::trace_histogram& latency) {
+    auto us = [](std::uint64_t ns){return ns / 1000.0;};
+    std::cout << std::left << std::setw(24) << scheduler
+              << std::setw(12) << test
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << latency.count()
+              << std::setw(12) << us(latency.value_at(0.5))
+              << std::setw(12) << us(latency.value_at(0.99))
+              << std::setw(12) << us(latency.value_at(0.999))
+              << std::setw(12) << us(latency.max()) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    auto period = std::chrono::microseconds(argc > 2 ? std::atoi(argv[2]) : 50);
+
+    struct candidate
+    {
+        const char* name;
+        rx::observe_on_one_worker coordination;
+    };
+    // the same loops that spin and yield before they park
+    auto spinning = rx::observe_on_one_worker(rxsc::make_event_loop(
+        [](std::function<void()> start){
+            return std::thread(std::move(start));
+        },
+        rxsc::idle_strategy::spin_yield_park()));
+
+    candidate candidates[] = {
+        {"new_thread", rx::observe_on_new_thread()},
+        {"event_loop", rx::observe_on_event_loop()},
+        {"event_loop spin", spinning},
+        {"work_stealing_pool", rx::observe_on_work_stealing_pool()}
+    };
+
+    print_header();
+    for (auto& c : candidates) {
+        print_row(c.name, "one-way", one_way(c.coordination, count, period));
+        print_row(c.name, "ping-pong", ping_pong(c.coordination, count, period));
+    }
+    return 0;
+}
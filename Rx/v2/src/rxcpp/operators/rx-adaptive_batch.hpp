@@ -0,0 +1,231 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_ADAPTIVE_BATCH_HPP)
+#define RXCPP_OPERATORS_RX_ADAPTIVE_BATCH_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// a batch is sent when it holds limit items, or when its first item has
+// waited for the target latency. the latency of a batch is the time from its
+// first item until the downstream on_next returns. limit is doubled after a
+// full batch with a latency of at most half the target, and halved after a
+// batch with a latency of at least the target. so a busy stream that the
+// downstream keeps up with is sent in large batches, and a quiet stream or a
+// slow downstream in small ones.
+template<class T, class Duration, class Coordination>
+struct adaptive_batch
+{
+    static_assert(std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>::value, "Duration parameter must convert to rxsc::scheduler::clock_type::duration");
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct adaptive_batch_values
+    {
+        adaptive_batch_values(int mn, int mx, duration_type t, coordination_type c)
+            : min_count((std::max)(mn, 1))
+            , max_count((std::max)(mx, (std::max)(mn, 1)))
+            , target(t)
+            , coordination(c)
+        {
+        }
+        int min_count;
+        int max_count;
+        duration_type target;
+        coordination_type coordination;
+    };
+    adaptive_batch_values initial;
+
+    adaptive_batch(int min_count, int max_count, duration_type target, coordination_type coordination)
+        : initial(min_count, max_count, target, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct adaptive_batch_observer
+    {
+        typedef adaptive_batch_observer<Subscriber> this_type;
+        typedef std::vector<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct adaptive_batch_subscriber_values : public adaptive_batch_values
+        {
+            adaptive_batch_subscriber_values(dest_type d, adaptive_batch_values v, coordinator_type c)
+                : adaptive_batch_values(std::move(v))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , limit(this->min_count)
+                , chunk_id(0)
+                , emitting(false)
+                , overdue(false)
+                , ending(ending_none)
+            {
+                chunk.reserve(limit);
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            std::mutex lock;
+            int limit;
+            int chunk_id;
+            value_type chunk;
+            rxsc::scheduler::clock_type::time_point first;
+            // dest is called without the lock. while a batch is sent, the
+            // chunk that fills or expires and the end are left for the
+            // sender to send after the batch.
+            bool emitting;
+            bool overdue;
+            enum ending_type { ending_none, ending_completed, ending_error };
+            ending_type ending;
+            std::exception_ptr error;
+        };
+        typedef std::shared_ptr<adaptive_batch_subscriber_values> state_type;
+        state_type state;
+
+        adaptive_batch_observer(dest_type d, adaptive_batch_values v, coordinator_type c)
+            : state(std::make_shared<adaptive_batch_subscriber_values>(std::move(d), std::move(v), std::move(c)))
+        {
+        }
+
+        // sends batches until the chunk is neither full nor expired, then the
+        // end if one arrived. call with the lock held and emitting set.
+        static void produce_batches(const state_type& state, std::unique_lock<std::mutex>& guard) {
+            for (;;) {
+                value_type batch;
+                batch.reserve(state->limit);
+                swap(batch, state->chunk);
+                ++state->chunk_id;
+                state->overdue = false;
+                auto first = state->first;
+                bool full = int(batch.size()) >= state->limit;
+                guard.unlock();
+                state->dest.on_next(std::move(batch));
+                auto latency = state->worker.now() - first;
+                guard.lock();
+                if (latency >= state->target) {
+                    state->limit = (std::max)(state->min_count, state->limit / 2);
+                } else if (full && latency <= state->target / 2) {
+                    state->limit = (std::min)(state->max_count, state->limit * 2);
+                }
+                state->chunk.reserve(state->limit);
+                if (state->ending != adaptive_batch_subscriber_values::ending_none) {
+                    send_end(state, guard);
+                    return;
+                }
+                if (state->chunk.empty() || (!state->overdue && int(state->chunk.size()) < state->limit)) {
+                    break;
+                }
+            }
+            state->emitting = false;
+        }
+
+        // sends the rest of the chunk and the end, called with the lock held
+        static void send_end(const state_type& state, std::unique_lock<std::mutex>& guard) {
+            value_type rest;
+            swap(rest, state->chunk);
+            ++state->chunk_id;
+            auto ending = state->ending;
+            auto e = state->error;
+            // nothing is sent after the end
+            state->emitting = true;
+            guard.unlock();
+            if (ending == adaptive_batch_subscriber_values::ending_error) {
+                state->dest.on_error(e);
+                return;
+            }
+            if (!rest.empty()) {
+                state->dest.on_next(std::move(rest));
+            }
+            state->dest.on_completed();
+        }
+
+        static void expire_batch(int id, const state_type& state) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (id != state->chunk_id || state->chunk.empty()) {
+                return;
+            }
+            if (state->emitting) {
+                state->overdue = true;
+                return;
+            }
+            state->emitting = true;
+            produce_batches(state, guard);
+        }
+
+        void on_next(T v) const {
+            auto localState = state;
+            std::unique_lock<std::mutex> guard(localState->lock);
+            bool started = localState->chunk.empty();
+            if (started) {
+                localState->first = localState->worker.now();
+            }
+            localState->chunk.push_back(std::move(v));
+            if (int(localState->chunk.size()) >= localState->limit) {
+                if (!localState->emitting) {
+                    localState->emitting = true;
+                    produce_batches(localState, guard);
+                }
+                return;
+            }
+            if (started) {
+                auto id = localState->chunk_id;
+                auto due = localState->first + localState->target;
+                guard.unlock();
+                // scheduled without the lock, the worker may run the action now
+                localState->worker.schedule(due, [id, localState](const rxsc::schedulable&){
+                    expire_batch(id, localState);
+                });
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->chunk.clear();
+            state->ending = adaptive_batch_subscriber_values::ending_error;
+            state->error = e;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->ending = adaptive_batch_subscriber_values::ending_completed;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, adaptive_batch_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(adaptive_batch_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      adaptive_batch_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
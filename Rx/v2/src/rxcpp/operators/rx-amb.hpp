@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_AMB_HPP)
+#define RXCPP_OPERATORS_RX_AMB_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+/// subscribes to every source and sends the notifications of the first one
+/// that sends any. the others are unsubscribed as soon as it does.
+template<class T, class Coordination>
+struct amb : public operator_base<T>
+{
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef std::vector<observable<value_type>> sources_type;
+
+    struct values
+    {
+        values(sources_type s, coordination_type cn)
+            : sources(std::move(s))
+            , coordination(std::move(cn))
+        {
+        }
+        sources_type sources;
+        coordination_type coordination;
+    };
+    values initial;
+
+    amb(sources_type s, coordination_type cn)
+        : initial(std::move(s), std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef Subscriber output_type;
+
+        struct amb_state_type
+            : public std::enable_shared_from_this<amb_state_type>
+            , public values
+        {
+            amb_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(std::move(i))
+                , winner(-1)
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            // true when source i is the first to send
+            bool win(int i) {
+                if (winner < 0) {
+                    winner = i;
+                    for (int other = 0; other != int(lifetimes.size()); ++other) {
+                        if (other != i) {
+                            lifetimes[other].unsubscribe();
+                        }
+                    }
+                }
+                return winner == i;
+            }
+
+            std::vector<composite_subscription> lifetimes;
+            int winner;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxcpp::detail::allocate_state<amb_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        if (state->sources.empty()) {
+            state->out.on_completed();
+            return;
+        }
+
+        // all the lifetimes exist before any source can send
+        for (size_t i = 0; i != state->sources.size(); ++i) {
+            composite_subscription innercs;
+
+            // when the out observer is unsubscribed all the
+            // inner subscriptions are unsubscribed as well
+            auto innercstoken = state->out.add(innercs);
+            innercs.add(make_subscription([state, innercstoken](){
+                state->out.remove(innercstoken);
+            }));
+            state->lifetimes.push_back(std::move(innercs));
+        }
+
+        for (int i = 0; i != int(state->sources.size()); ++i) {
+            if (state->winner >= 0) {
+                return;
+            }
+
+            auto source = on_exception(
+                [&](){return state->coordinator.in(state->sources[i]);},
+                state->out);
+            if (source.empty()) {
+                return;
+            }
+
+            auto sink = make_subscriber<value_type>(
+                state->out,
+                state->lifetimes[i],
+            // on_next
+                [state, i](value_type v) {
+                    if (state->win(i)) {
+                        state->out.on_next(std::move(v));
+                    }
+                },
+            // on_error
+                [state, i](std::exception_ptr e) {
+                    if (state->win(i)) {
+                        state->out.on_error(e);
+                    }
+                },
+            // on_completed
+                [state, i]() {
+                    if (state->win(i)) {
+                        state->out.on_completed();
+                    }
+                }
+            );
+            auto selectedSink = on_exception(
+                [&](){return state->coordinator.out(sink);},
+                state->out);
+            if (selectedSink.empty()) {
+                return;
+            }
+            source->subscribe(std::move(selectedSink.get()));
+        }
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
@@ -14,25 +14,32 @@ namespace operators {
 namespace detail {
 
 
-template<class T>
+// Value is the source value, or a std::shared_ptr<const T> that the
+// overlapping chunks a value is part of share.
+template<class T, class Value = rxu::decay_t<T>>
 struct buffer_count
 {
     typedef rxu::decay_t<T> source_value_type;
     struct buffer_count_values
     {
-        buffer_count_values(int c, int s)
+        buffer_count_values(int c, int s, chunk_pool<Value> p, memory_budget b)
             : count(c)
             , skip(s)
+            , pool(std::move(p))
+            , budget(std::move(b))
         {
         }
         int count;
         int skip;
+        chunk_pool<Value> pool;
+        // charged with the capacity of each open chunk
+        memory_budget budget;
     };
 
     buffer_count_values initial;
 
-    buffer_count(int count, int skip)
-        : initial(count, skip)
+    buffer_count(int count, int skip, chunk_pool<Value> pool = chunk_pool<Value>(), memory_budget budget = memory_budget::empty())
+        : initial(count, skip, std::move(pool), std::move(budget))
     {
     }
 
@@ -40,29 +47,44 @@ struct buffer_count
     struct buffer_count_observer : public buffer_count_values
     {
         typedef buffer_count_observer<Subscriber> this_type;
-        typedef std::vector<T> value_type;
+        typedef std::vector<Value> value_type;
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<value_type, this_type> observer_type;
         dest_type dest;
+        memory_account account;
         mutable int cursor;
-        mutable std::deque<value_type> chunks;
+        mutable rxcpp::detail::pooled_chunks<Value> chunks;
 
         buffer_count_observer(dest_type d, buffer_count_values v)
             : buffer_count_values(v)
             , dest(std::move(d))
+            , account(this->budget, dest.get_subscription())
             , cursor(0)
+            , chunks(this->pool)
         {
         }
+        void emit_front() const {
+            account.refund(this->count * sizeof(Value), 1);
+            auto chunk = std::move(chunks.front());
+            chunks.pop_front();
+            dest.on_next(std::move(chunk));
+        }
         void on_next(T v) const {
             if (cursor++ % this->skip == 0) {
-                chunks.emplace_back();
+                chunks.push_back(this->pool.take(this->count));
+                account.charge(this->count * sizeof(Value), 1);
             }
-            for(auto& chunk : chunks) {
-                chunk.push_back(v);
+            if (!chunks.empty()) {
+                // copy into the overlapping chunks and move into the newest
+                auto held = hold_value<source_value_type, Value>::make(std::move(v));
+                auto last = chunks.end() - 1;
+                for (auto chunk = chunks.begin(); chunk != last; ++chunk) {
+                    chunk->push_back(held);
+                }
+                last->push_back(std::move(held));
             }
             while (!chunks.empty() && int(chunks.front().size()) == this->count) {
-                dest.on_next(std::move(chunks.front()));
-                chunks.pop_front();
+                emit_front();
             }
         }
         void on_error(std::exception_ptr e) const {
@@ -72,8 +94,7 @@ struct buffer_count
             auto done = on_exception(
                 [&](){
                     while (!chunks.empty()) {
-                        dest.on_next(std::move(chunks.front()));
-                        chunks.pop_front();
+                        emit_front();
                     }
                     return true;
                 },
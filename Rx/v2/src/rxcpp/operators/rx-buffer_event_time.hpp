@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_BUFFER_WITH_EVENT_TIME_HPP)
+#define RXCPP_OPERATORS_RX_BUFFER_WITH_EVENT_TIME_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// the windows are [start, start + period) for every start that is a multiple
+// of skip from the default constructed timestamp. the watermark is the
+// greatest timestamp so far less lateness. a window is sent, and its state
+// freed, once the watermark reaches its end. a value whose windows have all
+// been sent is dropped.
+template<class T, class Selector, class Duration>
+struct buffer_with_event_time
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Selector> select_type;
+    typedef rxu::decay_t<decltype(std::declval<select_type>()(std::declval<source_value_type>()))> timestamp_type;
+    typedef rxu::decay_t<decltype(std::declval<timestamp_type>() - std::declval<timestamp_type>())> duration_type;
+
+    static_assert(std::is_convertible<Duration, duration_type>::value, "Duration parameter must convert to the difference of two timestamps");
+
+    struct buffer_with_event_time_values
+    {
+        buffer_with_event_time_values(select_type s, duration_type p, duration_type sk, duration_type l)
+            : timestamp(std::move(s))
+            , period(p)
+            , skip(sk)
+            , lateness(l)
+        {
+        }
+        select_type timestamp;
+        duration_type period;
+        duration_type skip;
+        duration_type lateness;
+    };
+
+    buffer_with_event_time_values initial;
+
+    buffer_with_event_time(select_type s, duration_type period, duration_type skip, duration_type lateness)
+        : initial(std::move(s), period, skip, lateness)
+    {
+    }
+
+    template<class Subscriber>
+    struct buffer_with_event_time_observer : public buffer_with_event_time_values
+    {
+        typedef buffer_with_event_time_observer<Subscriber> this_type;
+        typedef std::vector<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        // the open windows by start, which is also the order of their ends
+        mutable std::map<timestamp_type, value_type> windows;
+        mutable bool seen;
+        mutable timestamp_type watermark;
+
+        buffer_with_event_time_observer(dest_type d, buffer_with_event_time_values v)
+            : buffer_with_event_time_values(std::move(v))
+            , dest(std::move(d))
+            , seen(false)
+            , watermark()
+        {
+        }
+
+        // the start of the last window that holds ts
+        timestamp_type last_start(const timestamp_type& ts) const {
+            auto offset = ts - timestamp_type();
+            auto k = offset / this->skip;
+            if (this->skip * k > offset) {
+                --k;
+            }
+            return timestamp_type() + this->skip * k;
+        }
+
+        void on_next(T v) const {
+            auto ts = this->timestamp(v);
+            auto mark = ts - this->lateness;
+            if (!seen || watermark < mark) {
+                watermark = mark;
+                seen = true;
+            }
+
+            // the open windows that hold ts, newest first
+            auto newest = last_start(ts);
+            auto open = [&](const timestamp_type& start){
+                return ts < start + this->period && watermark < start + this->period;
+            };
+            auto start = newest;
+            size_t count = 0;
+            for (; open(start); start = start - this->skip) {
+                ++count;
+            }
+            // copy into the overlapping windows and move into the oldest
+            start = newest;
+            for (; count > 1; --count, start = start - this->skip) {
+                windows[start].push_back(v);
+            }
+            if (count == 1) {
+                windows[start].push_back(std::move(v));
+            }
+
+            while (!windows.empty() && !(watermark < windows.begin()->first + this->period)) {
+                auto window = std::move(windows.begin()->second);
+                windows.erase(windows.begin());
+                dest.on_next(std::move(window));
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            auto done = on_exception(
+                [&](){
+                    while (!windows.empty()) {
+                        auto window = std::move(windows.begin()->second);
+                        windows.erase(windows.begin());
+                        dest.on_next(std::move(window));
+                    }
+                    return true;
+                },
+                dest);
+            if (done.empty()) {
+                return;
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, buffer_with_event_time_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(buffer_with_event_time_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      buffer_with_event_time_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
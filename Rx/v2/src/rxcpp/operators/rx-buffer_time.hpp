@@ -26,20 +26,22 @@ struct buffer_with_time
 
     struct buffer_with_time_values
     {
-        buffer_with_time_values(duration_type p, duration_type s, coordination_type c)
+        buffer_with_time_values(duration_type p, duration_type s, coordination_type c, chunk_pool<T> cp)
             : period(p)
             , skip(s)
             , coordination(c)
+            , pool(std::move(cp))
         {
         }
         duration_type period;
         duration_type skip;
         coordination_type coordination;
+        chunk_pool<T> pool;
     };
     buffer_with_time_values initial;
 
-    buffer_with_time(duration_type period, duration_type skip, coordination_type coordination)
-        : initial(period, skip, coordination)
+    buffer_with_time(duration_type period, duration_type skip, coordination_type coordination, chunk_pool<T> pool = chunk_pool<T>())
+        : initial(period, skip, coordination, std::move(pool))
     {
     }
 
@@ -51,6 +53,15 @@ struct buffer_with_time
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<value_type, this_type> observer_type;
 
+        typedef rxsc::scheduler::clock_type::time_point time_point;
+
+        // an open chunk is the values from start on, until close_at
+        struct open_chunk
+        {
+            time_point close_at;
+            size_t start;
+        };
+
         struct buffer_with_time_subscriber_values : public buffer_with_time_values
         {
             buffer_with_time_subscriber_values(dest_type d, buffer_with_time_values v, coordinator_type c)
@@ -58,14 +69,49 @@ struct buffer_with_time
                 , dest(std::move(d))
                 , coordinator(std::move(c))
                 , worker(std::move(coordinator.get_worker()))
+                , base(0)
                 , expected(worker.now())
             {
             }
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::deque<value_type> chunks;
-            rxsc::scheduler::clock_type::time_point expected;
+            // the values of the open chunks, each held once however many
+            // chunks it is in. the chunks overlap, so each open chunk is a
+            // range from its start to the newest value.
+            mutable std::deque<T> values;
+            // the index of values.front() among the values held so far
+            mutable size_t base;
+            mutable std::deque<open_chunk> chunks;
+            // when the next chunk opens
+            mutable time_point expected;
+
+            void open() const {
+                open_chunk c = {expected + this->period, base + values.size()};
+                chunks.push_back(c);
+                expected += this->skip;
+            }
+
+            // the values that no later chunk holds are moved into the chunk,
+            // the rest are copied
+            value_type close() const {
+                auto start = chunks.front().start;
+                chunks.pop_front();
+                auto end = base + values.size();
+                auto keep = chunks.empty() ? end : chunks.front().start;
+                auto chunk = this->pool.take(end - start);
+                for (auto i = start; i != end; ++i) {
+                    auto& v = values[i - base];
+                    if (i < keep) {
+                        chunk.push_back(std::move(v));
+                    } else {
+                        chunk.push_back(v);
+                    }
+                }
+                values.erase(values.begin(), values.begin() + (keep - base));
+                base = keep;
+                return chunk;
+            }
         };
         std::shared_ptr<buffer_with_time_subscriber_values> state;
 
@@ -73,26 +119,35 @@ struct buffer_with_time
             : state(std::make_shared<buffer_with_time_subscriber_values>(buffer_with_time_subscriber_values(std::move(d), v, std::move(c))))
         {
             auto localState = state;
-            auto produce_buffer = [localState](const rxsc::schedulable&) {
-                localState->dest.on_next(std::move(localState->chunks.front()));
-                localState->chunks.pop_front();
-            };
-            auto create_buffer = [localState, produce_buffer](const rxsc::schedulable&) {
-                localState->chunks.emplace_back();
-                auto produce_at = localState->expected + localState->period;
-                localState->expected += localState->skip;
-                localState->worker.schedule(produce_at, produce_buffer);
+
+            // one timer opens and closes all the chunks. a chunk that closes
+            // at the time that another opens closes first.
+            auto next_chunk = [localState](const rxsc::schedulable& self) {
+                auto& st = *localState;
+                auto now = st.worker.now();
+                for (;;) {
+                    if (!st.chunks.empty() && st.chunks.front().close_at <= st.expected && st.chunks.front().close_at <= now) {
+                        st.dest.on_next(st.close());
+                    } else if (st.expected <= now) {
+                        st.open();
+                    } else {
+                        break;
+                    }
+                }
+                auto due = st.expected;
+                if (!st.chunks.empty()) {
+                    due = (std::min)(due, st.chunks.front().close_at);
+                }
+                self.schedule(due);
             };
 
-            state->worker.schedule_periodically(
-                state->expected,
-                state->skip,
-                create_buffer);
+            state->worker.schedule(state->expected, next_chunk);
         }
         void on_next(T v) const {
-            for(auto& chunk : state->chunks) {
-                chunk.push_back(v);
+            if (state->chunks.empty()) {
+                return;
             }
+            state->values.push_back(std::move(v));
         }
         void on_error(std::exception_ptr e) const {
             state->dest.on_error(e);
@@ -101,8 +156,7 @@ struct buffer_with_time
             auto done = on_exception(
                 [&](){
                     while (!state->chunks.empty()) {
-                        state->dest.on_next(std::move(state->chunks.front()));
-                        state->chunks.pop_front();
+                        state->dest.on_next(state->close());
                     }
                     return true;
                 },
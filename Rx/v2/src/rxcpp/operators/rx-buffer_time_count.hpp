@@ -26,20 +26,22 @@ struct buffer_with_time_or_count
 
     struct buffer_with_time_or_count_values
     {
-        buffer_with_time_or_count_values(duration_type p, int n, coordination_type c)
+        buffer_with_time_or_count_values(duration_type p, int n, coordination_type c, chunk_pool<T> cp)
             : period(p)
             , count(n)
             , coordination(c)
+            , pool(std::move(cp))
         {
         }
         duration_type period;
         int count;
         coordination_type coordination;
+        chunk_pool<T> pool;
     };
     buffer_with_time_or_count_values initial;
 
-    buffer_with_time_or_count(duration_type period, int count, coordination_type coordination)
-        : initial(period, count, coordination)
+    buffer_with_time_or_count(duration_type period, int count, coordination_type coordination, chunk_pool<T> pool = chunk_pool<T>())
+        : initial(period, count, coordination, std::move(pool))
     {
     }
 
@@ -59,8 +61,14 @@ struct buffer_with_time_or_count
                 , coordinator(std::move(c))
                 , worker(std::move(coordinator.get_worker()))
                 , chunk_id(0)
+                , chunk(this->pool.take(this->count))
             {
             }
+            // the chunk that was started and not emitted goes back to the pool
+            ~buffer_with_time_or_count_subscriber_values()
+            {
+                this->pool.recycle(std::move(chunk));
+            }
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
@@ -71,7 +79,7 @@ struct buffer_with_time_or_count
         state_type state;
 
         buffer_with_time_or_count_observer(dest_type d, buffer_with_time_or_count_values v, coordinator_type c)
-            : state(std::make_shared<buffer_with_time_or_count_subscriber_values>(buffer_with_time_or_count_subscriber_values(std::move(d), std::move(v), std::move(c))))
+            : state(std::make_shared<buffer_with_time_or_count_subscriber_values>(std::move(d), std::move(v), std::move(c)))
         {
             auto new_id = state->chunk_id;
             auto produce_time = state->worker.now() + state->period;
@@ -85,8 +93,10 @@ struct buffer_with_time_or_count
             if (id != state->chunk_id)
                 return;
 
-            state->dest.on_next(state->chunk);
-            state->chunk.resize(0);
+            // the chunk is moved out and a new one started
+            auto chunk = state->pool.take(state->count);
+            swap(chunk, state->chunk);
+            state->dest.on_next(std::move(chunk));
             auto new_id = ++state->chunk_id;
             auto produce_time = expected + state->period;
             auto localState = state;
@@ -96,7 +106,7 @@ struct buffer_with_time_or_count
         }
 
         void on_next(T v) const {
-            state->chunk.push_back(v);
+            state->chunk.push_back(std::move(v));
             if (int(state->chunk.size()) == state->count) {
                 produce_buffer(state->chunk_id, state->worker.now(), state);
             }
@@ -105,7 +115,7 @@ struct buffer_with_time_or_count
             state->dest.on_error(e);
         }
         void on_completed() const {
-            state->dest.on_next(state->chunk);
+            state->dest.on_next(std::move(state->chunk));
             state->dest.on_completed();
         }
 
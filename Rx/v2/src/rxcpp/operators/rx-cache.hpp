@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_CACHE_HPP)
+#define RXCPP_OPERATORS_RX_CACHE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// connects the source for the first subscriber and keeps the connection,
+// so that the source runs once for all of the subscribers.
+template<class T, class ConnectableObservable>
+struct cache : public operator_base<T>
+{
+    typedef rxu::decay_t<ConnectableObservable> source_type;
+
+    struct cache_state
+    {
+        explicit cache_state(source_type o)
+            : source(std::move(o))
+            , connected(false)
+        {
+        }
+        source_type source;
+        std::atomic<bool> connected;
+    };
+    std::shared_ptr<cache_state> state;
+
+    explicit cache(source_type o)
+        : state(std::make_shared<cache_state>(std::move(o)))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber&& o) const {
+        state->source.subscribe(std::forward<Subscriber>(o));
+        if (!state->connected.exchange(true)) {
+            state->source.connect();
+        }
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_CHECKPOINT_HPP)
+#define RXCPP_OPERATORS_RX_CHECKPOINT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+/// passed to scan, reduce or distinct_until_changed to save the state of the
+/// operator and to start it from a saved state. request() is the barrier: the
+/// operator saves its state after the next value, or batch of values, that it
+/// takes in, on the thread that delivers it, so the saved state is always the
+/// state between two values. each subscription starts from the state that was saved
+/// last, so a resubscription after an error, for instance with retry, goes on
+/// from the last checkpoint. copies share the saved state.
+template<class State>
+class checkpoint
+{
+    typedef rxu::decay_t<State> state_value_type;
+
+    struct state_type
+    {
+        state_type()
+            : requested(false)
+        {
+        }
+        std::atomic<bool> requested;
+        mutable std::mutex lock;
+        rxu::maybe<state_value_type> saved;
+        std::function<void(const state_value_type&)> on_save;
+    };
+    std::shared_ptr<state_type> state;
+
+    struct empty_tag {};
+    explicit checkpoint(empty_tag)
+    {
+    }
+
+public:
+    checkpoint()
+        : state(std::make_shared<state_type>())
+    {
+    }
+
+    /// a checkpoint that starts from a state that was saved before a restart
+    explicit checkpoint(state_value_type restored)
+        : state(std::make_shared<state_type>())
+    {
+        state->saved.reset(std::move(restored));
+    }
+
+    /// a checkpoint that restores nothing and is never requested
+    static checkpoint empty() {
+        return checkpoint(empty_tag());
+    }
+
+    /// f is called with each state that is saved, on the thread of the
+    /// operator. set it before the operator is subscribed.
+    void on_save(std::function<void(const state_value_type&)> f) const {
+        if (!!state) {
+            state->on_save = std::move(f);
+        }
+    }
+
+    /// the operator saves its state after the next value that it takes in
+    void request() const {
+        if (!!state) {
+            state->requested = true;
+        }
+    }
+
+    /// the state that was saved last, or the restored state
+    rxu::maybe<state_value_type> get() const {
+        rxu::maybe<state_value_type> result;
+        if (!!state) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            result = state->saved;
+        }
+        return result;
+    }
+
+    /// for the operators. the state to start a subscription from.
+    state_value_type restore_or(state_value_type initial) const {
+        auto saved = get();
+        return saved.empty() ? std::move(initial) : std::move(saved.get());
+    }
+
+    /// for the operators. true once for each request, a relaxed load keeps
+    /// the test cheap when no save has been requested.
+    bool take_request() const {
+        return !!state && state->requested.load(std::memory_order_relaxed) && state->requested.exchange(false);
+    }
+
+    /// for the operators
+    void save(const state_value_type& s) const {
+        if (!state) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->saved.reset(s);
+        }
+        if (state->on_save) {
+            state->on_save(s);
+        }
+    }
+};
+
+}
+
+}
+
+#endif
@@ -13,24 +13,67 @@ namespace operators {
 
 namespace detail {
 
+// marks a Selector that is passed the set of inputs that changed
+// before the latest values
+template<class Selector>
+struct changes_selector
+{
+    explicit changes_selector(Selector s)
+        : selector(std::move(s))
+    {
+    }
+    Selector selector;
+};
+
+template<class Selector>
+struct combine_latest_select
+{
+    typedef std::false_type with_changes;
+    typedef Selector selector_type;
+    static selector_type& get(Selector& s) {return s;}
+};
+template<class Selector>
+struct combine_latest_select<changes_selector<Selector>>
+{
+    typedef std::true_type with_changes;
+    typedef Selector selector_type;
+    static selector_type& get(changes_selector<Selector>& s) {return s.selector;}
+};
+
 template<class Coordination, class Selector, class... ObservableN>
 struct combine_latest_traits {
 
     typedef std::tuple<ObservableN...> tuple_source_type;
     typedef std::tuple<rxu::detail::maybe<typename ObservableN::value_type>...> tuple_source_value_type;
 
+    /// one bit for each input, set when the input has a new value since the last selection
+    typedef std::bitset<sizeof...(ObservableN)> changes_type;
+
     typedef rxu::decay_t<Selector> selector_type;
     typedef rxu::decay_t<Coordination> coordination_type;
 
+    typedef combine_latest_select<selector_type> select_type;
+    typedef typename select_type::with_changes with_changes;
+
     struct tag_not_valid {};
     template<class CS, class... CVN>
-    static auto check(int) -> decltype((*(CS*)nullptr)((*(CVN*)nullptr)...));
+    static auto check(int) -> decltype((*(CS*)nullptr)((*(const CVN*)nullptr)...));
     template<class CS, class... CVN>
     static tag_not_valid check(...);
 
-    static_assert(!std::is_same<decltype(check<selector_type, typename ObservableN::value_type...>(0)), tag_not_valid>::value, "combine_latest Selector must be a function with the signature value_type(Observable::value_type...)");
+    template<class CS, class... CVN>
+    static auto check_changes(int) -> decltype((*(CS*)nullptr)((*(const changes_type*)nullptr), (*(const CVN*)nullptr)...));
+    template<class CS, class... CVN>
+    static tag_not_valid check_changes(...);
+
+    typedef typename std::conditional<with_changes::value,
+        decltype(check_changes<typename select_type::selector_type, typename ObservableN::value_type...>(0)),
+        decltype(check<typename select_type::selector_type, typename ObservableN::value_type...>(0))>::type selected_type;
+
+    static_assert(with_changes::value || !std::is_same<selected_type, tag_not_valid>::value, "combine_latest Selector must be a function with the signature value_type(Observable::value_type...)");
+    static_assert(!with_changes::value || !std::is_same<selected_type, tag_not_valid>::value, "combine_latest_changes Selector must be a function with the signature value_type(changes_type, Observable::value_type...)");
 
-    typedef decltype(check<selector_type, typename ObservableN::value_type...>(0)) value_type;
+    typedef rxu::decay_t<selected_type> value_type;
 };
 
 template<class Coordination, class Selector, class... ObservableN>
@@ -43,10 +86,13 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
     typedef typename traits::tuple_source_type tuple_source_type;
     typedef typename traits::tuple_source_value_type tuple_source_value_type;
 
+    typedef typename traits::value_type value_type;
     typedef typename traits::selector_type selector_type;
+    typedef typename traits::changes_type changes_type;
 
     typedef typename traits::coordination_type coordination_type;
-    typedef typename coordination_type::coordinator_type coordinator_type;
+    // combine_latest only calls in and out, so identity needs no worker
+    typedef typename rxcpp::detail::in_out_coordinator<coordination_type>::type coordinator_type;
 
     struct values
     {
@@ -67,6 +113,22 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
     {
     }
 
+    // the selector reads the latest values in place, a selector that takes
+    // const references does not copy them
+    template<class State, int... IndexN>
+    static value_type select(State& state, std::false_type, rxu::values<int, IndexN...>) {
+        typedef typename traits::select_type select_type;
+        const auto& latest = state.latest;
+        return select_type::get(state.selector)(std::get<IndexN>(latest).get()...);
+    }
+    template<class State, int... IndexN>
+    static value_type select(State& state, std::true_type, rxu::values<int, IndexN...>) {
+        typedef typename traits::select_type select_type;
+        const auto& latest = state.latest;
+        const auto& changes = state.changes;
+        return select_type::get(state.selector)(changes, std::get<IndexN>(latest).get()...);
+    }
+
     template<int Index, class State>
     void subscribe_one(std::shared_ptr<State> state) const {
 
@@ -99,12 +161,13 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
                     ++state->valuesSet;
                 }
 
-                value.reset(st);
+                value.reset(std::move(st));
+                state->changes.set(Index);
 
                 if (state->valuesSet == sizeof... (ObservableN)) {
-                    auto values = rxu::surely(state->latest);
-                    auto selectedResult = rxu::apply(values, state->selector);
-                    state->out.on_next(selectedResult);
+                    auto selectedResult = select(*state, typename traits::with_changes(), typename rxu::values_from<int, sizeof...(ObservableN)>::type());
+                    state->changes.reset();
+                    state->out.on_next(std::move(selectedResult));
                 }
             },
         // on_error
@@ -156,11 +219,12 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
             mutable int pendingCompletions;
             mutable int valuesSet;
             mutable tuple_source_value_type latest;
+            mutable changes_type changes;
             coordinator_type coordinator;
             output_type out;
         };
 
-        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+        auto coordinator = rxcpp::detail::in_out_coordinator<coordination_type>::create(initial.coordination, scbr.get_subscription());
 
         // take a copy of the values for each subscription
         auto state = std::make_shared<combine_latest_state_type>(initial, std::move(coordinator), std::move(scbr));
@@ -201,6 +265,91 @@ public:
     }
 };
 
+// chooses the form of combine_latest from the arguments that are passed to the
+// observable member. the first argument may be a coordination, then a
+// selector, then the observables.
+template<class Source, class Coordination, class TS, class C = rxu::types_checked>
+struct select_combine_latest_cn : public std::false_type {
+    typedef void observable_type;
+    template<class T0, class... TN>
+    void operator()(const Source&, Coordination, T0, TN...) const {
+        static_assert(rxu::all_true<is_observable<T0>::value, is_observable<TN>::value...>::value, "after the coordination, combine_latest takes a selector and observables or only observables");
+    }
+};
+
+template<class Source, class Coordination, class T0, class... TN>
+struct select_combine_latest_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Coordination::coordination_tag, typename T0::observable_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef combine_latest<Coordination, rxu::detail::pack, Source, T0, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Coordination cn, ObservableN... on) const {
+        return observable_type(operator_type(std::move(cn), rxu::pack(), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class Coordination, class T0, class... TN>
+struct select_combine_latest_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<T0(typename Source::value_type, typename TN::value_type...)>::type, typename Coordination::coordination_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef combine_latest<Coordination, T0, Source, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Coordination cn, T0 t0, ObservableN... on) const {
+        return observable_type(operator_type(std::move(cn), std::move(t0), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class TS, class C = rxu::types_checked>
+struct select_combine_latest : public std::false_type {
+    typedef void observable_type;
+    template<class T0, class T1, class... TN>
+    void operator()(const Source&, T0, T1, TN...) const {
+        static_assert(is_coordination<T0>::value ||
+            is_observable<T0>::value ||
+            std::is_convertible<T0, std::function<void(typename T1::value_type, typename TN::value_type...)>>::value
+            , "T0 must be selector, coordination or observable");
+        static_assert(is_observable<T1>::value  ||
+            std::is_convertible<T1, std::function<void(typename TN::value_type...)>>::value, "T1 must be selector or observable");
+        static_assert(rxu::all_true<true, is_observable<TN>::value...>::value, "TN... must be observable");
+    }
+    template<class T0>
+    void operator()(const Source&, T0) const {
+        static_assert(is_observable<T0>::value, "T0 must be observable");
+    }
+};
+
+template<class Source, class T0, class T1, class... TN>
+struct select_combine_latest<Source, rxu::types<T0, T1, TN...>, typename rxu::types_checked_from<typename T0::coordination_tag>::type>
+    : public select_combine_latest_cn<Source, T0, rxu::types<T1, TN...>>
+{
+};
+
+template<class Source, class Selector, class... TN>
+struct select_combine_latest<Source, rxu::types<Selector, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<Selector(typename Source::value_type, typename TN::value_type...)>::type, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef combine_latest<identity_one_worker, Selector, Source, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Selector sel, ObservableN... on) const {
+        return observable_type(operator_type(identity_current_thread(), std::move(sel), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class T0, class... TN>
+struct select_combine_latest<Source, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename T0::observable_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef combine_latest<identity_one_worker, rxu::detail::pack, Source, T0, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, ObservableN... on) const {
+        return observable_type(operator_type(identity_current_thread(), rxu::pack(), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
 }
 
 template<class Coordination, class Selector, class... ObservableN>
@@ -209,6 +358,12 @@ auto combine_latest(Coordination sf, Selector s, ObservableN... on)
     return  detail::combine_latest_factory<Coordination, Selector, ObservableN...>(std::move(sf), std::move(s), std::move(on)...);
 }
 
+template<class Coordination, class Selector, class... ObservableN>
+auto combine_latest_changes(Coordination sf, Selector s, ObservableN... on)
+    ->      detail::combine_latest_factory<Coordination, detail::changes_selector<Selector>, ObservableN...> {
+    return  detail::combine_latest_factory<Coordination, detail::changes_selector<Selector>, ObservableN...>(std::move(sf), detail::changes_selector<Selector>(std::move(s)), std::move(on)...);
+}
+
 }
 
 }
@@ -61,24 +61,46 @@ struct concat
                 , source(i.source_operator)
                 , sourceLifetime(composite_subscription::empty())
                 , collectionLifetime(composite_subscription::empty())
+                , active(false)
+                , trampoline(0)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
             {
             }
 
+            // an inner that completes inside its own subscribe only counts
+            // another round of the loop that subscribed it, so a long run of
+            // synchronous inners is subscribed one after the other in constant
+            // stack, instead of each from the completion of the one before.
+            void drain()
+            {
+                if (trampoline.fetch_add(1) != 0) {
+                    return;
+                }
+                do {
+                    if (!active && !selectedCollections.empty()) {
+                        auto value = std::move(selectedCollections.front());
+                        selectedCollections.pop_front();
+                        active = true;
+                        subscribe_to(std::move(value));
+                    }
+                } while (trampoline.fetch_sub(1) != 1);
+            }
+
             void subscribe_to(collection_type st)
             {
                 auto state = this->shared_from_this();
 
+                // one inner is subscribed at a time, so the entry of the one
+                // that completed is reused instead of each inner adding a
+                // subscription to remove its own entry.
+                state->out.remove(innercstoken);
+
                 collectionLifetime = composite_subscription();
 
                 // when the out observer is unsubscribed all the
                 // inner subscriptions are unsubscribed as well
-                auto innercstoken = state->out.add(collectionLifetime);
-
-                collectionLifetime.add(make_subscription([state, innercstoken](){
-                    state->out.remove(innercstoken);
-                }));
+                innercstoken = state->out.add(collectionLifetime);
 
                 auto selectedSource = on_exception(
                     [&](){return state->coordinator.in(std::move(st));},
@@ -93,8 +115,8 @@ struct concat
                     state->out,
                     collectionLifetime,
                 // on_next
-                    [state, st](value_type ct) {
-                        state->out.on_next(ct);
+                    [state](value_type ct) {
+                        state->out.on_next(std::move(ct));
                     },
                 // on_error
                     [state](std::exception_ptr e) {
@@ -102,11 +124,9 @@ struct concat
                     },
                 //on_completed
                     [state](){
+                        state->active = false;
                         if (!state->selectedCollections.empty()) {
-                            auto value = state->selectedCollections.front();
-                            state->selectedCollections.pop_front();
-                            state->collectionLifetime.unsubscribe();
-                            state->subscribe_to(value);
+                            state->drain();
                         } else if (!state->sourceLifetime.is_subscribed()) {
                             state->out.on_completed();
                         }
@@ -123,7 +143,11 @@ struct concat
             observable<source_value_type, source_operator_type> source;
             composite_subscription sourceLifetime;
             composite_subscription collectionLifetime;
+            composite_subscription::weak_subscription innercstoken;
             std::deque<collection_type> selectedCollections;
+            // true from the subscribe of an inner until it completes
+            bool active;
+            std::atomic<int> trampoline;
             coordinator_type coordinator;
             output_type out;
         };
@@ -154,11 +178,8 @@ struct concat
             state->sourceLifetime,
         // on_next
             [state](collection_type st) {
-                if (state->collectionLifetime.is_subscribed()) {
-                    state->selectedCollections.push_back(st);
-                } else if (state->selectedCollections.empty()) {
-                    state->subscribe_to(st);
-                }
+                state->selectedCollections.push_back(std::move(st));
+                state->drain();
             },
         // on_error
             [state](std::exception_ptr e) {
@@ -166,7 +187,7 @@ struct concat
             },
         // on_completed
             [state]() {
-                if (!state->collectionLifetime.is_subscribed() && state->selectedCollections.empty()) {
+                if (!state->active && state->selectedCollections.empty()) {
                     state->out.on_completed();
                 }
             }
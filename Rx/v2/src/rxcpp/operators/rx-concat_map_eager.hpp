@@ -0,0 +1,316 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_CONCATMAPEAGER_HPP)
+#define RXCPP_OPERATORS_RX_CONCATMAPEAGER_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class Observable, class CollectionSelector, class Coordination>
+struct concat_eager_traits {
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<CollectionSelector> collection_selector_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    typedef typename source_type::value_type source_value_type;
+
+    struct tag_not_valid {};
+    template<class CV, class CCS>
+    static auto collection_check(int) -> decltype((*(CCS*)nullptr)(*(CV*)nullptr));
+    template<class CV, class CCS>
+    static tag_not_valid collection_check(...);
+
+    static_assert(!std::is_same<decltype(collection_check<source_value_type, collection_selector_type>(0)), tag_not_valid>::value, "concat_map_eager CollectionSelector must be a function with the signature observable(concat_map_eager::source_value_type)");
+
+    typedef decltype((*(collection_selector_type*)nullptr)((*(source_value_type*)nullptr))) collection_type;
+
+    static_assert(is_observable<collection_type>::value, "concat_map_eager CollectionSelector must return an observable");
+
+    typedef typename collection_type::value_type value_type;
+};
+
+// subscribes to up to prefetch selected observables ahead of the one that is
+// being delivered. the values from the observables ahead are buffered until
+// each observable before them has completed.
+template<class Observable, class CollectionSelector, class Coordination>
+struct concat_map_eager
+    : public operator_base<rxu::value_type_t<concat_eager_traits<Observable, CollectionSelector, Coordination>>>
+{
+    typedef concat_map_eager<Observable, CollectionSelector, Coordination> this_type;
+    typedef concat_eager_traits<Observable, CollectionSelector, Coordination> traits;
+
+    typedef typename traits::source_type source_type;
+    typedef typename traits::collection_selector_type collection_selector_type;
+
+    typedef typename traits::source_value_type source_value_type;
+    typedef typename traits::collection_type collection_type;
+    typedef typename traits::value_type collection_value_type;
+
+    typedef typename traits::coordination_type coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    struct values
+    {
+        values(source_type o, collection_selector_type s, int p, coordination_type sf)
+            : source(std::move(o))
+            , selectCollection(std::move(s))
+            , prefetch(std::max(p, 0))
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        collection_selector_type selectCollection;
+        int prefetch;
+        coordination_type coordination;
+    private:
+        values& operator=(const values&) RXCPP_DELETE;
+    };
+    values initial;
+
+    concat_map_eager(source_type o, collection_selector_type s, int prefetch, coordination_type sf)
+        : initial(std::move(o), std::move(s), prefetch, std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef Subscriber output_type;
+
+        // one selected observable and the values that it sent before it
+        // was the first in line
+        struct inner_type
+        {
+            inner_type()
+                : completed(false)
+            {
+            }
+            composite_subscription lifetime;
+            std::deque<collection_value_type> buffer;
+            bool completed;
+        };
+
+        struct concat_map_eager_state_type
+            : public std::enable_shared_from_this<concat_map_eager_state_type>
+            , public values
+        {
+            concat_map_eager_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(std::move(i))
+                , sourceLifetime(composite_subscription::empty())
+                , draining(false)
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            bool has_room() const {
+                return active.size() <= static_cast<size_t>(this->prefetch);
+            }
+
+            void subscribe_to(source_value_type st)
+            {
+                auto state = this->shared_from_this();
+
+                auto selectedCollection = on_exception(
+                    [&](){return state->selectCollection(st);},
+                    state->out);
+                if (selectedCollection.empty()) {
+                    return;
+                }
+
+                auto inner = std::make_shared<inner_type>();
+                active.push_back(inner);
+
+                // when the out observer is unsubscribed all the
+                // inner subscriptions are unsubscribed as well
+                auto innercstoken = state->out.add(inner->lifetime);
+
+                inner->lifetime.add(make_subscription([state, innercstoken](){
+                    state->out.remove(innercstoken);
+                }));
+
+                auto selectedSource = on_exception(
+                    [&](){return state->coordinator.in(selectedCollection.get());},
+                    state->out);
+                if (selectedSource.empty()) {
+                    return;
+                }
+
+                // this subscribe does not share the source subscription
+                // so that when it is unsubscribed the source will continue
+                auto sinkInner = make_subscriber<collection_value_type>(
+                    state->out,
+                    inner->lifetime,
+                // on_next
+                    [state, inner](collection_value_type ct) {
+                        if (inner == state->active.front() && inner->buffer.empty()) {
+                            state->out.on_next(std::move(ct));
+                        } else {
+                            inner->buffer.push_back(std::move(ct));
+                        }
+                    },
+                // on_error
+                    [state](std::exception_ptr e) {
+                        state->out.on_error(e);
+                    },
+                //on_completed
+                    [state, inner](){
+                        inner->completed = true;
+                        state->drain();
+                    }
+                );
+                auto selectedSinkInner = on_exception(
+                    [&](){return state->coordinator.out(sinkInner);},
+                    state->out);
+                if (selectedSinkInner.empty()) {
+                    return;
+                }
+                selectedSource->subscribe(std::move(selectedSinkInner.get()));
+            }
+
+            // deliver the buffered values of the first observable in line,
+            // and when it has completed move on to the next one.
+            void drain()
+            {
+                if (draining) {
+                    // the loop below will see the change
+                    return;
+                }
+                draining = true;
+                RXCPP_UNWIND_AUTO([&](){
+                    draining = false;
+                });
+                while (!active.empty()) {
+                    auto front = active.front();
+                    while (!front->buffer.empty()) {
+                        auto value = std::move(front->buffer.front());
+                        front->buffer.pop_front();
+                        out.on_next(std::move(value));
+                    }
+                    if (!front->completed) {
+                        break;
+                    }
+                    active.pop_front();
+                    while (has_room() && !selectedCollections.empty()) {
+                        auto value = selectedCollections.front();
+                        selectedCollections.pop_front();
+                        subscribe_to(value);
+                    }
+                }
+                if (active.empty() && selectedCollections.empty() && !sourceLifetime.is_subscribed()) {
+                    out.on_completed();
+                }
+            }
+
+            composite_subscription sourceLifetime;
+            // the selected observables that are subscribed, in order
+            std::deque<std::shared_ptr<inner_type>> active;
+            // the source values waiting for room to subscribe
+            std::deque<source_value_type> selectedCollections;
+            bool draining;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<concat_map_eager_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        state->sourceLifetime = composite_subscription();
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        state->out.add(state->sourceLifetime);
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        // this subscribe does not share the observer subscription
+        // so that when it is unsubscribed the observer can be called
+        // until the inner subscriptions have finished
+        auto sink = make_subscriber<source_value_type>(
+            state->out,
+            state->sourceLifetime,
+        // on_next
+            [state](source_value_type st) {
+                if (state->has_room() && state->selectedCollections.empty()) {
+                    state->subscribe_to(st);
+                } else {
+                    state->selectedCollections.push_back(st);
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                if (state->active.empty() && state->selectedCollections.empty()) {
+                    state->out.on_completed();
+                }
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        source->subscribe(std::move(selectedSink.get()));
+
+    }
+private:
+    concat_map_eager& operator=(const concat_map_eager&) RXCPP_DELETE;
+};
+
+template<class CollectionSelector, class Coordination>
+class concat_map_eager_factory
+{
+    typedef rxu::decay_t<CollectionSelector> collection_selector_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    collection_selector_type selectorCollection;
+    int prefetch;
+    coordination_type coordination;
+public:
+    concat_map_eager_factory(collection_selector_type s, int p, coordination_type sf)
+        : selectorCollection(std::move(s))
+        , prefetch(p)
+        , coordination(std::move(sf))
+    {
+    }
+
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<concat_map_eager<Observable, CollectionSelector, Coordination>>, concat_map_eager<Observable, CollectionSelector, Coordination>> {
+        return  observable<rxu::value_type_t<concat_map_eager<Observable, CollectionSelector, Coordination>>, concat_map_eager<Observable, CollectionSelector, Coordination>>(
+                                             concat_map_eager<Observable, CollectionSelector, Coordination>(std::forward<Observable>(source), selectorCollection, prefetch, coordination));
+    }
+};
+
+}
+
+template<class CollectionSelector, class Coordination>
+auto concat_map_eager(CollectionSelector&& s, int prefetch, Coordination&& sf)
+    ->      detail::concat_map_eager_factory<CollectionSelector, Coordination> {
+    return  detail::concat_map_eager_factory<CollectionSelector, Coordination>(std::forward<CollectionSelector>(s), prefetch, std::forward<Coordination>(sf));
+}
+
+}
+
+}
+
+#endif
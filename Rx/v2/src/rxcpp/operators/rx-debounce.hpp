@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_DEBOUNCE_HPP)
+#define RXCPP_OPERATORS_RX_DEBOUNCE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// emits an item once no other item has arrived for the period. there is at
+// most one timed action for each subscription. it is scheduled when a quiet
+// period starts and moves itself out while more items arrive.
+template<class T, class Duration, class Coordination>
+struct debounce
+{
+    static_assert(std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>::value, "Duration parameter must convert to rxsc::scheduler::clock_type::duration");
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct debounce_values
+    {
+        debounce_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+        duration_type period;
+        coordination_type coordination;
+    };
+    debounce_values initial;
+
+    debounce(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct debounce_observer
+    {
+        typedef debounce_observer<Subscriber> this_type;
+        typedef rxu::decay_t<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct debounce_subscriber_values : public debounce_values
+        {
+            debounce_subscriber_values(dest_type d, debounce_values v, coordinator_type c)
+                : debounce_values(v)
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(std::move(coordinator.get_worker()))
+                , scheduled(false)
+                , emitting(false)
+                , ending(ending_none)
+            {
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            std::mutex lock;
+            rxu::maybe<value_type> value;
+            rxsc::scheduler::clock_type::time_point last;
+            bool scheduled;
+            // dest is called without the lock. while the timer sends a value
+            // the end is left for it to send after the value.
+            bool emitting;
+            enum ending_type { ending_none, ending_completed, ending_error };
+            ending_type ending;
+            std::exception_ptr error;
+        };
+        std::shared_ptr<debounce_subscriber_values> state;
+
+        debounce_observer(dest_type d, debounce_values v, coordinator_type c)
+            : state(std::make_shared<debounce_subscriber_values>(std::move(d), v, std::move(c)))
+        {
+        }
+        static void tick(std::shared_ptr<debounce_subscriber_values> state, const rxsc::schedulable& self) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->value.empty()) {
+                state->scheduled = false;
+                return;
+            }
+            auto due = state->last + state->period;
+            if (state->worker.now() < due) {
+                guard.unlock();
+                self.schedule(due);
+                return;
+            }
+            state->scheduled = false;
+            auto v = std::move(state->value.get());
+            state->value.reset();
+            state->emitting = true;
+            guard.unlock();
+            state->dest.on_next(std::move(v));
+            guard.lock();
+            state->emitting = false;
+            if (state->ending != debounce_subscriber_values::ending_none) {
+                send_end(state, guard);
+            }
+        }
+        // sends the pending value and the end, called with the lock held
+        static void send_end(const std::shared_ptr<debounce_subscriber_values>& state, std::unique_lock<std::mutex>& guard) {
+            rxu::maybe<value_type> v;
+            using std::swap;
+            swap(v, state->value);
+            auto ending = state->ending;
+            auto e = state->error;
+            // nothing is sent after the end
+            state->emitting = true;
+            guard.unlock();
+            if (ending == debounce_subscriber_values::ending_error) {
+                state->dest.on_error(e);
+                return;
+            }
+            if (!v.empty()) {
+                state->dest.on_next(std::move(v.get()));
+            }
+            state->dest.on_completed();
+        }
+        void on_next(T v) const {
+            auto localState = state;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                localState->value.reset(std::move(v));
+                localState->last = localState->worker.now();
+                if (localState->scheduled) {
+                    return;
+                }
+                localState->scheduled = true;
+            }
+            // scheduled without the lock, the worker may run the action now
+            localState->worker.schedule(localState->last + localState->period, [localState](const rxsc::schedulable& self) {
+                tick(localState, self);
+            });
+        }
+        void on_error(std::exception_ptr e) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->value.reset();
+            state->ending = debounce_subscriber_values::ending_error;
+            state->error = e;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->ending = debounce_subscriber_values::ending_completed;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, debounce_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(debounce_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      debounce_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Duration, class Coordination>
+class debounce_factory
+{
+    typedef rxu::decay_t<Duration> duration_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    duration_type period;
+    coordination_type coordination;
+public:
+    debounce_factory(duration_type p, coordination_type c) : period(p), coordination(c) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(debounce<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(debounce<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination));
+    }
+};
+
+}
+
+template<class Duration, class Coordination>
+inline auto debounce(Duration period, Coordination coordination)
+    ->      detail::debounce_factory<Duration, Coordination> {
+    return  detail::debounce_factory<Duration, Coordination>(period, coordination);
+}
+
+}
+
+}
+
+#endif
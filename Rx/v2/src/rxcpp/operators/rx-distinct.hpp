@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_DISTINCT_HPP)
+#define RXCPP_OPERATORS_RX_DISTINCT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// the key for distinct() is the value itself
+struct distinct_identity
+{
+    template<class U>
+    U operator()(const U& u) const {
+        return u;
+    }
+};
+
+// emits each value whose key has not been seen before. when capacity is not
+// zero only the most recent capacity keys are remembered, the oldest key is
+// forgotten to make room for a new one.
+template<class T, class KeySelector>
+struct distinct
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    typedef rxu::decay_t<decltype(std::declval<key_selector_type&>()(std::declval<source_value_type&>()))> key_type;
+    key_selector_type selectKey;
+    size_t capacity;
+
+    distinct(key_selector_type ks, size_t c)
+        : selectKey(std::move(ks))
+        , capacity(c)
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_observer
+    {
+        typedef distinct_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        key_selector_type selectKey;
+        size_t capacity;
+        mutable std::unordered_set<key_type> seen;
+        // the keys in seen, oldest first. only used when there is a capacity
+        mutable std::deque<key_type> order;
+
+        distinct_observer(dest_type d, key_selector_type ks, size_t c)
+            : dest(std::move(d))
+            , selectKey(std::move(ks))
+            , capacity(c)
+        {
+        }
+        void on_next(source_value_type v) const {
+            auto key = on_exception([&](){
+                return this->selectKey(v);},
+                dest);
+            if (key.empty()) {
+                return;
+            }
+            if (!seen.insert(key.get()).second) {
+                return;
+            }
+            if (capacity != 0) {
+                order.push_back(std::move(key.get()));
+                if (order.size() > capacity) {
+                    seen.erase(order.front());
+                    order.pop_front();
+                }
+            }
+            dest.on_next(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, key_selector_type ks, size_t c) {
+            return make_subscriber<value_type>(d, this_type(d, std::move(ks), c));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(distinct_observer<Subscriber>::make(std::move(dest), selectKey, capacity)) {
+        return      distinct_observer<Subscriber>::make(std::move(dest), selectKey, capacity);
+    }
+};
+
+template<class KeySelector>
+class distinct_factory
+{
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    key_selector_type selectKey;
+    size_t capacity;
+public:
+    distinct_factory(key_selector_type ks, size_t c)
+        : selectKey(std::move(ks))
+        , capacity(c)
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(distinct<rxu::value_type_t<rxu::decay_t<Observable>>, key_selector_type>(selectKey, capacity))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(distinct<rxu::value_type_t<rxu::decay_t<Observable>>, key_selector_type>(selectKey, capacity));
+    }
+};
+
+}
+
+inline auto distinct()
+    ->      detail::distinct_factory<detail::distinct_identity> {
+    return  detail::distinct_factory<detail::distinct_identity>(detail::distinct_identity(), 0);
+}
+
+template<class KeySelector>
+auto distinct(KeySelector ks, size_t capacity = 0)
+    ->      detail::distinct_factory<KeySelector> {
+    return  detail::distinct_factory<KeySelector>(std::move(ks), capacity);
+}
+
+}
+
+}
+
+#endif
@@ -18,6 +18,39 @@ struct distinct_until_changed
 {
     typedef rxu::decay_t<T> source_value_type;
 
+    // the step does not save, only the lift of a distinct_until_changed
+    // with a checkpoint uses it
+    checkpoint<source_value_type> saved;
+
+    distinct_until_changed()
+        : saved(checkpoint<source_value_type>::empty())
+    {
+    }
+    explicit distinct_until_changed(checkpoint<source_value_type> cp)
+        : saved(std::move(cp))
+    {
+    }
+
+    // the work of distinct_until_changed_observer::on_next, used when
+    // distinct_until_changed is fused with the operators next to it
+    struct step_type
+    {
+        typedef rxu::decay_t<T> source_value_type;
+        typedef source_value_type value_type;
+        mutable rxu::detail::maybe<source_value_type> remembered;
+
+        template<class Next, class OnError>
+        void operator()(source_value_type v, const Next& next, const OnError&) const {
+            if (remembered.empty() || v != remembered.get()) {
+                remembered.reset(v);
+                next(std::move(v));
+            }
+        }
+    };
+    step_type make_step() const {
+        return step_type();
+    }
+
     template<class Subscriber>
     struct distinct_until_changed_observer
     {
@@ -26,18 +59,118 @@ struct distinct_until_changed
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<value_type, this_type> observer_type;
         dest_type dest;
+        checkpoint<source_value_type> saved;
         mutable rxu::detail::maybe<source_value_type> remembered;
 
-        distinct_until_changed_observer(dest_type d)
+        distinct_until_changed_observer(dest_type d, checkpoint<source_value_type> cp)
             : dest(d)
+            , saved(std::move(cp))
+            , remembered(saved.get())
         {
         }
         void on_next(source_value_type v) const {
             if (remembered.empty() || v != remembered.get()) {
                 remembered.reset(v);
-                dest.on_next(v);
+                if (saved.take_request()) {
+                    saved.save(v);
+                }
+                dest.on_next(std::move(v));
+            } else if (saved.take_request()) {
+                saved.save(remembered.get());
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, checkpoint<source_value_type> cp) {
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<value_type, observer<value_type, this_type>>(trace_id::make_next_id_subscriber(), std::move(cs), observer<value_type, this_type>(this_type(std::move(d), std::move(cp))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(distinct_until_changed_observer<Subscriber>::make(std::move(dest), saved)) {
+        return      distinct_until_changed_observer<Subscriber>::make(std::move(dest), saved);
+    }
+};
+
+// compares only the key that KeySelector returns for each value, so that
+// the values themselves are neither compared nor remembered
+template<class T, class KeySelector>
+struct distinct_until_key_changed
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    typedef rxu::decay_t<decltype(std::declval<key_selector_type&>()(std::declval<source_value_type&>()))> key_type;
+    key_selector_type selectKey;
+
+    distinct_until_key_changed(key_selector_type ks)
+        : selectKey(std::move(ks))
+    {
+    }
+
+    // the work of distinct_until_key_changed_observer::on_next, used when
+    // distinct_until_changed is fused with the operators next to it
+    struct step_type
+    {
+        typedef rxu::decay_t<T> source_value_type;
+        typedef source_value_type value_type;
+        key_selector_type selectKey;
+        mutable rxu::detail::maybe<key_type> remembered;
+
+        explicit step_type(key_selector_type ks)
+            : selectKey(std::move(ks))
+        {
+        }
+        template<class Next, class OnError>
+        void operator()(source_value_type v, const Next& next, const OnError& error) const {
+            auto key = on_exception([&](){
+                return this->selectKey(v);},
+                error);
+            if (key.empty()) {
+                return;
+            }
+            if (remembered.empty() || key.get() != remembered.get()) {
+                remembered.reset(std::move(key.get()));
+                next(std::move(v));
             }
         }
+    };
+    step_type make_step() const {
+        return step_type(selectKey);
+    }
+
+    template<class Subscriber>
+    struct distinct_until_key_changed_observer
+    {
+        typedef distinct_until_key_changed_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        step_type step;
+
+        distinct_until_key_changed_observer(dest_type d, key_selector_type ks)
+            : dest(d)
+            , step(std::move(ks))
+        {
+        }
+        void on_next(source_value_type v) const {
+            auto& out = dest;
+            step(std::move(v),
+                [&](value_type r){
+                    out.on_next(std::move(r));
+                },
+                [&](std::exception_ptr e){
+                    out.on_error(e);
+                });
+        }
         void on_error(std::exception_ptr e) const {
             dest.on_error(e);
         }
@@ -45,15 +178,17 @@ struct distinct_until_changed
             dest.on_completed();
         }
 
-        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d) {
-            return make_subscriber<value_type>(d, this_type(d));
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, key_selector_type ks) {
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<value_type, observer<value_type, this_type>>(trace_id::make_next_id_subscriber(), std::move(cs), observer<value_type, this_type>(this_type(std::move(d), std::move(ks))));
         }
     };
 
     template<class Subscriber>
     auto operator()(Subscriber dest) const
-        -> decltype(distinct_until_changed_observer<Subscriber>::make(std::move(dest))) {
-        return      distinct_until_changed_observer<Subscriber>::make(std::move(dest));
+        -> decltype(distinct_until_key_changed_observer<Subscriber>::make(std::move(dest), selectKey)) {
+        return      distinct_until_key_changed_observer<Subscriber>::make(std::move(dest), selectKey);
     }
 };
 
@@ -67,6 +202,20 @@ public:
     }
 };
 
+template<class KeySelector>
+class distinct_until_key_changed_factory
+{
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    key_selector_type selectKey;
+public:
+    distinct_until_key_changed_factory(key_selector_type ks) : selectKey(std::move(ks)) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift_fused<rxu::value_type_t<rxu::decay_t<Observable>>>(distinct_until_key_changed<rxu::value_type_t<rxu::decay_t<Observable>>, key_selector_type>(selectKey))) {
+        return      source.template lift_fused<rxu::value_type_t<rxu::decay_t<Observable>>>(distinct_until_key_changed<rxu::value_type_t<rxu::decay_t<Observable>>, key_selector_type>(selectKey));
+    }
+};
+
 }
 
 inline auto distinct_until_changed()
@@ -74,6 +223,12 @@ inline auto distinct_until_changed()
     return  detail::distinct_until_changed_factory();
 }
 
+template<class KeySelector>
+auto distinct_until_changed(KeySelector ks)
+    ->      detail::distinct_until_key_changed_factory<KeySelector> {
+    return  detail::distinct_until_key_changed_factory<KeySelector>(std::move(ks));
+}
+
 }
 
 }
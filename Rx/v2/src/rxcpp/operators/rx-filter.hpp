@@ -25,6 +25,35 @@ struct filter
     {
     }
 
+    // the work of filter_observer::on_next, used when filter is fused with
+    // the operators next to it
+    struct step_type
+    {
+        typedef rxu::decay_t<T> source_value_type;
+        typedef source_value_type value_type;
+        test_type test;
+
+        explicit step_type(test_type t)
+            : test(std::move(t))
+        {
+        }
+        template<class Next, class OnError>
+        void operator()(source_value_type v, const Next& next, const OnError& error) const {
+            auto filtered = on_exception([&](){
+                return !this->test(v);},
+                error);
+            if (filtered.empty()) {
+                return;
+            }
+            if (!filtered.get()) {
+                next(std::move(v));
+            }
+        }
+    };
+    step_type make_step() const {
+        return step_type(test);
+    }
+
     template<class Subscriber>
     struct filter_observer
     {
@@ -48,8 +77,28 @@ struct filter
                 return;
             }
             if (!filtered.get()) {
-                dest.on_next(v);
+                dest.on_next(std::move(v));
+            }
+        }
+        /// delivers the values that pass the test in one call. only present
+        /// when dest takes them as a run.
+        template<class U = source_value_type, class Dest = dest_type>
+        auto on_next_range(const U* first, size_t count) const
+            -> typename std::enable_if<rxcpp::detail::is_range_subscriber<U, Dest>::value,
+                decltype(std::declval<const test_type&>()(*first), void())>::type {
+            rxu::detail::batch_buffer<source_value_type> passed(count);
+            for (auto last = first + count; first != last; ++first) {
+                try {
+                    if (this->test(*first)) {
+                        passed.push_back(*first);
+                    }
+                } catch(...) {
+                    dest.on_next_range(passed.data(), passed.size());
+                    dest.on_error(std::current_exception());
+                    return;
+                }
             }
+            dest.on_next_range(passed.data(), passed.size());
         }
         void on_error(std::exception_ptr e) const {
             dest.on_error(e);
@@ -59,7 +108,9 @@ struct filter
         }
 
         static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, test_type t) {
-            return make_subscriber<value_type>(d, this_type(d, std::move(t)));
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<value_type, observer<value_type, this_type>>(trace_id::make_next_id_subscriber(), std::move(cs), observer<value_type, this_type>(this_type(std::move(d), std::move(t))));
         }
     };
 
@@ -79,8 +130,8 @@ public:
     filter_factory(test_type p) : predicate(std::move(p)) {}
     template<class Observable>
     auto operator()(Observable&& source)
-        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(filter<rxu::value_type_t<rxu::decay_t<Observable>>, test_type>(predicate))) {
-        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(filter<rxu::value_type_t<rxu::decay_t<Observable>>, test_type>(predicate));
+        -> decltype(source.template lift_fused<rxu::value_type_t<rxu::decay_t<Observable>>>(filter<rxu::value_type_t<rxu::decay_t<Observable>>, test_type>(predicate))) {
+        return      source.template lift_fused<rxu::value_type_t<rxu::decay_t<Observable>>>(filter<rxu::value_type_t<rxu::decay_t<Observable>>, test_type>(predicate));
     }
 };
 
@@ -39,7 +39,7 @@ struct finally
         {
         }
         void on_next(source_value_type v) const {
-            dest.on_next(v);
+            dest.on_next(std::move(v));
         }
         void on_error(std::exception_ptr e) const {
             dest.on_error(e);
@@ -66,25 +66,92 @@ struct flat_map
 
     struct values
     {
-        values(source_type o, collection_selector_type s, result_selector_type rs, coordination_type sf)
+        values(source_type o, collection_selector_type s, result_selector_type rs, coordination_type sf, int mc)
             : source(std::move(o))
             , selectCollection(std::move(s))
             , selectResult(std::move(rs))
             , coordination(std::move(sf))
+            , maxConcurrent(mc)
         {
         }
         source_type source;
         collection_selector_type selectCollection;
         result_selector_type selectResult;
         coordination_type coordination;
+        // 0 subscribes to every selected observable as soon as it is selected
+        int maxConcurrent;
     };
     values initial;
 
-    flat_map(source_type o, collection_selector_type s, result_selector_type rs, coordination_type sf)
-        : initial(std::move(o), std::move(s), std::move(rs), std::move(sf))
+    flat_map(source_type o, collection_selector_type s, result_selector_type rs, coordination_type sf, int maxConcurrent = 0)
+        : initial(std::move(o), std::move(s), std::move(rs), std::move(sf), maxConcurrent)
     {
     }
 
+    // select and subscribe to the queued values while there are free slots
+    template<class State>
+    static void drain(const std::shared_ptr<State>& state) {
+        if (state->draining) {
+            // an inner completed during a subscribe below, the loop will
+            // pick up the slot that it freed
+            return;
+        }
+        state->draining = true;
+        while (!state->queue.empty() && state->active < state->maxConcurrent && state->out.is_subscribed()) {
+            auto st = std::move(state->queue.front());
+            state->queue.pop_front();
+            subscribe_inner(state, std::move(st));
+        }
+        state->draining = false;
+    }
+
+    template<class State>
+    static void subscribe_inner(const std::shared_ptr<State>& state, source_value_type st) {
+
+        composite_subscription innercs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        auto innercstoken = state->out.add(innercs);
+
+        innercs.add(make_subscription([state, innercstoken](){
+            state->out.remove(innercstoken);
+        }));
+
+        auto selectedCollection = state->selectCollection(st);
+        auto selectedSource = state->coordinator.in(selectedCollection);
+
+        ++state->active;
+        // this subscribe does not share the source subscription
+        // so that when it is unsubscribed the source will continue
+        auto sinkInner = make_subscriber<collection_value_type>(
+            state->out,
+            innercs,
+        // on_next
+            [state, st](collection_value_type ct) {
+                auto selectedResult = state->selectResult(st, std::move(ct));
+                state->out.on_next(std::move(selectedResult));
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        //on_completed
+            [state](){
+                --state->active;
+                if (!state->queue.empty()) {
+                    drain(state);
+                }
+                if (--state->pendingCompletions == 0) {
+                    state->out.on_completed();
+                }
+            }
+        );
+
+        auto selectedSinkInner = state->coordinator.out(sinkInner);
+        selectedSource.subscribe(std::move(selectedSinkInner));
+    }
+
     template<class Subscriber>
     void on_subscribe(Subscriber scbr) const {
         static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
@@ -98,6 +165,8 @@ struct flat_map
             state_type(values i, coordinator_type coor, output_type oarg)
                 : values(std::move(i))
                 , pendingCompletions(0)
+                , active(0)
+                , draining(false)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
             {
@@ -105,6 +174,11 @@ struct flat_map
             // on_completed on the output must wait until all the
             // subscriptions have received on_completed
             int pendingCompletions;
+            // selected observables that are subscribed
+            int active;
+            bool draining;
+            // source values that wait for a free slot
+            std::deque<source_value_type> queue;
             coordinator_type coordinator;
             output_type out;
         };
@@ -136,45 +210,13 @@ struct flat_map
             outercs,
         // on_next
             [state](source_value_type st) {
-
-                composite_subscription innercs;
-
-                // when the out observer is unsubscribed all the
-                // inner subscriptions are unsubscribed as well
-                auto innercstoken = state->out.add(innercs);
-
-                innercs.add(make_subscription([state, innercstoken](){
-                    state->out.remove(innercstoken);
-                }));
-
-                auto selectedCollection = state->selectCollection(st);
-                auto selectedSource = state->coordinator.in(selectedCollection);
-
                 ++state->pendingCompletions;
-                // this subscribe does not share the source subscription
-                // so that when it is unsubscribed the source will continue
-                auto sinkInner = make_subscriber<collection_value_type>(
-                    state->out,
-                    innercs,
-                // on_next
-                    [state, st](collection_value_type ct) {
-                        auto selectedResult = state->selectResult(st, std::move(ct));
-                        state->out.on_next(std::move(selectedResult));
-                    },
-                // on_error
-                    [state](std::exception_ptr e) {
-                        state->out.on_error(e);
-                    },
-                //on_completed
-                    [state](){
-                        if (--state->pendingCompletions == 0) {
-                            state->out.on_completed();
-                        }
-                    }
-                );
-
-                auto selectedSinkInner = state->coordinator.out(sinkInner);
-                selectedSource.subscribe(std::move(selectedSinkInner));
+                if (state->maxConcurrent == 0) {
+                    subscribe_inner(state, std::move(st));
+                    return;
+                }
+                state->queue.push_back(std::move(st));
+                drain(state);
             },
         // on_error
             [state](std::exception_ptr e) {
@@ -210,11 +252,13 @@ class flat_map_factory
     collection_selector_type selectorCollection;
     result_selector_type selectorResult;
     coordination_type coordination;
+    int maxConcurrent;
 public:
-    flat_map_factory(collection_selector_type s, result_selector_type rs, coordination_type sf)
+    flat_map_factory(collection_selector_type s, result_selector_type rs, coordination_type sf, int mc = 0)
         : selectorCollection(std::move(s))
         , selectorResult(std::move(rs))
         , coordination(std::move(sf))
+        , maxConcurrent(mc)
     {
     }
 
@@ -222,7 +266,7 @@ public:
     auto operator()(Observable&& source)
         ->      observable<rxu::value_type_t<flat_map<Observable, CollectionSelector, ResultSelector, Coordination>>, flat_map<Observable, CollectionSelector, ResultSelector, Coordination>> {
         return  observable<rxu::value_type_t<flat_map<Observable, CollectionSelector, ResultSelector, Coordination>>, flat_map<Observable, CollectionSelector, ResultSelector, Coordination>>(
-                                             flat_map<Observable, CollectionSelector, ResultSelector, Coordination>(std::forward<Observable>(source), selectorCollection, selectorResult, coordination));
+                                             flat_map<Observable, CollectionSelector, ResultSelector, Coordination>(std::forward<Observable>(source), selectorCollection, selectorResult, coordination, maxConcurrent));
     }
 };
 
@@ -234,6 +278,14 @@ auto flat_map(CollectionSelector&& s, ResultSelector&& rs, Coordination&& sf)
     return  detail::flat_map_factory<CollectionSelector, ResultSelector, Coordination>(std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf));
 }
 
+/// subscribes to at most maxConcurrent of the selected observables at a time,
+/// the source values wait in order until a subscribed observable completes.
+template<class CollectionSelector, class ResultSelector, class Coordination>
+auto flat_map(CollectionSelector&& s, ResultSelector&& rs, Coordination&& sf, int maxConcurrent)
+    ->      detail::flat_map_factory<CollectionSelector, ResultSelector, Coordination> {
+    return  detail::flat_map_factory<CollectionSelector, ResultSelector, Coordination>(std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf), maxConcurrent);
+}
+
 }
 
 }
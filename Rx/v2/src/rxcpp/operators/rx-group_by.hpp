@@ -11,8 +11,78 @@ namespace rxcpp {
 
 namespace operators {
 
+/// use in place of the BinaryPredicate of group_by to keep the groups in a
+/// hash table instead of an ordered map.
+template<class Hash = rxu::hash, class KeyEqual = rxu::equal_to>
+struct hash_groups
+{
+    explicit hash_groups(Hash h = Hash(), KeyEqual e = KeyEqual())
+        : hash(std::move(h))
+        , equal(std::move(e))
+    {
+    }
+    Hash hash;
+    KeyEqual equal;
+};
+
+/// limits the groups that group_by keeps open. a group that is removed is
+/// completed and forgotten, a later value with the same key starts a new
+/// group.
+///
+/// with max_groups the least recently used group is removed to make room for
+/// a new group. with idle the groups that have not received a value for the
+/// idle duration, measured on the clock of the scheduler, are removed. idle
+/// groups are found when the next value arrives, there is no timer.
+struct group_expiry
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    /// no limits
+    group_expiry()
+        : max_groups(0)
+    {
+    }
+    explicit group_expiry(size_t maxGroups)
+        : max_groups(maxGroups)
+    {
+    }
+    group_expiry(clock_type::duration idle, rxsc::scheduler clock, size_t maxGroups = 0)
+        : max_groups(maxGroups)
+        , idle(idle)
+        , clock(std::move(clock))
+    {
+    }
+
+    bool empty() const {
+        return max_groups == 0 && idle.empty();
+    }
+
+    // 0 keeps any number of groups
+    size_t max_groups;
+    rxu::maybe<clock_type::duration> idle;
+    rxu::maybe<rxsc::scheduler> clock;
+};
+
 namespace detail {
 
+// the table of open groups is ordered by the BinaryPredicate or hashed
+template<class Key, class Value, class BinaryPredicate>
+struct group_by_table
+{
+    typedef std::map<Key, Value, BinaryPredicate> type;
+    static type make(const BinaryPredicate& p) {
+        return type(p);
+    }
+};
+template<class Key, class Value, class Hash, class KeyEqual>
+struct group_by_table<Key, Value, hash_groups<Hash, KeyEqual>>
+{
+    typedef std::unordered_map<Key, Value, Hash, KeyEqual> type;
+    static type make(const hash_groups<Hash, KeyEqual>& p) {
+        return type(16, p.hash, p.equal);
+    }
+};
+
 template<class T, class Selector>
 struct is_group_by_selector_for {
 
@@ -29,7 +99,35 @@ struct is_group_by_selector_for {
     static const bool value = !std::is_same<type, tag_not_valid>::value;
 };
 
-template<class T, class Observable, class KeySelector, class MarbleSelector, class BinaryPredicate>
+// the source of a group. the groups are emitted with this type, so that a new
+// key does not allocate a dynamic_grouped_observable, and only become
+// dynamic when they are converted to grouped_observable<Key, Marble>.
+template<class Key, class Marble>
+struct group_by_observable : public rxs::source_base<Marble>
+{
+    typedef Key key_type;
+    typedef rxsub::subject<Marble> subject_type;
+
+    subject_type subject;
+    key_type key;
+
+    group_by_observable(subject_type s, key_type k)
+        : subject(std::move(s))
+        , key(std::move(k))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber&& o) const {
+        subject.get_observable().subscribe(std::forward<Subscriber>(o));
+    }
+
+    key_type on_get_key() const {
+        return key;
+    }
+};
+
+template<class T, class Observable, class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination = identity_one_worker>
 struct group_by_traits
 {
     typedef T source_value_type;
@@ -37,6 +135,8 @@ struct group_by_traits
     typedef rxu::decay_t<KeySelector> key_selector_type;
     typedef rxu::decay_t<MarbleSelector> marble_selector_type;
     typedef rxu::decay_t<BinaryPredicate> predicate_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
 
     static_assert(is_group_by_selector_for<source_value_type, key_selector_type>::value, "group_by KeySelector must be a function with the signature key_type(source_value_type)");
 
@@ -48,62 +148,72 @@ struct group_by_traits
 
     typedef rxsub::subject<marble_type> subject_type;
 
-    typedef std::map<key_type, typename subject_type::subscriber_type, predicate_type> key_subscriber_map_type;
+    // each group delivers through its lane of the coordination
+    typedef typename coordinator_type::template get<typename subject_type::subscriber_type>::type group_subscriber_type;
+
+    typedef group_expiry::clock_type::time_point time_point;
+
+    // the open groups from the most to the least recently used, only kept
+    // when there is a group_expiry
+    typedef std::list<std::pair<key_type, time_point>> recent_list_type;
+
+    struct group_type
+    {
+        explicit group_type(group_subscriber_type s)
+            : subscriber(std::move(s))
+        {
+        }
+        group_subscriber_type subscriber;
+        typename recent_list_type::iterator recent;
+    };
+
+    typedef group_by_table<key_type, group_type, predicate_type> table_type;
+    typedef typename table_type::type key_subscriber_map_type;
 
-    typedef grouped_observable<key_type, source_value_type> grouped_observable_type;
+    typedef group_by_observable<key_type, marble_type> group_source_type;
+    typedef grouped_observable<key_type, marble_type, group_source_type> grouped_observable_type;
 };
 
-template<class T, class Observable, class KeySelector, class MarbleSelector, class BinaryPredicate>
+template<class T, class Observable, class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination = identity_one_worker>
 struct group_by
 {
-    typedef group_by_traits<T, Observable, KeySelector, MarbleSelector, BinaryPredicate> traits_type;
+    typedef group_by_traits<T, Observable, KeySelector, MarbleSelector, BinaryPredicate, Coordination> traits_type;
     typedef typename traits_type::key_selector_type key_selector_type;
     typedef typename traits_type::marble_selector_type marble_selector_type;
     typedef typename traits_type::marble_type marble_type;
     typedef typename traits_type::predicate_type predicate_type;
     typedef typename traits_type::subject_type subject_type;
     typedef typename traits_type::key_type key_type;
+    typedef typename traits_type::coordination_type coordination_type;
+    typedef typename traits_type::coordinator_type coordinator_type;
 
     struct group_by_values
     {
-        group_by_values(key_selector_type ks, marble_selector_type ms, predicate_type p)
+        group_by_values(key_selector_type ks, marble_selector_type ms, predicate_type p, group_expiry e, coordination_type cn)
             : keySelector(std::move(ks))
             , marbleSelector(std::move(ms))
             , predicate(std::move(p))
+            , expiry(std::move(e))
+            , coordination(std::move(cn))
         {
         }
         mutable key_selector_type keySelector;
         mutable marble_selector_type marbleSelector;
         mutable predicate_type predicate;
+        group_expiry expiry;
+        coordination_type coordination;
     };
 
     group_by_values initial;
 
-    group_by(key_selector_type ks, marble_selector_type ms, predicate_type p)
-        : initial(std::move(ks), std::move(ms), std::move(p))
+    group_by(key_selector_type ks, marble_selector_type ms, predicate_type p, group_expiry e = group_expiry())
+        : initial(std::move(ks), std::move(ms), std::move(p), std::move(e), identity_current_thread())
     {
     }
-
-    struct group_by_observable : public rxs::source_base<marble_type>
+    group_by(key_selector_type ks, marble_selector_type ms, predicate_type p, group_expiry e, coordination_type cn)
+        : initial(std::move(ks), std::move(ms), std::move(p), std::move(e), std::move(cn))
     {
-        subject_type subject;
-        key_type key;
-
-        group_by_observable(subject_type s, key_type k)
-            : subject(std::move(s))
-            , key(k)
-        {
-        }
-
-        template<class Subscriber>
-        void on_subscribe(Subscriber&& o) const {
-            subject.get_observable().subscribe(std::forward<Subscriber>(o));
-        }
-
-        key_type on_get_key() {
-            return key;
-        }
-    };
+    }
 
     template<class Subscriber>
     struct group_by_observer : public group_by_values
@@ -114,14 +224,53 @@ struct group_by
         typedef observer<T, this_type> observer_type;
         dest_type dest;
 
+        typedef typename traits_type::time_point time_point;
+        typedef typename traits_type::group_type group_type;
+
         mutable typename traits_type::key_subscriber_map_type groups;
+        mutable typename traits_type::recent_list_type recent;
+        bool expiring;
+        // a worker from the coordination for each lane, a key always uses
+        // the same lane
+        std::vector<coordinator_type> lanes;
 
         group_by_observer(dest_type d, group_by_values v)
             : group_by_values(v)
             , dest(std::move(d))
-            , groups(group_by_values::predicate)
+            , groups(traits_type::table_type::make(group_by_values::predicate))
+            , expiring(!group_by_values::expiry.empty())
         {
+            auto count = std::is_same<coordination_type, identity_one_worker>::value ? 1 : (std::max)(std::thread::hardware_concurrency(), 1u);
+            for (unsigned i = 0; i < count; ++i) {
+                lanes.push_back(this->coordination.create_coordinator(dest.get_subscription()));
+            }
+        }
+
+        const coordinator_type& select_lane(const key_type&, std::true_type) const {
+            return lanes.front();
+        }
+        const coordinator_type& select_lane(const key_type& key, std::false_type) const {
+            return lanes[rxu::hash()(key) % lanes.size()];
         }
+
+        // complete and forget the least recently used group
+        void remove_oldest() const {
+            auto g = groups.find(recent.back().first);
+            auto sub = std::move(g->second.subscriber);
+            groups.erase(g);
+            recent.pop_back();
+            sub.on_completed();
+        }
+        void expire(time_point now) const {
+            auto& idle = this->expiry.idle;
+            if (idle.empty()) {
+                return;
+            }
+            while (!recent.empty() && now - recent.back().second >= idle.get()) {
+                remove_oldest();
+            }
+        }
+
         void on_next(T v) const {
             auto selectedKey = on_exception(
                 [&](){
@@ -130,30 +279,47 @@ struct group_by
             if (selectedKey.empty()) {
                 return;
             }
+            time_point now;
+            if (expiring) {
+                auto& clock = this->expiry.clock;
+                now = clock.empty() ? group_expiry::clock_type::now() : clock->now();
+                expire(now);
+            }
             auto g = groups.find(selectedKey.get());
             if (g == groups.end()) {
+                if (expiring && this->expiry.max_groups != 0 && groups.size() >= this->expiry.max_groups) {
+                    remove_oldest();
+                }
                 auto sub = subject_type();
-                g = groups.insert(std::make_pair(selectedKey.get(), sub.get_subscriber())).first;
-                dest.on_next(make_dynamic_grouped_observable<key_type, marble_type>(group_by_observable(sub, selectedKey.get())));
+                auto& lane = select_lane(selectedKey.get(), typename std::is_same<coordination_type, identity_one_worker>::type());
+                g = groups.insert(std::make_pair(selectedKey.get(), group_type(lane.out(sub.get_subscriber())))).first;
+                if (expiring) {
+                    recent.push_front(std::make_pair(selectedKey.get(), now));
+                    g->second.recent = recent.begin();
+                }
+                dest.on_next(value_type(typename traits_type::group_source_type(sub, selectedKey.get())));
+            } else if (expiring) {
+                recent.splice(recent.begin(), recent, g->second.recent);
+                g->second.recent->second = now;
             }
             auto selectedMarble = on_exception(
                 [&](){
-                    return this->marbleSelector(v);},
+                    return this->marbleSelector(std::move(v));},
                 [this](std::exception_ptr e){on_error(e);});
             if (selectedMarble.empty()) {
                 return;
             }
-            g->second.on_next(std::move(selectedMarble.get()));
+            g->second.subscriber.on_next(std::move(selectedMarble.get()));
         }
         void on_error(std::exception_ptr e) const {
             for(auto& g : groups) {
-                g.second.on_error(e);
+                g.second.subscriber.on_error(e);
             }
             dest.on_error(e);
         }
         void on_completed() const {
             for(auto& g : groups) {
-                g.second.on_completed();
+                g.second.subscriber.on_completed();
             }
             dest.on_completed();
         }
@@ -171,33 +337,47 @@ struct group_by
     }
 };
 
-template<class KeySelector, class MarbleSelector, class BinaryPredicate>
+template<class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination = identity_one_worker>
 class group_by_factory
 {
     typedef rxu::decay_t<KeySelector> key_selector_type;
     typedef rxu::decay_t<MarbleSelector> marble_selector_type;
     typedef rxu::decay_t<BinaryPredicate> predicate_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
     key_selector_type keySelector;
     marble_selector_type marbleSelector;
     predicate_type predicate;
+    group_expiry expiry;
+    coordination_type coordination;
 public:
-    group_by_factory(key_selector_type ks, marble_selector_type ms, predicate_type p)
+    group_by_factory(key_selector_type ks, marble_selector_type ms, predicate_type p, group_expiry e = group_expiry())
+        : keySelector(std::move(ks))
+        , marbleSelector(std::move(ms))
+        , predicate(std::move(p))
+        , expiry(std::move(e))
+        , coordination(identity_current_thread())
+    {
+    }
+    group_by_factory(key_selector_type ks, marble_selector_type ms, predicate_type p, group_expiry e, coordination_type cn)
         : keySelector(std::move(ks))
         , marbleSelector(std::move(ms))
         , predicate(std::move(p))
+        , expiry(std::move(e))
+        , coordination(std::move(cn))
     {
     }
     template<class Observable>
     struct group_by_factory_traits
     {
-        typedef rxu::value_type_t<Observable> value_type;
-        typedef detail::group_by_traits<value_type, Observable, KeySelector, MarbleSelector, BinaryPredicate> traits_type;
-        typedef detail::group_by<value_type, Observable, KeySelector, MarbleSelector, BinaryPredicate> group_by_type;
+        typedef rxu::decay_t<Observable> source_type;
+        typedef rxu::value_type_t<source_type> value_type;
+        typedef detail::group_by_traits<value_type, source_type, KeySelector, MarbleSelector, BinaryPredicate, Coordination> traits_type;
+        typedef detail::group_by<value_type, source_type, KeySelector, MarbleSelector, BinaryPredicate, Coordination> group_by_type;
     };
     template<class Observable>
     auto operator()(Observable&& source)
-        -> decltype(source.template lift<typename group_by_factory_traits<Observable>::traits_type::grouped_observable_type>(typename group_by_factory_traits<Observable>::group_by_type(std::move(keySelector), std::move(marbleSelector), std::move(predicate)))) {
-        return      source.template lift<typename group_by_factory_traits<Observable>::traits_type::grouped_observable_type>(typename group_by_factory_traits<Observable>::group_by_type(std::move(keySelector), std::move(marbleSelector), std::move(predicate)));
+        -> decltype(source.template lift<typename group_by_factory_traits<Observable>::traits_type::grouped_observable_type>(typename group_by_factory_traits<Observable>::group_by_type(std::move(keySelector), std::move(marbleSelector), std::move(predicate), std::move(expiry), std::move(coordination)))) {
+        return      source.template lift<typename group_by_factory_traits<Observable>::traits_type::grouped_observable_type>(typename group_by_factory_traits<Observable>::group_by_type(std::move(keySelector), std::move(marbleSelector), std::move(predicate), std::move(expiry), std::move(coordination)));
     }
 };
 
@@ -209,6 +389,21 @@ inline auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p)
     return  detail::group_by_factory<KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p));
 }
 
+template<class KeySelector, class MarbleSelector, class BinaryPredicate>
+inline auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p, group_expiry e)
+    ->      detail::group_by_factory<KeySelector, MarbleSelector, BinaryPredicate> {
+    return  detail::group_by_factory<KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p), std::move(e));
+}
+
+/// the values of each group are delivered on a worker from the coordination,
+/// the worker is chosen by the hash of the key so that a key always uses the
+/// same worker.
+template<class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination>
+inline auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p, group_expiry e, Coordination cn)
+    ->      detail::group_by_factory<KeySelector, MarbleSelector, BinaryPredicate, Coordination> {
+    return  detail::group_by_factory<KeySelector, MarbleSelector, BinaryPredicate, Coordination>(std::move(ks), std::move(ms), std::move(p), std::move(e), std::move(cn));
+}
+
 
 }
 
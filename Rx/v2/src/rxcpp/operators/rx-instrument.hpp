@@ -0,0 +1,318 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_INSTRUMENT_HPP)
+#define RXCPP_OPERATORS_RX_INSTRUMENT_HPP
+
+#include "../rx-includes.hpp"
+#include "rx-lift.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+/// counts the values inside the stages that share it and the time that they
+/// spend there. copies refer to the same counters. each value that enters is
+/// passed to the tracer in stage_enqueue and each value that leaves in
+/// stage_deliver, with the time since the oldest value in the stage entered.
+class stage_metrics
+{
+    struct state_type
+    {
+        explicit state_type(std::string n)
+            : name(std::move(n))
+            , current(0)
+            , peak(0)
+            , entered(0)
+            , delivered(0)
+            , latency(0)
+            , max_latency(0)
+        {
+        }
+        std::string name;
+        std::atomic<size_t> current;
+        std::atomic<size_t> peak;
+        std::atomic<std::uint64_t> entered;
+        std::atomic<std::uint64_t> delivered;
+        std::atomic<std::int64_t> latency;
+        std::atomic<std::int64_t> max_latency;
+    };
+    std::shared_ptr<state_type> state;
+
+public:
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    explicit stage_metrics(std::string name)
+        : state(std::make_shared<state_type>(std::move(name)))
+    {
+    }
+
+    const std::string& name() const {
+        return state->name;
+    }
+    /// values in the stage now
+    size_t current() const {
+        return state->current.load();
+    }
+    /// the most values that have been in the stage at one time
+    size_t peak() const {
+        return state->peak.load();
+    }
+    /// values that entered the stage
+    std::uint64_t entered() const {
+        return state->entered.load();
+    }
+    /// values that left the stage
+    std::uint64_t delivered() const {
+        return state->delivered.load();
+    }
+    /// the mean time from entering the stage to leaving it
+    clock_type::duration mean_latency() const {
+        auto count = delivered();
+        return clock_type::duration(count == 0 ? 0 : state->latency.load() / std::int64_t(count));
+    }
+    clock_type::duration max_latency() const {
+        return clock_type::duration(state->max_latency.load());
+    }
+
+    void enter() const {
+        ++state->entered;
+        auto now = ++state->current;
+        auto peak = state->peak.load();
+        while (peak < now && !state->peak.compare_exchange_weak(peak, now));
+        trace_activity().stage_enqueue(*this);
+    }
+    /// a value left that was paired with a value that entered waited ago
+    void leave(clock_type::duration waited) const {
+        ++state->delivered;
+        --state->current;
+        auto ticks = waited.count();
+        state->latency += ticks;
+        auto max = state->max_latency.load();
+        while (max < ticks && !state->max_latency.compare_exchange_weak(max, ticks));
+        trace_activity().stage_deliver(*this, waited);
+    }
+    /// a value left that was not paired with a value that entered
+    void leave() const {
+        ++state->delivered;
+        trace_activity().stage_deliver(*this, clock_type::duration(0));
+    }
+    /// values that will not leave the stage
+    void discard(size_t n) const {
+        if (n > 0) {
+            state->current -= n;
+        }
+    }
+};
+
+namespace detail {
+
+// the stage of a source that is not lifted
+struct instrument_identity
+{
+    template<class Subscriber>
+    Subscriber operator()(Subscriber dest) const {
+        return dest;
+    }
+};
+
+// wraps the subscriber that the operator in the stage creates, so that the
+// values before and after the operator are seen. each value that leaves is
+// paired with the oldest value that entered.
+template<class SourceValue, class Operator>
+struct instrument
+{
+    typedef rxu::decay_t<SourceValue> source_value_type;
+    typedef rxu::decay_t<Operator> operator_type;
+    typedef stage_metrics::clock_type clock_type;
+
+    operator_type chain;
+    stage_metrics stage;
+
+    instrument(operator_type op, stage_metrics s)
+        : chain(std::move(op))
+        , stage(std::move(s))
+    {
+    }
+
+    // the times that the values in the stage for one subscription entered
+    struct instrument_state
+    {
+        explicit instrument_state(stage_metrics s)
+            : stage(std::move(s))
+        {
+        }
+        ~instrument_state()
+        {
+            stage.discard(entered.size());
+        }
+        void enter() {
+            {
+                std::unique_lock<rxu::detail::spin_lock> guard(lock);
+                entered.push_back(clock_type::now());
+            }
+            stage.enter();
+        }
+        void leave() {
+            std::unique_lock<rxu::detail::spin_lock> guard(lock);
+            if (entered.empty()) {
+                guard.unlock();
+                stage.leave();
+                return;
+            }
+            auto waited = clock_type::now() - entered.front();
+            entered.pop_front();
+            guard.unlock();
+            stage.leave(waited);
+        }
+        void discard() {
+            std::unique_lock<rxu::detail::spin_lock> guard(lock);
+            stage.discard(entered.size());
+            entered.clear();
+        }
+        stage_metrics stage;
+        rxu::detail::spin_lock lock;
+        std::deque<clock_type::time_point> entered;
+    };
+    typedef std::shared_ptr<instrument_state> state_type;
+
+    template<class Subscriber>
+    struct exit_observer
+    {
+        typedef exit_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef typename dest_type::value_type value_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        state_type state;
+
+        exit_observer(dest_type d, state_type s)
+            : dest(std::move(d))
+            , state(std::move(s))
+        {
+        }
+        void on_next(value_type v) const {
+            state->leave();
+            dest.on_next(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            state->discard();
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            state->discard();
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, state_type s) {
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<value_type, observer_type>(trace_id::make_next_id_subscriber(), std::move(cs), observer_type(this_type(std::move(d), std::move(s))));
+        }
+    };
+
+    template<class Subscriber>
+    struct entry_observer
+    {
+        typedef entry_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef source_value_type value_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        state_type state;
+
+        entry_observer(dest_type d, state_type s)
+            : dest(std::move(d))
+            , state(std::move(s))
+        {
+        }
+        void on_next(value_type v) const {
+            state->enter();
+            dest.on_next(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, state_type s) {
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<value_type, observer_type>(trace_id::make_next_id_subscriber(), std::move(cs), observer_type(this_type(std::move(d), std::move(s))));
+        }
+    };
+
+    template<class Subscriber>
+    struct lifted
+    {
+        typedef subscriber<typename rxu::decay_t<Subscriber>::value_type, typename exit_observer<Subscriber>::observer_type> exit_type;
+        typedef rxu::decay_t<decltype((*(const operator_type*)nullptr)(*(exit_type*)nullptr))> chain_type;
+        typedef subscriber<source_value_type, typename entry_observer<chain_type>::observer_type> type;
+    };
+
+    template<class Subscriber>
+    typename lifted<Subscriber>::type operator()(Subscriber dest) const {
+        auto state = std::make_shared<instrument_state>(stage);
+        auto exit = exit_observer<Subscriber>::make(std::move(dest), state);
+        return entry_observer<typename lifted<Subscriber>::chain_type>::make(chain(std::move(exit)), std::move(state));
+    }
+};
+
+// the stage is the last operator lifted onto the source, or the source itself
+template<class T, class SourceOperator>
+struct instrument_source
+{
+    typedef instrument<T, instrument_identity> operator_type;
+    typedef lift_operator<T, SourceOperator, operator_type> lift_type;
+    typedef observable<T, lift_type> observable_type;
+
+    static observable_type make(const SourceOperator& so, stage_metrics stage) {
+        return observable_type(lift_type(so, operator_type(instrument_identity(), std::move(stage))));
+    }
+};
+template<class T, class ResultType, class StageSource, class StageOperator>
+struct instrument_source<T, lift_operator<ResultType, StageSource, StageOperator>>
+{
+    typedef lift_operator<ResultType, StageSource, StageOperator> source_operator_type;
+    typedef typename source_operator_type::source_operator_type stage_source_type;
+    typedef instrument<typename stage_source_type::value_type, typename source_operator_type::operator_type> operator_type;
+    typedef lift_operator<T, stage_source_type, operator_type> lift_type;
+    typedef observable<T, lift_type> observable_type;
+
+    static observable_type make(const source_operator_type& so, stage_metrics stage) {
+        return observable_type(lift_type(so.source, operator_type(so.chain, std::move(stage))));
+    }
+};
+
+class instrument_factory
+{
+    stage_metrics stage;
+public:
+    explicit instrument_factory(stage_metrics s) : stage(std::move(s)) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.instrument(stage)) {
+        return      source.instrument(stage);
+    }
+};
+
+}
+
+/// measure the last operator of the source as a stage
+inline auto instrument(stage_metrics stage)
+    ->      detail::instrument_factory {
+    return  detail::instrument_factory(std::move(stage));
+}
+inline auto instrument(std::string name)
+    ->      detail::instrument_factory {
+    return  detail::instrument_factory(stage_metrics(std::move(name)));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,273 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_JOIN_WINDOW_HPP)
+#define RXCPP_OPERATORS_RX_JOIN_WINDOW_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+/// pairs each value of one source with the values of the other source that
+/// have the same key and arrived no more than window before it.
+///
+/// the values that can still be paired are kept in a bucket per key, in the
+/// order that they arrived. each arrival first drops the values of both
+/// sources that are older than window, so the memory held is bounded by the
+/// values that arrive within one window. the values of a source are dropped
+/// as soon as the other source completes.
+template<class Left, class Right, class LeftKey, class RightKey, class Selector, class Coordination>
+struct join_window : public operator_base<rxu::decay_t<decltype(std::declval<rxu::decay_t<Selector>>()(std::declval<rxu::value_type_t<rxu::decay_t<Left>>>(), std::declval<rxu::value_type_t<rxu::decay_t<Right>>>()))>>
+{
+    typedef rxu::decay_t<Left> left_source_type;
+    typedef rxu::decay_t<Right> right_source_type;
+    typedef rxu::value_type_t<left_source_type> left_value_type;
+    typedef rxu::value_type_t<right_source_type> right_value_type;
+    typedef rxu::decay_t<LeftKey> left_key_selector_type;
+    typedef rxu::decay_t<RightKey> right_key_selector_type;
+    typedef rxu::decay_t<Selector> select_type;
+    typedef rxu::decay_t<decltype(std::declval<left_key_selector_type>()(std::declval<left_value_type>()))> key_type;
+    typedef rxu::decay_t<decltype(std::declval<select_type>()(std::declval<left_value_type>(), std::declval<right_value_type>()))> value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    static_assert(std::is_convertible<decltype(std::declval<right_key_selector_type>()(std::declval<right_value_type>())), key_type>::value, "the keys of both sources must be the same type");
+
+    struct values
+    {
+        values(left_source_type l, right_source_type r, left_key_selector_type lk, right_key_selector_type rk, clock_type::duration w, select_type s, coordination_type cn)
+            : left(std::move(l))
+            , right(std::move(r))
+            , left_key(std::move(lk))
+            , right_key(std::move(rk))
+            , window(w)
+            , selector(std::move(s))
+            , coordination(std::move(cn))
+        {
+        }
+        left_source_type left;
+        right_source_type right;
+        left_key_selector_type left_key;
+        right_key_selector_type right_key;
+        clock_type::duration window;
+        select_type selector;
+        coordination_type coordination;
+    };
+    values initial;
+
+    join_window(left_source_type l, right_source_type r, left_key_selector_type lk, right_key_selector_type rk, clock_type::duration w, select_type s, coordination_type cn)
+        : initial(std::move(l), std::move(r), std::move(lk), std::move(rk), w, std::move(s), std::move(cn))
+    {
+    }
+
+    // the values of one source that can still be paired
+    template<class V>
+    struct side_state
+    {
+        side_state()
+            : completed(false)
+        {
+        }
+
+        void expire(clock_type::time_point since) {
+            while (!arrivals.empty() && arrivals.front().first < since) {
+                auto bucket = buckets.find(arrivals.front().second);
+                bucket->second.pop_front();
+                if (bucket->second.empty()) {
+                    buckets.erase(bucket);
+                }
+                arrivals.pop_front();
+            }
+        }
+
+        void clear() {
+            buckets.clear();
+            arrivals.clear();
+        }
+
+        std::unordered_map<key_type, std::deque<V>> buckets;
+        // the time and key of each value in buckets, oldest first
+        std::deque<std::pair<clock_type::time_point, key_type>> arrivals;
+        bool completed;
+    };
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef Subscriber output_type;
+
+        struct join_window_state_type
+            : public std::enable_shared_from_this<join_window_state_type>
+            , public values
+        {
+            join_window_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(std::move(i))
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            void expire(clock_type::time_point now) {
+                auto since = now - this->window;
+                lefts.expire(since);
+                rights.expire(since);
+            }
+
+            // nothing arrives to pair with the values of the other source
+            // once one completes
+            void complete_left() {
+                lefts.completed = true;
+                rights.clear();
+                complete();
+            }
+            void complete_right() {
+                rights.completed = true;
+                lefts.clear();
+                complete();
+            }
+            void complete() {
+                if (lefts.completed && rights.completed) {
+                    out.on_completed();
+                }
+            }
+
+            side_state<left_value_type> lefts;
+            side_state<right_value_type> rights;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxcpp::detail::allocate_state<join_window_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        composite_subscription leftcs;
+        composite_subscription rightcs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        state->out.add(leftcs);
+        state->out.add(rightcs);
+
+        auto left = on_exception(
+            [&](){return state->coordinator.in(state->left);},
+            state->out);
+        if (left.empty()) {
+            return;
+        }
+        auto right = on_exception(
+            [&](){return state->coordinator.in(state->right);},
+            state->out);
+        if (right.empty()) {
+            return;
+        }
+
+        auto leftSink = make_subscriber<left_value_type>(
+            state->out,
+            leftcs,
+        // on_next
+            [state](left_value_type lv) {
+                state->expire(state->coordinator.get_worker().now());
+                auto key = on_exception(
+                    [&](){return key_type(state->left_key(lv));},
+                    state->out);
+                if (key.empty()) {
+                    return;
+                }
+                auto bucket = state->rights.buckets.find(key.get());
+                if (bucket != state->rights.buckets.end()) {
+                    for (auto& rv : bucket->second) {
+                        auto selected = on_exception(
+                            [&](){return state->selector(lv, rv);},
+                            state->out);
+                        if (selected.empty()) {
+                            return;
+                        }
+                        state->out.on_next(std::move(selected.get()));
+                    }
+                }
+                if (!state->rights.completed) {
+                    state->lefts.arrivals.emplace_back(state->coordinator.get_worker().now(), key.get());
+                    state->lefts.buckets[std::move(key.get())].push_back(std::move(lv));
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->complete_left();
+            }
+        );
+        auto rightSink = make_subscriber<right_value_type>(
+            state->out,
+            rightcs,
+        // on_next
+            [state](right_value_type rv) {
+                state->expire(state->coordinator.get_worker().now());
+                auto key = on_exception(
+                    [&](){return key_type(state->right_key(rv));},
+                    state->out);
+                if (key.empty()) {
+                    return;
+                }
+                auto bucket = state->lefts.buckets.find(key.get());
+                if (bucket != state->lefts.buckets.end()) {
+                    for (auto& lv : bucket->second) {
+                        auto selected = on_exception(
+                            [&](){return state->selector(lv, rv);},
+                            state->out);
+                        if (selected.empty()) {
+                            return;
+                        }
+                        state->out.on_next(std::move(selected.get()));
+                    }
+                }
+                if (!state->lefts.completed) {
+                    state->rights.arrivals.emplace_back(state->coordinator.get_worker().now(), key.get());
+                    state->rights.buckets[std::move(key.get())].push_back(std::move(rv));
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->complete_right();
+            }
+        );
+
+        auto selectedLeftSink = on_exception(
+            [&](){return state->coordinator.out(leftSink);},
+            state->out);
+        if (selectedLeftSink.empty()) {
+            return;
+        }
+        auto selectedRightSink = on_exception(
+            [&](){return state->coordinator.out(rightSink);},
+            state->out);
+        if (selectedRightSink.empty()) {
+            return;
+        }
+        left->subscribe(std::move(selectedLeftSink.get()));
+        right->subscribe(std::move(selectedRightSink.get()));
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
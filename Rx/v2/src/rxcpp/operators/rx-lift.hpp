@@ -67,6 +67,154 @@ struct lift_operator : public operator_base<typename lift_traits<ResultType, Sou
     }
 };
 
+template<class Operator>
+struct is_fusable_operator
+{
+    struct not_void {};
+    template<class CO>
+    static typename CO::step_type check(int);
+    template<class CO>
+    static not_void check(...);
+
+    static const bool value = !std::is_same<decltype(check<rxu::decay_t<Operator>>(0)), not_void>::value;
+};
+
+// runs First and then sends each value that First produces to Second
+template<class First, class Second>
+struct fused_step
+{
+    typedef typename First::source_value_type source_value_type;
+    typedef typename Second::value_type value_type;
+    First first;
+    Second second;
+
+    fused_step(First f, Second s)
+        : first(std::move(f))
+        , second(std::move(s))
+    {
+    }
+    template<class Next, class OnError>
+    void operator()(source_value_type v, const Next& next, const OnError& error) const {
+        auto& then = second;
+        first(std::move(v), [&](typename First::value_type u){
+            then(std::move(u), next, error);
+        }, error);
+    }
+};
+
+// an operator that runs the steps of adjacent map, filter and
+// distinct_until_changed operators in one subscriber. each subscriber gets
+// its own copy of the steps.
+template<class Step>
+struct fused
+{
+    typedef rxu::decay_t<Step> step_type;
+    typedef typename step_type::source_value_type source_value_type;
+    typedef typename step_type::value_type value_type;
+    step_type step;
+
+    explicit fused(step_type s)
+        : step(std::move(s))
+    {
+    }
+
+    step_type make_step() const {
+        return step;
+    }
+
+    template<class Subscriber>
+    struct fused_observer
+    {
+        typedef fused_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+        dest_type dest;
+        step_type step;
+
+        fused_observer(dest_type d, step_type s)
+            : dest(std::move(d))
+            , step(std::move(s))
+        {
+        }
+        void on_next(source_value_type v) const {
+            auto& out = dest;
+            step(std::move(v),
+                [&](value_type r){
+                    out.on_next(std::move(r));
+                },
+                [&](std::exception_ptr e){
+                    out.on_error(e);
+                });
+        }
+        /// delivers the values that come out of the steps in one call. only
+        /// present when dest takes them as a run.
+        template<class U = source_value_type, class Dest = dest_type>
+        auto on_next_range(const U* first, size_t count) const
+            -> typename std::enable_if<std::is_copy_constructible<U>::value && rxcpp::detail::is_range_subscriber<value_type, Dest>::value>::type {
+            auto& out = dest;
+            rxu::detail::batch_buffer<value_type> results(count);
+            bool errored = false;
+            auto next = [&](value_type r){
+                results.push_back(std::move(r));
+            };
+            auto error = [&](std::exception_ptr e){
+                errored = true;
+                out.on_next_range(results.data(), results.size());
+                out.on_error(e);
+            };
+            for (auto last = first + count; first != last && !errored; ++first) {
+                step(*first, next, error);
+            }
+            if (!errored) {
+                out.on_next_range(results.data(), results.size());
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, step_type s) {
+            return make_subscriber<source_value_type>(d, this_type(d, std::move(s)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(fused_observer<Subscriber>::make(std::move(dest), step)) {
+        return      fused_observer<Subscriber>::make(std::move(dest), step);
+    }
+};
+
+// selects the operator for source.lift(op). when both the source and op are
+// map, filter or distinct_until_changed the two are fused into one operator.
+template<class ResultType, class SourceOperator, class Operator, class Enable = void>
+struct lift_fusion
+{
+    typedef rxu::decay_t<SourceOperator> source_operator_type;
+    typedef rxu::decay_t<Operator> operator_type;
+    typedef lift_operator<ResultType, source_operator_type, operator_type> type;
+
+    static type make(source_operator_type source, operator_type op) {
+        return type(std::move(source), std::move(op));
+    }
+};
+template<class ResultType, class SourceResultType, class SourceOperator, class SourceChain, class Operator>
+struct lift_fusion<ResultType, lift_operator<SourceResultType, SourceOperator, SourceChain>, Operator,
+    typename std::enable_if<is_fusable_operator<SourceChain>::value && is_fusable_operator<Operator>::value>::type>
+{
+    typedef lift_operator<SourceResultType, SourceOperator, SourceChain> source_lift_type;
+    typedef rxu::decay_t<Operator> operator_type;
+    typedef fused_step<typename source_lift_type::operator_type::step_type, typename operator_type::step_type> step_type;
+    typedef lift_operator<ResultType, typename source_lift_type::source_operator_type, fused<step_type>> type;
+
+    static type make(const source_lift_type& source, operator_type op) {
+        return type(source.source, fused<step_type>(step_type(source.chain.make_step(), op.make_step())));
+    }
+};
+
 template<class ResultType, class Operator>
 class lift_factory
 {
@@ -19,7 +19,7 @@ struct map
 {
     typedef rxu::decay_t<T> source_value_type;
     typedef rxu::decay_t<Selector> select_type;
-    typedef decltype((*(select_type*)nullptr)(*(source_value_type*)nullptr)) value_type;
+    typedef decltype((*(select_type*)nullptr)(std::move(*(source_value_type*)nullptr))) value_type;
     select_type selector;
 
     map(select_type s)
@@ -27,11 +27,39 @@ struct map
     {
     }
 
+    // the work of map_observer::on_next, used when map is fused with the
+    // operators next to it
+    struct step_type
+    {
+        typedef rxu::decay_t<T> source_value_type;
+        typedef rxu::decay_t<decltype((*(select_type*)nullptr)(std::move(*(source_value_type*)nullptr)))> value_type;
+        select_type selector;
+
+        explicit step_type(select_type s)
+            : selector(std::move(s))
+        {
+        }
+        template<class Next, class OnError>
+        void operator()(source_value_type v, const Next& next, const OnError& error) const {
+            auto selected = on_exception(
+                [&](){
+                    return this->selector(std::move(v));},
+                error);
+            if (selected.empty()) {
+                return;
+            }
+            next(std::move(selected.get()));
+        }
+    };
+    step_type make_step() const {
+        return step_type(selector);
+    }
+
     template<class Subscriber>
     struct map_observer
     {
         typedef map_observer<Subscriber> this_type;
-        typedef decltype((*(select_type*)nullptr)(*(source_value_type*)nullptr)) value_type;
+        typedef decltype((*(select_type*)nullptr)(std::move(*(source_value_type*)nullptr))) value_type;
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<T, this_type> observer_type;
         dest_type dest;
@@ -52,6 +80,25 @@ struct map
             }
             dest.on_next(std::move(selected.get()));
         }
+        /// maps a run of values and delivers the results in one call. only
+        /// present when dest takes the results as a run, otherwise the
+        /// values arrive one at a time through on_next.
+        template<class U = source_value_type, class Dest = dest_type>
+        auto on_next_range(const U* first, size_t count) const
+            -> typename std::enable_if<rxcpp::detail::is_range_subscriber<rxu::decay_t<value_type>, Dest>::value,
+                decltype(std::declval<const select_type&>()(*first), void())>::type {
+            rxu::detail::batch_buffer<rxu::decay_t<value_type>> selected(count);
+            for (auto last = first + count; first != last; ++first) {
+                try {
+                    selected.push_back(this->selector(*first));
+                } catch(...) {
+                    dest.on_next_range(selected.data(), selected.size());
+                    dest.on_error(std::current_exception());
+                    return;
+                }
+            }
+            dest.on_next_range(selected.data(), selected.size());
+        }
         void on_error(std::exception_ptr e) const {
             dest.on_error(e);
         }
@@ -60,8 +107,9 @@ struct map
         }
 
         static subscriber<T, observer_type> make(dest_type d, select_type s) {
-            auto cs = d.get_subscription();
-            return make_subscriber<T>(std::move(cs), observer_type(this_type(std::move(d), std::move(s))));
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<T, observer_type>(trace_id::make_next_id_subscriber(), std::move(cs), observer_type(this_type(std::move(d), std::move(s))));
         }
     };
 
@@ -81,8 +129,8 @@ public:
     map_factory(select_type s) : selector(std::move(s)) {}
     template<class Observable>
     auto operator()(Observable&& source)
-        -> decltype(source.template lift<rxu::value_type_t<map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>>>(map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>(selector))) {
-        return      source.template lift<rxu::value_type_t<map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>>>(map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>(selector));
+        -> decltype(source.template lift_fused<rxu::value_type_t<map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>>>(map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>(selector))) {
+        return      source.template lift_fused<rxu::value_type_t<map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>>>(map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type>(selector));
     }
 };
 
@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_MATCH_HPP)
+#define RXCPP_OPERATORS_RX_MATCH_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+/// a sequence of steps for match. each step is a predicate that a later item
+/// must satisfy, the items between steps that do not satisfy it are skipped.
+/// a step can also have an unless predicate, an item that satisfies it while
+/// a partial match waits for the step ends that partial match.
+///
+///   auto p = rxo::pattern<int>()
+///       .followed_by(is_a)
+///       .followed_by(is_b, is_c); // a followed by b, without c between them
+///
+template<class T>
+class pattern
+{
+public:
+    typedef std::function<bool(const T&)> predicate_type;
+
+    struct step
+    {
+        predicate_type where;
+        // empty when nothing ends the partial matches that wait for this step
+        predicate_type unless;
+    };
+
+    template<class Where>
+    pattern followed_by(Where w) const {
+        pattern result(*this);
+        step s = {predicate_type(std::move(w)), predicate_type()};
+        result.steps.push_back(std::move(s));
+        return result;
+    }
+
+    template<class Where, class Unless>
+    pattern followed_by(Where w, Unless u) const {
+        pattern result(*this);
+        step s = {predicate_type(std::move(w)), predicate_type(std::move(u))};
+        result.steps.push_back(std::move(s));
+        return result;
+    }
+
+    std::vector<step> steps;
+};
+
+namespace detail {
+
+// the pattern is run as an nfa with a state for each step. the partial
+// matches in a state are kept oldest first. an older partial match has seen
+// every item that a newer one has, so it is never behind it, and the partial
+// matches that one item moves to the next state are all newer than the ones
+// already there.
+//
+// the partial matches that move on the same item share a node that holds the
+// item and the nodes that they came from, so an item allocates one node for
+// each state that it advances, however many partial matches move.
+template<class T, class Coordination>
+struct match
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+    typedef pattern<source_value_type> pattern_type;
+
+    struct match_values
+    {
+        match_values(pattern_type p, clock_type::duration w, coordination_type c)
+            : pattern(std::move(p))
+            , within(w)
+            , coordination(std::move(c))
+        {
+        }
+        pattern_type pattern;
+        clock_type::duration within;
+        coordination_type coordination;
+    };
+    match_values initial;
+
+    match(pattern_type p, clock_type::duration within, coordination_type cn)
+        : initial(std::move(p), within, std::move(cn))
+    {
+    }
+
+    // the partial matches that matched value at the same step
+    struct node
+    {
+        node(source_value_type v, clock_type::time_point e, clock_type::time_point l)
+            : value(std::move(v))
+            , earliest(e)
+            , latest(l)
+        {
+        }
+        source_value_type value;
+        // empty at the first step
+        std::vector<std::shared_ptr<node>> from;
+        // the times that the first and last of the partial matches started
+        clock_type::time_point earliest;
+        clock_type::time_point latest;
+    };
+    typedef std::shared_ptr<node> node_ptr;
+
+    template<class Subscriber>
+    struct match_observer : public match_values
+    {
+        typedef match_observer<Subscriber> this_type;
+        typedef std::vector<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+
+        dest_type dest;
+        coordinator_type coordinator;
+        // the partial matches that wait for the step after each step but
+        // the last
+        mutable std::vector<std::deque<node_ptr>> waiting;
+
+        match_observer(dest_type d, match_values v, coordinator_type c)
+            : match_values(std::move(v))
+            , dest(std::move(d))
+            , coordinator(std::move(c))
+            , waiting(this->pattern.steps.empty() ? 0 : this->pattern.steps.size() - 1)
+        {
+        }
+
+        // sends each partial match under n that started at or after since,
+        // with the values in path after it
+        void send(const node_ptr& n, clock_type::time_point since, std::vector<source_value_type>& path) const {
+            path.push_back(n->value);
+            if (n->from.empty()) {
+                if (!(n->earliest < since)) {
+                    dest.on_next(value_type(path.rbegin(), path.rend()));
+                }
+            } else {
+                for (auto& f : n->from) {
+                    if (!(f->latest < since)) {
+                        send(f, since, path);
+                    }
+                }
+            }
+            path.pop_back();
+        }
+
+        void on_next(T v) const {
+            auto& steps = this->pattern.steps;
+            if (steps.empty()) {
+                return;
+            }
+            auto now = coordinator.get_worker().now();
+            auto since = now - this->within;
+
+            auto matched = on_exception(
+                [&](){
+                    for (auto& w : waiting) {
+                        while (!w.empty() && w.front()->latest < since) {
+                            w.pop_front();
+                        }
+                    }
+                    // the last step first, so that one item only moves a partial
+                    // match by one step
+                    for (size_t i = steps.size() - 1; i != 0; --i) {
+                        auto& from = waiting[i - 1];
+                        if (from.empty()) {
+                            continue;
+                        }
+                        if (steps[i].unless && steps[i].unless(v)) {
+                            from.clear();
+                            continue;
+                        }
+                        if (!steps[i].where(v)) {
+                            continue;
+                        }
+                        auto n = std::make_shared<node>(v, from.front()->earliest, from.back()->latest);
+                        n->from.assign(from.begin(), from.end());
+                        from.clear();
+                        if (i + 1 == steps.size()) {
+                            std::vector<source_value_type> path;
+                            path.reserve(steps.size());
+                            send(n, since, path);
+                        } else {
+                            waiting[i].push_back(std::move(n));
+                        }
+                    }
+                    return steps.front().where(v);
+                },
+                dest);
+            if (matched.empty() || !matched.get()) {
+                return;
+            }
+            if (steps.size() == 1) {
+                dest.on_next(value_type(1, std::move(v)));
+                return;
+            }
+            waiting.front().push_back(std::make_shared<node>(std::move(v), now, now));
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            waiting.clear();
+            dest.on_completed();
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, match_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(match_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      match_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
@@ -29,25 +29,173 @@ struct merge
     typedef typename source_value_type::value_type value_type;
 
     typedef rxu::decay_t<Coordination> coordination_type;
-    typedef typename coordination_type::coordinator_type coordinator_type;
+    // merge only calls in and out, so identity needs no worker
+    typedef typename rxcpp::detail::in_out_coordinator<coordination_type>::type coordinator_type;
 
     struct values
     {
-        values(source_operator_type o, coordination_type sf)
+        values(source_operator_type o, coordination_type sf, int mc)
             : source_operator(std::move(o))
             , coordination(std::move(sf))
+            , maxConcurrent(mc)
         {
         }
         source_operator_type source_operator;
         coordination_type coordination;
+        // 0 subscribes to every nested observable as soon as it arrives
+        int maxConcurrent;
     };
     values initial;
 
-    merge(const source_type& o, coordination_type sf)
-        : initial(o.source_operator, std::move(sf))
+    merge(const source_type& o, coordination_type sf, int maxConcurrent = 0)
+        : initial(o.source_operator, std::move(sf), maxConcurrent)
     {
     }
 
+    // true when the inners are emitted on the worker that subscribed
+    typedef rxcpp::detail::is_identity_coordination<coordination_type> same_worker;
+
+    // with the same worker the lifetimes of the inner subscriptions are
+    // kept in slots of the state, which are unsubscribed together when the
+    // output is unsubscribed. otherwise each is added to the output and
+    // removed from it when it ends.
+    struct inner_slots
+    {
+        inner_slots()
+            : closed(false)
+        {
+        }
+        std::mutex lock;
+        bool closed;
+        // free slots hold the empty subscription
+        std::vector<composite_subscription> slots;
+        std::vector<size_t> free;
+    };
+
+    template<class State>
+    static void add_slots(const std::shared_ptr<State>&, std::false_type) {
+    }
+    template<class State>
+    static void add_slots(const std::shared_ptr<State>& state, std::true_type) {
+        // the output keeps the state, and the inners in it, until it is
+        // unsubscribed
+        state->out.add([state](){
+            std::vector<composite_subscription> slots;
+            {
+                std::unique_lock<std::mutex> guard(state->inners.lock);
+                state->inners.closed = true;
+                slots.swap(state->inners.slots);
+                state->inners.free.clear();
+            }
+            for (auto& slot : slots) {
+                slot.unsubscribe();
+            }
+        });
+    }
+
+    template<class State>
+    static size_t add_inner(const std::shared_ptr<State>& state, const composite_subscription& innercs, std::false_type) {
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        auto innercstoken = state->out.add(innercs);
+
+        innercs.add(make_subscription([state, innercstoken](){
+            state->out.remove(innercstoken);
+        }));
+        return 0;
+    }
+    template<class State>
+    static size_t add_inner(const std::shared_ptr<State>& state, const composite_subscription& innercs, std::true_type) {
+        auto& inners = state->inners;
+        std::unique_lock<std::mutex> guard(inners.lock);
+        if (inners.closed) {
+            guard.unlock();
+            innercs.unsubscribe();
+            return 0;
+        }
+        if (inners.free.empty()) {
+            inners.slots.push_back(innercs);
+            return inners.slots.size() - 1;
+        }
+        auto slot = inners.free.back();
+        inners.free.pop_back();
+        inners.slots[slot] = innercs;
+        return slot;
+    }
+
+    template<class State>
+    static void release_inner(const std::shared_ptr<State>&, size_t, std::false_type) {
+    }
+    template<class State>
+    static void release_inner(const std::shared_ptr<State>& state, size_t slot, std::true_type) {
+        auto& inners = state->inners;
+        std::unique_lock<std::mutex> guard(inners.lock);
+        if (inners.closed) {
+            return;
+        }
+        inners.slots[slot] = composite_subscription::empty();
+        inners.free.push_back(slot);
+    }
+
+    // subscribe to the queued observables while there are free slots
+    template<class State>
+    static void drain(const std::shared_ptr<State>& state) {
+        if (state->draining) {
+            // an inner completed during a subscribe below, the loop will
+            // pick up the slot that it freed
+            return;
+        }
+        state->draining = true;
+        while (!state->queue.empty() && state->active < state->maxConcurrent && state->out.is_subscribed()) {
+            auto st = std::move(state->queue.front());
+            state->queue.pop_front();
+            subscribe_inner(state, std::move(st));
+        }
+        state->draining = false;
+    }
+
+    template<class State>
+    static void subscribe_inner(const std::shared_ptr<State>& state, source_value_type st) {
+
+        rxcpp::detail::arena_scope scope(state->arena.get());
+
+        composite_subscription innercs;
+
+        auto slot = add_inner(state, innercs, same_worker());
+
+        auto selectedSource = state->coordinator.in(st);
+
+        ++state->active;
+        // this subscribe does not share the source subscription
+        // so that when it is unsubscribed the source will continue
+        auto sinkInner = make_subscriber<value_type>(
+            state->out,
+            innercs,
+        // on_next
+            [state, st](value_type ct) {
+                state->out.on_next(std::move(ct));
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        //on_completed
+            [state, slot](){
+                release_inner(state, slot, same_worker());
+                --state->active;
+                if (!state->queue.empty()) {
+                    drain(state);
+                }
+                if (--state->pendingCompletions == 0) {
+                    state->out.on_completed();
+                }
+            }
+        );
+
+        auto selectedSinkInner = state->coordinator.out(sinkInner);
+        selectedSource.subscribe(std::move(selectedSinkInner));
+    }
+
     template<class Subscriber>
     void on_subscribe(Subscriber scbr) const {
         static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
@@ -62,22 +210,36 @@ struct merge
                 : values(i)
                 , source(i.source_operator)
                 , pendingCompletions(0)
+                , active(0)
+                , draining(false)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
+                , arena(rxcpp::detail::current_arena())
             {
             }
             observable<source_value_type, source_operator_type> source;
             // on_completed on the output must wait until all the
             // subscriptions have received on_completed
             int pendingCompletions;
+            // nested observables that are subscribed
+            int active;
+            bool draining;
+            // nested observables that wait for a free slot
+            std::deque<source_value_type> queue;
             coordinator_type coordinator;
             output_type out;
+            // inner subscriptions allocate from the arena of the subscribe
+            std::shared_ptr<rxcpp::detail::arena_state> arena;
+            // used with the same worker
+            inner_slots inners;
         };
 
-        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+        auto coordinator = rxcpp::detail::in_out_coordinator<coordination_type>::create(initial.coordination, scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxcpp::detail::allocate_state<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        add_slots(state, same_worker());
 
         composite_subscription outercs;
 
@@ -101,43 +263,13 @@ struct merge
             outercs,
         // on_next
             [state](source_value_type st) {
-
-                composite_subscription innercs;
-
-                // when the out observer is unsubscribed all the
-                // inner subscriptions are unsubscribed as well
-                auto innercstoken = state->out.add(innercs);
-
-                innercs.add(make_subscription([state, innercstoken](){
-                    state->out.remove(innercstoken);
-                }));
-
-                auto selectedSource = state->coordinator.in(st);
-
                 ++state->pendingCompletions;
-                // this subscribe does not share the source subscription
-                // so that when it is unsubscribed the source will continue
-                auto sinkInner = make_subscriber<value_type>(
-                    state->out,
-                    innercs,
-                // on_next
-                    [state, st](value_type ct) {
-                        state->out.on_next(std::move(ct));
-                    },
-                // on_error
-                    [state](std::exception_ptr e) {
-                        state->out.on_error(e);
-                    },
-                //on_completed
-                    [state](){
-                        if (--state->pendingCompletions == 0) {
-                            state->out.on_completed();
-                        }
-                    }
-                );
-
-                auto selectedSinkInner = state->coordinator.out(sinkInner);
-                selectedSource.subscribe(std::move(selectedSinkInner));
+                if (state->maxConcurrent == 0) {
+                    subscribe_inner(state, std::move(st));
+                    return;
+                }
+                state->queue.push_back(std::move(st));
+                drain(state);
             },
         // on_error
             [state](std::exception_ptr e) {
@@ -166,9 +298,11 @@ class merge_factory
     typedef rxu::decay_t<Coordination> coordination_type;
 
     coordination_type coordination;
+    int maxConcurrent;
 public:
-    merge_factory(coordination_type sf)
+    merge_factory(coordination_type sf, int mc = 0)
         : coordination(std::move(sf))
+        , maxConcurrent(mc)
     {
     }
 
@@ -176,7 +310,7 @@ public:
     auto operator()(Observable source)
         ->      observable<rxu::value_type_t<merge<rxu::value_type_t<Observable>, Observable, Coordination>>,   merge<rxu::value_type_t<Observable>, Observable, Coordination>> {
         return  observable<rxu::value_type_t<merge<rxu::value_type_t<Observable>, Observable, Coordination>>,   merge<rxu::value_type_t<Observable>, Observable, Coordination>>(
-                                                                                                                merge<rxu::value_type_t<Observable>, Observable, Coordination>(std::move(source), coordination));
+                                                                                                                merge<rxu::value_type_t<Observable>, Observable, Coordination>(std::move(source), coordination, maxConcurrent));
     }
 };
 
@@ -188,6 +322,14 @@ auto merge(Coordination&& sf)
     return  detail::merge_factory<Coordination>(std::forward<Coordination>(sf));
 }
 
+/// subscribes to at most maxConcurrent of the nested observables at a time,
+/// the rest wait in order until a subscribed observable completes.
+template<class Coordination>
+auto merge(Coordination&& sf, int maxConcurrent)
+    ->      detail::merge_factory<Coordination> {
+    return  detail::merge_factory<Coordination>(std::forward<Coordination>(sf), maxConcurrent);
+}
+
 }
 
 }
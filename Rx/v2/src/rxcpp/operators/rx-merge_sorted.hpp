@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_MERGE_SORTED_HPP)
+#define RXCPP_OPERATORS_RX_MERGE_SORTED_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+/// merges sources that are each ordered by compare into one ordered stream.
+/// the head of every source is kept in a heap, and the least head is sent
+/// once every source that has not completed has a head.
+///
+/// a source that has had no head for idle is passed over until it sends
+/// again, so that the others are not held up by it. a value that it sends
+/// then, which is less than a value already sent, is sent at once. an idle
+/// of zero waits for every source.
+template<class T, class Compare, class Coordination>
+struct merge_sorted : public operator_base<T>
+{
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Compare> compare_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+    typedef std::vector<observable<value_type>> sources_type;
+
+    struct values
+    {
+        values(sources_type s, compare_type c, clock_type::duration i, coordination_type cn)
+            : sources(std::move(s))
+            , compare(std::move(c))
+            , idle(i)
+            , coordination(std::move(cn))
+        {
+        }
+        sources_type sources;
+        compare_type compare;
+        clock_type::duration idle;
+        coordination_type coordination;
+    };
+    values initial;
+
+    merge_sorted(sources_type s, compare_type c, clock_type::duration idle, coordination_type cn)
+        : initial(std::move(s), std::move(c), idle, std::move(cn))
+    {
+    }
+
+    struct input_state
+    {
+        input_state()
+            : completed(false)
+            , idle(false)
+        {
+        }
+        // the values that arrived before they could be sent
+        rxu::detail::ring_queue<value_type> queue;
+        bool completed;
+        // passed over until it sends again
+        bool idle;
+        clock_type::time_point empty_since;
+    };
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef Subscriber output_type;
+
+        struct merge_sorted_state_type
+            : public std::enable_shared_from_this<merge_sorted_state_type>
+            , public values
+        {
+            merge_sorted_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(std::move(i))
+                , inputs(this->sources.size())
+                , waiting(this->sources.size())
+                , remaining(this->sources.size())
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+                auto now = coordinator.get_worker().now();
+                for (auto& in : inputs) {
+                    in.empty_since = now;
+                }
+            }
+
+            // orders the heap so that the least head is at the front
+            struct later
+            {
+                merge_sorted_state_type* state;
+                bool operator()(size_t a, size_t b) const {
+                    return state->compare(state->inputs[b].queue.front(), state->inputs[a].queue.front());
+                }
+            };
+
+            void push(size_t i, value_type v) {
+                auto& in = inputs[i];
+                auto first = in.queue.empty();
+                in.queue.push_back(std::move(v));
+                if (first) {
+                    if (in.idle) {
+                        in.idle = false;
+                    } else {
+                        --waiting;
+                    }
+                    heap.push_back(i);
+                    std::push_heap(heap.begin(), heap.end(), later{this});
+                }
+                drain();
+            }
+
+            void complete(size_t i) {
+                auto& in = inputs[i];
+                in.completed = true;
+                --remaining;
+                if (in.queue.empty() && !in.idle) {
+                    --waiting;
+                }
+                drain();
+            }
+
+            // marks the sources that have been empty for idle
+            void expire() {
+                auto now = coordinator.get_worker().now();
+                auto found = false;
+                for (auto& in : inputs) {
+                    if (!in.completed && !in.idle && in.queue.empty() && now - in.empty_since >= this->idle) {
+                        in.idle = true;
+                        --waiting;
+                        found = true;
+                    }
+                }
+                if (found) {
+                    drain();
+                }
+            }
+
+            // sends the least heads while no source is waited for
+            void drain() {
+                while (waiting == 0 && !heap.empty() && out.is_subscribed()) {
+                    std::pop_heap(heap.begin(), heap.end(), later{this});
+                    auto i = heap.back();
+                    auto& in = inputs[i];
+                    auto v = std::move(in.queue.front());
+                    in.queue.pop_front();
+                    if (!in.queue.empty()) {
+                        std::push_heap(heap.begin(), heap.end(), later{this});
+                    } else {
+                        heap.pop_back();
+                        if (!in.completed) {
+                            ++waiting;
+                            if (this->idle != clock_type::duration::zero()) {
+                                in.empty_since = coordinator.get_worker().now();
+                            }
+                        }
+                    }
+                    out.on_next(std::move(v));
+                }
+                if (remaining == 0 && heap.empty()) {
+                    out.on_completed();
+                }
+            }
+
+            std::vector<input_state> inputs;
+            // the sources that have a head
+            std::vector<size_t> heap;
+            // the sources without a head that have neither completed nor
+            // been passed over
+            size_t waiting;
+            size_t remaining;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxcpp::detail::allocate_state<merge_sorted_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        if (state->sources.empty()) {
+            state->out.on_completed();
+            return;
+        }
+
+        if (state->idle != clock_type::duration::zero()) {
+            auto worker = state->coordinator.get_worker();
+            auto selectedExpire = on_exception(
+                [&](){
+                    return state->coordinator.act([state](const rxsc::schedulable&){
+                        state->expire();
+                    });
+                },
+                state->out);
+            if (selectedExpire.empty()) {
+                return;
+            }
+            worker.schedule_periodically(worker.now() + state->idle, state->idle, selectedExpire.get());
+        }
+
+        for (size_t i = 0; i != state->sources.size(); ++i) {
+            composite_subscription innercs;
+
+            // when the out observer is unsubscribed all the
+            // inner subscriptions are unsubscribed as well
+            auto innercstoken = state->out.add(innercs);
+            innercs.add(make_subscription([state, innercstoken](){
+                state->out.remove(innercstoken);
+            }));
+
+            auto source = on_exception(
+                [&](){return state->coordinator.in(state->sources[i]);},
+                state->out);
+            if (source.empty()) {
+                return;
+            }
+
+            auto sink = make_subscriber<value_type>(
+                state->out,
+                innercs,
+            // on_next
+                [state, i](value_type v) {
+                    state->push(i, std::move(v));
+                },
+            // on_error
+                [state](std::exception_ptr e) {
+                    state->out.on_error(e);
+                },
+            // on_completed
+                [state, i]() {
+                    state->complete(i);
+                }
+            );
+            auto selectedSink = on_exception(
+                [&](){return state->coordinator.out(sink);},
+                state->out);
+            if (selectedSink.empty()) {
+                return;
+            }
+            source->subscribe(std::move(selectedSink.get()));
+        }
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
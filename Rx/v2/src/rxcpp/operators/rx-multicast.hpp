@@ -24,10 +24,14 @@ struct multicast : public operator_base<T>
         multicast_state(source_type o, subject_type sub)
             : source(std::move(o))
             , subject_value(std::move(sub))
+            , connected(false)
         {
         }
         source_type source;
         subject_type subject_value;
+        // claimed by the connect that subscribes the source, so that
+        // concurrent connects do not need a lock to find the winner
+        std::atomic<bool> connected;
         rxu::detail::maybe<typename composite_subscription::weak_subscription> connection;
     };
 
@@ -42,26 +46,31 @@ struct multicast : public operator_base<T>
         state->subject_value.get_observable().subscribe(std::forward<Subscriber>(o));
     }
     void on_connect(composite_subscription cs) const {
-        if (state->connection.empty()) {
-            auto destination = state->subject_value.get_subscriber();
+        bool expected = false;
+        if (state->connected.load(std::memory_order_relaxed) ||
+            !state->connected.compare_exchange_strong(expected, true)) {
+            return;
+        }
 
-            // the lifetime of each connect is nested in the subject lifetime
-            state->connection.reset(destination.add(cs));
+        auto destination = state->subject_value.get_subscriber();
 
-            auto localState = state;
+        // the lifetime of each connect is nested in the subject lifetime
+        state->connection.reset(destination.add(cs));
 
-            // when the connection is finished it should shutdown the connection
-            cs.add(
-                [destination, localState](){
-                    if (!localState->connection.empty()) {
-                        destination.remove(localState->connection.get());
-                        localState->connection.reset();
-                    }
-                });
+        auto localState = state;
 
-            // use cs not destination for lifetime of subscribe.
-            state->source.subscribe(cs, destination);
-        }
+        // when the connection is finished it should shutdown the connection
+        cs.add(
+            [destination, localState](){
+                if (!localState->connection.empty()) {
+                    destination.remove(localState->connection.get());
+                    localState->connection.reset();
+                    localState->connected = false;
+                }
+            });
+
+        // use cs not destination for lifetime of subscribe.
+        state->source.subscribe(cs, destination);
     }
 };
 
@@ -11,8 +11,147 @@ namespace rxcpp {
 
 namespace operators {
 
+/// what observe_on does when a value arrives and its queue is full
+struct overflow_policy
+{
+    enum type {
+        /// wait until the worker has taken values from the queue.
+        /// the producer must not be running on the worker that drains the queue.
+        block_producer,
+        /// discard the value that arrived
+        drop_newest,
+        /// discard the oldest value waiting in the queue
+        drop_oldest,
+        /// discard the queue and end the stream with queue_overflow_error
+        error
+    };
+};
+
+struct queue_overflow_error : public std::runtime_error
+{
+    queue_overflow_error()
+        : std::runtime_error("observe_on queue is full")
+    {
+    }
+};
+
+/// counts the notifications waiting in the queues of the observe_on
+/// operators that share it. copies refer to the same counters.
+/// a queue_depth made from a memory_budget also charges the budget for
+/// each queued notification.
+class queue_depth
+{
+    struct state_type
+    {
+        explicit state_type(memory_budget b)
+            : current(0)
+            , peak(0)
+            , dropped(0)
+            , budget(std::move(b))
+        {
+        }
+        std::atomic<size_t> current;
+        std::atomic<size_t> peak;
+        std::atomic<size_t> dropped;
+        memory_budget budget;
+    };
+    std::shared_ptr<state_type> state;
+    // the bytes charged for each notification, set by the operator
+    size_t item_bytes;
+
+    struct empty_tag {};
+    explicit queue_depth(empty_tag)
+        : item_bytes(0)
+    {
+    }
+
+public:
+    queue_depth()
+        : state(std::make_shared<state_type>(memory_budget::empty()))
+        , item_bytes(0)
+    {
+    }
+
+    explicit queue_depth(memory_budget budget)
+        : state(std::make_shared<state_type>(std::move(budget)))
+        , item_bytes(0)
+    {
+    }
+
+    /// a queue_depth that counts nothing
+    static queue_depth empty() {
+        return queue_depth(empty_tag());
+    }
+
+    /// notifications queued now
+    size_t current() const {
+        return !!state ? state->current.load() : 0;
+    }
+    /// the most notifications that have been queued at one time
+    size_t peak() const {
+        return !!state ? state->peak.load() : 0;
+    }
+    /// values discarded by the drop policies
+    size_t dropped() const {
+        return !!state ? state->dropped.load() : 0;
+    }
+
+    /// for the operators. a copy that charges bytes for each notification.
+    queue_depth sized(size_t bytes) const {
+        queue_depth result = *this;
+        result.item_bytes = bytes;
+        return result;
+    }
+
+    void add(size_t n) const {
+        if (!!state) {
+            auto now = state->current += n;
+            auto peak = state->peak.load();
+            while (peak < now && !state->peak.compare_exchange_weak(peak, now));
+            state->budget.charge(n * item_bytes, n);
+        }
+    }
+    void remove(size_t n) const {
+        if (!!state && n > 0) {
+            state->current -= n;
+            state->budget.refund(n * item_bytes, n);
+        }
+    }
+    void drop(size_t n) const {
+        if (!!state) {
+            state->dropped += n;
+        }
+    }
+};
+
 namespace detail {
 
+/// the number of notifications that one drain delivers before it yields the worker
+enum { observe_on_default_batch = 16 };
+
+struct observe_on_settings
+{
+    observe_on_settings()
+        : batch(observe_on_default_batch)
+        , capacity(0)
+        , policy(overflow_policy::block_producer)
+        , depth(queue_depth::empty())
+        , upstream(demand::unbounded())
+        , window(0)
+    {
+    }
+    /// notifications delivered by one drain before it yields the worker
+    size_t batch;
+    /// the most values waiting in the queue, zero is unbounded
+    size_t capacity;
+    overflow_policy::type policy;
+    queue_depth depth;
+    /// when bounded, window values are requested from upstream at subscribe
+    /// and one more is requested as each value is delivered
+    demand upstream;
+    size_t window;
+};
+
 template<class T, class Coordination>
 struct observe_on
 {
@@ -22,10 +161,13 @@ struct observe_on
     typedef typename coordination_type::coordinator_type coordinator_type;
 
     coordination_type coordination;
+    observe_on_settings settings;
 
-    observe_on(coordination_type cn)
+    observe_on(coordination_type cn, observe_on_settings s = observe_on_settings())
         : coordination(std::move(cn))
+        , settings(std::move(s))
     {
+        settings.batch = (std::max)(settings.batch, size_t(1));
     }
 
     template<class Subscriber>
@@ -37,9 +179,10 @@ struct observe_on
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<value_type, this_type> observer_type;
 
-        typedef rxn::notification<T> notification_type;
-        typedef typename notification_type::type base_notification_type;
-        typedef std::queue<base_notification_type> queue_type;
+        // notifications are queued by value so that crossing to the
+        // worker does not allocate for each notification
+        typedef rxn::notification_value<source_value_type> notification_type;
+        typedef std::queue<notification_type> queue_type;
 
         struct mode
         {
@@ -53,20 +196,103 @@ struct observe_on
         };
         struct observe_on_state : std::enable_shared_from_this<observe_on_state>
         {
+            // the producer and the drain run on different threads. the
+            // members that only one of them writes are kept out of the
+            // cache lines of the other.
+
+            // set at subscribe and then only read
+            coordinator_type coordinator;
+            rxsc::worker processor;
+            observe_on_settings settings;
+            composite_subscription lifetime;
+            // notifications allocate from the arena of the subscribe
+            std::shared_ptr<rxcpp::detail::arena_state> arena;
+            rxu::detail::cache_line_pad read_pad;
+
+            // the producer and the drain meet here, under the lock
             mutable std::mutex lock;
+            mutable std::condition_variable space;
             mutable queue_type queue;
-            mutable queue_type drain_queue;
-            composite_subscription lifetime;
             mutable typename mode::type current;
-            coordinator_type coordinator;
+            mutable bool overflowed;
+            rxu::detail::cache_line_pad shared_pad;
+
+            // only the drain writes these
+            mutable queue_type drain_queue;
             dest_type destination;
 
-            observe_on_state(dest_type d, coordinator_type coor, composite_subscription cs)
-                : lifetime(std::move(cs))
+            observe_on_state(dest_type d, coordinator_type coor, composite_subscription cs, observe_on_settings s)
+                : coordinator(std::move(coor))
+                , processor(coordinator.get_worker())
+                , settings(std::move(s))
+                , lifetime(std::move(cs))
+                , arena(rxcpp::detail::current_arena())
                 , current(mode::Empty)
-                , coordinator(std::move(coor))
+                , overflowed(false)
                 , destination(std::move(d))
             {
+                settings.depth = settings.depth.sized(sizeof(notification_type));
+            }
+
+            // call with lock held
+            void expire() const {
+                using std::swap;
+                queue_type expired;
+                swap(expired, queue);
+                settings.depth.remove(expired.size());
+                space.notify_all();
+            }
+
+            // call with lock held. applies the overflow policy, returns false
+            // when the value must not be queued
+            bool admit(std::unique_lock<std::mutex>& guard) const {
+                if (overflowed) {
+                    return false;
+                }
+                if (settings.capacity == 0 || queue.size() < settings.capacity) {
+                    return true;
+                }
+                switch (settings.policy) {
+                case overflow_policy::block_producer:
+                    space.wait(guard, [this](){
+                        return queue.size() < settings.capacity ||
+                            current == mode::Disposed || current == mode::Errored ||
+                            !destination.is_subscribed();
+                    });
+                    return queue.size() < settings.capacity;
+                case overflow_policy::drop_newest:
+                    settings.depth.drop(1);
+                    return false;
+                case overflow_policy::drop_oldest:
+                    queue.pop();
+                    settings.depth.remove(1);
+                    settings.depth.drop(1);
+                    return true;
+                case overflow_policy::error:
+                    overflowed = true;
+                    expire();
+                    queue.push(notification_type::on_error(std::make_exception_ptr(queue_overflow_error())));
+                    settings.depth.add(1);
+                    ensure_processing(guard);
+                    return false;
+                }
+                return true;
+            }
+
+            // call with lock held. moves queued notifications to the drain.
+            // a bounded queue gives the drain one batch at a time so that
+            // the policy applies to all the values that are not being delivered.
+            void claim() const {
+                using std::swap;
+                if (settings.capacity == 0) {
+                    swap(queue, drain_queue);
+                    return;
+                }
+                for (size_t n = 0; n < settings.batch && !queue.empty(); ++n) {
+                    drain_queue.push(std::move(queue.front()));
+                    queue.pop();
+                }
+                space.notify_all();
             }
 
             void ensure_processing(std::unique_lock<std::mutex>& guard) const {
@@ -79,38 +305,44 @@ struct observe_on
                     auto keepAlive = this->shared_from_this();
 
                     auto drain = [keepAlive, this](const rxsc::schedulable& self){
-                        using std::swap;
                         try {
-                            if (drain_queue.empty() || !destination.is_subscribed()) {
-                                std::unique_lock<std::mutex> guard(lock);
-                                if (!destination.is_subscribed() ||
-                                    (!lifetime.is_subscribed() && queue.empty() && drain_queue.empty())) {
-                                    current = mode::Disposed;
-                                    queue_type expired;
-                                    swap(expired, queue);
-                                    guard.unlock();
-                                    lifetime.unsubscribe();
-                                    destination.unsubscribe();
-                                    return;
-                                }
-                                if (drain_queue.empty()) {
-                                    if (queue.empty()) {
-                                        current = mode::Empty;
+                            // deliver a batch, then yield the worker to other actions
+                            for (size_t delivered = 0; delivered < settings.batch; ++delivered) {
+                                if (drain_queue.empty() || !destination.is_subscribed()) {
+                                    std::unique_lock<std::mutex> guard(lock);
+                                    if (!destination.is_subscribed() ||
+                                        (!lifetime.is_subscribed() && queue.empty() && drain_queue.empty())) {
+                                        current = mode::Disposed;
+                                        expire();
+                                        settings.depth.remove(drain_queue.size());
+                                        guard.unlock();
+                                        lifetime.unsubscribe();
+                                        destination.unsubscribe();
                                         return;
                                     }
-                                    swap(queue, drain_queue);
+                                    if (drain_queue.empty()) {
+                                        if (queue.empty()) {
+                                            current = mode::Empty;
+                                            return;
+                                        }
+                                        claim();
+                                    }
+                                }
+                                auto notification = std::move(drain_queue.front());
+                                drain_queue.pop();
+                                settings.depth.remove(1);
+                                auto replenish = notification.is_on_next();
+                                notification.deliver(destination);
+                                if (replenish) {
+                                    settings.upstream.request(1);
                                 }
                             }
-                            auto notification = std::move(drain_queue.front());
-                            drain_queue.pop();
-                            notification->accept(destination);
                             self();
                         } catch(...) {
                             destination.on_error(std::current_exception());
                             std::unique_lock<std::mutex> guard(lock);
                             current = mode::Errored;
-                            queue_type expired;
-                            swap(expired, queue);
+                            expire();
                         }
                     };
 
@@ -119,14 +351,10 @@ struct observe_on
                         destination);
                     if (selectedDrain.empty()) {
                         current = mode::Errored;
-                        using std::swap;
-                        queue_type expired;
-                        swap(expired, queue);
+                        expire();
                         return;
                     }
 
-                    auto processor = coordinator.get_worker();
-
                     RXCPP_UNWIND_AUTO([&](){guard.lock();});
                     guard.unlock();
 
@@ -136,37 +364,76 @@ struct observe_on
         };
         std::shared_ptr<observe_on_state> state;
 
-        observe_on_observer(dest_type d, coordinator_type coor, composite_subscription cs)
-            : state(std::make_shared<observe_on_state>(std::move(d), std::move(coor), std::move(cs)))
+        observe_on_observer(dest_type d, coordinator_type coor, composite_subscription cs, observe_on_settings settings)
+            : state(rxcpp::detail::allocate_state<observe_on_state>(std::move(d), std::move(coor), std::move(cs), std::move(settings)))
         {
         }
 
         void on_next(source_value_type v) const {
+            rxcpp::detail::arena_scope scope(state->arena.get());
             std::unique_lock<std::mutex> guard(state->lock);
+            if (!state->admit(guard)) {
+                return;
+            }
+            if (state->current == mode::Empty && state->processor.is_running()) {
+                // already on the worker and nothing is waiting to be
+                // delivered before this value, so it is delivered here
+                state->current = mode::Processing;
+                guard.unlock();
+                try {
+                    state->destination.on_next(std::move(v));
+                } catch(...) {
+                    state->destination.on_error(std::current_exception());
+                    guard.lock();
+                    state->current = mode::Errored;
+                    state->expire();
+                    return;
+                }
+                state->settings.upstream.request(1);
+                guard.lock();
+                state->current = mode::Empty;
+                if (!state->queue.empty() || !state->lifetime.is_subscribed()) {
+                    state->ensure_processing(guard);
+                }
+                return;
+            }
             state->queue.push(notification_type::on_next(std::move(v)));
+            state->settings.depth.add(1);
             state->ensure_processing(guard);
         }
         void on_error(std::exception_ptr e) const {
+            rxcpp::detail::arena_scope scope(state->arena.get());
             std::unique_lock<std::mutex> guard(state->lock);
+            if (state->overflowed) {
+                return;
+            }
             state->queue.push(notification_type::on_error(e));
+            state->settings.depth.add(1);
             state->ensure_processing(guard);
         }
         void on_completed() const {
+            rxcpp::detail::arena_scope scope(state->arena.get());
             std::unique_lock<std::mutex> guard(state->lock);
+            if (state->overflowed) {
+                return;
+            }
             state->queue.push(notification_type::on_completed());
+            state->settings.depth.add(1);
             state->ensure_processing(guard);
         }
 
-        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, coordination_type cn, composite_subscription cs = composite_subscription()) {
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, coordination_type cn, observe_on_settings settings, composite_subscription cs = composite_subscription()) {
             auto coor = cn.create_coordinator(d.get_subscription());
             d.add(cs);
 
-            this_type o(d, std::move(coor), cs);
+            this_type o(d, std::move(coor), cs, std::move(settings));
             auto keepAlive = o.state;
             cs.add([keepAlive](){
                 std::unique_lock<std::mutex> guard(keepAlive->lock);
+                keepAlive->space.notify_all();
                 keepAlive->ensure_processing(guard);
             });
+            keepAlive->settings.upstream.request(keepAlive->settings.window);
 
             return make_subscriber<value_type>(d, cs, make_observer<value_type>(std::move(o)));
         }
@@ -174,31 +441,65 @@ struct observe_on
 
     template<class Subscriber>
     auto operator()(Subscriber dest) const
-        -> decltype(observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination)) {
-        return      observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination);
+        -> decltype(observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination, settings)) {
+        return      observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination, settings);
     }
 };
 
+inline observe_on_settings make_observe_on_settings(size_t batch) {
+    observe_on_settings result;
+    result.batch = batch;
+    return result;
+}
+
+inline observe_on_settings make_observe_on_settings(demand upstream, size_t window) {
+    observe_on_settings result;
+    result.upstream = std::move(upstream);
+    result.window = (std::max)(window, size_t(1));
+    return result;
+}
+
+inline observe_on_settings make_observe_on_settings(size_t capacity, overflow_policy::type policy, queue_depth depth) {
+    observe_on_settings result;
+    result.capacity = capacity;
+    result.policy = policy;
+    result.depth = std::move(depth);
+    return result;
+}
+
 template<class Coordination>
 class observe_on_factory
 {
     typedef rxu::decay_t<Coordination> coordination_type;
     coordination_type coordination;
+    observe_on_settings settings;
 public:
-    observe_on_factory(coordination_type cn) : coordination(std::move(cn)) {}
+    observe_on_factory(coordination_type cn, observe_on_settings s) : coordination(std::move(cn)), settings(std::move(s)) {}
     template<class Observable>
     auto operator()(Observable&& source)
-        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on<rxu::value_type_t<rxu::decay_t<Observable>>, coordination_type>(coordination))) {
-        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on<rxu::value_type_t<rxu::decay_t<Observable>>, coordination_type>(coordination));
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on<rxu::value_type_t<rxu::decay_t<Observable>>, coordination_type>(coordination, settings))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on<rxu::value_type_t<rxu::decay_t<Observable>>, coordination_type>(coordination, settings));
     }
 };
 
 }
 
 template<class Coordination>
-auto observe_on(Coordination cn)
+auto observe_on(Coordination cn, size_t batch = detail::observe_on_default_batch)
     ->      detail::observe_on_factory<Coordination> {
-    return  detail::observe_on_factory<Coordination>(std::move(cn));
+    return  detail::observe_on_factory<Coordination>(std::move(cn), detail::make_observe_on_settings(batch));
+}
+
+template<class Coordination>
+auto observe_on(Coordination cn, demand upstream, size_t window = detail::observe_on_default_batch)
+    ->      detail::observe_on_factory<Coordination> {
+    return  detail::observe_on_factory<Coordination>(std::move(cn), detail::make_observe_on_settings(std::move(upstream), window));
+}
+
+template<class Coordination>
+auto observe_on(Coordination cn, size_t capacity, overflow_policy::type policy, queue_depth depth = queue_depth::empty())
+    ->      detail::observe_on_factory<Coordination> {
+    return  detail::observe_on_factory<Coordination>(std::move(cn), detail::make_observe_on_settings(capacity, policy, std::move(depth)));
 }
 
 
@@ -252,6 +553,10 @@ public:
 
     typedef coordinator<input_type> coordinator_type;
 
+    inline const rxsc::scheduler& get_scheduler() const {
+        return factory;
+    }
+
     inline rxsc::scheduler::clock_type::time_point now() const {
         return factory.now();
     }
@@ -272,6 +577,23 @@ inline observe_on_one_worker observe_on_new_thread() {
     return r;
 }
 
+/// like observe_on_new_thread, with threads that are reused once the
+/// subscription that had them has ended
+inline observe_on_one_worker observe_on_cached_new_thread() {
+    static observe_on_one_worker r(rxsc::make_cached_new_thread());
+    return r;
+}
+
+inline observe_on_one_worker observe_on_work_stealing_pool() {
+    static observe_on_one_worker r(rxsc::make_work_stealing_pool());
+    return r;
+}
+
+/// delivers on the thread that dispatches rl
+inline observe_on_one_worker observe_on_run_loop(const rxsc::run_loop& rl) {
+    return observe_on_one_worker(rxsc::make_run_loop(rl));
+}
+
 }
 
 #endif
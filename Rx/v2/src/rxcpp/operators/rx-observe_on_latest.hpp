@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_OBSERVE_ON_LATEST_HPP)
+#define RXCPP_OPERATORS_RX_OBSERVE_ON_LATEST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+struct keep_latest
+{
+    template<class T>
+    T operator()(T, T next) const {
+        return next;
+    }
+};
+
+// holds one value while a delivery is waiting on the worker. the values that
+// arrive before it runs are combined into that one, so the worker runs at most
+// one delivery for each time that it gets to run, however fast the producer.
+template<class T, class Coordination, class Combiner>
+struct observe_on_latest
+{
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Combiner> combiner_type;
+
+    struct observe_on_latest_values
+    {
+        observe_on_latest_values(coordination_type c, combiner_type cb)
+            : coordination(std::move(c))
+            , combiner(std::move(cb))
+        {
+        }
+        coordination_type coordination;
+        combiner_type combiner;
+    };
+    observe_on_latest_values initial;
+
+    observe_on_latest(coordination_type coordination, combiner_type combiner)
+        : initial(std::move(coordination), std::move(combiner))
+    {
+    }
+
+    template<class Subscriber>
+    struct observe_on_latest_observer
+    {
+        typedef observe_on_latest_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct observe_on_latest_subscriber_values : public observe_on_latest_values
+        {
+            observe_on_latest_subscriber_values(dest_type d, observe_on_latest_values v, coordinator_type c)
+                : observe_on_latest_values(std::move(v))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , scheduled(false)
+                , completed(false)
+            {
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            std::mutex lock;
+            rxu::maybe<value_type> value;
+            std::exception_ptr error;
+            bool scheduled;
+            bool completed;
+        };
+        typedef std::shared_ptr<observe_on_latest_subscriber_values> state_type;
+        state_type state;
+
+        observe_on_latest_observer(dest_type d, observe_on_latest_values v, coordinator_type c)
+            : state(std::make_shared<observe_on_latest_subscriber_values>(std::move(d), std::move(v), std::move(c)))
+        {
+        }
+
+        static void deliver(const state_type& state) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            rxu::maybe<value_type> v;
+            if (!state->value.empty()) {
+                v.reset(std::move(state->value.get()));
+                state->value.reset();
+            }
+            auto completed = state->completed;
+            auto error = state->error;
+            // a value that arrives during the delivery schedules the next one
+            state->scheduled = false;
+            guard.unlock();
+
+            if (!v.empty()) {
+                state->dest.on_next(std::move(v.get()));
+            }
+            if (error) {
+                state->dest.on_error(error);
+            } else if (completed) {
+                state->dest.on_completed();
+            }
+        }
+
+        // call with the lock held
+        static void ensure_scheduled(const state_type& state, std::unique_lock<std::mutex>& guard) {
+            if (state->scheduled) {
+                return;
+            }
+            state->scheduled = true;
+            guard.unlock();
+            auto localState = state;
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act([localState](const rxsc::schedulable&){
+                    deliver(localState);
+                });},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        void on_next(T v) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->error || state->completed) {
+                return;
+            }
+            if (state->value.empty()) {
+                state->value.reset(std::move(v));
+            } else {
+                try {
+                    state->value.reset(state->combiner(std::move(state->value.get()), std::move(v)));
+                } catch(...) {
+                    state->value.reset();
+                    state->error = std::current_exception();
+                }
+            }
+            ensure_scheduled(state, guard);
+        }
+        void on_error(std::exception_ptr e) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->error || state->completed) {
+                return;
+            }
+            state->error = e;
+            ensure_scheduled(state, guard);
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->error || state->completed) {
+                return;
+            }
+            state->completed = true;
+            ensure_scheduled(state, guard);
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, observe_on_latest_values v) {
+            auto coordinator = v.coordination.create_coordinator(d.get_subscription());
+
+            // the source ends before the delivery of its end has run, so
+            // it has a lifetime of its own
+            composite_subscription cs;
+            d.add(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(observe_on_latest_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      observe_on_latest_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Coordination, class Combiner>
+class observe_on_latest_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxu::decay_t<Combiner> combiner_type;
+
+    coordination_type coordination;
+    combiner_type combiner;
+public:
+    observe_on_latest_factory(coordination_type cn, combiner_type cb) : coordination(std::move(cn)), combiner(std::move(cb)) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on_latest<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, Combiner>(coordination, combiner))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(observe_on_latest<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, Combiner>(coordination, combiner));
+    }
+};
+
+}
+
+template<class Coordination>
+inline auto observe_on_latest(Coordination cn)
+    ->      detail::observe_on_latest_factory<Coordination, detail::keep_latest> {
+    return  detail::observe_on_latest_factory<Coordination, detail::keep_latest>(std::move(cn), detail::keep_latest());
+}
+
+template<class Coordination, class Combiner>
+inline auto observe_on_latest(Coordination cn, Combiner cb)
+    ->      detail::observe_on_latest_factory<Coordination, Combiner> {
+    return  detail::observe_on_latest_factory<Coordination, Combiner>(std::move(cn), std::move(cb));
+}
+
+}
+
+}
+
+#endif
@@ -13,34 +13,39 @@ namespace operators {
 
 namespace detail {
 
-template<class T>
+// Value is the source value, or a std::shared_ptr<const T> that the two
+// tuples a value is part of share.
+template<class T, class Value = rxu::decay_t<T>>
 struct pairwise
 {
     typedef rxu::decay_t<T> source_value_type;
-    typedef std::tuple<source_value_type, source_value_type> value_type;
+    typedef std::tuple<Value, Value> value_type;
 
     template<class Subscriber>
     struct pairwise_observer
     {
         typedef pairwise_observer<Subscriber> this_type;
-        typedef std::tuple<source_value_type, source_value_type> value_type;
+        typedef std::tuple<Value, Value> value_type;
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<T, this_type> observer_type;
         dest_type dest;
-        mutable rxu::detail::maybe<source_value_type> remembered;
+        mutable rxu::detail::maybe<Value> remembered;
 
         pairwise_observer(dest_type d)
             : dest(std::move(d))
         {
         }
         void on_next(source_value_type v) const {
+            auto held = hold_value<source_value_type, Value>::make(std::move(v));
             if (remembered.empty()) {
-                remembered.reset(v);
+                remembered.reset(std::move(held));
                 return;
             }
 
-            dest.on_next(std::make_tuple(remembered.get(), v));
-            remembered.reset(v);
+            // the value is copied once, to be remembered for the next pair
+            auto previous = std::move(remembered.get());
+            remembered.reset(held);
+            dest.on_next(std::make_tuple(std::move(previous), std::move(held)));
         }
         void on_error(std::exception_ptr e) const {
             dest.on_error(e);
@@ -50,8 +55,9 @@ struct pairwise
         }
 
         static subscriber<T, observer_type> make(dest_type d) {
-            auto cs = d.get_subscription();
-            return make_subscriber<T>(std::move(cs), observer_type(this_type(std::move(d))));
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            return subscriber<T, observer_type>(trace_id::make_next_id_subscriber(), std::move(cs), observer_type(this_type(std::move(d))));
         }
     };
 
@@ -72,6 +78,22 @@ public:
     }
 };
 
+class pairwise_shared_factory
+{
+    template<class Observable>
+    struct shared
+    {
+        typedef rxu::value_type_t<rxu::decay_t<Observable>> source_value_type;
+        typedef pairwise<source_value_type, std::shared_ptr<const source_value_type>> type;
+    };
+public:
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<typename shared<Observable>::type>>(typename shared<Observable>::type())) {
+        return      source.template lift<rxu::value_type_t<typename shared<Observable>::type>>(typename shared<Observable>::type());
+    }
+};
+
 }
 
 inline auto pairwise()
@@ -79,6 +101,11 @@ inline auto pairwise()
     return  detail::pairwise_factory();
 }
 
+inline auto pairwise_shared()
+    ->      detail::pairwise_shared_factory {
+    return  detail::pairwise_shared_factory();
+}
+
 }
 
 }
@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_PARALLEL_MAP_HPP)
+#define RXCPP_OPERATORS_RX_PARALLEL_MAP_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// sends each value to the next lane in turn
+struct round_robin_lanes
+{
+    template<class T>
+    size_t operator()(const T&, size_t position, size_t lanes) const {
+        return position % lanes;
+    }
+};
+
+// sends the values of a key to the same lane, found from the hash of the key
+template<class KeySelector>
+struct partition_lanes
+{
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    key_selector_type keySelector;
+
+    explicit partition_lanes(key_selector_type k)
+        : keySelector(std::move(k))
+    {
+    }
+    template<class T>
+    size_t operator()(const T& v, size_t, size_t lanes) const {
+        typedef rxu::decay_t<decltype(keySelector(v))> key_type;
+        return std::hash<key_type>()(keySelector(v)) % lanes;
+    }
+};
+
+// calls the selector for each value on one of degree workers. each worker
+// has a queue, a worker is only scheduled when its queue was empty, so a
+// burst of values costs one schedule per worker. the results are delivered
+// by one thread at a time and, when ordered, in the order of the source.
+// Lanes picks the worker for each value. a lane calls the selector for one
+// value at a time, in the order of the source, so with partition_lanes the
+// values of a key are selected one after another and, even when not
+// ordered, delivered in the order of the source.
+template<class T, class Selector, class Coordination, class Lanes = round_robin_lanes>
+struct parallel_map
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Selector> select_type;
+    typedef rxu::decay_t<decltype((*(select_type*)nullptr)(*(source_value_type*)nullptr))> value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Lanes> lanes_type;
+
+    struct parallel_map_values
+    {
+        parallel_map_values(select_type s, coordination_type c, int d, bool o, lanes_type l)
+            : selector(std::move(s))
+            , coordination(std::move(c))
+            , degree(std::max(d, 1))
+            , ordered(o)
+            , laneSelector(std::move(l))
+        {
+        }
+        select_type selector;
+        coordination_type coordination;
+        int degree;
+        bool ordered;
+        lanes_type laneSelector;
+    };
+    parallel_map_values initial;
+
+    parallel_map(select_type s, coordination_type c, int degree, bool ordered, lanes_type l = lanes_type())
+        : initial(std::move(s), std::move(c), degree, ordered, std::move(l))
+    {
+    }
+
+    template<class Subscriber>
+    struct parallel_map_observer
+    {
+        typedef parallel_map_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+
+        // the values waiting for one worker, with their position in the source
+        struct lane_type
+        {
+            explicit lane_type(coordinator_type coor)
+                : coordinator(std::move(coor))
+                , worker(coordinator.get_worker())
+                , scheduled(false)
+            {
+            }
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            std::deque<std::pair<size_t, source_value_type>> queue;
+            bool scheduled;
+        };
+
+        struct parallel_map_subscriber_values : public parallel_map_values
+        {
+            parallel_map_subscriber_values(parallel_map_values v, dest_type d)
+                : parallel_map_values(std::move(v))
+                , dest(std::move(d))
+                , next(0)
+                , delivered(0)
+                , active(0)
+                , completed(false)
+                , stopped(false)
+                , delivering(false)
+            {
+                for (int i = 0; i != this->degree; ++i) {
+                    lanes.push_back(std::make_shared<lane_type>(this->coordination.create_coordinator(dest.get_subscription())));
+                }
+            }
+            dest_type dest;
+            mutable std::mutex lock;
+            std::vector<std::shared_ptr<lane_type>> lanes;
+            // the position of the next value from the source
+            size_t next;
+            // the position of the next result to deliver
+            size_t delivered;
+            // results waiting to be delivered, the front is at delivered
+            std::deque<rxu::maybe<value_type>> results;
+            // values sent to a lane that have not produced a result yet
+            size_t active;
+            bool completed;
+            bool stopped;
+            bool delivering;
+            std::exception_ptr error;
+        };
+        typedef std::shared_ptr<parallel_map_subscriber_values> state_type;
+        state_type state;
+
+        explicit parallel_map_observer(state_type s)
+            : state(std::move(s))
+        {
+        }
+
+        // sends the results at the front and the final notification. only
+        // one thread delivers at a time, the others leave their results for it.
+        static void deliver(const state_type& state, std::unique_lock<std::mutex>& guard) {
+            if (state->delivering) {
+                return;
+            }
+            state->delivering = true;
+            for (;;) {
+                if (!!state->error) {
+                    auto e = state->error;
+                    guard.unlock();
+                    state->dest.on_error(e);
+                    return;
+                }
+                if (!state->results.empty() && !state->results.front().empty()) {
+                    auto v = std::move(state->results.front().get());
+                    state->results.pop_front();
+                    ++state->delivered;
+                    guard.unlock();
+                    state->dest.on_next(std::move(v));
+                    guard.lock();
+                    continue;
+                }
+                if (state->completed && state->active == 0) {
+                    state->stopped = true;
+                    guard.unlock();
+                    state->dest.on_completed();
+                    return;
+                }
+                state->delivering = false;
+                return;
+            }
+        }
+
+        static void fail(const state_type& state, std::exception_ptr e) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->stopped) {
+                return;
+            }
+            state->stopped = true;
+            state->error = e;
+            deliver(state, guard);
+        }
+
+        static void drain(const state_type& state, const std::shared_ptr<lane_type>& lane, const rxsc::schedulable& self) {
+            std::deque<std::pair<size_t, source_value_type>> taken;
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (state->stopped) {
+                    return;
+                }
+                taken.swap(lane->queue);
+            }
+            for (auto& item : taken) {
+                auto selected = on_exception(
+                    [&](){return state->selector(std::move(item.second));},
+                    [&](std::exception_ptr e){fail(state, e);});
+                if (selected.empty()) {
+                    return;
+                }
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (state->stopped) {
+                    return;
+                }
+                --state->active;
+                auto slot = state->ordered ? item.first - state->delivered : state->results.size();
+                if (state->results.size() <= slot) {
+                    state->results.resize(slot + 1);
+                }
+                state->results[slot].reset(std::move(selected.get()));
+                deliver(state, guard);
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (lane->queue.empty()) {
+                lane->scheduled = false;
+                return;
+            }
+            guard.unlock();
+            // let the other actions on this worker run before the next batch
+            self();
+        }
+
+        void on_next(source_value_type v) const {
+            auto localState = state;
+            std::shared_ptr<lane_type> lane;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                if (localState->stopped) {
+                    return;
+                }
+                auto position = localState->next;
+                auto index = on_exception(
+                    [&](){return localState->laneSelector(v, position, localState->lanes.size());},
+                    [&](std::exception_ptr e){
+                        localState->stopped = true;
+                        localState->error = e;
+                        deliver(localState, guard);});
+                if (index.empty()) {
+                    return;
+                }
+                ++localState->next;
+                lane = localState->lanes[index.get()];
+                ++localState->active;
+                lane->queue.push_back(std::make_pair(position, std::move(v)));
+                if (lane->scheduled) {
+                    return;
+                }
+                lane->scheduled = true;
+            }
+            auto selectedWork = on_exception(
+                [&](){return lane->coordinator.act([localState, lane](const rxsc::schedulable& self){
+                    drain(localState, lane, self);
+                });},
+                [&](std::exception_ptr e){fail(localState, e);});
+            if (selectedWork.empty()) {
+                return;
+            }
+            lane->worker.schedule(selectedWork.get());
+        }
+        void on_error(std::exception_ptr e) const {
+            fail(state, e);
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->stopped) {
+                return;
+            }
+            state->completed = true;
+            deliver(state, guard);
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, parallel_map_values v) {
+            auto cs = composite_subscription();
+            // the source completes before the workers have finished, so it
+            // does not share the lifetime of the destination
+            d.add(cs);
+            auto localState = std::make_shared<parallel_map_subscriber_values>(std::move(v), std::move(d));
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(localState))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(parallel_map_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      parallel_map_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Selector, class Coordination, class Lanes = round_robin_lanes>
+class parallel_map_factory
+{
+    typedef rxu::decay_t<Selector> select_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxu::decay_t<Lanes> lanes_type;
+
+    select_type selector;
+    coordination_type coordination;
+    int degree;
+    bool ordered;
+    lanes_type lanes;
+public:
+    parallel_map_factory(select_type s, coordination_type c, int d, bool o, lanes_type l = lanes_type())
+        : selector(std::move(s))
+        , coordination(std::move(c))
+        , degree(d)
+        , ordered(o)
+        , lanes(std::move(l))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<parallel_map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type, coordination_type, lanes_type>>>(parallel_map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type, coordination_type, lanes_type>(selector, coordination, degree, ordered, lanes))) {
+        return      source.template lift<rxu::value_type_t<parallel_map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type, coordination_type, lanes_type>>>(parallel_map<rxu::value_type_t<rxu::decay_t<Observable>>, select_type, coordination_type, lanes_type>(selector, coordination, degree, ordered, lanes));
+    }
+};
+
+}
+
+template<class Selector, class Coordination>
+auto parallel_map(Selector s, Coordination cn, int degree, bool ordered = true)
+    ->      detail::parallel_map_factory<Selector, Coordination> {
+    return  detail::parallel_map_factory<Selector, Coordination>(std::move(s), std::move(cn), degree, ordered);
+}
+
+template<class KeySelector, class Selector, class Coordination>
+auto partition_map(KeySelector k, Selector s, Coordination cn, int degree, bool ordered = false)
+    ->      detail::parallel_map_factory<Selector, Coordination, detail::partition_lanes<KeySelector>> {
+    return  detail::parallel_map_factory<Selector, Coordination, detail::partition_lanes<KeySelector>>(std::move(s), std::move(cn), degree, ordered, detail::partition_lanes<KeySelector>(std::move(k)));
+}
+
+}
+
+}
+
+#endif
@@ -27,7 +27,8 @@ struct is_accumulate_function_for {
     static tag_not_valid check(...);
 
     typedef decltype(check<seed_type, source_value_type, accumulator_type>(0)) type;
-    static const bool value = std::is_same<type, seed_type>::value;
+    // Seed(Seed, T), or void(Seed&, T) to update the seed in place
+    static const bool value = std::is_same<type, seed_type>::value || std::is_same<type, void>::value;
 };
 
 template<class Seed, class ResultSelector>
@@ -47,6 +48,18 @@ struct is_result_function_for {
     static const bool value = !std::is_same<type, tag_not_valid>::value;
 };
 
+// folds a batch of values that arrived together. the default calls the
+// accumulator once for each value.
+template<class Accumulator, class Seed, class T, class Enable = void>
+struct reduce_range
+{
+    static void apply(Accumulator& accumulator, Seed& current, const T* first, size_t count) {
+        for (auto last = first + count; first != last; ++first) {
+            detail::accumulate(accumulator, current, *first);
+        }
+    }
+};
+
 template<class T, class SourceOperator, class Accumulator, class ResultSelector, class Seed>
 struct reduce_traits
 {
@@ -57,7 +70,7 @@ struct reduce_traits
 
     typedef T source_value_type;
 
-    static_assert(is_accumulate_function_for<source_value_type, seed_type, accumulator_type>::value, "reduce Accumulator must be a function with the signature Seed(Seed, reduce::source_value_type)");
+    static_assert(is_accumulate_function_for<source_value_type, seed_type, accumulator_type>::value, "reduce Accumulator must be a function with the signature Seed(Seed, reduce::source_value_type) or void(Seed&, reduce::source_value_type)");
 
     static_assert(is_result_function_for<seed_type, result_selector_type>::value, "reduce ResultSelector must be a function with the signature reduce::value_type(Seed)");
 
@@ -83,17 +96,19 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, SourceOp
         ~reduce_initial_type()
         {
         }
-        reduce_initial_type(source_type o, accumulator_type a, result_selector_type rs, seed_type s)
+        reduce_initial_type(source_type o, accumulator_type a, result_selector_type rs, seed_type s, checkpoint<seed_type> cp)
             : source(std::move(o))
             , accumulator(std::move(a))
             , result_selector(std::move(rs))
             , seed(std::move(s))
+            , saved(std::move(cp))
         {
         }
         source_type source;
         accumulator_type accumulator;
         result_selector_type result_selector;
         seed_type seed;
+        checkpoint<seed_type> saved;
 
     private:
         reduce_initial_type& operator=(reduce_initial_type o) RXCPP_DELETE;
@@ -103,8 +118,8 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, SourceOp
     ~reduce()
     {
     }
-    reduce(source_type o, accumulator_type a, result_selector_type rs, seed_type s)
-        : initial(std::move(o), std::move(a), std::move(rs), std::move(s))
+    reduce(source_type o, accumulator_type a, result_selector_type rs, seed_type s, checkpoint<seed_type> cp = checkpoint<seed_type>::empty())
+        : initial(std::move(o), std::move(a), std::move(rs), std::move(s), std::move(cp))
     {
     }
     template<class Subscriber>
@@ -116,7 +131,7 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, SourceOp
             reduce_state_type(reduce_initial_type i, Subscriber scrbr)
                 : reduce_initial_type(i)
                 , source(i.source)
-                , current(reduce_initial_type::seed)
+                , current(reduce_initial_type::saved.restore_or(reduce_initial_type::seed))
                 , out(std::move(scrbr))
             {
             }
@@ -130,22 +145,36 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, SourceOp
         auto state = std::make_shared<reduce_state_type>(initial, std::move(o));
         state->source.subscribe(
             state->out,
-        // on_next
-            [state](T t) {
-                auto next = state->accumulator(state->current, t);
-                state->current = next;
-            },
-        // on_error
-            [state](std::exception_ptr e) {
-                state->out.on_error(e);
-            },
-        // on_completed
-            [state]() {
-                auto result = state->result_selector(state->current);
-                state->out.on_next(result);
-                state->out.on_completed();
-            }
-        );
+            make_observer_with_range(make_observer<T>(
+            // on_next
+                [state](T t) {
+                    detail::accumulate(state->accumulator, state->current, std::move(t));
+                    if (state->saved.take_request()) {
+                        state->saved.save(state->current);
+                    }
+                },
+            // on_error
+                [state](std::exception_ptr e) {
+                    state->out.on_error(e);
+                },
+            // on_completed
+                [state]() {
+                    auto result = on_exception(
+                        [&](){return state->result_selector(state->current);},
+                        state->out);
+                    if (result.empty()) {
+                        return;
+                    }
+                    state->out.on_next(result.get());
+                    state->out.on_completed();
+                }),
+            // on_next_range
+                [state](const T* first, size_t count) {
+                    reduce_range<accumulator_type, seed_type, T>::apply(state->accumulator, state->current, first, count);
+                    if (state->saved.take_request()) {
+                        state->saved.save(state->current);
+                    }
+                }));
     }
 private:
     reduce& operator=(reduce o) RXCPP_DELETE;
@@ -234,6 +263,424 @@ struct average {
     }
 };
 
+
+template<class T>
+struct min {
+    typedef rxu::maybe<T> seed_type;
+    seed_type seed() {
+        return seed_type{};
+    }
+    seed_type operator()(seed_type a, T v) {
+        if (a.empty() || v < *a) {
+            a.reset(std::move(v));
+        }
+        return a;
+    }
+    T operator()(seed_type a) {
+        if (a.empty()) {
+            throw std::runtime_error("min() requires a source with at least one item");
+        }
+        return *a;
+    }
+};
+
+template<class T>
+struct max {
+    typedef rxu::maybe<T> seed_type;
+    seed_type seed() {
+        return seed_type{};
+    }
+    seed_type operator()(seed_type a, T v) {
+        if (a.empty() || *a < v) {
+            a.reset(std::move(v));
+        }
+        return a;
+    }
+    T operator()(seed_type a) {
+        if (a.empty()) {
+            throw std::runtime_error("max() requires a source with at least one item");
+        }
+        return *a;
+    }
+};
+
+// folds a batch of arithmetic values in independent lanes, and then folds the
+// lanes. the lanes do not depend on each other, so the compiler can keep them
+// in vector registers (SSE, AVX or NEON) without any intrinsics. floating
+// point sums are added in a different order than one at a time.
+template<class T, class Op>
+T fold_lanes(const T* first, size_t count, Op op) {
+    enum { lanes = 8 };
+    if (count < 2 * lanes) {
+        T result = first[0];
+        for (size_t i = 1; i != count; ++i) {
+            result = op(result, first[i]);
+        }
+        return result;
+    }
+    T lane[lanes];
+    for (size_t j = 0; j != lanes; ++j) {
+        lane[j] = first[j];
+    }
+    size_t i = lanes;
+    for (; i + lanes <= count; i += lanes) {
+        for (size_t j = 0; j != lanes; ++j) {
+            lane[j] = op(lane[j], first[i + j]);
+        }
+    }
+    T result = lane[0];
+    for (size_t j = 1; j != lanes; ++j) {
+        result = op(result, lane[j]);
+    }
+    for (; i != count; ++i) {
+        result = op(result, first[i]);
+    }
+    return result;
+}
+
+template<class T>
+struct is_lane_value : public std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+{
+};
+
+struct lane_plus
+{
+    template<class T>
+    T operator()(T a, T b) const {
+        return a + b;
+    }
+};
+struct lane_min
+{
+    template<class T>
+    T operator()(T a, T b) const {
+        return b < a ? b : a;
+    }
+};
+struct lane_max
+{
+    template<class T>
+    T operator()(T a, T b) const {
+        return a < b ? b : a;
+    }
+};
+
+// sum
+template<class T>
+struct reduce_range<rxu::plus, T, T, typename std::enable_if<is_lane_value<T>::value>::type>
+{
+    static void apply(rxu::plus&, T& current, const T* first, size_t count) {
+        if (count != 0) {
+            current = current + fold_lanes(first, count, lane_plus());
+        }
+    }
+};
+
+template<class T>
+struct reduce_range<min<T>, typename min<T>::seed_type, T, typename std::enable_if<is_lane_value<T>::value>::type>
+{
+    static void apply(min<T>& accumulator, typename min<T>::seed_type& current, const T* first, size_t count) {
+        if (count != 0) {
+            current = accumulator(current, fold_lanes(first, count, lane_min()));
+        }
+    }
+};
+
+template<class T>
+struct reduce_range<max<T>, typename max<T>::seed_type, T, typename std::enable_if<is_lane_value<T>::value>::type>
+{
+    static void apply(max<T>& accumulator, typename max<T>::seed_type& current, const T* first, size_t count) {
+        if (count != 0) {
+            current = accumulator(current, fold_lanes(first, count, lane_max()));
+        }
+    }
+};
+
+// the floating point averages, the integral averages check each value for
+// overflow
+template<class T>
+struct reduce_range<average<T>, typename average<T>::seed_type, T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static void apply(average<T>& accumulator, typename average<T>::seed_type& current, const T* first, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (static_cast<size_t>(std::numeric_limits<int>::max() - current.count) <= count) {
+            // the count would overflow, let the accumulator restart it
+            for (auto last = first + count; first != last; ++first) {
+                current = accumulator(current, *first);
+            }
+            return;
+        }
+        current.value += fold_lanes(first, count, lane_plus());
+        current.count += static_cast<int>(count);
+    }
+};
+
+// a source that can be read by index, so that each worker can fold its own
+// part of it without subscribing. other sources are reduced in sequence.
+template<class SourceOperator, class Enable = void>
+struct parallel_reduce_partition
+{
+    static const bool value = false;
+};
+
+// the integral ranges that count towards last. the values are narrower than
+// long long so that the distance between them cannot overflow.
+template<class T, class Coordination>
+struct parallel_reduce_partition<rxs::detail::range<T, Coordination>, typename std::enable_if<std::is_integral<T>::value && (sizeof(T) < sizeof(long long))>::type>
+{
+    static const bool value = true;
+    typedef rxs::detail::range<T, Coordination> source_type;
+
+    // the number of whole steps from the first value
+    static long long steps(const source_type& s) {
+        return (static_cast<long long>(s.initial.last) - static_cast<long long>(s.initial.next)) / s.initial.step;
+    }
+    static bool size(const source_type& s, size_t& count) {
+        if (s.initial.empty) {
+            // a slice past the end, next and last no longer bound it
+            count = 0;
+            return true;
+        }
+        auto span = static_cast<long long>(s.initial.last) - static_cast<long long>(s.initial.next);
+        if (!s.initial.pull.is_unbounded() || s.initial.step == 0 || (span != 0 && (span > 0) != (s.initial.step > 0))) {
+            return false;
+        }
+        auto k = steps(s);
+        // range sends last even when it is not a whole step from first
+        auto whole = static_cast<long long>(s.initial.next) + k * s.initial.step == static_cast<long long>(s.initial.last);
+        count = static_cast<size_t>(k + (whole ? 1 : 2));
+        return true;
+    }
+    template<class F>
+    static void for_each(const source_type& s, size_t first, size_t last, F& f) {
+        auto k = static_cast<size_t>(steps(s));
+        for (auto i = first; i != last; ++i) {
+            f(i <= k ? static_cast<T>(s.initial.next + static_cast<long long>(i) * s.initial.step) : s.initial.last);
+        }
+    }
+};
+
+// the collections with random access iterators
+template<class Collection, class Coordination>
+struct parallel_reduce_partition<rxs::detail::iterate<Collection, Coordination>, typename std::enable_if<std::is_base_of<std::random_access_iterator_tag,
+    typename std::iterator_traits<typename rxs::detail::iterate_traits<Collection>::iterator_type>::iterator_category>::value>::type>
+{
+    static const bool value = true;
+    typedef rxs::detail::iterate<Collection, Coordination> source_type;
+
+    // the index in the collection of the first value of the slice
+    static size_t offset(const source_type& s) {
+        auto total = static_cast<size_t>(std::distance(std::begin(s.initial.collection), std::end(s.initial.collection)));
+        return (std::min)(s.initial.skip, total);
+    }
+    static bool size(const source_type& s, size_t& count) {
+        if (!s.initial.pull.is_unbounded()) {
+            return false;
+        }
+        auto total = static_cast<size_t>(std::distance(std::begin(s.initial.collection), std::end(s.initial.collection)));
+        count = (std::min)(total - offset(s), s.initial.count);
+        return true;
+    }
+    template<class F>
+    static void for_each(const source_type& s, size_t first, size_t last, F& f) {
+        auto begin = std::begin(s.initial.collection) + static_cast<ptrdiff_t>(offset(s));
+        auto cursor = begin + static_cast<ptrdiff_t>(first);
+        for (auto end = begin + static_cast<ptrdiff_t>(last); cursor != end; ++cursor) {
+            f(*cursor);
+        }
+    }
+};
+
+template<class T, class SourceOperator, class Accumulator, class Combine, class Seed, class Coordination>
+struct parallel_reduce : public operator_base<rxu::decay_t<Seed>>
+{
+    typedef rxu::decay_t<SourceOperator> source_type;
+    typedef rxu::decay_t<Accumulator> accumulator_type;
+    typedef rxu::decay_t<Combine> combine_type;
+    typedef rxu::decay_t<Seed> seed_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef parallel_reduce_partition<source_type> partition_type;
+
+    static_assert(is_accumulate_function_for<T, seed_type, accumulator_type>::value, "parallel_reduce Accumulator must be a function with the signature Seed(Seed, parallel_reduce::source_value_type) or void(Seed&, parallel_reduce::source_value_type)");
+    static_assert(std::is_convertible<decltype((*(combine_type*)nullptr)(*(seed_type*)nullptr, *(seed_type*)nullptr)), seed_type>::value, "parallel_reduce Combine must be an associative function with the signature Seed(Seed, Seed)");
+
+    struct parallel_reduce_initial_type
+    {
+        parallel_reduce_initial_type(source_type o, accumulator_type a, combine_type c, seed_type s, coordination_type cn)
+            : source(std::move(o))
+            , accumulator(std::move(a))
+            , combine(std::move(c))
+            , seed(std::move(s))
+            , coordination(std::move(cn))
+        {
+        }
+        source_type source;
+        accumulator_type accumulator;
+        combine_type combine;
+        seed_type seed;
+        coordination_type coordination;
+    };
+    parallel_reduce_initial_type initial;
+
+    parallel_reduce(source_type o, accumulator_type a, combine_type c, seed_type s, coordination_type cn)
+        : initial(std::move(o), std::move(a), std::move(c), std::move(s), std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        size_t count = 0;
+        if (!size(initial.source, count, std::integral_constant<bool, partition_type::value>())) {
+            count = 0;
+        }
+        auto lanes = static_cast<size_t>((std::max)(std::thread::hardware_concurrency(), 2u));
+        auto parts = (std::min)(lanes, count);
+        if (parts < 2) {
+            // a single fold gains nothing from the workers
+            typedef reduce<T, SourceOperator, Accumulator, identity_for<seed_type>, Seed> reduce_type;
+            observable<seed_type, reduce_type>(reduce_type(initial.source, initial.accumulator, identity_for<seed_type>(), initial.seed)).subscribe(std::move(o));
+            return;
+        }
+        subscribe_parts(std::move(o), count, parts, std::integral_constant<bool, partition_type::value>());
+    }
+
+private:
+    typedef std::integral_constant<bool, is_accumulate_in_place<accumulator_type, seed_type, T>::value> in_place;
+
+    // the partial seed is local to the fold, so it is moved through an
+    // accumulator that returns the next seed
+    static void fold_into(accumulator_type& accumulator, seed_type& current, T v, std::true_type) {
+        accumulator(current, std::move(v));
+    }
+    static void fold_into(accumulator_type& accumulator, seed_type& current, T v, std::false_type) {
+        current = accumulator(std::move(current), std::move(v));
+    }
+
+    static bool size(const source_type& s, size_t& count, std::true_type) {
+        return partition_type::size(s, count);
+    }
+    static bool size(const source_type&, size_t&, std::false_type) {
+        return false;
+    }
+
+    template<class Subscriber>
+    void subscribe_parts(Subscriber, size_t, size_t, std::false_type) const {
+    }
+    template<class Subscriber>
+    void subscribe_parts(Subscriber o, size_t count, size_t parts, std::true_type) const {
+        struct parallel_reduce_state_type
+            : public parallel_reduce_initial_type
+        {
+            parallel_reduce_state_type(const parallel_reduce_initial_type& i, Subscriber scrbr, size_t parts)
+                : parallel_reduce_initial_type(i)
+                , partials(parts)
+                , remaining(parts)
+                , errored(false)
+                , out(std::move(scrbr))
+            {
+            }
+            void fail(std::exception_ptr e) {
+                if (!errored.exchange(true)) {
+                    out.on_error(e);
+                }
+            }
+            // the partial accumulators in the order of the parts, so that
+            // combine is only required to be associative
+            std::vector<rxu::maybe<seed_type>> partials;
+            std::atomic<size_t> remaining;
+            std::atomic<bool> errored;
+            Subscriber out;
+        };
+        auto state = std::make_shared<parallel_reduce_state_type>(initial, std::move(o), parts);
+
+        for (size_t part = 0; part != parts; ++part) {
+            auto first = count * part / parts;
+            auto last = count * (part + 1) / parts;
+
+            auto fold = [state, part, first, last](const rxsc::schedulable&){
+                if (!state->out.is_subscribed()) {
+                    return;
+                }
+                auto partial = on_exception(
+                    [&](){
+                        auto current = state->seed;
+                        auto fold_value = [&](T v){
+                            fold_into(state->accumulator, current, std::move(v), in_place());
+                        };
+                        partition_type::for_each(state->source, first, last, fold_value);
+                        return current;},
+                    [&](std::exception_ptr e){
+                        state->fail(e);
+                    });
+                if (!partial.empty()) {
+                    state->partials[part].reset(std::move(partial.get()));
+                }
+                if (--state->remaining != 0 || state->errored) {
+                    return;
+                }
+                // the last part to finish combines and sends the result
+                auto result = on_exception(
+                    [&](){
+                        auto current = std::move(state->partials[0].get());
+                        for (size_t i = 1; i != state->partials.size(); ++i) {
+                            current = state->combine(std::move(current), std::move(state->partials[i].get()));
+                        }
+                        return current;},
+                    state->out);
+                if (result.empty()) {
+                    return;
+                }
+                state->out.on_next(std::move(result.get()));
+                state->out.on_completed();
+            };
+
+            // each part gets its own coordinator, so an event loop spreads
+            // the parts over its threads
+            auto coordinator = state->coordination.create_coordinator(state->out.get_subscription());
+            auto controller = coordinator.get_worker();
+            auto selectedFold = on_exception(
+                [&](){return coordinator.act(fold);},
+                [&](std::exception_ptr e){
+                    state->fail(e);
+                });
+            if (selectedFold.empty()) {
+                return;
+            }
+            controller.schedule(selectedFold.get());
+        }
+    }
+};
+
+template<class Accumulator, class Combine, class Seed, class Coordination>
+class parallel_reduce_factory
+{
+    typedef rxu::decay_t<Accumulator> accumulator_type;
+    typedef rxu::decay_t<Combine> combine_type;
+    typedef rxu::decay_t<Seed> seed_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    accumulator_type accumulator;
+    combine_type combine;
+    seed_type seed;
+    coordination_type coordination;
+public:
+    parallel_reduce_factory(accumulator_type a, combine_type c, Seed s, coordination_type cn)
+        : accumulator(std::move(a))
+        , combine(std::move(c))
+        , seed(std::move(s))
+        , coordination(std::move(cn))
+    {
+    }
+    template<class Observable>
+    auto operator()(const Observable& source)
+        ->      observable<seed_type,   parallel_reduce<rxu::value_type_t<Observable>, typename Observable::source_operator_type, Accumulator, Combine, Seed, Coordination>> {
+        return  observable<seed_type,   parallel_reduce<rxu::value_type_t<Observable>, typename Observable::source_operator_type, Accumulator, Combine, Seed, Coordination>>(
+                                        parallel_reduce<rxu::value_type_t<Observable>, typename Observable::source_operator_type, Accumulator, Combine, Seed, Coordination>(source.source_operator, accumulator, combine, seed, coordination));
+    }
+};
+
 }
 
 template<class Seed, class Accumulator, class ResultSelector>
@@ -242,6 +689,15 @@ auto reduce(Seed s, Accumulator a, ResultSelector rs)
     return  detail::reduce_factory<Accumulator, ResultSelector, Seed>(std::move(a), std::move(rs), std::move(s));
 }
 
+/// reduce the parts of a range or of a random access collection on separate
+/// workers of the coordination and then combine the partial results in order.
+/// Combine must be associative. other sources are reduced in sequence.
+template<class Seed, class Accumulator, class Combine, class Coordination>
+auto parallel_reduce(Seed s, Accumulator a, Combine c, Coordination cn)
+    ->      detail::parallel_reduce_factory<Accumulator, Combine, Seed, Coordination> {
+    return  detail::parallel_reduce_factory<Accumulator, Combine, Seed, Coordination>(std::move(a), std::move(c), std::move(s), std::move(cn));
+}
+
 
 }
 
@@ -13,48 +13,112 @@ namespace operators {
 
 namespace detail {
 
-template<class T, class ConnectableObservable>
+template<class T, class ConnectableObservable, class Coordination = identity_one_worker>
 struct ref_count : public operator_base<T>
 {
     typedef rxu::decay_t<ConnectableObservable> source_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type::duration duration_type;
 
     struct ref_count_state : public std::enable_shared_from_this<ref_count_state>
     {
-        explicit ref_count_state(source_type o)
+        ref_count_state(source_type o, rxu::maybe<duration_type> g, coordination_type cn)
             : source(std::move(o))
+            , grace(std::move(g))
+            , coordination(std::move(cn))
             , subscribers(0)
+            , connected(false)
+            , releases(0)
         {
         }
 
         source_type source;
+        // when set, the connection is kept for this long after the last
+        // subscriber has gone, so that a new subscriber can reuse it
+        rxu::maybe<duration_type> grace;
+        coordination_type coordination;
+        // the count does not take the lock. only the first subscribe and the
+        // last unsubscribe take it, to connect and to disconnect.
+        std::atomic<long> subscribers;
         std::mutex lock;
-        long subscribers;
+        bool connected;
+        // the times that the count went to 0. a disconnect is dropped when
+        // the count has gone to 0 again since it was asked for.
+        long releases;
         composite_subscription connection;
+
+        void connect() {
+            composite_subscription cs;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (connected || subscribers == 0) {
+                    return;
+                }
+                connected = true;
+                cs = connection;
+            }
+            source.connect(cs);
+        }
+
+        void disconnect(long release) {
+            composite_subscription expired;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (!connected || subscribers != 0 || releases != release) {
+                    return;
+                }
+                connected = false;
+                expired = connection;
+                connection = composite_subscription();
+            }
+            expired.unsubscribe();
+        }
+
+        void release() {
+            if (--subscribers != 0) {
+                return;
+            }
+            long release = 0;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                release = ++releases;
+            }
+            if (grace.empty()) {
+                disconnect(release);
+                return;
+            }
+            auto keepAlive = this->shared_from_this();
+            auto coordinator = coordination.create_coordinator();
+            auto controller = coordinator.get_worker();
+            controller.schedule(controller.now() + grace.get(), coordinator.act(
+                [keepAlive, release, controller](const rxsc::schedulable&){
+                    keepAlive->disconnect(release);
+                    controller.unsubscribe();
+                }));
+        }
     };
     std::shared_ptr<ref_count_state> state;
 
     explicit ref_count(source_type o)
-        : state(std::make_shared<ref_count_state>(std::move(o)))
+        : state(std::make_shared<ref_count_state>(std::move(o), rxu::maybe<duration_type>(), identity_current_thread()))
+    {
+    }
+    ref_count(source_type o, duration_type grace, coordination_type cn)
+        : state(std::make_shared<ref_count_state>(std::move(o), rxu::maybe<duration_type>(grace), std::move(cn)))
     {
     }
 
     template<class Subscriber>
     void on_subscribe(Subscriber&& o) const {
-        std::unique_lock<std::mutex> guard(state->lock);
         auto needConnect = ++state->subscribers == 1;
         auto keepAlive = state;
-        guard.unlock();
         o.add(
             [keepAlive](){
-                std::unique_lock<std::mutex> guard_unsubscribe(keepAlive->lock);
-                if (--keepAlive->subscribers == 0) {
-                    keepAlive->connection.unsubscribe();
-                    keepAlive->connection = composite_subscription();
-                }
+                keepAlive->release();
             });
         keepAlive->source.subscribe(std::forward<Subscriber>(o));
         if (needConnect) {
-            keepAlive->source.connect(keepAlive->connection);
+            keepAlive->connect();
         }
     }
 };
@@ -71,6 +135,27 @@ public:
     }
 };
 
+template<class Coordination>
+class ref_count_grace_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    rxsc::scheduler::clock_type::duration grace;
+    coordination_type coordination;
+public:
+    ref_count_grace_factory(rxsc::scheduler::clock_type::duration g, coordination_type cn)
+        : grace(g)
+        , coordination(std::move(cn))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>,   ref_count<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>> {
+        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>,   ref_count<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>>(
+                                                                          ref_count<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>(std::forward<Observable>(source), grace, coordination));
+    }
+};
+
 }
 
 inline auto ref_count()
@@ -78,6 +163,12 @@ inline auto ref_count()
     return  detail::ref_count_factory();
 }
 
+template<class Coordination>
+auto ref_count(rxsc::scheduler::clock_type::duration grace, Coordination cn)
+    ->      detail::ref_count_grace_factory<Coordination> {
+    return  detail::ref_count_grace_factory<Coordination>(grace, std::move(cn));
+}
+
 }
 
 }
@@ -52,20 +52,24 @@ struct repeat : public operator_base<T>
             {
             }
             composite_subscription source_lifetime;
+            composite_subscription::weak_subscription source_token;
             output_type out;
 
             void do_subscribe() {
                 auto state = this->shared_from_this();
 
+                // the lifetime of the finished iteration is dropped from out, so
+                // that a long running loop does not collect one for each iteration
+                state->out.remove(state->source_token);
                 state->source_lifetime = composite_subscription();
-                state->out.add(state->source_lifetime);
+                state->source_token = state->out.add(state->source_lifetime);
 
                 state->source.subscribe(
                     state->out,
                     state->source_lifetime,
                 // on_next
                     [state](T t) {
-                        state->out.on_next(t);
+                        state->out.on_next(std::move(t));
                     },
                 // on_error
                     [state](std::exception_ptr e) {
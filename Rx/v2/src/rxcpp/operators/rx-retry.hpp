@@ -11,6 +11,40 @@ namespace rxcpp {
 
     namespace operators {
 
+        /// the delay before each retry. the delay starts at initial and doubles
+        /// with each attempt up to maximum. a jitter of j takes a random part of
+        /// up to j of each delay away, so that the retries of many subscribers
+        /// that failed together are spread out.
+        class exponential_backoff {
+        public:
+            typedef rxsc::scheduler::clock_type::duration duration_type;
+
+            exponential_backoff(duration_type initial, duration_type maximum, double jitter = 0.5)
+                : initial(initial)
+                , maximum(std::max(initial, maximum))
+                , jitter(std::min(std::max(jitter, 0.0), 1.0)) {
+            }
+
+            template<class UniformRandomGenerator>
+            duration_type delay(int attempt, UniformRandomGenerator& random) const {
+                auto result = initial;
+                for (; attempt > 0 && result < maximum; --attempt) {
+                    result *= 2;
+                }
+                result = std::min(result, maximum);
+                if (jitter > 0) {
+                    std::uniform_real_distribution<double> part(1.0 - jitter, 1.0);
+                    result = std::chrono::duration_cast<duration_type>(result * part(random));
+                }
+                return result;
+            }
+
+        private:
+            duration_type initial;
+            duration_type maximum;
+            double jitter;
+        };
+
         namespace detail {
 
             template<class T, class Observable, class Count>
@@ -46,20 +80,24 @@ namespace rxcpp {
                         , out(oarg) {
                         }
                         composite_subscription source_lifetime;
+                        composite_subscription::weak_subscription source_token;
                         output_type out;
 
                         void do_subscribe() {
                             auto state = this->shared_from_this();
 
+                            // the lifetime of the finished iteration is dropped from out, so
+                            // that a long running loop does not collect one for each iteration
+                            state->out.remove(state->source_token);
                             state->source_lifetime = composite_subscription();
-                            state->out.add(state->source_lifetime);
+                            state->source_token = state->out.add(state->source_lifetime);
 
                             state->source.subscribe(
                                 state->out,
                                 state->source_lifetime,
                                 // on_next
                                 [state](T t) {
-                                state->out.on_next(t);
+                                state->out.on_next(std::move(t));
                             },
                                 // on_error
                                 [state](std::exception_ptr e) {
@@ -88,6 +126,107 @@ namespace rxcpp {
                 }
             };
 
+            template<class T, class Observable, class Count, class Coordination>
+            struct retry_backoff : public operator_base<T> {
+                typedef rxu::decay_t<Observable> source_type;
+                typedef rxu::decay_t<Count> count_type;
+                typedef rxu::decay_t<Coordination> coordination_type;
+                typedef typename coordination_type::coordinator_type coordinator_type;
+                struct values {
+                    values(source_type s, count_type t, exponential_backoff b, coordination_type cn)
+                    : source(std::move(s))
+                    , remaining(std::move(t))
+                    , retry_infinitely(t == 0)
+                    , backoff(std::move(b))
+                    , coordination(std::move(cn)) {
+                    }
+                    source_type source;
+                    count_type remaining;
+                    bool retry_infinitely;
+                    exponential_backoff backoff;
+                    coordination_type coordination;
+                };
+                values initial;
+
+                retry_backoff(source_type s, count_type t, exponential_backoff b, coordination_type cn)
+                    : initial(std::move(s), std::move(t), std::move(b), std::move(cn)) {
+                }
+
+                template<class Subscriber>
+                void on_subscribe(const Subscriber& s) const {
+
+                    typedef Subscriber output_type;
+                    struct state_type
+                        : public std::enable_shared_from_this<state_type>
+                        , public values {
+                        state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                        : values(i)
+                        , source_lifetime(composite_subscription::empty())
+                        , attempt(0)
+                        , random(std::random_device()())
+                        , coordinator(std::move(coor))
+                        , out(oarg) {
+                        }
+                        composite_subscription source_lifetime;
+                        composite_subscription::weak_subscription source_token;
+                        int attempt;
+                        std::minstd_rand random;
+                        coordinator_type coordinator;
+                        output_type out;
+
+                        void do_subscribe() {
+                            auto state = this->shared_from_this();
+
+                            // the lifetime of the finished iteration is dropped from out, so
+                            // that a long running loop does not collect one for each iteration
+                            state->out.remove(state->source_token);
+                            state->source_lifetime = composite_subscription();
+                            state->source_token = state->out.add(state->source_lifetime);
+
+                            state->source.subscribe(
+                                state->out,
+                                state->source_lifetime,
+                                // on_next
+                                [state](T t) {
+                                state->out.on_next(std::move(t));
+                            },
+                                // on_error
+                                [state](std::exception_ptr e) {
+                                if (state->retry_infinitely || (--state->remaining >= 0)) {
+                                    state->schedule_subscribe();
+                                } else {
+                                    state->out.on_error(e);
+                                }
+                            },
+                                // on_completed
+                                [state]() {
+                                    state->out.on_completed();
+                            }
+                            );
+                        }
+
+                        // the resubscribe waits on the worker, no thread is
+                        // blocked while the delay runs out
+                        void schedule_subscribe() {
+                            auto state = this->shared_from_this();
+                            auto delay = state->backoff.delay(state->attempt++, state->random);
+                            auto controller = state->coordinator.get_worker();
+                            controller.schedule(controller.now() + delay, [state](const rxsc::schedulable&) {
+                                state->do_subscribe();
+                            });
+                        }
+                    };
+
+                    auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+                    // take a copy of the values for each subscription
+                    auto state = std::make_shared<state_type>(initial, std::move(coordinator), s);
+
+                    // start the first iteration
+                    state->do_subscribe();
+                }
+            };
+
             template<class T>
             class retry_factory {
                 typedef rxu::decay_t<T> count_type;
@@ -103,6 +242,27 @@ namespace rxcpp {
                 }
             };
 
+
+            template<class T, class Coordination>
+            class retry_backoff_factory {
+                typedef rxu::decay_t<T> count_type;
+                typedef rxu::decay_t<Coordination> coordination_type;
+                count_type count;
+                exponential_backoff backoff;
+                coordination_type coordination;
+            public:
+                retry_backoff_factory(count_type t, exponential_backoff b, coordination_type cn)
+                    : count(std::move(t))
+                    , backoff(std::move(b))
+                    , coordination(std::move(cn)) {}
+
+                template<class Observable>
+                auto operator()(Observable&& source)
+                    ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, retry_backoff<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type, coordination_type>> {
+                    return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, retry_backoff<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type, coordination_type>>(
+                        retry_backoff<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type, coordination_type>(std::forward<Observable>(source), count, backoff, coordination));
+                }
+            };
         }
 
         template<class T>
@@ -111,6 +271,12 @@ namespace rxcpp {
             return  detail::retry_factory<T>(std::forward<T>(t));
         }
 
+        template<class T, class Coordination>
+        auto retry(T&& t, exponential_backoff b, Coordination&& cn)
+            ->      detail::retry_backoff_factory<T, Coordination> {
+            return  detail::retry_backoff_factory<T, Coordination>(std::forward<T>(t), std::move(b), std::forward<Coordination>(cn));
+        }
+
     }
 
 }
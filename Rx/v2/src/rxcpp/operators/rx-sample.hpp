@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_SAMPLE_HPP)
+#define RXCPP_OPERATORS_RX_SAMPLE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// emits the most recent item, if any arrived, at the end of each period.
+// one periodic action for each subscription drives the output.
+template<class T, class Duration, class Coordination>
+struct sample
+{
+    static_assert(std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>::value, "Duration parameter must convert to rxsc::scheduler::clock_type::duration");
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct sample_values
+    {
+        sample_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+        duration_type period;
+        coordination_type coordination;
+    };
+    sample_values initial;
+
+    sample(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct sample_observer
+    {
+        typedef sample_observer<Subscriber> this_type;
+        typedef rxu::decay_t<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct sample_subscriber_values : public sample_values
+        {
+            sample_subscriber_values(dest_type d, sample_values v, coordinator_type c)
+                : sample_values(v)
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(std::move(coordinator.get_worker()))
+                , emitting(false)
+                , ending(ending_none)
+            {
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            std::mutex lock;
+            rxu::maybe<value_type> value;
+            // dest is called without the lock. while a sample is sent the
+            // end is left for it to send after the value.
+            bool emitting;
+            enum ending_type { ending_none, ending_completed, ending_error };
+            ending_type ending;
+            std::exception_ptr error;
+        };
+        std::shared_ptr<sample_subscriber_values> state;
+
+        sample_observer(dest_type d, sample_values v, coordinator_type c)
+            : state(std::make_shared<sample_subscriber_values>(std::move(d), v, std::move(c)))
+        {
+            auto localState = state;
+            auto produce_sample = [localState](const rxsc::schedulable&) {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                if (localState->value.empty() || localState->emitting) {
+                    return;
+                }
+                auto v = std::move(localState->value.get());
+                localState->value.reset();
+                localState->emitting = true;
+                guard.unlock();
+                localState->dest.on_next(std::move(v));
+                guard.lock();
+                localState->emitting = false;
+                if (localState->ending != sample_subscriber_values::ending_none) {
+                    send_end(localState, guard);
+                }
+            };
+
+            state->worker.schedule_periodically(
+                state->worker.now() + state->period,
+                state->period,
+                produce_sample);
+        }
+        // sends the end, called with the lock held
+        static void send_end(const std::shared_ptr<sample_subscriber_values>& state, std::unique_lock<std::mutex>& guard) {
+            auto ending = state->ending;
+            auto e = state->error;
+            // nothing is sent after the end
+            state->emitting = true;
+            guard.unlock();
+            if (ending == sample_subscriber_values::ending_error) {
+                state->dest.on_error(e);
+                return;
+            }
+            state->dest.on_completed();
+        }
+        void on_next(T v) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->value.reset(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->ending = sample_subscriber_values::ending_error;
+            state->error = e;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->ending = sample_subscriber_values::ending_completed;
+            if (!state->emitting) {
+                send_end(state, guard);
+            }
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, sample_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(sample_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      sample_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Duration, class Coordination>
+class sample_factory
+{
+    typedef rxu::decay_t<Duration> duration_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    duration_type period;
+    coordination_type coordination;
+public:
+    sample_factory(duration_type p, coordination_type c) : period(p), coordination(c) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(sample<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(sample<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination));
+    }
+};
+
+}
+
+template<class Duration, class Coordination>
+inline auto sample(Duration period, Coordination coordination)
+    ->      detail::sample_factory<Duration, Coordination> {
+    return  detail::sample_factory<Duration, Coordination>(period, coordination);
+}
+
+}
+
+}
+
+#endif
@@ -22,60 +22,94 @@ struct scan : public operator_base<rxu::decay_t<Seed>>
 
     struct scan_initial_type
     {
-        scan_initial_type(source_type o, accumulator_type a, seed_type s)
+        scan_initial_type(source_type o, accumulator_type a, seed_type s, checkpoint<seed_type> cp)
             : source(std::move(o))
             , accumulator(std::move(a))
             , seed(s)
+            , saved(std::move(cp))
         {
         }
         source_type source;
         accumulator_type accumulator;
         seed_type seed;
+        checkpoint<seed_type> saved;
     };
     scan_initial_type initial;
 
+    struct tag_not_valid {};
     template<class CT, class CS, class CP>
     static auto check(int) -> decltype((*(CP*)nullptr)(*(CS*)nullptr, *(CT*)nullptr));
     template<class CT, class CS, class CP>
-    static void check(...);
+    static tag_not_valid check(...);
 
-    scan(source_type o, accumulator_type a, seed_type s)
-        : initial(std::move(o), a, s)
+    typedef decltype(check<T, seed_type, accumulator_type>(0)) accumulate_result_type;
+
+    scan(source_type o, accumulator_type a, seed_type s, checkpoint<seed_type> cp = checkpoint<seed_type>::empty())
+        : initial(std::move(o), a, s, std::move(cp))
     {
-        static_assert(std::is_convertible<decltype(check<T, seed_type, accumulator_type>(0)), seed_type>::value, "scan Accumulator must be a function with the signature Seed(Seed, T)");
+        static_assert(std::is_convertible<accumulate_result_type, seed_type>::value || std::is_same<accumulate_result_type, void>::value, "scan Accumulator must be a function with the signature Seed(Seed, T) or void(Seed&, T)");
     }
     template<class Subscriber>
-    void on_subscribe(Subscriber o) const {
-        struct scan_state_type
-            : public scan_initial_type
-            , public std::enable_shared_from_this<scan_state_type>
+    struct scan_observer
+    {
+        typedef scan_observer<Subscriber> this_type;
+        typedef observer<T, this_type> observer_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        dest_type out;
+        accumulator_type accumulator;
+        checkpoint<seed_type> saved;
+        mutable seed_type result;
+
+        scan_observer(dest_type d, accumulator_type a, checkpoint<seed_type> cp, seed_type s)
+            : out(std::move(d))
+            , accumulator(std::move(a))
+            , saved(std::move(cp))
+            , result(std::move(s))
         {
-            scan_state_type(scan_initial_type i, Subscriber scrbr)
-                : scan_initial_type(i)
-                , result(scan_initial_type::seed)
-                , out(std::move(scrbr))
-            {
+        }
+        void on_next(T t) const {
+            detail::accumulate(accumulator, result, std::move(t));
+            if (saved.take_request()) {
+                saved.save(result);
+            }
+            out.on_next(result);
+        }
+        void on_next_range(const T* first, size_t count) const {
+            rxu::detail::batch_buffer<seed_type> results(count);
+            for (auto last = first + count; first != last; ++first) {
+                try {
+                    detail::accumulate(accumulator, result, *first);
+                } catch(...) {
+                    out.on_next_range(results.data(), results.size());
+                    throw;
+                }
+                results.push_back(result);
             }
-            seed_type result;
-            Subscriber out;
-        };
-        auto state = std::make_shared<scan_state_type>(initial, std::move(o));
-        state->source.subscribe(
-            state->out,
-        // on_next
-            [state](T t) {
-                state->result = state->accumulator(state->result, t);
-                state->out.on_next(state->result);
-            },
-        // on_error
-            [state](std::exception_ptr e) {
-                state->out.on_error(e);
-            },
-        // on_completed
-            [state]() {
-                state->out.on_completed();
+            if (saved.take_request()) {
+                saved.save(result);
             }
-        );
+            out.on_next_range(results.data(), results.size());
+        }
+        void on_error(std::exception_ptr e) const {
+            out.on_error(e);
+        }
+        void on_completed() const {
+            out.on_completed();
+        }
+    };
+
+    // the accumulated result is kept in the subscriber passed to the source,
+    // so subscribing allocates no state of its own.
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        typedef scan_observer<Subscriber> observer_type;
+        // o owns the subscription and lives as long as the subscriber
+        auto cs = o.get_subscription().borrow();
+        initial.source.subscribe(
+            subscriber<T, typename observer_type::observer_type>(
+                trace_id::make_next_id_subscriber(),
+                std::move(cs),
+                typename observer_type::observer_type(observer_type(std::move(o), initial.accumulator, initial.saved, initial.saved.restore_or(initial.seed)))));
     }
 };
 
@@ -0,0 +1,367 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_SKETCH_HPP)
+#define RXCPP_OPERATORS_RX_SKETCH_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+// summaries of a stream in a fixed amount of memory. each one is a Seed for
+// reduce and parallel_reduce: sketch_add adds a value to a sketch, and
+// sketch_merge combines the sketches of two parts of a stream into the sketch
+// of both.
+
+namespace detail {
+
+// std::hash is the identity for integers in some libraries, so the bits are
+// mixed before they are used (the finalizer of splitmix64)
+inline unsigned long long mix_hash(unsigned long long h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+}
+
+/// counts the distinct values of a stream with HyperLogLog. it holds 2^precision
+/// registers of a byte each, and the standard error is about 1.04 / sqrt(2^precision).
+template<class T, class Hash = std::hash<T>>
+class hyperloglog
+{
+    int precision;
+    std::vector<unsigned char> registers;
+    Hash hash;
+
+public:
+    explicit hyperloglog(int p = 12, Hash h = Hash())
+        : precision((std::min)((std::max)(p, 4), 18))
+        , registers(size_t(1) << precision, 0)
+        , hash(std::move(h))
+    {
+    }
+
+    void add(const T& v) {
+        auto h = detail::mix_hash(static_cast<unsigned long long>(hash(v)));
+        auto index = h >> (64 - precision);
+        // the remaining bits, with a stop bit in case they are all zero
+        auto rest = (h << precision) | (1ULL << (precision - 1));
+        unsigned char rank = 1;
+        while ((rest & (1ULL << 63)) == 0) {
+            rest <<= 1;
+            ++rank;
+        }
+        if (registers[index] < rank) {
+            registers[index] = rank;
+        }
+    }
+
+    void merge(const hyperloglog& o) {
+        if (o.precision != precision) {
+            throw std::invalid_argument("hyperloglog::merge() requires sketches with the same precision");
+        }
+        for (size_t i = 0; i != registers.size(); ++i) {
+            registers[i] = (std::max)(registers[i], o.registers[i]);
+        }
+    }
+
+    double estimate() const {
+        double m = double(registers.size());
+        double sum = 0;
+        size_t zeros = 0;
+        for (auto r : registers) {
+            sum += std::ldexp(1.0, -int(r));
+            zeros += r == 0;
+        }
+        double alpha = 0.7213 / (1 + 1.079 / m);
+        double e = alpha * m * m / sum;
+        if (e <= 2.5 * m && zeros != 0) {
+            // linear counting is closer for small counts
+            e = m * std::log(m / double(zeros));
+        }
+        return e;
+    }
+};
+
+/// estimates how often each value occurs with a count-min sketch of depth rows
+/// of width counters. an estimate is never less than the true count.
+template<class T, class Hash = std::hash<T>>
+class count_min
+{
+    size_t width;
+    size_t depth;
+    std::vector<unsigned long long> counters;
+    Hash hash;
+
+    template<class F>
+    void for_each_counter(const T& v, F f) const {
+        auto h = detail::mix_hash(static_cast<unsigned long long>(hash(v)));
+        auto h1 = h & 0xffffffffULL;
+        auto h2 = (h >> 32) | 1;
+        for (size_t row = 0; row != depth; ++row) {
+            f(row * width + size_t((h1 + row * h2) % width));
+        }
+    }
+
+public:
+    explicit count_min(size_t w = 2048, size_t d = 4, Hash h = Hash())
+        : width((std::max)(w, size_t(1)))
+        , depth((std::max)(d, size_t(1)))
+        , counters(width * depth, 0)
+        , hash(std::move(h))
+    {
+    }
+
+    void add(const T& v, unsigned long long count = 1) {
+        for_each_counter(v, [&](size_t i){counters[i] += count;});
+    }
+
+    void merge(const count_min& o) {
+        if (o.width != width || o.depth != depth) {
+            throw std::invalid_argument("count_min::merge() requires sketches with the same width and depth");
+        }
+        for (size_t i = 0; i != counters.size(); ++i) {
+            counters[i] += o.counters[i];
+        }
+    }
+
+    unsigned long long estimate(const T& v) const {
+        auto result = (std::numeric_limits<unsigned long long>::max)();
+        for_each_counter(v, [&](size_t i){result = (std::min)(result, counters[i]);});
+        return result;
+    }
+};
+
+/// keeps the k values with the largest estimates in a count-min sketch.
+template<class T, class Hash = std::hash<T>>
+class top_k
+{
+    typedef std::unordered_map<T, unsigned long long, Hash> candidates_type;
+
+    size_t k;
+    count_min<T, Hash> counts;
+    // at most k values and their estimates
+    candidates_type candidates;
+    // the candidate with the least estimate, when known
+    rxu::detail::maybe<typename candidates_type::iterator> least;
+
+    typename candidates_type::iterator find_least() {
+        if (least.empty()) {
+            least.reset(std::min_element(candidates.begin(), candidates.end(),
+                [](const typename candidates_type::value_type& a, const typename candidates_type::value_type& b){
+                    return a.second < b.second;
+                }));
+        }
+        return *least;
+    }
+
+    void offer(const T& v, unsigned long long estimate) {
+        auto found = candidates.find(v);
+        if (found != candidates.end()) {
+            found->second = estimate;
+            if (!least.empty() && *least == found) {
+                least.reset();
+            }
+            return;
+        }
+        if (candidates.size() < k) {
+            candidates.emplace(v, estimate);
+            least.reset();
+            return;
+        }
+        auto l = find_least();
+        if (l->second < estimate) {
+            candidates.erase(l);
+            candidates.emplace(v, estimate);
+            least.reset();
+        }
+    }
+
+public:
+    explicit top_k(size_t count = 10, size_t width = 2048, size_t depth = 4, Hash h = Hash())
+        : k((std::max)(count, size_t(1)))
+        , counts(width, depth, h)
+        , candidates(k + 1, h)
+    {
+    }
+
+    top_k(const top_k& o)
+        : k(o.k)
+        , counts(o.counts)
+        , candidates(o.candidates)
+    {
+    }
+
+    top_k& operator=(top_k o) {
+        k = o.k;
+        counts = std::move(o.counts);
+        candidates = std::move(o.candidates);
+        least.reset();
+        return *this;
+    }
+
+    void add(const T& v) {
+        counts.add(v);
+        offer(v, counts.estimate(v));
+    }
+
+    void merge(const top_k& o) {
+        counts.merge(o.counts);
+        for (auto& c : candidates) {
+            c.second = counts.estimate(c.first);
+        }
+        least.reset();
+        for (auto& c : o.candidates) {
+            offer(c.first, counts.estimate(c.first));
+        }
+    }
+
+    /// the candidates and their estimates, the most frequent first
+    std::vector<std::pair<T, unsigned long long>> values() const {
+        std::vector<std::pair<T, unsigned long long>> result(candidates.begin(), candidates.end());
+        std::sort(result.begin(), result.end(),
+            [](const std::pair<T, unsigned long long>& a, const std::pair<T, unsigned long long>& b){
+                return a.second > b.second;
+            });
+        return result;
+    }
+};
+
+/// estimates the quantiles of a stream of numbers with a merging t-digest. it
+/// holds in the order of compression centroids, the estimates are most precise
+/// near the smallest and largest values.
+class tdigest
+{
+    struct centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    double compression;
+    std::vector<centroid> centroids;
+    // the values added since the last compress
+    std::vector<centroid> pending;
+    double total;
+    double least;
+    double greatest;
+
+    void compress() {
+        if (pending.empty()) {
+            return;
+        }
+        pending.insert(pending.end(), centroids.begin(), centroids.end());
+        std::sort(pending.begin(), pending.end(), [](const centroid& a, const centroid& b){
+            return a.mean < b.mean;
+        });
+        centroids.clear();
+        auto current = pending.front();
+        double before = 0;
+        for (auto it = pending.begin() + 1; it != pending.end(); ++it) {
+            double q = (before + current.weight + it->weight) / total;
+            double limit = 4 * total * q * (1 - q) / compression;
+            if (current.weight + it->weight <= limit) {
+                current.mean += (it->mean - current.mean) * it->weight / (current.weight + it->weight);
+                current.weight += it->weight;
+            } else {
+                before += current.weight;
+                centroids.push_back(current);
+                current = *it;
+            }
+        }
+        centroids.push_back(current);
+        pending.clear();
+    }
+
+public:
+    explicit tdigest(double c = 100)
+        : compression((std::max)(c, 10.0))
+        , total(0)
+        , least(std::numeric_limits<double>::infinity())
+        , greatest(-std::numeric_limits<double>::infinity())
+    {
+    }
+
+    void add(double v, double weight = 1) {
+        centroid c = {v, weight};
+        pending.push_back(c);
+        total += weight;
+        least = (std::min)(least, v);
+        greatest = (std::max)(greatest, v);
+        if (pending.size() >= size_t(5 * compression)) {
+            compress();
+        }
+    }
+
+    void merge(const tdigest& o) {
+        pending.insert(pending.end(), o.centroids.begin(), o.centroids.end());
+        pending.insert(pending.end(), o.pending.begin(), o.pending.end());
+        total += o.total;
+        least = (std::min)(least, o.least);
+        greatest = (std::max)(greatest, o.greatest);
+        compress();
+    }
+
+    double count() const {
+        return total;
+    }
+
+    /// the estimate of the value with a fraction q of the values below it
+    double quantile(double q) {
+        compress();
+        if (centroids.empty()) {
+            throw std::runtime_error("tdigest::quantile() requires at least one value");
+        }
+        q = (std::min)((std::max)(q, 0.0), 1.0);
+        double target = q * total;
+        // each centroid is taken to be centered on its mean
+        double before = 0;
+        double left = least;
+        double left_at = 0;
+        for (auto& c : centroids) {
+            double at = before + c.weight / 2;
+            if (target < at) {
+                return left + (c.mean - left) * (target - left_at) / (at - left_at);
+            }
+            left = c.mean;
+            left_at = at;
+            before += c.weight;
+        }
+        if (total == left_at) {
+            return greatest;
+        }
+        return left + (greatest - left) * (target - left_at) / (total - left_at);
+    }
+};
+
+/// adds a value to a sketch, as the Accumulator of reduce or parallel_reduce
+struct sketch_add
+{
+    template<class Sketch, class V>
+    void operator()(Sketch& s, const V& v) const {
+        s.add(v);
+    }
+};
+
+/// combines two sketches, as the Combine of parallel_reduce
+struct sketch_merge
+{
+    template<class Sketch>
+    Sketch operator()(Sketch a, const Sketch& b) const {
+        a.merge(b);
+        return a;
+    }
+};
+
+}
+
+}
+
+#endif
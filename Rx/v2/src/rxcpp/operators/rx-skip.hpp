@@ -72,27 +72,66 @@ struct skip : public operator_base<T>
         state->source.subscribe(
         // split subscription lifetime
             source_lifetime,
-        // on_next
-            [state](T t) {
-                if (state->mode_value == mode::skipping) {
-                    if (--state->count == 0) {
+            make_observer_with_range(make_observer<T>(
+            // on_next
+                [state](T t) {
+                    if (state->mode_value == mode::skipping) {
+                        if (--state->count == 0) {
+                            state->mode_value = mode::triggered;
+                        }
+                    } else {
+                        state->out.on_next(std::move(t));
+                    }
+                },
+            // on_error
+                [state](std::exception_ptr e) {
+                    state->mode_value = mode::errored;
+                    state->out.on_error(e);
+                },
+            // on_completed
+                [state]() {
+                    state->mode_value = mode::stopped;
+                    state->out.on_completed();
+                }),
+            // on_next_range
+                [state](const T* first, size_t count) {
+                    if (state->mode_value == mode::skipping) {
+                        if (count < static_cast<size_t>(state->count)) {
+                            state->count -= static_cast<count_type>(count);
+                            return;
+                        }
+                        auto skipped = static_cast<size_t>(state->count);
+                        state->count = 0;
                         state->mode_value = mode::triggered;
+                        first += skipped;
+                        count -= skipped;
                     }
-                } else {
-                    state->out.on_next(t);
-                }
-            },
-        // on_error
-            [state](std::exception_ptr e) {
-                state->mode_value = mode::errored;
-                state->out.on_error(e);
-            },
-        // on_completed
-            [state]() {
-                state->mode_value = mode::stopped;
-                state->out.on_completed();
-            }
-        );
+                    state->out.on_next_range(first, count);
+                }));
+    }
+};
+
+// skip of a sliceable source is the source narrowed to the slice
+template<class T, class Observable, class Count, class Enable = void>
+struct skip_of
+{
+    typedef rxu::decay_t<Count> count_type;
+    typedef observable<T, skip<T, Observable, count_type>> type;
+
+    template<class Source>
+    static type make(Source&& source, count_type t) {
+        return type(skip<T, Observable, count_type>(std::forward<Source>(source), std::move(t)));
+    }
+};
+template<class T, class Observable, class Count>
+struct skip_of<T, Observable, Count, typename std::enable_if<is_sliceable<typename rxu::decay_t<Observable>::source_operator_type>::value>::type>
+{
+    typedef rxu::decay_t<Count> count_type;
+    typedef typename rxu::decay_t<Observable>::source_operator_type source_operator_type;
+    typedef observable<T, source_operator_type> type;
+
+    static type make(const rxu::decay_t<Observable>& source, count_type t) {
+        return type(source.source_operator.sliced(slice_count(t), (std::numeric_limits<size_t>::max)()));
     }
 };
 
@@ -105,9 +144,8 @@ public:
     skip_factory(count_type t) : count(std::move(t)) {}
     template<class Observable>
     auto operator()(Observable&& source)
-        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, skip<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>> {
-        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, skip<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>>(
-                                                                        skip<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>(std::forward<Observable>(source), count));
+        ->      typename skip_of<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>::type {
+        return  skip_of<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>::make(std::forward<Observable>(source), count);
     }
 };
 
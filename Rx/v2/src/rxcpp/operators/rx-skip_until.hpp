@@ -139,7 +139,7 @@ struct skip_until : public operator_base<T>
                 if (state->mode_value != mode::triggered) {
                     return;
                 }
-                state->out.on_next(t);
+                state->out.on_next(std::move(t));
             },
         // on_error
             [state](std::exception_ptr e) {
@@ -161,6 +161,102 @@ struct skip_until : public operator_base<T>
     }
 };
 
+// skips the items that arrive before the time. the time is one timed action
+// on the worker of the coordination, and on_next only checks a flag.
+template<class T, class Observable, class Coordination>
+struct skip_until_time : public operator_base<T>
+{
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type::time_point time_point_type;
+    struct values
+    {
+        values(source_type s, time_point_type w, coordination_type sf)
+            : source(std::move(s))
+            , when(w)
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        time_point_type when;
+        coordination_type coordination;
+    };
+    values initial;
+
+    skip_until_time(source_type s, time_point_type when, coordination_type sf)
+        : initial(std::move(s), when, std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct state_type
+            : public std::enable_shared_from_this<state_type>
+            , public values
+        {
+            state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , open(false)
+                , coordinator(std::move(coor))
+                , out(oarg)
+            {
+            }
+            std::atomic<bool> open;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sink = make_subscriber<T>(
+            state->out,
+        // on_next
+            [state](T t) {
+                if (state->open.load(std::memory_order_acquire)) {
+                    state->out.on_next(std::move(t));
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->out.on_completed();
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        auto controller = state->coordinator.get_worker();
+        if (state->when <= controller.now()) {
+            state->open.store(true, std::memory_order_release);
+        }
+        source->subscribe(std::move(selectedSink.get()));
+        if (!state->open.load(std::memory_order_acquire)) {
+            controller.schedule(state->when, [state](const rxsc::schedulable&) {
+                state->open.store(true, std::memory_order_release);
+            });
+        }
+    }
+};
+
 template<class TriggerObservable, class Coordination>
 class skip_until_factory
 {
@@ -183,6 +279,28 @@ public:
     }
 };
 
+template<class Coordination>
+class skip_until_time_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+    time_point_type when;
+    coordination_type coordination;
+public:
+    skip_until_time_factory(time_point_type w, coordination_type sf)
+        : when(w)
+        , coordination(std::move(sf))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, skip_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>> {
+        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, skip_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>>(
+                                                                        skip_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>(std::forward<Observable>(source), when, coordination));
+    }
+};
+
 }
 
 template<class TriggerObservable, class Coordination>
@@ -191,6 +309,12 @@ auto skip_until(TriggerObservable&& t, Coordination&& sf)
     return  detail::skip_until_factory<TriggerObservable, Coordination>(std::forward<TriggerObservable>(t), std::forward<Coordination>(sf));
 }
 
+template<class Coordination>
+auto skip_until(rxsc::scheduler::clock_type::time_point when, Coordination sf)
+    ->      detail::skip_until_time_factory<Coordination> {
+    return  detail::skip_until_time_factory<Coordination>(when, std::move(sf));
+}
+
 }
 
 }
@@ -0,0 +1,230 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_SLIDING_AGGREGATE_HPP)
+#define RXCPP_OPERATORS_RX_SLIDING_AGGREGATE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// the aggregate of a window that slides over the values. values enter at the
+// back and leave from the front. the front holds the aggregates of the values
+// from each position to the end of the front, the back holds the values that
+// arrived since the last flip and their aggregate. each value is combined a
+// constant number of times, so push, pop and aggregate are O(1) amortized.
+template<class Seed, class Combine>
+class sliding_window
+{
+    Seed seed;
+    Combine combine;
+    // the oldest value is last
+    std::vector<Seed> front;
+    std::vector<Seed> back;
+    Seed backAggregate;
+
+    void flip() {
+        auto aggregate = seed;
+        while (!back.empty()) {
+            aggregate = combine(std::move(back.back()), std::move(aggregate));
+            back.pop_back();
+            front.push_back(aggregate);
+        }
+        backAggregate = seed;
+    }
+
+public:
+    sliding_window(Seed s, Combine c)
+        : seed(s)
+        , combine(std::move(c))
+        , backAggregate(std::move(s))
+    {
+    }
+
+    size_t size() const {
+        return front.size() + back.size();
+    }
+
+    void push(Seed v) {
+        backAggregate = combine(std::move(backAggregate), v);
+        back.push_back(std::move(v));
+    }
+
+    void pop() {
+        if (front.empty()) {
+            flip();
+        }
+        front.pop_back();
+    }
+
+    Seed aggregate() {
+        if (front.empty()) {
+            return backAggregate;
+        }
+        return combine(front.back(), backAggregate);
+    }
+};
+
+template<class T, class Seed, class Combine, class Coordination>
+struct sliding_aggregate
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Seed> value_type;
+    typedef rxu::decay_t<Combine> combine_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    static_assert(std::is_convertible<source_value_type, value_type>::value, "sliding_aggregate values must be convertible to the Seed type");
+    static_assert(std::is_convertible<decltype((*(combine_type*)nullptr)(*(value_type*)nullptr, *(value_type*)nullptr)), value_type>::value, "sliding_aggregate Combine must be an associative function with the signature Seed(Seed, Seed)");
+
+    struct sliding_aggregate_values
+    {
+        sliding_aggregate_values(int c, rxu::maybe<clock_type::duration> p, value_type s, combine_type cmb, coordination_type cn)
+            : count(c)
+            , period(p)
+            , seed(std::move(s))
+            , combine(std::move(cmb))
+            , coordination(std::move(cn))
+        {
+        }
+        // 0 when the window is only limited by the period
+        int count;
+        rxu::maybe<clock_type::duration> period;
+        value_type seed;
+        combine_type combine;
+        coordination_type coordination;
+    };
+    sliding_aggregate_values initial;
+
+    sliding_aggregate(int count, rxu::maybe<clock_type::duration> period, value_type seed, combine_type combine, coordination_type cn)
+        : initial(count, period, std::move(seed), std::move(combine), std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    struct sliding_aggregate_observer : public sliding_aggregate_values
+    {
+        typedef sliding_aggregate_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+        dest_type dest;
+
+        struct window_state
+        {
+            window_state(const sliding_aggregate_values& v)
+                : window(v.seed, v.combine)
+            {
+            }
+            sliding_window<value_type, combine_type> window;
+            // when each value in the window arrived, only kept with a period
+            rxu::detail::ring_queue<clock_type::time_point> arrivals;
+        };
+        std::shared_ptr<window_state> state;
+
+        sliding_aggregate_observer(dest_type d, sliding_aggregate_values v)
+            : sliding_aggregate_values(v)
+            , dest(std::move(d))
+            , state(std::make_shared<window_state>(v))
+        {
+        }
+
+        void on_next(source_value_type v) const {
+            auto& window = state->window;
+            auto& arrivals = state->arrivals;
+            auto aggregate = on_exception(
+                [&](){
+                    if (!this->period.empty()) {
+                        auto now = this->coordination.now();
+                        while (!arrivals.empty() && now - arrivals.front() >= this->period.get()) {
+                            arrivals.pop_front();
+                            window.pop();
+                        }
+                        arrivals.push_back(now);
+                    }
+                    if (this->count > 0 && window.size() == static_cast<size_t>(this->count)) {
+                        window.pop();
+                    }
+                    window.push(std::move(v));
+                    return window.aggregate();},
+                dest);
+            if (aggregate.empty()) {
+                return;
+            }
+            dest.on_next(std::move(aggregate.get()));
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<T, observer_type> make(dest_type d, sliding_aggregate_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<T>(std::move(cs), observer_type(this_type(std::move(d), std::move(v))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(sliding_aggregate_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      sliding_aggregate_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Seed, class Combine, class Coordination>
+class sliding_aggregate_factory
+{
+    typedef rxu::decay_t<Seed> seed_type;
+    typedef rxu::decay_t<Combine> combine_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    int count;
+    rxu::maybe<clock_type::duration> period;
+    seed_type seed;
+    combine_type combine;
+    coordination_type coordination;
+public:
+    sliding_aggregate_factory(int c, rxu::maybe<clock_type::duration> p, seed_type s, combine_type cmb, coordination_type cn)
+        : count(c)
+        , period(p)
+        , seed(std::move(s))
+        , combine(std::move(cmb))
+        , coordination(std::move(cn))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<seed_type>(sliding_aggregate<rxu::value_type_t<rxu::decay_t<Observable>>, Seed, Combine, Coordination>(count, period, seed, combine, coordination))) {
+        return      source.template lift<seed_type>(sliding_aggregate<rxu::value_type_t<rxu::decay_t<Observable>>, Seed, Combine, Coordination>(count, period, seed, combine, coordination));
+    }
+};
+
+}
+
+/// the aggregate of the last count values, emitted for each value
+template<class Seed, class Combine>
+auto sliding_aggregate(int count, Seed s, Combine c)
+    ->      detail::sliding_aggregate_factory<Seed, Combine, identity_one_worker> {
+    return  detail::sliding_aggregate_factory<Seed, Combine, identity_one_worker>(count, rxu::maybe<rxsc::scheduler::clock_type::duration>(), std::move(s), std::move(c), identity_current_thread());
+}
+
+/// the aggregate of the values that arrived during the last period, measured
+/// on the clock of the coordination, emitted for each value
+template<class Seed, class Combine, class Coordination>
+auto sliding_aggregate(rxsc::scheduler::clock_type::duration period, Seed s, Combine c, Coordination cn)
+    ->      detail::sliding_aggregate_factory<Seed, Combine, Coordination> {
+    return  detail::sliding_aggregate_factory<Seed, Combine, Coordination>(0, rxu::maybe<rxsc::scheduler::clock_type::duration>(period), std::move(s), std::move(c), std::move(cn));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_SPLIT_HPP)
+#define RXCPP_OPERATORS_RX_SPLIT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+inline slice as_slice(slice s) {
+    return s;
+}
+inline slice as_slice(std::string s) {
+    return slice(std::move(s));
+}
+
+template<class T>
+struct split
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef slice value_type;
+
+    struct split_values
+    {
+        split_values(char d, bool cr)
+            : delimiter(d)
+            , drop_cr(cr)
+        {
+        }
+        char delimiter;
+        // split_lines drops a '\r' before the '\n'
+        bool drop_cr;
+    };
+    split_values initial;
+
+    split(char delimiter, bool drop_cr)
+        : initial(delimiter, drop_cr)
+    {
+    }
+
+    template<class Subscriber>
+    struct split_observer : public split_values
+    {
+        typedef split_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+
+        static_assert(std::is_same<source_value_type, slice>::value || std::is_same<source_value_type, std::string>::value, "split requires a source of slice or std::string");
+
+        dest_type dest;
+        // the pieces of a part that started in an earlier chunk
+        mutable std::vector<slice> pending;
+        mutable size_t pending_size;
+
+        split_observer(dest_type d, split_values v)
+            : split_values(v)
+            , dest(std::move(d))
+            , pending_size(0)
+        {
+        }
+
+        void emit(slice part) const {
+            if (this->drop_cr && !part.empty() && part[part.size() - 1] == '\r') {
+                part = part.sub(0, part.size() - 1);
+            }
+            dest.on_next(std::move(part));
+        }
+
+        // the pending pieces followed by tail. only a part that crosses a
+        // chunk boundary is copied.
+        slice join(slice tail) const {
+            if (pending.empty()) {
+                return tail;
+            }
+            slice joined;
+            if (pending.size() == 1 && tail.empty()) {
+                joined = std::move(pending.front());
+            } else {
+                std::string bytes;
+                bytes.reserve(pending_size + tail.size());
+                for (auto& piece : pending) {
+                    bytes.append(piece.data(), piece.size());
+                }
+                bytes.append(tail.data(), tail.size());
+                joined = slice(std::move(bytes));
+            }
+            pending.clear();
+            pending_size = 0;
+            return joined;
+        }
+
+        void on_next(source_value_type v) const {
+            auto chunk = as_slice(std::move(v));
+            auto first = chunk.data();
+            auto last = first + chunk.size();
+            auto cursor = first;
+            while (cursor != last) {
+                auto found = static_cast<const char*>(std::memchr(cursor, this->delimiter, last - cursor));
+                if (!found) {
+                    break;
+                }
+                if (!dest.is_subscribed()) {
+                    return;
+                }
+                emit(join(chunk.sub(cursor - first, found - cursor)));
+                cursor = found + 1;
+            }
+            if (cursor != last) {
+                pending.push_back(chunk.sub(cursor - first));
+                pending_size += last - cursor;
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            if (!pending.empty()) {
+                emit(join(slice()));
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, split_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(d), std::move(v))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(split_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      split_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+class split_factory
+{
+    char delimiter;
+    bool drop_cr;
+public:
+    split_factory(char d, bool cr)
+        : delimiter(d)
+        , drop_cr(cr)
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<slice>(split<rxu::value_type_t<rxu::decay_t<Observable>>>(delimiter, drop_cr))) {
+        return      source.template lift<slice>(split<rxu::value_type_t<rxu::decay_t<Observable>>>(delimiter, drop_cr));
+    }
+};
+
+}
+
+/// the parts of the chunks between each delimiter
+inline auto split(char delimiter)
+    ->      detail::split_factory {
+    return  detail::split_factory(delimiter, false);
+}
+
+/// the lines of the chunks. a '\r' before the '\n' is dropped
+inline auto split_lines()
+    ->      detail::split_factory {
+    return  detail::split_factory('\n', true);
+}
+
+}
+
+}
+
+#endif
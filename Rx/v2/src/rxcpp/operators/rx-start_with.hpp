@@ -11,10 +11,60 @@ namespace rxcpp {
 
 namespace operators {
 
+namespace detail {
+
+// the prefix is held in the operator and sent on the thread that subscribes,
+// before the subscribe to the source, instead of through an iterate and a
+// concat that would allocate their states and schedule each value.
+template<class T, class Observable, size_t Count>
+struct start_with : public operator_base<T>
+{
+    typedef rxu::decay_t<Observable> source_type;
+    typedef std::array<T, Count> prefix_type;
+
+    struct values
+    {
+        values(source_type s, prefix_type p)
+            : source(std::move(s))
+            , prefix(std::move(p))
+        {
+        }
+        source_type source;
+        prefix_type prefix;
+    };
+    values initial;
+
+    start_with(source_type s, prefix_type p)
+        : initial(std::move(s), std::move(p))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        for (auto& v : initial.prefix) {
+            if (!o.is_subscribed()) {
+                return;
+            }
+            o.on_next(v);
+        }
+        if (!o.is_subscribed()) {
+            return;
+        }
+        initial.source.subscribe(std::move(o));
+    }
+};
+
+}
+
 template<class Observable, class Value0, class... ValueN>
 auto start_with(Observable o, Value0 v0, ValueN... vn)
-    -> decltype(rxs::from(rxu::value_type_t<Observable>(v0), rxu::value_type_t<Observable>(vn)...).concat(o)) {
-    return      rxs::from(rxu::value_type_t<Observable>(v0), rxu::value_type_t<Observable>(vn)...).concat(o);
+    ->      observable<rxu::value_type_t<Observable>, detail::start_with<rxu::value_type_t<Observable>, Observable, 1 + sizeof...(ValueN)>> {
+    typedef rxu::value_type_t<Observable> value_type;
+    std::array<value_type, 1 + sizeof...(ValueN)> prefix = {{value_type(std::move(v0)), value_type(std::move(vn))...}};
+    return  observable<value_type, detail::start_with<value_type, Observable, 1 + sizeof...(ValueN)>>(
+                                   detail::start_with<value_type, Observable, 1 + sizeof...(ValueN)>(std::move(o), std::move(prefix)));
 }
 
 }
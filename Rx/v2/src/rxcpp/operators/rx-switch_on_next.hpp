@@ -63,18 +63,63 @@ struct switch_on_next
             switch_state_type(values i, coordinator_type coor, output_type oarg)
                 : values(i)
                 , source(i.source_operator)
-                , pendingCompletions(0)
+                , generation(0)
+                , inner_active(false)
+                , outer_completed(false)
                 , coordinator(std::move(coor))
+                , stopped(false)
                 , out(std::move(oarg))
             {
             }
             observable<source_value_type, source_operator_type> source;
-            // on_completed on the output must wait until all the
-            // subscriptions have received on_completed
-            int pendingCompletions;
+            // each inner is stamped with the generation that was current
+            // when it was subscribed. values from an inner that has been
+            // replaced are dropped.
+            std::atomic<size_t> generation;
+            // on_completed on the output must wait until the source and
+            // the current inner have both completed
+            bool inner_active;
+            bool outer_completed;
             coordinator_type coordinator;
+            // the one inner slot. it is registered with the output once and
+            // each inner replaces the subscription in it. the slot is
+            // replaced on the source thread and emptied when out is
+            // unsubscribed, so it is guarded by lock.
+            std::mutex lock;
+            bool stopped;
             composite_subscription inner_lifetime;
             output_type out;
+
+            // puts next in the slot and unsubscribes the inner it replaced.
+            // returns false when out has been unsubscribed, next is then
+            // unsubscribed as well.
+            bool replace_inner(composite_subscription next) {
+                composite_subscription replaced;
+                bool accepted = false;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (!stopped) {
+                        replaced = inner_lifetime;
+                        inner_lifetime = next;
+                        accepted = true;
+                    }
+                }
+                replaced.unsubscribe();
+                if (!accepted || !out.is_subscribed()) {
+                    next.unsubscribe();
+                    return false;
+                }
+                return true;
+            }
+            void stop() {
+                composite_subscription last;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    stopped = true;
+                    last = inner_lifetime;
+                }
+                last.unsubscribe();
+            }
         };
 
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
@@ -87,6 +132,9 @@ struct switch_on_next
         // when the out observer is unsubscribed all the
         // inner subscriptions are unsubscribed as well
         state->out.add(outercs);
+        state->out.add([state](){
+            state->stop();
+        });
 
         auto source = on_exception(
             [&](){return state->coordinator.in(state->source);},
@@ -95,7 +143,6 @@ struct switch_on_next
             return;
         }
 
-        ++state->pendingCompletions;
         // this subscribe does not share the observer subscription
         // so that when it is unsubscribed the observer can be called
         // until the inner subscriptions have finished
@@ -105,18 +152,13 @@ struct switch_on_next
         // on_next
             [state](collection_type st) {
 
-                state->inner_lifetime.unsubscribe();
+                auto generation = ++state->generation;
 
-                state->inner_lifetime = composite_subscription();
-
-                // when the out observer is unsubscribed all the
-                // inner subscriptions are unsubscribed as well
-                auto innerlifetimetoken = state->out.add(state->inner_lifetime);
-
-                state->inner_lifetime.add(make_subscription([state, innerlifetimetoken](){
-                    state->out.remove(innerlifetimetoken);
-                    --state->pendingCompletions;
-                }));
+                composite_subscription innercs;
+                if (!state->replace_inner(innercs)) {
+                    return;
+                }
+                state->inner_active = true;
 
                 auto selectedSource = state->coordinator.in(st);
 
@@ -124,25 +166,34 @@ struct switch_on_next
                 // so that when it is unsubscribed the source will continue
                 auto sinkInner = make_subscriber<collection_value_type>(
                     state->out,
-                    state->inner_lifetime,
+                    innercs,
                 // on_next
-                    [state, st](collection_value_type ct) {
+                    [state, generation](collection_value_type ct) {
+                        if (generation != state->generation) {
+                            return;
+                        }
                         state->out.on_next(std::move(ct));
                     },
                 // on_error
-                    [state](std::exception_ptr e) {
+                    [state, generation](std::exception_ptr e) {
+                        if (generation != state->generation) {
+                            return;
+                        }
                         state->out.on_error(e);
                     },
                 //on_completed
-                    [state](){
-                        if (state->pendingCompletions == 1) {
+                    [state, generation](){
+                        if (generation != state->generation) {
+                            return;
+                        }
+                        state->inner_active = false;
+                        if (state->outer_completed) {
                             state->out.on_completed();
                         }
                     }
                 );
 
                 auto selectedSinkInner = state->coordinator.out(sinkInner);
-                ++state->pendingCompletions;
                 selectedSource.subscribe(std::move(selectedSinkInner));
             },
         // on_error
@@ -151,7 +202,8 @@ struct switch_on_next
             },
         // on_completed
             [state]() {
-                if (--state->pendingCompletions == 0) {
+                state->outer_completed = true;
+                if (!state->inner_active) {
                     state->out.on_completed();
                 }
             }
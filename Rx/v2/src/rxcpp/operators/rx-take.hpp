@@ -72,31 +72,72 @@ struct take : public operator_base<T>
         state->source.subscribe(
         // split subscription lifetime
             source_lifetime,
-        // on_next
-            [state, source_lifetime](T t) {
-                if (state->mode_value < mode::triggered) {
-                    if (--state->count > 0) {
-                        state->out.on_next(t);
-                    } else {
-                        state->mode_value = mode::triggered;
-                        state->out.on_next(t);
-                        // must shutdown source before signaling completion
-                        source_lifetime.unsubscribe();
-                        state->out.on_completed();
+            make_observer_with_range(make_observer<T>(
+            // on_next
+                [state, source_lifetime](T t) {
+                    if (state->mode_value < mode::triggered) {
+                        if (--state->count > 0) {
+                            state->out.on_next(std::move(t));
+                        } else {
+                            state->mode_value = mode::triggered;
+                            state->out.on_next(std::move(t));
+                            // must shutdown source before signaling completion
+                            source_lifetime.unsubscribe();
+                            state->out.on_completed();
+                        }
                     }
-                }
-            },
-        // on_error
-            [state](std::exception_ptr e) {
-                state->mode_value = mode::errored;
-                state->out.on_error(e);
-            },
-        // on_completed
-            [state]() {
-                state->mode_value = mode::stopped;
-                state->out.on_completed();
-            }
-        );
+                },
+            // on_error
+                [state](std::exception_ptr e) {
+                    state->mode_value = mode::errored;
+                    state->out.on_error(e);
+                },
+            // on_completed
+                [state]() {
+                    state->mode_value = mode::stopped;
+                    state->out.on_completed();
+                }),
+            // on_next_range
+                [state, source_lifetime](const T* first, size_t count) {
+                    if (state->mode_value < mode::triggered) {
+                        if (state->count > 0 && count < static_cast<size_t>(state->count)) {
+                            state->count -= static_cast<count_type>(count);
+                            state->out.on_next_range(first, count);
+                        } else {
+                            auto last = state->count > 0 ? static_cast<size_t>(state->count) : 1;
+                            state->count = 0;
+                            state->mode_value = mode::triggered;
+                            state->out.on_next_range(first, last);
+                            // must shutdown source before signaling completion
+                            source_lifetime.unsubscribe();
+                            state->out.on_completed();
+                        }
+                    }
+                }));
+    }
+};
+
+// take of a sliceable source is the source narrowed to the slice
+template<class T, class Observable, class Count, class Enable = void>
+struct take_of
+{
+    typedef rxu::decay_t<Count> count_type;
+    typedef observable<T, take<T, Observable, count_type>> type;
+
+    template<class Source>
+    static type make(Source&& source, count_type t) {
+        return type(take<T, Observable, count_type>(std::forward<Source>(source), std::move(t)));
+    }
+};
+template<class T, class Observable, class Count>
+struct take_of<T, Observable, Count, typename std::enable_if<is_sliceable<typename rxu::decay_t<Observable>::source_operator_type>::value>::type>
+{
+    typedef rxu::decay_t<Count> count_type;
+    typedef typename rxu::decay_t<Observable>::source_operator_type source_operator_type;
+    typedef observable<T, source_operator_type> type;
+
+    static type make(const rxu::decay_t<Observable>& source, count_type t) {
+        return type(source.source_operator.sliced(0, slice_count(t)));
     }
 };
 
@@ -109,9 +150,8 @@ public:
     take_factory(count_type t) : count(std::move(t)) {}
     template<class Observable>
     auto operator()(Observable&& source)
-        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>,   take<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>> {
-        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>,   take<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>>(
-                                                                          take<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>(std::forward<Observable>(source), count));
+        ->      typename take_of<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>::type {
+        return  take_of<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, count_type>::make(std::forward<Observable>(source), count);
     }
 };
 
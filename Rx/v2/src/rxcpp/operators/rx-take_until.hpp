@@ -133,7 +133,7 @@ struct take_until : public operator_base<T>
                 // everything is crafted to minimize the overhead of this function.
                 //
                 if (state->mode_value < mode::triggered) {
-                    state->out.on_next(t);
+                    state->out.on_next(std::move(t));
                 }
             },
         // on_error
@@ -159,6 +159,198 @@ struct take_until : public operator_base<T>
     }
 };
 
+// completes at the deadline. the deadline is one timed action on the worker
+// of the coordination, and on_next only checks a flag.
+template<class T, class Observable, class Coordination>
+struct take_until_time : public operator_base<T>
+{
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type::time_point time_point_type;
+    struct values
+    {
+        values(source_type s, time_point_type w, coordination_type sf)
+            : source(std::move(s))
+            , when(w)
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        time_point_type when;
+        coordination_type coordination;
+    };
+    values initial;
+
+    take_until_time(source_type s, time_point_type when, coordination_type sf)
+        : initial(std::move(s), when, std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct state_type
+            : public std::enable_shared_from_this<state_type>
+            , public values
+        {
+            state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , expired(false)
+                , coordinator(std::move(coor))
+                , out(oarg)
+            {
+            }
+            std::atomic<bool> expired;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sink = make_subscriber<T>(
+            state->out,
+        // on_next
+            [state](T t) {
+                if (!state->expired.load(std::memory_order_acquire)) {
+                    state->out.on_next(std::move(t));
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->out.on_completed();
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        auto deadline = selectedSink.get();
+        source->subscribe(std::move(selectedSink.get()));
+        auto controller = state->coordinator.get_worker();
+        controller.schedule(state->when, [state, deadline](const rxsc::schedulable&) {
+            state->expired.store(true, std::memory_order_release);
+            deadline.on_completed();
+        });
+    }
+};
+
+// completes when the token is cancelled. the subscription is one entry in
+// the list of the cancellation_source, so a source shared by many
+// subscriptions cancels them with one walk of its list.
+template<class T, class Observable, class Coordination>
+struct take_until_token : public operator_base<T>
+{
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    struct values
+    {
+        values(source_type s, cancellation_token t, coordination_type sf)
+            : source(std::move(s))
+            , token(std::move(t))
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        cancellation_token token;
+        coordination_type coordination;
+    };
+    values initial;
+
+    take_until_token(source_type s, cancellation_token t, coordination_type sf)
+        : initial(std::move(s), std::move(t), std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct state_type
+            : public std::enable_shared_from_this<state_type>
+            , public values
+        {
+            state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , cancelled(false)
+                , coordinator(std::move(coor))
+                , out(oarg)
+            {
+            }
+            std::atomic<bool> cancelled;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sink = make_subscriber<T>(
+            state->out,
+        // on_next
+            [state](T t) {
+                if (!state->cancelled.load(std::memory_order_acquire)) {
+                    state->out.on_next(std::move(t));
+                }
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->out.on_completed();
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        auto cancelled = selectedSink.get();
+        auto controller = state->coordinator.get_worker();
+        auto complete = [state, cancelled, controller](){
+            state->cancelled.store(true, std::memory_order_release);
+            controller.schedule([cancelled](const rxsc::schedulable&) {
+                cancelled.on_completed();
+            });
+        };
+        state->token.add(state->out.get_subscription(), std::make_shared<rxcpp::detail::cancellation_callback<decltype(complete)>>(std::move(complete)));
+        if (state->cancelled.load(std::memory_order_acquire)) {
+            return;
+        }
+        source->subscribe(std::move(selectedSink.get()));
+    }
+};
+
 template<class TriggerObservable, class Coordination>
 class take_until_factory
 {
@@ -181,6 +373,49 @@ public:
     }
 };
 
+template<class Coordination>
+class take_until_time_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+    time_point_type when;
+    coordination_type coordination;
+public:
+    take_until_time_factory(time_point_type w, coordination_type sf)
+        : when(w)
+        , coordination(std::move(sf))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, take_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>> {
+        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, take_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>>(
+                                                                        take_until_time<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>(std::forward<Observable>(source), when, coordination));
+    }
+};
+
+template<class Coordination>
+class take_until_token_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    cancellation_token token;
+    coordination_type coordination;
+public:
+    take_until_token_factory(cancellation_token t, coordination_type sf)
+        : token(std::move(t))
+        , coordination(std::move(sf))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, take_until_token<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>> {
+        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, take_until_token<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>>(
+                                                                        take_until_token<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, Coordination>(std::forward<Observable>(source), token, coordination));
+    }
+};
+
 }
 
 template<class TriggerObservable, class Coordination>
@@ -189,6 +424,18 @@ auto take_until(TriggerObservable t, Coordination sf)
     return  detail::take_until_factory<TriggerObservable, Coordination>(std::move(t), std::move(sf));
 }
 
+template<class Coordination>
+auto take_until(rxsc::scheduler::clock_type::time_point when, Coordination sf)
+    ->      detail::take_until_time_factory<Coordination> {
+    return  detail::take_until_time_factory<Coordination>(when, std::move(sf));
+}
+
+template<class Coordination>
+auto take_until(cancellation_token t, Coordination sf)
+    ->      detail::take_until_token_factory<Coordination> {
+    return  detail::take_until_token_factory<Coordination>(std::move(t), std::move(sf));
+}
+
 }
 
 }
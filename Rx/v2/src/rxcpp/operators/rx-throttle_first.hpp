@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_THROTTLE_FIRST_HPP)
+#define RXCPP_OPERATORS_RX_THROTTLE_FIRST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+// emits an item and then drops the items that arrive within the period
+// after it. only the clock of the worker is used, no action is scheduled.
+template<class T, class Duration, class Coordination>
+struct throttle_first
+{
+    static_assert(std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>::value, "Duration parameter must convert to rxsc::scheduler::clock_type::duration");
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct throttle_first_values
+    {
+        throttle_first_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+        duration_type period;
+        coordination_type coordination;
+    };
+    throttle_first_values initial;
+
+    throttle_first(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct throttle_first_observer
+    {
+        typedef throttle_first_observer<Subscriber> this_type;
+        typedef rxu::decay_t<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct throttle_first_subscriber_values : public throttle_first_values
+        {
+            throttle_first_subscriber_values(dest_type d, throttle_first_values v, coordinator_type c)
+                : throttle_first_values(v)
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(std::move(coordinator.get_worker()))
+                , next(rxsc::scheduler::clock_type::time_point::min())
+            {
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            rxsc::scheduler::clock_type::time_point next;
+        };
+        std::shared_ptr<throttle_first_subscriber_values> state;
+
+        throttle_first_observer(dest_type d, throttle_first_values v, coordinator_type c)
+            : state(std::make_shared<throttle_first_subscriber_values>(std::move(d), v, std::move(c)))
+        {
+        }
+        void on_next(T v) const {
+            auto now = state->worker.now();
+            if (now < state->next) {
+                return;
+            }
+            state->next = now + state->period;
+            state->dest.on_next(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            state->dest.on_error(e);
+        }
+        void on_completed() const {
+            state->dest.on_completed();
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, throttle_first_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(throttle_first_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      throttle_first_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Duration, class Coordination>
+class throttle_first_factory
+{
+    typedef rxu::decay_t<Duration> duration_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    duration_type period;
+    coordination_type coordination;
+public:
+    throttle_first_factory(duration_type p, coordination_type c) : period(p), coordination(c) {}
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(throttle_first<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(throttle_first<rxu::value_type_t<rxu::decay_t<Observable>>, Duration, Coordination>(period, coordination));
+    }
+};
+
+}
+
+template<class Duration, class Coordination>
+inline auto throttle_first(Duration period, Coordination coordination)
+    ->      detail::throttle_first_factory<Duration, Coordination> {
+    return  detail::throttle_first_factory<Duration, Coordination>(period, coordination);
+}
+
+}
+
+}
+
+#endif
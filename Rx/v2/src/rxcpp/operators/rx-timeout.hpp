@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_TIMEOUT_HPP)
+#define RXCPP_OPERATORS_RX_TIMEOUT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+/// the error that timeout sends when no fallback was supplied
+class timeout_error : public std::runtime_error
+{
+public:
+    explicit timeout_error(const std::string& msg)
+        : std::runtime_error(msg)
+    {
+    }
+};
+
+namespace detail {
+
+// switches to the fallback when no item has arrived for the period.
+// there is one timed action for each subscription. on_next only stores the
+// time of the item. when the action runs and items have arrived it
+// reschedules itself for the period after the last one. the time is the one
+// atomic that both use, so the action never sees an item without its time.
+template<class T, class Observable, class Fallback, class Coordination>
+struct timeout : public operator_base<T>
+{
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<Fallback> fallback_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+    typedef clock_type::duration duration_type;
+    struct values
+    {
+        values(source_type s, duration_type p, fallback_type f, coordination_type sf)
+            : source(std::move(s))
+            , period(p)
+            , fallback(std::move(f))
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        duration_type period;
+        fallback_type fallback;
+        coordination_type coordination;
+    };
+    values initial;
+
+    timeout(source_type s, duration_type period, fallback_type f, coordination_type sf)
+        : initial(std::move(s), period, std::move(f), std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct timeout_state_type
+            : public std::enable_shared_from_this<timeout_state_type>
+            , public values
+        {
+            // the time of the last item once the source has stopped or timed out
+            static duration_type::rep stopped() {return std::numeric_limits<duration_type::rep>::max();}
+
+            timeout_state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , coordinator(std::move(coor))
+                , controller(coordinator.get_worker())
+                , last(controller.now().time_since_epoch().count())
+                , checked(last.load())
+                , out(oarg)
+            {
+                out.add(source_lifetime);
+            }
+
+            // true when the caller may send the item that arrived at now
+            bool arrive(duration_type::rep now) {
+                auto seen = last.load(std::memory_order_relaxed);
+                return seen != stopped() && last.compare_exchange_strong(seen, now);
+            }
+            bool stop() {
+                auto seen = last.load(std::memory_order_relaxed);
+                return seen != stopped() && last.compare_exchange_strong(seen, stopped());
+            }
+
+            void on_timer(const rxsc::schedulable& self) {
+                auto state = this->shared_from_this();
+                // an item that arrived in the same tick as the last one that
+                // was checked arrived a period ago
+                if (!last.compare_exchange_strong(checked, stopped())) {
+                    if (checked == stopped()) {
+                        return;
+                    }
+                    // items arrived, wait for the period after the last one
+                    self.schedule(clock_type::time_point(duration_type(checked)) + this->period);
+                    return;
+                }
+                source_lifetime.unsubscribe();
+                auto selectedFallback = on_exception(
+                    [&](){return state->coordinator.in(state->fallback);},
+                    state->out);
+                if (selectedFallback.empty()) {
+                    return;
+                }
+                auto selectedOut = on_exception(
+                    [&](){return state->coordinator.out(state->out);},
+                    state->out);
+                if (selectedOut.empty()) {
+                    return;
+                }
+                selectedFallback->subscribe(std::move(selectedOut.get()));
+            }
+
+            composite_subscription source_lifetime;
+            coordinator_type coordinator;
+            rxsc::worker controller;
+            std::atomic<duration_type::rep> last;
+            // the time of the last item when the timer last ran
+            duration_type::rep checked;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<timeout_state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sink = make_subscriber<T>(
+        // split subscription lifetime
+            state->source_lifetime,
+        // on_next
+            [state](T t) {
+                if (!state->arrive(state->controller.now().time_since_epoch().count())) {
+                    return;
+                }
+                state->out.on_next(std::move(t));
+            },
+        // on_error
+            [state](std::exception_ptr e) {
+                if (!state->stop()) {
+                    return;
+                }
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                if (!state->stop()) {
+                    return;
+                }
+                state->out.on_completed();
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+
+        source->subscribe(std::move(selectedSink.get()));
+
+        state->controller.schedule(clock_type::time_point(duration_type(state->checked)) + state->period, [state](const rxsc::schedulable& self){
+            state->on_timer(self);
+        });
+    }
+};
+
+template<class Fallback, class Coordination>
+class timeout_factory
+{
+    typedef rxu::decay_t<Fallback> fallback_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type::duration duration_type;
+
+    duration_type period;
+    fallback_type fallback;
+    coordination_type coordination;
+public:
+    timeout_factory(duration_type p, fallback_type f, coordination_type sf)
+        : period(p)
+        , fallback(std::move(f))
+        , coordination(std::move(sf))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        ->      observable<rxu::value_type_t<rxu::decay_t<Observable>>, timeout<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, fallback_type, Coordination>> {
+        return  observable<rxu::value_type_t<rxu::decay_t<Observable>>, timeout<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, fallback_type, Coordination>>(
+                                                                        timeout<rxu::value_type_t<rxu::decay_t<Observable>>, Observable, fallback_type, Coordination>(std::forward<Observable>(source), period, fallback, coordination));
+    }
+};
+
+}
+
+template<class Coordination, class Fallback>
+auto timeout(rxsc::scheduler::clock_type::duration period, Coordination sf, Fallback f)
+    ->      detail::timeout_factory<Fallback, Coordination> {
+    return  detail::timeout_factory<Fallback, Coordination>(period, std::move(f), std::move(sf));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_TO_COLUMNS_HPP)
+#define RXCPP_OPERATORS_RX_TO_COLUMNS_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class T, class Field>
+struct column_of;
+
+template<class T, class Member, class Class>
+struct column_of<T, Member Class::*>
+{
+    static_assert(std::is_base_of<Class, T>::value, "each field must be a data member of the value");
+    typedef rxu::decay_t<Member> type;
+};
+
+template<class T, class Coordination, class... FieldN>
+struct to_columns
+{
+    static_assert(is_coordination<Coordination>::value, "Coordination parameter must satisfy the requirements for a Coordination");
+    static_assert(sizeof...(FieldN) > 0, "to_columns needs at least one field");
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef column_batch<typename column_of<source_value_type, FieldN>::type...> value_type;
+    typedef std::tuple<FieldN...> fields_type;
+    typedef typename rxu::values_from<int, sizeof...(FieldN)>::type field_indices;
+
+    struct to_columns_values
+    {
+        to_columns_values(int n, rxsc::scheduler::clock_type::duration p, coordination_type c, fields_type f)
+            : count(n)
+            , period(p)
+            , coordination(std::move(c))
+            , fields(std::move(f))
+        {
+        }
+        int count;
+        rxsc::scheduler::clock_type::duration period;
+        coordination_type coordination;
+        fields_type fields;
+    };
+    to_columns_values initial;
+
+    to_columns(int count, rxsc::scheduler::clock_type::duration period, coordination_type coordination, FieldN... fieldn)
+        : initial(count, period, std::move(coordination), fields_type(fieldn...))
+    {
+    }
+
+    template<class Subscriber>
+    struct to_columns_observer
+    {
+        typedef to_columns_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+
+        struct to_columns_subscriber_values : public to_columns_values
+        {
+            to_columns_subscriber_values(dest_type d, to_columns_values v, coordinator_type c)
+                : to_columns_values(std::move(v))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , batch_id(0)
+                , batch(this->count)
+            {
+            }
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            mutable int batch_id;
+            mutable value_type batch;
+        };
+        typedef std::shared_ptr<to_columns_subscriber_values> state_type;
+        state_type state;
+
+        to_columns_observer(dest_type d, to_columns_values v, coordinator_type c)
+            : state(std::make_shared<to_columns_subscriber_values>(std::move(d), std::move(v), std::move(c)))
+        {
+            schedule_batch(state->batch_id, state->worker.now() + state->period, state);
+        }
+
+        static void schedule_batch(int id, rxsc::scheduler::clock_type::time_point when, state_type state) {
+            auto localState = state;
+            state->worker.schedule(when, [id, when, localState](const rxsc::schedulable&){
+                produce_batch(id, when, localState);
+            });
+        }
+
+        // sends the batch when it is not empty and starts the next one with
+        // room for count rows. a batch that fills starts a new period.
+        static void produce_batch(int id, rxsc::scheduler::clock_type::time_point expected, state_type state) {
+            if (id != state->batch_id)
+                return;
+
+            if (!state->batch.empty()) {
+                value_type batch(state->count);
+                std::swap(batch, state->batch);
+                state->dest.on_next(std::move(batch));
+            }
+            schedule_batch(++state->batch_id, expected + state->period, state);
+        }
+
+        template<int... IndexN>
+        static void scatter(value_type& batch, const fields_type& fields, const source_value_type& v, rxu::values<int, IndexN...>) {
+            int expanded[] = {0, (batch.template column<IndexN>().push_back(v.*std::get<IndexN>(fields)), 0)...};
+            (void)expanded;
+            batch.set_size(batch.size() + 1);
+        }
+
+        void on_next(const source_value_type& v) const {
+            scatter(state->batch, state->fields, v, field_indices());
+            if (int(state->batch.size()) == state->count) {
+                produce_batch(state->batch_id, state->worker.now(), state);
+            }
+        }
+        void on_error(std::exception_ptr e) const {
+            state->dest.on_error(e);
+        }
+        void on_completed() const {
+            if (!state->batch.empty()) {
+                state->dest.on_next(std::move(state->batch));
+            }
+            state->dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, to_columns_values v) {
+            auto cs = d.get_subscription();
+            auto coordinator = v.coordination.create_coordinator(cs);
+
+            return make_subscriber<source_value_type>(std::move(cs), this_type(std::move(d), std::move(v), std::move(coordinator)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(to_columns_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      to_columns_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class Coordination, class... FieldN>
+class to_columns_factory
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+
+    int count;
+    rxsc::scheduler::clock_type::duration period;
+    coordination_type coordination;
+    std::tuple<FieldN...> fields;
+
+    template<class Observable, int... IndexN>
+    auto lift_to(Observable&& source, rxu::values<int, IndexN...>)
+        -> decltype(source.template lift<rxu::value_type_t<to_columns<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, FieldN...>>>(to_columns<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, FieldN...>(count, period, coordination, std::get<IndexN>(fields)...))) {
+        return      source.template lift<rxu::value_type_t<to_columns<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, FieldN...>>>(to_columns<rxu::value_type_t<rxu::decay_t<Observable>>, Coordination, FieldN...>(count, period, coordination, std::get<IndexN>(fields)...));
+    }
+public:
+    to_columns_factory(int n, rxsc::scheduler::clock_type::duration p, coordination_type c, FieldN... fieldn)
+        : count(n)
+        , period(p)
+        , coordination(std::move(c))
+        , fields(fieldn...)
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(lift_to(std::forward<Observable>(source), typename rxu::values_from<int, sizeof...(FieldN)>::type())) {
+        return      lift_to(std::forward<Observable>(source), typename rxu::values_from<int, sizeof...(FieldN)>::type());
+    }
+};
+
+}
+
+/// collects the fields of the rows into a column_batch with one column for
+/// each field. a batch is sent when it holds count rows or when period has
+/// passed since the last batch, and batches with no rows are not sent.
+template<class Coordination, class... FieldN>
+inline auto to_columns(int count, rxsc::scheduler::clock_type::duration period, Coordination coordination, FieldN... fieldn)
+    -> typename std::enable_if<is_coordination<Coordination>::value,
+            detail::to_columns_factory<Coordination, FieldN...>>::type {
+    return  detail::to_columns_factory<Coordination, FieldN...>(count, period, std::move(coordination), fieldn...);
+}
+
+template<class Field0, class... FieldN>
+inline auto to_columns(int count, rxsc::scheduler::clock_type::duration period, Field0 field0, FieldN... fieldn)
+    -> typename std::enable_if<std::is_member_object_pointer<Field0>::value,
+            detail::to_columns_factory<identity_one_worker, Field0, FieldN...>>::type {
+    return  detail::to_columns_factory<identity_one_worker, Field0, FieldN...>(count, period, identity_current_thread(), field0, fieldn...);
+}
+
+}
+
+}
+
+#endif
@@ -13,9 +13,51 @@ namespace operators {
 
 namespace detail {
 
+// how a window is sent through its subject. a subject lets each window have
+// any number of subscribers, a unicast sends to its one subscriber directly.
+template<class Subject>
+struct window_subject;
+
+template<class T>
+struct window_subject<rxcpp::subjects::subject<T>>
+{
+    typedef rxcpp::subjects::subject<T> subject_type;
+    static observable<T> get_observable(const subject_type& s) {
+        return s.get_observable().as_dynamic();
+    }
+    static void on_next(const subject_type& s, const T& v) {
+        s.get_subscriber().on_next(v);
+    }
+    static void on_error(const subject_type& s, std::exception_ptr e) {
+        s.get_subscriber().on_error(e);
+    }
+    static void on_completed(const subject_type& s) {
+        s.get_subscriber().on_completed();
+    }
+};
+
 template<class T>
+struct window_subject<rxcpp::subjects::unicast<T>>
+{
+    typedef rxcpp::subjects::unicast<T> subject_type;
+    static observable<T> get_observable(const subject_type& s) {
+        return s.get_observable();
+    }
+    static void on_next(const subject_type& s, const T& v) {
+        s.on_next(v);
+    }
+    static void on_error(const subject_type& s, std::exception_ptr e) {
+        s.on_error(e);
+    }
+    static void on_completed(const subject_type& s) {
+        s.on_completed();
+    }
+};
+
+template<class T, class Subject = rxcpp::subjects::subject<T>>
 struct window
 {
+    typedef window_subject<Subject> window_subject_type;
     typedef rxu::decay_t<T> source_value_type;
     struct window_values
     {
@@ -45,43 +87,43 @@ struct window
         typedef observer<T, this_type> observer_type;
         dest_type dest;
         mutable int cursor;
-        mutable std::deque<rxcpp::subjects::subject<T>> subj;
+        mutable std::deque<Subject> subj;
 
         window_observer(dest_type d, window_values v)
             : window_values(v)
             , dest(std::move(d))
             , cursor(0)
         {
-            subj.push_back(rxcpp::subjects::subject<T>());
-            dest.on_next(subj[0].get_observable().as_dynamic());
+            subj.push_back(Subject());
+            dest.on_next(window_subject_type::get_observable(subj[0]));
         }
         void on_next(T v) const {
-            for (auto s : subj) {
-                s.get_subscriber().on_next(v);
+            for (auto& s : subj) {
+                window_subject_type::on_next(s, v);
             }
 
             int c = cursor - this->count + 1;
             if (c >= 0 && c % this->skip == 0) {
-                subj[0].get_subscriber().on_completed();
+                window_subject_type::on_completed(subj[0]);
                 subj.pop_front();
             }
 
             if (++cursor % this->skip == 0) {
-                subj.push_back(rxcpp::subjects::subject<T>());
-                dest.on_next(subj[subj.size() - 1].get_observable().as_dynamic());
+                subj.push_back(Subject());
+                dest.on_next(window_subject_type::get_observable(subj.back()));
             }
         }
 
         void on_error(std::exception_ptr e) const {
-            for (auto s : subj) {
-                s.get_subscriber().on_error(e);
+            for (auto& s : subj) {
+                window_subject_type::on_error(s, e);
             }
             dest.on_error(e);
         }
 
         void on_completed() const {
-            for (auto s : subj) {
-                s.get_subscriber().on_completed();
+            for (auto& s : subj) {
+                window_subject_type::on_completed(s);
             }
             dest.on_completed();
         }
@@ -6,6 +6,7 @@
 #define RXCPP_OPERATORS_RX_WINDOW_WITH_TIME_HPP
 
 #include "../rx-includes.hpp"
+#include "rx-window.hpp"
 
 namespace rxcpp {
 
@@ -13,9 +14,10 @@ namespace operators {
 
 namespace detail {
 
-template<class T, class Duration, class Coordination>
+template<class T, class Duration, class Coordination, class Subject = rxcpp::subjects::subject<T>>
 struct window_with_time
 {
+    typedef window_subject<Subject> window_subject_type;
     typedef rxu::decay_t<T> source_value_type;
     typedef rxu::decay_t<Coordination> coordination_type;
     typedef typename coordination_type::coordinator_type coordinator_type;
@@ -62,7 +64,7 @@ struct window_with_time
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::deque<rxcpp::subjects::subject<T>> subj;
+            mutable std::deque<Subject> subj;
             rxsc::scheduler::clock_type::time_point expected;
         };
         std::shared_ptr<window_with_time_subscriber_values> state;
@@ -72,12 +74,12 @@ struct window_with_time
         {
             auto localState = state;
             auto release_window = [localState](const rxsc::schedulable&) {
-                localState->subj[0].get_subscriber().on_completed();
+                window_subject_type::on_completed(localState->subj[0]);
                 localState->subj.pop_front();
             };
             auto create_window = [localState, release_window](const rxsc::schedulable&) {
-                localState->subj.push_back(rxcpp::subjects::subject<T>());
-                localState->dest.on_next(localState->subj[localState->subj.size() - 1].get_observable().as_dynamic());
+                localState->subj.push_back(Subject());
+                localState->dest.on_next(window_subject_type::get_observable(localState->subj.back()));
 
                 auto produce_at = localState->expected + localState->period;
                 localState->expected += localState->skip;
@@ -91,21 +93,21 @@ struct window_with_time
         }
 
         void on_next(T v) const {
-            for (auto s : state->subj) {
-                s.get_subscriber().on_next(v);
+            for (auto& s : state->subj) {
+                window_subject_type::on_next(s, v);
             }
         }
 
         void on_error(std::exception_ptr e) const {
-            for (auto s : state->subj) {
-                s.get_subscriber().on_error(e);
+            for (auto& s : state->subj) {
+                window_subject_type::on_error(s, e);
             }
             state->dest.on_error(e);
         }
 
         void on_completed() const {
-            for (auto s : state->subj) {
-                s.get_subscriber().on_completed();
+            for (auto& s : state->subj) {
+                window_subject_type::on_completed(s);
             }
             state->dest.on_completed();
         }
@@ -6,6 +6,7 @@
 #define RXCPP_OPERATORS_RX_WINDOW_WITH_TIME_OR_COUNT_HPP
 
 #include "../rx-includes.hpp"
+#include "rx-window.hpp"
 
 namespace rxcpp {
 
@@ -13,9 +14,10 @@ namespace operators {
 
 namespace detail {
 
-template<class T, class Duration, class Coordination>
+template<class T, class Duration, class Coordination, class Subject = rxcpp::subjects::subject<T>>
 struct window_with_time_or_count
 {
+    typedef window_subject<Subject> window_subject_type;
     typedef rxu::decay_t<T> source_value_type;
     typedef rxu::decay_t<Coordination> coordination_type;
     typedef typename coordination_type::coordinator_type coordinator_type;
@@ -65,7 +67,7 @@ struct window_with_time_or_count
             rxsc::worker worker;
             mutable int cursor;
             mutable int subj_id;
-            mutable rxcpp::subjects::subject<T> subj;
+            mutable Subject subj;
         };
         typedef std::shared_ptr<window_with_time_or_count_subscriber_values> state_type;
         state_type state;
@@ -73,7 +75,7 @@ struct window_with_time_or_count
         window_with_time_or_count_observer(dest_type d, window_with_time_or_count_values v, coordinator_type c)
             : state(std::make_shared<window_with_time_or_count_subscriber_values>(window_with_time_or_count_subscriber_values(std::move(d), std::move(v), std::move(c))))
         {
-            state->dest.on_next(state->subj.get_observable().as_dynamic());
+            state->dest.on_next(window_subject_type::get_observable(state->subj));
             auto new_id = state->subj_id;
             auto produce_time = state->worker.now() + state->period;
             auto localState = state;
@@ -86,9 +88,9 @@ struct window_with_time_or_count
             if (id != state->subj_id)
                 return;
 
-            state->subj.get_subscriber().on_completed();
-            state->subj = rxcpp::subjects::subject<T>();
-            state->dest.on_next(state->subj.get_observable().as_dynamic());
+            window_subject_type::on_completed(state->subj);
+            state->subj = Subject();
+            state->dest.on_next(window_subject_type::get_observable(state->subj));
             state->cursor = 0;
             auto new_id = ++state->subj_id;
             auto produce_time = expected + state->period;
@@ -99,19 +101,19 @@ struct window_with_time_or_count
         }
 
         void on_next(T v) const {
-            state->subj.get_subscriber().on_next(v);
+            window_subject_type::on_next(state->subj, v);
             if (++state->cursor == state->count) {
                 release_window(state->subj_id, state->worker.now(), state);
             }
         }
 
         void on_error(std::exception_ptr e) const {
-            state->subj.get_subscriber().on_error(e);
+            window_subject_type::on_error(state->subj, e);
             state->dest.on_error(e);
         }
 
         void on_completed() const {
-            state->subj.get_subscriber().on_completed();
+            window_subject_type::on_completed(state->subj);
             state->dest.on_completed();
         }
 
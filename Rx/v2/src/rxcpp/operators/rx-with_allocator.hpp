@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_OPERATORS_RX_WITH_ALLOCATOR_HPP)
+#define RXCPP_OPERATORS_RX_WITH_ALLOCATOR_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class T, class SourceOperator>
+struct with_allocator : public operator_base<T>
+{
+    typedef rxu::decay_t<SourceOperator> source_operator_type;
+    source_operator_type source;
+    arena allocator;
+
+    with_allocator(source_operator_type s, arena a)
+        : source(std::move(s))
+        , allocator(std::move(a))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        // the operators allocate their state while they are subscribed
+        rxcpp::detail::arena_scope scope(allocator.get_state().get());
+        source.on_subscribe(std::move(o));
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
@@ -16,7 +16,8 @@ namespace detail {
 template<class Coordination, class Selector, class... ObservableN>
 struct zip_traits {
     typedef std::tuple<ObservableN...> tuple_source_type;
-    typedef std::tuple<std::list<typename ObservableN::value_type>...> tuple_source_values_type;
+    // the values that are waiting for a value from each of the other sources
+    typedef std::tuple<rxu::detail::ring_queue<typename ObservableN::value_type>...> tuple_source_values_type;
 
     typedef rxu::decay_t<Selector> selector_type;
     typedef rxu::decay_t<Coordination> coordination_type;
@@ -45,7 +46,8 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
     typedef typename traits::selector_type selector_type;
 
     typedef typename traits::coordination_type coordination_type;
-    typedef typename coordination_type::coordinator_type coordinator_type;
+    // zip only calls in and out, so identity needs no worker
+    typedef typename rxcpp::detail::in_out_coordinator<coordination_type>::type coordinator_type;
 
     struct values
     {
@@ -93,7 +95,7 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
         // on_next
             [state](source_value_type st) {
                 auto& values = std::get<Index>(state->pending);
-                values.push_back(st);
+                values.push_back(std::move(st));
                 if (rxu::apply_to_each(state->pending, rxu::list_not_empty(), rxu::all_values_true())) {
                     auto selectedResult = rxu::apply_to_each(state->pending, rxu::extract_list_front(), state->selector);
                     state->out.on_next(selectedResult);
@@ -152,10 +154,10 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
             output_type out;
         };
 
-        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+        auto coordinator = rxcpp::detail::in_out_coordinator<coordination_type>::create(initial.coordination, scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<zip_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxcpp::detail::allocate_state<zip_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         subscribe_all(state, typename rxu::values_from<int, sizeof...(ObservableN)>::type());
     }
@@ -193,6 +195,91 @@ public:
     }
 };
 
+// chooses the form of zip from the arguments that are passed to the
+// observable member. the first argument may be a coordination, then a
+// selector, then the observables.
+template<class Source, class Coordination, class TS, class C = rxu::types_checked>
+struct select_zip_cn : public std::false_type {
+    typedef void observable_type;
+    template<class T0, class... TN>
+    void operator()(const Source&, Coordination, T0, TN...) const {
+        static_assert(rxu::all_true<is_observable<T0>::value, is_observable<TN>::value...>::value, "after the coordination, zip takes a selector and observables or only observables");
+    }
+};
+
+template<class Source, class Coordination, class T0, class... TN>
+struct select_zip_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Coordination::coordination_tag, typename T0::observable_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef zip<Coordination, rxu::detail::pack, Source, T0, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Coordination cn, ObservableN... on) const {
+        return observable_type(operator_type(std::move(cn), rxu::pack(), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class Coordination, class T0, class... TN>
+struct select_zip_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<T0(typename Source::value_type, typename TN::value_type...)>::type, typename Coordination::coordination_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef zip<Coordination, T0, Source, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Coordination cn, T0 t0, ObservableN... on) const {
+        return observable_type(operator_type(std::move(cn), std::move(t0), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class TS, class C = rxu::types_checked>
+struct select_zip : public std::false_type {
+    typedef void observable_type;
+    template<class T0, class T1, class... TN>
+    void operator()(const Source&, T0, T1, TN...) const {
+        static_assert(is_coordination<T0>::value ||
+            is_observable<T0>::value ||
+            std::is_convertible<T0, std::function<void(typename T1::value_type, typename TN::value_type...)>>::value
+            , "T0 must be selector, coordination or observable");
+        static_assert(is_observable<T1>::value  ||
+            std::is_convertible<T1, std::function<void(typename TN::value_type...)>>::value, "T1 must be selector or observable");
+        static_assert(rxu::all_true<true, is_observable<TN>::value...>::value, "TN... must be observable");
+    }
+    template<class T0>
+    void operator()(const Source&, T0) const {
+        static_assert(is_observable<T0>::value, "T0 must be observable");
+    }
+};
+
+template<class Source, class T0, class T1, class... TN>
+struct select_zip<Source, rxu::types<T0, T1, TN...>, typename rxu::types_checked_from<typename T0::coordination_tag>::type>
+    : public select_zip_cn<Source, T0, rxu::types<T1, TN...>>
+{
+};
+
+template<class Source, class Selector, class... TN>
+struct select_zip<Source, rxu::types<Selector, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<Selector(typename Source::value_type, typename TN::value_type...)>::type, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef zip<identity_one_worker, Selector, Source, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, Selector sel, ObservableN... on) const {
+        return observable_type(operator_type(identity_current_thread(), std::move(sel), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
+template<class Source, class T0, class... TN>
+struct select_zip<Source, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename T0::observable_tag, typename TN::observable_tag...>::type>
+    : public std::true_type
+{
+    typedef zip<identity_one_worker, rxu::detail::pack, Source, T0, TN...> operator_type;
+    typedef observable<typename operator_type::value_type, operator_type> observable_type;
+    template<class... ObservableN>
+    observable_type operator()(const Source& src, ObservableN... on) const {
+        return observable_type(operator_type(identity_current_thread(), rxu::pack(), std::make_tuple(src, std::move(on)...)));
+    }
+};
+
 }
 
 template<class Coordination, class Selector, class... ObservableN>
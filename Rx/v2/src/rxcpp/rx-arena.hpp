@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_ARENA_HPP)
+#define RXCPP_RX_ARENA_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace detail {
+
+// hands out memory from large blocks and frees the blocks all at once when
+// the last allocation that refers to them is gone.
+struct arena_state : public std::enable_shared_from_this<arena_state>
+{
+    explicit arena_state(size_t bs)
+        : block_size((std::max)(bs, size_t(256)))
+        , cursor(nullptr)
+        , remaining(0)
+        , allocated(0)
+        , reserved(0)
+    {
+    }
+    ~arena_state()
+    {
+        for (auto b : blocks) {
+            ::operator delete(b);
+        }
+    }
+
+    void* allocate(size_t size, size_t align) {
+        std::unique_lock<rxu::detail::spin_lock> guard(lock);
+        auto skip = (align - reinterpret_cast<size_t>(cursor) % align) % align;
+        if (remaining < size + skip) {
+            auto bytes = (std::max)(block_size, size + align);
+            blocks.push_back(::operator new(bytes));
+            cursor = static_cast<char*>(blocks.back());
+            remaining = bytes;
+            reserved += bytes;
+            skip = (align - reinterpret_cast<size_t>(cursor) % align) % align;
+        }
+        auto result = cursor + skip;
+        cursor += skip + size;
+        remaining -= skip + size;
+        allocated += size;
+        return result;
+    }
+
+    // the thread is subscribing or delivering for a pipeline that allocates
+    // from this arena
+    static arena_state*& current() {
+        static RXCPP_THREAD_LOCAL arena_state* state;
+        return state;
+    }
+
+    size_t block_size;
+    rxu::detail::spin_lock lock;
+    std::vector<void*> blocks;
+    char* cursor;
+    size_t remaining;
+    size_t allocated;
+    size_t reserved;
+};
+
+}
+
+/// arena is a pipeline level allocator. the state that a pipeline creates
+/// while it is subscribed with observable.with_allocator(arena) is taken from
+/// the arena. memory is not returned piece by piece, the whole arena is freed
+/// when the arena and all the state allocated from it are gone.
+/// copies refer to the same arena.
+class arena
+{
+    std::shared_ptr<detail::arena_state> state;
+
+public:
+    enum { default_block_size = 64 * 1024 };
+
+    explicit arena(size_t block_size = default_block_size)
+        : state(std::make_shared<detail::arena_state>(block_size))
+    {
+    }
+
+    /// bytes handed out
+    size_t allocated() const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        return state->allocated;
+    }
+    /// bytes taken from the global heap
+    size_t reserved() const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        return state->reserved;
+    }
+
+    const std::shared_ptr<detail::arena_state>& get_state() const {
+        return state;
+    }
+};
+
+namespace detail {
+
+// a std allocator that takes memory from an arena, or from the global heap
+// when there is no arena
+template<class T>
+struct arena_allocator
+{
+    typedef T value_type;
+
+    explicit arena_allocator(std::shared_ptr<arena_state> s)
+        : state(std::move(s))
+    {
+    }
+    template<class U>
+    arena_allocator(const arena_allocator<U>& o)
+        : state(o.state)
+    {
+    }
+
+    T* allocate(size_t n) {
+        if (!state) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(state->allocate(n * sizeof(T), std::alignment_of<T>::value));
+    }
+    void deallocate(T* p, size_t) {
+        if (!state) {
+            ::operator delete(p);
+        }
+        // the arena frees its blocks when it is destroyed
+    }
+
+    template<class U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    std::shared_ptr<arena_state> state;
+};
+template<class T, class U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.state == rhs.state;
+}
+template<class T, class U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+// makes the arena current on this thread until the scope ends
+class arena_scope
+{
+    arena_state* previous;
+    arena_scope(const arena_scope&);
+    arena_scope& operator=(const arena_scope&);
+
+public:
+    explicit arena_scope(arena_state* s)
+        : previous(arena_state::current())
+    {
+        arena_state::current() = s;
+    }
+    ~arena_scope()
+    {
+        arena_state::current() = previous;
+    }
+};
+
+// the arena that is current on this thread, if any
+inline std::shared_ptr<arena_state> current_arena() {
+    auto s = arena_state::current();
+    return !!s ? s->shared_from_this() : std::shared_ptr<arena_state>();
+}
+
+// make_shared from the current arena, or from the global heap when no
+// arena is current
+template<class T, class... AN>
+std::shared_ptr<T> allocate_state(AN&&... an) {
+    auto s = arena_state::current();
+    if (!s) {
+        return std::make_shared<T>(std::forward<AN>(an)...);
+    }
+    return std::allocate_shared<T>(arena_allocator<T>(s->shared_from_this()), std::forward<AN>(an)...);
+}
+
+}
+
+}
+
+#endif
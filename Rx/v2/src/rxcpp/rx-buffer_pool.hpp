@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_BUFFER_POOL_HPP)
+#define RXCPP_RX_BUFFER_POOL_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// buffer is a block of bytes that is shared by reference. a producer writes
+/// into data() and then sends slices of it with sub(). the block is freed, or
+/// returned to its buffer_pool, when the buffer and all of its slices are gone.
+class buffer
+{
+    std::shared_ptr<char> bytes;
+    size_t length;
+
+public:
+    buffer()
+        : length(0)
+    {
+    }
+    /// a block of capacity bytes that does not belong to a pool
+    explicit buffer(size_t capacity)
+        : bytes(new char[capacity], std::default_delete<char[]>())
+        , length(capacity)
+    {
+    }
+    buffer(std::shared_ptr<char> b, size_t capacity)
+        : bytes(std::move(b))
+        , length(capacity)
+    {
+    }
+
+    char* data() const {
+        return bytes.get();
+    }
+    size_t capacity() const {
+        return length;
+    }
+    bool empty() const {
+        return !bytes;
+    }
+
+    /// the count bytes from offset, which keep the block alive
+    slice sub(size_t offset, size_t count = slice::npos) const {
+        offset = (std::min)(offset, length);
+        count = (std::min)(count, length - offset);
+        return slice(bytes, bytes.get() + offset, count);
+    }
+};
+
+/// buffer_pool hands out buffers of block_size bytes and keeps the blocks
+/// that are released so that the next take() does not allocate them. at most
+/// limit blocks are kept, the rest are freed. copies refer to the same pool.
+/// blocks that are released after the last copy of the pool is gone are
+/// freed.
+class buffer_pool
+{
+    struct state_type
+    {
+        state_type(size_t b, size_t l)
+            : block_size(b)
+            , limit(l)
+        {
+        }
+        ~state_type()
+        {
+            for (auto block : blocks) {
+                delete[] block;
+            }
+        }
+        size_t block_size;
+        size_t limit;
+        rxu::detail::spin_lock lock;
+        std::vector<char*> blocks;
+    };
+    std::shared_ptr<state_type> state;
+
+    struct recycle
+    {
+        std::weak_ptr<state_type> pool;
+        void operator()(char* block) const {
+            auto s = pool.lock();
+            if (!!s) {
+                std::unique_lock<rxu::detail::spin_lock> guard(s->lock);
+                if (s->blocks.size() < s->limit) {
+                    s->blocks.push_back(block);
+                    return;
+                }
+            }
+            delete[] block;
+        }
+    };
+
+public:
+    /// a pool of blocks of block_size bytes that keeps at most limit blocks
+    explicit buffer_pool(size_t block_size, size_t limit = 64)
+        : state(std::make_shared<state_type>((std::max)(block_size, size_t(1)), limit))
+    {
+    }
+
+    size_t block_size() const {
+        return state->block_size;
+    }
+
+    /// blocks that are waiting to be reused
+    size_t size() const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        return state->blocks.size();
+    }
+
+    /// a buffer of block_size bytes. the bytes are not cleared.
+    buffer take() const {
+        char* block = nullptr;
+        {
+            std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+            if (!state->blocks.empty()) {
+                block = state->blocks.back();
+                state->blocks.pop_back();
+            }
+        }
+        if (!block) {
+            block = new char[state->block_size];
+        }
+        recycle r;
+        r.pool = state;
+        return buffer(std::shared_ptr<char>(block, std::move(r)), state->block_size);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_CANCELLATION_HPP)
+#define RXCPP_RX_CANCELLATION_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace detail {
+
+/// an entry in the intrusive list of a cancellation_source. the entry owns
+/// itself while it is linked, so that neither the list nor the owner of the
+/// registration has to.
+struct cancellation_node
+{
+    cancellation_node()
+        : prev(nullptr)
+        , next(nullptr)
+    {
+    }
+    virtual ~cancellation_node()
+    {
+    }
+    /// called once, on the thread that cancels
+    virtual void on_cancel() = 0;
+
+    cancellation_node* prev;
+    cancellation_node* next;
+    std::shared_ptr<cancellation_node> self;
+};
+
+struct cancellation_state
+{
+    cancellation_state()
+        : head(nullptr)
+        , cancelled(false)
+    {
+    }
+
+    std::mutex lock;
+    cancellation_node* head;
+    std::atomic<bool> cancelled;
+
+    // false when already cancelled
+    bool link(std::shared_ptr<cancellation_node> node) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        auto n = node.get();
+        n->self = std::move(node);
+        n->next = head;
+        if (!!head) {
+            head->prev = n;
+        }
+        head = n;
+        return true;
+    }
+
+    void unlink(cancellation_node* n) {
+        // released after the lock
+        std::shared_ptr<cancellation_node> release;
+        std::unique_lock<std::mutex> guard(lock);
+        if (cancelled.load(std::memory_order_relaxed) || !n->self) {
+            // the cancel owns the list now
+            return;
+        }
+        if (!!n->prev) {
+            n->prev->next = n->next;
+        } else {
+            head = n->next;
+        }
+        if (!!n->next) {
+            n->next->prev = n->prev;
+        }
+        n->prev = n->next = nullptr;
+        release = std::move(n->self);
+    }
+
+    void cancel() {
+        cancellation_node* n = nullptr;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (cancelled.load(std::memory_order_relaxed)) {
+                return;
+            }
+            cancelled.store(true, std::memory_order_release);
+            n = head;
+            head = nullptr;
+        }
+        // one walk of the list that was detached, without the lock
+        while (!!n) {
+            auto keepAlive = std::move(n->self);
+            auto next = n->next;
+            n->on_cancel();
+            n = next;
+        }
+    }
+};
+
+template<class F>
+struct cancellation_callback : public cancellation_node
+{
+    explicit cancellation_callback(F f)
+        : f(std::move(f))
+    {
+    }
+    virtual void on_cancel() {
+        f();
+    }
+    F f;
+};
+
+}
+
+/// the side of a cancellation_source that registers. copies refer to the
+/// same source.
+class cancellation_token
+{
+    std::shared_ptr<detail::cancellation_state> state;
+
+public:
+    explicit cancellation_token(std::shared_ptr<detail::cancellation_state> st)
+        : state(std::move(st))
+    {
+    }
+
+    bool is_cancelled() const {
+        return state->cancelled.load(std::memory_order_acquire);
+    }
+
+    /// links node into the list of the source and unlinks it when lifetime
+    /// is unsubscribed. the node is called at once when the source is already
+    /// cancelled.
+    void add(const composite_subscription& lifetime, std::shared_ptr<detail::cancellation_node> node) const {
+        auto n = node.get();
+        if (!state->link(node)) {
+            node->on_cancel();
+            return;
+        }
+        auto st = state;
+        lifetime.add([st, n](){
+            st->unlink(n);
+        });
+    }
+
+    /// unsubscribes lifetime when the source is cancelled
+    void add(const composite_subscription& lifetime) const {
+        auto target = lifetime;
+        auto cancel = [target](){
+            target.unsubscribe();
+        };
+        add(lifetime, std::make_shared<detail::cancellation_callback<decltype(cancel)>>(std::move(cancel)));
+    }
+};
+
+/// cancels many subscriptions at once. each registration is an entry in an
+/// intrusive list that unlinks itself when its subscription ends, and cancel()
+/// walks the list once. a subject used as the trigger of take_until has an
+/// observer for each subscription instead, and sends to each of them.
+/// copies refer to the same source.
+class cancellation_source
+{
+    std::shared_ptr<detail::cancellation_state> state;
+
+public:
+    cancellation_source()
+        : state(std::make_shared<detail::cancellation_state>())
+    {
+    }
+
+    cancellation_token get_token() const {
+        return cancellation_token(state);
+    }
+
+    bool is_cancelled() const {
+        return state->cancelled.load(std::memory_order_acquire);
+    }
+
+    /// calls each registration once, on this thread. later registrations are
+    /// called as they are added.
+    void cancel() const {
+        state->cancel();
+    }
+};
+
+}
+
+#endif
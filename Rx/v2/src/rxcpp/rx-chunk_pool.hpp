@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_CHUNK_POOL_HPP)
+#define RXCPP_RX_CHUNK_POOL_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// chunk_pool keeps the vectors that a consumer is done with so that the
+/// buffer operators can reuse their capacity for the next chunk.
+///
+/// the buffer operators take() each new chunk from the pool. the consumer
+/// passes each chunk back to recycle() when it is done with it. a chunk that
+/// is not recycled is simply freed. the chunks that an operator has started
+/// and not emitted when its subscription ends, by unsubscribe or on_error,
+/// are recycled by the operator. copies refer to the same pool.
+///
+/// a default constructed pool keeps nothing, take() always returns a new
+/// vector.
+template<class T>
+class chunk_pool
+{
+public:
+    typedef std::vector<T> chunk_type;
+
+private:
+    struct state_type
+    {
+        explicit state_type(size_t m)
+            : limit(m)
+        {
+        }
+        size_t limit;
+        rxu::detail::spin_lock lock;
+        std::vector<chunk_type> chunks;
+    };
+    std::shared_ptr<state_type> state;
+
+public:
+    /// a pool that keeps nothing
+    chunk_pool()
+    {
+    }
+    /// a pool that keeps at most limit chunks
+    explicit chunk_pool(size_t limit)
+        : state(std::make_shared<state_type>(limit))
+    {
+    }
+
+    /// chunks that are waiting to be reused
+    size_t size() const {
+        if (!state) {
+            return 0;
+        }
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        return state->chunks.size();
+    }
+
+    /// an empty chunk with room for at least reserve values
+    chunk_type take(size_t reserve = 0) const {
+        chunk_type result;
+        if (!!state) {
+            std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+            if (!state->chunks.empty()) {
+                using std::swap;
+                swap(result, state->chunks.back());
+                state->chunks.pop_back();
+            }
+        }
+        result.reserve(reserve);
+        return result;
+    }
+
+    /// keep the capacity of a chunk that is no longer used
+    void recycle(chunk_type chunk) const {
+        if (!state || chunk.capacity() == 0) {
+            return;
+        }
+        chunk.clear();
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        if (state->chunks.size() < state->limit) {
+            state->chunks.push_back(std::move(chunk));
+        }
+    }
+};
+
+namespace detail {
+
+// the chunks that an operator has taken from a pool and not yet emitted.
+// the chunks that are still here when the operator is destroyed go back to
+// the pool.
+template<class T>
+struct pooled_chunks : public std::deque<std::vector<T>>
+{
+    typedef std::deque<std::vector<T>> base_type;
+
+    explicit pooled_chunks(chunk_pool<T> p)
+        : pool(std::move(p))
+    {
+    }
+    pooled_chunks(const pooled_chunks& o)
+        : base_type(o)
+        , pool(o.pool)
+    {
+    }
+    pooled_chunks(pooled_chunks&& o)
+        : base_type(std::move(static_cast<base_type&>(o)))
+        , pool(std::move(o.pool))
+    {
+    }
+    ~pooled_chunks()
+    {
+        for (auto& chunk : *this) {
+            pool.recycle(std::move(chunk));
+        }
+    }
+
+    chunk_pool<T> pool;
+
+private:
+    pooled_chunks& operator=(const pooled_chunks&);
+};
+
+}
+
+}
+
+#endif
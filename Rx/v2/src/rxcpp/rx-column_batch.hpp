@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_COLUMN_BATCH_HPP)
+#define RXCPP_RX_COLUMN_BATCH_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// column_batch holds a batch of rows as one contiguous vector for each
+/// field. the to_columns operator scatters the fields of each row into the
+/// columns as the rows arrive.
+///
+/// each column is a std::vector, so column<I>().data() can be handed to a
+/// columnar writer without a copy, and release<I>() moves the column out of
+/// the batch.
+template<class... ColumnN>
+class column_batch
+{
+public:
+    typedef std::tuple<std::vector<ColumnN>...> columns_type;
+
+    enum { column_count = sizeof...(ColumnN) };
+
+    template<size_t Index>
+    struct column_type
+    {
+        typedef typename std::tuple_element<Index, columns_type>::type type;
+    };
+
+private:
+    columns_type columns;
+    size_t rows;
+
+    template<int... IndexN>
+    void reserve(size_t count, rxu::values<int, IndexN...>) {
+        int expanded[] = {0, (std::get<IndexN>(columns).reserve(count), 0)...};
+        (void)expanded;
+    }
+
+public:
+    column_batch()
+        : rows(0)
+    {
+    }
+    /// an empty batch with room in each column for count rows
+    explicit column_batch(size_t count)
+        : rows(0)
+    {
+        reserve(count, typename rxu::values_from<int, sizeof...(ColumnN)>::type());
+    }
+
+    /// the number of rows in each column
+    size_t size() const {
+        return rows;
+    }
+    bool empty() const {
+        return rows == 0;
+    }
+
+    template<size_t Index>
+    const typename column_type<Index>::type& column() const {
+        return std::get<Index>(columns);
+    }
+    template<size_t Index>
+    typename column_type<Index>::type& column() {
+        return std::get<Index>(columns);
+    }
+    const columns_type& get_columns() const {
+        return columns;
+    }
+
+    /// moves a column out of the batch, the batch keeps an empty column in
+    /// its place
+    template<size_t Index>
+    typename column_type<Index>::type release() {
+        typename column_type<Index>::type result;
+        using std::swap;
+        swap(result, std::get<Index>(columns));
+        return result;
+    }
+
+    /// appends one value to each column
+    void push_back(ColumnN... valueN) {
+        push_back(typename rxu::values_from<int, sizeof...(ColumnN)>::type(), std::move(valueN)...);
+    }
+
+    /// the number of rows, used by push_back and by code that writes into
+    /// the columns directly
+    void set_size(size_t count) {
+        rows = count;
+    }
+
+private:
+    template<int... IndexN>
+    void push_back(rxu::values<int, IndexN...>, ColumnN... valueN) {
+        int expanded[] = {0, (std::get<IndexN>(columns).push_back(std::move(valueN)), 0)...};
+        (void)expanded;
+        ++rows;
+    }
+};
+
+}
+
+#endif
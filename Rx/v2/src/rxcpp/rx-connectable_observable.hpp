@@ -140,7 +140,7 @@ public:
         return *this;
     }
 
-    composite_subscription connect(composite_subscription cs = composite_subscription()) {
+    composite_subscription connect(composite_subscription cs = composite_subscription()) const {
         base_type::source_operator.on_connect(cs);
         return cs;
     }
@@ -157,6 +157,19 @@ public:
                                 rxo::detail::ref_count<T, this_type>(*this));
     }
 
+    /// ref_count ->
+    /// like ref_count(), except that the connection is kept for grace after
+    /// the last unsubscribe. a subscriber that arrives within grace shares the
+    /// connection, so subscribers that come and go do not reconnect the
+    /// source each time. the disconnect is scheduled on cn.
+    ///
+    template<class Coordination>
+    auto ref_count(rxsc::scheduler::clock_type::duration grace, Coordination cn) const
+        ->      observable<T,   rxo::detail::ref_count<T, this_type, Coordination>> {
+        return  observable<T,   rxo::detail::ref_count<T, this_type, Coordination>>(
+                                rxo::detail::ref_count<T, this_type, Coordination>(*this, grace, std::move(cn)));
+    }
+
     /// connect_forever ->
     /// takes a connectable_observable source and calls connect during
     /// the construction of the expression. This means that the source
@@ -170,6 +183,47 @@ public:
     }
 };
 
+namespace detail {
+
+// a feed ends the lifetime that it was connected with when it completes or
+// fails, so each feed is connected with a lifetime of its own inside cs.
+template<class Connectable>
+void connect_nested(const composite_subscription& cs, const Connectable& c) {
+    composite_subscription child;
+    cs.add(child);
+    c.connect(child);
+}
+
+}
+
+/// connect_all ->
+/// connects each of the connectable observables in one pass. each connect is
+/// made through the type of its feed, so a feed that was not made dynamic is
+/// connected without a std::function. a feed that ends does not disconnect
+/// the others. the returned subscription disconnects all of them.
+///
+template<class... ConnectableN>
+composite_subscription connect_all(composite_subscription cs, const ConnectableN&... cn) {
+    static_assert(rxu::all_true<true, is_connectable_observable<ConnectableN>::value...>::value, "connect_all must be passed connectable observables");
+    int connected[] = {0, (detail::connect_nested(cs, cn), 0)...};
+    (void)connected;
+    return cs;
+}
+
+/// the feeds of one type that were made in a loop
+template<class T, class SourceOperator>
+composite_subscription connect_all(composite_subscription cs, const std::vector<connectable_observable<T, SourceOperator>>& feeds) {
+    for (auto& feed : feeds) {
+        detail::connect_nested(cs, feed);
+    }
+    return cs;
+}
+
+template<class Connectable0, class... ConnectableN>
+auto connect_all(const Connectable0& c0, const ConnectableN&... cn)
+    -> typename std::enable_if<is_connectable_observable<Connectable0>::value, composite_subscription>::type {
+    return connect_all(composite_subscription(), c0, cn...);
+}
 
 }
 
@@ -70,7 +70,8 @@ public:
 
     coordinator(Input i) : input(i) {}
 
-    rxsc::worker get_worker() const {
+    auto get_worker() const
+        -> decltype((*(input_type*)nullptr).get_worker()) {
         return input.get_worker();
     }
     rxsc::scheduler get_scheduler() const {
@@ -99,21 +100,27 @@ public:
     }
 };
 
-class identity_one_worker : public coordination_base
+/// runs the actions on a worker of Scheduler. when Scheduler is a
+/// typed_scheduler the coordinator worker is a typed_worker, so the
+/// operators schedule on it without a virtual call.
+template<class Scheduler>
+class basic_identity_one_worker : public coordination_base
 {
-    rxsc::scheduler factory;
+    typedef typename Scheduler::worker_type worker_type;
+
+    Scheduler factory;
 
     class input_type
     {
-        rxsc::worker controller;
+        worker_type controller;
         rxsc::scheduler factory;
     public:
-        explicit input_type(rxsc::worker w)
+        explicit input_type(worker_type w)
             : controller(w)
             , factory(rxsc::make_same_worker(w))
         {
         }
-        inline rxsc::worker get_worker() const {
+        inline const worker_type& get_worker() const {
             return controller;
         }
         inline rxsc::scheduler get_scheduler() const {
@@ -141,10 +148,14 @@ class identity_one_worker : public coordination_base
 
 public:
 
-    explicit identity_one_worker(rxsc::scheduler sc) : factory(sc) {}
+    explicit basic_identity_one_worker(Scheduler sc) : factory(sc) {}
 
     typedef coordinator<input_type> coordinator_type;
 
+    inline const Scheduler& get_scheduler() const {
+        return factory;
+    }
+
     inline rxsc::scheduler::clock_type::time_point now() const {
         return factory.now();
     }
@@ -155,6 +166,8 @@ public:
     }
 };
 
+typedef basic_identity_one_worker<rxsc::scheduler> identity_one_worker;
+
 inline identity_one_worker identity_immediate() {
     static identity_one_worker r(rxsc::make_immediate());
     return r;
@@ -165,6 +178,71 @@ inline identity_one_worker identity_current_thread() {
     return r;
 }
 
+typedef basic_identity_one_worker<rxsc::typed_scheduler<rxsc::immediate>> identity_typed_immediate_worker;
+
+inline identity_typed_immediate_worker identity_typed_immediate() {
+    static identity_typed_immediate_worker r(rxsc::make_typed_immediate());
+    return r;
+}
+
+typedef basic_identity_one_worker<rxsc::typed_scheduler<rxsc::current_thread>> identity_typed_current_thread_worker;
+
+inline identity_typed_current_thread_worker identity_typed_current_thread() {
+    static identity_typed_current_thread_worker r(rxsc::make_typed_current_thread());
+    return r;
+}
+
+namespace detail {
+
+template<class Coordination>
+struct is_identity_coordination : public std::false_type {};
+
+template<class Scheduler>
+struct is_identity_coordination<basic_identity_one_worker<Scheduler>> : public std::true_type {};
+
+// the in, out and act of an identity coordination return their argument,
+// so it stands in for the coordinator of an operator that calls only those.
+struct identity_pass_coordinator
+{
+    template<class Observable>
+    Observable in(Observable o) const {
+        return o;
+    }
+    template<class Subscriber>
+    Subscriber out(Subscriber s) const {
+        return s;
+    }
+    template<class F>
+    F act(F f) const {
+        return f;
+    }
+};
+
+// the coordinator of an operator that only calls in, out and act. an
+// identity coordination creates no worker.
+template<class Coordination, bool Identity = is_identity_coordination<rxu::decay_t<Coordination>>::value>
+struct in_out_coordinator
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type type;
+
+    static type create(const coordination_type& cn, composite_subscription cs) {
+        return cn.create_coordinator(std::move(cs));
+    }
+};
+template<class Coordination>
+struct in_out_coordinator<Coordination, true>
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef identity_pass_coordinator type;
+
+    static type create(const coordination_type&, const composite_subscription&) {
+        return type();
+    }
+};
+
+}
+
 class serialize_one_worker : public coordination_base
 {
     rxsc::scheduler factory;
@@ -270,6 +348,10 @@ public:
 
     typedef coordinator<input_type> coordinator_type;
 
+    inline const rxsc::scheduler& get_scheduler() const {
+        return factory;
+    }
+
     inline rxsc::scheduler::clock_type::time_point now() const {
         return factory.now();
     }
@@ -291,6 +373,235 @@ inline serialize_one_worker serialize_new_thread() {
     return r;
 }
 
+inline serialize_one_worker serialize_work_stealing_pool() {
+    static serialize_one_worker r(rxsc::make_work_stealing_pool());
+    return r;
+}
+
+/// serializes like serialize_one_worker without a lock. the caller that finds
+/// no call in progress makes its call and then makes, on behalf of the other
+/// callers, the calls that they queued in the meantime. a call is only queued
+/// when another thread is mid-call, and the caller that queued it returns
+/// without waiting for it.
+class serialize_drain_one_worker : public coordination_base
+{
+    rxsc::scheduler factory;
+
+    struct drain_state
+    {
+        drain_state()
+            : wip(0)
+        {
+        }
+
+        // the number of calls that have not been made. the caller that moves
+        // it from 0 makes calls until it returns to 0.
+        std::atomic<size_t> wip;
+        rxsc::detail::mpsc_queue<std::function<void()>> queue;
+
+        // a call that throws does not end the drain: the other calls are
+        // still made so that wip returns to 0, then the first exception is
+        // rethrown to the caller that was draining.
+        void drain(std::exception_ptr ex) {
+            std::function<void()> call;
+            size_t missed = 1;
+            for (;;) {
+                while (!queue.empty()) {
+                    if (!queue.pop(call)) {
+                        // a producer is between claiming and linking its node
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    try {
+                        call();
+                    } catch(...) {
+                        if (!ex) {
+                            ex = std::current_exception();
+                        }
+                    }
+                    call = nullptr;
+                }
+                missed = wip.fetch_sub(missed) - missed;
+                if (missed == 0) {
+                    if (ex) {
+                        std::rethrow_exception(ex);
+                    }
+                    return;
+                }
+            }
+        }
+
+        template<class Direct, class Make>
+        void deliver(Direct direct, Make make) {
+            size_t idle = 0;
+            if (wip.compare_exchange_strong(idle, 1)) {
+                std::exception_ptr ex;
+                try {
+                    direct();
+                } catch(...) {
+                    ex = std::current_exception();
+                }
+                drain(ex);
+                return;
+            }
+            queue.push(make());
+            if (wip++ == 0) {
+                drain(std::exception_ptr());
+            }
+        }
+    };
+
+    template<class F>
+    struct serialize_action
+    {
+        F dest;
+        std::shared_ptr<drain_state> state;
+        serialize_action(F d, std::shared_ptr<drain_state> s)
+            : dest(std::move(d))
+            , state(std::move(s))
+        {
+            if (!state) {
+                abort();
+            }
+        }
+        void operator()(const rxsc::schedulable& scbl) const {
+            auto& d = dest;
+            state->deliver(
+                [&](){d(scbl);},
+                [&](){
+                    return std::function<void()>([d, scbl](){
+                        // a queued action runs on the thread that drains, so it
+                        // is not allowed to tail-recurse. a request to recurse
+                        // schedules it again on its worker instead.
+                        rxsc::recursion r(false);
+                        auto scope = scbl.set_recursed(r.get_recurse());
+                        r.get_recurse().reset();
+                        d(scbl);
+                        if (r.get_recurse().is_requested()) {
+                            scbl.schedule();
+                        }
+                    });
+                });
+        }
+    };
+
+    template<class Observer>
+    struct serialize_observer
+    {
+        typedef serialize_observer<Observer> this_type;
+        typedef rxu::decay_t<Observer> dest_type;
+        typedef typename dest_type::value_type value_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        std::shared_ptr<drain_state> state;
+
+        serialize_observer(dest_type d, std::shared_ptr<drain_state> s)
+            : dest(std::move(d))
+            , state(std::move(s))
+        {
+            if (!state) {
+                abort();
+            }
+        }
+        void on_next(value_type v) const {
+            auto& d = dest;
+            state->deliver(
+                [&](){d.on_next(std::move(v));},
+                [&](){return std::function<void()>([d, v](){d.on_next(v);});});
+        }
+        void on_error(std::exception_ptr e) const {
+            auto& d = dest;
+            state->deliver(
+                [&](){d.on_error(e);},
+                [&](){return std::function<void()>([d, e](){d.on_error(e);});});
+        }
+        void on_completed() const {
+            auto& d = dest;
+            state->deliver(
+                [&](){d.on_completed();},
+                [&](){return std::function<void()>([d](){d.on_completed();});});
+        }
+
+        template<class Subscriber>
+        static subscriber<value_type, observer_type> make(const Subscriber& s, std::shared_ptr<drain_state> st) {
+            return make_subscriber<value_type>(s, observer_type(this_type(s.get_observer(), std::move(st))));
+        }
+    };
+
+    class input_type
+    {
+        rxsc::worker controller;
+        rxsc::scheduler factory;
+        std::shared_ptr<drain_state> state;
+    public:
+        explicit input_type(rxsc::worker w, std::shared_ptr<drain_state> s)
+            : controller(w)
+            , factory(rxsc::make_same_worker(w))
+            , state(std::move(s))
+        {
+        }
+        inline rxsc::worker get_worker() const {
+            return controller;
+        }
+        inline rxsc::scheduler get_scheduler() const {
+            return factory;
+        }
+        inline rxsc::scheduler::clock_type::time_point now() const {
+            return factory.now();
+        }
+        template<class Observable>
+        auto in(Observable o) const
+            -> Observable {
+            return o;
+        }
+        template<class Subscriber>
+        auto out(const Subscriber& s) const
+            -> decltype(serialize_observer<decltype(s.get_observer())>::make(s, state)) {
+            return      serialize_observer<decltype(s.get_observer())>::make(s, state);
+        }
+        template<class F>
+        auto act(F f) const
+            ->      serialize_action<F> {
+            return  serialize_action<F>(std::move(f), state);
+        }
+    };
+
+public:
+
+    explicit serialize_drain_one_worker(rxsc::scheduler sc) : factory(sc) {}
+
+    typedef coordinator<input_type> coordinator_type;
+
+    inline const rxsc::scheduler& get_scheduler() const {
+        return factory;
+    }
+
+    inline rxsc::scheduler::clock_type::time_point now() const {
+        return factory.now();
+    }
+
+    inline coordinator_type create_coordinator(composite_subscription cs = composite_subscription()) const {
+        auto w = factory.create_worker(std::move(cs));
+        auto state = std::make_shared<drain_state>();
+        return coordinator_type(input_type(std::move(w), std::move(state)));
+    }
+};
+
+inline serialize_drain_one_worker serialize_drain_event_loop() {
+    static serialize_drain_one_worker r(rxsc::make_event_loop());
+    return r;
+}
+
+inline serialize_drain_one_worker serialize_drain_new_thread() {
+    static serialize_drain_one_worker r(rxsc::make_new_thread());
+    return r;
+}
+
+inline serialize_drain_one_worker serialize_drain_work_stealing_pool() {
+    static serialize_drain_one_worker r(rxsc::make_work_stealing_pool());
+    return r;
+}
+
 
 }
 
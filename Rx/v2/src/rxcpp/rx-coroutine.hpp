@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_COROUTINE_HPP)
+#define RXCPP_RX_COROUTINE_HPP
+
+// this bridge needs c++20 coroutines, so it is not included by rx.hpp.
+// include "rxcpp/rx-coroutine.hpp" to use it. it is empty when the compiler
+// does not support coroutines.
+
+#include "rx-includes.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+
+namespace rxcpp {
+
+namespace detail {
+
+template<class T>
+struct observable_awaiter_state
+{
+    observable_awaiter_state()
+        : done(false)
+    {
+    }
+    rxu::maybe<T> value;
+    std::exception_ptr error;
+    std::coroutine_handle<> waiting;
+    // set by whichever of the end and await_suspend comes second
+    std::atomic<bool> done;
+
+    void finish() {
+        if (done.exchange(true)) {
+            waiting.resume();
+        }
+    }
+};
+
+template<class T, class Observable>
+struct observable_awaiter
+{
+    typedef observable_awaiter_state<T> state_type;
+
+    Observable source;
+    std::shared_ptr<state_type> state;
+
+    explicit observable_awaiter(Observable o)
+        : source(std::move(o))
+        , state(std::make_shared<state_type>())
+    {
+    }
+
+    bool await_ready() const {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<> h) {
+        state->waiting = h;
+        auto s = state;
+        source.subscribe(
+            [s](T v){
+                s->value.reset(std::move(v));
+            },
+            [s](std::exception_ptr e){
+                s->error = e;
+                s->finish();
+            },
+            [s](){
+                s->finish();
+            });
+        // stay running when the source ended during subscribe
+        return !state->done.exchange(true);
+    }
+    T await_resume() {
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+        if (state->value.empty()) {
+            throw std::runtime_error("co_await requires a source with at least one item");
+        }
+        return std::move(state->value.get());
+    }
+};
+
+}
+
+/// co_await an observable for its last value. the coroutine is resumed on the
+/// thread that delivers the end. an error is thrown out of the co_await, as
+/// is a runtime_error when the observable ends without a value. use first()
+/// or last() to pick the value.
+template<class T, class SourceOperator>
+auto operator co_await(const observable<T, SourceOperator>& o)
+    ->      detail::observable_awaiter<T, observable<T, SourceOperator>> {
+    return  detail::observable_awaiter<T, observable<T, SourceOperator>>(o);
+}
+
+/// async_generator hands the values of an observable to a coroutine one at a
+/// time. co_await next() resumes with the next value, or an empty maybe after
+/// the end. the coroutine is resumed on the thread that delivers the value
+/// when it was waiting, so a synchronous source waits for the coroutine.
+/// values that arrive while the coroutine is busy are queued. the source is
+/// subscribed at the first next() and unsubscribed when the generator is
+/// destroyed.
+///
+///     auto values = rxcpp::make_async_generator(source);
+///     for (auto v = co_await values.next(); !v.empty(); v = co_await values.next()) {
+///         use(v.get());
+///     }
+template<class T>
+class async_generator
+{
+    struct state_type
+    {
+        std::mutex lock;
+        std::deque<T> values;
+        bool done = false;
+        std::exception_ptr error;
+        std::coroutine_handle<> waiting;
+    };
+
+    observable<T> source;
+    composite_subscription lifetime;
+    std::shared_ptr<state_type> state;
+    bool started;
+
+    // the first value or the end resumes the coroutine, which might be
+    // before subscribe returns. so nothing in the generator is touched after
+    // subscribe, the coroutine might have destroyed it by then.
+    static void start(observable<T> source, composite_subscription lifetime, std::shared_ptr<state_type> s) {
+        auto wake = [](std::unique_lock<std::mutex>& guard, state_type& s){
+            auto h = s.waiting;
+            s.waiting = nullptr;
+            guard.unlock();
+            if (h) {
+                h.resume();
+            }
+        };
+        source.subscribe(
+            lifetime,
+            [s, wake](T v){
+                std::unique_lock<std::mutex> guard(s->lock);
+                s->values.push_back(std::move(v));
+                wake(guard, *s);
+            },
+            [s, wake](std::exception_ptr e){
+                std::unique_lock<std::mutex> guard(s->lock);
+                s->error = e;
+                s->done = true;
+                wake(guard, *s);
+            },
+            [s, wake](){
+                std::unique_lock<std::mutex> guard(s->lock);
+                s->done = true;
+                wake(guard, *s);
+            });
+    }
+
+public:
+    struct next_awaiter
+    {
+        async_generator* that;
+
+        bool await_ready() {
+            if (!that->started) {
+                return false;
+            }
+            std::unique_lock<std::mutex> guard(that->state->lock);
+            return !that->state->values.empty() || that->state->done;
+        }
+        bool await_suspend(std::coroutine_handle<> h) {
+            if (!that->started) {
+                that->started = true;
+                that->state->waiting = h;
+                start(that->source, that->lifetime, that->state);
+                return true;
+            }
+            std::unique_lock<std::mutex> guard(that->state->lock);
+            if (!that->state->values.empty() || that->state->done) {
+                // arrived since await_ready
+                return false;
+            }
+            that->state->waiting = h;
+            return true;
+        }
+        rxu::maybe<T> await_resume() {
+            std::unique_lock<std::mutex> guard(that->state->lock);
+            rxu::maybe<T> result;
+            if (!that->state->values.empty()) {
+                result.reset(std::move(that->state->values.front()));
+                that->state->values.pop_front();
+            } else if (that->state->error) {
+                std::rethrow_exception(that->state->error);
+            }
+            return result;
+        }
+    };
+
+    explicit async_generator(observable<T> o)
+        : source(std::move(o))
+        , state(std::make_shared<state_type>())
+        , started(false)
+    {
+    }
+    async_generator(async_generator&& o)
+        : source(std::move(o.source))
+        , lifetime(o.lifetime)
+        , state(std::move(o.state))
+        , started(o.started)
+    {
+        // the moved from generator must not end the subscription
+        o.lifetime = composite_subscription();
+    }
+    async_generator(const async_generator&) = delete;
+    async_generator& operator=(const async_generator&) = delete;
+    ~async_generator()
+    {
+        lifetime.unsubscribe();
+    }
+
+    next_awaiter next() {
+        return next_awaiter{this};
+    }
+};
+
+template<class T, class SourceOperator>
+auto make_async_generator(const observable<T, SourceOperator>& o)
+    ->      async_generator<T> {
+    return  async_generator<T>(o.as_dynamic());
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_DEMAND_HPP)
+#define RXCPP_RX_DEMAND_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// demand carries requests for values from a consumer to a producer.
+///
+/// the consumer calls request(n) to allow n more values. a producer that
+/// honors demand calls take() before each value and, when no value has
+/// been requested, stops and leaves a resume function that the next
+/// request(n) calls. copies refer to the same requests.
+///
+/// sources::range and sources::iterate honor a demand passed to them and
+/// observe_on can request values from its source as it delivers them.
+///
+/// the combinators pass a demand on through the demands of their sources.
+/// the sources of merge or concat share one demand, so that each value of
+/// any of them takes one requested value and a request resumes each source
+/// that waits. the sources of zip each have a demand and the consumer
+/// requests tuples through demand::each of them, since each tuple takes one
+/// value from every source. either way zip, merge and concat hold at most
+/// the requested values.
+class demand
+{
+    struct state_type
+    {
+        explicit state_type(size_t initial)
+            : requested(initial)
+        {
+        }
+        std::atomic<size_t> requested;
+        std::mutex lock;
+        // one for each producer that waits on this demand
+        std::vector<std::function<void()>> resume;
+        // the demands that each request is passed on to
+        std::vector<demand> upstream;
+    };
+    std::shared_ptr<state_type> state;
+
+    struct unbounded_tag {};
+    explicit demand(unbounded_tag)
+    {
+    }
+
+public:
+    /// no values are requested until request(n) is called
+    demand()
+        : state(std::make_shared<state_type>(0))
+    {
+    }
+    explicit demand(size_t initial)
+        : state(std::make_shared<state_type>(initial))
+    {
+    }
+
+    /// a demand that never stops the producer
+    static demand unbounded() {
+        return demand(unbounded_tag());
+    }
+
+    /// a demand whose requests are also made of each of upstream. a consumer
+    /// of zip requests n tuples by requesting n values of each source.
+    static demand each(std::vector<demand> upstream) {
+        demand result;
+        result.state->upstream = std::move(upstream);
+        return result;
+    }
+
+    bool is_unbounded() const {
+        return !state;
+    }
+
+    /// values requested and not yet produced
+    size_t outstanding() const {
+        return !!state ? state->requested.load() : std::numeric_limits<size_t>::max();
+    }
+
+    /// allow n more values and resume a producer that is waiting
+    void request(size_t n) const {
+        if (!state || n == 0) {
+            return;
+        }
+        state->requested += n;
+        std::vector<std::function<void()>> resume;
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            using std::swap;
+            swap(resume, state->resume);
+        }
+        // the producers race for the values, those that find none wait again
+        for (auto& r : resume) {
+            r();
+        }
+        for (auto& u : state->upstream) {
+            u.request(n);
+        }
+    }
+
+    /// consume one requested value. returns false when no value was requested.
+    bool take() const {
+        if (!state) {
+            return true;
+        }
+        auto requested = state->requested.load();
+        while (requested > 0) {
+            if (state->requested.compare_exchange_weak(requested, requested - 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// consume one requested value or, when there is none, leave resume
+    /// to be called once by the next request(n) and return false.
+    template<class F>
+    bool take_or_resume(F resume) const {
+        for (;;) {
+            if (take()) {
+                return true;
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->requested.load() == 0) {
+                state->resume.push_back(resume);
+                return false;
+            }
+            // a request arrived before resume was stored
+        }
+    }
+};
+
+}
+
+#endif
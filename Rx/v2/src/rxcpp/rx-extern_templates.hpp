@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_EXTERN_TEMPLATES_HPP)
+#define RXCPP_RX_EXTERN_TEMPLATES_HPP
+
+// included by rx-includes.hpp when RXCPP_EXTERN_TEMPLATES is defined. the
+// dynamic observable, observer, subscriber and subject types of the common
+// value types are then declared extern, so that each translation unit does
+// not instantiate them again. the rxcpp_core library holds the one
+// instantiation, it is built from rxcpp_core.cpp with
+// RXCPP_INSTANTIATE_TEMPLATES defined.
+
+#if defined(RXCPP_INSTANTIATE_TEMPLATES)
+#define RXCPP_EXTERN_TEMPLATE template
+#else
+#define RXCPP_EXTERN_TEMPLATE extern template
+#endif
+
+#define RXCPP_EXTERN_TEMPLATES_OF(T) \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::dynamic_observer<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::observer<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::subscriber<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::dynamic_observable<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::observable<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::subjects::detail::multicast_observer<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::subjects::subject<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::subjects::detail::behavior_observer<T>; \
+    RXCPP_EXTERN_TEMPLATE class rxcpp::subjects::behavior<T>;
+
+RXCPP_EXTERN_TEMPLATES_OF(int)
+RXCPP_EXTERN_TEMPLATES_OF(long)
+RXCPP_EXTERN_TEMPLATES_OF(double)
+RXCPP_EXTERN_TEMPLATES_OF(std::string)
+
+#undef RXCPP_EXTERN_TEMPLATES_OF
+#undef RXCPP_EXTERN_TEMPLATE
+
+#endif
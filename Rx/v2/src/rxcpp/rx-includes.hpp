@@ -94,11 +94,13 @@
 #include <stdlib.h>
 
 #include <cstddef>
+#include <cmath>
 
 #include <iostream>
 #include <iomanip>
 
 #include <exception>
+#include <stdexcept>
 #include <functional>
 #include <memory>
 #include <array>
@@ -107,6 +109,8 @@
 #include <atomic>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <deque>
 #include <thread>
@@ -116,16 +120,31 @@
 #include <queue>
 #include <chrono>
 #include <condition_variable>
+#include <limits>
 #include <initializer_list>
 #include <typeinfo>
 #include <tuple>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <random>
 
 #include "rx-util.hpp"
 #include "rx-predef.hpp"
+#include "rx-arena.hpp"
 #include "rx-subscription.hpp"
 #include "rx-observer.hpp"
 #include "rx-scheduler.hpp"
 #include "rx-subscriber.hpp"
+#include "rx-demand.hpp"
+#include "rx-cancellation.hpp"
+#include "rx-memory_budget.hpp"
+#include "rx-chunk_pool.hpp"
+#include "rx-column_batch.hpp"
+#include "rx-slice.hpp"
+#include "rx-buffer_pool.hpp"
 #include "rx-notification.hpp"
 #include "rx-coordination.hpp"
 #include "rx-sources.hpp"
@@ -135,6 +154,10 @@
 #include "rx-connectable_observable.hpp"
 #include "rx-grouped_observable.hpp"
 
+#if defined(RXCPP_EXTERN_TEMPLATES)
+#include "rx-extern_templates.hpp"
+#endif
+
 #pragma pop_macro("min")
 #pragma pop_macro("max")
 
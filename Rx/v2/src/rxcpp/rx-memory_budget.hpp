@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_MEMORY_BUDGET_HPP)
+#define RXCPP_RX_MEMORY_BUDGET_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// memory_budget counts the bytes and items that buffering operators hold,
+/// against a limit. the operators charge what they take in and refund what
+/// they let go of, so bytes() is what the pipelines that share the budget
+/// retain now. copies refer to the same budget.
+///
+/// the callback passed to on_exceeded is called when a charge takes bytes()
+/// over the limit, on the thread that charged, and again only after bytes()
+/// has come back to the limit. shedding is up to the callback, for instance
+/// by unsubscribing the root subscription of the pipeline of a tenant.
+///
+/// observe_on charges through a queue_depth made from a budget, the items
+/// are queued notifications. buffer charges the capacity of each open chunk,
+/// the items are chunks.
+class memory_budget
+{
+    struct state_type
+    {
+        state_type(std::string n, size_t l)
+            : name(std::move(n))
+            , limit(l)
+            , bytes(0)
+            , items(0)
+            , peak(0)
+            , exceeded(false)
+        {
+        }
+        std::string name;
+        size_t limit;
+        std::atomic<size_t> bytes;
+        std::atomic<size_t> items;
+        std::atomic<size_t> peak;
+        std::atomic<bool> exceeded;
+        std::function<void(const memory_budget&)> on_exceeded;
+    };
+    std::shared_ptr<state_type> state;
+
+    struct empty_tag {};
+    explicit memory_budget(empty_tag)
+    {
+    }
+
+public:
+    /// a limit of zero counts without a limit
+    memory_budget(std::string name, size_t limit)
+        : state(std::make_shared<state_type>(std::move(name), limit))
+    {
+    }
+
+    /// a memory_budget that counts nothing
+    static memory_budget empty() {
+        return memory_budget(empty_tag());
+    }
+
+    bool is_empty() const {
+        return !state;
+    }
+
+    std::string name() const {
+        return !!state ? state->name : std::string();
+    }
+    size_t limit() const {
+        return !!state ? state->limit : 0;
+    }
+    /// bytes held now
+    size_t bytes() const {
+        return !!state ? state->bytes.load() : 0;
+    }
+    /// items held now
+    size_t items() const {
+        return !!state ? state->items.load() : 0;
+    }
+    /// the most bytes that have been held at one time
+    size_t peak_bytes() const {
+        return !!state ? state->peak.load() : 0;
+    }
+    bool is_exceeded() const {
+        return !!state && state->exceeded.load();
+    }
+
+    /// f is called when the limit is exceeded. set it before the budget is
+    /// passed to an operator.
+    void on_exceeded(std::function<void(const memory_budget&)> f) const {
+        if (!!state) {
+            state->on_exceeded = std::move(f);
+        }
+    }
+
+    /// for the operators
+    void charge(size_t bytes, size_t items) const {
+        if (!state) {
+            return;
+        }
+        state->items += items;
+        auto now = state->bytes += bytes;
+        auto peak = state->peak.load();
+        while (peak < now && !state->peak.compare_exchange_weak(peak, now));
+        if (state->limit != 0 && now > state->limit &&
+            !state->exceeded.load(std::memory_order_relaxed) && !state->exceeded.exchange(true) &&
+            state->on_exceeded) {
+            state->on_exceeded(*this);
+        }
+    }
+
+    /// for the operators
+    void refund(size_t bytes, size_t items) const {
+        if (!state || (bytes == 0 && items == 0)) {
+            return;
+        }
+        state->items -= items;
+        auto now = state->bytes -= bytes;
+        if (now <= state->limit && state->exceeded.load(std::memory_order_relaxed)) {
+            state->exceeded = false;
+        }
+    }
+};
+
+/// the part of a memory_budget charged by one subscription. what is still
+/// charged when the lifetime ends is refunded then, so a subscription that
+/// is unsubscribed with values in its buffers does not leave them counted.
+class memory_account
+{
+    struct state_type
+    {
+        explicit state_type(memory_budget b)
+            : budget(std::move(b))
+            , bytes(0)
+            , items(0)
+            , ended(false)
+        {
+        }
+        memory_budget budget;
+        std::atomic<size_t> bytes;
+        std::atomic<size_t> items;
+        // charges after the end, from the notification that shed it, are ignored
+        std::atomic<bool> ended;
+    };
+    std::shared_ptr<state_type> state;
+
+public:
+    memory_account()
+    {
+    }
+
+    memory_account(memory_budget budget, const composite_subscription& lifetime)
+    {
+        if (budget.is_empty()) {
+            return;
+        }
+        state = std::make_shared<state_type>(std::move(budget));
+        auto st = state;
+        lifetime.add([st](){
+            st->ended = true;
+            st->budget.refund(st->bytes.exchange(0), st->items.exchange(0));
+        });
+    }
+
+    void charge(size_t bytes, size_t items) const {
+        if (!!state && !state->ended.load(std::memory_order_relaxed)) {
+            state->bytes += bytes;
+            state->items += items;
+            state->budget.charge(bytes, items);
+        }
+    }
+
+    void refund(size_t bytes, size_t items) const {
+        if (!!state && !state->ended.load(std::memory_order_relaxed)) {
+            state->bytes -= bytes;
+            state->items -= items;
+            state->budget.refund(bytes, items);
+        }
+    }
+};
+
+}
+
+#endif
@@ -195,24 +195,24 @@ private:
         catch (...) {
             ep = std::current_exception();
         }
-        return std::make_shared<on_error_notification>(ep);
+        return rxcpp::detail::allocate_state<on_error_notification>(ep);
     }
 
     struct exception_ptr_tag {};
 
     static
     type make_on_error(exception_ptr_tag&&, std::exception_ptr ep) {
-        return std::make_shared<on_error_notification>(ep);
+        return rxcpp::detail::allocate_state<on_error_notification>(ep);
     }
 
 public:
     template<typename U>
     static type on_next(U value) {
-        return std::make_shared<on_next_notification>(std::move(value));
+        return rxcpp::detail::allocate_state<on_next_notification>(std::move(value));
     }
 
     static type on_completed() {
-        return std::make_shared<on_completed_notification>();
+        return rxcpp::detail::allocate_state<on_completed_notification>();
     }
 
     template<typename Exception>
@@ -224,6 +224,69 @@ public:
     }
 };
 
+/// holds one notification by value. unlike notification<T>::type this
+/// does not allocate, so it is used to queue notifications on hot paths.
+template<class T>
+class notification_value
+{
+    typedef notification_value<T> this_type;
+
+    struct kind
+    {
+        enum type {
+            OnNext,
+            OnError,
+            OnCompleted
+        };
+    };
+
+    typename kind::type k;
+    rxu::maybe<T> value;
+    std::exception_ptr error;
+
+    explicit notification_value(typename kind::type k)
+        : k(k)
+    {
+    }
+
+public:
+    static this_type on_next(T v) {
+        this_type result(kind::OnNext);
+        result.value.reset(std::move(v));
+        return result;
+    }
+
+    static this_type on_error(std::exception_ptr e) {
+        this_type result(kind::OnError);
+        result.error = e;
+        return result;
+    }
+
+    static this_type on_completed() {
+        return this_type(kind::OnCompleted);
+    }
+
+    bool is_on_next() const {
+        return k == kind::OnNext;
+    }
+
+    /// calls the matching method on o. a value is moved into o.on_next
+    template<class Observer>
+    void deliver(const Observer& o) {
+        switch (k) {
+        case kind::OnNext:
+            o.on_next(std::move(value.get()));
+            break;
+        case kind::OnError:
+            o.on_error(error);
+            break;
+        case kind::OnCompleted:
+            o.on_completed();
+            break;
+        }
+    }
+};
+
 template<class T>
 bool operator == (const std::shared_ptr<detail::notification_base<T>>& lhs, const std::shared_ptr<detail::notification_base<T>>& rhs) {
     if (!lhs && !rhs) {return true;}
@@ -52,30 +52,55 @@ template<class T>
 class dynamic_observable
     : public rxs::source_base<T>
 {
+    // the source is stored in the same allocation as the state and is
+    // called through one virtual call, without a std::function between.
     struct state_type
-        : public std::enable_shared_from_this<state_type>
     {
-        typedef std::function<void(subscriber<T>)> onsubscribe_type;
-
-        onsubscribe_type on_subscribe;
+        virtual ~state_type() {}
+        virtual void on_subscribe(subscriber<T> o) = 0;
     };
     std::shared_ptr<state_type> state;
 
     template<class U>
     friend bool operator==(const dynamic_observable<U>&, const dynamic_observable<U>&);
 
+    template<class SO>
+    struct source_state : public state_type
+    {
+        explicit source_state(SO so)
+            : source(std::move(so))
+        {
+        }
+        virtual void on_subscribe(subscriber<T> o) {
+            source.on_subscribe(std::move(o));
+        }
+        SO source;
+    };
+
+    template<class F>
+    struct function_state : public state_type
+    {
+        explicit function_state(F f)
+            : function(std::move(f))
+        {
+        }
+        virtual void on_subscribe(subscriber<T> o) {
+            function(std::move(o));
+        }
+        F function;
+    };
+
     template<class SO>
     void construct(SO&& source, rxs::tag_source&&) {
-        rxu::decay_t<SO> so = std::forward<SO>(source);
-        state->on_subscribe = [so](subscriber<T> o) mutable {
-            so.on_subscribe(std::move(o));
-        };
+        typedef rxu::decay_t<SO> source_type;
+        state = std::make_shared<source_state<source_type>>(std::forward<SO>(source));
     }
 
     struct tag_function {};
     template<class F>
     void construct(F&& f, tag_function&&) {
-        state->on_subscribe = std::forward<F>(f);
+        typedef rxu::decay_t<F> function_type;
+        state = std::make_shared<function_state<function_type>>(std::forward<F>(f));
     }
 
 public:
@@ -88,7 +113,6 @@ public:
 
     template<class SOF>
     explicit dynamic_observable(SOF&& sof, typename std::enable_if<!is_dynamic_observable<SOF>::value, void**>::type = 0)
-        : state(std::make_shared<state_type>())
     {
         construct(std::forward<SOF>(sof),
                   typename std::conditional<rxs::is_source<SOF>::value || rxo::is_operator<SOF>::value, rxs::tag_source, tag_function>::type());
@@ -178,58 +202,27 @@ struct defer_observable
 template<class T, class Observable>
 class blocking_observable
 {
+    // parks the calling thread until the subscription is disposed. the
+    // state lives in this frame: disposed is set and notified while the
+    // lock is held, so the waiter cannot return and end the frame until
+    // the notifying thread is done with it.
     template<class Obsvbl, class... ArgN>
     static auto blocking_subscribe(const Obsvbl& source, ArgN&&... an)
         -> composite_subscription {
         std::mutex lock;
         std::condition_variable wake;
-        composite_subscription cs;
-        struct tracking
-        {
-            ~tracking()
-            {
-                if (!disposed || !wakened) abort();
-            }
-            tracking()
-            {
-                disposed = false;
-                wakened = false;
-                false_wakes = 0;
-                true_wakes = 0;
-            }
-            std::atomic_bool disposed;
-            std::atomic_bool wakened;
-            std::atomic_int false_wakes;
-            std::atomic_int true_wakes;
-        };
-        auto track = std::make_shared<tracking>();
+        bool disposed = false;
 
         auto scbr = make_subscriber<T>(std::forward<ArgN>(an)...);
-        cs = scbr.get_subscription();
-        cs.add(
-            [&, track](){
-                // OSX geting invalid x86 op if notify_one is after the disposed = true
-                // presumably because the condition_variable may already have been awakened
-                // and is now sitting in a while loop on disposed
+        scbr.get_subscription().add(
+            [&](){
+                std::unique_lock<std::mutex> guard(lock);
+                disposed = true;
                 wake.notify_one();
-                track->disposed = true;
             });
-        std::unique_lock<std::mutex> guard(lock);
         source.subscribe(std::move(scbr));
-        wake.wait(guard,
-            [&, track](){
-                // this is really not good.
-                // false wakeups were never followed by true wakeups so..
-
-                // anyways this gets triggered before disposed is set now so wait.
-                while (!track->disposed) {
-                    ++track->false_wakes;
-                }
-                ++track->true_wakes;
-                return true;
-            });
-        track->wakened = true;
-        if (!track->disposed || !track->wakened) abort();
+        std::unique_lock<std::mutex> guard(lock);
+        wake.wait(guard, [&](){return disposed;});
         return composite_subscription::empty();
     }
 
@@ -407,6 +400,66 @@ public:
         return blocking_observable<T, this_type>(*this);
     }
 
+    ///
+    /// subscribes and returns a future for the last value. the future holds
+    /// the error when this observable fails, or a runtime_error when it
+    /// completes without a value. the calling thread does not wait.
+    ///
+    std::future<T> to_future() const {
+        return last_async();
+    }
+
+    ///
+    /// subscribes and returns a future for the first value. the subscription
+    /// ends once the first value arrives.
+    ///
+    std::future<T> first_async() const {
+        auto result = std::make_shared<std::promise<T>>();
+        auto future = result->get_future();
+        composite_subscription cs;
+        subscribe(
+            cs,
+            [result, cs](T v){
+                result->set_value(std::move(v));
+                cs.unsubscribe();
+            },
+            [result](std::exception_ptr e){
+                result->set_exception(e);
+            },
+            [result](){
+                result->set_exception(std::make_exception_ptr(std::runtime_error("first_async() requires a source with at least one item")));
+            });
+        return future;
+    }
+
+    ///
+    /// subscribes and returns a future for the last value.
+    ///
+    std::future<T> last_async() const {
+        struct last_state
+        {
+            std::promise<T> result;
+            rxu::maybe<T> last;
+        };
+        auto state = std::make_shared<last_state>();
+        auto future = state->result.get_future();
+        subscribe(
+            [state](T v){
+                state->last.reset(std::move(v));
+            },
+            [state](std::exception_ptr e){
+                state->result.set_exception(e);
+            },
+            [state](){
+                if (state->last.empty()) {
+                    state->result.set_exception(std::make_exception_ptr(std::runtime_error("last_async() requires a source with at least one item")));
+                    return;
+                }
+                state->result.set_value(std::move(state->last.get()));
+            });
+        return future;
+    }
+
     ///
     /// takes any function that will take this observable and produce a result value.
     /// this is intended to allow externally defined operators, that use subscribe,
@@ -432,6 +485,17 @@ public:
         static_assert(detail::is_lift_function_for<T, subscriber<ResultType>, Operator>::value, "Function passed for lift() must have the signature subscriber<...>(subscriber<T, ...>)");
     }
 
+    ///
+    /// lift for map, filter and distinct_until_changed. when this observable is
+    /// also one of those, the two operators are fused and share a subscriber.
+    ///
+    template<class ResultType, class Operator>
+    auto lift_fused(Operator&& op) const
+        ->      observable<rxu::value_type_t<typename rxo::detail::lift_fusion<ResultType, source_operator_type, Operator>::type>, typename rxo::detail::lift_fusion<ResultType, source_operator_type, Operator>::type> {
+        return  observable<rxu::value_type_t<typename rxo::detail::lift_fusion<ResultType, source_operator_type, Operator>::type>, typename rxo::detail::lift_fusion<ResultType, source_operator_type, Operator>::type>(
+                                                                                                                                          rxo::detail::lift_fusion<ResultType, source_operator_type, Operator>::make(source_operator, std::forward<Operator>(op)));
+    }
+
     ///
     /// takes any function that will take a subscriber for this observable and produce a subscriber.
     /// this is intended to allow externally defined operators, that use make_subscriber, to be connected
@@ -477,8 +541,8 @@ public:
     ///
     template<class Predicate>
     auto filter(Predicate p) const
-        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::filter<T, Predicate>(std::move(p)))) {
-        return                    lift<T>(rxo::detail::filter<T, Predicate>(std::move(p)));
+        -> decltype(EXPLICIT_THIS lift_fused<T>(rxo::detail::filter<T, Predicate>(std::move(p)))) {
+        return                    lift_fused<T>(rxo::detail::filter<T, Predicate>(std::move(p)));
     }
 
     /// finally () ->
@@ -494,16 +558,54 @@ public:
     ///
     template<class Selector>
     auto map(Selector s) const
-        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::map<T, Selector>>>(rxo::detail::map<T, Selector>(std::move(s)))) {
-        return                    lift<rxu::value_type_t<rxo::detail::map<T, Selector>>>(rxo::detail::map<T, Selector>(std::move(s)));
+        -> decltype(EXPLICIT_THIS lift_fused<rxu::value_type_t<rxo::detail::map<T, Selector>>>(rxo::detail::map<T, Selector>(std::move(s)))) {
+        return                    lift_fused<rxu::value_type_t<rxo::detail::map<T, Selector>>>(rxo::detail::map<T, Selector>(std::move(s)));
     }
 
     /// distinct_until_changed ->
     /// for each item from this observable, filter out repeated values and emit only changes from the new observable that is returned.
     ///
     auto distinct_until_changed() const
-        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::distinct_until_changed<T>())) {
-        return                    lift<T>(rxo::detail::distinct_until_changed<T>());
+        -> decltype(EXPLICIT_THIS lift_fused<T>(rxo::detail::distinct_until_changed<T>())) {
+        return                    lift_fused<T>(rxo::detail::distinct_until_changed<T>());
+    }
+
+    /// distinct_until_changed ->
+    /// for each item from this observable, filter out repeated values and emit only changes from the new observable that is returned.
+    /// the last value is saved when the checkpoint is requested, and each subscription starts from the saved value.
+    ///
+    auto distinct_until_changed(rxo::checkpoint<T> cp) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::distinct_until_changed<T>(std::move(cp)))) {
+        return                    lift<T>(rxo::detail::distinct_until_changed<T>(std::move(cp)));
+    }
+
+    /// distinct_until_changed ->
+    /// for each item from this observable, filter out items whose key is the same as the key of the previous item.
+    /// only the keys are compared and remembered.
+    ///
+    template<class KeySelector,
+        class Requires = typename std::enable_if<!std::is_same<rxu::decay_t<KeySelector>, rxo::checkpoint<T>>::value, rxu::types_checked>::type>
+    auto distinct_until_changed(KeySelector ks) const
+        -> decltype(EXPLICIT_THIS lift_fused<T>(rxo::detail::distinct_until_key_changed<T, KeySelector>(std::move(ks)))) {
+        return                    lift_fused<T>(rxo::detail::distinct_until_key_changed<T, KeySelector>(std::move(ks)));
+    }
+
+    /// distinct ->
+    /// for each item from this observable, filter out items that have been emitted before.
+    ///
+    auto distinct() const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::distinct<T, rxo::detail::distinct_identity>(rxo::detail::distinct_identity(), 0))) {
+        return                    lift<T>(rxo::detail::distinct<T, rxo::detail::distinct_identity>(rxo::detail::distinct_identity(), 0));
+    }
+
+    /// distinct ->
+    /// for each item from this observable, filter out items whose key has been seen before.
+    /// when capacity is not zero only the most recent capacity keys are remembered.
+    ///
+    template<class KeySelector>
+    auto distinct(KeySelector ks, size_t capacity = 0) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::distinct<T, KeySelector>(std::move(ks), capacity))) {
+        return                    lift<T>(rxo::detail::distinct<T, KeySelector>(std::move(ks), capacity));
     }
 
     /// window ->
@@ -522,6 +624,15 @@ public:
         return                    lift<observable<T>>(rxo::detail::window<T>(count, skip));
     }
 
+    /// window ->
+    /// produce observables containing count items emitted by this observable
+    /// each produced observable is a unicast and supports one subscriber.
+    ///
+    auto window(int count, int skip, rxsub::unicast_windows) const
+        -> decltype(EXPLICIT_THIS lift<observable<T>>(rxo::detail::window<T, rxsub::unicast<T>>(count, skip))) {
+        return                    lift<observable<T>>(rxo::detail::window<T, rxsub::unicast<T>>(count, skip));
+    }
+
     /// window_with_time ->
     /// produce observables every skip time interval and collect items from this observable for period of time into each produced observable.
     ///
@@ -531,6 +642,16 @@ public:
         return                    lift<observable<T>>(rxo::detail::window_with_time<T, Duration, Coordination>(period, skip, coordination));
     }
 
+    /// window_with_time ->
+    /// produce observables every skip time interval and collect items from this observable for period of time into each produced observable.
+    /// each produced observable is a unicast and supports one subscriber.
+    ///
+    template<class Duration, class Coordination>
+    auto window_with_time(Duration period, Duration skip, Coordination coordination, rxsub::unicast_windows) const
+        -> decltype(EXPLICIT_THIS lift<observable<T>>(rxo::detail::window_with_time<T, Duration, Coordination, rxsub::unicast<T>>(period, skip, coordination))) {
+        return                    lift<observable<T>>(rxo::detail::window_with_time<T, Duration, Coordination, rxsub::unicast<T>>(period, skip, coordination));
+    }
+
     /// window_with_time ->
     /// produce observables every skip time interval and collect items from this observable for period of time into each produced observable.
     ///
@@ -567,6 +688,16 @@ public:
         return                    lift<observable<T>>(rxo::detail::window_with_time_or_count<T, Duration, Coordination>(period, count, coordination));
     }
 
+    /// window_with_time_or_count ->
+    /// produce observables every skip time interval and collect items from this observable for period of time into each produced observable.
+    /// each produced observable is a unicast and supports one subscriber.
+    ///
+    template<class Duration, class Coordination>
+    auto window_with_time_or_count(Duration period, int count, Coordination coordination, rxsub::unicast_windows) const
+        -> decltype(EXPLICIT_THIS lift<observable<T>>(rxo::detail::window_with_time_or_count<T, Duration, Coordination, rxsub::unicast<T>>(period, count, coordination))) {
+        return                    lift<observable<T>>(rxo::detail::window_with_time_or_count<T, Duration, Coordination, rxsub::unicast<T>>(period, count, coordination));
+    }
+
     /// window_with_time_or_count ->
     /// produce observables every skip time interval and collect items from this observable for period of time into each produced observable.
     ///
@@ -592,6 +723,54 @@ public:
         return                    lift_if<std::vector<T>>(rxo::detail::buffer_count<T>(count, skip));
     }
 
+    /// buffer ->
+    /// collect count items from this observable and produce a vector of them to emit from the new observable that is returned.
+    /// each vector is taken from pool, a consumer can return it to pool.recycle() to reuse its capacity.
+    ///
+    auto buffer(int count, int skip, chunk_pool<T> pool) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::buffer_count<T>(count, skip, std::move(pool)))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::buffer_count<T>(count, skip, std::move(pool)));
+    }
+
+    /// buffer ->
+    /// start a new vector every skip items and collect count items from this observable into each vector to emit from the new observable that is returned.
+    /// the capacity of each vector is charged to budget until it is emitted.
+    ///
+    auto buffer(int count, int skip, memory_budget budget) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::buffer_count<T>(count, skip, chunk_pool<T>(), std::move(budget)))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::buffer_count<T>(count, skip, chunk_pool<T>(), std::move(budget)));
+    }
+
+    /// buffer_shared ->
+    /// start a new vector every skip items and collect count items from this observable into each vector to emit from the new observable that is returned.
+    /// each item is moved into one std::shared_ptr<const T> that the overlapping vectors share, instead of being copied into each of them.
+    ///
+    auto buffer_shared(int count, int skip) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<std::shared_ptr<const T>>>(rxo::detail::buffer_count<T, std::shared_ptr<const T>>(count, skip))) {
+        return                    lift_if<std::vector<std::shared_ptr<const T>>>(rxo::detail::buffer_count<T, std::shared_ptr<const T>>(count, skip));
+    }
+
+    /// buffer_with_event_time ->
+    /// collect items from this observable into a vector for each window of period, by the timestamp that Selector
+    /// returns for each item. a window starts every skip. each vector is sent when the greatest timestamp so far, less
+    /// lateness, passes the end of its window. an item whose windows have all been sent is dropped.
+    ///
+    template<class Selector, class Duration>
+    auto buffer_with_event_time(Selector timestamp, Duration period, Duration skip, Duration lateness) const
+        -> decltype(EXPLICIT_THIS lift<std::vector<T>>(rxo::detail::buffer_with_event_time<T, Selector, Duration>(std::move(timestamp), period, skip, lateness))) {
+        return                    lift<std::vector<T>>(rxo::detail::buffer_with_event_time<T, Selector, Duration>(std::move(timestamp), period, skip, lateness));
+    }
+
+    /// buffer_with_event_time ->
+    /// collect items from this observable into a vector for each window of period, by the timestamp that Selector
+    /// returns for each item. the windows do not overlap.
+    ///
+    template<class Selector, class Duration>
+    auto buffer_with_event_time(Selector timestamp, Duration period, Duration lateness) const
+        -> decltype(EXPLICIT_THIS lift<std::vector<T>>(rxo::detail::buffer_with_event_time<T, Selector, Duration>(std::move(timestamp), period, period, lateness))) {
+        return                    lift<std::vector<T>>(rxo::detail::buffer_with_event_time<T, Selector, Duration>(std::move(timestamp), period, period, lateness));
+    }
+
     /// buffer_with_time ->
     /// start a new vector every skip time interval and collect items into it from this observable for period of time.
     ///
@@ -601,6 +780,16 @@ public:
         return                    lift_if<std::vector<T>>(rxo::detail::buffer_with_time<T, rxsc::scheduler::clock_type::duration, Coordination>(period, skip, coordination));
     }
 
+    /// buffer_with_time ->
+    /// start a new vector every skip time interval and collect items into it from this observable for period of time.
+    /// each vector is taken from pool, a consumer can return it to pool.recycle() to reuse its capacity.
+    ///
+    template<class Coordination>
+    auto buffer_with_time(rxsc::scheduler::clock_type::duration period, rxsc::scheduler::clock_type::duration skip, Coordination coordination, chunk_pool<T> pool) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::buffer_with_time<T, rxsc::scheduler::clock_type::duration, Coordination>(period, skip, coordination, std::move(pool)))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::buffer_with_time<T, rxsc::scheduler::clock_type::duration, Coordination>(period, skip, coordination, std::move(pool)));
+    }
+
     /// buffer_with_time ->
     /// start a new vector every skip time interval and collect items into it from this observable for period of time.
     ///
@@ -636,6 +825,16 @@ public:
         return                    lift_if<std::vector<T>>(rxo::detail::buffer_with_time_or_count<T, rxsc::scheduler::clock_type::duration, Coordination>(period, count, coordination));
     }
 
+    /// buffer_with_time_or_count ->
+    /// start a new vector every skip time interval and collect items into it from this observable for period of time.
+    /// each vector is taken from pool, a consumer can return it to pool.recycle() to reuse its capacity.
+    ///
+    template<class Coordination>
+    auto buffer_with_time_or_count(rxsc::scheduler::clock_type::duration period, int count, Coordination coordination, chunk_pool<T> pool) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::buffer_with_time_or_count<T, rxsc::scheduler::clock_type::duration, Coordination>(period, count, coordination, std::move(pool)))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::buffer_with_time_or_count<T, rxsc::scheduler::clock_type::duration, Coordination>(period, count, coordination, std::move(pool)));
+    }
+
     /// buffer_with_time_or_count ->
     /// start a new vector every skip time interval and collect items into it from this observable for period of time.
     ///
@@ -644,6 +843,47 @@ public:
         return                    lift_if<std::vector<T>>(rxo::detail::buffer_with_time_or_count<T, rxsc::scheduler::clock_type::duration, identity_one_worker>(period, count, identity_current_thread()));
     }
 
+    /// adaptive_batch ->
+    /// collect items into a vector and send it when it holds as many items as the current limit or its first item has waited for target.
+    /// the limit starts at min_count, doubles up to max_count while full vectors are delivered in at most half of target, and halves down to min_count when delivery takes target or longer.
+    ///
+    template<class Coordination>
+    auto adaptive_batch(int min_count, int max_count, rxsc::scheduler::clock_type::duration target, Coordination coordination) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::adaptive_batch<T, rxsc::scheduler::clock_type::duration, Coordination>(min_count, max_count, target, coordination))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::adaptive_batch<T, rxsc::scheduler::clock_type::duration, Coordination>(min_count, max_count, target, coordination));
+    }
+
+    /// adaptive_batch ->
+    /// collect items into a vector and send it when it holds as many items as the current limit or its first item has waited for target.
+    /// the limit starts at min_count, doubles up to max_count while full vectors are delivered in at most half of target, and halves down to min_count when delivery takes target or longer.
+    ///
+    auto adaptive_batch(int min_count, int max_count, rxsc::scheduler::clock_type::duration target) const
+        -> decltype(EXPLICIT_THIS lift_if<std::vector<T>>(rxo::detail::adaptive_batch<T, rxsc::scheduler::clock_type::duration, identity_one_worker>(min_count, max_count, target, identity_current_thread()))) {
+        return                    lift_if<std::vector<T>>(rxo::detail::adaptive_batch<T, rxsc::scheduler::clock_type::duration, identity_one_worker>(min_count, max_count, target, identity_current_thread()));
+    }
+
+    /// to_columns ->
+    /// collect the fields of the values into a column_batch, with one column for each field, and send it when it holds count rows or period has passed.
+    ///
+    template<class Coordination,
+        class Requires = typename std::enable_if<is_coordination<Coordination>::value, rxu::types_checked>::type,
+        class... FieldN>
+    auto to_columns(int count, rxsc::scheduler::clock_type::duration period, Coordination coordination, FieldN... fieldn) const
+        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::to_columns<T, Coordination, FieldN...>>>(rxo::detail::to_columns<T, Coordination, FieldN...>(count, period, std::move(coordination), fieldn...))) {
+        return                    lift<rxu::value_type_t<rxo::detail::to_columns<T, Coordination, FieldN...>>>(rxo::detail::to_columns<T, Coordination, FieldN...>(count, period, std::move(coordination), fieldn...));
+    }
+
+    /// to_columns ->
+    /// collect the fields of the values into a column_batch, with one column for each field, and send it when it holds count rows or period has passed.
+    ///
+    template<class Field0,
+        class Requires = typename std::enable_if<std::is_member_object_pointer<Field0>::value, rxu::types_checked>::type,
+        class... FieldN>
+    auto to_columns(int count, rxsc::scheduler::clock_type::duration period, Field0 field0, FieldN... fieldn) const
+        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::to_columns<T, identity_one_worker, Field0, FieldN...>>>(rxo::detail::to_columns<T, identity_one_worker, Field0, FieldN...>(count, period, identity_current_thread(), field0, fieldn...))) {
+        return                    lift<rxu::value_type_t<rxo::detail::to_columns<T, identity_one_worker, Field0, FieldN...>>>(rxo::detail::to_columns<T, identity_one_worker, Field0, FieldN...>(count, period, identity_current_thread(), field0, fieldn...));
+    }
+
     template<class Coordination>
     struct defer_switch_on_next : public defer_observable<
         is_observable<value_type>,
@@ -673,9 +913,56 @@ public:
         return          defer_switch_on_next<Coordination>::make(*this, *this, std::move(cn));
     }
 
+    /// switch_map ->
+    /// for each item from this observable use the Selector to produce an observable and subscribe to it
+    /// after unsubscribing from the observable produced for the previous item.
+    /// NOTE: map followed by switch_on_next
+    ///
+    template<class Selector>
+    auto switch_map(Selector s) const
+        -> decltype(EXPLICIT_THIS map(std::move(s)).switch_on_next()) {
+        return                    map(std::move(s)).switch_on_next();
+    }
+
+    /// switch_map ->
+    /// The coodination is used to synchronize sources from different contexts.
+    /// for each item from this observable use the Selector to produce an observable and subscribe to it
+    /// after unsubscribing from the observable produced for the previous item.
+    ///
+    template<class Selector, class Coordination>
+    auto switch_map(Selector s, Coordination cn) const
+        -> decltype(EXPLICIT_THIS map(std::move(s)).switch_on_next(std::move(cn))) {
+        return                    map(std::move(s)).switch_on_next(std::move(cn));
+    }
+
+    /// match ->
+    /// for each sequence of items from this observable that satisfies the steps of the pattern, with the first and last
+    /// item no more than within apart, emit a vector of the items that matched the steps from the new observable that is
+    /// returned. the items between steps that do not satisfy them are skipped.
+    ///
+    template<class Duration>
+    auto match(rxo::pattern<T> p, Duration within) const
+        -> decltype(EXPLICIT_THIS lift<std::vector<T>>(rxo::detail::match<T, identity_one_worker>(std::move(p), within, identity_current_thread()))) {
+        return                    lift<std::vector<T>>(rxo::detail::match<T, identity_one_worker>(std::move(p), within, identity_current_thread()));
+    }
+
+    /// match ->
+    /// The coordination is used to measure within.
+    /// for each sequence of items from this observable that satisfies the steps of the pattern, with the first and last
+    /// item no more than within apart, emit a vector of the items that matched the steps from the new observable that is
+    /// returned. the items between steps that do not satisfy them are skipped.
+    ///
+    template<class Duration, class Coordination>
+    auto match(rxo::pattern<T> p, Duration within, Coordination cn) const
+        -> decltype(EXPLICIT_THIS lift<std::vector<T>>(rxo::detail::match<T, Coordination>(std::move(p), within, std::move(cn)))) {
+        return                    lift<std::vector<T>>(rxo::detail::match<T, Coordination>(std::move(p), within, std::move(cn)));
+    }
+
     template<class Coordination>
     struct defer_merge : public defer_observable<
-        is_observable<value_type>,
+        rxu::all_true<
+            is_observable<value_type>::value,
+            is_coordination<Coordination>::value>,
         this_type,
         rxo::detail::merge, value_type, observable<value_type>, Coordination>
     {
@@ -704,6 +991,29 @@ public:
         return          defer_merge<Coordination>::make(*this, *this, std::move(cn));
     }
 
+    /// merge ->
+    /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
+    /// for each item from this observable subscribe, while fewer than maxConcurrent are subscribed. the rest wait in order.
+    /// for each item from all of the nested observables deliver from the new observable that is returned.
+    ///
+    auto merge(int maxConcurrent) const
+        -> typename defer_merge<identity_one_worker>::observable_type {
+        return      defer_merge<identity_one_worker>::make(*this, *this, identity_current_thread(), maxConcurrent);
+    }
+
+    /// merge ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// for each item from this observable subscribe, while fewer than maxConcurrent are subscribed. the rest wait in order.
+    /// for each item from all of the nested observables deliver from the new observable that is returned.
+    ///
+    template<class Coordination>
+    auto merge(Coordination cn, int maxConcurrent) const
+        ->  typename std::enable_if<
+                        defer_merge<Coordination>::value,
+            typename    defer_merge<Coordination>::observable_type>::type {
+        return          defer_merge<Coordination>::make(*this, *this, std::move(cn), maxConcurrent);
+    }
+
     template<class Coordination, class Value0>
     struct defer_merge_from : public defer_observable<
         rxu::all_true<
@@ -740,6 +1050,112 @@ public:
         return          defer_merge_from<Coordination, Value0>::make(*this, rxs::from(this->as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...), std::move(cn));
     }
 
+    /// amb ->
+    /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
+    /// subscribe to this observable and the others, deliver the items from the first one that sends a notification and
+    /// unsubscribe from the rest as soon as it does.
+    ///
+    template<class Value0, class... ValueN>
+    auto amb(Value0 v0, ValueN... vn) const
+        ->  typename std::enable_if<
+                        is_observable<Value0>::value,
+                        observable<T, rxo::detail::amb<T, identity_one_worker>>>::type {
+        return          observable<T, rxo::detail::amb<T, identity_one_worker>>(
+                                      rxo::detail::amb<T, identity_one_worker>(
+                                          rxu::to_vector({this->as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...}), identity_current_thread()));
+    }
+
+    /// amb ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// subscribe to this observable and the others, deliver the items from the first one that sends a notification and
+    /// unsubscribe from the rest as soon as it does.
+    ///
+    template<class Coordination, class Value0, class... ValueN>
+    auto amb(Coordination cn, Value0 v0, ValueN... vn) const
+        ->  typename std::enable_if<
+                        is_coordination<Coordination>::value && is_observable<Value0>::value,
+                        observable<T, rxo::detail::amb<T, Coordination>>>::type {
+        return          observable<T, rxo::detail::amb<T, Coordination>>(
+                                      rxo::detail::amb<T, Coordination>(
+                                          rxu::to_vector({this->as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...}), std::move(cn)));
+    }
+
+    /// merge_sorted ->
+    /// this observable and the others are each ordered by Compare. the values of all of them are delivered from the new
+    /// observable that is returned in the order of Compare. a value is delivered once every source that has not completed
+    /// has sent a value that is not delivered yet.
+    ///
+    template<class Compare, class Value0, class... ValueN>
+    auto merge_sorted(Compare less, Value0 v0, ValueN... vn) const
+        ->  typename std::enable_if<
+                        is_observable<Value0>::value,
+                        observable<T, rxo::detail::merge_sorted<T, Compare, identity_one_worker>>>::type {
+        return          observable<T, rxo::detail::merge_sorted<T, Compare, identity_one_worker>>(
+                                      rxo::detail::merge_sorted<T, Compare, identity_one_worker>(
+                                          rxu::to_vector({this->as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...}), std::move(less), rxsc::scheduler::clock_type::duration::zero(), identity_current_thread()));
+    }
+
+    /// merge_sorted ->
+    /// like merge_sorted, but a source that has not sent a value for the idle duration is passed over until it sends
+    /// again. a value that it then sends, which is less than a value already delivered, is delivered at once.
+    /// The coordination is used to synchronize sources from different contexts and to measure idle.
+    ///
+    template<class Compare, class Duration, class Coordination, class Value0, class... ValueN>
+    auto merge_sorted(Compare less, Duration idle, Coordination cn, Value0 v0, ValueN... vn) const
+        ->  typename std::enable_if<
+                        is_coordination<Coordination>::value && is_observable<Value0>::value,
+                        observable<T, rxo::detail::merge_sorted<T, Compare, Coordination>>>::type {
+        return          observable<T, rxo::detail::merge_sorted<T, Compare, Coordination>>(
+                                      rxo::detail::merge_sorted<T, Compare, Coordination>(
+                                          rxu::to_vector({this->as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...}), std::move(less), idle, std::move(cn)));
+    }
+
+    /// join_window ->
+    /// for each item from this observable and each item from the Right observable that have the same key, and arrived
+    /// no more than window apart, emit the result of Selector(left, right) from the new observable that is returned.
+    ///
+    template<class Right, class LeftKey, class RightKey, class Duration, class Selector>
+    auto join_window(Right r, LeftKey lk, RightKey rk, Duration window, Selector s) const
+        ->  typename std::enable_if<
+                        is_observable<Right>::value,
+                        observable<rxu::value_type_t<rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, identity_one_worker>>, rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, identity_one_worker>>>::type {
+        return          observable<rxu::value_type_t<rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, identity_one_worker>>, rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, identity_one_worker>>(
+                                                     rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, identity_one_worker>(*this, std::move(r), std::move(lk), std::move(rk), window, std::move(s), identity_current_thread()));
+    }
+
+    /// join_window ->
+    /// like join_window, the Coordination is used to synchronize the two observables and to measure window.
+    ///
+    template<class Right, class LeftKey, class RightKey, class Duration, class Selector, class Coordination>
+    auto join_window(Right r, LeftKey lk, RightKey rk, Duration window, Selector s, Coordination cn) const
+        ->  typename std::enable_if<
+                        is_observable<Right>::value && is_coordination<Coordination>::value,
+                        observable<rxu::value_type_t<rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, Coordination>>, rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, Coordination>>>::type {
+        return          observable<rxu::value_type_t<rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, Coordination>>, rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, Coordination>>(
+                                                     rxo::detail::join_window<this_type, Right, LeftKey, RightKey, Selector, Coordination>(*this, std::move(r), std::move(lk), std::move(rk), window, std::move(s), std::move(cn)));
+    }
+
+    /// parallel_map ->
+    /// for each item from this observable use Selector on one of degree workers from Coordination to produce an item to emit from the new observable that is returned.
+    /// when ordered is true the items are emitted in the order of this observable, otherwise as each one is produced.
+    ///
+    template<class Selector, class Coordination>
+    auto parallel_map(Selector s, Coordination cn, int degree, bool ordered = true) const
+        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::parallel_map<T, Selector, Coordination>>>(rxo::detail::parallel_map<T, Selector, Coordination>(std::move(s), std::move(cn), degree, ordered))) {
+        return                    lift<rxu::value_type_t<rxo::detail::parallel_map<T, Selector, Coordination>>>(rxo::detail::parallel_map<T, Selector, Coordination>(std::move(s), std::move(cn), degree, ordered));
+    }
+
+    /// partition_map ->
+    /// for each item from this observable use Selector on one of degree workers from Coordination to produce an item to emit from the new observable that is returned.
+    /// the items with equal keys from KeySelector go to the same worker, which uses Selector on them one at a time in the order of this observable, so per-key state in Selector needs no lock.
+    /// the items of each key are emitted in the order of this observable. when ordered is true all the items are.
+    ///
+    template<class KeySelector, class Selector, class Coordination>
+    auto partition_map(KeySelector k, Selector s, Coordination cn, int degree, bool ordered = false) const
+        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::parallel_map<T, Selector, Coordination, rxo::detail::partition_lanes<KeySelector>>>>(rxo::detail::parallel_map<T, Selector, Coordination, rxo::detail::partition_lanes<KeySelector>>(std::move(s), std::move(cn), degree, ordered, rxo::detail::partition_lanes<KeySelector>(std::move(k))))) {
+        return                    lift<rxu::value_type_t<rxo::detail::parallel_map<T, Selector, Coordination, rxo::detail::partition_lanes<KeySelector>>>>(rxo::detail::parallel_map<T, Selector, Coordination, rxo::detail::partition_lanes<KeySelector>>(std::move(s), std::move(cn), degree, ordered, rxo::detail::partition_lanes<KeySelector>(std::move(k))));
+    }
+
     /// flat_map (AKA SelectMany) ->
     /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
     /// for each item from this observable use the CollectionSelector to select an observable and subscribe to that observable.
@@ -752,6 +1168,14 @@ public:
                                                                                                                                           rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>(*this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), identity_current_thread()));
     }
 
+    template<class CollectionSelector, class ResultSelector, class Coordination>
+    struct defer_flat_map : public defer_observable<
+        is_coordination<rxu::decay_t<Coordination>>,
+        this_type,
+        rxo::detail::flat_map, this_type, CollectionSelector, ResultSelector, Coordination>
+    {
+    };
+
     /// flat_map (AKA SelectMany) ->
     /// The coodination is used to synchronize sources from different contexts.
     /// for each item from this observable use the CollectionSelector to select an observable and subscribe to that observable.
@@ -759,9 +1183,37 @@ public:
     ///
     template<class CollectionSelector, class ResultSelector, class Coordination>
     auto flat_map(CollectionSelector&& s, ResultSelector&& rs, Coordination&& sf) const
-        ->      observable<rxu::value_type_t<rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, Coordination>>, rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, Coordination>> {
-        return  observable<rxu::value_type_t<rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, Coordination>>, rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, Coordination>>(
-                                                                                                                                  rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, Coordination>(*this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf)));
+        ->  typename std::enable_if<
+                        defer_flat_map<CollectionSelector, ResultSelector, Coordination>::value,
+            typename    defer_flat_map<CollectionSelector, ResultSelector, Coordination>::observable_type>::type {
+        return          defer_flat_map<CollectionSelector, ResultSelector, Coordination>::make(*this, *this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf));
+    }
+
+    /// flat_map (AKA SelectMany) ->
+    /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
+    /// for each item from this observable use the CollectionSelector to select an observable and subscribe to that observable,
+    /// while fewer than maxConcurrent are subscribed. the rest of the items wait in order.
+    /// for each item from all of the selected observables use the ResultSelector to select a value to emit from the new observable that is returned.
+    ///
+    template<class CollectionSelector, class ResultSelector>
+    auto flat_map(CollectionSelector&& s, ResultSelector&& rs, int maxConcurrent) const
+        ->      observable<rxu::value_type_t<rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>>,  rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>> {
+        return  observable<rxu::value_type_t<rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>>,  rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>>(
+                                                                                                                                          rxo::detail::flat_map<this_type, CollectionSelector, ResultSelector, identity_one_worker>(*this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), identity_current_thread(), maxConcurrent));
+    }
+
+    /// flat_map (AKA SelectMany) ->
+    /// The coodination is used to synchronize sources from different contexts.
+    /// for each item from this observable use the CollectionSelector to select an observable and subscribe to that observable,
+    /// while fewer than maxConcurrent are subscribed. the rest of the items wait in order.
+    /// for each item from all of the selected observables use the ResultSelector to select a value to emit from the new observable that is returned.
+    ///
+    template<class CollectionSelector, class ResultSelector, class Coordination>
+    auto flat_map(CollectionSelector&& s, ResultSelector&& rs, Coordination&& sf, int maxConcurrent) const
+        ->  typename std::enable_if<
+                        defer_flat_map<CollectionSelector, ResultSelector, Coordination>::value,
+            typename    defer_flat_map<CollectionSelector, ResultSelector, Coordination>::observable_type>::type {
+        return          defer_flat_map<CollectionSelector, ResultSelector, Coordination>::make(*this, *this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf), maxConcurrent);
     }
 
     template<class Coordination>
@@ -855,182 +1307,143 @@ public:
                                                                                                                                       rxo::detail::concat_map<this_type, CollectionSelector, ResultSelector, Coordination>(*this, std::forward<CollectionSelector>(s), std::forward<ResultSelector>(rs), std::forward<Coordination>(sf)));
     }
 
-    template<class Source, class Coordination, class TS, class C = rxu::types_checked>
-    struct select_combine_latest_cn : public std::false_type {};
-
-    template<class Source, class Coordination, class T0, class... TN>
-    struct select_combine_latest_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Coordination::coordination_tag, typename T0::observable_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::combine_latest<Coordination, rxu::detail::pack, Source, T0, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Coordination cn, ObservableN... on) const {
-            return observable_type(operator_type(std::move(cn), rxu::pack(), std::make_tuple(src, std::move(on)...)));
-        }
-    };
-
-    template<class Source, class Coordination, class T0, class... TN>
-    struct select_combine_latest_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<T0(typename Source::value_type, typename TN::value_type...)>::type, typename Coordination::coordination_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::combine_latest<Coordination, T0, Source, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Coordination cn, T0 t0, ObservableN... on) const {
-            return observable_type(operator_type(std::move(cn), std::move(t0), std::make_tuple(src, std::move(on)...)));
-        }
-    };
-
-    template<class Source, class TS, class C = rxu::types_checked>
-    struct select_combine_latest : public std::false_type {
-        template<class T0, class T1, class... TN>
-        void operator()(const Source&, T0, T1, TN...) const {
-            static_assert(is_coordination<T0>::value ||
-                is_observable<T0>::value ||
-                std::is_convertible<T0, std::function<void(typename T1::value_type, typename TN::value_type...)>>::value
-                , "T0 must be selector, coordination or observable");
-            static_assert(is_observable<T1>::value  ||
-                std::is_convertible<T1, std::function<void(typename TN::value_type...)>>::value, "T1 must be selector or observable");
-            static_assert(rxu::all_true<true, is_observable<TN>::value...>::value, "TN... must be observable");
-        }
-        template<class T0>
-        void operator()(const Source&, T0) const {
-            static_assert(is_observable<T0>::value, "T0 must be observable");
-        }
-    };
-
-    template<class Source, class T0, class T1, class... TN>
-    struct select_combine_latest<Source, rxu::types<T0, T1, TN...>, typename rxu::types_checked_from<typename T0::coordination_tag, typename T1::observable_tag, typename TN::observable_tag...>::type>
-        : public select_combine_latest_cn<Source, T0, rxu::types<T1, TN...>>
-    {
-    };
-
-    template<class Source, class Selector, class... TN>
-    struct select_combine_latest<Source, rxu::types<Selector, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<Selector(typename Source::value_type, typename TN::value_type...)>::type, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::combine_latest<identity_one_worker, Selector, Source, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Selector sel, ObservableN... on) const {
-            return observable_type(operator_type(identity_current_thread(), std::move(sel), std::make_tuple(src, std::move(on)...)));
-        }
-    };
+    /// concat_map_eager ->
+    /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
+    /// for each item from this observable use the CollectionSelector to select an observable. up to prefetch of the
+    /// selected observables are subscribed ahead of the one that is being delivered, and their items are buffered so
+    /// that the items from all of the selected observables are emitted in order. a prefetch of 0 is the same as concat_map.
+    ///
+    template<class CollectionSelector>
+    auto concat_map_eager(CollectionSelector&& s, int prefetch) const
+        ->      observable<rxu::value_type_t<rxo::detail::concat_map_eager<this_type, CollectionSelector, identity_one_worker>>,  rxo::detail::concat_map_eager<this_type, CollectionSelector, identity_one_worker>> {
+        return  observable<rxu::value_type_t<rxo::detail::concat_map_eager<this_type, CollectionSelector, identity_one_worker>>,  rxo::detail::concat_map_eager<this_type, CollectionSelector, identity_one_worker>>(
+                                                                                                                                  rxo::detail::concat_map_eager<this_type, CollectionSelector, identity_one_worker>(*this, std::forward<CollectionSelector>(s), prefetch, identity_current_thread()));
+    }
 
-    template<class Source, class T0, class... TN>
-    struct select_combine_latest<Source, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename T0::observable_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::combine_latest<identity_one_worker, rxu::detail::pack, Source, T0, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, ObservableN... on) const {
-            return observable_type(operator_type(identity_current_thread(), rxu::pack(), std::make_tuple(src, std::move(on)...)));
-        }
-    };
+    /// concat_map_eager ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// for each item from this observable use the CollectionSelector to select an observable. up to prefetch of the
+    /// selected observables are subscribed ahead of the one that is being delivered, and their items are buffered so
+    /// that the items from all of the selected observables are emitted in order.
+    ///
+    template<class CollectionSelector, class Coordination>
+    auto concat_map_eager(CollectionSelector&& s, int prefetch, Coordination&& sf) const
+        ->      observable<rxu::value_type_t<rxo::detail::concat_map_eager<this_type, CollectionSelector, Coordination>>, rxo::detail::concat_map_eager<this_type, CollectionSelector, Coordination>> {
+        return  observable<rxu::value_type_t<rxo::detail::concat_map_eager<this_type, CollectionSelector, Coordination>>, rxo::detail::concat_map_eager<this_type, CollectionSelector, Coordination>>(
+                                                                                                                          rxo::detail::concat_map_eager<this_type, CollectionSelector, Coordination>(*this, std::forward<CollectionSelector>(s), prefetch, std::forward<Coordination>(sf)));
+    }
 
     /// combine_latest ->
     /// for each item from all of the observables use the Selector to select a value to emit from the new observable that is returned.
     ///
     template<class... AN>
     auto combine_latest(AN... an) const
-        -> decltype(select_combine_latest<this_type, rxu::types<decltype(an)...>>{}(*(this_type*)nullptr,  std::move(an)...)) {
-        return      select_combine_latest<this_type, rxu::types<decltype(an)...>>{}(*this,                 std::move(an)...);
+        -> typename rxo::detail::select_combine_latest<this_type, rxu::types<AN...>>::observable_type {
+        return      rxo::detail::select_combine_latest<this_type, rxu::types<AN...>>{}(*this, std::move(an)...);
     }
 
-    template<class Source, class Coordination, class TS, class C = rxu::types_checked>
-    struct select_zip_cn : public std::false_type {};
-
-    template<class Source, class Coordination, class T0, class... TN>
-    struct select_zip_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Coordination::coordination_tag, typename T0::observable_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::zip<Coordination, rxu::detail::pack, Source, T0, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Coordination cn, ObservableN... on) const {
-            return observable_type(operator_type(std::move(cn), rxu::pack(), std::make_tuple(src, std::move(on)...)));
-        }
-    };
-
-    template<class Source, class Coordination, class T0, class... TN>
-    struct select_zip_cn<Source, Coordination, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<T0(typename Source::value_type, typename TN::value_type...)>::type, typename Coordination::coordination_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::zip<Coordination, T0, Source, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Coordination cn, T0 t0, ObservableN... on) const {
-            return observable_type(operator_type(std::move(cn), std::move(t0), std::make_tuple(src, std::move(on)...)));
-        }
-    };
-
-    template<class Source, class TS, class C = rxu::types_checked>
-    struct select_zip : public std::false_type {
-        template<class T0, class T1, class... TN>
-        void operator()(const Source&, T0, T1, TN...) const {
-            static_assert(is_coordination<T0>::value ||
-                is_observable<T0>::value ||
-                std::is_convertible<T0, std::function<void(typename T1::value_type, typename TN::value_type...)>>::value
-                , "T0 must be selector, coordination or observable");
-            static_assert(is_observable<T1>::value  ||
-                std::is_convertible<T1, std::function<void(typename TN::value_type...)>>::value, "T1 must be selector or observable");
-            static_assert(rxu::all_true<true, is_observable<TN>::value...>::value, "TN... must be observable");
-        }
-        template<class T0>
-        void operator()(const Source&, T0) const {
-            static_assert(is_observable<T0>::value, "T0 must be observable");
-        }
-    };
-
-    template<class Source, class T0, class T1, class... TN>
-    struct select_zip<Source, rxu::types<T0, T1, TN...>, typename rxu::types_checked_from<typename T0::coordination_tag, typename T1::observable_tag, typename TN::observable_tag...>::type>
-        : public select_zip_cn<Source, T0, rxu::types<T1, TN...>>
+    template<class Coordination, class Selector, class... ObservableN>
+    struct defer_combine_latest_changes
     {
+        typedef rxo::detail::changes_selector<Selector> selector_type;
+        typedef rxo::detail::combine_latest<Coordination, selector_type, this_type, ObservableN...> operator_type;
+        typedef observable<rxu::value_type_t<operator_type>, operator_type> observable_type;
     };
 
-    template<class Source, class Selector, class... TN>
-    struct select_zip<Source, rxu::types<Selector, TN...>, typename rxu::types_checked_from<typename Source::value_type, typename TN::value_type..., typename std::result_of<Selector(typename Source::value_type, typename TN::value_type...)>::type, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::zip<identity_one_worker, Selector, Source, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, Selector sel, ObservableN... on) const {
-            return observable_type(operator_type(identity_current_thread(), std::move(sel), std::make_tuple(src, std::move(on)...)));
-        }
-    };
+    /// combine_latest_changes ->
+    /// like combine_latest, the Selector is also passed a std::bitset, as the first argument, with a bit set for each
+    /// observable that has emitted since the Selector was last called. the latest values are passed as const references.
+    ///
+    template<class Selector, class... ObservableN>
+    auto combine_latest_changes(Selector s, ObservableN... on) const
+        ->  typename std::enable_if<!is_coordination<Selector>::value,
+                     defer_combine_latest_changes<identity_one_worker, Selector, ObservableN...>>::type::observable_type {
+        typedef defer_combine_latest_changes<identity_one_worker, Selector, ObservableN...> defer_type;
+        return typename defer_type::observable_type(typename defer_type::operator_type(identity_current_thread(), typename defer_type::selector_type(std::move(s)), std::make_tuple(*this, std::move(on)...)));
+    }
 
-    template<class Source, class T0, class... TN>
-    struct select_zip<Source, rxu::types<T0, TN...>, typename rxu::types_checked_from<typename T0::observable_tag, typename TN::observable_tag...>::type>
-        : public std::true_type
-    {
-        typedef rxo::detail::zip<identity_one_worker, rxu::detail::pack, Source, T0, TN...> operator_type;
-        typedef observable<typename operator_type::value_type, operator_type> observable_type;
-        template<class... ObservableN>
-        observable_type operator()(const Source& src, ObservableN... on) const {
-            return observable_type(operator_type(identity_current_thread(), rxu::pack(), std::make_tuple(src, std::move(on)...)));
-        }
-    };
+    /// combine_latest_changes ->
+    /// The coordination is used to synchronize sources from different contexts.
+    ///
+    template<class Coordination, class Selector, class... ObservableN>
+    auto combine_latest_changes(Coordination cn, Selector s, ObservableN... on) const
+        ->  typename std::enable_if<is_coordination<Coordination>::value,
+                     defer_combine_latest_changes<Coordination, Selector, ObservableN...>>::type::observable_type {
+        typedef defer_combine_latest_changes<Coordination, Selector, ObservableN...> defer_type;
+        return typename defer_type::observable_type(typename defer_type::operator_type(std::move(cn), typename defer_type::selector_type(std::move(s)), std::make_tuple(*this, std::move(on)...)));
+    }
 
     /// zip ->
     /// bring by one item from all given observables and use the Selector to select a value to emit from the new observable that is returned.
     ///
     template<class... AN>
     auto zip(AN... an) const
-        -> decltype(select_zip<this_type, rxu::types<decltype(an)...>>{}(*(this_type*)nullptr,  std::move(an)...)) {
-        return      select_zip<this_type, rxu::types<decltype(an)...>>{}(*this,                 std::move(an)...);
+        -> typename rxo::detail::select_zip<this_type, rxu::types<AN...>>::observable_type {
+        return      rxo::detail::select_zip<this_type, rxu::types<AN...>>{}(*this, std::move(an)...);
     }
 
     /// group_by ->
     ///
     template<class KeySelector, class MarbleSelector, class BinaryPredicate>
     inline auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p) const
-        -> decltype(EXPLICIT_THIS lift<typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>::grouped_observable_type>(rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p)))) {
+        -> typename std::enable_if<!is_coordination<BinaryPredicate>::value, decltype(EXPLICIT_THIS lift<typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>::grouped_observable_type>(rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p))))>::type {
         return                    lift<typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>::grouped_observable_type>(rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p)));
     }
 
+    /// group_by ->
+    /// the groups are limited by the group_expiry. a group that expires is completed.
+    /// pass rxo::hash_groups<>() as the BinaryPredicate to keep the groups in a hash table.
+    ///
+    template<class KeySelector, class MarbleSelector, class BinaryPredicate>
+    inline auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p, rxo::group_expiry e) const
+        -> decltype(EXPLICIT_THIS lift<typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>::grouped_observable_type>(rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p), std::move(e)))) {
+        return                    lift<typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>::grouped_observable_type>(rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate>(std::move(ks), std::move(ms), std::move(p), std::move(e)));
+    }
+
+    template<class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination>
+    struct defer_group_by
+    {
+        typedef rxo::detail::group_by<T, this_type, KeySelector, MarbleSelector, BinaryPredicate, Coordination> operator_type;
+        typedef typename rxo::detail::group_by_traits<T, this_type, KeySelector, MarbleSelector, BinaryPredicate, Coordination>::grouped_observable_type value_type;
+        typedef observable<value_type, rxo::detail::lift_operator<value_type, source_operator_type, operator_type>> observable_type;
+    };
+
+    /// group_by ->
+    /// the values of each group are delivered on a worker from the coordination. the worker is chosen by
+    /// the hash of the key so that a key is always delivered on the same worker.
+    ///
+    template<class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination>
+    auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p, rxo::group_expiry e, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                    defer_group_by<KeySelector, MarbleSelector, BinaryPredicate, Coordination>>::type::observable_type {
+        typedef defer_group_by<KeySelector, MarbleSelector, BinaryPredicate, Coordination> defer_type;
+        return lift<typename defer_type::value_type>(typename defer_type::operator_type(std::move(ks), std::move(ms), std::move(p), std::move(e), std::move(cn)));
+    }
+
+    /// group_by ->
+    /// the values of each group are delivered on a worker from the coordination. the worker is chosen by
+    /// the hash of the key so that a key is always delivered on the same worker.
+    ///
+    template<class KeySelector, class MarbleSelector, class BinaryPredicate, class Coordination>
+    auto group_by(KeySelector ks, MarbleSelector ms, BinaryPredicate p, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                    defer_group_by<KeySelector, MarbleSelector, BinaryPredicate, Coordination>>::type::observable_type {
+        typedef defer_group_by<KeySelector, MarbleSelector, BinaryPredicate, Coordination> defer_type;
+        return lift<typename defer_type::value_type>(typename defer_type::operator_type(std::move(ks), std::move(ms), std::move(p), rxo::group_expiry(), std::move(cn)));
+    }
+
+    /// group_by ->
+    /// the values of each group are delivered on a worker from the coordination. the worker is chosen by
+    /// the hash of the key so that a key is always delivered on the same worker.
+    ///
+    template<class KeySelector, class MarbleSelector, class Coordination>
+    auto group_by(KeySelector ks, MarbleSelector ms, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                    defer_group_by<KeySelector, MarbleSelector, rxu::less, Coordination>>::type::observable_type {
+        typedef defer_group_by<KeySelector, MarbleSelector, rxu::less, Coordination> defer_type;
+        return lift<typename defer_type::value_type>(typename defer_type::operator_type(std::move(ks), std::move(ms), rxu::less(), rxo::group_expiry(), std::move(cn)));
+    }
+
     /// group_by ->
     ///
     template<class KeySelector, class MarbleSelector>
@@ -1068,13 +1481,60 @@ public:
         return                    multicast(rxsub::subject<T>(cs));
     }
 
+    /// publish_ring ->
+    /// turns a cold observable hot like publish, but each value is written once into a ring of capacity slots
+    /// and each subscriber reads the ring at its own pace on its own worker from the supplied coordination.
+    /// the source only waits for a subscriber that is capacity values behind
+    /// NOTE: multicast of a ring_subject
+    ///
+    template<class Coordination>
+    auto publish_ring(size_t capacity, Coordination cn, composite_subscription cs = composite_subscription()) const
+        -> decltype(EXPLICIT_THIS multicast(rxsub::ring_subject<T, Coordination>(std::move(cn), capacity, cs))) {
+        return                    multicast(rxsub::ring_subject<T, Coordination>(std::move(cn), capacity, cs));
+    }
+
     /// publish ->
     /// turns a cold observable hot, sends the most recent value to any new subscriber and allows connections to the source to be independent of subscriptions
     /// NOTE: multicast of a behavior
     ///
     auto publish(T first, composite_subscription cs = composite_subscription()) const
-        -> decltype(EXPLICIT_THIS multicast(rxsub::behavior<T>(first, cs))) {
-        return      multicast(rxsub::behavior<T>(first, cs));
+        -> decltype(EXPLICIT_THIS multicast(rxsub::behavior<T>(std::move(first), cs))) {
+        return      multicast(rxsub::behavior<T>(std::move(first), cs));
+    }
+
+    /// cache ->
+    /// subscribes to this observable once, when the first subscriber arrives,
+    /// and sends each subscriber the values that have been sent so far and
+    /// then the live values. max_items bounds the values kept, 0 keeps them
+    /// all. the source is kept when the subscribers have gone, so that a late
+    /// subscriber is still served from memory.
+    /// NOTE: multicast of a replay that is connected once
+    ///
+    auto cache(size_t max_items = 0) const
+        ->      observable<T,   rxo::detail::cache<T, connectable_observable<T, rxo::detail::multicast<T, this_type, rxsub::replay<T, identity_one_worker>>>>> {
+        return  observable<T,   rxo::detail::cache<T, connectable_observable<T, rxo::detail::multicast<T, this_type, rxsub::replay<T, identity_one_worker>>>>>(
+                                rxo::detail::cache<T, connectable_observable<T, rxo::detail::multicast<T, this_type, rxsub::replay<T, identity_one_worker>>>>(
+                                    multicast(rxsub::replay<T, identity_one_worker>(max_items, identity_current_thread()))));
+    }
+
+    /// share_replay ->
+    /// like cache, except that the source is unsubscribed when the last
+    /// subscriber has gone. the last count values are kept, 0 keeps them all.
+    /// NOTE: multicast of a replay with a ref_count
+    ///
+    auto share_replay(size_t count) const
+        ->      observable<T,   rxo::detail::ref_count<T, connectable_observable<T, rxo::detail::multicast<T, this_type, rxsub::replay<T, identity_one_worker>>>>> {
+        return  multicast(rxsub::replay<T, identity_one_worker>(count, identity_current_thread())).ref_count();
+    }
+
+    /// with_allocator ->
+    /// the state that the operators of this observable create for each subscription, and the notifications that
+    /// they queue, are allocated from the arena. the arena is freed when it and all of that state are gone.
+    ///
+    auto with_allocator(arena a) const
+        ->      observable<T,   rxo::detail::with_allocator<T, source_operator_type>> {
+        return  observable<T,   rxo::detail::with_allocator<T, source_operator_type>>(
+                                rxo::detail::with_allocator<T, source_operator_type>(source_operator, std::move(a)));
     }
 
     /// subscribe_on ->
@@ -1096,8 +1556,61 @@ public:
         return                    lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn)));
     }
 
+    /// observe_on ->
+    /// all values are queued and delivered using the scheduler from the supplied coordination.
+    /// each scheduled drain delivers up to batch values before it yields the worker.
+    ///
+    template<class Coordination>
+    auto observe_on(Coordination cn, size_t batch) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(batch)))) {
+        return                    lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(batch)));
+    }
+
+    /// observe_on ->
+    /// all values are queued and delivered using the scheduler from the supplied coordination.
+    /// window values are requested from upstream when subscribed and one more is requested as each value is delivered.
+    /// this bounds the queue when the source honors upstream, as sources::range and sources::iterate do.
+    ///
+    template<class Coordination>
+    auto observe_on(Coordination cn, demand upstream, size_t window = rxo::detail::observe_on_default_batch) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(std::move(upstream), window)))) {
+        return                    lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(std::move(upstream), window)));
+    }
+
+    /// observe_on ->
+    /// all values are queued and delivered using the scheduler from the supplied coordination.
+    /// at most capacity values wait in the queue, policy decides what happens to a value that arrives when the queue is full.
+    /// depth counts the values waiting in the queue.
+    ///
+    template<class Coordination>
+    auto observe_on(Coordination cn, size_t capacity, rxo::overflow_policy::type policy, rxo::queue_depth depth = rxo::queue_depth::empty()) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(capacity, policy, std::move(depth))))) {
+        return                    lift<T>(rxo::detail::observe_on<T, Coordination>(std::move(cn), rxo::detail::make_observe_on_settings(capacity, policy, std::move(depth))));
+    }
+
+    /// observe_on_latest ->
+    /// each value is delivered using the scheduler from the supplied coordination, keeping only the most recent value
+    /// while a delivery is waiting. the worker runs at most one delivery each time it gets to run, however fast the values arrive.
+    ///
+    template<class Coordination>
+    auto observe_on_latest(Coordination cn) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::observe_on_latest<T, Coordination, rxo::detail::keep_latest>(std::move(cn), rxo::detail::keep_latest()))) {
+        return                    lift<T>(rxo::detail::observe_on_latest<T, Coordination, rxo::detail::keep_latest>(std::move(cn), rxo::detail::keep_latest()));
+    }
+
+    /// observe_on_latest ->
+    /// each value is delivered using the scheduler from the supplied coordination. the values that arrive while a delivery
+    /// is waiting are merged into the waiting one with T(T waiting, T next) from Combiner.
+    ///
+    template<class Coordination, class Combiner>
+    auto observe_on_latest(Coordination cn, Combiner cb) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::observe_on_latest<T, Coordination, Combiner>(std::move(cn), std::move(cb)))) {
+        return                    lift<T>(rxo::detail::observe_on_latest<T, Coordination, Combiner>(std::move(cn), std::move(cb)));
+    }
+
     /// reduce ->
     /// for each item from this observable use Accumulator to combine items, when completed use ResultSelector to produce a value that will be emitted from the new observable that is returned.
+    /// an Accumulator with the signature void(Seed&, T) updates the seed in place instead of returning the next seed.
     ///
     template<class Seed, class Accumulator, class ResultSelector>
     auto reduce(Seed seed, Accumulator&& a, ResultSelector&& rs) const
@@ -1106,6 +1619,28 @@ public:
                                                                                                                                   rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>(source_operator, std::forward<Accumulator>(a), std::forward<ResultSelector>(rs), seed));
     }
 
+    /// reduce ->
+    /// for each item from this observable use Accumulator to combine items, when completed use ResultSelector to produce a value that will be emitted from the new observable that is returned.
+    /// the accumulated seed is saved when the checkpoint is requested, and each subscription starts from the saved seed.
+    ///
+    template<class Seed, class Accumulator, class ResultSelector>
+    auto reduce(Seed seed, Accumulator&& a, ResultSelector&& rs, rxo::checkpoint<Seed> cp) const
+        ->      observable<rxu::value_type_t<rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>>,    rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>> {
+        return  observable<rxu::value_type_t<rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>>,    rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>>(
+                                                                                                                                  rxo::detail::reduce<T, source_operator_type, Accumulator, ResultSelector, Seed>(source_operator, std::forward<Accumulator>(a), std::forward<ResultSelector>(rs), seed, std::move(cp)));
+    }
+
+    /// parallel_reduce ->
+    /// for a range or a random access collection, use Accumulator to combine the items of each part on a separate worker of the coordination, then use Combine to merge the partial results in order. Combine must be associative.
+    /// other sources are reduced in sequence.
+    ///
+    template<class Seed, class Accumulator, class Combine, class Coordination>
+    auto parallel_reduce(Seed seed, Accumulator a, Combine c, Coordination cn) const
+        ->      observable<rxu::decay_t<Seed>,  rxo::detail::parallel_reduce<T, source_operator_type, Accumulator, Combine, Seed, Coordination>> {
+        return  observable<rxu::decay_t<Seed>,  rxo::detail::parallel_reduce<T, source_operator_type, Accumulator, Combine, Seed, Coordination>>(
+                                                rxo::detail::parallel_reduce<T, source_operator_type, Accumulator, Combine, Seed, Coordination>(source_operator, std::move(a), std::move(c), std::move(seed), std::move(cn)));
+    }
+
     template<class Seed, class Accumulator, class ResultSelector>
     struct defer_reduce : public defer_observable<
         rxu::all_true<
@@ -1142,6 +1677,22 @@ public:
         return      defer_reduce<rxu::defer_seed_type<rxo::detail::initialize_seeder, T>, rxu::plus, rxu::defer_type<identity_for, T>>::make(source_operator, rxu::plus(), identity_for<T>(), rxo::detail::initialize_seeder<T>().seed());
     }
 
+    /// min ->
+    /// for each item from this observable reduce it by keeping the smallest item. a source without items is an error.
+    ///
+    auto min() const
+        -> typename defer_reduce<rxu::defer_seed_type<rxo::detail::min, T>, rxu::defer_type<rxo::detail::min, T>, rxu::defer_type<rxo::detail::min, T>>::observable_type {
+        return      defer_reduce<rxu::defer_seed_type<rxo::detail::min, T>, rxu::defer_type<rxo::detail::min, T>, rxu::defer_type<rxo::detail::min, T>>::make(source_operator, rxo::detail::min<T>(), rxo::detail::min<T>(), rxo::detail::min<T>().seed());
+    }
+
+    /// max ->
+    /// for each item from this observable reduce it by keeping the largest item. a source without items is an error.
+    ///
+    auto max() const
+        -> typename defer_reduce<rxu::defer_seed_type<rxo::detail::max, T>, rxu::defer_type<rxo::detail::max, T>, rxu::defer_type<rxo::detail::max, T>>::observable_type {
+        return      defer_reduce<rxu::defer_seed_type<rxo::detail::max, T>, rxu::defer_type<rxo::detail::max, T>, rxu::defer_type<rxo::detail::max, T>>::make(source_operator, rxo::detail::max<T>(), rxo::detail::max<T>(), rxo::detail::max<T>().seed());
+    }
+
     /// average ->
     /// for each item from this observable reduce it by adding to the previous values and then dividing by the number of items at the end.
     ///
@@ -1150,8 +1701,34 @@ public:
         return      defer_reduce<rxu::defer_seed_type<rxo::detail::average, T>, rxu::defer_type<rxo::detail::average, T>, rxu::defer_type<rxo::detail::average, T>>::make(source_operator, rxo::detail::average<T>(), rxo::detail::average<T>(), rxo::detail::average<T>().seed());
     }
 
+    /// approx_distinct_count ->
+    /// for each item from this observable add it to a HyperLogLog sketch of 2^precision registers, when completed emit the
+    /// estimated number of distinct items. the standard error is about 1.04 / sqrt(2^precision).
+    /// rxo::hyperloglog, rxo::sketch_add and rxo::sketch_merge can be passed to parallel_reduce to build the sketch in parts.
+    ///
+    auto approx_distinct_count(int precision = 12) const
+        -> observable<long long>;
+
+    /// heavy_hitters ->
+    /// for each item from this observable count it in a count-min sketch of depth rows of width counters, when completed
+    /// emit the k items with the largest estimated counts, the most frequent first. an estimate is never less than the true count.
+    /// rxo::top_k, rxo::sketch_add and rxo::sketch_merge can be passed to parallel_reduce to build the sketch in parts.
+    ///
+    auto heavy_hitters(size_t k, size_t width = 2048, size_t depth = 4) const
+        -> observable<std::vector<std::pair<T, unsigned long long>>>;
+
+    /// approx_quantiles ->
+    /// for each item from this observable add it to a t-digest of about compression centroids, when completed emit the
+    /// estimated value at each of the quantiles in qs. a source without items is an error. the items must convert to double.
+    /// rxo::tdigest, rxo::sketch_add and rxo::sketch_merge can be passed to parallel_reduce to build the digest in parts.
+    ///
+    template<class Value = T>
+    auto approx_quantiles(std::vector<double> qs, double compression = 100) const
+        -> observable<std::vector<double>>;
+
     /// scan ->
     /// for each item from this observable use Accumulator to combine items into a value that will be emitted from the new observable that is returned.
+    /// an Accumulator with the signature void(Seed&, T) updates the seed in place instead of returning the next seed.
     ///
     template<class Seed, class Accumulator>
     auto scan(Seed seed, Accumulator&& a) const
@@ -1160,15 +1737,25 @@ public:
                                     rxo::detail::scan<T, this_type, Accumulator, Seed>(*this, std::forward<Accumulator>(a), seed));
     }
 
+    /// scan ->
+    /// for each item from this observable use Accumulator to combine items into a value that will be emitted from the new observable that is returned.
+    /// the accumulated seed is saved when the checkpoint is requested, and each subscription starts from the saved seed.
+    ///
+    template<class Seed, class Accumulator>
+    auto scan(Seed seed, Accumulator&& a, rxo::checkpoint<Seed> cp) const
+        ->      observable<Seed,    rxo::detail::scan<T, this_type, Accumulator, Seed>> {
+        return  observable<Seed,    rxo::detail::scan<T, this_type, Accumulator, Seed>>(
+                                    rxo::detail::scan<T, this_type, Accumulator, Seed>(*this, std::forward<Accumulator>(a), seed, std::move(cp)));
+    }
+
     /// skip ->
     /// make new observable with skipped first count items from this observable
     ///
     ///
     template<class Count>
     auto skip(Count t) const
-        ->      observable<T,   rxo::detail::skip<T, this_type, Count>> {
-        return  observable<T,   rxo::detail::skip<T, this_type, Count>>(
-                                rxo::detail::skip<T, this_type, Count>(*this, t));
+        ->      typename rxo::detail::skip_of<T, this_type, Count>::type {
+        return  rxo::detail::skip_of<T, this_type, Count>::make(*this, t);
     }
 
     /// skip_until ->
@@ -1197,15 +1784,41 @@ public:
                                 rxo::detail::skip_until<T, this_type, TriggerSource, Coordination>(*this, std::forward<TriggerSource>(t), std::forward<Coordination>(sf)));
     }
 
+    /// skip_until ->
+    /// make new observable with items skipped until the specified time.
+    /// the time is one timed action on the current thread, not a trigger observable.
+    ///
+    ///
+    template<class TimePoint>
+    auto skip_until(TimePoint when) const
+        -> typename std::enable_if<std::is_convertible<TimePoint, rxsc::scheduler::clock_type::time_point>::value,
+                observable<T,   rxo::detail::skip_until_time<T, this_type, identity_one_worker>>>::type {
+        return  observable<T,   rxo::detail::skip_until_time<T, this_type, identity_one_worker>>(
+                                rxo::detail::skip_until_time<T, this_type, identity_one_worker>(*this, when, identity_current_thread()));
+    }
+
+    /// skip_until ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// make new observable with items skipped until the specified time.
+    /// the time is one timed action on the worker of the coordination, not a trigger observable.
+    ///
+    ///
+    template<class Coordination>
+    auto skip_until(rxsc::scheduler::clock_type::time_point when, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                observable<T,   rxo::detail::skip_until_time<T, this_type, Coordination>>>::type {
+        return  observable<T,   rxo::detail::skip_until_time<T, this_type, Coordination>>(
+                                rxo::detail::skip_until_time<T, this_type, Coordination>(*this, when, std::move(cn)));
+    }
+
     /// take ->
     /// for the first count items from this observable emit them from the new observable that is returned.
     ///
     ///
     template<class Count>
     auto take(Count t) const
-        ->      observable<T,   rxo::detail::take<T, this_type, Count>> {
-        return  observable<T,   rxo::detail::take<T, this_type, Count>>(
-                                rxo::detail::take<T, this_type, Count>(*this, t));
+        ->      typename rxo::detail::take_of<T, this_type, Count>::type {
+        return  rxo::detail::take_of<T, this_type, Count>::make(*this, t);
     }
 
     /// take_until ->
@@ -1235,28 +1848,111 @@ public:
     }
 
     /// take_until ->
-    /// All sources must be synchronized! This means that calls across all the subscribers must be serial.
     /// for each item from this observable until the specified time, emit them from the new observable that is returned.
+    /// the time is one timed action on the current thread, not a trigger observable.
     ///
     ///
     template<class TimePoint>
     auto take_until(TimePoint when) const
         -> typename std::enable_if<std::is_convertible<TimePoint, rxsc::scheduler::clock_type::time_point>::value,
-                observable<T,   rxo::detail::take_until<T, this_type, decltype(rxs::interval(when, identity_current_thread())), identity_one_worker>>>::type {
-        auto cn = identity_current_thread();
-        return  take_until(rxs::interval(when, cn), cn);
+                observable<T,   rxo::detail::take_until_time<T, this_type, identity_one_worker>>>::type {
+        return  observable<T,   rxo::detail::take_until_time<T, this_type, identity_one_worker>>(
+                                rxo::detail::take_until_time<T, this_type, identity_one_worker>(*this, when, identity_current_thread()));
     }
 
     /// take_until ->
     /// The coordination is used to synchronize sources from different contexts.
     /// for each item from this observable until the specified time, emit them from the new observable that is returned.
+    /// the time is one timed action on the worker of the coordination, not a trigger observable.
     ///
     ///
     template<class Coordination>
     auto take_until(rxsc::scheduler::clock_type::time_point when, Coordination cn) const
         -> typename std::enable_if<is_coordination<Coordination>::value,
-                observable<T,   rxo::detail::take_until<T, this_type, decltype(rxs::interval(when, cn)), Coordination>>>::type {
-        return  take_until(rxs::interval(when, cn), cn);
+                observable<T,   rxo::detail::take_until_time<T, this_type, Coordination>>>::type {
+        return  observable<T,   rxo::detail::take_until_time<T, this_type, Coordination>>(
+                                rxo::detail::take_until_time<T, this_type, Coordination>(*this, when, std::move(cn)));
+    }
+
+    /// take_until ->
+    /// for each item from this observable until the token is cancelled, emit them from the new observable that is returned.
+    /// the subscription is one entry in the list of the cancellation_source, not an observer of a trigger.
+    ///
+    auto take_until(cancellation_token t) const
+        ->      observable<T,   rxo::detail::take_until_token<T, this_type, identity_one_worker>> {
+        return  observable<T,   rxo::detail::take_until_token<T, this_type, identity_one_worker>>(
+                                rxo::detail::take_until_token<T, this_type, identity_one_worker>(*this, std::move(t), identity_current_thread()));
+    }
+
+    /// take_until ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// for each item from this observable until the token is cancelled, emit them from the new observable that is returned.
+    ///
+    template<class Coordination>
+    auto take_until(cancellation_token t, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                observable<T,   rxo::detail::take_until_token<T, this_type, Coordination>>>::type {
+        return  observable<T,   rxo::detail::take_until_token<T, this_type, Coordination>>(
+                                rxo::detail::take_until_token<T, this_type, Coordination>(*this, std::move(t), std::move(cn)));
+    }
+
+    /// timeout ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// for each item from this observable emit it from the new observable that is returned. when no item arrives for
+    /// the period, unsubscribe this observable and send rxo::timeout_error.
+    ///
+    ///
+    template<class Coordination>
+    auto timeout(rxsc::scheduler::clock_type::duration period, Coordination cn) const
+        -> typename std::enable_if<is_coordination<Coordination>::value,
+                observable<T,   rxo::detail::timeout<T, this_type, decltype(rxs::error<T>(rxo::timeout_error("timeout"))), Coordination>>>::type {
+        return  observable<T,   rxo::detail::timeout<T, this_type, decltype(rxs::error<T>(rxo::timeout_error("timeout"))), Coordination>>(
+                                rxo::detail::timeout<T, this_type, decltype(rxs::error<T>(rxo::timeout_error("timeout"))), Coordination>(*this, period, rxs::error<T>(rxo::timeout_error("timeout")), std::move(cn)));
+    }
+
+    /// timeout ->
+    /// The coordination is used to synchronize sources from different contexts.
+    /// for each item from this observable emit it from the new observable that is returned. when no item arrives for
+    /// the period, unsubscribe this observable and emit the items from the fallback instead.
+    ///
+    ///
+    template<class Coordination, class Fallback>
+    auto timeout(rxsc::scheduler::clock_type::duration period, Coordination cn, Fallback fallback) const
+        -> typename std::enable_if<is_coordination<Coordination>::value && is_observable<Fallback>::value,
+                observable<T,   rxo::detail::timeout<T, this_type, Fallback, Coordination>>>::type {
+        return  observable<T,   rxo::detail::timeout<T, this_type, Fallback, Coordination>>(
+                                rxo::detail::timeout<T, this_type, Fallback, Coordination>(*this, period, std::move(fallback), std::move(cn)));
+    }
+
+    /// debounce ->
+    /// emit an item from this observable once no other item has arrived for the period.
+    /// the last item is emitted when this observable completes.
+    /// the time is kept by the worker of the coordination.
+    ///
+    template<class Coordination>
+    auto debounce(rxsc::scheduler::clock_type::duration period, Coordination coordination) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::debounce<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination))) {
+        return                    lift<T>(rxo::detail::debounce<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination));
+    }
+
+    /// sample ->
+    /// emit the most recent item from this observable at the end of each period in which an item arrived.
+    /// the time is kept by the worker of the coordination.
+    ///
+    template<class Coordination>
+    auto sample(rxsc::scheduler::clock_type::duration period, Coordination coordination) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::sample<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination))) {
+        return                    lift<T>(rxo::detail::sample<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination));
+    }
+
+    /// throttle_first ->
+    /// emit an item from this observable and drop the items that arrive within the period after it.
+    /// the time is kept by the worker of the coordination.
+    ///
+    template<class Coordination>
+    auto throttle_first(rxsc::scheduler::clock_type::duration period, Coordination coordination) const
+        -> decltype(EXPLICIT_THIS lift<T>(rxo::detail::throttle_first<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination))) {
+        return                    lift<T>(rxo::detail::throttle_first<T, rxsc::scheduler::clock_type::duration, Coordination>(period, coordination));
     }
 
     /// repeat ->
@@ -1301,6 +1997,17 @@ public:
             rxo::detail::retry<T, this_type, Count>(*this, t));
     }
 
+    /// retry ->
+    /// retrys this observable for given number of times, 0 retrys infinitely.
+    /// each retry is delayed by the backoff and scheduled on the coordination.
+    ///
+    template<class Count, class Coordination>
+    auto retry(Count t, rxo::exponential_backoff b, Coordination cn) const
+        ->      observable<T, rxo::detail::retry_backoff<T, this_type, Count, Coordination>> {
+        return  observable<T, rxo::detail::retry_backoff<T, this_type, Count, Coordination>>(
+            rxo::detail::retry_backoff<T, this_type, Count, Coordination>(*this, t, std::move(b), std::move(cn)));
+    }
+
     /// start_with ->
     /// start with the supplied values, then concatenate this observable
     ///
@@ -1311,6 +2018,74 @@ public:
         return      rxo::start_with(*this, std::move(v0), std::move(vn)...);
     }
 
+    /// sliding_aggregate ->
+    /// for each item from this observable emit the Combine of the last count items, starting from the seed.
+    /// Combine must be associative with the seed as its identity. each item is combined a constant number of times.
+    ///
+    template<class Seed, class Combine>
+    auto sliding_aggregate(int count, Seed seed, Combine c) const
+        -> decltype(EXPLICIT_THIS lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, identity_one_worker>(count, rxu::maybe<rxsc::scheduler::clock_type::duration>(), std::move(seed), std::move(c), identity_current_thread()))) {
+        return                    lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, identity_one_worker>(count, rxu::maybe<rxsc::scheduler::clock_type::duration>(), std::move(seed), std::move(c), identity_current_thread()));
+    }
+
+    /// sliding_aggregate ->
+    /// for each item from this observable emit the Combine of the items that arrived during the last period, starting from the seed.
+    /// Combine must be associative with the seed as its identity. each item is combined a constant number of times.
+    ///
+    template<class Seed, class Combine>
+    auto sliding_aggregate(rxsc::scheduler::clock_type::duration period, Seed seed, Combine c) const
+        -> decltype(EXPLICIT_THIS lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, identity_one_worker>(0, rxu::maybe<rxsc::scheduler::clock_type::duration>(period), std::move(seed), std::move(c), identity_current_thread()))) {
+        return                    lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, identity_one_worker>(0, rxu::maybe<rxsc::scheduler::clock_type::duration>(period), std::move(seed), std::move(c), identity_current_thread()));
+    }
+
+    /// sliding_aggregate ->
+    /// The period is measured on the clock of the coordination.
+    ///
+    template<class Seed, class Combine, class Coordination>
+    auto sliding_aggregate(rxsc::scheduler::clock_type::duration period, Seed seed, Combine c, Coordination cn) const
+        -> decltype(EXPLICIT_THIS lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, Coordination>(0, rxu::maybe<rxsc::scheduler::clock_type::duration>(period), std::move(seed), std::move(c), std::move(cn)))) {
+        return                    lift<rxu::decay_t<Seed>>(rxo::detail::sliding_aggregate<T, Seed, Combine, Coordination>(0, rxu::maybe<rxsc::scheduler::clock_type::duration>(period), std::move(seed), std::move(c), std::move(cn)));
+    }
+
+    /// split ->
+    /// for each part of the slices from this observable that ends at the delimiter emit a slice of the part.
+    /// parts inside one slice share its bytes, only a part that spans slices is copied.
+    ///
+    template<class Source = T>
+    auto split(char delimiter) const
+        -> decltype(EXPLICIT_THIS lift<slice>(rxo::detail::split<Source>(delimiter, false))) {
+        return                    lift<slice>(rxo::detail::split<Source>(delimiter, false));
+    }
+
+    /// split_lines ->
+    /// split at each '\n' and drop a '\r' before the '\n'.
+    ///
+    template<class Source = T>
+    auto split_lines() const
+        -> decltype(EXPLICIT_THIS lift<slice>(rxo::detail::split<Source>('\n', true))) {
+        return                    lift<slice>(rxo::detail::split<Source>('\n', true));
+    }
+
+    /// instrument ->
+    /// measure the last operator as a stage. the values that enter and leave
+    /// it are counted in stage, which is passed to the tracer for each of them.
+    /// each value that leaves is paired with the oldest value that entered, so
+    /// the depth and latency are exact for operators like observe_on that send
+    /// one value for each value.
+    ///
+    auto instrument(rxo::stage_metrics stage) const
+        ->      typename rxo::detail::instrument_source<T, source_operator_type>::observable_type {
+        return  rxo::detail::instrument_source<T, source_operator_type>::make(source_operator, std::move(stage));
+    }
+
+    /// instrument ->
+    /// measure the last operator as a stage with this name.
+    ///
+    auto instrument(std::string name) const
+        ->      typename rxo::detail::instrument_source<T, source_operator_type>::observable_type {
+        return  rxo::detail::instrument_source<T, source_operator_type>::make(source_operator, rxo::stage_metrics(std::move(name)));
+    }
+
     /// pairwise ->
     /// take values pairwise from the observable
     ///
@@ -1318,6 +2093,14 @@ public:
         -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::pairwise<T>>>(rxo::detail::pairwise<T>())) {
         return                    lift<rxu::value_type_t<rxo::detail::pairwise<T>>>(rxo::detail::pairwise<T>());
     }
+
+    /// pairwise_shared ->
+    /// take values pairwise from the observable. each value is moved into one std::shared_ptr<const T> that the two tuples it is part of share.
+    ///
+    auto pairwise_shared() const
+        -> decltype(EXPLICIT_THIS lift<rxu::value_type_t<rxo::detail::pairwise<T, std::shared_ptr<const T>>>>(rxo::detail::pairwise<T, std::shared_ptr<const T>>())) {
+        return                    lift<rxu::value_type_t<rxo::detail::pairwise<T, std::shared_ptr<const T>>>>(rxo::detail::pairwise<T, std::shared_ptr<const T>>());
+    }
 };
 
 template<class T, class SourceOperator>
@@ -1339,6 +2122,32 @@ auto observable<T, SourceOperator>::count() const
     return this->reduce(0, [](int current, const T&){return ++current;}, [](int result){return result;});
 }
 
+template<class T, class SourceOperator>
+auto observable<T, SourceOperator>::approx_distinct_count(int precision) const
+    -> observable<long long> {
+    return this->reduce(rxo::hyperloglog<T>(precision), rxo::sketch_add(), [](const rxo::hyperloglog<T>& s){return std::llround(s.estimate());});
+}
+
+template<class T, class SourceOperator>
+auto observable<T, SourceOperator>::heavy_hitters(size_t k, size_t width, size_t depth) const
+    -> observable<std::vector<std::pair<T, unsigned long long>>> {
+    return this->reduce(rxo::top_k<T>(k, width, depth), rxo::sketch_add(), [](const rxo::top_k<T>& s){return s.values();});
+}
+
+template<class T, class SourceOperator>
+template<class Value>
+auto observable<T, SourceOperator>::approx_quantiles(std::vector<double> qs, double compression) const
+    -> observable<std::vector<double>> {
+    return this->reduce(rxo::tdigest(compression), rxo::sketch_add(), [qs](rxo::tdigest s){
+        std::vector<double> result;
+        result.reserve(qs.size());
+        for (auto q : qs) {
+            result.push_back(s.quantile(q));
+        }
+        return result;
+    });
+}
+
 template<class T, class SourceOperator>
 inline bool operator==(const observable<T, SourceOperator>& lhs, const observable<T, SourceOperator>& rhs) {
     return lhs.source_operator == rhs.source_operator;
@@ -1385,11 +2194,28 @@ public:
         -> decltype(rxs::never<T>()) {
         return      rxs::never<T>();
     }
+    template<class T>
+    static auto amb(std::vector<observable<T>> sources)
+        ->      observable<T, rxo::detail::amb<T, identity_one_worker>> {
+        return  observable<T, rxo::detail::amb<T, identity_one_worker>>(
+                              rxo::detail::amb<T, identity_one_worker>(std::move(sources), identity_current_thread()));
+    }
+    template<class T, class Coordination>
+    static auto amb(Coordination cn, std::vector<observable<T>> sources)
+        ->      observable<T, rxo::detail::amb<T, Coordination>> {
+        return  observable<T, rxo::detail::amb<T, Coordination>>(
+                              rxo::detail::amb<T, Coordination>(std::move(sources), std::move(cn)));
+    }
     template<class ObservableFactory>
     static auto defer(ObservableFactory of)
         -> decltype(rxs::defer(std::move(of))) {
         return      rxs::defer(std::move(of));
     }
+    template<class Duration, class ObservableFactory, class Coordination>
+    static auto hedge(Duration delay, ObservableFactory of, int max_attempts, Coordination cn)
+        -> decltype(rxs::hedge(delay, std::move(of), max_attempts, std::move(cn))) {
+        return      rxs::hedge(delay, std::move(of), max_attempts, std::move(cn));
+    }
     static auto interval(rxsc::scheduler::clock_type::time_point when)
         -> decltype(rxs::interval(when)) {
         return      rxs::interval(when);
@@ -1418,6 +2244,16 @@ public:
         -> decltype(rxs::iterate(std::move(c), std::move(cn))) {
         return      rxs::iterate(std::move(c), std::move(cn));
     }
+    template<class Generator>
+    static auto from_generator(Generator g)
+        -> decltype(rxs::from_generator(std::move(g), identity_current_thread())) {
+        return      rxs::from_generator(std::move(g), identity_current_thread());
+    }
+    template<class Generator, class Coordination>
+    static auto from_generator(Generator g, Coordination cn)
+        -> decltype(rxs::from_generator(std::move(g), std::move(cn))) {
+        return      rxs::from_generator(std::move(g), std::move(cn));
+    }
     template<class T>
     static auto from()
         -> decltype(    rxs::from<T>()) {
@@ -1473,14 +2309,31 @@ public:
     }
     template<class Observable, class Value0, class... ValueN>
     static auto start_with(Observable o, Value0 v0, ValueN... vn)
-        -> decltype(rxs::from(rxu::value_type_t<Observable>(v0), rxu::value_type_t<Observable>(vn)...).concat(o)) {
-        return      rxs::from(rxu::value_type_t<Observable>(v0), rxu::value_type_t<Observable>(vn)...).concat(o);
+        -> decltype(rxo::start_with(std::move(o), std::move(v0), std::move(vn)...)) {
+        return      rxo::start_with(std::move(o), std::move(v0), std::move(vn)...);
+    }
+    template<class T, class Compare>
+    static auto merge_sorted(Compare less, std::vector<observable<T>> sources)
+        ->      observable<T, rxo::detail::merge_sorted<T, Compare, identity_one_worker>> {
+        return  observable<T, rxo::detail::merge_sorted<T, Compare, identity_one_worker>>(
+                              rxo::detail::merge_sorted<T, Compare, identity_one_worker>(std::move(sources), std::move(less), rxsc::scheduler::clock_type::duration::zero(), identity_current_thread()));
+    }
+    template<class T, class Compare, class Duration, class Coordination>
+    static auto merge_sorted(Compare less, Duration idle, Coordination cn, std::vector<observable<T>> sources)
+        ->      observable<T, rxo::detail::merge_sorted<T, Compare, Coordination>> {
+        return  observable<T, rxo::detail::merge_sorted<T, Compare, Coordination>>(
+                              rxo::detail::merge_sorted<T, Compare, Coordination>(std::move(sources), std::move(less), idle, std::move(cn)));
     }
     template<class ResourceFactory, class ObservableFactory>
     static auto scope(ResourceFactory rf, ObservableFactory of)
         -> decltype(rxs::scope(std::move(rf), std::move(of))) {
         return      rxs::scope(std::move(rf), std::move(of));
     }
+    template<class T, class ObservableFactory>
+    static auto scope_pooled(rxs::resource_pool<T> pool, ObservableFactory of)
+        -> decltype(rxs::scope_pooled(std::move(pool), std::move(of))) {
+        return      rxs::scope_pooled(std::move(pool), std::move(of));
+    }
 };
 
 
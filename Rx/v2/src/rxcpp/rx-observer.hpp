@@ -39,8 +39,9 @@ template<class T, class F>
 struct is_on_next_of
 {
     struct not_void {};
+    // values are passed as rvalues so that move-only values can be sent
     template<class CT, class CF>
-    static auto check(int) -> decltype((*(CF*)nullptr)(*(CT*)nullptr));
+    static auto check(int) -> decltype((*(CF*)nullptr)(std::move(*(CT*)nullptr)));
     template<class CT, class CF>
     static not_void check(...);
 
@@ -48,6 +49,56 @@ struct is_on_next_of
     static const bool value = std::is_same<detail_result, void>::value;
 };
 
+template<class T, class Observer>
+struct has_on_next_range
+{
+    struct not_void {};
+    template<class CT, class CO>
+    static auto check(int) -> decltype(std::declval<const CO&>().on_next_range(std::declval<const CT*>(), size_t(0)));
+    template<class CT, class CO>
+    static not_void check(...);
+
+    static const bool value = std::is_same<decltype(check<T, rxu::decay_t<Observer>>(0)), void>::value;
+};
+
+// true when sending a V to the observer cannot throw. the observer types
+// pass on the noexcept of the functions they call, so a lambda declared
+// noexcept makes the whole observer noexcept.
+template<class Observer, class V>
+struct is_nothrow_on_next
+{
+    static const bool value = noexcept(std::declval<const rxu::decay_t<Observer>&>().on_next(std::declval<V>()));
+};
+
+// delivers count values to o, in one call when o supports it
+template<class T, class Observer>
+void on_next_range(const Observer& o, const T* first, size_t count, std::true_type) {
+    o.on_next_range(first, count);
+}
+template<class T, class Observer>
+void on_next_each(const Observer& o, const T* first, size_t count, std::true_type) {
+    for (auto last = first + count; first != last; ++first) {
+        o.on_next(*first);
+    }
+}
+template<class T, class Observer>
+void on_next_each(const Observer& o, const T*, size_t count, std::false_type) {
+    // values that cannot be copied can only be sent as a run to an
+    // observer that has on_next_range. the operators and sources do not
+    // batch them, so this is only reached by a direct call.
+    if (count != 0) {
+        o.on_error(std::make_exception_ptr(std::logic_error("on_next_range of values that cannot be copied to an observer without on_next_range")));
+    }
+}
+template<class T, class Observer>
+void on_next_range(const Observer& o, const T* first, size_t count, std::false_type) {
+    on_next_each(o, first, count, std::integral_constant<bool, std::is_copy_constructible<T>::value>());
+}
+template<class T, class Observer>
+void on_next_range(const Observer& o, const T* first, size_t count) {
+    on_next_range(o, first, count, std::integral_constant<bool, has_on_next_range<T, Observer>::value>());
+}
+
 template<class F>
 struct is_on_error
 {
@@ -120,7 +171,8 @@ public:
 
     // use V so that std::move can be used safely
     template<class V>
-    void on_next(V v) const {
+    void on_next(V v) const
+        noexcept(noexcept(std::declval<const on_next_t&>()(std::declval<V>()))) {
         onnext(std::move(v));
     }
     void on_error(std::exception_ptr e) const {
@@ -141,80 +193,168 @@ private:
     typedef dynamic_observer<T> this_type;
     typedef observer_base<T> base_type;
 
-    struct virtual_observer : public std::enable_shared_from_this<virtual_observer>
+    // the observer is stored in the object when it fits and otherwise
+    // shared on the heap. calls go through a table of functions that is
+    // shared by all the dynamic observers of one observer type, so a call
+    // costs one indirect call and never a reference count.
+    //
+    // a copy of a dynamic_observer copies an observer that is stored in the
+    // object, as a copy of a static observer does, and shares one that is on
+    // the heap. an observer that changes its own members when called should
+    // keep them behind a pointer, as subscribers and lambdas that capture by
+    // reference do, so that every copy sees the same state.
+    typedef typename std::aligned_storage<4 * sizeof(void*)>::type storage_type;
+
+    struct vtable_type
     {
-        virtual void on_next(T) const {};
-        virtual void on_error(std::exception_ptr) const {};
-        virtual void on_completed() const {};
+        void (*on_next)(const void*, T);
+        void (*on_next_range)(const void*, const T*, size_t);
+        void (*on_error)(const void*, std::exception_ptr);
+        void (*on_completed)(const void*);
+        void (*copy)(void*, const void*);
+        void (*move)(void*, void*);
+        void (*destroy)(void*);
     };
 
     template<class Observer>
-    struct specific_observer : public virtual_observer
+    struct fits_inline
+    {
+        static const bool value = sizeof(Observer) <= sizeof(storage_type) &&
+            std::alignment_of<storage_type>::value % std::alignment_of<Observer>::value == 0;
+    };
+
+    // how to reach the observer that is kept in the storage
+    template<class Observer, bool Inline = fits_inline<Observer>::value>
+    struct holder
+    {
+        typedef Observer held_type;
+        static const Observer& get(const void* p) {
+            return *static_cast<const Observer*>(p);
+        }
+        static void make(void* p, Observer o) {
+            new (p) held_type(std::move(o));
+        }
+    };
+    template<class Observer>
+    struct holder<Observer, false>
     {
-        explicit specific_observer(Observer o)
-            : destination(std::move(o))
-        {
+        typedef std::shared_ptr<const Observer> held_type;
+        static const Observer& get(const void* p) {
+            return **static_cast<const held_type*>(p);
         }
+        static void make(void* p, Observer o) {
+            new (p) held_type(std::make_shared<const Observer>(std::move(o)));
+        }
+    };
 
-        Observer destination;
-        virtual void on_next(T t) const {
-            destination.on_next(std::move(t));
+    template<class Observer>
+    struct specific_observer
+    {
+        typedef holder<Observer> holder_type;
+        typedef typename holder_type::held_type held_type;
+
+        static void on_next(const void* p, T t) {
+            holder_type::get(p).on_next(std::move(t));
+        }
+        static void on_next_range(const void* p, const T* first, size_t count) {
+            detail::on_next_range(holder_type::get(p), first, count);
         }
-        virtual void on_error(std::exception_ptr e) const {
-            destination.on_error(e);
+        static void on_error(const void* p, std::exception_ptr e) {
+            holder_type::get(p).on_error(e);
         }
-        virtual void on_completed() const {
-            destination.on_completed();
+        static void on_completed(const void* p) {
+            holder_type::get(p).on_completed();
+        }
+        static void copy(void* to, const void* from) {
+            new (to) held_type(*static_cast<const held_type*>(from));
+        }
+        static void move(void* to, void* from) {
+            new (to) held_type(std::move(*static_cast<held_type*>(from)));
+        }
+        static void destroy(void* p) {
+            static_cast<held_type*>(p)->~held_type();
+        }
+
+        static const vtable_type* vtable() {
+            static const vtable_type table = {
+                &on_next, &on_next_range, &on_error, &on_completed, &copy, &move, &destroy
+            };
+            return &table;
         }
     };
 
-    std::shared_ptr<virtual_observer> destination;
+    const vtable_type* vtable;
+    storage_type storage;
 
-    template<class Observer>
-    static auto make_destination(Observer o)
-        -> std::shared_ptr<virtual_observer> {
-        return std::make_shared<specific_observer<Observer>>(std::move(o));
+    void reset() {
+        if (vtable) {
+            vtable->destroy(&storage);
+            vtable = nullptr;
+        }
     }
 
 public:
     dynamic_observer()
+        : vtable(nullptr)
     {
     }
     dynamic_observer(const this_type& o)
-        : destination(o.destination)
+        : vtable(o.vtable)
     {
+        if (vtable) {
+            vtable->copy(&storage, &o.storage);
+        }
     }
     dynamic_observer(this_type&& o)
-        : destination(std::move(o.destination))
+        : vtable(o.vtable)
     {
+        if (vtable) {
+            vtable->move(&storage, &o.storage);
+        }
     }
 
     template<class Observer>
     explicit dynamic_observer(Observer o)
-        : destination(make_destination(std::move(o)))
+        : vtable(specific_observer<Observer>::vtable())
     {
+        holder<Observer>::make(&storage, std::move(o));
+    }
+
+    ~dynamic_observer()
+    {
+        reset();
     }
 
     this_type& operator=(this_type o) {
-        destination = std::move(o.destination);
+        reset();
+        if (o.vtable) {
+            o.vtable->move(&storage, &o.storage);
+            vtable = o.vtable;
+        }
         return *this;
     }
 
     // perfect forwarding delays the copy of the value.
     template<class V>
     void on_next(V&& v) const {
-        if (destination) {
-            destination->on_next(std::forward<V>(v));
+        if (vtable) {
+            vtable->on_next(&storage, std::forward<V>(v));
+        }
+    }
+    /// delivers count values with one indirect call
+    void on_next_range(const T* first, size_t count) const {
+        if (vtable) {
+            vtable->on_next_range(&storage, first, count);
         }
     }
     void on_error(std::exception_ptr e) const {
-        if (destination) {
-            destination->on_error(e);
+        if (vtable) {
+            vtable->on_error(&storage, e);
         }
     }
     void on_completed() const {
-        if (destination) {
-            destination->on_completed();
+        if (vtable) {
+            vtable->on_completed(&storage);
         }
     }
 };
@@ -250,9 +390,16 @@ public:
         return *this;
     }
     template<class V>
-    void on_next(V&& v) const {
+    void on_next(V&& v) const
+        noexcept(noexcept(std::declval<const inner_t&>().on_next(std::forward<V>(v)))) {
         inner.on_next(std::forward<V>(v));
     }
+    /// only present when the inner observer has on_next_range
+    template<class U = T, class Inner = inner_t>
+    auto on_next_range(const U* first, size_t count) const
+        -> decltype(std::declval<const Inner&>().on_next_range(first, count)) {
+        return      inner.on_next_range(first, count);
+    }
     void on_error(std::exception_ptr e) const {
         inner.on_error(e);
     }
@@ -272,7 +419,7 @@ public:
     {
     }
     template<class V>
-    void on_next(V&&) const {
+    void on_next(V&&) const noexcept {
     }
     void on_error(std::exception_ptr) const {
     }
@@ -383,6 +530,47 @@ auto make_observer_dynamic(OnNext&& on, OnError&& oe, OnCompleted&& oc)
 
 namespace detail {
 
+// forwards to an observer and sends runs of values to a separate function
+template<class T, class Observer, class OnNextRange>
+class range_observer : public observer_base<T>
+{
+    Observer destination;
+    OnNextRange onnextrange;
+
+public:
+    range_observer(Observer o, OnNextRange r)
+        : destination(std::move(o))
+        , onnextrange(std::move(r))
+    {
+    }
+    template<class V>
+    void on_next(V&& v) const
+        noexcept(noexcept(std::declval<const Observer&>().on_next(std::forward<V>(v)))) {
+        destination.on_next(std::forward<V>(v));
+    }
+    void on_next_range(const T* first, size_t count) const {
+        onnextrange(first, count);
+    }
+    void on_error(std::exception_ptr e) const {
+        destination.on_error(e);
+    }
+    void on_completed() const {
+        destination.on_completed();
+    }
+};
+
+}
+
+/// an observer that is sent runs of values with on_next_range(first, count)
+template<class T, class I, class OnNextRange>
+auto make_observer_with_range(observer<T, I> o, OnNextRange r)
+    ->      observer<T, detail::range_observer<T, observer<T, I>, OnNextRange>> {
+    return  observer<T, detail::range_observer<T, observer<T, I>, OnNextRange>>(
+                        detail::range_observer<T, observer<T, I>, OnNextRange>(std::move(o), std::move(r)));
+}
+
+namespace detail {
+
 template<class F>
 struct maybe_from_result
 {
@@ -29,45 +29,142 @@ public:
     static const bool value = std::is_convertible<decltype(check<rxu::decay_t<T>>(0)), tag_operator*>::value;
 };
 
+namespace detail {
+
+// an accumulator with the signature void(Seed&, T) updates the seed in
+// place, so a seed that owns memory is not copied for each value.
+template<class Accumulator, class Seed, class T>
+struct is_accumulate_in_place
+{
+    struct tag_not_valid {};
+    template<class CA, class CS, class CT>
+    static auto check(int) -> decltype((*(CA*)nullptr)(*(CS*)nullptr, *(CT*)nullptr));
+    template<class CA, class CS, class CT>
+    static tag_not_valid check(...);
+
+    static const bool value = std::is_same<decltype(check<typename std::remove_reference<Accumulator>::type, rxu::decay_t<Seed>, rxu::decay_t<T>>(0)), void>::value;
+};
+
+template<class Accumulator, class Seed, class T>
+void accumulate(Accumulator& accumulator, Seed& seed, T&& t, std::true_type) {
+    accumulator(seed, std::forward<T>(t));
+}
+template<class Accumulator, class Seed, class T>
+void accumulate(Accumulator& accumulator, Seed& seed, T&& t, std::false_type) {
+    auto next = accumulator(seed, std::forward<T>(t));
+    seed = std::move(next);
+}
+
+/// folds t into seed with an accumulator that either updates the seed in
+/// place or returns the next seed
+template<class Accumulator, class Seed, class T>
+void accumulate(Accumulator& accumulator, Seed& seed, T&& t) {
+    detail::accumulate(accumulator, seed, std::forward<T>(t), std::integral_constant<bool, is_accumulate_in_place<Accumulator, Seed, T>::value>());
+}
+
+// an operator that emits a value more than once, as in overlapping chunks,
+// holds it as Value, either a copy for each emission or one shared copy.
+template<class T, class Value>
+struct hold_value;
+
+template<class T>
+struct hold_value<T, T>
+{
+    static T make(T t) {
+        return t;
+    }
+};
+
+template<class T>
+struct hold_value<T, std::shared_ptr<const T>>
+{
+    static std::shared_ptr<const T> make(T t) {
+        return std::make_shared<const T>(std::move(t));
+    }
+};
+
+// a source that can send a slice of its values has sliced(skip, take), which
+// returns the source narrowed to the slice. skip and take of such a source
+// rewrite its bounds instead of dropping or stopping the values it sends.
+template<class SourceOperator>
+struct is_sliceable
+{
+    template<class CS>
+    static auto check(int) -> decltype((*(CS*)nullptr).sliced(size_t(0), size_t(0)));
+    template<class CS>
+    static void check(...);
+
+    static const bool value = std::is_same<decltype(check<rxu::decay_t<SourceOperator>>(0)), rxu::decay_t<SourceOperator>>::value;
+};
+
+template<class Count>
+size_t slice_count(Count c) {
+    return c > 0 ? static_cast<size_t>(c) : 0;
+}
+
+}
+
 }
 namespace rxo=operators;
 
 }
 
+#include "operators/rx-adaptive_batch.hpp"
+#include "operators/rx-amb.hpp"
 #include "operators/rx-buffer_count.hpp"
+#include "operators/rx-buffer_event_time.hpp"
 #include "operators/rx-buffer_time.hpp"
 #include "operators/rx-buffer_time_count.hpp"
+#include "operators/rx-cache.hpp"
+#include "operators/rx-checkpoint.hpp"
 #include "operators/rx-combine_latest.hpp"
 #include "operators/rx-concat.hpp"
 #include "operators/rx-concat_map.hpp"
+#include "operators/rx-concat_map_eager.hpp"
 #include "operators/rx-connect_forever.hpp"
+#include "operators/rx-debounce.hpp"
+#include "operators/rx-distinct.hpp"
 #include "operators/rx-distinct_until_changed.hpp"
 #include "operators/rx-filter.hpp"
 #include "operators/rx-finally.hpp"
 #include "operators/rx-flat_map.hpp"
 #include "operators/rx-group_by.hpp"
+#include "operators/rx-instrument.hpp"
+#include "operators/rx-join_window.hpp"
 #include "operators/rx-lift.hpp"
 #include "operators/rx-map.hpp"
+#include "operators/rx-match.hpp"
 #include "operators/rx-merge.hpp"
+#include "operators/rx-merge_sorted.hpp"
 #include "operators/rx-multicast.hpp"
 #include "operators/rx-observe_on.hpp"
+#include "operators/rx-observe_on_latest.hpp"
 #include "operators/rx-pairwise.hpp"
+#include "operators/rx-parallel_map.hpp"
 #include "operators/rx-publish.hpp"
 #include "operators/rx-reduce.hpp"
 #include "operators/rx-ref_count.hpp"
 #include "operators/rx-repeat.hpp"
 #include "operators/rx-retry.hpp"
+#include "operators/rx-sample.hpp"
 #include "operators/rx-scan.hpp"
 #include "operators/rx-skip.hpp"
 #include "operators/rx-skip_until.hpp"
+#include "operators/rx-sketch.hpp"
+#include "operators/rx-sliding_aggregate.hpp"
+#include "operators/rx-split.hpp"
 #include "operators/rx-start_with.hpp"
 #include "operators/rx-subscribe.hpp"
 #include "operators/rx-subscribe_on.hpp"
 #include "operators/rx-switch_on_next.hpp"
 #include "operators/rx-take.hpp"
 #include "operators/rx-take_until.hpp"
+#include "operators/rx-throttle_first.hpp"
+#include "operators/rx-timeout.hpp"
+#include "operators/rx-to_columns.hpp"
 #include "operators/rx-window.hpp"
 #include "operators/rx-window_time.hpp"
 #include "operators/rx-window_time_count.hpp"
+#include "operators/rx-with_allocator.hpp"
 #include "operators/rx-zip.hpp"
 #endif
@@ -17,6 +17,46 @@ inline auto trace_activity() -> decltype(rxcpp_trace_activity(trace_tag()))& {
     return trace;
 }
 
+namespace detail {
+
+// true when the tracer of this program records nothing. the paths that
+// skip the trace hooks, such as sending a run of values in one call, are
+// only taken then.
+struct is_trace_noop
+    : public std::is_same<rxu::decay_t<decltype(rxcpp_trace_activity(trace_tag()))>, trace_noop>
+{
+};
+
+// ids are taken from the shared counter in blocks so that threads creating
+// subscribers at the same time do not contend for its cache line. the ids
+// of one thread increase, the ids of different threads interleave.
+struct trace_id_block
+{
+    enum { size = 4096 };
+
+    static unsigned long next() {
+        static std::atomic<unsigned long> blocks(0xB0000000);
+        static RXCPP_THREAD_LOCAL unsigned long current;
+        static RXCPP_THREAD_LOCAL unsigned long last;
+        if (current == last) {
+            current = blocks.fetch_add(size, std::memory_order_relaxed);
+            last = current + size;
+        }
+        return ++current;
+    }
+};
+
+}
+
+// trace_noop never reads the ids, so every subscriber shares one id and the
+// counter is not touched.
+inline trace_id trace_id::make_next_id_subscriber() {
+    typedef rxu::decay_t<decltype(rxcpp_trace_activity(trace_tag()))> tracer_type;
+    return std::is_same<tracer_type, trace_noop>::value
+        ? trace_id{0xB0000000}
+        : trace_id{detail::trace_id_block::next()};
+}
+
 
 struct tag_action {};
 template<class T, class C = rxu::types_checked>
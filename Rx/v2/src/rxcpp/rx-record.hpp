@@ -0,0 +1,546 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_RECORD_HPP)
+#define RXCPP_RX_RECORD_HPP
+
+// record_to and replay_from write and read files, so they are not included
+// by rx.hpp. include "rxcpp/rx-record.hpp" to use them.
+
+#include "rx-includes.hpp"
+
+#include <fstream>
+
+namespace rxcpp {
+
+namespace notifications {
+
+/// the error that replay_from sends for a recorded on_error. only the
+/// what() of the original exception is recorded.
+struct recorded_error : public std::runtime_error
+{
+    explicit recorded_error(const std::string& what)
+        : std::runtime_error(what)
+    {
+    }
+};
+
+namespace detail {
+
+// a record file is the 8 bytes "rxrecord" and a version byte, then one
+// record for each notification: a kind byte, the nanoseconds since the
+// previous record as a varint and, for on_next and on_error, the length of
+// the payload as a varint and the payload. on_next payloads are written by
+// the serializer and on_error payloads are the what() of the exception.
+struct record_kind
+{
+    enum type {
+        on_next = 1,
+        on_error,
+        on_completed
+    };
+};
+
+struct record_format
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    static const char* magic() {
+        return "rxrecord";
+    }
+    enum {
+        magic_size = 8,
+        version = 1
+    };
+};
+
+class record_writer
+{
+    typedef record_format::clock_type clock_type;
+
+    std::string path;
+    std::ofstream file;
+    clock_type::time_point last;
+    std::vector<char> scratch;
+
+    record_writer(const record_writer&);
+    record_writer& operator=(const record_writer&);
+
+    void put_varint(std::uint64_t v) {
+        char bytes[10];
+        int count = 0;
+        do {
+            auto low = static_cast<char>(v & 0x7f);
+            v >>= 7;
+            bytes[count++] = static_cast<char>(low | (v != 0 ? 0x80 : 0));
+        } while (v != 0);
+        file.write(bytes, count);
+    }
+
+    void begin(record_kind::type kind) {
+        auto now = clock_type::now();
+        auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+        last = now;
+        file.put(static_cast<char>(kind));
+        put_varint(static_cast<std::uint64_t>((std::max)(delta, decltype(delta)(0))));
+    }
+
+    void put_payload(const char* data, size_t size) {
+        put_varint(size);
+        file.write(data, size);
+    }
+
+    std::system_error failed() const {
+        return std::system_error(errno, std::generic_category(), "record_to: write " + path);
+    }
+
+public:
+    explicit record_writer(std::string p)
+        : path(std::move(p))
+        , file(path.c_str(), std::ios::binary | std::ios::trunc)
+        , last(clock_type::now())
+        , scratch(64)
+    {
+        if (!file) {
+            throw std::system_error(errno, std::generic_category(), "record_to: open " + path);
+        }
+        file.write(record_format::magic(), record_format::magic_size);
+        file.put(static_cast<char>(record_format::version));
+    }
+
+    template<class Serializer, class T>
+    void next(const Serializer& serializer, const T& v) {
+        for (;;) {
+            auto length = serializer.write(v, scratch.data(), scratch.size());
+            if (length <= scratch.size()) {
+                begin(record_kind::on_next);
+                put_payload(scratch.data(), length);
+                return;
+            }
+            scratch.resize(length);
+        }
+    }
+
+    void error(const std::string& what) {
+        begin(record_kind::on_error);
+        put_payload(what.data(), what.size());
+        file.flush();
+    }
+
+    /// returns the error when the file could not be written
+    std::exception_ptr completed() {
+        begin(record_kind::on_completed);
+        file.flush();
+        return !file ? std::make_exception_ptr(failed()) : std::exception_ptr();
+    }
+};
+
+class record_reader
+{
+    std::string path;
+    std::ifstream file;
+
+    record_reader(const record_reader&);
+    record_reader& operator=(const record_reader&);
+
+    bool get_varint(std::uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto c = file.get();
+            if (c == std::ifstream::traits_type::eof()) {
+                return false;
+            }
+            v |= std::uint64_t(c & 0x7f) << shift;
+            if ((c & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    struct record
+    {
+        record()
+            : kind(record_kind::on_completed)
+        {
+        }
+        record_kind::type kind;
+        std::chrono::nanoseconds delta;
+        std::vector<char> payload;
+    };
+
+    explicit record_reader(std::string p)
+        : path(std::move(p))
+        , file(path.c_str(), std::ios::binary)
+    {
+        if (!file) {
+            throw std::system_error(errno, std::generic_category(), "replay_from: open " + path);
+        }
+        char header[record_format::magic_size + 1];
+        if (!file.read(header, sizeof(header)) ||
+            std::memcmp(header, record_format::magic(), record_format::magic_size) != 0 ||
+            header[record_format::magic_size] != record_format::version) {
+            throw std::runtime_error("replay_from: not a record file " + path);
+        }
+    }
+
+    /// the next record. throws at the end of a file that did not record
+    /// the end of its stream.
+    void next(record& r) {
+        auto kind = file.get();
+        std::uint64_t delta = 0;
+        if (kind == std::ifstream::traits_type::eof() || !get_varint(delta) ||
+            kind < record_kind::on_next || kind > record_kind::on_completed) {
+            throw std::runtime_error("replay_from: truncated " + path);
+        }
+        r.kind = static_cast<record_kind::type>(kind);
+        r.delta = std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(delta));
+        r.payload.clear();
+        if (r.kind == record_kind::on_completed) {
+            return;
+        }
+        std::uint64_t size = 0;
+        if (!get_varint(size)) {
+            throw std::runtime_error("replay_from: truncated " + path);
+        }
+        r.payload.resize(static_cast<size_t>(size));
+        if (size != 0 && !file.read(r.payload.data(), r.payload.size())) {
+            throw std::runtime_error("replay_from: truncated " + path);
+        }
+    }
+};
+
+inline std::string what_of(std::exception_ptr e) {
+    try {
+        std::rethrow_exception(e);
+    } catch(const std::exception& ex) {
+        return ex.what();
+    } catch(...) {
+        return "<not derived from std::exception>";
+    }
+}
+
+}
+
+}
+
+namespace operators {
+
+namespace detail {
+
+template<class T, class Serializer>
+struct record_to
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef source_value_type value_type;
+    typedef rxu::decay_t<Serializer> serializer_type;
+
+    std::string path;
+    serializer_type serializer;
+
+    record_to(std::string p, serializer_type s)
+        : path(std::move(p))
+        , serializer(std::move(s))
+    {
+    }
+
+    template<class Subscriber>
+    struct record_to_observer
+    {
+        typedef record_to_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        typedef rxn::detail::record_writer writer_type;
+        dest_type dest;
+        std::shared_ptr<writer_type> writer;
+        serializer_type serializer;
+
+        record_to_observer(dest_type d, std::shared_ptr<writer_type> w, serializer_type s)
+            : dest(std::move(d))
+            , writer(std::move(w))
+            , serializer(std::move(s))
+        {
+        }
+        void on_next(source_value_type v) const {
+            auto written = on_exception(
+                [&](){writer->next(serializer, v); return true;},
+                dest);
+            if (written.empty()) {
+                return;
+            }
+            dest.on_next(std::move(v));
+        }
+        void on_error(std::exception_ptr e) const {
+            writer->error(rxn::detail::what_of(e));
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            auto failed = writer->completed();
+            if (failed) {
+                dest.on_error(failed);
+                return;
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, const std::string& path, serializer_type s) {
+            // d owns the subscription and lives as long as this subscriber
+            auto cs = d.get_subscription().borrow();
+            std::shared_ptr<writer_type> w;
+            try {
+                w = std::make_shared<writer_type>(path);
+            } catch(...) {
+                // the source is not subscribed once d is unsubscribed
+                d.on_error(std::current_exception());
+            }
+            return subscriber<value_type, observer_type>(trace_id::make_next_id_subscriber(), std::move(cs), observer_type(this_type(std::move(d), std::move(w), std::move(s))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(record_to_observer<Subscriber>::make(std::move(dest), path, serializer)) {
+        return      record_to_observer<Subscriber>::make(std::move(dest), path, serializer);
+    }
+};
+
+template<class Serializer>
+class record_to_factory
+{
+    std::string path;
+    Serializer serializer;
+
+public:
+    record_to_factory(std::string p, Serializer s)
+        : path(std::move(p))
+        , serializer(std::move(s))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(record_to<rxu::value_type_t<rxu::decay_t<Observable>>, Serializer>(path, serializer))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(record_to<rxu::value_type_t<rxu::decay_t<Observable>>, Serializer>(path, serializer));
+    }
+};
+
+// picks bitwise_serializer for the value type of the source
+class record_to_bitwise_factory
+{
+    std::string path;
+
+public:
+    explicit record_to_bitwise_factory(std::string p)
+        : path(std::move(p))
+    {
+    }
+    template<class Observable>
+    auto operator()(Observable&& source)
+        -> decltype(source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(record_to<rxu::value_type_t<rxu::decay_t<Observable>>, rxu::bitwise_serializer<rxu::value_type_t<rxu::decay_t<Observable>>>>(path, rxu::bitwise_serializer<rxu::value_type_t<rxu::decay_t<Observable>>>()))) {
+        return      source.template lift<rxu::value_type_t<rxu::decay_t<Observable>>>(record_to<rxu::value_type_t<rxu::decay_t<Observable>>, rxu::bitwise_serializer<rxu::value_type_t<rxu::decay_t<Observable>>>>(path, rxu::bitwise_serializer<rxu::value_type_t<rxu::decay_t<Observable>>>()));
+    }
+};
+
+}
+
+/// writes each notification, and the time since the one before it, to the
+/// file at path and passes it on. the file is rewritten for each
+/// subscription. replay_from sends the notifications of the file again.
+/// the values are written by the serializer, which can be a
+/// rxu::bitwise_serializer for a trivially copyable value.
+inline auto record_to(std::string path)
+    ->      detail::record_to_bitwise_factory {
+    return  detail::record_to_bitwise_factory(std::move(path));
+}
+template<class Serializer>
+auto record_to(std::string path, Serializer s)
+    ->      detail::record_to_factory<Serializer> {
+    return  detail::record_to_factory<Serializer>(std::move(path), std::move(s));
+}
+
+}
+
+namespace sources {
+
+/// how replay_from spaces the notifications of a record file
+struct replay_time
+{
+    enum type {
+        /// each notification is sent as soon as the one before it
+        fast,
+        /// each notification is sent after the time that separated it from
+        /// the one before it when it was recorded
+        original
+    };
+};
+
+namespace detail {
+
+template<class T, class Serializer, class Coordination>
+struct replay_from : public source_base<rxu::decay_t<T>>
+{
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Serializer> serializer_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxn::detail::record_reader reader_type;
+
+    struct replay_from_initial_type
+    {
+        replay_from_initial_type(std::string p, replay_time::type m, serializer_type s, coordination_type cn)
+            : path(std::move(p))
+            , mode(m)
+            , serializer(std::move(s))
+            , coordination(std::move(cn))
+        {
+        }
+        std::string path;
+        replay_time::type mode;
+        serializer_type serializer;
+        coordination_type coordination;
+    };
+    replay_from_initial_type initial;
+
+    replay_from(std::string path, replay_time::type mode, serializer_type s, coordination_type cn)
+        : initial(std::move(path), mode, std::move(s), std::move(cn))
+    {
+    }
+
+    // notifications sent by one scheduled action in fast mode
+    enum { batch_size = 64 };
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct replay_from_state_type
+        {
+            replay_from_state_type(std::shared_ptr<reader_type> r, const replay_from_initial_type& i, output_type o)
+                : reader(std::move(r))
+                , mode(i.mode)
+                , serializer(i.serializer)
+                , pending(false)
+                , out(std::move(o))
+            {
+            }
+            std::shared_ptr<reader_type> reader;
+            replay_time::type mode;
+            serializer_type serializer;
+            // the record that was read and waits for its time
+            reader_type::record current;
+            bool pending;
+            rxsc::scheduler::clock_type::time_point due;
+            output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        auto path = initial.path;
+        auto reader = on_exception(
+            [&](){return std::make_shared<reader_type>(path);},
+            o);
+        if (reader.empty()) {
+            return;
+        }
+
+        auto state = std::make_shared<replay_from_state_type>(std::move(reader.get()), initial, coordinator.out(o));
+        state->due = controller.now();
+
+        auto producer = [state](const rxsc::schedulable& self){
+            auto& out = state->out;
+            for (int count = 0; count < batch_size; ++count) {
+                if (!out.is_subscribed()) {
+                    // terminate loop
+                    return;
+                }
+                if (!state->pending) {
+                    auto read = on_exception(
+                        [&](){state->reader->next(state->current); return true;},
+                        out);
+                    if (read.empty()) {
+                        return;
+                    }
+                    state->pending = true;
+                    if (state->mode == replay_time::original) {
+                        state->due += std::chrono::duration_cast<rxsc::scheduler::clock_type::duration>(state->current.delta);
+                        if (state->due > self.now()) {
+                            // wait for the time of the record
+                            self.schedule(state->due);
+                            return;
+                        }
+                    }
+                }
+                state->pending = false;
+                auto& r = state->current;
+                switch (r.kind) {
+                case rxn::detail::record_kind::on_next:
+                    {
+                        auto value = on_exception(
+                            [&](){return state->serializer.read(r.payload.data(), r.payload.size());},
+                            out);
+                        if (value.empty()) {
+                            return;
+                        }
+                        out.on_next(std::move(value.get()));
+                    }
+                    break;
+                case rxn::detail::record_kind::on_error:
+                    out.on_error(std::make_exception_ptr(rxn::recorded_error(std::string(r.payload.begin(), r.payload.end()))));
+                    return;
+                case rxn::detail::record_kind::on_completed:
+                    out.on_completed();
+                    return;
+                }
+            }
+            // tail recurse this same action so that other actions can run
+            // between batches
+            self();
+        };
+
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+
+        controller.schedule(selectedProducer.get());
+    }
+};
+
+}
+
+/// sends the notifications that record_to wrote to the file at path, as
+/// fast as possible or with their original spacing. a recorded on_error is
+/// sent as a rxn::recorded_error with the what() of the original.
+template<class T>
+auto replay_from(std::string path, replay_time::type mode = replay_time::fast)
+    ->      observable<T,   detail::replay_from<T, rxu::bitwise_serializer<T>, identity_one_worker>> {
+    return  observable<T,   detail::replay_from<T, rxu::bitwise_serializer<T>, identity_one_worker>>(
+                            detail::replay_from<T, rxu::bitwise_serializer<T>, identity_one_worker>(std::move(path), mode, rxu::bitwise_serializer<T>(), identity_current_thread()));
+}
+template<class T, class Serializer>
+auto replay_from(std::string path, replay_time::type mode, Serializer s)
+    ->      observable<T,   detail::replay_from<T, Serializer, identity_one_worker>> {
+    return  observable<T,   detail::replay_from<T, Serializer, identity_one_worker>>(
+                            detail::replay_from<T, Serializer, identity_one_worker>(std::move(path), mode, std::move(s), identity_current_thread()));
+}
+template<class T, class Serializer, class Coordination>
+auto replay_from(std::string path, replay_time::type mode, Serializer s, Coordination cn)
+    ->      observable<T,   detail::replay_from<T, Serializer, Coordination>> {
+    return  observable<T,   detail::replay_from<T, Serializer, Coordination>>(
+                            detail::replay_from<T, Serializer, Coordination>(std::move(path), mode, std::move(s), std::move(cn)));
+}
+
+}
+
+}
+
+#endif
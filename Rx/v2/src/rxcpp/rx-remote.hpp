@@ -0,0 +1,518 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_REMOTE_HPP)
+#define RXCPP_RX_REMOTE_HPP
+
+// remote sends the notifications of an observable over a socket, so it is not
+// included by rx.hpp. include "rxcpp/rx-remote.hpp" to use it.
+
+#include "rx-includes.hpp"
+#include "sources/rx-io.hpp"
+#include "subjects/rx-ipc.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+
+namespace rxcpp {
+
+/// remote sends an observable from one process to another over a stream
+/// socket and receives it there as an observable<T>.
+///
+/// a frame is a little endian u32 length, a u8 kind and the payload.
+/// a values frame holds a u32 count and then a u32 length and the bytes of
+/// each value. the values are written by the serializers of ipc_subject,
+/// so ipc_copy<T> needs the same T on both hosts. the completed frame is
+/// empty and the error frame holds the what() of the exception.
+///
+/// the receiver reads the socket only while its demand has values
+/// requested, so a slow subscriber fills the socket buffers and blocks the
+/// sender in its writes, which is the flow control of tcp.
+namespace remote {
+
+struct remote_error : public std::runtime_error
+{
+    explicit remote_error(const std::string& what)
+        : std::runtime_error(what)
+    {
+    }
+};
+
+namespace detail {
+
+struct frame_kind
+{
+    enum type {
+        values = 1,
+        completed,
+        error
+    };
+};
+
+enum {
+    // length and kind
+    frame_header_size = 5,
+    frame_count_size = 4
+};
+
+inline void put_u32(char* out, std::uint32_t v) {
+    out[0] = static_cast<char>(v & 0xff);
+    out[1] = static_cast<char>((v >> 8) & 0xff);
+    out[2] = static_cast<char>((v >> 16) & 0xff);
+    out[3] = static_cast<char>((v >> 24) & 0xff);
+}
+inline std::uint32_t get_u32(const char* in) {
+    auto b = reinterpret_cast<const unsigned char*>(in);
+    return std::uint32_t(b[0]) | (std::uint32_t(b[1]) << 8) | (std::uint32_t(b[2]) << 16) | (std::uint32_t(b[3]) << 24);
+}
+
+// writes all of the bytes, waiting while a non-blocking fd is full.
+// returns false when the connection is gone.
+inline bool write_all(int fd, const char* data, size_t size) {
+    while (size != 0) {
+#if defined(MSG_NOSIGNAL)
+        auto count = ::send(fd, data, size, MSG_NOSIGNAL);
+#else
+        auto count = ::write(fd, data, size);
+#endif
+        if (count > 0) {
+            data += count;
+            size -= count;
+        } else if (count < 0 && rxs::detail::io_would_block(errno)) {
+            pollfd p = {};
+            p.fd = fd;
+            p.events = POLLOUT;
+            ::poll(&p, 1, -1);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class T, class Serializer>
+struct sender_state : public std::enable_shared_from_this<sender_state<T, Serializer>>
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    sender_state(int fd, Serializer s, size_t mv, clock_type::duration md, rxsc::worker w)
+        : fd(fd)
+        , serializer(std::move(s))
+        , max_values((std::max)(mv, size_t(1)))
+        , max_delay(md)
+        , flusher(std::move(w))
+        , count(0)
+        , broken(false)
+    {
+        begin();
+    }
+
+    // a values frame with no values
+    void begin() {
+        frame.resize(frame_header_size + frame_count_size);
+        count = 0;
+    }
+
+    // call with lock held. writes the values frame when it has values.
+    bool flush() {
+        if (count == 0 || broken) {
+            return !broken;
+        }
+        put_u32(frame.data(), static_cast<std::uint32_t>(frame.size() - 4));
+        frame[4] = static_cast<char>(frame_kind::values);
+        put_u32(frame.data() + frame_header_size, static_cast<std::uint32_t>(count));
+        broken = !write_all(fd, frame.data(), frame.size());
+        begin();
+        return !broken;
+    }
+
+    // returns false when the connection is gone
+    bool put(const T& v) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (broken) {
+            return false;
+        }
+        auto at = frame.size();
+        frame.resize(at + 4 + 64);
+        for (;;) {
+            auto capacity = frame.size() - at - 4;
+            auto length = serializer.write(v, frame.data() + at + 4, capacity);
+            if (length <= capacity) {
+                frame.resize(at + 4 + length);
+                put_u32(frame.data() + at, static_cast<std::uint32_t>(length));
+                break;
+            }
+            frame.resize(at + 4 + length);
+        }
+        if (++count >= max_values || frame.size() >= max_bytes) {
+            return flush();
+        }
+        if (count == 1) {
+            auto keepAlive = this->shared_from_this();
+            flusher.schedule(flusher.now() + max_delay, [keepAlive](const rxsc::schedulable&){
+                std::unique_lock<std::mutex> guard(keepAlive->lock);
+                keepAlive->flush();
+            });
+        }
+        return true;
+    }
+
+    void end(frame_kind::type kind, const std::string& what) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (!flush()) {
+            return;
+        }
+        std::vector<char> last(frame_header_size + what.size());
+        put_u32(last.data(), static_cast<std::uint32_t>(last.size() - 4));
+        last[4] = static_cast<char>(kind);
+        std::memcpy(last.data() + frame_header_size, what.data(), what.size());
+        broken = !write_all(fd, last.data(), last.size());
+    }
+
+    enum { max_bytes = 64 * 1024 };
+
+    const int fd;
+    Serializer serializer;
+    const size_t max_values;
+    const clock_type::duration max_delay;
+    rxsc::worker flusher;
+
+    std::mutex lock;
+    std::vector<char> frame;
+    size_t count;
+    bool broken;
+};
+
+inline std::string what_of(std::exception_ptr e) {
+    try {
+        std::rethrow_exception(e);
+    } catch(const std::exception& ex) {
+        return ex.what();
+    } catch(...) {
+        return "remote: unknown error";
+    }
+}
+
+template<class T, class Serializer>
+struct receive : public rxs::source_base<T>
+{
+    struct receive_initial_type
+    {
+        receive_initial_type(int fd, Serializer s, rxcpp::demand d, std::shared_ptr<rxsc::io_event_loop> l)
+            : fd(fd)
+            , serializer(std::move(s))
+            , requests(std::move(d))
+            , loop(std::move(l))
+        {
+        }
+        int fd;
+        Serializer serializer;
+        rxcpp::demand requests;
+        std::shared_ptr<rxsc::io_event_loop> loop;
+    };
+    receive_initial_type initial;
+
+    receive(int fd, Serializer s, rxcpp::demand d, std::shared_ptr<rxsc::io_event_loop> l)
+        : initial(fd, std::move(s), std::move(d), std::move(l))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        // the bytes that were read and not yet parsed start at parsed. a
+        // values frame is parsed one value at a time, so that the missing
+        // demand can stop it between two values.
+        struct receive_state_type : public std::enable_shared_from_this<receive_state_type>
+        {
+            receive_state_type(const receive_initial_type& i, Subscriber o)
+                : fd(i.fd)
+                , serializer(i.serializer)
+                , requests(i.requests)
+                , loop(i.loop)
+                , parsed(0)
+                , values_left(0)
+                , out(std::move(o))
+                , resumer(loop->get_scheduler().create_worker(out.get_subscription()))
+            {
+            }
+
+            size_t available() const {
+                return bytes.size() - parsed;
+            }
+
+            // returns false when the stream ended or is waiting for demand
+            bool parse() {
+                for (;;) {
+                    if (!out.is_subscribed()) {
+                        return false;
+                    }
+                    if (values_left != 0) {
+                        if (available() < 4 || available() - 4 < get_u32(bytes.data() + parsed)) {
+                            return true;
+                        }
+                        auto keepAlive = this->shared_from_this();
+                        if (!requests.take_or_resume([keepAlive](){
+                                keepAlive->resumer.schedule([keepAlive](const rxsc::schedulable&){
+                                    if (keepAlive->parse()) {
+                                        keepAlive->watch();
+                                    }
+                                });
+                            })) {
+                            return false;
+                        }
+                        auto length = get_u32(bytes.data() + parsed);
+                        auto at = bytes.data() + parsed + 4;
+                        parsed += 4 + length;
+                        --values_left;
+                        auto value = on_exception(
+                            [&](){return serializer.read(at, length);},
+                            out);
+                        if (value.empty()) {
+                            return false;
+                        }
+                        out.on_next(std::move(value.get()));
+                        continue;
+                    }
+                    if (available() < frame_header_size) {
+                        return true;
+                    }
+                    auto length = get_u32(bytes.data() + parsed);
+                    auto kind = static_cast<frame_kind::type>(bytes[parsed + 4]);
+                    if (kind == frame_kind::values) {
+                        if (available() < frame_header_size + frame_count_size) {
+                            return true;
+                        }
+                        values_left = get_u32(bytes.data() + parsed + frame_header_size);
+                        parsed += frame_header_size + frame_count_size;
+                        continue;
+                    }
+                    if (available() < 4 + size_t(length)) {
+                        return true;
+                    }
+                    if (kind == frame_kind::completed) {
+                        out.on_completed();
+                    } else if (kind == frame_kind::error) {
+                        auto at = bytes.data() + parsed + frame_header_size;
+                        out.on_error(std::make_exception_ptr(remote_error(std::string(at, length - 1))));
+                    } else {
+                        out.on_error(std::make_exception_ptr(remote_error("remote: unknown frame")));
+                    }
+                    return false;
+                }
+            }
+
+            // call on a loop thread
+            void readable() {
+                if (!out.is_subscribed()) {
+                    return;
+                }
+                // move what is left to the front so that the buffer does not grow
+                if (parsed != 0) {
+                    bytes.erase(bytes.begin(), bytes.begin() + parsed);
+                    parsed = 0;
+                }
+                auto used = bytes.size();
+                bytes.resize(used + 64 * 1024);
+                auto count = ::read(fd, bytes.data() + used, bytes.size() - used);
+                bytes.resize(used + (count > 0 ? count : 0));
+                if (count == 0) {
+                    parse();
+                    if (out.is_subscribed()) {
+                        out.on_error(std::make_exception_ptr(remote_error("remote: the connection closed")));
+                    }
+                    return;
+                } else if (count < 0) {
+                    if (!rxs::detail::io_would_block(errno)) {
+                        out.on_error(std::make_exception_ptr(rxsc::detail::io_error("remote: read")));
+                    }
+                    return;
+                }
+                if (!parse()) {
+                    // stop reading until there is demand
+                    watching.unsubscribe();
+                }
+            }
+
+            void watch() {
+                watching = composite_subscription();
+                auto token = out.add(watching);
+                auto lifetime = out.get_subscription();
+                watching.add([lifetime, token](){
+                    lifetime.remove(token);
+                });
+                auto keepAlive = this->shared_from_this();
+                loop->watch_readable(fd, watching, [keepAlive](){
+                    keepAlive->readable();
+                });
+            }
+
+            const int fd;
+            Serializer serializer;
+            rxcpp::demand requests;
+            std::shared_ptr<rxsc::io_event_loop> loop;
+            std::vector<char> bytes;
+            size_t parsed;
+            std::uint32_t values_left;
+            Subscriber out;
+            rxsc::worker resumer;
+            composite_subscription watching;
+        };
+
+        auto state = std::make_shared<receive_state_type>(initial, o);
+        on_exception(
+            [&](){state->watch(); return true;},
+            o);
+    }
+};
+
+}
+
+/// sends each notification of source over the connected stream socket fd
+/// and returns the subscription to source. values are sent in frames of up
+/// to max_values, or of the values that arrived within max_delay of the
+/// first one. a full socket blocks the thread of source. fd must stay open
+/// until the subscription ends.
+template<class Observable, class Serializer>
+composite_subscription send(Observable source, int fd, Serializer s, size_t max_values = 64, rxsc::scheduler::clock_type::duration max_delay = std::chrono::milliseconds(1)) {
+    typedef rxu::value_type_t<rxu::decay_t<Observable>> value_type;
+    typedef detail::sender_state<value_type, Serializer> state_type;
+
+    composite_subscription lifetime;
+    auto flusher = rxsc::make_event_loop().create_worker(lifetime);
+    auto state = std::make_shared<state_type>(fd, std::move(s), max_values, max_delay, std::move(flusher));
+    source.subscribe(make_subscriber<value_type>(
+        lifetime,
+        [state, lifetime](const value_type& v){
+            if (!state->put(v)) {
+                lifetime.unsubscribe();
+            }
+        },
+        [state](std::exception_ptr e){
+            state->end(detail::frame_kind::error, detail::what_of(e));
+        },
+        [state](){
+            state->end(detail::frame_kind::completed, std::string());
+        }));
+    return lifetime;
+}
+template<class Observable>
+composite_subscription send(Observable source, int fd) {
+    typedef rxu::value_type_t<rxu::decay_t<Observable>> value_type;
+    return send(std::move(source), fd, subjects::ipc_copy<value_type>());
+}
+
+/// the notifications that a send on the other end of fd sent. the socket is
+/// only read while d has values requested. fd should be non-blocking and
+/// must stay open until the subscription ends.
+template<class T, class Serializer>
+auto receive(int fd, Serializer s, rxcpp::demand d, std::shared_ptr<rxsc::io_event_loop> loop)
+    ->      observable<T,   detail::receive<T, Serializer>> {
+    return  observable<T,   detail::receive<T, Serializer>>(
+                            detail::receive<T, Serializer>(fd, std::move(s), std::move(d), std::move(loop)));
+}
+template<class T, class Serializer>
+auto receive(int fd, Serializer s, rxcpp::demand d)
+    ->      observable<T,   detail::receive<T, Serializer>> {
+    return  receive<T>(fd, std::move(s), std::move(d), rxsc::make_io_event_loop());
+}
+template<class T>
+auto receive(int fd)
+    ->      observable<T,   detail::receive<T, subjects::ipc_copy<T>>> {
+    return  receive<T>(fd, subjects::ipc_copy<T>(), rxcpp::demand::unbounded(), rxsc::make_io_event_loop());
+}
+
+/// sends source to each connection accepted on listen_fd, and closes the
+/// connection when its copy of source ends.
+template<class Observable, class Serializer>
+composite_subscription serve(Observable source, int listen_fd, Serializer s) {
+    composite_subscription lifetime;
+    rxs::accept(listen_fd).subscribe(
+        lifetime,
+        [=](int client){
+            auto connection = send(source, client, s);
+            auto token = lifetime.add(connection);
+            connection.add([lifetime, token, client](){
+                lifetime.remove(token);
+                ::close(client);
+            });
+        },
+        [](std::exception_ptr){
+            // the listening socket failed, the connections continue
+        });
+    return lifetime;
+}
+template<class Observable>
+composite_subscription serve(Observable source, int listen_fd) {
+    typedef rxu::value_type_t<rxu::decay_t<Observable>> value_type;
+    return serve(std::move(source), listen_fd, subjects::ipc_copy<value_type>());
+}
+
+namespace detail {
+
+inline addrinfo* resolve(const std::string& host, unsigned short port, bool passive) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* found = nullptr;
+    auto service = std::to_string(port);
+    auto error = ::getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &found);
+    if (error != 0) {
+        throw remote_error(std::string("remote: resolve ") + host + ": " + ::gai_strerror(error));
+    }
+    return found;
+}
+
+}
+
+/// a non-blocking socket listening on port for tcp connections
+inline int listen(unsigned short port, const std::string& host = std::string(), int backlog = 64) {
+    std::unique_ptr<addrinfo, void(*)(addrinfo*)> found(detail::resolve(host, port, true), ::freeaddrinfo);
+    for (auto a = found.get(); !!a; a = a->ai_next) {
+        int fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (::bind(fd, a->ai_addr, a->ai_addrlen) == 0 && ::listen(fd, backlog) == 0) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            return fd;
+        }
+        ::close(fd);
+    }
+    throw rxsc::detail::io_error("remote: listen");
+}
+
+/// a non-blocking socket connected to host and port over tcp
+inline int connect(const std::string& host, unsigned short port) {
+    std::unique_ptr<addrinfo, void(*)(addrinfo*)> found(detail::resolve(host, port, false), ::freeaddrinfo);
+    for (auto a = found.get(); !!a; a = a->ai_next) {
+        int fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        if (::connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+            // the frames are already batched
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            return fd;
+        }
+        ::close(fd);
+    }
+    throw rxsc::detail::io_error("remote: connect");
+}
+
+}
+
+}
+
+#endif
@@ -59,12 +59,12 @@ public:
 /// the action uses recurse to coordinate the scheduler and the function.
 class recurse
 {
-    bool& isallowed;
+    const std::atomic<bool>& isallowed;
     mutable bool isrequested;
     recursed requestor;
     recurse operator=(const recurse&);
 public:
-    explicit recurse(bool& a)
+    explicit recurse(const std::atomic<bool>& a)
         : isallowed(a)
         , isrequested(true)
         , requestor(isrequested)
@@ -72,7 +72,7 @@ public:
     }
     /// does the scheduler allow tail-recursion now?
     inline bool is_allowed() const {
-        return isallowed;
+        return isallowed.load(std::memory_order_relaxed);
     }
     /// did the function request to be recursed?
     inline bool is_requested() const {
@@ -89,9 +89,11 @@ public:
 };
 
 /// recursion is used by the scheduler to signal to each action whether tail recursion is allowed.
+/// a scheduler whose callers queue work from other threads while an action
+/// runs can disallow tail recursion from those threads.
 class recursion
 {
-    mutable bool isallowed;
+    mutable std::atomic<bool> isallowed;
     recurse recursor;
     recursion operator=(const recursion&);
 public:
@@ -107,7 +109,7 @@ public:
     }
     /// set whether tail-recursion is allowed
     inline void reset(bool b = true) const {
-        isallowed = b;
+        isallowed.store(b, std::memory_order_relaxed);
     }
     /// get the recurse to pass into each action being called
     inline const recurse& get_recurse() const {
@@ -142,6 +144,11 @@ public:
         return action(detail::shared_empty());
     }
 
+    /// identifies the function, copies of an action have the same id
+    inline const void* get_id() const {
+        return inner.get();
+    }
+
     /// call the function
     inline void operator()(const schedulable& s, const recurse& r) const;
 };
@@ -157,6 +164,158 @@ struct worker_base : public subscription_base
     typedef tag_worker worker_tag;
 };
 
+/// what one thread that runs actions has done
+struct worker_stats
+{
+    typedef scheduler_base::clock_type clock_type;
+
+    worker_stats()
+        : busy(0)
+        , idle(0)
+        , actions(0)
+        , timed(0)
+        , late(0)
+        , max_lateness(0)
+        , steals(0)
+        , queued(0)
+    {
+    }
+
+    /// a timed action that starts later than this after it was due is late
+    static clock_type::duration late_after() {
+        return std::chrono::milliseconds(1);
+    }
+
+    std::thread::id thread;
+    /// time spent running actions
+    clock_type::duration busy;
+    /// time spent waiting for actions
+    clock_type::duration idle;
+    std::uint64_t actions;
+    /// actions that were scheduled for a time
+    std::uint64_t timed;
+    /// timed actions that started more than late_after() after they were due
+    std::uint64_t late;
+    clock_type::duration max_lateness;
+    /// runs of work taken from the queue of another thread
+    std::uint64_t steals;
+    /// work waiting now
+    size_t queued;
+};
+
+namespace detail {
+
+// the stats of one thread that runs actions. only that thread writes them,
+// so a plain load and store is enough, except for the count of actions
+// that were queued.
+struct worker_counters
+{
+    typedef scheduler_base::clock_type clock_type;
+    typedef clock_type::duration::rep rep_type;
+
+    worker_counters()
+        : busy(0)
+        , idle(0)
+        , max_lateness(0)
+        , actions(0)
+        , timed(0)
+        , late(0)
+        , steals(0)
+        , pushed(0)
+        , popped(0)
+        , next_report(clock_type::now() + report_period())
+    {
+    }
+
+    /// how often a thread passes its stats to the tracer, while it is awake
+    static clock_type::duration report_period() {
+        return std::chrono::seconds(1);
+    }
+
+    template<class T>
+    static void add(std::atomic<T>& c, T by) {
+        c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    void ran(clock_type::duration d) {
+        add(busy, d.count());
+        add(actions, std::uint64_t(1));
+    }
+    void waited(clock_type::duration d) {
+        add(idle, d.count());
+    }
+    void started_timed(clock_type::duration lateness) {
+        add(timed, std::uint64_t(1));
+        if (lateness > worker_stats::late_after()) {
+            add(late, std::uint64_t(1));
+        }
+        if (lateness.count() > max_lateness.load(std::memory_order_relaxed)) {
+            max_lateness.store(lateness.count(), std::memory_order_relaxed);
+        }
+    }
+    void stole() {
+        add(steals, std::uint64_t(1));
+    }
+    // called by the threads that schedule
+    void queued() {
+        pushed.fetch_add(1, std::memory_order_relaxed);
+    }
+    void dequeued() {
+        add(popped, size_t(1));
+    }
+
+    // true once each report_period()
+    bool report_due(clock_type::time_point now) {
+        if (now < next_report) {
+            return false;
+        }
+        next_report = now + report_period();
+        return true;
+    }
+
+    worker_stats read(size_t also_queued = 0) const {
+        worker_stats result;
+        result.busy = clock_type::duration(busy.load(std::memory_order_relaxed));
+        result.idle = clock_type::duration(idle.load(std::memory_order_relaxed));
+        result.max_lateness = clock_type::duration(max_lateness.load(std::memory_order_relaxed));
+        result.actions = actions.load(std::memory_order_relaxed);
+        result.timed = timed.load(std::memory_order_relaxed);
+        result.late = late.load(std::memory_order_relaxed);
+        result.steals = steals.load(std::memory_order_relaxed);
+        auto in = pushed.load(std::memory_order_relaxed);
+        auto out = popped.load(std::memory_order_relaxed);
+        result.queued = (in > out ? in - out : 0) + also_queued;
+        return result;
+    }
+
+    std::atomic<rep_type> busy;
+    std::atomic<rep_type> idle;
+    std::atomic<rep_type> max_lateness;
+    std::atomic<std::uint64_t> actions;
+    std::atomic<std::uint64_t> timed;
+    std::atomic<std::uint64_t> late;
+    std::atomic<std::uint64_t> steals;
+    std::atomic<size_t> pushed;
+    std::atomic<size_t> popped;
+    // only used by the thread
+    clock_type::time_point next_report;
+};
+
+}
+
+/// the lane of the queue of a thread that the actions of a worker wait in.
+/// the schedulers that keep lanes, like event_loop, run the actions in the
+/// high lane first and bulk last.
+struct schedule_priority
+{
+    enum type {
+        high,
+        normal,
+        bulk,
+        lanes
+    };
+};
+
 class worker_interface
     : public std::enable_shared_from_this<worker_interface>
 {
@@ -171,10 +330,45 @@ public:
 
     virtual void schedule(const schedulable& scbl) const = 0;
     virtual void schedule(clock_type::time_point when, const schedulable& scbl) const = 0;
+
+    /// insert the schedulables in order, to run as soon as possible. the
+    /// schedulers that queue override this to lock and wake once for all.
+    virtual void schedule_batch(const std::vector<schedulable>& batch) const;
+
+    /// the stats of the thread that runs the actions, when it keeps them
+    virtual rxu::maybe<worker_stats> stats() const {
+        return rxu::maybe<worker_stats>();
+    }
+
+    /// the worker that runs the actions scheduled here. the workers that
+    /// pass their actions on to another worker return the executor of that one.
+    virtual const worker_interface* executor() const {
+        return this;
+    }
 };
 
 namespace detail {
 
+// the executor of the action that is running on this thread
+inline const worker_interface*& current_executor() {
+    static RXCPP_THREAD_LOCAL const worker_interface* executor;
+    return executor;
+}
+
+struct executor_scope
+{
+    explicit executor_scope(const worker_interface* e)
+        : previous(current_executor())
+    {
+        current_executor() = e;
+    }
+    ~executor_scope()
+    {
+        current_executor() = previous;
+    }
+    const worker_interface* previous;
+};
+
 template<class F>
 struct is_action_function
 {
@@ -248,6 +442,23 @@ public:
         return inner->now();
     }
 
+    /// the stats of the thread that runs the actions of this worker, when it keeps them
+    inline rxu::maybe<worker_stats> stats() const {
+        return !!inner ? inner->stats() : rxu::maybe<worker_stats>();
+    }
+
+    /// the worker_interface that runs the actions of this worker
+    inline const worker_interface* executor() const {
+        return !!inner ? inner->executor() : nullptr;
+    }
+
+    /// true when the calling thread is inside an action of this worker or
+    /// of another worker with the same executor
+    inline bool is_running() const {
+        auto e = executor();
+        return !!e && e == detail::current_executor();
+    }
+
     /// insert the supplied schedulable to be run as soon as possible
     inline void schedule(const schedulable& scbl) const {
         // force rebinding scbl to this worker
@@ -269,6 +480,11 @@ public:
         schedule_rebind(now() + when, scbl);
     }
 
+    /// insert each of the supplied schedulables, in order, to be run as soon
+    /// as possible. the worker is locked and woken once for the batch.
+    template<class Range>
+    void schedule_batch(const Range& scbls) const;
+
     /// insert the supplied schedulable to be run at the initial time specified and then again at initial + (N * period)
     /// this will continue until the worker or schedulable is unsubscribed.
     inline void schedule_periodically(clock_type::time_point initial, clock_type::duration period, const schedulable& scbl) const {
@@ -324,6 +540,105 @@ inline bool operator!=(const worker& lhs, const worker& rhs) {
     return !(lhs == rhs);
 }
 
+/// a worker that knows the type of its worker_interface. schedule calls the
+/// implementation of WorkerInterface without a virtual call, so that it can
+/// be inlined. it converts to a worker for the code that is not typed.
+///
+/// WorkerInterface must be the exact type of the implementation.
+template<class WorkerInterface>
+class typed_worker : public worker_base
+{
+    typedef typed_worker<WorkerInterface> this_type;
+    worker erased;
+    const WorkerInterface* inner;
+public:
+    typedef WorkerInterface worker_interface_type;
+    typedef scheduler_base::clock_type clock_type;
+    typedef composite_subscription::weak_subscription weak_subscription;
+
+    typed_worker()
+        : inner(nullptr)
+    {
+    }
+    typed_worker(composite_subscription cs, std::shared_ptr<const WorkerInterface> i)
+        : erased(std::move(cs), i)
+        , inner(i.get())
+    {
+    }
+
+    /// the worker that this types
+    inline const worker& as_worker() const {
+        return erased;
+    }
+    inline operator const worker&() const {
+        return erased;
+    }
+
+    inline const composite_subscription& get_subscription() const {
+        return erased.get_subscription();
+    }
+
+    // composite_subscription
+    //
+    inline bool is_subscribed() const {
+        return erased.is_subscribed();
+    }
+    inline weak_subscription add(subscription s) const {
+        return erased.add(std::move(s));
+    }
+    inline void remove(weak_subscription w) const {
+        return erased.remove(std::move(w));
+    }
+    inline void clear() const {
+        return erased.clear();
+    }
+    inline void unsubscribe() const {
+        return erased.unsubscribe();
+    }
+
+    // worker_interface
+    //
+    inline clock_type::time_point now() const {
+        return inner->WorkerInterface::now();
+    }
+    inline rxu::maybe<worker_stats> stats() const {
+        return erased.stats();
+    }
+
+    /// insert the supplied schedulable to be run as soon as possible
+    inline void schedule(const schedulable& scbl) const;
+
+    /// insert the supplied schedulable to be run at the time specified
+    inline void schedule(clock_type::time_point when, const schedulable& scbl) const;
+
+    /// insert the supplied schedulable to be run at now() + the delay specified
+    inline void schedule(clock_type::duration when, const schedulable& scbl) const {
+        schedule(now() + when, scbl);
+    }
+
+    /// use the supplied arguments to make a schedulable and then insert it to be run
+    template<class Arg0, class... ArgN>
+    auto schedule(Arg0&& a0, ArgN&&... an) const
+        -> typename std::enable_if<
+            (detail::is_action_function<Arg0>::value ||
+            is_subscription<Arg0>::value) &&
+            !is_schedulable<Arg0>::value>::type;
+
+    /// use the supplied arguments to make a schedulable and then insert it to be run
+    template<class Arg0, class... ArgN>
+    auto schedule(clock_type::time_point when, Arg0&& a0, ArgN&&... an) const
+        -> typename std::enable_if<
+            (detail::is_action_function<Arg0>::value ||
+            is_subscription<Arg0>::value) &&
+            !is_schedulable<Arg0>::value>::type;
+
+    /// periodic actions are not on the fast path, they use the worker
+    template<class... ArgN>
+    void schedule_periodically(ArgN&&... an) const {
+        erased.schedule_periodically(std::forward<ArgN>(an)...);
+    }
+};
+
 class scheduler_interface
     : public std::enable_shared_from_this<scheduler_interface>
 {
@@ -337,6 +652,28 @@ public:
     virtual clock_type::time_point now() const = 0;
 
     virtual worker create_worker(composite_subscription cs) const = 0;
+
+    /// a worker whose actions wait in lane on the thread that runs them. the
+    /// schedulers without lanes ignore lane.
+    virtual worker create_lane_worker(composite_subscription cs, schedule_priority::type) const {
+        return create_worker(cs);
+    }
+
+    /// the stats of each thread that runs actions, when they are kept
+    virtual std::vector<worker_stats> stats() const {
+        return std::vector<worker_stats>();
+    }
+
+    /// start the threads that would otherwise be started when a worker
+    /// first needs them
+    virtual void warm_up() const {
+    }
+
+    /// stop taking new work, run the queued work until the deadline and then
+    /// cancel what is left. true when nothing was cancelled.
+    virtual bool shutdown(clock_type::time_point) const {
+        return true;
+    }
 };
 
 
@@ -355,6 +692,7 @@ class scheduler : public scheduler_base
     friend bool operator==(const scheduler&, const scheduler&);
 public:
     typedef scheduler_base::clock_type clock_type;
+    typedef worker worker_type;
 
     scheduler()
     {
@@ -380,13 +718,176 @@ public:
     inline worker create_worker(composite_subscription cs = composite_subscription()) const {
         return inner->create_worker(cs);
     }
+    /// create a worker whose actions wait in lane, so that control messages
+    /// on a high lane do not wait behind the bulk data on the same thread.
+    inline worker create_worker(composite_subscription cs, schedule_priority::type lane) const {
+        return inner->create_lane_worker(cs, lane);
+    }
+    /// the stats of each thread that runs actions for this scheduler. the
+    /// schedulers that run actions on their own threads keep them.
+    inline std::vector<worker_stats> stats() const {
+        return inner->stats();
+    }
+    /// start the threads of this scheduler now, for servers that would
+    /// rather not pay for them on the first worker. the schedulers that
+    /// start their threads lazily, like event_loop, override it.
+    inline void warm_up() const {
+        inner->warm_up();
+    }
+    /// stop taking new work, drain the work that is queued until deadline
+    /// and then cancel the rest. returns false when work was cancelled. the
+    /// schedulers that run actions on their own threads override it. the
+    /// shared instances, like make_new_thread(), refuse it and return false.
+    inline bool shutdown(clock_type::time_point deadline) const {
+        return inner->shutdown(deadline);
+    }
 };
 
+inline bool operator==(const scheduler& lhs, const scheduler& rhs) {
+    return lhs.inner == rhs.inner;
+}
+inline bool operator!=(const scheduler& lhs, const scheduler& rhs) {
+    return !(lhs == rhs);
+}
+
 template<class Scheduler, class... ArgN>
 inline scheduler make_scheduler(ArgN&&... an) {
     return scheduler(std::static_pointer_cast<scheduler_interface>(std::make_shared<Scheduler>(std::forward<ArgN>(an)...)));
 }
 
+/// a scheduler that knows its type, so that its workers are typed_workers.
+/// Scheduler provides the implementation type of its workers as
+/// worker_interface_type and makes them with create_worker_interface(cs).
+/// it converts to a scheduler for the code that is not typed.
+template<class Scheduler>
+class typed_scheduler : public scheduler_base
+{
+    typedef typed_scheduler<Scheduler> this_type;
+    std::shared_ptr<const Scheduler> inner;
+    scheduler erased;
+public:
+    typedef scheduler_base::clock_type clock_type;
+    typedef typed_worker<typename Scheduler::worker_interface_type> worker_type;
+
+    explicit typed_scheduler(std::shared_ptr<const Scheduler> i)
+        : inner(i)
+        , erased(std::static_pointer_cast<const scheduler_interface>(i))
+    {
+    }
+
+    /// the scheduler that this types
+    inline const scheduler& as_scheduler() const {
+        return erased;
+    }
+    inline operator const scheduler&() const {
+        return erased;
+    }
+
+    inline clock_type::time_point now() const {
+        return inner->Scheduler::now();
+    }
+    inline worker_type create_worker(composite_subscription cs = composite_subscription()) const {
+        auto w = inner->create_worker_interface(cs);
+        return worker_type(std::move(cs), std::move(w));
+    }
+    inline std::vector<worker_stats> stats() const {
+        return erased.stats();
+    }
+    inline void warm_up() const {
+        erased.warm_up();
+    }
+    inline bool shutdown(clock_type::time_point deadline) const {
+        return erased.shutdown(deadline);
+    }
+};
+
+template<class Scheduler, class... ArgN>
+inline typed_scheduler<Scheduler> make_typed_scheduler(ArgN&&... an) {
+    return typed_scheduler<Scheduler>(std::make_shared<Scheduler>(std::forward<ArgN>(an)...));
+}
+
+namespace detail {
+
+struct lane_scheduler : public scheduler_interface
+{
+    lane_scheduler(scheduler sc, schedule_priority::type l)
+        : inner(std::move(sc))
+        , lane(l)
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return inner.now();
+    }
+    virtual worker create_worker(composite_subscription cs) const {
+        return inner.create_worker(std::move(cs), lane);
+    }
+    virtual worker create_lane_worker(composite_subscription cs, schedule_priority::type l) const {
+        return inner.create_worker(std::move(cs), l);
+    }
+    virtual std::vector<worker_stats> stats() const {
+        return inner.stats();
+    }
+    virtual void warm_up() const {
+        inner.warm_up();
+    }
+    virtual bool shutdown(clock_type::time_point deadline) const {
+        return inner.shutdown(deadline);
+    }
+
+    scheduler inner;
+    schedule_priority::type lane;
+};
+
+}
+
+namespace detail {
+
+// the instance that make_new_thread() and the like share with the whole
+// process. shutting it down would leave every later user of it without
+// threads, so shutdown is refused.
+struct shared_scheduler : public scheduler_interface
+{
+    explicit shared_scheduler(scheduler sc)
+        : inner(std::move(sc))
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return inner.now();
+    }
+    virtual worker create_worker(composite_subscription cs) const {
+        return inner.create_worker(std::move(cs));
+    }
+    virtual worker create_lane_worker(composite_subscription cs, schedule_priority::type l) const {
+        return inner.create_worker(std::move(cs), l);
+    }
+    virtual std::vector<worker_stats> stats() const {
+        return inner.stats();
+    }
+    virtual void warm_up() const {
+        inner.warm_up();
+    }
+    virtual bool shutdown(clock_type::time_point) const {
+        return false;
+    }
+
+    scheduler inner;
+};
+
+template<class Scheduler, class... ArgN>
+inline scheduler make_shared_scheduler(ArgN&&... an) {
+    return make_scheduler<shared_scheduler>(make_scheduler<Scheduler>(std::forward<ArgN>(an)...));
+}
+
+}
+
+/// a scheduler whose workers are the workers of sc in lane. a coordination
+/// such as observe_on_one_worker on it delivers in that lane.
+inline scheduler make_lane_scheduler(scheduler sc, schedule_priority::type lane) {
+    return make_scheduler<detail::lane_scheduler>(std::move(sc), lane);
+}
+
 
 class schedulable : public schedulable_base
 {
@@ -605,6 +1106,12 @@ public:
     }
 };
 
+inline void worker_interface::schedule_batch(const std::vector<schedulable>& batch) const {
+    for (auto& scbl : batch) {
+        schedule(scbl);
+    }
+}
+
 struct current_thread;
 
 namespace detail {
@@ -617,24 +1124,50 @@ class action_type
 public:
     typedef std::function<void(const schedulable&, const recurse&)> function_type;
 
-private:
-    function_type f;
-
-public:
     action_type()
     {
     }
+    virtual ~action_type()
+    {
+    }
 
-    action_type(function_type f)
-        : f(std::move(f))
+    /// the empty action must not be called
+    virtual void operator()(const schedulable&, const recurse&) {
+        abort();
+    }
+};
+
+// the function is held in the same allocation as the action and its count,
+// instead of in a function_type that would allocate again for most lambdas.
+template<class F>
+class action_function : public action_type
+{
+    F fn;
+
+public:
+    explicit action_function(F f)
+        : fn(std::move(f))
     {
     }
 
-    inline void operator()(const schedulable& s, const recurse& r) {
-        if (!f) {
-            abort();
+    // tail-recurse inside of the virtual function call
+    // until a new action, lifetime or scheduler is returned
+    virtual void operator()(const schedulable& s, const recurse& r) {
+        trace_activity().action_enter(s);
+        auto scope = s.set_recursed(r);
+        executor_scope running(s.get_worker().executor());
+        while (s.is_subscribed()) {
+            r.reset();
+            fn(s);
+            if (!r.is_allowed() || !r.is_requested()) {
+                if (r.is_requested()) {
+                    s.schedule();
+                }
+                break;
+            }
+            trace_activity().action_recurse(s);
         }
-        f(s, r);
+        trace_activity().action_return(s);
     }
 };
 
@@ -651,26 +1184,7 @@ inline action make_action_empty() {
 template<class F>
 inline action make_action(F&& f) {
     static_assert(detail::is_action_function<F>::value, "action function must be void(schedulable)");
-    auto fn = std::forward<F>(f);
-    return action(std::make_shared<detail::action_type>(
-        // tail-recurse inside of the virtual function call
-        // until a new action, lifetime or scheduler is returned
-        [fn](const schedulable& s, const recurse& r) {
-            trace_activity().action_enter(s);
-            auto scope = s.set_recursed(r);
-            while (s.is_subscribed()) {
-                r.reset();
-                fn(s);
-                if (!r.is_allowed() || !r.is_requested()) {
-                    if (r.is_requested()) {
-                        s.schedule();
-                    }
-                    break;
-                }
-                trace_activity().action_recurse(s);
-            }
-            trace_activity().action_return(s);
-        }));
+    return action(std::make_shared<detail::action_function<rxu::decay_t<F>>>(std::forward<F>(f)));
 }
 
 // copy
@@ -751,6 +1265,27 @@ void worker::schedule_rebind(const schedulable& scbl, ArgN&&... an) const {
     trace_activity().schedule_return(*inner.get());
 }
 
+template<class Range>
+void worker::schedule_batch(const Range& scbls) const {
+    std::vector<schedulable> batch;
+    for (auto& scbl : scbls) {
+        // rebind scbl to this worker, unless it already is
+        if (scbl.get_worker() == *this) {
+            batch.push_back(scbl);
+        } else {
+            batch.push_back(make_schedulable(scbl, *this));
+        }
+        trace_activity().schedule_enter(*inner.get(), batch.back());
+    }
+    if (batch.empty()) {
+        return;
+    }
+    inner->schedule_batch(batch);
+    for (size_t i = 0; i != batch.size(); ++i) {
+        trace_activity().schedule_return(*inner.get());
+    }
+}
+
 template<class Arg0, class... ArgN>
 auto worker::schedule(clock_type::time_point when, Arg0&& a0, ArgN&&... an) const
     -> typename std::enable_if<
@@ -799,6 +1334,47 @@ void worker::schedule_periodically_rebind(clock_type::time_point initial, clock_
     trace_activity().schedule_when_return(*inner.get());
 }
 
+template<class WorkerInterface>
+void typed_worker<WorkerInterface>::schedule(const schedulable& scbl) const {
+    // force rebinding scbl to this worker
+    auto rescbl = make_schedulable(scbl, erased);
+    trace_activity().schedule_enter(*inner, rescbl);
+    inner->WorkerInterface::schedule(rescbl);
+    trace_activity().schedule_return(*inner);
+}
+template<class WorkerInterface>
+void typed_worker<WorkerInterface>::schedule(clock_type::time_point when, const schedulable& scbl) const {
+    // force rebinding scbl to this worker
+    auto rescbl = make_schedulable(scbl, erased);
+    trace_activity().schedule_when_enter(*inner, when, rescbl);
+    inner->WorkerInterface::schedule(when, rescbl);
+    trace_activity().schedule_when_return(*inner);
+}
+template<class WorkerInterface>
+template<class Arg0, class... ArgN>
+auto typed_worker<WorkerInterface>::schedule(Arg0&& a0, ArgN&&... an) const
+    -> typename std::enable_if<
+        (detail::is_action_function<Arg0>::value ||
+        is_subscription<Arg0>::value) &&
+        !is_schedulable<Arg0>::value>::type {
+    auto scbl = make_schedulable(erased, std::forward<Arg0>(a0), std::forward<ArgN>(an)...);
+    trace_activity().schedule_enter(*inner, scbl);
+    inner->WorkerInterface::schedule(scbl);
+    trace_activity().schedule_return(*inner);
+}
+template<class WorkerInterface>
+template<class Arg0, class... ArgN>
+auto typed_worker<WorkerInterface>::schedule(clock_type::time_point when, Arg0&& a0, ArgN&&... an) const
+    -> typename std::enable_if<
+        (detail::is_action_function<Arg0>::value ||
+        is_subscription<Arg0>::value) &&
+        !is_schedulable<Arg0>::value>::type {
+    auto scbl = make_schedulable(erased, std::forward<Arg0>(a0), std::forward<ArgN>(an)...);
+    trace_activity().schedule_when_enter(*inner, when, scbl);
+    inner->WorkerInterface::schedule(when, scbl);
+    trace_activity().schedule_when_return(*inner);
+}
+
 namespace detail {
 
 template<class TimePoint>
@@ -840,16 +1416,39 @@ private:
         }
     };
 
-    typedef std::priority_queue<
+    struct queue_type : public std::priority_queue<
         elem_type,
         container_type,
         compare_elem
-    > queue_type;
+    >
+    {
+        template<class Pred>
+        size_t remove_if(Pred p) {
+            auto end = std::remove_if(this->c.begin(), this->c.end(), p);
+            auto removed = static_cast<size_t>(this->c.end() - end);
+            if (removed > 0) {
+                this->c.erase(end, this->c.end());
+                std::make_heap(this->c.begin(), this->c.end(), this->comp);
+            }
+            return removed;
+        }
+        elem_type take() {
+            std::pop_heap(this->c.begin(), this->c.end(), this->comp);
+            elem_type e(std::move(this->c.back()));
+            this->c.pop_back();
+            return e;
+        }
+    };
 
     queue_type queue;
 
     int64_t ordinal;
 public:
+    schedulable_queue()
+        : ordinal(0)
+    {
+    }
+
     const_reference top() const {
         return queue.top().first;
     }
@@ -862,6 +1461,17 @@ public:
         return queue.empty();
     }
 
+    size_t size() const {
+        return queue.size();
+    }
+
+    /// remove the items that are no longer subscribed. O(n)
+    size_t compact() {
+        return queue.remove_if([](const elem_type& e){
+            return !e.first.what.is_subscribed();
+        });
+    }
+
     void push(const item_type& value) {
         queue.push(elem_type(value, ordinal++));
     }
@@ -869,6 +1479,305 @@ public:
     void push(item_type&& value) {
         queue.push(elem_type(std::move(value), ordinal++));
     }
+
+    /// move the first item out, with its place in the order
+    elem_type take() {
+        return queue.take();
+    }
+
+    /// put back an item that was taken, in the place that it had
+    void restore(elem_type e) {
+        queue.push(std::move(e));
+    }
+};
+
+inline int lowest_bit(uint64_t v) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    int result = 0;
+    while (!(v & 1)) {
+        v >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+inline int highest_bit(uint64_t v) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#else
+    int result = 0;
+    while (v >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Hierarchical timing wheel with the same interface as schedulable_queue.
+//
+// Time is divided into ticks of a fixed resolution. Level 0 has a slot for
+// each of the 64 ticks in the current block, level 1 has a slot for each of
+// the 64 blocks of 64 ticks and so on. push and erase are O(1), the slot
+// that holds the earliest items is found from a bitmap of occupied slots per
+// level. Items in a slot are cascaded to the lower levels when the wheel
+// reaches that slot.
+//
+// Items in the same tick are kept in fifo order, so items are sorted by
+// tick and then by the order they were pushed. Items that are earlier than
+// the block the wheel has reached are kept in a short list sorted on when.
+template<class TimePoint>
+class timer_wheel
+{
+public:
+    typedef time_schedulable<TimePoint> item_type;
+    typedef const item_type& const_reference;
+    typedef typename TimePoint::duration duration_type;
+
+private:
+    enum {
+        slot_bits = 6,
+        slot_count = 1 << slot_bits,
+        level_count = (64 + slot_bits - 1) / slot_bits
+    };
+
+    struct elem_type
+    {
+        elem_type(item_type i, uint64_t t)
+            : item(std::move(i))
+            , tick(t)
+            , level(0)
+            , slot(0)
+        {
+        }
+        item_type item;
+        uint64_t tick;
+        // level -1 is the overdue list
+        int level;
+        int slot;
+    };
+    typedef std::list<elem_type> list_type;
+
+public:
+    /// remains valid until the item is popped or erased.
+    typedef typename list_type::iterator handle_type;
+
+private:
+    duration_type resolution;
+    mutable list_type slots[level_count][slot_count];
+    mutable uint64_t occupied[level_count];
+    mutable list_type overdue;
+    mutable uint64_t current;
+    size_t count;
+
+    timer_wheel(const timer_wheel&);
+    timer_wheel& operator=(const timer_wheel&);
+
+    uint64_t tick_of(const TimePoint& when) const {
+        auto since = when.time_since_epoch();
+        if (since.count() < 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(since / resolution);
+    }
+
+    void place(list_type& from, handle_type it) const {
+        if (it->tick < current) {
+            auto when = it->item.when;
+            auto position = std::find_if(overdue.begin(), overdue.end(), [&](const elem_type& e){
+                return when < e.item.when;
+            });
+            it->level = -1;
+            overdue.splice(position, from, it);
+            return;
+        }
+        int level = it->tick == current ? 0 : highest_bit(it->tick ^ current) / slot_bits;
+        int slot = static_cast<int>((it->tick >> (level * slot_bits)) & (slot_count - 1));
+        it->level = level;
+        it->slot = slot;
+        slots[level][slot].splice(slots[level][slot].end(), from, it);
+        occupied[level] |= uint64_t(1) << slot;
+    }
+
+    handle_type earliest() const {
+        if (!overdue.empty()) {
+            return overdue.begin();
+        }
+        for (;;) {
+            if (occupied[0]) {
+                return slots[0][lowest_bit(occupied[0])].begin();
+            }
+            int level = 1;
+            while (level < level_count && !occupied[level]) {
+                ++level;
+            }
+            if (level == level_count) {
+                abort();
+            }
+            int slot = lowest_bit(occupied[level]);
+            int shift = level * slot_bits;
+            uint64_t kept = shift + slot_bits >= 64 ? 0 : ~((uint64_t(1) << (shift + slot_bits)) - 1);
+            current = (current & kept) | (uint64_t(slot) << shift);
+            occupied[level] &= ~(uint64_t(1) << slot);
+            auto& from = slots[level][slot];
+            while (!from.empty()) {
+                place(from, from.begin());
+            }
+        }
+    }
+
+public:
+    explicit timer_wheel(duration_type r = std::chrono::milliseconds(1))
+        : resolution(r.count() > 0 ? r : duration_type(1))
+        , current(0)
+        , count(0)
+    {
+        std::fill(std::begin(occupied), std::end(occupied), 0);
+    }
+
+    const_reference top() const {
+        return earliest()->item;
+    }
+
+    void pop() {
+        erase(earliest());
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    handle_type push(item_type value) {
+        auto tick = tick_of(value.when);
+        if (count == 0) {
+            current = tick;
+        }
+        list_type incoming;
+        incoming.emplace_back(std::move(value), tick);
+        auto it = incoming.begin();
+        place(incoming, it);
+        ++count;
+        return it;
+    }
+
+    /// remove the items that are no longer subscribed. O(n)
+    size_t compact() {
+        auto before = count;
+        auto unsubscribed = [](const elem_type& e){
+            return !e.item.what.is_subscribed();
+        };
+        count -= overdue.size();
+        overdue.remove_if(unsubscribed);
+        count += overdue.size();
+        for (int level = 0; level < level_count; ++level) {
+            auto bits = occupied[level];
+            while (bits) {
+                auto slot = lowest_bit(bits);
+                bits &= bits - 1;
+                auto& items = slots[level][slot];
+                count -= items.size();
+                items.remove_if(unsubscribed);
+                count += items.size();
+                if (items.empty()) {
+                    occupied[level] &= ~(uint64_t(1) << slot);
+                }
+            }
+        }
+        return before - count;
+    }
+
+    void erase(handle_type it) {
+        if (it->level < 0) {
+            overdue.erase(it);
+        } else {
+            auto& slot = slots[it->level][it->slot];
+            auto bit = uint64_t(1) << it->slot;
+            auto level = it->level;
+            slot.erase(it);
+            if (slot.empty()) {
+                occupied[level] &= ~bit;
+            }
+        }
+        --count;
+    }
+};
+
+// Unbounded fifo queue that any number of threads may push into
+// without a lock while a single consumer thread pops.
+//
+// push links a node with one atomic exchange. a pop may briefly fail
+// while empty() is false when a producer has claimed the head but not
+// yet linked its node, the consumer must retry in that case.
+template<class T>
+class mpsc_queue
+{
+    struct node
+    {
+        node()
+            : next(nullptr)
+        {
+        }
+        explicit node(T v)
+            : next(nullptr)
+            , value(std::move(v))
+        {
+        }
+        std::atomic<node*> next;
+        rxu::maybe<T> value;
+    };
+
+    // the producers write head and the consumer writes tail
+    std::atomic<node*> head;
+    rxu::detail::cache_line_pad head_pad;
+    node* tail;
+
+    mpsc_queue(const mpsc_queue&);
+    mpsc_queue& operator=(const mpsc_queue&);
+public:
+    mpsc_queue()
+        : head(new node())
+    {
+        tail = head.load();
+    }
+    ~mpsc_queue()
+    {
+        while (tail) {
+            auto next = tail->next.load();
+            delete tail;
+            tail = next;
+        }
+    }
+
+    /// called by any thread
+    void push(T value) {
+        auto n = new node(std::move(value));
+        auto prev = head.exchange(n);
+        prev->next.store(n);
+    }
+
+    /// called by the consumer thread
+    bool empty() const {
+        return head.load() == tail;
+    }
+
+    /// called by the consumer thread
+    bool pop(T& out) {
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        out = std::move(next->value.get());
+        next->value.reset();
+        delete tail;
+        tail = next;
+        return true;
+    }
 };
 
 }
@@ -881,8 +1790,13 @@ namespace rxsc=schedulers;
 #include "schedulers/rx-currentthread.hpp"
 #include "schedulers/rx-newthread.hpp"
 #include "schedulers/rx-eventloop.hpp"
+#include "schedulers/rx-workstealing.hpp"
+#include "schedulers/rx-elastic.hpp"
+#include "schedulers/rx-edf.hpp"
+#include "schedulers/rx-affinity.hpp"
 #include "schedulers/rx-immediate.hpp"
 #include "schedulers/rx-virtualtime.hpp"
 #include "schedulers/rx-sameworker.hpp"
+#include "schedulers/rx-runloop.hpp"
 
 #endif
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SLICE_HPP)
+#define RXCPP_RX_SLICE_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+/// slice is a run of bytes inside memory that it keeps alive. a slice is
+/// a pointer, a size and a reference to the owner of the memory, so slices of
+/// a large buffer or of a mapped file can be sent without copying the bytes.
+/// the bytes are never changed through a slice.
+class slice
+{
+    std::shared_ptr<const void> owner;
+    const char* first;
+    size_t length;
+
+public:
+    typedef const char* const_iterator;
+    static const size_t npos = static_cast<size_t>(-1);
+
+    slice()
+        : first(nullptr)
+        , length(0)
+    {
+    }
+    /// the bytes from first to first + length, which stay valid while owner
+    /// is alive
+    slice(std::shared_ptr<const void> o, const char* f, size_t n)
+        : owner(std::move(o))
+        , first(f)
+        , length(n)
+    {
+    }
+    /// a slice that owns a copy of the bytes of the string
+    explicit slice(std::string s)
+    {
+        auto copy = std::make_shared<const std::string>(std::move(s));
+        first = copy->data();
+        length = copy->size();
+        owner = std::move(copy);
+    }
+
+    const char* data() const {
+        return first;
+    }
+    size_t size() const {
+        return length;
+    }
+    bool empty() const {
+        return length == 0;
+    }
+    const_iterator begin() const {
+        return first;
+    }
+    const_iterator end() const {
+        return first + length;
+    }
+    char operator[](size_t i) const {
+        return first[i];
+    }
+
+    /// the count bytes from offset, sharing the same owner
+    slice sub(size_t offset, size_t count = npos) const {
+        offset = (std::min)(offset, length);
+        count = (std::min)(count, length - offset);
+        return slice(owner, first + offset, count);
+    }
+
+    std::string str() const {
+        return std::string(first, length);
+    }
+
+    const std::shared_ptr<const void>& get_owner() const {
+        return owner;
+    }
+};
+
+inline bool operator==(const slice& lhs, const slice& rhs) {
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+inline bool operator!=(const slice& lhs, const slice& rhs) {
+    return !(lhs == rhs);
+}
+inline bool operator==(const slice& lhs, const std::string& rhs) {
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+inline bool operator==(const std::string& lhs, const slice& rhs) {
+    return rhs == lhs;
+}
+inline bool operator!=(const slice& lhs, const std::string& rhs) {
+    return !(lhs == rhs);
+}
+inline bool operator!=(const std::string& lhs, const slice& rhs) {
+    return !(rhs == lhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const slice& s) {
+    return os.write(s.data(), s.size());
+}
+
+}
+
+#endif
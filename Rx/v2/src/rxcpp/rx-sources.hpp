@@ -38,8 +38,10 @@ namespace rxs=sources;
 #include "sources/rx-create.hpp"
 #include "sources/rx-range.hpp"
 #include "sources/rx-iterate.hpp"
+#include "sources/rx-from_generator.hpp"
 #include "sources/rx-interval.hpp"
 #include "sources/rx-defer.hpp"
+#include "sources/rx-hedge.hpp"
 #include "sources/rx-never.hpp"
 #include "sources/rx-error.hpp"
 #include "sources/rx-scope.hpp"
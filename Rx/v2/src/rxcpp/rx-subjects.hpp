@@ -17,7 +17,12 @@ namespace rxsub=subjects;
 }
 
 #include "subjects/rx-subject.hpp"
+#include "subjects/rx-unicast.hpp"
 #include "subjects/rx-behavior.hpp"
+#include "subjects/rx-replay.hpp"
 #include "subjects/rx-synchronize.hpp"
+#include "subjects/rx-parallel_subject.hpp"
+#include "subjects/rx-ring.hpp"
+#include "subjects/rx-graph.hpp"
 
 #endif
@@ -94,6 +94,57 @@ class subscriber : public subscriber_base<T>
         const this_type* that;
     };
 
+    // an observer whose on_next cannot throw is called directly, without
+    // the try/catch and the unsubscribe check of nextdetacher
+    template<class V>
+    void on_next(V&& v, std::true_type) const {
+        trace_activity().on_next_enter(*this, v);
+        destination.on_next(std::forward<V>(v));
+        trace_activity().on_next_return(*this);
+    }
+    template<class V>
+    void on_next(V&& v, std::false_type) const {
+        nextdetacher protect(this);
+        protect(std::forward<V>(v));
+    }
+
+    void on_next_range(const T* first, size_t count, std::true_type) const {
+        if (!is_subscribed() || count == 0) {
+            return;
+        }
+        // a traced run is only sent in one call when its values cannot be
+        // copied, it is then traced as one on_next
+        trace_activity().on_next_enter(*this, *first);
+        try {
+            destination.on_next_range(first, count);
+        } catch(...) {
+            auto ex = std::current_exception();
+            trace_activity().on_error_enter(*this, ex);
+            destination.on_error(std::move(ex));
+            trace_activity().on_error_return(*this);
+            trace_activity().on_next_return(*this);
+            unsubscribe();
+            return;
+        }
+        trace_activity().on_next_return(*this);
+    }
+    void on_next_range(const T* first, size_t count, std::false_type) const {
+        on_next_each(first, count, std::integral_constant<bool, std::is_copy_constructible<T>::value>());
+    }
+    void on_next_each(const T* first, size_t count, std::true_type) const {
+        for (auto last = first + count; first != last && is_subscribed(); ++first) {
+            on_next(*first);
+        }
+    }
+    void on_next_each(const T*, size_t count, std::false_type) const {
+        // values that cannot be copied can only be sent as a run to an
+        // observer that has on_next_range. the operators and sources do not
+        // batch them, so this is only reached by a direct call.
+        if (count != 0) {
+            on_error(std::make_exception_ptr(std::logic_error("on_next_range of values that cannot be copied to an observer without on_next_range")));
+        }
+    }
+
     subscriber();
 public:
     typedef typename composite_subscription::weak_subscription weak_subscription;
@@ -171,8 +222,16 @@ public:
         if (!is_subscribed()) {
             return;
         }
-        nextdetacher protect(this);
-        protect(std::forward<V>(v));
+        on_next(std::forward<V>(v), std::integral_constant<bool, detail::is_nothrow_on_next<observer_type, V&&>::value>());
+    }
+    /// delivers count values. an observer that has on_next_range receives
+    /// them in one call, any other observer receives them one at a time.
+    /// while a tracer is set, values that can be copied are sent one at a
+    /// time so that the tracer sees each of them.
+    void on_next_range(const T* first, size_t count) const {
+        on_next_range(first, count, std::integral_constant<bool,
+            detail::has_on_next_range<T, observer_type>::value &&
+            (rxcpp::detail::is_trace_noop::value || !std::is_copy_constructible<T>::value)>());
     }
     void on_error(std::exception_ptr e) const {
         if (!is_subscribed()) {
@@ -214,6 +273,21 @@ public:
 
 };
 
+namespace detail {
+
+// true when on_next_range on the subscriber reaches its observer in one call.
+// operators and sources only batch values that can be copied, a run of values
+// that cannot be copied could not be split into calls to on_next. nothing is
+// batched while a tracer is set, so that it sees each value.
+template<class T, class Subscriber>
+struct is_range_subscriber
+{
+    typedef rxu::decay_t<decltype(std::declval<const Subscriber&>().get_observer())> observer_type;
+    static const bool value = std::is_copy_constructible<rxu::decay_t<T>>::value && has_on_next_range<T, observer_type>::value && is_trace_noop::value;
+};
+
+}
+
 template<class T, class Observer>
 auto make_subscriber(
             subscriber<T,   Observer> o)
@@ -38,6 +38,10 @@ public:
     static const bool value = std::is_convertible<decltype(check<rxu::decay_t<T>>(0)), tag_subscription*>::value;
 };
 
+namespace detail {
+class composite_subscription_inner;
+}
+
 template<class Unsubscribe>
 class static_subscription
 {
@@ -108,6 +112,36 @@ protected:
     friend bool operator<(const subscription&, const subscription&);
     friend bool operator==(const subscription&, const subscription&);
 
+    // composite_subscription derives its state from base_subscription_state
+    // so that it needs one allocation and one reference count.
+    friend class detail::composite_subscription_inner;
+    struct tag_state {};
+    subscription(tag_state, std::shared_ptr<base_subscription_state> s)
+        : state(std::move(s))
+    {
+        if (!state) {
+            abort();
+        }
+    }
+
+    // a borrowed state points at the state without a reference count. it
+    // is only ever moved: copies, weak handles and keep alive references
+    // are taken from the state itself.
+    struct tag_borrowed {};
+    subscription(tag_borrowed, const subscription& o)
+        : state(std::shared_ptr<base_subscription_state>(), o.state.get())
+    {
+        if (!state) {
+            abort();
+        }
+    }
+    static std::shared_ptr<base_subscription_state> owned(std::shared_ptr<base_subscription_state> s) {
+        if (s.use_count() == 0 && s) {
+            return s->shared_from_this();
+        }
+        return s;
+    }
+
 private:
     subscription(weak_state_type w)
         : state(w.lock())
@@ -136,14 +170,14 @@ public:
     template<class U>
     explicit subscription(U u, typename std::enable_if<!std::is_same<subscription, U>::value && is_subscription<U>::value, void**>::type = nullptr)
         // intentionally slice
-        : state(std::move((*static_cast<subscription*>(&u)).state))
+        : state(owned(std::move((*static_cast<subscription*>(&u)).state)))
     {
         if (!state) {
             abort();
         }
     }
     subscription(const subscription& o)
-        : state(o.state)
+        : state(owned(o.state))
     {
         if (!state) {
             abort();
@@ -170,12 +204,12 @@ public:
         if (!state) {
             abort();
         }
-        auto keepAlive = state;
+        auto keepAlive = owned(state);
         state->unsubscribe();
     }
 
     weak_state_type get_weak() {
-        return state;
+        return owned(state);
     }
     static subscription lock(weak_state_type w) {
         return subscription(w);
@@ -218,44 +252,87 @@ struct tag_composite_subscription_empty {};
 
 class composite_subscription_inner
 {
-private:
-    typedef subscription::weak_state_type weak_subscription;
-    struct composite_subscription_state : public std::enable_shared_from_this<composite_subscription_state>
+public:
+    /// returned from add and passed to remove. the index is where the
+    /// subscription was added, removal checks there before searching.
+    struct weak_subscription
     {
-        std::set<subscription> subscriptions;
-        std::mutex lock;
-        std::atomic<bool> issubscribed;
-
-        ~composite_subscription_state()
+        weak_subscription()
+            : index(0)
+        {
+        }
+        weak_subscription(subscription::weak_state_type w, size_t i)
+            : state(std::move(w))
+            , index(i)
         {
-            std::unique_lock<decltype(lock)> guard(lock);
-            subscriptions.clear();
         }
+        bool expired() const {
+            return state.expired();
+        }
+        subscription::weak_state_type state;
+        size_t index;
+    };
+
+private:
+    typedef subscription::base_subscription_state base_state_type;
+
+protected:
+    // the same object is the state of the subscription and of the children
+    struct composite_subscription_state : public base_state_type
+    {
+        // most composites hold very few children
+        typedef rxu::detail::small_vector<subscription, 3> subscriptions_type;
+
+        // is_subscribed() reads the flag of the base on every notification,
+        // often from other threads than the ones that add and remove
+        // children, so the children start a new cache line
+        rxu::detail::cache_line_pad subscribed_pad;
+        subscriptions_type subscriptions;
+        // held only to change subscriptions, never while calling out
+        rxu::detail::spin_lock lock;
 
         composite_subscription_state()
-            : issubscribed(true)
+            : base_state_type(true)
         {
         }
         composite_subscription_state(tag_composite_subscription_empty)
-            : issubscribed(false)
+            : base_state_type(false)
         {
         }
 
         inline weak_subscription add(subscription s) {
+            size_t index = 0;
             if (!issubscribed) {
                 s.unsubscribe();
             } else if (s.is_subscribed()) {
                 std::unique_lock<decltype(lock)> guard(lock);
-                subscriptions.insert(s);
+                if (!issubscribed) {
+                    // unsubscribe ran after the check above
+                    guard.unlock();
+                    s.unsubscribe();
+                } else {
+                    index = subscriptions.size();
+                    subscriptions.push_back(s);
+                }
             }
-            return s.get_weak();
+            return weak_subscription(s.get_weak(), index);
         }
 
         inline void remove(weak_subscription w) {
             if (issubscribed && !w.expired()) {
-                auto s = subscription::lock(w);
+                auto s = subscription::lock(w.state);
                 std::unique_lock<decltype(lock)> guard(lock);
-                subscriptions.erase(std::move(s));
+                if (w.index < subscriptions.size() && subscriptions[w.index] == s) {
+                    subscriptions.erase_unordered(w.index);
+                    return;
+                }
+                // an earlier removal moved it
+                for (size_t i = 0; i < subscriptions.size(); ++i) {
+                    if (subscriptions[i] == s) {
+                        subscriptions.erase_unordered(i);
+                        return;
+                    }
+                }
             }
         }
 
@@ -263,40 +340,39 @@ private:
             if (issubscribed) {
                 std::unique_lock<decltype(lock)> guard(lock);
 
-                std::set<subscription> v(std::move(subscriptions));
+                subscriptions_type v(std::move(subscriptions));
                 guard.unlock();
-                std::for_each(v.begin(), v.end(),
-                              [](const subscription& s) {
-                                s.unsubscribe(); });
+                v.for_each([](const subscription& s) {
+                    s.unsubscribe(); });
             }
         }
 
-        inline void unsubscribe() {
+        virtual void unsubscribe() {
             if (issubscribed.exchange(false)) {
+                trace_activity().unsubscribe_enter(*this);
                 std::unique_lock<decltype(lock)> guard(lock);
 
-                std::set<subscription> v(std::move(subscriptions));
+                subscriptions_type v(std::move(subscriptions));
                 guard.unlock();
-                std::for_each(v.begin(), v.end(),
-                              [](const subscription& s) {
-                                s.unsubscribe(); });
+                v.for_each([](const subscription& s) {
+                    s.unsubscribe(); });
+                trace_activity().unsubscribe_return(*this);
             }
         }
     };
 
-public:
     typedef std::shared_ptr<composite_subscription_state> shared_state_type;
 
-protected:
-    mutable shared_state_type state;
+    static subscription as_subscription(shared_state_type s) {
+        return subscription(subscription::tag_state(), std::move(s));
+    }
+
+    // owned by the subscription that is constructed with it
+    composite_subscription_state* state;
 
 public:
-    composite_subscription_inner()
-        : state(std::make_shared<composite_subscription_state>())
-    {
-    }
-    composite_subscription_inner(tag_composite_subscription_empty et)
-        : state(std::make_shared<composite_subscription_state>(et))
+    explicit composite_subscription_inner(const shared_state_type& s)
+        : state(s.get())
     {
     }
 
@@ -342,12 +418,6 @@ public:
         }
         state->clear();
     }
-    inline void unsubscribe() {
-        if (!state) {
-            abort();
-        }
-        state->unsubscribe();
-    }
 };
 
 inline composite_subscription shared_empty();
@@ -360,19 +430,29 @@ class composite_subscription
 {
     typedef detail::composite_subscription_inner inner_type;
 public:
-    typedef subscription::weak_state_type weak_subscription;
+    typedef inner_type::weak_subscription weak_subscription;
 
     composite_subscription(detail::tag_composite_subscription_empty et)
-        : inner_type(et)
-        , subscription() // use empty base
+        : composite_subscription(detail::allocate_state<composite_subscription_state>(et))
+    {
+    }
+
+private:
+    explicit composite_subscription(const shared_state_type& s)
+        : inner_type(s)
+        , subscription(inner_type::as_subscription(s))
+    {
+    }
+    composite_subscription(const composite_subscription& o, subscription::tag_borrowed tb)
+        : inner_type(static_cast<const inner_type&>(o))
+        , subscription(tb, static_cast<const subscription&>(o))
     {
     }
 
 public:
 
     composite_subscription()
-        : inner_type()
-        , subscription(*static_cast<const inner_type* const>(this))
+        : composite_subscription(detail::allocate_state<composite_subscription_state>())
     {
     }
 
@@ -398,6 +478,14 @@ public:
         return detail::shared_empty();
     }
 
+    /// returns a handle to this subscription that holds no reference count,
+    /// for a subscriber that also holds an owner of this subscription, as a
+    /// lifted subscriber holds its destination. moving the handle keeps it
+    /// borrowed and copying it takes a reference as usual.
+    composite_subscription borrow() const {
+        return composite_subscription(*this, subscription::tag_borrowed());
+    }
+
     using subscription::is_subscribed;
     using subscription::unsubscribe;
 
@@ -13,10 +13,9 @@ namespace rxcpp {
 
 struct trace_id
 {
-    static inline trace_id make_next_id_subscriber() {
-        static std::atomic<unsigned long> id(0xB0000000);
-        return trace_id{++id};
-    }
+    /// a new id for a subscriber. defined in rx-predef.hpp, where the
+    /// tracer is known.
+    static inline trace_id make_next_id_subscriber();
     unsigned long id;
 };
 
@@ -102,6 +101,17 @@ struct trace_noop
     inline void on_completed_enter(const Subscriber&) {}
     template<class Subscriber>
     inline void on_completed_return(const Subscriber&) {}
+
+    template<class Stage>
+    inline void stage_enqueue(const Stage&) {}
+    template<class Stage, class Duration>
+    inline void stage_deliver(const Stage&, const Duration&) {}
+
+    template<class Schedulable, class Duration>
+    inline void deadline_miss(const Schedulable&, const Duration&) {}
+
+    template<class WorkerStats>
+    inline void worker_report(const WorkerStats&) {}
 };
 
 struct trace_tag {};
@@ -0,0 +1,995 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_TRACE_METRICS_HPP)
+#define RXCPP_RX_TRACE_METRICS_HPP
+
+// the tracer is chosen before rx.hpp is included, so this header only depends
+// on rx-trace.hpp and the standard library. to collect metrics:
+//
+//     #include "rxcpp/rx-trace_metrics.hpp"
+//     inline auto rxcpp_trace_activity(rxcpp::trace_tag) -> rxcpp::trace_metrics;
+//     #include "rxcpp/rx.hpp"
+//
+// and read rxcpp::trace_activity().snapshot(). rxcpp::trace_counters is
+// chosen the same way and only counts, without reading the clock. every
+// translation unit in the program must make the same choice.
+
+#include "rx-trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rxcpp {
+
+namespace detail {
+struct trace_access;
+}
+
+/// a log linear histogram of durations in nanoseconds, in the style of
+/// HdrHistogram. each power of two is split into 8 buckets so a value is
+/// known to within 12.5%.
+class trace_histogram
+{
+public:
+    enum {
+        sub_bucket_bits = 3,
+        sub_buckets = 1 << sub_bucket_bits,
+        bucket_count = (64 - sub_bucket_bits + 1) * sub_buckets
+    };
+
+    static int msb(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        int m = 0;
+        while (v >>= 1) {
+            ++m;
+        }
+        return m;
+#endif
+    }
+
+    /// the bucket that holds the value
+    static int index(std::uint64_t v) {
+        if (v < sub_buckets) {
+            return static_cast<int>(v);
+        }
+        int shift = msb(v) - sub_bucket_bits;
+        return (shift + 1) * sub_buckets + static_cast<int>((v >> shift) & (sub_buckets - 1));
+    }
+    /// the smallest value in the bucket
+    static std::uint64_t lowest(int i) {
+        if (i < sub_buckets) {
+            return i;
+        }
+        int shift = i / sub_buckets - 1;
+        return std::uint64_t(sub_buckets + i % sub_buckets) << shift;
+    }
+    /// the largest value in the bucket
+    static std::uint64_t highest(int i) {
+        int shift = i < sub_buckets ? 0 : i / sub_buckets - 1;
+        return lowest(i) + ((std::uint64_t(1) << shift) - 1);
+    }
+
+    trace_histogram()
+        : buckets(bucket_count, 0)
+        , total(0)
+        , sum_ns(0)
+        , max_ns(0)
+    {
+    }
+
+    void record(std::uint64_t ns) {
+        ++buckets[index(ns)];
+        ++total;
+        sum_ns += ns;
+        max_ns = (std::max)(max_ns, ns);
+    }
+
+    std::uint64_t count() const {
+        return total;
+    }
+    std::uint64_t sum() const {
+        return sum_ns;
+    }
+    std::uint64_t max() const {
+        return max_ns;
+    }
+    double mean() const {
+        return total == 0 ? 0.0 : double(sum_ns) / total;
+    }
+    /// the count in each bucket
+    const std::vector<std::uint64_t>& counts() const {
+        return buckets;
+    }
+
+    /// the largest value in the bucket that holds the quantile, q in [0, 1]
+    std::uint64_t value_at(double q) const {
+        if (total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<std::uint64_t>(q * total + 0.5);
+        rank = (std::max)(rank, std::uint64_t(1));
+        std::uint64_t seen = 0;
+        for (int i = 0; i < bucket_count; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return (std::min)(highest(i), max_ns);
+            }
+        }
+        return max_ns;
+    }
+
+private:
+    friend struct detail::trace_access;
+
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t total;
+    std::uint64_t sum_ns;
+    std::uint64_t max_ns;
+};
+
+/// the totals of all the threads that have reported to a trace_metrics
+struct trace_metrics_snapshot
+{
+    trace_metrics_snapshot()
+        : threads(0)
+        , subscribe(0)
+        , lift(0)
+        , create_subscriber(0)
+        , unsubscribe(0)
+        , subscription_add(0)
+        , subscription_remove(0)
+        , schedule(0)
+        , schedule_when(0)
+        , action(0)
+        , action_recurse(0)
+        , on_next(0)
+        , on_error(0)
+        , on_completed(0)
+        , stage_enqueue(0)
+        , stage_deliver(0)
+        , deadline_miss(0)
+    {
+    }
+
+    std::uint64_t threads;
+
+    std::uint64_t subscribe;
+    std::uint64_t lift;
+    std::uint64_t create_subscriber;
+    std::uint64_t unsubscribe;
+    std::uint64_t subscription_add;
+    std::uint64_t subscription_remove;
+    std::uint64_t schedule;
+    std::uint64_t schedule_when;
+    std::uint64_t action;
+    std::uint64_t action_recurse;
+    std::uint64_t on_next;
+    std::uint64_t on_error;
+    std::uint64_t on_completed;
+    std::uint64_t stage_enqueue;
+    std::uint64_t stage_deliver;
+    /// the actions that an edf_scheduler started after their deadline
+    std::uint64_t deadline_miss;
+
+    /// the time in on_next, including the operators downstream
+    trace_histogram on_next_latency;
+    /// the time of each pass through an action
+    trace_histogram action_run_time;
+    /// the time from schedule, or the time it was due, to the action starting
+    trace_histogram queue_wait;
+    /// the time from entering an instrumented stage to leaving it
+    trace_histogram stage_latency;
+};
+
+/// the totals of all the threads that have reported to a trace_counters
+struct trace_counters_snapshot
+{
+    trace_counters_snapshot()
+        : threads(0)
+        , subscribe(0)
+        , lift(0)
+        , create_subscriber(0)
+        , unsubscribe(0)
+        , subscription_add(0)
+        , subscription_remove(0)
+        , schedule(0)
+        , schedule_when(0)
+        , action(0)
+        , action_recurse(0)
+        , on_next(0)
+        , on_error(0)
+        , on_completed(0)
+    {
+    }
+
+    std::uint64_t threads;
+
+    std::uint64_t subscribe;
+    std::uint64_t lift;
+    std::uint64_t create_subscriber;
+    std::uint64_t unsubscribe;
+    std::uint64_t subscription_add;
+    std::uint64_t subscription_remove;
+    std::uint64_t schedule;
+    std::uint64_t schedule_when;
+    std::uint64_t action;
+    std::uint64_t action_recurse;
+    std::uint64_t on_next;
+    std::uint64_t on_error;
+    std::uint64_t on_completed;
+
+    /// the calls that set up, tear down and schedule the query rather than
+    /// deliver its values
+    std::uint64_t overhead() const {
+        return subscribe + lift + create_subscriber + unsubscribe +
+            subscription_add + subscription_remove +
+            schedule + schedule_when + action + action_recurse;
+    }
+
+    /// count for each of the values that the query emitted. a query that
+    /// needs many more than one subscribe or schedule for each value is
+    /// dominated by the framework rather than by the work in its operators.
+    static double per_value(std::uint64_t count, std::uint64_t values) {
+        return values == 0 ? 0.0 : double(count) / values;
+    }
+    double overhead_per_value(std::uint64_t values) const {
+        return per_value(overhead(), values);
+    }
+};
+
+namespace detail {
+
+enum trace_counter {
+    trace_subscribe,
+    trace_lift,
+    trace_create_subscriber,
+    trace_unsubscribe,
+    trace_subscription_add,
+    trace_subscription_remove,
+    trace_schedule,
+    trace_schedule_when,
+    trace_action,
+    trace_action_recurse,
+    trace_on_next,
+    trace_on_error,
+    trace_on_completed,
+    trace_stage_enqueue,
+    trace_stage_deliver,
+    trace_deadline_miss,
+    trace_counter_count
+};
+
+// only the owning thread writes, so a plain load and store is enough and
+// readers still see whole values
+inline void trace_bump(std::atomic<std::uint64_t>& c, std::uint64_t by = 1) {
+    c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+inline std::int64_t trace_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct trace_thread_histogram
+{
+    trace_thread_histogram() {
+        for (auto& c : buckets) {
+            c.store(0, std::memory_order_relaxed);
+        }
+        total.store(0, std::memory_order_relaxed);
+        sum_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+
+    void record(std::int64_t ns) {
+        auto v = static_cast<std::uint64_t>((std::max)(ns, std::int64_t(0)));
+        trace_bump(buckets[trace_histogram::index(v)]);
+        trace_bump(total);
+        trace_bump(sum_ns, v);
+        if (v > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(v, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> buckets[trace_histogram::bucket_count];
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> sum_ns;
+    std::atomic<std::uint64_t> max_ns;
+};
+
+// start times of nested calls. zero marks a call that is not timed.
+struct trace_stack
+{
+    enum { limit = 32 };
+
+    trace_stack()
+        : depth(0)
+    {
+    }
+
+    void push(std::int64_t t) {
+        if (depth < limit) {
+            at[depth] = t;
+        }
+        ++depth;
+    }
+    std::int64_t pop() {
+        if (depth == 0) {
+            return 0;
+        }
+        --depth;
+        return depth < limit ? at[depth] : 0;
+    }
+    std::int64_t top() const {
+        return depth > 0 && depth <= limit ? at[depth - 1] : 0;
+    }
+    void retop(std::int64_t t) {
+        if (depth > 0 && depth <= limit) {
+            at[depth - 1] = t;
+        }
+    }
+
+    int depth;
+    std::int64_t at[limit];
+};
+
+// the padding keeps the blocks of different threads off of the same cache
+// lines without depending on over aligned allocation
+struct trace_thread_metrics
+{
+    trace_thread_metrics()
+        : next_ticks(0)
+        , action_ticks(0)
+        , schedule_ticks(0)
+    {
+        for (auto& c : counters) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    char padding_front[64];
+
+    std::atomic<std::uint64_t> counters[trace_counter_count];
+    trace_thread_histogram on_next_latency;
+    trace_thread_histogram action_run_time;
+    trace_thread_histogram queue_wait;
+    trace_thread_histogram stage_latency;
+
+    // only used by the owning thread
+    trace_stack on_next_started;
+    trace_stack action_started;
+    std::uint32_t next_ticks;
+    std::uint32_t action_ticks;
+    std::uint32_t schedule_ticks;
+
+    char padding_back[64];
+};
+
+// the block of a trace_counters
+struct trace_thread_counters
+{
+    trace_thread_counters()
+    {
+        for (auto& c : counters) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    char padding_front[64];
+
+    std::atomic<std::uint64_t> counters[trace_counter_count];
+
+    char padding_back[64];
+};
+
+// remembers when a sampled schedulable was scheduled until its action starts.
+// a collision loses that sample.
+struct trace_wait_slot
+{
+    std::atomic<const void*> key;
+    std::atomic<std::int64_t> ready;
+    char padding[64 - sizeof(std::atomic<const void*>) - sizeof(std::atomic<std::int64_t>)];
+};
+
+struct trace_access
+{
+    static void add(trace_histogram& to, const trace_thread_histogram& from) {
+        for (int i = 0; i < trace_histogram::bucket_count; ++i) {
+            to.buckets[i] += from.buckets[i].load(std::memory_order_relaxed);
+        }
+        to.total += from.total.load(std::memory_order_relaxed);
+        to.sum_ns += from.sum_ns.load(std::memory_order_relaxed);
+        to.max_ns = (std::max)(to.max_ns, from.max_ns.load(std::memory_order_relaxed));
+    }
+
+    static void add(trace_metrics_snapshot& to, const trace_thread_metrics& from) {
+        auto count = [&](trace_counter c){
+            return from.counters[c].load(std::memory_order_relaxed);
+        };
+        ++to.threads;
+        to.subscribe += count(trace_subscribe);
+        to.lift += count(trace_lift);
+        to.create_subscriber += count(trace_create_subscriber);
+        to.unsubscribe += count(trace_unsubscribe);
+        to.subscription_add += count(trace_subscription_add);
+        to.subscription_remove += count(trace_subscription_remove);
+        to.schedule += count(trace_schedule);
+        to.schedule_when += count(trace_schedule_when);
+        to.action += count(trace_action);
+        to.action_recurse += count(trace_action_recurse);
+        to.on_next += count(trace_on_next);
+        to.on_error += count(trace_on_error);
+        to.on_completed += count(trace_on_completed);
+        to.stage_enqueue += count(trace_stage_enqueue);
+        to.stage_deliver += count(trace_stage_deliver);
+        to.deadline_miss += count(trace_deadline_miss);
+        add(to.on_next_latency, from.on_next_latency);
+        add(to.action_run_time, from.action_run_time);
+        add(to.queue_wait, from.queue_wait);
+        add(to.stage_latency, from.stage_latency);
+    }
+
+    static void add(trace_counters_snapshot& to, const trace_thread_counters& from) {
+        auto count = [&](trace_counter c){
+            return from.counters[c].load(std::memory_order_relaxed);
+        };
+        ++to.threads;
+        to.subscribe += count(trace_subscribe);
+        to.lift += count(trace_lift);
+        to.create_subscriber += count(trace_create_subscriber);
+        to.unsubscribe += count(trace_unsubscribe);
+        to.subscription_add += count(trace_subscription_add);
+        to.subscription_remove += count(trace_subscription_remove);
+        to.schedule += count(trace_schedule);
+        to.schedule_when += count(trace_schedule_when);
+        to.action += count(trace_action);
+        to.action_recurse += count(trace_action_recurse);
+        to.on_next += count(trace_on_next);
+        to.on_error += count(trace_on_error);
+        to.on_completed += count(trace_on_completed);
+    }
+};
+
+// the blocks that the threads write to and the totals of the threads that
+// have exited
+template<class Block, class Snapshot>
+struct trace_thread_blocks
+{
+    typedef Block block_type;
+    typedef Snapshot snapshot_type;
+
+    trace_thread_blocks()
+        : id(next_id())
+    {
+    }
+
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> id(0);
+        return ++id;
+    }
+
+    std::shared_ptr<block_type> join() {
+        auto metrics = std::make_shared<block_type>();
+        std::unique_lock<std::mutex> guard(lock);
+        threads.push_back(metrics);
+        return metrics;
+    }
+
+    // keeps the totals of a thread that has exited
+    void retire(const std::shared_ptr<block_type>& metrics) {
+        std::unique_lock<std::mutex> guard(lock);
+        for (auto it = threads.begin(); it != threads.end(); ++it) {
+            if (*it == metrics) {
+                trace_access::add(retired, *metrics);
+                threads.erase(it);
+                break;
+            }
+        }
+    }
+
+    snapshot_type snapshot() {
+        std::unique_lock<std::mutex> guard(lock);
+        auto result = retired;
+        for (auto& t : threads) {
+            trace_access::add(result, *t);
+        }
+        return result;
+    }
+
+    const std::uint64_t id;
+
+    std::mutex lock;
+    std::vector<std::shared_ptr<block_type>> threads;
+    snapshot_type retired;
+};
+
+struct trace_metrics_state : public trace_thread_blocks<trace_thread_metrics, trace_metrics_snapshot>
+{
+    enum { slot_count = 128 };
+
+    trace_metrics_state()
+        : sample_mask(63)
+    {
+        for (auto& s : slots) {
+            s.key.store(nullptr, std::memory_order_relaxed);
+            s.ready.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    trace_wait_slot& slot(const void* key) {
+        auto k = reinterpret_cast<std::uintptr_t>(key);
+        return slots[((k >> 4) ^ (k >> 12)) % slot_count];
+    }
+
+    std::atomic<std::uint32_t> sample_mask;
+
+    trace_wait_slot slots[slot_count];
+};
+
+typedef trace_thread_blocks<trace_thread_counters, trace_counters_snapshot> trace_counters_state;
+
+// the block that this thread last reported to. it is trivial so that reading
+// it does not go through thread_local initialization.
+template<class Block>
+struct trace_thread_cache
+{
+    std::uint64_t id;
+    Block* metrics;
+};
+
+template<class Block>
+inline trace_thread_cache<Block>& trace_this_thread_cache() {
+    static thread_local trace_thread_cache<Block> cache = {0, nullptr};
+    return cache;
+}
+
+// the blocks of this thread, one for each tracer that it reports to
+template<class State>
+struct trace_thread_registry
+{
+    typedef typename State::block_type block_type;
+
+    struct entry
+    {
+        std::uint64_t id;
+        std::weak_ptr<State> state;
+        std::shared_ptr<block_type> metrics;
+    };
+
+    ~trace_thread_registry()
+    {
+        trace_this_thread_cache<block_type>() = trace_thread_cache<block_type>{0, nullptr};
+        for (auto& e : entries) {
+            auto state = e.state.lock();
+            if (!!state) {
+                state->retire(e.metrics);
+            }
+        }
+    }
+
+    block_type& find(const std::shared_ptr<State>& state) {
+        block_type* found = nullptr;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->id == state->id) {
+                found = it->metrics.get();
+                ++it;
+            } else if (it->state.expired()) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!found) {
+            entry e;
+            e.id = state->id;
+            e.state = state;
+            e.metrics = state->join();
+            found = e.metrics.get();
+            entries.push_back(std::move(e));
+        }
+        trace_this_thread_cache<block_type>() = trace_thread_cache<block_type>{state->id, found};
+        return *found;
+    }
+
+    std::vector<entry> entries;
+};
+
+template<class State>
+inline trace_thread_registry<State>& trace_this_thread() {
+    static thread_local trace_thread_registry<State> registry;
+    return registry;
+}
+
+template<class State>
+inline typename State::block_type& trace_find_block(const std::shared_ptr<State>& state, std::uint64_t id) {
+    auto& cache = trace_this_thread_cache<typename State::block_type>();
+    if (cache.id == id) {
+        return *cache.metrics;
+    }
+    return trace_this_thread<State>().find(state);
+}
+
+}
+
+/// trace_metrics is a tracer that counts the calls to the trace hooks and
+/// keeps histograms of on_next latency, action run time, queue wait and the
+/// latency of instrumented stages. each thread writes to its own block, so
+/// the hooks take no locks. the counts and stage latencies are exact. the
+/// other times are sampled, one in sample_period() calls on each thread, to
+/// keep the cost of reading the clock out of most calls. snapshot() adds up
+/// the blocks of all the threads, including the threads that have exited.
+struct trace_metrics
+{
+    trace_metrics()
+        : state(std::make_shared<detail::trace_metrics_state>())
+        , id(state->id)
+    {
+    }
+
+    trace_metrics_snapshot snapshot() const {
+        return state->snapshot();
+    }
+
+    std::uint32_t sample_period() const {
+        return state->sample_mask.load(std::memory_order_relaxed) + 1;
+    }
+    /// time one in period calls. period is rounded up to a power of two and
+    /// 1 times every call.
+    void set_sample_period(std::uint32_t period) {
+        std::uint32_t p = 1;
+        while (p < period && p < (1u << 31)) {
+            p <<= 1;
+        }
+        state->sample_mask.store(p - 1, std::memory_order_relaxed);
+    }
+
+    template<class Worker, class Schedulable>
+    inline void schedule_enter(const Worker&, const Schedulable& s) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_schedule]);
+        if (sampled(t.schedule_ticks)) {
+            queued(s.get_action().get_id(), detail::trace_now());
+        }
+    }
+    template<class Worker>
+    inline void schedule_return(const Worker&) {}
+    template<class Worker, class When, class Schedulable>
+    inline void schedule_when_enter(const Worker&, const When& when, const Schedulable& s) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_schedule_when]);
+        if (sampled(t.schedule_ticks)) {
+            auto due = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+            queued(s.get_action().get_id(), (std::max)(std::int64_t(due), detail::trace_now()));
+        }
+    }
+    template<class Worker>
+    inline void schedule_when_return(const Worker&) {}
+
+    template<class Schedulable>
+    inline void action_enter(const Schedulable& s) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_action]);
+        std::int64_t now = 0;
+        auto key = s.get_action().get_id();
+        auto& slot = state->slot(key);
+        if (slot.key.load(std::memory_order_acquire) == key) {
+            auto ready = slot.ready.load(std::memory_order_relaxed);
+            if (slot.key.compare_exchange_strong(key, nullptr)) {
+                now = detail::trace_now();
+                t.queue_wait.record(now - ready);
+            }
+        }
+        if (sampled(t.action_ticks)) {
+            now = now == 0 ? detail::trace_now() : now;
+            t.action_started.push(now);
+        } else {
+            t.action_started.push(0);
+        }
+    }
+    template<class Schedulable>
+    inline void action_return(const Schedulable&) {
+        auto& t = metrics();
+        auto started = t.action_started.pop();
+        if (started != 0) {
+            t.action_run_time.record(detail::trace_now() - started);
+        }
+    }
+    template<class Schedulable>
+    inline void action_recurse(const Schedulable&) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_action_recurse]);
+        auto started = t.action_started.top();
+        if (started != 0) {
+            // each pass is recorded on its own
+            auto now = detail::trace_now();
+            t.action_run_time.record(now - started);
+            t.action_started.retop(now);
+        }
+    }
+
+    template<class Observable, class Subscriber>
+    inline void subscribe_enter(const Observable& , const Subscriber& ) {
+        detail::trace_bump(metrics().counters[detail::trace_subscribe]);
+    }
+    template<class Observable>
+    inline void subscribe_return(const Observable& ) {}
+
+    template<class SubscriberFrom, class SubscriberTo>
+    inline void connect(const SubscriberFrom&, const SubscriberTo&) {}
+
+    template<class OperatorSource, class OperatorChain, class Subscriber, class SubscriberLifted>
+    inline void lift_enter(const OperatorSource&, const OperatorChain&, const Subscriber&, const SubscriberLifted&) {
+        detail::trace_bump(metrics().counters[detail::trace_lift]);
+    }
+    template<class OperatorSource, class OperatorChain>
+    inline void lift_return(const OperatorSource&, const OperatorChain&) {}
+
+    template<class SubscriptionState>
+    inline void unsubscribe_enter(const SubscriptionState&) {
+        detail::trace_bump(metrics().counters[detail::trace_unsubscribe]);
+    }
+    template<class SubscriptionState>
+    inline void unsubscribe_return(const SubscriptionState&) {}
+
+    template<class SubscriptionState, class Subscription>
+    inline void subscription_add_enter(const SubscriptionState&, const Subscription&) {
+        detail::trace_bump(metrics().counters[detail::trace_subscription_add]);
+    }
+    template<class SubscriptionState>
+    inline void subscription_add_return(const SubscriptionState&) {}
+
+    template<class SubscriptionState, class WeakSubscription>
+    inline void subscription_remove_enter(const SubscriptionState&, const WeakSubscription&) {
+        detail::trace_bump(metrics().counters[detail::trace_subscription_remove]);
+    }
+    template<class SubscriptionState>
+    inline void subscription_remove_return(const SubscriptionState&) {}
+
+    template<class Subscriber>
+    inline void create_subscriber(const Subscriber&) {
+        detail::trace_bump(metrics().counters[detail::trace_create_subscriber]);
+    }
+
+    template<class Subscriber, class T>
+    inline void on_next_enter(const Subscriber&, const T&) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_on_next]);
+        t.on_next_started.push(sampled(t.next_ticks) ? detail::trace_now() : 0);
+    }
+    template<class Subscriber>
+    inline void on_next_return(const Subscriber&) {
+        auto& t = metrics();
+        auto started = t.on_next_started.pop();
+        if (started != 0) {
+            t.on_next_latency.record(detail::trace_now() - started);
+        }
+    }
+
+    template<class Subscriber>
+    inline void on_error_enter(const Subscriber&, const std::exception_ptr&) {
+        detail::trace_bump(metrics().counters[detail::trace_on_error]);
+    }
+    template<class Subscriber>
+    inline void on_error_return(const Subscriber&) {}
+
+    template<class Subscriber>
+    inline void on_completed_enter(const Subscriber&) {
+        detail::trace_bump(metrics().counters[detail::trace_on_completed]);
+    }
+    template<class Subscriber>
+    inline void on_completed_return(const Subscriber&) {}
+
+    template<class Stage>
+    inline void stage_enqueue(const Stage&) {
+        detail::trace_bump(metrics().counters[detail::trace_stage_enqueue]);
+    }
+    template<class Stage, class Duration>
+    inline void stage_deliver(const Stage&, const Duration& waited) {
+        auto& t = metrics();
+        detail::trace_bump(t.counters[detail::trace_stage_deliver]);
+        // the stage has already read the clock
+        t.stage_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+    }
+
+    template<class Schedulable, class Duration>
+    inline void deadline_miss(const Schedulable&, const Duration&) {
+        detail::trace_bump(metrics().counters[detail::trace_deadline_miss]);
+    }
+
+    // the stats of the scheduler threads are read with scheduler::stats()
+    template<class WorkerStats>
+    inline void worker_report(const WorkerStats&) {}
+
+private:
+    detail::trace_thread_metrics& metrics() const {
+        return detail::trace_find_block(state, id);
+    }
+    bool sampled(std::uint32_t& ticks) const {
+        return (ticks++ & state->sample_mask.load(std::memory_order_relaxed)) == 0;
+    }
+    void queued(const void* key, std::int64_t ready) {
+        auto& slot = state->slot(key);
+        slot.ready.store(ready, std::memory_order_relaxed);
+        slot.key.store(key, std::memory_order_release);
+    }
+
+    std::shared_ptr<detail::trace_metrics_state> state;
+    std::uint64_t id;
+};
+
+/// trace_counters is a tracer that only counts the calls to the trace hooks,
+/// to see how much framework activity a query shape needs for each value
+/// that it emits. each thread counts in its own block, so there is no
+/// contended increment, and snapshot() adds up the blocks of all the
+/// threads, including the threads that have exited.
+struct trace_counters : public trace_noop
+{
+    trace_counters()
+        : state(std::make_shared<detail::trace_counters_state>())
+        , id(state->id)
+    {
+    }
+
+    trace_counters_snapshot snapshot() const {
+        return state->snapshot();
+    }
+
+    template<class Worker, class Schedulable>
+    inline void schedule_enter(const Worker&, const Schedulable&) {
+        count(detail::trace_schedule);
+    }
+    template<class Worker, class When, class Schedulable>
+    inline void schedule_when_enter(const Worker&, const When&, const Schedulable&) {
+        count(detail::trace_schedule_when);
+    }
+
+    template<class Schedulable>
+    inline void action_enter(const Schedulable&) {
+        count(detail::trace_action);
+    }
+    template<class Schedulable>
+    inline void action_recurse(const Schedulable&) {
+        count(detail::trace_action_recurse);
+    }
+
+    template<class Observable, class Subscriber>
+    inline void subscribe_enter(const Observable& , const Subscriber& ) {
+        count(detail::trace_subscribe);
+    }
+
+    template<class OperatorSource, class OperatorChain, class Subscriber, class SubscriberLifted>
+    inline void lift_enter(const OperatorSource&, const OperatorChain&, const Subscriber&, const SubscriberLifted&) {
+        count(detail::trace_lift);
+    }
+
+    template<class SubscriptionState>
+    inline void unsubscribe_enter(const SubscriptionState&) {
+        count(detail::trace_unsubscribe);
+    }
+
+    template<class SubscriptionState, class Subscription>
+    inline void subscription_add_enter(const SubscriptionState&, const Subscription&) {
+        count(detail::trace_subscription_add);
+    }
+
+    template<class SubscriptionState, class WeakSubscription>
+    inline void subscription_remove_enter(const SubscriptionState&, const WeakSubscription&) {
+        count(detail::trace_subscription_remove);
+    }
+
+    template<class Subscriber>
+    inline void create_subscriber(const Subscriber&) {
+        count(detail::trace_create_subscriber);
+    }
+
+    template<class Subscriber, class T>
+    inline void on_next_enter(const Subscriber&, const T&) {
+        count(detail::trace_on_next);
+    }
+
+    template<class Subscriber>
+    inline void on_error_enter(const Subscriber&, const std::exception_ptr&) {
+        count(detail::trace_on_error);
+    }
+
+    template<class Subscriber>
+    inline void on_completed_enter(const Subscriber&) {
+        count(detail::trace_on_completed);
+    }
+
+private:
+    void count(detail::trace_counter c) const {
+        detail::trace_bump(detail::trace_find_block(state, id).counters[c]);
+    }
+
+    std::shared_ptr<detail::trace_counters_state> state;
+    std::uint64_t id;
+};
+
+/// writes each count and its ratio to the values that the query emitted. the
+/// on_next count includes every operator that a value passed through.
+inline void write_overhead(std::ostream& os, const trace_counters_snapshot& s, std::uint64_t values) {
+    auto line = [&](const char* name, std::uint64_t count){
+        os << name << ": " << count << ", per value: " << trace_counters_snapshot::per_value(count, values) << "\n";
+    };
+    os << "values: " << values << ", threads: " << s.threads << "\n";
+    line("subscribe", s.subscribe);
+    line("lift", s.lift);
+    line("create_subscriber", s.create_subscriber);
+    line("unsubscribe", s.unsubscribe);
+    line("subscription_add", s.subscription_add);
+    line("subscription_remove", s.subscription_remove);
+    line("schedule", s.schedule);
+    line("schedule_when", s.schedule_when);
+    line("action", s.action);
+    line("action_recurse", s.action_recurse);
+    line("on_next", s.on_next);
+    line("on_error", s.on_error);
+    line("on_completed", s.on_completed);
+    line("overhead", s.overhead());
+}
+
+/// writes the snapshot in the prometheus text format. the histogram buckets
+/// are the powers of two of nanoseconds up to 2^40, given in seconds.
+inline void write_prometheus(std::ostream& os, const trace_metrics_snapshot& s, const std::string& prefix = "rxcpp") {
+    auto counter = [&](const char* name, std::uint64_t value){
+        os << "# TYPE " << prefix << "_" << name << "_total counter\n";
+        os << prefix << "_" << name << "_total " << value << "\n";
+    };
+    auto histogram = [&](const char* name, const trace_histogram& h){
+        auto full = prefix + "_" + name + "_seconds";
+        os << "# TYPE " << full << " histogram\n";
+        std::uint64_t seen = 0;
+        // the same bounds in every snapshot
+        const std::uint64_t last = std::uint64_t(1) << 40;
+        for (int i = 0; i < trace_histogram::bucket_count; ++i) {
+            seen += h.counts()[i];
+            if (i % trace_histogram::sub_buckets == trace_histogram::sub_buckets - 1) {
+                auto bound = trace_histogram::highest(i) + 1;
+                os << full << "_bucket{le=\"" << bound / 1e9 << "\"} " << seen << "\n";
+                if (bound == last) {
+                    break;
+                }
+            }
+        }
+        os << full << "_bucket{le=\"+Inf\"} " << h.count() << "\n";
+        os << full << "_sum " << h.sum() / 1e9 << "\n";
+        os << full << "_count " << h.count() << "\n";
+    };
+    os << "# TYPE " << prefix << "_trace_threads gauge\n";
+    os << prefix << "_trace_threads " << s.threads << "\n";
+    counter("subscribe", s.subscribe);
+    counter("lift", s.lift);
+    counter("create_subscriber", s.create_subscriber);
+    counter("unsubscribe", s.unsubscribe);
+    counter("subscription_add", s.subscription_add);
+    counter("subscription_remove", s.subscription_remove);
+    counter("schedule", s.schedule);
+    counter("schedule_when", s.schedule_when);
+    counter("action", s.action);
+    counter("action_recurse", s.action_recurse);
+    counter("on_next", s.on_next);
+    counter("on_error", s.on_error);
+    counter("on_completed", s.on_completed);
+    counter("stage_enqueue", s.stage_enqueue);
+    counter("stage_deliver", s.stage_deliver);
+    counter("deadline_miss", s.deadline_miss);
+    histogram("on_next_latency", s.on_next_latency);
+    histogram("action_run_time", s.action_run_time);
+    histogram("queue_wait", s.queue_wait);
+    histogram("stage_latency", s.stage_latency);
+}
+
+}
+
+#endif
@@ -0,0 +1,448 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_TRACE_TIMELINE_HPP)
+#define RXCPP_RX_TRACE_TIMELINE_HPP
+
+// the tracer is chosen before rx.hpp is included, so this header only depends
+// on rx-trace.hpp and the standard library. to record a timeline:
+//
+//     #include "rxcpp/rx-trace_timeline.hpp"
+//     inline auto rxcpp_trace_activity(rxcpp::trace_tag) -> rxcpp::trace_timeline;
+//     #include "rxcpp/rx.hpp"
+//
+// and write rxcpp::trace_activity().write_chrome_trace(file) to a file that
+// chrome://tracing or ui.perfetto.dev can open. every translation unit in the
+// program must make the same choice.
+
+#include "rx-trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace rxcpp {
+
+namespace detail {
+
+enum timeline_kind {
+    timeline_schedule,
+    timeline_action_begin,
+    timeline_action_end,
+    timeline_subscribe_begin,
+    timeline_subscribe_end,
+    timeline_on_next_begin,
+    timeline_on_next_end,
+    timeline_on_error,
+    timeline_on_completed
+};
+
+struct timeline_record
+{
+    std::int64_t at;
+    std::uint64_t id;
+    std::uint32_t kind;
+};
+
+// the fields are atomic so that a reader may copy the ring while the owner
+// thread writes. the writer only uses relaxed stores.
+struct timeline_event
+{
+    std::atomic<std::int64_t> at;
+    std::atomic<std::uint64_t> id;
+    std::atomic<std::uint32_t> kind;
+};
+
+// the events of one thread. when the ring is full the oldest events are
+// overwritten.
+struct timeline_ring
+{
+    timeline_ring(size_t capacity, unsigned t)
+        : events(new timeline_event[capacity])
+        , mask(capacity - 1)
+        , head(0)
+        , tid(t)
+    {
+    }
+
+    // only called by the owner thread
+    void push(timeline_kind kind, std::uint64_t id) {
+        auto at = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto h = head.load(std::memory_order_relaxed);
+        auto& e = events[h & mask];
+        e.at.store(at, std::memory_order_relaxed);
+        e.id.store(id, std::memory_order_relaxed);
+        e.kind.store(kind, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // copies the events, leaving out any that were overwritten during the copy
+    std::vector<timeline_record> read() const {
+        auto capacity = mask + 1;
+        auto end = head.load(std::memory_order_acquire);
+        auto begin = end > capacity ? end - capacity : 0;
+        std::vector<timeline_record> copied;
+        copied.reserve(end - begin);
+        for (auto i = begin; i != end; ++i) {
+            auto& e = events[i & mask];
+            timeline_record r = {
+                e.at.load(std::memory_order_relaxed),
+                e.id.load(std::memory_order_relaxed),
+                e.kind.load(std::memory_order_relaxed)
+            };
+            copied.push_back(r);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto now = head.load(std::memory_order_relaxed);
+        // the slot of index now is being written over index now - capacity
+        size_t skip = 0;
+        if (now >= capacity && now - capacity + 1 > begin) {
+            skip = (std::min)(size_t(now - capacity + 1 - begin), copied.size());
+        }
+        copied.erase(copied.begin(), copied.begin() + skip);
+        return copied;
+    }
+
+    std::unique_ptr<timeline_event[]> events;
+    size_t mask;
+    std::atomic<size_t> head;
+    unsigned tid;
+};
+
+struct timeline_state
+{
+    enum { retired_limit = 64 };
+
+    explicit timeline_state(size_t capacity)
+        : id(next_id())
+        , capacity(capacity)
+        , next_tid(1)
+    {
+    }
+
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> id(0);
+        return ++id;
+    }
+
+    std::shared_ptr<timeline_ring> join() {
+        std::unique_lock<std::mutex> guard(lock);
+        auto ring = std::make_shared<timeline_ring>(capacity, next_tid++);
+        rings.push_back(ring);
+        return ring;
+    }
+
+    // the rings of exited threads are kept until there are too many of them
+    void retire(const std::shared_ptr<timeline_ring>& ring) {
+        std::unique_lock<std::mutex> guard(lock);
+        auto it = std::find(rings.begin(), rings.end(), ring);
+        if (it == rings.end()) {
+            return;
+        }
+        rings.erase(it);
+        retired.push_back(ring);
+        if (retired.size() > retired_limit) {
+            retired.pop_front();
+        }
+    }
+
+    std::vector<std::shared_ptr<timeline_ring>> all() {
+        std::unique_lock<std::mutex> guard(lock);
+        std::vector<std::shared_ptr<timeline_ring>> result(retired.begin(), retired.end());
+        result.insert(result.end(), rings.begin(), rings.end());
+        return result;
+    }
+
+    const std::uint64_t id;
+    std::mutex lock;
+    size_t capacity;
+    unsigned next_tid;
+    std::vector<std::shared_ptr<timeline_ring>> rings;
+    std::deque<std::shared_ptr<timeline_ring>> retired;
+};
+
+// the ring that this thread last wrote to. it is trivial so that reading it
+// does not go through thread_local initialization.
+struct timeline_thread_cache
+{
+    std::uint64_t id;
+    timeline_ring* ring;
+};
+
+inline timeline_thread_cache& timeline_this_thread_cache() {
+    static thread_local timeline_thread_cache cache = {0, nullptr};
+    return cache;
+}
+
+// the rings of this thread, one for each trace_timeline that it writes to
+struct timeline_thread_registry
+{
+    struct entry
+    {
+        std::uint64_t id;
+        std::weak_ptr<timeline_state> state;
+        std::shared_ptr<timeline_ring> ring;
+    };
+
+    ~timeline_thread_registry()
+    {
+        timeline_this_thread_cache() = timeline_thread_cache{0, nullptr};
+        for (auto& e : entries) {
+            auto state = e.state.lock();
+            if (!!state) {
+                state->retire(e.ring);
+            }
+        }
+    }
+
+    timeline_ring& find(const std::shared_ptr<timeline_state>& state) {
+        timeline_ring* found = nullptr;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->id == state->id) {
+                found = it->ring.get();
+                ++it;
+            } else if (it->state.expired()) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!found) {
+            entry e;
+            e.id = state->id;
+            e.state = state;
+            e.ring = state->join();
+            found = e.ring.get();
+            entries.push_back(std::move(e));
+        }
+        timeline_this_thread_cache() = timeline_thread_cache{state->id, found};
+        return *found;
+    }
+
+    std::vector<entry> entries;
+};
+
+inline timeline_thread_registry& timeline_this_thread() {
+    static thread_local timeline_thread_registry registry;
+    return registry;
+}
+
+}
+
+/// trace_timeline is a tracer that records subscribe, schedule, action and
+/// on_next spans into a ring for each thread and writes them as chrome trace
+/// events. a schedule and the action that it starts are joined by a flow
+/// arrow, so the handoffs between threads in observe_on and subscribe_on can
+/// be seen. each hook reads the clock, so this is for investigations rather
+/// than for production.
+struct trace_timeline
+{
+    /// capacity is rounded up to a power of two. each thread keeps its newest
+    /// events, all but one slot of the ring, which the thread may be writing.
+    explicit trace_timeline(size_t capacity = 1 << 15)
+        : state(std::make_shared<detail::timeline_state>(round(capacity)))
+        , id(state->id)
+    {
+    }
+
+    /// the events recorded so far by each thread, oldest first
+    std::vector<std::vector<detail::timeline_record>> records() const {
+        std::vector<std::vector<detail::timeline_record>> result;
+        for (auto& ring : state->all()) {
+            result.push_back(ring->read());
+        }
+        return result;
+    }
+
+    /// writes the events in the chrome trace event json format
+    void write_chrome_trace(std::ostream& os) const {
+        static const char* const names[] = {
+            "schedule", "action", "action", "subscribe", "subscribe",
+            "on_next", "on_next", "on_error", "on_completed"
+        };
+        auto first = true;
+        auto comma = [&](){
+            if (!first) {
+                os << ",\n";
+            }
+            first = false;
+        };
+        auto at = [&](std::int64_t ns){
+            auto us = ns / 1000;
+            auto fraction = static_cast<int>(ns % 1000);
+            os << "\"ts\":" << us << "." << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "") << fraction;
+        };
+        auto event = [&](unsigned tid, const detail::timeline_record& r, const char* name, const char* phase){
+            comma();
+            os << "{\"name\":\"" << name << "\",\"cat\":\"rx\",\"ph\":\"" << phase << "\",";
+            at(r.at);
+            os << ",\"pid\":1,\"tid\":" << tid;
+        };
+        os << "{\"traceEvents\":[\n";
+        for (auto& ring : state->all()) {
+            auto tid = ring->tid;
+            comma();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"rx thread " << tid << "\"}}";
+            for (auto& r : ring->read()) {
+                auto name = names[r.kind];
+                switch (r.kind) {
+                case detail::timeline_schedule:
+                    event(tid, r, name, "i");
+                    os << ",\"s\":\"t\"}";
+                    event(tid, r, "handoff", "s");
+                    os << ",\"id\":\"0x" << std::hex << r.id << std::dec << "\"}";
+                    break;
+                case detail::timeline_action_begin:
+                    event(tid, r, "handoff", "f");
+                    os << ",\"bp\":\"e\",\"id\":\"0x" << std::hex << r.id << std::dec << "\"}";
+                    event(tid, r, name, "B");
+                    os << "}";
+                    break;
+                case detail::timeline_subscribe_begin:
+                case detail::timeline_on_next_begin:
+                    event(tid, r, name, "B");
+                    os << ",\"args\":{\"subscriber\":\"" << std::hex << r.id << std::dec << "\"}}";
+                    break;
+                case detail::timeline_action_end:
+                case detail::timeline_subscribe_end:
+                case detail::timeline_on_next_end:
+                    event(tid, r, name, "E");
+                    os << "}";
+                    break;
+                default:
+                    event(tid, r, name, "i");
+                    os << ",\"s\":\"t\",\"args\":{\"subscriber\":\"" << std::hex << r.id << std::dec << "\"}}";
+                    break;
+                }
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    template<class Worker, class Schedulable>
+    inline void schedule_enter(const Worker&, const Schedulable& s) {
+        ring().push(detail::timeline_schedule, key(s));
+    }
+    template<class Worker>
+    inline void schedule_return(const Worker&) {}
+    template<class Worker, class When, class Schedulable>
+    inline void schedule_when_enter(const Worker&, const When&, const Schedulable& s) {
+        ring().push(detail::timeline_schedule, key(s));
+    }
+    template<class Worker>
+    inline void schedule_when_return(const Worker&) {}
+
+    template<class Schedulable>
+    inline void action_enter(const Schedulable& s) {
+        ring().push(detail::timeline_action_begin, key(s));
+    }
+    template<class Schedulable>
+    inline void action_return(const Schedulable& s) {
+        ring().push(detail::timeline_action_end, key(s));
+    }
+    template<class Schedulable>
+    inline void action_recurse(const Schedulable&) {}
+
+    template<class Observable, class Subscriber>
+    inline void subscribe_enter(const Observable& , const Subscriber& o) {
+        ring().push(detail::timeline_subscribe_begin, o.get_id().id);
+    }
+    template<class Observable>
+    inline void subscribe_return(const Observable& ) {
+        ring().push(detail::timeline_subscribe_end, 0);
+    }
+
+    template<class SubscriberFrom, class SubscriberTo>
+    inline void connect(const SubscriberFrom&, const SubscriberTo&) {}
+
+    template<class OperatorSource, class OperatorChain, class Subscriber, class SubscriberLifted>
+    inline void lift_enter(const OperatorSource&, const OperatorChain&, const Subscriber&, const SubscriberLifted&) {}
+    template<class OperatorSource, class OperatorChain>
+    inline void lift_return(const OperatorSource&, const OperatorChain&) {}
+
+    template<class SubscriptionState>
+    inline void unsubscribe_enter(const SubscriptionState&) {}
+    template<class SubscriptionState>
+    inline void unsubscribe_return(const SubscriptionState&) {}
+
+    template<class SubscriptionState, class Subscription>
+    inline void subscription_add_enter(const SubscriptionState&, const Subscription&) {}
+    template<class SubscriptionState>
+    inline void subscription_add_return(const SubscriptionState&) {}
+
+    template<class SubscriptionState, class WeakSubscription>
+    inline void subscription_remove_enter(const SubscriptionState&, const WeakSubscription&) {}
+    template<class SubscriptionState>
+    inline void subscription_remove_return(const SubscriptionState&) {}
+
+    template<class Subscriber>
+    inline void create_subscriber(const Subscriber&) {}
+
+    template<class Subscriber, class T>
+    inline void on_next_enter(const Subscriber& o, const T&) {
+        ring().push(detail::timeline_on_next_begin, o.get_id().id);
+    }
+    template<class Subscriber>
+    inline void on_next_return(const Subscriber&) {
+        ring().push(detail::timeline_on_next_end, 0);
+    }
+
+    template<class Subscriber>
+    inline void on_error_enter(const Subscriber& o, const std::exception_ptr&) {
+        ring().push(detail::timeline_on_error, o.get_id().id);
+    }
+    template<class Subscriber>
+    inline void on_error_return(const Subscriber&) {}
+
+    template<class Subscriber>
+    inline void on_completed_enter(const Subscriber& o) {
+        ring().push(detail::timeline_on_completed, o.get_id().id);
+    }
+    template<class Subscriber>
+    inline void on_completed_return(const Subscriber&) {}
+
+    template<class Stage>
+    inline void stage_enqueue(const Stage&) {}
+    template<class Stage, class Duration>
+    inline void stage_deliver(const Stage&, const Duration&) {}
+
+    template<class Schedulable, class Duration>
+    inline void deadline_miss(const Schedulable&, const Duration&) {}
+
+    template<class WorkerStats>
+    inline void worker_report(const WorkerStats&) {}
+
+private:
+    static size_t round(size_t capacity) {
+        size_t c = 2;
+        while (c < capacity) {
+            c <<= 1;
+        }
+        return c;
+    }
+    template<class Schedulable>
+    static std::uint64_t key(const Schedulable& s) {
+        return reinterpret_cast<std::uintptr_t>(s.get_action().get_id());
+    }
+    detail::timeline_ring& ring() const {
+        auto& cache = detail::timeline_this_thread_cache();
+        if (cache.id == id) {
+            return *cache.ring;
+        }
+        return detail::timeline_this_thread().find(state);
+    }
+
+    std::shared_ptr<detail::timeline_state> state;
+    std::uint64_t id;
+};
+
+}
+
+#endif
@@ -339,6 +339,22 @@ struct less
         { return std::forward<LHS>(lhs) < std::forward<RHS>(rhs); }
 };
 
+struct equal_to
+{
+    template <class LHS, class RHS>
+    auto operator()(LHS&& lhs, RHS&& rhs) const
+        -> decltype(std::forward<LHS>(lhs) == std::forward<RHS>(rhs))
+        { return std::forward<LHS>(lhs) == std::forward<RHS>(rhs); }
+};
+
+struct hash
+{
+    template <class T>
+    auto operator()(const T& t) const
+        -> decltype(std::hash<T>()(t))
+        { return std::hash<T>()(t); }
+};
+
 namespace detail {
 template<class OStream, class Delimit>
 struct print_function
@@ -488,14 +504,14 @@ public:
         return reinterpret_cast<T*>(&storage);
     }
     const_iterator begin() const {
-        return reinterpret_cast<T*>(&storage);
+        return reinterpret_cast<const T*>(&storage);
     }
 
     iterator end() {
         return reinterpret_cast<T*>(&storage) + size();
     }
     const_iterator end() const {
-        return reinterpret_cast<T*>(&storage) + size();
+        return reinterpret_cast<const T*>(&storage) + size();
     }
 
     T* operator->() {
@@ -504,7 +520,7 @@ public:
     }
     const T* operator->() const {
         if (!is_set) abort();
-        return reinterpret_cast<T*>(&storage);
+        return reinterpret_cast<const T*>(&storage);
     }
 
     T& operator*() {
@@ -513,7 +529,7 @@ public:
     }
     const T& operator*() const {
         if (!is_set) abort();
-        return *reinterpret_cast<T*>(&storage);
+        return *reinterpret_cast<const T*>(&storage);
     }
 
     T& get() {
@@ -555,6 +571,287 @@ public:
     }
 };
 
+
+// vector that keeps the first N elements inline and only allocates
+// when it holds more than N.
+template<class T, size_t N>
+class small_vector
+{
+    typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage_type;
+
+    size_t count;
+    storage_type inline_storage[N];
+    std::vector<T> overflow;
+
+    T* inline_at(size_t i) {
+        return reinterpret_cast<T*>(&inline_storage[i]);
+    }
+    const T* inline_at(size_t i) const {
+        return reinterpret_cast<const T*>(&inline_storage[i]);
+    }
+
+public:
+    typedef T value_type;
+
+    small_vector()
+        : count(0)
+    {
+    }
+    small_vector(small_vector&& o)
+        : count(0)
+    {
+        swap(o);
+    }
+    small_vector& operator=(small_vector o) {
+        swap(o);
+        return *this;
+    }
+    ~small_vector()
+    {
+        clear();
+    }
+
+    size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+
+    T& operator[](size_t i) {
+        return i < N ? *inline_at(i) : overflow[i - N];
+    }
+    const T& operator[](size_t i) const {
+        return i < N ? *inline_at(i) : overflow[i - N];
+    }
+
+    template<class U>
+    void push_back(U&& value) {
+        if (count < N) {
+            new (inline_at(count)) T(std::forward<U>(value));
+        } else {
+            overflow.push_back(std::forward<U>(value));
+        }
+        ++count;
+    }
+
+    void pop_back() {
+        --count;
+        if (count < N) {
+            inline_at(count)->~T();
+        } else {
+            overflow.pop_back();
+        }
+    }
+
+    /// O(1), the last element takes the place of the erased element
+    void erase_unordered(size_t i) {
+        if (i + 1 != count) {
+            (*this)[i] = std::move((*this)[count - 1]);
+        }
+        pop_back();
+    }
+
+    void clear() {
+        while (count > 0) {
+            pop_back();
+        }
+    }
+
+    void swap(small_vector& o) {
+        using std::swap;
+        small_vector* lhs = this;
+        small_vector* rhs = &o;
+        if (lhs->count > rhs->count) {
+            swap(lhs, rhs);
+        }
+        auto shared = (std::min)(lhs->count, N);
+        for (size_t i = 0; i < shared; ++i) {
+            swap(*lhs->inline_at(i), *rhs->inline_at(i));
+        }
+        auto moved = (std::min)(rhs->count, N);
+        for (size_t i = shared; i < moved; ++i) {
+            new (lhs->inline_at(i)) T(std::move(*rhs->inline_at(i)));
+            rhs->inline_at(i)->~T();
+        }
+        swap(lhs->overflow, rhs->overflow);
+        swap(lhs->count, rhs->count);
+    }
+
+    template<class F>
+    void for_each(F f) const {
+        for (size_t i = 0; i < count; ++i) {
+            f((*this)[i]);
+        }
+    }
+};
+
+// first in first out queue in one contiguous ring that doubles when it is
+// full. once it has grown to the most values that are waiting at one time
+// a push does not allocate.
+template<class T>
+class ring_queue
+{
+    std::vector<maybe<T>> ring;
+    size_t first;
+    size_t count;
+
+    maybe<T>& at(size_t i) {
+        return ring[(first + i) % ring.size()];
+    }
+
+    void grow() {
+        std::vector<maybe<T>> next((std::max)(size_t(8), ring.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            next[i].reset(std::move(at(i).get()));
+        }
+        using std::swap;
+        swap(ring, next);
+        first = 0;
+    }
+
+public:
+    ring_queue()
+        : first(0)
+        , count(0)
+    {
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+    size_t size() const {
+        return count;
+    }
+    size_t capacity() const {
+        return ring.size();
+    }
+
+    template<class U>
+    void push_back(U&& u) {
+        if (count == ring.size()) {
+            grow();
+        }
+        at(count).reset(std::forward<U>(u));
+        ++count;
+    }
+    T& front() {
+        return ring[first].get();
+    }
+    void pop_front() {
+        ring[first].reset();
+        first = (first + 1) % ring.size();
+        --count;
+    }
+};
+
+// contiguous values collected for on_next_range. std::vector<bool> has no
+// data(), so bool is kept in an array.
+template<class T>
+class batch_buffer
+{
+    std::vector<T> values;
+
+public:
+    explicit batch_buffer(size_t capacity)
+    {
+        values.reserve(capacity);
+    }
+    template<class U>
+    void push_back(U&& u) {
+        values.push_back(std::forward<U>(u));
+    }
+    const T* data() const {
+        return values.data();
+    }
+    size_t size() const {
+        return values.size();
+    }
+    void clear() {
+        values.clear();
+    }
+};
+
+template<>
+class batch_buffer<bool>
+{
+    std::unique_ptr<bool[]> values;
+    size_t capacity;
+    size_t count;
+
+public:
+    explicit batch_buffer(size_t c)
+        : values(new bool[(std::max)(c, size_t(1))])
+        , capacity((std::max)(c, size_t(1)))
+        , count(0)
+    {
+    }
+    void push_back(bool b) {
+        if (count == capacity) {
+            std::unique_ptr<bool[]> next(new bool[capacity * 2]);
+            std::copy(values.get(), values.get() + count, next.get());
+            values = std::move(next);
+            capacity *= 2;
+        }
+        values[count++] = b;
+    }
+    const bool* data() const {
+        return values.get();
+    }
+    size_t size() const {
+        return count;
+    }
+    void clear() {
+        count = 0;
+    }
+};
+
+#if !defined(RXCPP_CACHE_LINE_SIZE)
+#define RXCPP_CACHE_LINE_SIZE 64
+#endif
+
+// a member that fills one cache line, so that the members before it and the
+// members after it are never in the same line. the heap does not align these
+// objects to a line, so a whole line is needed rather than the rest of one.
+struct cache_line_pad
+{
+    char pad[RXCPP_CACHE_LINE_SIZE];
+};
+
+// lock for sections that are only a few instructions long. an uncontended
+// lock and unlock is one atomic exchange and one store. a waiter spins
+// briefly and then yields so that it does not starve the holder when there
+// are more threads than cores.
+class spin_lock
+{
+    std::atomic<bool> locked;
+
+    spin_lock(const spin_lock&);
+    spin_lock& operator=(const spin_lock&);
+
+public:
+    spin_lock()
+        : locked(false)
+    {
+    }
+
+    bool try_lock() {
+        return !locked.load(std::memory_order_relaxed) &&
+            !locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void lock() {
+        for (int spin = 0; !try_lock(); ++spin) {
+            if (spin >= 64) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() {
+        locked.store(false, std::memory_order_release);
+    }
+};
 }
 using detail::maybe;
 
@@ -581,21 +878,44 @@ inline auto surely(const std::tuple<T...>& tpl)
 }
 
 struct list_not_empty {
-    template<class T>
-    bool operator()(std::list<T>& list) const {
+    template<class List>
+    bool operator()(List& list) const {
         return !list.empty();
     }
 };
 
 struct extract_list_front {
-    template<class T>
-    T operator()(std::list<T>& list) const {
+    template<class List>
+    auto operator()(List& list) const
+        -> decay_t<decltype(list.front())> {
         auto val = std::move(list.front());
         list.pop_front();
         return val;
     }
 };
 
+/// the serializer that copies the bytes of a trivially copyable T. a
+/// serializer writes a value into out and returns the bytes it used, or
+/// more than capacity when the value does not fit. it reads a value back
+/// from the bytes that it wrote.
+template<class T>
+struct bitwise_serializer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "a trivially copyable T or a serializer is needed");
+
+    size_t write(const T& v, char* out, size_t capacity) const {
+        if (capacity >= sizeof(T)) {
+            std::memcpy(out, &v, sizeof(T));
+        }
+        return sizeof(T);
+    }
+    T read(const char* in, size_t) const {
+        typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type raw;
+        std::memcpy(&raw, in, sizeof(T));
+        return *reinterpret_cast<T*>(&raw);
+    }
+};
+
 namespace detail {
 
 template<typename Function>
@@ -0,0 +1,7 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+// the instantiations that rx-extern_templates.hpp declares extern
+
+#define RXCPP_EXTERN_TEMPLATES
+#define RXCPP_INSTANTIATE_TEMPLATES
+#include "rx.hpp"
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_AFFINITY_HPP)
+#define RXCPP_RX_SCHEDULER_AFFINITY_HPP
+
+#include "../rx-includes.hpp"
+
+#if defined(__linux__)
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+#if defined(__linux__)
+
+/// the cpus that this process is allowed to run on
+inline std::vector<int> allowed_cpus() {
+    std::vector<int> result;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+    return result;
+}
+
+/// parses a kernel cpu list, such as "0-3,8-11"
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> result;
+    size_t at = 0;
+    while (at < list.size()) {
+        auto end = list.find(',', at);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        auto range = list.substr(at, end - at);
+        auto dash = range.find('-');
+        if (!range.empty() && range[0] >= '0' && range[0] <= '9') {
+            int first = std::atoi(range.c_str());
+            int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        }
+        at = end + 1;
+    }
+    return result;
+}
+
+/// the allowed cpus of each numa node that has any
+inline std::vector<std::vector<int>> numa_node_cpus() {
+    auto allowed = allowed_cpus();
+    std::vector<std::vector<int>> result;
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) {
+            break;
+        }
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus;
+        for (auto cpu : parse_cpu_list(list)) {
+            if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            result.push_back(std::move(cpus));
+        }
+    }
+    if (result.empty() && !allowed.empty()) {
+        result.push_back(allowed);
+    }
+    return result;
+}
+
+/// pins the calling thread to cpus. returns false when that was refused.
+inline bool pin_this_thread(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+#else
+
+// threads are not pinned on this platform. the policies still report the
+// cpus, so that they can be used to size a scheduler.
+
+inline std::vector<int> allowed_cpus() {
+    std::vector<int> result;
+    auto count = std::max(std::thread::hardware_concurrency(), unsigned(1));
+    for (unsigned cpu = 0; cpu != count; ++cpu) {
+        result.push_back(static_cast<int>(cpu));
+    }
+    return result;
+}
+
+inline std::vector<std::vector<int>> numa_node_cpus() {
+    return std::vector<std::vector<int>>(1, allowed_cpus());
+}
+
+inline bool pin_this_thread(const std::vector<int>&) {
+    return false;
+}
+
+#endif
+
+}
+
+/// the cpus that the threads of a scheduler are pinned to. each thread that
+/// the scheduler starts is pinned to the next set of cpus, round robin. an
+/// empty policy does not pin.
+///
+/// a thread is pinned before it runs, so the memory that it first touches,
+/// such as the queues and timers that grow on the loop, is placed on its
+/// node by the kernel's first touch policy.
+class affinity_policy
+{
+    std::vector<std::vector<int>> sets;
+
+public:
+    affinity_policy()
+    {
+    }
+    explicit affinity_policy(std::vector<std::vector<int>> s)
+        : sets(std::move(s))
+    {
+    }
+
+    const std::vector<std::vector<int>>& cpu_sets() const {
+        return sets;
+    }
+    bool empty() const {
+        return sets.empty();
+    }
+
+    /// each thread on one of the allowed cpus, in order
+    static affinity_policy each_cpu() {
+        return cpus(detail::allowed_cpus());
+    }
+    /// each thread on one of the cpus, in order
+    static affinity_policy cpus(const std::vector<int>& c) {
+        std::vector<std::vector<int>> s;
+        for (auto cpu : c) {
+            s.push_back(std::vector<int>(1, cpu));
+        }
+        return affinity_policy(std::move(s));
+    }
+    /// each thread on the cpus of one numa node, in order
+    static affinity_policy each_numa_node() {
+        return affinity_policy(detail::numa_node_cpus());
+    }
+    /// every thread on the cpus of one numa node
+    static affinity_policy numa_node(int node) {
+        auto nodes = detail::numa_node_cpus();
+        if (node < 0 || node >= static_cast<int>(nodes.size())) {
+            throw std::out_of_range("rxcpp::schedulers::affinity_policy::numa_node");
+        }
+        return affinity_policy(std::vector<std::vector<int>>(1, nodes[node]));
+    }
+    /// each thread on the cpus of one numa node, the cpus of each node in
+    /// order before the next node
+    static affinity_policy each_cpu_by_numa_node() {
+        std::vector<int> c;
+        for (auto& node : detail::numa_node_cpus()) {
+            c.insert(c.end(), node.begin(), node.end());
+        }
+        return cpus(c);
+    }
+};
+
+/// a thread_factory that pins each thread that it starts by policy
+inline thread_factory make_thread_factory(affinity_policy policy) {
+    if (policy.empty()) {
+        return [](std::function<void()> start){
+            return std::thread(std::move(start));
+        };
+    }
+    auto sets = std::make_shared<std::vector<std::vector<int>>>(policy.cpu_sets());
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    return [sets, next](std::function<void()> start){
+        auto& cpus = (*sets)[(*next)++ % sets->size()];
+        return std::thread([](const std::vector<int>& c, const std::function<void()>& s){
+            detail::pin_this_thread(c);
+            s();
+        }, cpus, std::move(start));
+    };
+}
+
+inline scheduler make_new_thread(affinity_policy policy) {
+    return make_new_thread(make_thread_factory(std::move(policy)));
+}
+
+/// an event_loop with a loop pinned to each set of cpus of policy, so
+/// each_cpu() places a loop on each cpu.
+inline scheduler make_event_loop(affinity_policy policy) {
+    if (policy.empty()) {
+        return make_event_loop();
+    }
+    auto count = policy.cpu_sets().size();
+    return make_event_loop(make_thread_factory(std::move(policy)), count);
+}
+
+/// a work_stealing_pool with a thread pinned to each set of cpus of policy.
+/// the timer thread shares the first set.
+inline scheduler make_work_stealing_pool(affinity_policy policy) {
+    if (policy.empty()) {
+        return make_work_stealing_pool();
+    }
+    auto count = policy.cpu_sets().size();
+    return make_work_stealing_pool(make_thread_factory(std::move(policy)), count);
+}
+
+}
+
+}
+
+#endif
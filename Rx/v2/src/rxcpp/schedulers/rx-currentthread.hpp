@@ -13,6 +13,52 @@ namespace schedulers {
 
 namespace detail {
 
+// the items that were scheduled without a time, in the order they were
+// scheduled. the items that have run are at the front of the vector and
+// their space is reused once they are at least half of it, so actions that
+// keep scheduling more actions do not grow it.
+template<class Item>
+struct immediate_fifo
+{
+    typedef Item item_type;
+
+    immediate_fifo()
+        : head(0)
+    {
+    }
+    bool empty() const {
+        return head == items.size();
+    }
+    size_t size() const {
+        return items.size() - head;
+    }
+    /// the space that is held, for the items that are queued and the ones
+    /// that have run and not been reclaimed
+    size_t capacity() const {
+        return items.capacity();
+    }
+    const item_type& front() const {
+        return items[head];
+    }
+    void push(item_type item) {
+        items.push_back(std::move(item));
+    }
+    void pop() {
+        // release the action now, not when the space is reused
+        items[head].what = schedulable();
+        if (++head == items.size()) {
+            items.clear();
+            head = 0;
+        } else if (head > items.size() / 2) {
+            items.erase(items.begin(), items.begin() + head);
+            head = 0;
+        }
+    }
+private:
+    std::vector<item_type> items;
+    size_t head;
+};
+
 struct action_queue
 {
     typedef action_queue this_type;
@@ -23,11 +69,15 @@ struct action_queue
 private:
     typedef schedulable_queue<item_type::time_point_type> queue_item_time;
 
+    typedef immediate_fifo<item_type> queue_item_now;
+
 public:
+    // immediate items go to a fifo, only timed items go to the heap
     struct current_thread_queue_type {
         std::shared_ptr<worker_interface> w;
         recursion r;
         queue_item_time queue;
+        queue_item_now immediate;
     };
 
 private:
@@ -36,6 +86,20 @@ private:
         return queue;
     }
 
+    static current_thread_queue_type* checked() {
+        auto state = current_thread_queue();
+        if (!state) {
+            abort();
+        }
+        return state;
+    }
+
+    // the timed item goes first only when it is due before the immediate item
+    static bool timed_first(const current_thread_queue_type* state) {
+        return state->immediate.empty() ||
+            (!state->queue.empty() && state->queue.top().when < state->immediate.front().when);
+    }
+
 public:
 
     static bool owned() {
@@ -48,33 +112,31 @@ public:
         return current_thread_queue()->r;
     }
     static bool empty() {
-        if (!current_thread_queue()) {
-            abort();
-        }
-        return current_thread_queue()->queue.empty();
+        auto state = checked();
+        return state->immediate.empty() && state->queue.empty();
+    }
+    /// true when top() is a timed item, that may need to be waited for
+    static bool top_is_timed() {
+        return timed_first(checked());
     }
     static queue_item_time::const_reference top() {
-        if (!current_thread_queue()) {
-            abort();
-        }
-        return current_thread_queue()->queue.top();
+        auto state = checked();
+        return timed_first(state) ? state->queue.top() : state->immediate.front();
     }
     static void pop() {
-        auto state = current_thread_queue();
-        if (!state) {
-            abort();
+        auto state = checked();
+        if (timed_first(state)) {
+            state->queue.pop();
+        } else {
+            state->immediate.pop();
         }
-        state->queue.pop();
-        if (state->queue.empty()) {
+        if (state->queue.empty() && state->immediate.empty()) {
             // allow recursion
             state->r.reset(true);
         }
     }
     static void push(item_type item) {
-        auto state = current_thread_queue();
-        if (!state) {
-            abort();
-        }
+        auto state = checked();
         if (!item.what.is_subscribed()) {
             return;
         }
@@ -82,6 +144,16 @@ public:
         // disallow recursion
         state->r.reset(false);
     }
+    /// queue an item that was scheduled without a time
+    static void push_immediate(item_type item) {
+        auto state = checked();
+        if (!item.what.is_subscribed()) {
+            return;
+        }
+        state->immediate.push(std::move(item));
+        // disallow recursion
+        state->r.reset(false);
+    }
     static std::shared_ptr<worker_interface> ensure(std::shared_ptr<worker_interface> w) {
         if (!!current_thread_queue()) {
             abort();
@@ -103,6 +175,13 @@ public:
         // publish new queue
         current_thread_queue() = queue;
     }
+    /// stop publishing the queue that was set, without destroying it
+    static void reset() {
+        if (!current_thread_queue()) {
+            abort();
+        }
+        current_thread_queue() = nullptr;
+    }
     static void destroy(current_thread_queue_type* queue) {
         delete queue;
     }
@@ -144,12 +223,18 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            queue::push(queue::item_type(now(), scbl));
+            queue::push_immediate(queue::item_type(now(), scbl));
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
             queue::push(queue::item_type(when, scbl));
         }
+
+        // the derecurser has no state, so every trampoline shares one
+        static const std::shared_ptr<worker_interface>& instance() {
+            static std::shared_ptr<worker_interface> d = std::make_shared<derecurser>();
+            return d;
+        }
     };
 
     struct current_worker : public worker_interface
@@ -170,56 +255,68 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            schedule(now(), scbl);
+            run(false, clock_type::time_point(), scbl);
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            run(true, when, scbl);
+        }
+
+    private:
+        // the first action runs inline. the queue that takes the actions it
+        // schedules is on the stack, so a trampoline that only runs that
+        // action does not allocate.
+        static void run(bool timed, clock_type::time_point when, const schedulable& scbl) {
             if (!scbl.is_subscribed()) {
                 return;
             }
 
-            {
-                // check ownership
-                if (queue::owned()) {
-                    // already has an owner - delegate
+            // check ownership
+            if (queue::owned()) {
+                // already has an owner - delegate
+                if (timed) {
                     queue::get_worker_interface()->schedule(when, scbl);
-                    return;
+                } else {
+                    queue::get_worker_interface()->schedule(scbl);
                 }
-
-                // take ownership
-                queue::ensure(std::make_shared<derecurser>());
+                return;
             }
+
+            // take ownership
+            queue::current_thread_queue_type trampoline;
+            trampoline.w = derecurser::instance();
+            queue::set(&trampoline);
             // release ownership
             RXCPP_UNWIND_AUTO([]{
-                queue::destroy();
+                queue::reset();
             });
 
             const auto& recursor = queue::get_recursion().get_recurse();
-            std::this_thread::sleep_until(when);
+            if (timed) {
+                std::this_thread::sleep_until(when);
+            }
             if (scbl.is_subscribed()) {
                 scbl(recursor);
             }
-            if (queue::empty()) {
-                return;
-            }
 
             // loop until queue is empty
-            for (
-                auto next = queue::top().when;
-                (std::this_thread::sleep_until(next), true);
-                next = queue::top().when
-            ) {
+            while (!queue::empty()) {
                 auto what = queue::top().what;
+                // an item that was unsubscribed is dropped without waiting
+                // for its time
+                if (!what.is_subscribed()) {
+                    queue::pop();
+                    continue;
+                }
+                if (queue::top_is_timed()) {
+                    std::this_thread::sleep_until(queue::top().when);
+                }
 
                 queue::pop();
 
                 if (what.is_subscribed()) {
                     what(recursor);
                 }
-
-                if (queue::empty()) {
-                    break;
-                }
             }
         }
     };
@@ -227,6 +324,8 @@ private:
     std::shared_ptr<current_worker> wi;
 
 public:
+    typedef current_worker worker_interface_type;
+
     current_thread()
         : wi(std::make_shared<current_worker>())
     {
@@ -248,6 +347,10 @@ public:
     virtual worker create_worker(composite_subscription cs) const {
         return worker(std::move(cs), wi);
     }
+
+    std::shared_ptr<const current_worker> create_worker_interface(const composite_subscription&) const {
+        return wi;
+    }
 };
 
 inline const scheduler& make_current_thread() {
@@ -255,6 +358,12 @@ inline const scheduler& make_current_thread() {
     return instance;
 }
 
+/// a current_thread that schedules without a virtual call
+inline const typed_scheduler<current_thread>& make_typed_current_thread() {
+    static typed_scheduler<current_thread> instance = make_typed_scheduler<current_thread>();
+    return instance;
+}
+
 }
 
 }
@@ -0,0 +1,316 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_EDF_HPP)
+#define RXCPP_RX_SCHEDULER_EDF_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+// One thread runs the actions of all the workers, earliest deadline first.
+//
+// Each worker has a budget. An action that is scheduled now must start by
+// now + budget, an action that is scheduled for a time must start by that
+// time + budget. The actions that are due wait in a heap ordered by their
+// deadline, so a worker with a small budget goes ahead of the workers with a
+// large budget. The actions of one worker keep their order, because their
+// deadlines grow with the time they were scheduled.
+//
+// An action that starts after its deadline is a miss. The misses are counted
+// and passed to the tracer. When the scheduler drops late work, a missed
+// action is not run at all, which suits work that is worthless once it is
+// late, like a frame or a quote.
+//
+// with_budget() returns a scheduler on the same thread whose workers have
+// another budget. observe_on_one_worker on it gives each stream that it
+// observes that budget.
+struct edf_scheduler : public scheduler_interface
+{
+private:
+    typedef edf_scheduler this_type;
+    edf_scheduler(const this_type&);
+
+    struct edf_item
+    {
+        edf_item(clock_type::time_point r, clock_type::time_point d, std::int64_t o, schedulable w)
+            : release(r)
+            , deadline(d)
+            , ordinal(o)
+            , what(std::move(w))
+        {
+        }
+        clock_type::time_point release;
+        clock_type::time_point deadline;
+        std::int64_t ordinal;
+        schedulable what;
+    };
+    struct later_deadline
+    {
+        bool operator()(const edf_item& lhs, const edf_item& rhs) const {
+            return lhs.deadline > rhs.deadline ||
+                (lhs.deadline == rhs.deadline && lhs.ordinal > rhs.ordinal);
+        }
+    };
+    struct later_release
+    {
+        bool operator()(const edf_item& lhs, const edf_item& rhs) const {
+            return lhs.release > rhs.release ||
+                (lhs.release == rhs.release && lhs.ordinal > rhs.ordinal);
+        }
+    };
+
+    struct edf_state
+    {
+        explicit edf_state(bool drop)
+            : drop_late(drop)
+            , ordinal(0)
+            , stopped(false)
+            , misses(0)
+            , dropped(0)
+        {
+        }
+
+        void push(clock_type::time_point release, clock_type::time_point deadline, const schedulable& scbl) {
+            std::unique_lock<std::mutex> guard(lock);
+            if (stopped) {
+                return;
+            }
+            edf_item item(release, deadline, ++ordinal, scbl);
+            if (release <= clock_type::now()) {
+                ready.push(std::move(item));
+            } else {
+                waiting.push(std::move(item));
+            }
+            counters.queued();
+            r.reset(false);
+            wake.notify_one();
+        }
+
+        // call with lock held. moves the timed items that are due to the
+        // ready heap.
+        void release_due(clock_type::time_point now) {
+            while (!waiting.empty() && waiting.top().release <= now) {
+                ready.push(waiting.top());
+                waiting.pop();
+            }
+        }
+
+        void run() {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                thread = std::this_thread::get_id();
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            while (!stopped) {
+                auto now = clock_type::now();
+                release_due(now);
+                if (ready.empty()) {
+                    if (waiting.empty()) {
+                        wake.wait(guard);
+                    } else {
+                        wake.wait_until(guard, waiting.top().release);
+                    }
+                    counters.waited(clock_type::now() - now);
+                    continue;
+                }
+                auto item = ready.top();
+                ready.pop();
+                counters.dequeued();
+                if (!item.what.is_subscribed()) {
+                    continue;
+                }
+                r.reset(ready.empty() && waiting.empty());
+                guard.unlock();
+
+                auto started = clock_type::now();
+                if (item.release != clock_type::time_point()) {
+                    counters.started_timed(started - item.release);
+                }
+                auto missed = started > item.deadline;
+                if (missed) {
+                    ++misses;
+                    trace_activity().deadline_miss(item.what, started - item.deadline);
+                }
+                if (missed && drop_late) {
+                    ++dropped;
+                } else {
+                    item.what(r.get_recurse());
+                    counters.ran(clock_type::now() - started);
+                }
+                if (counters.report_due(started)) {
+                    trace_activity().worker_report(stats());
+                }
+                item.what = schedulable();
+                guard.lock();
+            }
+        }
+
+        void stop() {
+            std::priority_queue<edf_item, std::vector<edf_item>, later_deadline> expired;
+            std::priority_queue<edf_item, std::vector<edf_item>, later_release> expired_waiting;
+            std::unique_lock<std::mutex> guard(lock);
+            stopped = true;
+            using std::swap;
+            swap(expired, ready);
+            swap(expired_waiting, waiting);
+            wake.notify_one();
+        }
+
+        worker_stats stats() const {
+            std::unique_lock<std::mutex> guard(lock);
+            auto result = counters.read();
+            result.thread = thread;
+            return result;
+        }
+
+        const bool drop_late;
+
+        mutable std::mutex lock;
+        std::condition_variable wake;
+        std::priority_queue<edf_item, std::vector<edf_item>, later_deadline> ready;
+        std::priority_queue<edf_item, std::vector<edf_item>, later_release> waiting;
+        std::int64_t ordinal;
+        bool stopped;
+        // set under the lock by the thread
+        std::thread::id thread;
+        detail::worker_counters counters;
+        recursion r;
+        std::atomic<std::uint64_t> misses;
+        std::atomic<std::uint64_t> dropped;
+    };
+    typedef std::shared_ptr<edf_state> state_ptr;
+
+    // stops the thread when the last scheduler that shares it is released
+    struct edf_thread
+    {
+        edf_thread(thread_factory& tf, state_ptr s)
+            : state(std::move(s))
+        {
+            auto keepAlive = state;
+            worker = tf([keepAlive](){
+                keepAlive->run();
+            });
+        }
+        ~edf_thread()
+        {
+            state->stop();
+            if (worker.joinable()) {
+                if (worker.get_id() != std::this_thread::get_id()) {
+                    worker.join();
+                } else {
+                    worker.detach();
+                }
+            }
+        }
+        state_ptr state;
+        std::thread worker;
+    };
+
+    struct edf_worker : public worker_interface
+    {
+    private:
+        typedef edf_worker this_type;
+        edf_worker(const this_type&);
+
+        state_ptr state;
+        clock_type::duration budget;
+
+    public:
+        virtual ~edf_worker()
+        {
+        }
+        edf_worker(state_ptr s, clock_type::duration b)
+            : state(std::move(s))
+            , budget(b)
+        {
+        }
+
+        virtual clock_type::time_point now() const {
+            return clock_type::now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                state->push(clock_type::time_point(), now() + budget, scbl);
+            }
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                state->push(when, when + budget, scbl);
+            }
+        }
+
+        virtual rxu::maybe<worker_stats> stats() const {
+            return rxu::maybe<worker_stats>(state->stats());
+        }
+    };
+
+    std::shared_ptr<edf_thread> owner;
+    clock_type::duration budget;
+
+public:
+    /// the thread comes from tf. late work is dropped when dropLate is set.
+    edf_scheduler(thread_factory tf, clock_type::duration budget, bool dropLate = false)
+        : owner(std::make_shared<edf_thread>(tf, std::make_shared<edf_state>(dropLate)))
+        , budget(budget)
+    {
+    }
+    edf_scheduler(std::shared_ptr<edf_thread> o, clock_type::duration budget)
+        : owner(std::move(o))
+        , budget(budget)
+    {
+    }
+    virtual ~edf_scheduler()
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(std::move(cs), std::make_shared<edf_worker>(owner->state, budget));
+    }
+
+    /// a scheduler on the same thread whose workers have budget
+    scheduler with_budget(clock_type::duration other) const {
+        return make_scheduler<edf_scheduler>(owner, other);
+    }
+    /// a scheduler on the same thread with the same budget
+    scheduler get_scheduler() const {
+        return with_budget(budget);
+    }
+
+    /// the actions that started after their deadline
+    std::uint64_t deadline_misses() const {
+        return owner->state->misses;
+    }
+    /// the late actions that were not run
+    std::uint64_t dropped() const {
+        return owner->state->dropped;
+    }
+
+    virtual std::vector<worker_stats> stats() const {
+        return std::vector<worker_stats>(1, owner->state->stats());
+    }
+};
+
+inline std::shared_ptr<edf_scheduler> make_edf_scheduler(scheduler_base::clock_type::duration budget, bool dropLate = false) {
+    return std::make_shared<edf_scheduler>([](std::function<void()> start){
+        return std::thread(std::move(start));
+    }, budget, dropLate);
+}
+inline std::shared_ptr<edf_scheduler> make_edf_scheduler(thread_factory tf, scheduler_base::clock_type::duration budget, bool dropLate = false) {
+    return std::make_shared<edf_scheduler>(std::move(tf), budget, dropLate);
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,451 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_ELASTIC_HPP)
+#define RXCPP_RX_SCHEDULER_ELASTIC_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+// A pool of between min and max threads shares the work of many workers.
+//
+// Each worker is a strand with its own time ordered queue. A strand with
+// due actions is posted, as a unit, to the shared ready queue. A thread is
+// started when a strand is posted and no thread is idle, until there are max
+// threads. A thread that has been idle for idle_timeout stops, when there
+// are more than min threads. Only one thread runs a given strand at a time,
+// so the actions scheduled on one worker are still called in order and never
+// concurrently.
+//
+// this suits actions that block, such as blocking io in subscribe_on. a
+// burst of blocking work grows the pool instead of taking the event loops,
+// and max bounds the threads that the burst creates.
+struct elastic_pool : public scheduler_interface
+{
+private:
+    typedef elastic_pool this_type;
+    elastic_pool(const this_type&);
+
+    struct pool_state;
+
+    struct strand_state
+    {
+        typedef detail::schedulable_queue<
+            typename clock_type::time_point> queue_item_time;
+
+        typedef queue_item_time::item_type item_type;
+
+        strand_state(composite_subscription cs, std::shared_ptr<pool_state> p)
+            : lifetime(std::move(cs))
+            , pool(std::move(p))
+            , queued(false)
+            , compact_at(min_compact)
+        {
+        }
+
+        // sweep cancelled items out whenever the queue has doubled since
+        // the last sweep so that the queue only holds live work.
+        enum { min_compact = 64 };
+
+        // call with lock held
+        void push(item_type item) const {
+            if (queue.size() >= compact_at) {
+                queue.compact();
+                compact_at = (std::max)(size_t(min_compact), queue.size() * 2);
+            }
+            queue.push(std::move(item));
+        }
+
+        composite_subscription lifetime;
+        std::shared_ptr<pool_state> pool;
+        mutable std::mutex lock;
+        mutable queue_item_time queue;
+        // true while the strand is ready or being run by a pool thread
+        mutable bool queued;
+        mutable size_t compact_at;
+        recursion r;
+    };
+    typedef std::shared_ptr<strand_state> strand_ptr;
+
+    struct timer_item
+    {
+        timer_item(clock_type::time_point when, std::weak_ptr<strand_state> what)
+            : when(when)
+            , what(std::move(what))
+        {
+        }
+        clock_type::time_point when;
+        std::weak_ptr<strand_state> what;
+    };
+    struct timer_later
+    {
+        bool operator()(const timer_item& lhs, const timer_item& rhs) const {
+            return lhs.when > rhs.when;
+        }
+    };
+    typedef std::priority_queue<timer_item, std::vector<timer_item>, timer_later> timer_queue;
+
+    // the stats of one pool thread, kept while it runs
+    struct pool_thread
+    {
+        std::thread::id thread;
+        detail::worker_counters counters;
+    };
+    typedef std::shared_ptr<pool_thread> pool_thread_ptr;
+
+    struct pool_state : public std::enable_shared_from_this<pool_state>
+    {
+        pool_state(thread_factory tf, size_t min, size_t max, clock_type::duration timeout)
+            : factory(std::move(tf))
+            , min_threads(min)
+            , max_threads((std::max)(max, (std::max)(min, size_t(1))))
+            , idle_timeout(timeout)
+            , threads(0)
+            , idle(0)
+            , stopped(false)
+        {
+        }
+
+        thread_factory factory;
+        const size_t min_threads;
+        const size_t max_threads;
+        const clock_type::duration idle_timeout;
+
+        // guards all of the below
+        mutable std::mutex lock;
+        std::condition_variable wake;
+        std::condition_variable exited;
+        std::deque<strand_ptr> ready;
+        timer_queue timers;
+        std::list<pool_thread_ptr> running;
+        // the threads that have started and not yet stopped
+        size_t threads;
+        // the threads that are waiting for work
+        size_t idle;
+        bool stopped;
+
+        static const pool_state*& current_pool() {
+            static RXCPP_THREAD_LOCAL const pool_state* pool;
+            return pool;
+        }
+
+        // call with lock held
+        void start_thread() {
+            ++threads;
+            auto keepAlive = this->shared_from_this();
+            factory([keepAlive](){
+                keepAlive->run();
+            }).detach();
+        }
+
+        // call with lock held. a thread is started when the ready strands
+        // and timers outnumber the threads that are waiting for them.
+        void ensure_thread(size_t waiting) {
+            if (waiting > idle && threads < max_threads) {
+                start_thread();
+            } else if (idle > 0) {
+                wake.notify_one();
+            }
+        }
+
+        void start() {
+            std::unique_lock<std::mutex> guard(lock);
+            while (threads < min_threads) {
+                start_thread();
+            }
+        }
+
+        void post(strand_ptr s) {
+            std::unique_lock<std::mutex> guard(lock);
+            if (stopped) {
+                return;
+            }
+            ready.push_back(std::move(s));
+            ensure_thread(ready.size());
+        }
+
+        void add_timer(clock_type::time_point when, const strand_ptr& s) {
+            std::unique_lock<std::mutex> guard(lock);
+            if (stopped) {
+                return;
+            }
+            auto earliest = timers.empty() || when < timers.top().when;
+            timers.push(timer_item(when, s));
+            if (earliest) {
+                // the waiting threads wait for the earliest timer
+                ensure_thread(ready.size() + 1);
+            }
+        }
+
+        void wake_strand(const strand_ptr& s) {
+            std::unique_lock<std::mutex> guard(s->lock);
+            if (!s->queued && !s->queue.empty()) {
+                s->queued = true;
+                guard.unlock();
+                post(s);
+            }
+        }
+
+        void run() {
+            current_pool() = this;
+            RXCPP_UNWIND_AUTO([]{
+                current_pool() = nullptr;
+            });
+            auto self = std::make_shared<pool_thread>();
+            self->thread = std::this_thread::get_id();
+            auto& counters = self->counters;
+
+            std::unique_lock<std::mutex> guard(lock);
+            running.push_back(self);
+            while (!stopped) {
+                auto now = clock_type::now();
+                if (!timers.empty() && timers.top().when <= now) {
+                    auto s = timers.top().what.lock();
+                    timers.pop();
+                    guard.unlock();
+                    if (!!s) {
+                        wake_strand(s);
+                    }
+                    guard.lock();
+                    continue;
+                }
+                if (!ready.empty()) {
+                    auto s = std::move(ready.front());
+                    ready.pop_front();
+                    guard.unlock();
+                    counters.dequeued();
+                    if (counters.report_due(now)) {
+                        auto report = counters.read();
+                        report.thread = self->thread;
+                        trace_activity().worker_report(report);
+                    }
+                    drain(s, counters);
+                    guard.lock();
+                    continue;
+                }
+                auto until = now + idle_timeout;
+                auto timer = !timers.empty() && timers.top().when < until;
+                ++idle;
+                auto status = wake.wait_until(guard, timer ? timers.top().when : until);
+                --idle;
+                counters.waited(clock_type::now() - now);
+                if (status == std::cv_status::timeout && !timer &&
+                    ready.empty() && threads > min_threads) {
+                    break;
+                }
+            }
+            running.remove(self);
+            if (--threads == 0) {
+                exited.notify_all();
+            }
+        }
+
+        // call the due actions of one strand. after a few actions the strand
+        // goes to the back of the ready queue so that one busy worker cannot
+        // starve the others.
+        void drain(const strand_ptr& s, detail::worker_counters& counters) {
+            int budget = 16;
+            std::unique_lock<std::mutex> guard(s->lock);
+            for (;;) {
+                if (!s->lifetime.is_subscribed() || s->queue.empty()) {
+                    s->queued = false;
+                    return;
+                }
+                auto& peek = s->queue.top();
+                if (!peek.what.is_subscribed()) {
+                    s->queue.pop();
+                    continue;
+                }
+                if (clock_type::now() < peek.when) {
+                    auto when = peek.when;
+                    s->queued = false;
+                    guard.unlock();
+                    add_timer(when, s);
+                    return;
+                }
+                if (budget-- == 0) {
+                    guard.unlock();
+                    post(s);
+                    return;
+                }
+                auto what = peek.what;
+                s->queue.pop();
+                s->r.reset(s->queue.empty());
+                guard.unlock();
+                auto started = clock_type::now();
+                what(s->r.get_recurse());
+                counters.ran(clock_type::now() - started);
+                guard.lock();
+            }
+        }
+
+        size_t thread_count() const {
+            std::unique_lock<std::mutex> guard(lock);
+            return threads;
+        }
+
+        std::vector<worker_stats> stats() const {
+            std::unique_lock<std::mutex> guard(lock);
+            std::vector<worker_stats> result;
+            for (auto& t : running) {
+                auto s = t->counters.read();
+                s.thread = t->thread;
+                result.push_back(s);
+            }
+            return result;
+        }
+
+        // waits for the threads to stop, unless it is called on one of them
+        void stop() {
+            std::deque<strand_ptr> expired;
+            timer_queue expired_timers;
+            std::unique_lock<std::mutex> guard(lock);
+            stopped = true;
+            using std::swap;
+            swap(expired, ready);
+            swap(expired_timers, timers);
+            wake.notify_all();
+            if (current_pool() != this) {
+                exited.wait(guard, [this](){return threads == 0;});
+            }
+        }
+    };
+
+    struct pool_worker : public worker_interface
+    {
+    private:
+        typedef pool_worker this_type;
+        pool_worker(const this_type&);
+
+        strand_ptr state;
+
+    public:
+        virtual ~pool_worker()
+        {
+        }
+
+        pool_worker(composite_subscription cs, std::shared_ptr<pool_state> p)
+            : state(std::make_shared<strand_state>(cs, std::move(p)))
+        {
+            std::weak_ptr<strand_state> weak = state;
+            state->lifetime.add([weak](){
+                auto s = weak.lock();
+                if (!s) {
+                    return;
+                }
+                typename strand_state::queue_item_time expired;
+                std::unique_lock<std::mutex> guard(s->lock);
+                using std::swap;
+                swap(expired, s->queue);
+            });
+        }
+
+        virtual clock_type::time_point now() const {
+            return clock_type::now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            schedule(now(), scbl);
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->push(typename strand_state::item_type(when, scbl));
+            state->r.reset(false);
+            if (state->queued) {
+                return;
+            }
+            if (when <= clock_type::now()) {
+                state->queued = true;
+                guard.unlock();
+                state->pool->post(state);
+            } else {
+                guard.unlock();
+                state->pool->add_timer(when, state);
+            }
+        }
+
+        virtual void schedule_batch(const std::vector<schedulable>& batch) const {
+            auto when = now();
+            std::unique_lock<std::mutex> guard(state->lock);
+            bool any = false;
+            for (auto& scbl : batch) {
+                if (scbl.is_subscribed()) {
+                    state->push(typename strand_state::item_type(when, scbl));
+                    any = true;
+                }
+            }
+            if (!any) {
+                return;
+            }
+            state->r.reset(false);
+            if (state->queued) {
+                return;
+            }
+            state->queued = true;
+            guard.unlock();
+            state->pool->post(state);
+        }
+    };
+
+    std::shared_ptr<pool_state> state;
+
+public:
+    /// the default idle_timeout
+    static clock_type::duration default_idle_timeout() {
+        return std::chrono::seconds(60);
+    }
+
+    elastic_pool(thread_factory tf, size_t min_threads, size_t max_threads, clock_type::duration idle_timeout = default_idle_timeout())
+        : state(std::make_shared<pool_state>(std::move(tf), min_threads, max_threads, idle_timeout))
+    {
+        state->start();
+    }
+    virtual ~elastic_pool()
+    {
+        state->stop();
+    }
+
+    virtual clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<pool_worker>(cs, state));
+    }
+
+    /// the threads that run now
+    size_t thread_count() const {
+        return state->thread_count();
+    }
+
+    /// the stats of each pool thread that runs now
+    virtual std::vector<worker_stats> stats() const {
+        return state->stats();
+    }
+};
+
+/// a pool that grows to max_threads while there is work and shrinks to
+/// min_threads after idle_timeout without work.
+inline scheduler make_elastic_pool(size_t min_threads, size_t max_threads, scheduler_base::clock_type::duration idle_timeout = elastic_pool::default_idle_timeout()) {
+    thread_factory tf([](std::function<void()> start){
+        return std::thread(std::move(start));
+    });
+    return make_scheduler<elastic_pool>(std::move(tf), min_threads, max_threads, idle_timeout);
+}
+inline scheduler make_elastic_pool(thread_factory tf, size_t min_threads, size_t max_threads, scheduler_base::clock_type::duration idle_timeout = elastic_pool::default_idle_timeout()) {
+    return make_scheduler<elastic_pool>(std::move(tf), min_threads, max_threads, idle_timeout);
+}
+
+}
+
+}
+
+#endif
@@ -52,35 +52,114 @@ private:
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
             controller.schedule(when, lifetime, scbl.get_action());
         }
+
+        // the loop takes the whole batch at once
+        virtual void schedule_batch(const std::vector<schedulable>& batch) const {
+            std::vector<schedulable> actions;
+            actions.reserve(batch.size());
+            for (auto& scbl : batch) {
+                if (scbl.is_subscribed()) {
+                    actions.push_back(make_schedulable(controller, lifetime, scbl.get_action()));
+                }
+            }
+            controller.schedule_batch(actions);
+        }
+
+        virtual rxu::maybe<worker_stats> stats() const {
+            return controller.stats();
+        }
+
+        virtual const worker_interface* executor() const {
+            return controller.executor();
+        }
+    };
+
+    // the thread of a loop is started by the first worker that is given to
+    // it, or by warm_up()
+    struct loop_slot
+    {
+        loop_slot()
+            : ready(false)
+        {
+        }
+        std::once_flag started;
+        std::atomic<bool> ready;
+        // a worker for each schedule_priority lane of the loop
+        std::vector<worker> lanes;
     };
 
     mutable thread_factory factory;
-    scheduler newthread;
+    std::shared_ptr<new_thread> newthread;
     mutable std::atomic<size_t> count;
-    std::vector<worker> loops;
+    size_t loop_count;
+    std::unique_ptr<loop_slot[]> loops;
+
+    static size_t default_count() {
+        return std::max(std::thread::hardware_concurrency(), unsigned(4)) - 1;
+    }
+
+    const worker& loop(size_t i, schedule_priority::type lane = schedule_priority::normal) const {
+        auto& slot = loops[i];
+        std::call_once(slot.started, [&](){
+            slot.lanes = newthread->create_lane_workers(composite_subscription());
+            slot.ready.store(true, std::memory_order_release);
+        });
+        return slot.lanes[lane];
+    }
 
 public:
     event_loop()
         : factory([](std::function<void()> start){
             return std::thread(std::move(start));
         })
-        , newthread(make_new_thread())
+        , newthread(std::make_shared<new_thread>())
         , count(0)
+        , loop_count(default_count())
+        , loops(new loop_slot[loop_count])
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (--remaining) {
-            loops.push_back(newthread.create_worker());
-        }
     }
     explicit event_loop(thread_factory tf)
         : factory(tf)
-        , newthread(make_new_thread(tf))
+        , newthread(std::make_shared<new_thread>(tf))
         , count(0)
+        , loop_count(default_count())
+        , loops(new loop_slot[loop_count])
+    {
+    }
+    /// timed actions on each loop are kept in a timer_wheel with ticks of timer_resolution.
+    event_loop(thread_factory tf, clock_type::duration timer_resolution)
+        : factory(tf)
+        , newthread(std::make_shared<new_thread>(tf, timer_resolution))
+        , count(0)
+        , loop_count(default_count())
+        , loops(new loop_slot[loop_count])
+    {
+    }
+    /// a loop on each of count threads from tf
+    event_loop(thread_factory tf, size_t count)
+        : factory(tf)
+        , newthread(std::make_shared<new_thread>(tf))
+        , count(0)
+        , loop_count(std::max(count, size_t(1)))
+        , loops(new loop_slot[loop_count])
+    {
+    }
+    /// each loop waits for work as idle says.
+    event_loop(thread_factory tf, idle_strategy idle)
+        : factory(tf)
+        , newthread(std::make_shared<new_thread>(tf, idle))
+        , count(0)
+        , loop_count(default_count())
+        , loops(new loop_slot[loop_count])
+    {
+    }
+    event_loop(thread_factory tf, size_t count, idle_strategy idle)
+        : factory(tf)
+        , newthread(std::make_shared<new_thread>(tf, idle))
+        , count(0)
+        , loop_count(std::max(count, size_t(1)))
+        , loops(new loop_slot[loop_count])
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (--remaining) {
-            loops.push_back(newthread.create_worker());
-        }
     }
     virtual ~event_loop()
     {
@@ -91,17 +170,66 @@ public:
     }
 
     virtual worker create_worker(composite_subscription cs) const {
-        return worker(cs, std::make_shared<loop_worker>(cs, loops[++count % loops.size()]));
+        return worker(cs, std::make_shared<loop_worker>(cs, loop(++count % loop_count)));
+    }
+
+    /// the actions of a worker in the high lane run before the actions that
+    /// are already waiting in the normal and bulk lanes of the same loop
+    virtual worker create_lane_worker(composite_subscription cs, schedule_priority::type lane) const {
+        return worker(cs, std::make_shared<loop_worker>(cs, loop(++count % loop_count, lane)));
+    }
+
+    /// starts the threads of the loops that have not been given a worker yet
+    virtual void warm_up() const {
+        for (size_t i = 0; i != loop_count; ++i) {
+            loop(i);
+        }
+    }
+
+    /// drains the loops, see new_thread::shutdown. a loop that had not
+    /// started stays idle.
+    virtual bool shutdown(clock_type::time_point deadline) const {
+        return newthread->shutdown(deadline);
+    }
+
+    /// the stats of each loop that has started
+    virtual std::vector<worker_stats> stats() const {
+        std::vector<worker_stats> result;
+        for (size_t i = 0; i != loop_count; ++i) {
+            if (!loops[i].ready.load(std::memory_order_acquire)) {
+                continue;
+            }
+            auto s = loops[i].lanes[schedule_priority::normal].stats();
+            if (!s.empty()) {
+                result.push_back(s.get());
+            }
+        }
+        return result;
     }
 };
 
+/// the event_loop that the process shares. it refuses shutdown and returns
+/// false like make_new_thread(). to drain on shutdown, use an event_loop of
+/// your own, such as make_event_loop(tf) or make_scheduler<event_loop>().
 inline scheduler make_event_loop() {
-    static scheduler instance = make_scheduler<event_loop>();
+    static scheduler instance = detail::make_shared_scheduler<event_loop>();
     return instance;
 }
 inline scheduler make_event_loop(thread_factory tf) {
     return make_scheduler<event_loop>(tf);
 }
+inline scheduler make_event_loop(thread_factory tf, scheduler_base::clock_type::duration timer_resolution) {
+    return make_scheduler<event_loop>(tf, timer_resolution);
+}
+inline scheduler make_event_loop(thread_factory tf, size_t count) {
+    return make_scheduler<event_loop>(tf, count);
+}
+inline scheduler make_event_loop(thread_factory tf, idle_strategy idle) {
+    return make_scheduler<event_loop>(tf, idle);
+}
+inline scheduler make_event_loop(thread_factory tf, size_t count, idle_strategy idle) {
+    return make_scheduler<event_loop>(tf, count, idle);
+}
 
 }
 
@@ -17,16 +17,121 @@ private:
     typedef immediate this_type;
     immediate(const this_type&);
 
+    // an action runs directly while fewer than max_depth actions of the
+    // same immediate are running on the thread. deeper ones wait in a queue
+    // owned by the outermost action of that immediate and run, each with the
+    // whole depth again, when it returns. so shallow schedules keep their
+    // order and a long chain of schedules from inside actions runs in
+    // bounded stack. the bound is kept for each immediate, an action of one
+    // does not count towards the depth of another.
     struct immediate_worker : public worker_interface
     {
     private:
         typedef immediate_worker this_type;
         immediate_worker(const this_type&);
+
+        typedef std::deque<schedulable> pending_type;
+
+        // the outermost action of an immediate on a thread. the frames of
+        // the immediates that run inside each other are chained.
+        struct frame
+        {
+            frame(const this_type* o, pending_type* p, frame* f)
+                : owner(o)
+                , depth(1)
+                , pending(p)
+                , parent(f)
+            {
+            }
+            const this_type* owner;
+            int depth;
+            pending_type* pending;
+            frame* parent;
+        };
+
+        static frame*& current_frame() {
+            static RXCPP_THREAD_LOCAL frame* current;
+            return current;
+        }
+
+        // the frame of this immediate, usually the innermost one
+        frame* find_frame() const {
+            auto f = current_frame();
+            while (f != nullptr && f->owner != this) {
+                f = f->parent;
+            }
+            return f;
+        }
+
+        // restores the frame when the outermost action returns or throws
+        struct frame_scope
+        {
+            explicit frame_scope(frame& f)
+                : f(f)
+            {
+                current_frame() = &f;
+            }
+            ~frame_scope()
+            {
+                current_frame() = f.parent;
+            }
+            frame& f;
+        };
+
+        // restores the depth when a nested action returns or throws
+        struct depth_scope
+        {
+            explicit depth_scope(frame& f)
+                : f(f)
+            {
+                ++f.depth;
+            }
+            ~depth_scope()
+            {
+                --f.depth;
+            }
+            frame& f;
+        };
+
+        static void call(const schedulable& scbl) {
+            if (scbl.is_subscribed()) {
+                // allow recursion
+                recursion r(true);
+                scbl(r.get_recurse());
+            }
+        }
+
+        void run(const schedulable& scbl) const {
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            auto f = find_frame();
+            if (f == nullptr) {
+                pending_type pending;
+                frame outermost(this, &pending, current_frame());
+                frame_scope scope(outermost);
+                call(scbl);
+                while (!pending.empty()) {
+                    auto next = std::move(pending.front());
+                    pending.pop_front();
+                    call(next);
+                }
+            } else if (f->depth < max_depth) {
+                depth_scope scope(*f);
+                call(scbl);
+            } else {
+                f->pending->push_back(scbl);
+            }
+        }
+
+        int max_depth;
+
     public:
         virtual ~immediate_worker()
         {
         }
-        immediate_worker()
+        explicit immediate_worker(int md)
+            : max_depth((std::max)(md, 1))
         {
         }
 
@@ -35,28 +140,30 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            if (scbl.is_subscribed()) {
-                // allow recursion
-                recursion r(true);
-                scbl(r.get_recurse());
-            }
+            run(scbl);
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
             std::this_thread::sleep_until(when);
-            if (scbl.is_subscribed()) {
-                // allow recursion
-                recursion r(true);
-                scbl(r.get_recurse());
-            }
+            run(scbl);
+        }
+
+        // the actions run inside the action that scheduled them
+        virtual const worker_interface* executor() const {
+            return rxsc::detail::current_executor();
         }
     };
 
     std::shared_ptr<immediate_worker> wi;
 
 public:
-    immediate()
-        : wi(std::make_shared<immediate_worker>())
+    typedef immediate_worker worker_interface_type;
+
+    /// max_depth is how many actions of this immediate can run inside each
+    /// other on a thread before more are queued until the outermost returns.
+    /// each immediate keeps its own bound.
+    explicit immediate(int max_depth = 256)
+        : wi(std::make_shared<immediate_worker>(max_depth))
     {
     }
     virtual ~immediate()
@@ -70,6 +177,10 @@ public:
     virtual worker create_worker(composite_subscription cs) const {
         return worker(std::move(cs), wi);
     }
+
+    std::shared_ptr<const immediate_worker> create_worker_interface(const composite_subscription&) const {
+        return wi;
+    }
 };
 
 inline const scheduler& make_immediate() {
@@ -77,6 +188,17 @@ inline const scheduler& make_immediate() {
     return instance;
 }
 
+/// an immediate that queues the actions scheduled deeper than max_depth
+inline scheduler make_immediate(int max_depth) {
+    return make_scheduler<immediate>(max_depth);
+}
+
+/// an immediate that schedules without a virtual call
+inline const typed_scheduler<immediate>& make_typed_immediate() {
+    static typed_scheduler<immediate> instance = make_typed_scheduler<immediate>();
+    return instance;
+}
+
 }
 
 }
@@ -0,0 +1,507 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_IO_EVENT_LOOP_HPP)
+#define RXCPP_RX_SCHEDULER_IO_EVENT_LOOP_HPP
+
+// this scheduler waits on file descriptors, so it is not included by rx.hpp.
+// include "rxcpp/schedulers/rx-io_event_loop.hpp" to use it.
+
+#include "../rx-includes.hpp"
+
+#if defined(_WIN32)
+#error "io_event_loop needs epoll or poll"
+#endif
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#else
+#include <poll.h>
+#endif
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+inline std::system_error io_error(const char* what) {
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+#if defined(__linux__)
+
+// waits for any of the added file descriptors to be readable, or for wake.
+class io_poller
+{
+    int poll_fd;
+    int wake_fd;
+
+    io_poller(const io_poller&);
+    io_poller& operator=(const io_poller&);
+
+public:
+    io_poller()
+        : poll_fd(::epoll_create1(EPOLL_CLOEXEC))
+        , wake_fd(-1)
+    {
+        if (poll_fd < 0) {
+            throw io_error("io_event_loop: epoll_create1");
+        }
+        wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake_fd < 0) {
+            auto e = io_error("io_event_loop: eventfd");
+            ::close(poll_fd);
+            throw e;
+        }
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if (::epoll_ctl(poll_fd, EPOLL_CTL_ADD, wake_fd, &ev) != 0) {
+            auto e = io_error("io_event_loop: epoll_ctl");
+            ::close(wake_fd);
+            ::close(poll_fd);
+            throw e;
+        }
+    }
+    ~io_poller()
+    {
+        ::close(wake_fd);
+        ::close(poll_fd);
+    }
+
+    // safe to call from any thread
+    void add(int fd, void* key) const {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = key;
+        if (::epoll_ctl(poll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            throw io_error("io_event_loop: epoll_ctl");
+        }
+    }
+    // only called by the loop thread. the fd might already be closed.
+    void remove(int fd) const {
+        epoll_event ev = {};
+        ::epoll_ctl(poll_fd, EPOLL_CTL_DEL, fd, &ev);
+    }
+    void wake() const {
+        uint64_t one = 1;
+        auto written = ::write(wake_fd, &one, sizeof(one));
+        (void)written;
+    }
+    // timeout in milliseconds, -1 waits until an fd is ready or wake is called
+    void wait(int timeout, std::vector<void*>& ready) const {
+        epoll_event events[64];
+        int count = ::epoll_wait(poll_fd, events, 64, timeout);
+        for (int i = 0; i < count; ++i) {
+            if (!events[i].data.ptr) {
+                uint64_t value;
+                auto read = ::read(wake_fd, &value, sizeof(value));
+                (void)read;
+                continue;
+            }
+            ready.push_back(events[i].data.ptr);
+        }
+    }
+};
+
+#else
+
+// waits for any of the added file descriptors to be readable, or for wake.
+// poll is used where there is no epoll.
+class io_poller
+{
+    int wake_fds[2];
+    mutable std::mutex lock;
+    mutable std::map<int, void*> keys;
+
+    io_poller(const io_poller&);
+    io_poller& operator=(const io_poller&);
+
+public:
+    io_poller()
+    {
+        if (::pipe(wake_fds) != 0) {
+            throw io_error("io_event_loop: pipe");
+        }
+        for (auto fd : wake_fds) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+    ~io_poller()
+    {
+        ::close(wake_fds[0]);
+        ::close(wake_fds[1]);
+    }
+
+    // safe to call from any thread
+    void add(int fd, void* key) const {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (!keys.insert(std::make_pair(fd, key)).second) {
+                errno = EEXIST;
+                throw io_error("io_event_loop: poll");
+            }
+        }
+        // the loop thread must poll the new fd
+        wake();
+    }
+    // only called by the loop thread
+    void remove(int fd) const {
+        std::unique_lock<std::mutex> guard(lock);
+        keys.erase(fd);
+    }
+    void wake() const {
+        char one = 1;
+        auto written = ::write(wake_fds[1], &one, 1);
+        (void)written;
+    }
+    // timeout in milliseconds, -1 waits until an fd is ready or wake is called
+    void wait(int timeout, std::vector<void*>& ready) const {
+        std::vector<pollfd> fds;
+        std::vector<void*> polled;
+        pollfd wakeup = {wake_fds[0], POLLIN, 0};
+        fds.push_back(wakeup);
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            for (auto& k : keys) {
+                pollfd p = {k.first, POLLIN, 0};
+                fds.push_back(p);
+                polled.push_back(k.second);
+            }
+        }
+        if (::poll(&fds[0], fds.size(), timeout) <= 0) {
+            return;
+        }
+        if (fds[0].revents) {
+            char drain[64];
+            while (::read(wake_fds[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (fds[i].revents) {
+                ready.push_back(polled[i - 1]);
+            }
+        }
+    }
+};
+
+#endif
+
+}
+
+/// io_event_loop runs actions on a few loop threads that also wait for file
+/// descriptors to be readable, using epoll on linux and poll elsewhere. a
+/// loop thread is blocked in the poller whenever it has no action to run.
+struct io_event_loop : public scheduler_interface
+{
+private:
+    typedef io_event_loop this_type;
+    io_event_loop(const this_type&);
+
+    // the poller waits on a copy of the fd. the number of the copy is not
+    // reused until the watch is gone, so a late remove cannot take away a
+    // new fd that was given the number of a closed one.
+    struct io_watch
+    {
+        io_watch(int watched, composite_subscription cs, std::function<void()> r)
+            : fd(::fcntl(watched, F_DUPFD_CLOEXEC, 0))
+            , lifetime(std::move(cs))
+            , ready(std::move(r))
+        {
+            if (fd < 0) {
+                throw detail::io_error("io_event_loop: dup");
+            }
+        }
+        ~io_watch()
+        {
+            ::close(fd);
+        }
+        int fd;
+        composite_subscription lifetime;
+        std::function<void()> ready;
+    };
+
+    struct loop_state
+    {
+        typedef detail::schedulable_queue<clock_type::time_point> queue_item_time;
+        typedef queue_item_time::item_type item_type;
+
+        loop_state()
+        {
+        }
+        virtual ~loop_state()
+        {
+            // the last reference is released by the loop thread
+            if (worker.joinable()) {
+                worker.detach();
+            }
+        }
+
+        void stop() {
+            lifetime.unsubscribe();
+            poller.wake();
+            if (worker.joinable() && !on_loop_thread()) {
+                worker.join();
+            }
+        }
+
+        bool on_loop_thread() const {
+            return worker.get_id() == std::this_thread::get_id();
+        }
+
+        void push(schedulable scbl) const {
+            std::unique_lock<std::mutex> guard(lock);
+            immediate.push_back(std::move(scbl));
+            r.reset(false);
+            guard.unlock();
+            if (!on_loop_thread()) {
+                poller.wake();
+            }
+        }
+        void push(clock_type::time_point when, schedulable scbl) const {
+            std::unique_lock<std::mutex> guard(lock);
+            timed.push(item_type(when, std::move(scbl)));
+            r.reset(false);
+            guard.unlock();
+            if (!on_loop_thread()) {
+                poller.wake();
+            }
+        }
+
+        void watch(std::shared_ptr<io_watch> w) const {
+            auto key = w.get();
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                watches[key] = w;
+            }
+            try {
+                poller.add(w->fd, key);
+            } catch (...) {
+                std::unique_lock<std::mutex> guard(lock);
+                watches.erase(key);
+                throw;
+            }
+        }
+        // the watch is removed by the loop thread, after any event for it
+        // in the current batch has been dispatched
+        void retire(io_watch* key) const {
+            std::unique_lock<std::mutex> guard(lock);
+            retired.push_back(key);
+            guard.unlock();
+            if (!on_loop_thread()) {
+                poller.wake();
+            }
+        }
+
+        void run() const {
+            std::vector<void*> ready;
+            std::deque<schedulable> now;
+            std::vector<io_watch*> gone;
+            for (;;) {
+                if (!lifetime.is_subscribed()) {
+                    break;
+                }
+
+                int timeout = -1;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    gone.swap(retired);
+                    for (auto key : gone) {
+                        auto found = watches.find(key);
+                        if (found != watches.end()) {
+                            poller.remove(key->fd);
+                            watches.erase(found);
+                        }
+                    }
+                    gone.clear();
+
+                    // timed items that are due run before the immediate
+                    // items that are already queued
+                    auto current = clock_type::now();
+                    while (!timed.empty() && (!timed.top().what.is_subscribed() || timed.top().when <= current)) {
+                        if (timed.top().what.is_subscribed()) {
+                            now.push_back(timed.top().what);
+                        }
+                        timed.pop();
+                    }
+                    while (!immediate.empty()) {
+                        now.push_back(std::move(immediate.front()));
+                        immediate.pop_front();
+                    }
+                    if (now.empty() && !timed.empty()) {
+                        auto due = std::chrono::duration_cast<std::chrono::milliseconds>(timed.top().when - current).count() + 1;
+                        timeout = static_cast<int>((std::min)(due, static_cast<decltype(due)>(std::numeric_limits<int>::max())));
+                    }
+                }
+
+                if (!now.empty()) {
+                    while (!now.empty() && lifetime.is_subscribed()) {
+                        auto what = std::move(now.front());
+                        now.pop_front();
+                        if (what.is_subscribed()) {
+                            r.reset(now.empty());
+                            what(r.get_recurse());
+                        }
+                    }
+                    now.clear();
+                    timeout = 0;
+                }
+
+                poller.wait(timeout, ready);
+                for (auto key : ready) {
+                    auto w = static_cast<io_watch*>(key);
+                    if (w->lifetime.is_subscribed()) {
+                        w->ready();
+                    }
+                }
+                ready.clear();
+            }
+        }
+
+        composite_subscription lifetime;
+        detail::io_poller poller;
+        mutable std::mutex lock;
+        mutable std::deque<schedulable> immediate;
+        mutable queue_item_time timed;
+        mutable std::map<io_watch*, std::shared_ptr<io_watch>> watches;
+        mutable std::vector<io_watch*> retired;
+        mutable recursion r;
+        std::thread worker;
+    };
+
+    struct io_worker : public worker_interface
+    {
+    private:
+        typedef io_worker this_type;
+        io_worker(const this_type&);
+
+        std::shared_ptr<loop_state> state;
+
+    public:
+        virtual ~io_worker()
+        {
+        }
+        explicit io_worker(std::shared_ptr<loop_state> ls)
+            : state(std::move(ls))
+        {
+        }
+
+        virtual clock_type::time_point now() const {
+            return clock_type::now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                state->push(scbl);
+            }
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                state->push(when, scbl);
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<loop_state>> loops;
+    mutable std::atomic<size_t> count;
+
+    void start(thread_factory& tf, size_t size) {
+        size = (std::max)(size, size_t(1));
+        for (size_t i = 0; i < size; ++i) {
+            auto state = std::make_shared<loop_state>();
+            std::weak_ptr<loop_state> weak = state;
+            state->worker = tf([weak](){
+                auto keepAlive = weak.lock();
+                if (!keepAlive) {
+                    return;
+                }
+                // take ownership
+                detail::action_queue::ensure(std::make_shared<io_worker>(keepAlive));
+                // release ownership
+                RXCPP_UNWIND_AUTO([]{
+                    detail::action_queue::destroy();
+                });
+                keepAlive->run();
+            });
+            loops.push_back(std::move(state));
+        }
+    }
+
+    const std::shared_ptr<loop_state>& next_loop() const {
+        return loops[++count % loops.size()];
+    }
+
+public:
+    io_event_loop()
+        : count(0)
+    {
+        thread_factory tf = [](std::function<void()> start){
+            return std::thread(std::move(start));
+        };
+        start(tf, std::thread::hardware_concurrency());
+    }
+    io_event_loop(thread_factory tf, size_t size)
+        : count(0)
+    {
+        start(tf, size);
+    }
+    virtual ~io_event_loop()
+    {
+        for (auto& loop : loops) {
+            loop->stop();
+        }
+    }
+
+    virtual clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    /// actions scheduled on the worker run on one of the loop threads
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<io_worker>(next_loop()));
+    }
+
+    /// call ready on one of the loop threads each time fd is readable, until
+    /// cs is unsubscribed. ready should read once and return, the loop keeps
+    /// calling it while there is more to read. fd must stay open until cs is
+    /// unsubscribed.
+    void watch_readable(int fd, composite_subscription cs, std::function<void()> ready) const {
+        auto& loop = next_loop();
+        auto w = std::make_shared<io_watch>(fd, cs, std::move(ready));
+        loop->watch(w);
+        std::weak_ptr<loop_state> weak = loop;
+        auto key = w.get();
+        cs.add([weak, key](){
+            auto state = weak.lock();
+            if (state) {
+                state->retire(key);
+            }
+        });
+    }
+
+    scheduler get_scheduler() const {
+        return scheduler(shared_from_this());
+    }
+};
+
+inline std::shared_ptr<io_event_loop> make_io_event_loop() {
+    static std::shared_ptr<io_event_loop> instance = std::make_shared<io_event_loop>();
+    return instance;
+}
+inline std::shared_ptr<io_event_loop> make_io_event_loop(thread_factory tf, size_t size) {
+    return std::make_shared<io_event_loop>(tf, size);
+}
+
+}
+
+}
+
+#endif
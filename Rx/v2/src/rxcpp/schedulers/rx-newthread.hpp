@@ -13,27 +13,193 @@ namespace schedulers {
 
 typedef std::function<std::thread(std::function<void()>)> thread_factory;
 
+/// how a new_thread worker waits when it has nothing to run. it looks for
+/// work spins times, then yields yields times and then parks until a producer
+/// wakes it. a parked worker costs the next producer a lock and a wake, a
+/// spinning worker costs a core.
+struct idle_strategy
+{
+    idle_strategy(size_t spins, size_t yields, bool parks)
+        : spins(spins)
+        , yields(yields)
+        , parks(parks)
+    {
+    }
+
+    size_t spins;
+    size_t yields;
+    bool parks;
+
+    /// park as soon as there is nothing to run. this is the default
+    static idle_strategy park() {
+        return idle_strategy(0, 0, true);
+    }
+    /// spin and then yield before parking
+    static idle_strategy spin_yield_park(size_t spins = 10000, size_t yields = 100) {
+        return idle_strategy(spins, yields, true);
+    }
+    /// never park or yield. the worker thread keeps its core while it lives
+    static idle_strategy busy_spin() {
+        return idle_strategy(0, 0, false);
+    }
+};
+
+/// threads that are kept to run one function after another. a thread that
+/// has run its function waits keep_alive for the next one and then stops.
+/// at most max_idle threads wait at once, the rest stop at once.
+class thread_cache : public std::enable_shared_from_this<thread_cache>
+{
+    typedef scheduler_base::clock_type clock_type;
+
+    struct cached_thread
+    {
+        std::mutex lock;
+        std::condition_variable wake;
+        std::function<void()> work;
+    };
+    typedef std::shared_ptr<cached_thread> cached_thread_ptr;
+
+    thread_factory factory;
+    clock_type::duration keep_alive;
+    size_t max_idle;
+    std::mutex lock;
+    std::vector<cached_thread_ptr> idle;
+
+    // true when t was still waiting and has been taken out of idle
+    bool retire(const cached_thread_ptr& t) {
+        std::unique_lock<std::mutex> guard(lock);
+        auto it = std::find(idle.begin(), idle.end(), t);
+        if (it == idle.end()) {
+            return false;
+        }
+        idle.erase(it);
+        return true;
+    }
+
+    void loop(const cached_thread_ptr& t) {
+        for (;;) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> guard(t->lock);
+                swap(f, t->work);
+            }
+            f();
+            // release what the function holds before waiting
+            f = nullptr;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (idle.size() >= max_idle) {
+                    return;
+                }
+                idle.push_back(t);
+            }
+            std::unique_lock<std::mutex> guard(t->lock);
+            if (!t->wake.wait_for(guard, keep_alive, [&](){return !!t->work;})) {
+                guard.unlock();
+                if (retire(t)) {
+                    return;
+                }
+                // taken just as the wait ended, the work is on its way
+                guard.lock();
+                t->wake.wait(guard, [&](){return !!t->work;});
+            }
+        }
+    }
+
+public:
+    thread_cache(thread_factory tf, clock_type::duration keep_alive, size_t max_idle)
+        : factory(std::move(tf))
+        , keep_alive(keep_alive)
+        , max_idle(max_idle)
+    {
+    }
+
+    /// calls f on a waiting thread, or on a new thread when none is waiting
+    void run(std::function<void()> f) {
+        cached_thread_ptr t;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (!idle.empty()) {
+                t = std::move(idle.back());
+                idle.pop_back();
+            }
+        }
+        if (!!t) {
+            std::unique_lock<std::mutex> guard(t->lock);
+            t->work = std::move(f);
+            t->wake.notify_one();
+            return;
+        }
+        t = std::make_shared<cached_thread>();
+        t->work = std::move(f);
+        auto keepAlive = shared_from_this();
+        factory([keepAlive, t](){
+            keepAlive->loop(t);
+        }).detach();
+    }
+
+    /// the threads that wait for a function now
+    size_t idle_count() {
+        std::unique_lock<std::mutex> guard(lock);
+        return idle.size();
+    }
+};
+
+inline std::shared_ptr<thread_cache> make_thread_cache(
+    thread_factory tf,
+    scheduler_base::clock_type::duration keep_alive = std::chrono::seconds(60),
+    size_t max_idle = 64) {
+    return std::make_shared<thread_cache>(std::move(tf), keep_alive, max_idle);
+}
+inline std::shared_ptr<thread_cache> make_thread_cache() {
+    return make_thread_cache([](std::function<void()> start){
+        return std::thread(std::move(start));
+    });
+}
+
 struct new_thread : public scheduler_interface
 {
 private:
     typedef new_thread this_type;
     new_thread(const this_type&);
 
-    struct new_worker : public worker_interface
+    // the part of a worker that the scheduler reaches through its registry
+    struct registered_worker : public worker_interface
+    {
+        // refuse the work from other threads and stop once the work that is
+        // due by deadline has run
+        virtual void close(clock_type::time_point deadline) const = 0;
+        // false when the work was cancelled at the deadline
+        virtual bool wait_drained(clock_type::time_point deadline) const = 0;
+        // a worker on the same thread whose actions wait in lane
+        virtual std::shared_ptr<worker_interface> in_lane(schedule_priority::type lane) const = 0;
+    };
+
+    template<class TimedQueue>
+    struct new_worker : public registered_worker
     {
     private:
-        typedef new_worker this_type;
+        typedef new_worker<TimedQueue> this_type;
 
         typedef detail::action_queue queue;
 
         new_worker(const this_type&);
 
+        // immediate items are pushed without a lock into a fifo for each
+        // lane that only the worker thread pops. the TimedQueue under the
+        // lock holds timed items, either a schedulable_queue heap or a
+        // timer_wheel.
+        // producers only touch the lock and the condition variable when the
+        // worker thread is parked or when the item is timed.
         struct new_worker_state : public std::enable_shared_from_this<new_worker_state>
         {
-            typedef detail::schedulable_queue<
-                typename clock_type::time_point> queue_item_time;
+            typedef TimedQueue queue_item_time;
+
+            typedef typename queue_item_time::item_type item_type;
 
-            typedef queue_item_time::item_type item_type;
+            typedef detail::mpsc_queue<schedulable> queue_item_now;
+
+            typedef clock_type::duration::rep ticks_type;
 
             virtual ~new_worker_state()
             {
@@ -45,45 +211,226 @@ private:
                 }
                 else {
                     lifetime.unsubscribe();
-                    worker.detach();
+                    if (worker.joinable()) {
+                        worker.detach();
+                    }
                 }
             }
 
-            explicit new_worker_state(composite_subscription cs)
+            template<class... QueueArgN>
+            explicit new_worker_state(composite_subscription cs, idle_strategy is, QueueArgN&&... qan)
                 : lifetime(cs)
+                , idle(is)
+                , queue(std::forward<QueueArgN>(qan)...)
+                , compact_at(min_compact)
+                , drained(false)
+                , parked(false)
+                , next_due(std::numeric_limits<ticks_type>::max())
+                , closing(false)
+                , last_lane(schedule_priority::normal)
+                , streak(0)
             {
             }
 
+            // the lanes are served from high to bulk. after lane_weight
+            // actions in a row from one lane the lanes below it get a turn,
+            // so that a busy lane does not starve the others.
+            enum { lane_weight = 8 };
+
+            // call on the worker thread
+            bool pop_immediate(schedulable& what) const {
+                int start = 0;
+                if (streak >= lane_weight) {
+                    start = (last_lane + 1) % schedule_priority::lanes;
+                    streak = 0;
+                }
+                for (int i = 0; i != schedule_priority::lanes; ++i) {
+                    int lane = (start + i) % schedule_priority::lanes;
+                    if (immediate[lane].pop(what)) {
+                        streak = lane == last_lane ? streak + 1 : 1;
+                        last_lane = lane;
+                        return true;
+                    }
+                }
+                return false;
+            }
+            bool immediate_empty() const {
+                for (auto& lane : immediate) {
+                    if (!lane.empty()) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            static ticks_type ticks(clock_type::time_point tp) {
+                return tp.time_since_epoch().count();
+            }
+
+            // cancelled timed items stay queued until they reach the top.
+            // sweep them out whenever the queue has doubled since the last
+            // sweep so that the queue only holds live work.
+            enum { min_compact = 64 };
+
+            // call with lock held
+            void push_timed(item_type item) const {
+                if (queue.size() >= compact_at) {
+                    queue.compact();
+                    compact_at = (std::max)(size_t(min_compact), queue.size() * 2);
+                }
+                queue.push(std::move(item));
+                update_next_due();
+            }
+
+            // call with lock held
+            void update_next_due() const {
+                next_due = queue.empty() ? std::numeric_limits<ticks_type>::max() : ticks(queue.top().when);
+            }
+
+            // only the worker thread allows tail recursion, just before it
+            // runs an action. a caller disallows it after each push. the
+            // fences order the push and the flag on both sides, so when the
+            // worker allows recursion and misses a push, it sees it in the
+            // second check, or the caller's store lands after its own.
+            void allow_recursion(bool allowed) const {
+                r.reset(allowed);
+                if (allowed) {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (!immediate_empty()) {
+                        r.reset(false);
+                    }
+                }
+            }
+            void disallow_recursion() const {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                r.reset(false);
+            }
+
+            void wake_parked() const {
+                if (parked) {
+                    std::unique_lock<std::mutex> guard(lock);
+                    wake.notify_one();
+                }
+            }
+
+            // call on the worker thread
+            void report(clock_type::time_point now) {
+                if (counters.report_due(now)) {
+                    trace_activity().worker_report(stats());
+                }
+            }
+
+            worker_stats stats() const {
+                std::unique_lock<std::mutex> guard(lock);
+                auto result = counters.read(queue.size());
+                result.thread = thread;
+                return result;
+            }
+
+            // the actions that are draining may still schedule their next step
+            bool refuses_work() const {
+                if (!closing) {
+                    return false;
+                }
+                std::unique_lock<std::mutex> guard(lock);
+                return thread != std::this_thread::get_id();
+            }
+
+            // call with the lock held. the timed items that were
+            // unsubscribed are compacted away first.
+            bool has_queued_work() const {
+                if (!immediate_empty()) {
+                    return true;
+                }
+                queue.compact();
+                return !queue.empty();
+            }
+
+            // call on the worker thread when it has nothing to run. true when
+            // it is closing and no work is left that is due by the deadline.
+            bool finish_drain() const {
+                if (!closing) {
+                    return false;
+                }
+                std::unique_lock<std::mutex> guard(lock);
+                if (!immediate_empty() || (!queue.empty() && queue.top().when <= close_by)) {
+                    return false;
+                }
+                drained = true;
+                drained_wake.notify_all();
+                return true;
+            }
+
+            // callers schedule from other threads while the worker thread
+            // runs, so the members are grouped by who writes them and each
+            // group starts a new cache line.
+
+            // set when the worker starts and then only read
             composite_subscription lifetime;
+            idle_strategy idle;
+            std::thread worker;
+            rxu::detail::cache_line_pad read_pad;
+
+            // callers push, the worker thread pops
+            mutable queue_item_now immediate[schedule_priority::lanes];
             mutable std::mutex lock;
             mutable std::condition_variable wake;
             mutable queue_item_time queue;
-            std::thread worker;
+            mutable size_t compact_at;
+            // set under the lock
+            mutable clock_type::time_point close_by;
+            mutable bool drained;
+            mutable std::condition_variable drained_wake;
+            // set under the lock by the worker thread
+            std::thread::id thread;
+            rxu::detail::cache_line_pad queue_pad;
+
+            // read by each schedule, written when the worker parks, wakes
+            // or closes
+            mutable std::atomic<bool> parked;
+            mutable std::atomic<ticks_type> next_due;
+            mutable std::atomic<bool> closing;
+            // allowed by the worker thread, disallowed by each schedule
             recursion r;
+            rxu::detail::cache_line_pad flags_pad;
+
+            // only used by the worker thread
+            mutable int last_lane;
+            mutable int streak;
+            detail::worker_counters counters;
         };
 
         std::shared_ptr<new_worker_state> state;
+        schedule_priority::type lane;
 
     public:
         virtual ~new_worker()
         {
         }
 
-        explicit new_worker(std::shared_ptr<new_worker_state> ws)
+        explicit new_worker(std::shared_ptr<new_worker_state> ws, schedule_priority::type l = schedule_priority::normal)
             : state(ws)
+            , lane(l)
         {
         }
 
-        new_worker(composite_subscription cs, thread_factory& tf)
-            : state(std::make_shared<new_worker_state>(cs))
+        // the thread comes from cache when there is one, otherwise from tf.
+        // a cached thread is not joined, it goes back to the cache when
+        // the worker has stopped.
+        template<class... QueueArgN>
+        new_worker(composite_subscription cs, thread_factory& tf, const std::shared_ptr<thread_cache>& cache, idle_strategy idle, QueueArgN&&... qan)
+            : state(std::make_shared<new_worker_state>(cs, idle, std::forward<QueueArgN>(qan)...))
+            , lane(schedule_priority::normal)
         {
             auto keepAlive = state;
 
             state->lifetime.add([keepAlive](){
+                std::unique_lock<std::mutex> guard(keepAlive->lock);
                 keepAlive->wake.notify_one();
+                keepAlive->drained_wake.notify_all();
             });
 
-            state->worker = tf([keepAlive](){
+            std::function<void()> loop = [keepAlive](){
 
                 // take ownership
                 queue::ensure(std::make_shared<new_worker>(keepAlive));
@@ -92,32 +439,107 @@ private:
                     queue::destroy();
                 });
 
-                for(;;) {
+                {
                     std::unique_lock<std::mutex> guard(keepAlive->lock);
-                    if (keepAlive->queue.empty()) {
-                        keepAlive->wake.wait(guard, [keepAlive](){
-                            return !keepAlive->lifetime.is_subscribed() || !keepAlive->queue.empty();
-                        });
-                    }
+                    keepAlive->thread = std::this_thread::get_id();
+                }
+                auto& counters = keepAlive->counters;
+                const auto& idle = keepAlive->idle;
+                // the passes without work since the last action ran
+                size_t idled = 0;
+
+                schedulable what;
+                for(;;) {
                     if (!keepAlive->lifetime.is_subscribed()) {
                         break;
                     }
-                    auto& peek = keepAlive->queue.top();
-                    if (!peek.what.is_subscribed()) {
+
+                    auto now = clock_type::now();
+                    keepAlive->report(now);
+
+                    // timed items that are due go first
+                    if (new_worker_state::ticks(now) >= keepAlive->next_due) {
+                        std::unique_lock<std::mutex> guard(keepAlive->lock);
+                        if (keepAlive->queue.empty()) {
+                            keepAlive->update_next_due();
+                            continue;
+                        }
+                        auto& peek = keepAlive->queue.top();
+                        if (!peek.what.is_subscribed()) {
+                            keepAlive->queue.pop();
+                            keepAlive->update_next_due();
+                            continue;
+                        }
+                        if (clock_type::now() < peek.when) {
+                            keepAlive->update_next_due();
+                            continue;
+                        }
+                        what = peek.what;
+                        auto due = peek.when;
                         keepAlive->queue.pop();
+                        keepAlive->update_next_due();
+                        keepAlive->allow_recursion(keepAlive->queue.empty() && keepAlive->immediate_empty());
+                        guard.unlock();
+                        auto started = clock_type::now();
+                        counters.started_timed(started - due);
+                        what(keepAlive->r.get_recurse());
+                        counters.ran(clock_type::now() - started);
+                        what = schedulable();
+                        idled = 0;
                         continue;
                     }
-                    if (clock_type::now() < peek.when) {
-                        keepAlive->wake.wait_until(guard, peek.when);
+
+                    if (keepAlive->pop_immediate(what)) {
+                        counters.dequeued();
+                        if (what.is_subscribed()) {
+                            keepAlive->allow_recursion(keepAlive->immediate_empty());
+                            what(keepAlive->r.get_recurse());
+                            counters.ran(clock_type::now() - now);
+                        }
+                        what = schedulable();
+                        idled = 0;
                         continue;
                     }
-                    auto what = peek.what;
-                    keepAlive->queue.pop();
-                    keepAlive->r.reset(keepAlive->queue.empty());
-                    guard.unlock();
-                    what(keepAlive->r.get_recurse());
+
+                    if (!keepAlive->immediate_empty()) {
+                        // a producer is part way through a push
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    if (keepAlive->finish_drain()) {
+                        // cancel the work that is due after the deadline
+                        keepAlive->lifetime.unsubscribe();
+                        break;
+                    }
+
+                    if (idled < idle.spins + idle.yields || !idle.parks) {
+                        if (idled >= idle.spins && idled < idle.spins + idle.yields) {
+                            std::this_thread::yield();
+                        }
+                        ++idled;
+                        counters.waited(clock_type::now() - now);
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> guard(keepAlive->lock);
+                    keepAlive->parked = true;
+                    if (keepAlive->immediate_empty() && keepAlive->lifetime.is_subscribed()) {
+                        if (keepAlive->queue.empty()) {
+                            keepAlive->wake.wait(guard);
+                        } else {
+                            keepAlive->wake.wait_until(guard, keepAlive->queue.top().when);
+                        }
+                    }
+                    keepAlive->parked = false;
+                    counters.waited(clock_type::now() - now);
                 }
-            });
+            };
+            if (!!cache) {
+                cache->run(std::move(loop));
+            } else {
+                state->worker = tf(std::move(loop));
+            }
         }
 
         virtual clock_type::time_point now() const {
@@ -125,30 +547,215 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            schedule(now(), scbl);
+            if (scbl.is_subscribed() && !state->refuses_work()) {
+                state->counters.queued();
+                state->immediate[lane].push(scbl);
+                state->disallow_recursion();
+                state->wake_parked();
+            }
+        }
+
+        virtual void schedule_batch(const std::vector<schedulable>& batch) const {
+            if (state->refuses_work()) {
+                return;
+            }
+            bool any = false;
+            for (auto& scbl : batch) {
+                if (scbl.is_subscribed()) {
+                    state->counters.queued();
+                    state->immediate[lane].push(scbl);
+                    any = true;
+                }
+            }
+            if (any) {
+                state->disallow_recursion();
+                state->wake_parked();
+            }
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
-            if (scbl.is_subscribed()) {
+            if (when <= now()) {
+                schedule(scbl);
+                return;
+            }
+            if (scbl.is_subscribed() && !state->refuses_work()) {
                 std::unique_lock<std::mutex> guard(state->lock);
-                state->queue.push(new_worker_state::item_type(when, scbl));
-                state->r.reset(false);
+                state->push_timed(typename new_worker_state::item_type(when, scbl));
+                state->disallow_recursion();
+                state->wake.notify_one();
             }
+        }
+
+        virtual rxu::maybe<worker_stats> stats() const {
+            return rxu::maybe<worker_stats>(state->stats());
+        }
+
+        virtual void close(clock_type::time_point deadline) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->close_by = deadline;
+            state->closing = true;
+            // a parked worker finds that it is done
             state->wake.notify_one();
         }
+
+        virtual bool wait_drained(clock_type::time_point deadline) const {
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                auto done = [this](){
+                    return state->drained || !state->lifetime.is_subscribed();
+                };
+                if (state->drained_wake.wait_until(guard, deadline, done)) {
+                    // a lifetime that ended before the deadline leaves
+                    // nothing for it to cancel unless work was still queued
+                    return state->drained || !state->has_queued_work();
+                }
+            }
+            state->lifetime.unsubscribe();
+            return false;
+        }
+
+        virtual std::shared_ptr<worker_interface> in_lane(schedule_priority::type l) const {
+            return std::make_shared<new_worker>(state, l);
+        }
     };
 
+    // the workers that have been created and are still referenced
+    struct worker_registry
+    {
+        worker_registry()
+            : closed(false)
+        {
+        }
+
+        std::mutex lock;
+        std::vector<std::weak_ptr<registered_worker>> workers;
+        bool closed;
+
+        // false once the scheduler has been shut down
+        bool add(const std::shared_ptr<registered_worker>& w) {
+            std::unique_lock<std::mutex> guard(lock);
+            if (closed) {
+                return false;
+            }
+            // drop the workers that are gone when the list has doubled
+            if (workers.size() >= 64 && (workers.size() & (workers.size() - 1)) == 0) {
+                workers.erase(std::remove_if(workers.begin(), workers.end(), [](const std::weak_ptr<registered_worker>& e){
+                    return e.expired();
+                }), workers.end());
+            }
+            workers.push_back(w);
+            return true;
+        }
+        // call with lock held
+        std::vector<std::shared_ptr<registered_worker>> live() {
+            std::vector<std::shared_ptr<registered_worker>> result;
+            workers.erase(std::remove_if(workers.begin(), workers.end(), [](const std::weak_ptr<registered_worker>& e){
+                return e.expired();
+            }), workers.end());
+            for (auto& w : workers) {
+                auto p = w.lock();
+                if (!!p) {
+                    result.push_back(std::move(p));
+                }
+            }
+            return result;
+        }
+        // refuse new workers and return the workers to drain
+        std::vector<std::shared_ptr<registered_worker>> close() {
+            std::unique_lock<std::mutex> guard(lock);
+            closed = true;
+            return live();
+        }
+        std::vector<worker_stats> stats() {
+            std::vector<std::shared_ptr<registered_worker>> workers;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                workers = live();
+            }
+            std::vector<worker_stats> result;
+            for (auto& w : workers) {
+                auto s = w->stats();
+                if (!s.empty()) {
+                    result.push_back(s.get());
+                }
+            }
+            return result;
+        }
+    };
+
+    typedef detail::schedulable_queue<clock_type::time_point> heap_queue;
+    typedef detail::timer_wheel<clock_type::time_point> wheel_queue;
+
     mutable thread_factory factory;
+    // zero selects the heap, otherwise the tick of a timer_wheel
+    clock_type::duration timer_resolution;
+    idle_strategy idle;
+    // when set, the workers run on its threads instead of threads from factory
+    std::shared_ptr<thread_cache> cache;
+    std::shared_ptr<worker_registry> registry;
+
+    std::shared_ptr<registered_worker> create_thread(composite_subscription& cs) const {
+        std::shared_ptr<registered_worker> w;
+        if (timer_resolution == clock_type::duration::zero()) {
+            w = std::make_shared<new_worker<heap_queue>>(cs, factory, cache, idle);
+        } else {
+            w = std::make_shared<new_worker<wheel_queue>>(cs, factory, cache, idle, timer_resolution);
+        }
+        if (!registry->add(w)) {
+            // the scheduler has been shut down, the worker runs nothing
+            cs.unsubscribe();
+        }
+        return w;
+    }
 
 public:
     new_thread()
         : factory([](std::function<void()> start){
             return std::thread(std::move(start));
         })
+        , timer_resolution(clock_type::duration::zero())
+        , idle(idle_strategy::park())
+        , registry(std::make_shared<worker_registry>())
     {
     }
     explicit new_thread(thread_factory tf)
         : factory(tf)
+        , timer_resolution(clock_type::duration::zero())
+        , idle(idle_strategy::park())
+        , registry(std::make_shared<worker_registry>())
+    {
+    }
+    /// timed actions are kept in a timer_wheel with ticks of timer_resolution.
+    /// actions due in the same tick run in the order they were scheduled.
+    new_thread(thread_factory tf, clock_type::duration timer_resolution)
+        : factory(tf)
+        , timer_resolution(timer_resolution)
+        , idle(idle_strategy::park())
+        , registry(std::make_shared<worker_registry>())
+    {
+    }
+    /// each worker waits for work as idle says.
+    new_thread(thread_factory tf, idle_strategy idle)
+        : factory(tf)
+        , timer_resolution(clock_type::duration::zero())
+        , idle(idle)
+        , registry(std::make_shared<worker_registry>())
+    {
+    }
+    new_thread(thread_factory tf, clock_type::duration timer_resolution, idle_strategy idle)
+        : factory(tf)
+        , timer_resolution(timer_resolution)
+        , idle(idle)
+        , registry(std::make_shared<worker_registry>())
+    {
+    }
+    /// each worker runs on a thread from cache, that goes back to cache
+    /// when the worker stops.
+    explicit new_thread(std::shared_ptr<thread_cache> cache, idle_strategy idle = idle_strategy::park())
+        : timer_resolution(clock_type::duration::zero())
+        , idle(idle)
+        , cache(std::move(cache))
+        , registry(std::make_shared<worker_registry>())
     {
     }
     virtual ~new_thread()
@@ -160,17 +767,82 @@ public:
     }
 
     virtual worker create_worker(composite_subscription cs) const {
-        return worker(cs, std::make_shared<new_worker>(cs, factory));
+        auto w = create_thread(cs);
+        return worker(cs, std::move(w));
+    }
+
+    /// a worker for each lane, indexed by schedule_priority, that all run on
+    /// one new thread. the actions of a higher lane run first.
+    std::vector<worker> create_lane_workers(composite_subscription cs) const {
+        auto w = create_thread(cs);
+        std::vector<worker> result;
+        for (int lane = 0; lane != schedule_priority::lanes; ++lane) {
+            if (lane == schedule_priority::normal) {
+                result.push_back(worker(cs, w));
+            } else {
+                result.push_back(worker(cs, w->in_lane(schedule_priority::type(lane))));
+            }
+        }
+        return result;
+    }
+
+    /// the stats of each worker that is still referenced
+    virtual std::vector<worker_stats> stats() const {
+        return registry->stats();
+    }
+
+    /// refuses new workers and the work that is scheduled from other threads,
+    /// runs the work that is queued and due by the deadline, including the
+    /// steps that it schedules, and then cancels the rest. true when every
+    /// worker drained or had stopped with nothing queued before the
+    /// deadline. the registry stays closed, so only shut down a new_thread
+    /// that this code made, the shared make_new_thread() refuses it.
+    virtual bool shutdown(clock_type::time_point deadline) const {
+        auto workers = registry->close();
+        for (auto& w : workers) {
+            w->close(deadline);
+        }
+        bool drained = true;
+        for (auto& w : workers) {
+            drained = w->wait_drained(deadline) && drained;
+        }
+        return drained;
     }
 };
 
+/// the new_thread that the process shares. it refuses shutdown and
+/// returns false, since no later worker in the process could run after it.
+/// to drain on shutdown, use a new_thread of your own, such as
+/// make_new_thread(tf) or make_scheduler<new_thread>().
 inline scheduler make_new_thread() {
-    static scheduler instance = make_scheduler<new_thread>();
+    static scheduler instance = detail::make_shared_scheduler<new_thread>();
     return instance;
 }
 inline scheduler make_new_thread(thread_factory tf) {
     return make_scheduler<new_thread>(tf);
 }
+inline scheduler make_new_thread(thread_factory tf, scheduler_base::clock_type::duration timer_resolution) {
+    return make_scheduler<new_thread>(tf, timer_resolution);
+}
+inline scheduler make_new_thread(thread_factory tf, idle_strategy idle) {
+    return make_scheduler<new_thread>(tf, idle);
+}
+inline scheduler make_new_thread(thread_factory tf, scheduler_base::clock_type::duration timer_resolution, idle_strategy idle) {
+    return make_scheduler<new_thread>(tf, timer_resolution, idle);
+}
+inline scheduler make_new_thread(std::shared_ptr<thread_cache> cache) {
+    return make_scheduler<new_thread>(std::move(cache));
+}
+inline scheduler make_new_thread(std::shared_ptr<thread_cache> cache, idle_strategy idle) {
+    return make_scheduler<new_thread>(std::move(cache), idle);
+}
+/// a new_thread that reuses the threads of the workers that have stopped.
+/// it is shared by the process and refuses shutdown like make_new_thread(),
+/// make_new_thread(make_thread_cache()) makes one of your own.
+inline scheduler make_cached_new_thread() {
+    static scheduler instance = detail::make_shared_scheduler<new_thread>(make_thread_cache());
+    return instance;
+}
 
 }
 
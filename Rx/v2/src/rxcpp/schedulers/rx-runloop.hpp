@@ -0,0 +1,258 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_RUN_LOOP_HPP)
+#define RXCPP_RX_SCHEDULER_RUN_LOOP_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+struct run_loop_state
+{
+    typedef scheduler_base::clock_type clock_type;
+    typedef time_schedulable<clock_type::time_point> item_type;
+
+    run_loop_state()
+        : executor(nullptr)
+    {
+    }
+
+    composite_subscription lifetime;
+    // the workers of the loop report this as their executor, so that they
+    // are known to run on the same thread
+    const worker_interface* executor;
+    // any thread pushes the immediate items without a lock, only the
+    // thread that dispatches pops them
+    mutable mpsc_queue<schedulable> immediate;
+    mutable std::mutex lock;
+    mutable schedulable_queue<clock_type::time_point> timed;
+    std::function<void()> notify_on_enqueue;
+
+    void notify() const {
+        if (notify_on_enqueue) {
+            notify_on_enqueue();
+        }
+    }
+};
+
+}
+
+/// the actions scheduled on the workers of a run_loop wait until the thread
+/// that owns the loop calls dispatch(), for instance once for each frame of
+/// the event loop of a host. set_notify_on_enqueue() sets a function that is
+/// called by each schedule, it can wake the host to dispatch.
+struct run_loop_scheduler : public scheduler_interface
+{
+private:
+    typedef run_loop_scheduler this_type;
+    run_loop_scheduler(const this_type&);
+
+    struct run_loop_worker : public worker_interface
+    {
+    private:
+        typedef run_loop_worker this_type;
+        run_loop_worker(const this_type&);
+
+        typedef detail::run_loop_state::item_type item_type;
+
+        composite_subscription lifetime;
+        std::weak_ptr<const detail::run_loop_state> state;
+        const worker_interface* runs_on;
+
+    public:
+        virtual ~run_loop_worker()
+        {
+        }
+        run_loop_worker(composite_subscription cs, std::weak_ptr<const detail::run_loop_state> st, const worker_interface* e)
+            : lifetime(std::move(cs))
+            , state(std::move(st))
+            , runs_on(!!e ? e : this)
+        {
+        }
+
+        virtual clock_type::time_point now() const {
+            return clock_type::now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            auto st = state.lock();
+            if (!st || !scbl.is_subscribed()) {
+                return;
+            }
+            st->immediate.push(scbl);
+            st->notify();
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            auto st = state.lock();
+            if (!st || !scbl.is_subscribed()) {
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> guard(st->lock);
+                st->timed.push(item_type(when, scbl));
+            }
+            st->notify();
+        }
+
+        virtual const worker_interface* executor() const {
+            return runs_on;
+        }
+    };
+
+    std::weak_ptr<const detail::run_loop_state> state;
+
+public:
+    explicit run_loop_scheduler(std::weak_ptr<const detail::run_loop_state> st)
+        : state(std::move(st))
+    {
+    }
+    virtual ~run_loop_scheduler()
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        auto st = state.lock();
+        if (!st) {
+            // the loop is gone
+            cs.unsubscribe();
+            return worker(cs, std::make_shared<run_loop_worker>(cs, state, nullptr));
+        }
+        auto lifetime = st->lifetime;
+        auto token = lifetime.add(cs);
+        cs.add([lifetime, token](){lifetime.remove(token);});
+        return worker(cs, std::make_shared<run_loop_worker>(cs, state, st->executor));
+    }
+
+    /// the worker that the loop reports as the executor of its workers
+    static std::shared_ptr<worker_interface> make_executor(const std::shared_ptr<const detail::run_loop_state>& st) {
+        return std::make_shared<run_loop_worker>(st->lifetime, st, nullptr);
+    }
+};
+
+class run_loop
+{
+private:
+    typedef run_loop this_type;
+    // don't allow this instance to copy/move since it owns the state
+    run_loop(const this_type&);
+    run_loop(this_type&&);
+
+    typedef scheduler_base::clock_type clock_type;
+
+    std::shared_ptr<detail::run_loop_state> state;
+    std::shared_ptr<worker_interface> executor;
+    scheduler sc;
+
+public:
+    run_loop()
+        : state(std::make_shared<detail::run_loop_state>())
+        , executor(run_loop_scheduler::make_executor(state))
+        , sc(make_scheduler<run_loop_scheduler>(std::weak_ptr<const detail::run_loop_state>(state)))
+    {
+        state->executor = executor.get();
+    }
+    ~run_loop()
+    {
+        state->lifetime.unsubscribe();
+    }
+
+    clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+
+    /// call on the thread that dispatches. true when no immediate action is
+    /// waiting and no timed action is due.
+    bool empty() const {
+        if (!state->immediate.empty()) {
+            return false;
+        }
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->timed.empty() || state->timed.top().when > clock_type::now();
+    }
+
+    /// when the first timed action is due, clock_type::time_point::max() when
+    /// there is none. a host can wait until then when the loop is empty.
+    clock_type::time_point next_due() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->timed.empty() ? (clock_type::time_point::max)() : state->timed.top().when;
+    }
+
+    /// call on the thread that owns the loop. runs the immediate actions and
+    /// then the timed actions that are due, until none is left or budget has
+    /// passed, and returns how many ran. an action always runs to its end, so
+    /// dispatch can return after the budget by the time of one action. the
+    /// actions that are scheduled while it runs are run as well when there
+    /// is budget left.
+    size_t dispatch(clock_type::duration budget = (clock_type::duration::max)()) const {
+        auto start = clock_type::now();
+        auto deadline = budget >= (clock_type::time_point::max)() - start ? (clock_type::time_point::max)() : start + budget;
+
+        size_t ran = 0;
+        auto now = start;
+        while (state->lifetime.is_subscribed()) {
+            schedulable what;
+            if (!state->immediate.pop(what)) {
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (!state->timed.empty() && state->timed.top().when <= now) {
+                    what = state->timed.top().what;
+                    state->timed.pop();
+                } else if (state->immediate.empty()) {
+                    break;
+                } else {
+                    // a producer has not linked its item yet
+                    guard.unlock();
+                    std::this_thread::yield();
+                    now = clock_type::now();
+                    continue;
+                }
+            }
+            if (what.is_subscribed()) {
+                // a recursion request goes back into the queue, so that the
+                // budget is checked between each step
+                recursion r(false);
+                what(r.get_recurse());
+                ++ran;
+            }
+            now = clock_type::now();
+            if (now >= deadline) {
+                break;
+            }
+        }
+        return ran;
+    }
+
+    scheduler get_scheduler() const {
+        return sc;
+    }
+
+    /// f is called by each schedule, on the thread that schedules. set it
+    /// before the loop is used.
+    void set_notify_on_enqueue(std::function<void()> f) {
+        state->notify_on_enqueue = std::move(f);
+    }
+};
+
+inline scheduler make_run_loop(const run_loop& r) {
+    return r.get_scheduler();
+}
+
+}
+
+}
+
+#endif
@@ -120,6 +120,9 @@ public:
 
         template<class T>
         subscriber<T, rxt::testable_observer<T>> make_subscriber() const;
+
+        template<class T>
+        subscriber<T, rxt::testable_observer<T>> make_bulk_subscriber(size_t capacity) const;
     };
 
 public:
@@ -150,6 +153,12 @@ public:
 
     template<class T>
     rxt::testable_observable<T> make_cold_observable(std::vector<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> messages) const;
+
+    template<class T>
+    rxt::testable_observable<T> make_bulk_hot_observable(std::vector<long> ticks, std::vector<T> values, rxu::maybe<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> last) const;
+
+    template<class T>
+    rxt::testable_observable<T> make_bulk_cold_observable(std::vector<long> ticks, std::vector<T> values, rxu::maybe<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> last) const;
 };
 
 template<class T>
@@ -336,6 +345,290 @@ rxt::testable_observable<T> test_type::make_hot_observable(std::vector<rxn::reco
         std::make_shared<hot_observable<T>>(state, create_worker(composite_subscription()), std::move(messages)));
 }
 
+// the notifications of a bulk observable or subscriber. the values and their
+// ticks are held in two arrays, in place of one recorded notification for
+// each. the ticks are in ascending order.
+template<class T>
+struct bulk_messages
+{
+    typedef rxn::recorded<typename rxn::notification<T>::type> recorded_type;
+
+    bulk_messages()
+    {
+    }
+    bulk_messages(std::vector<long> t, std::vector<T> v, rxu::maybe<recorded_type> l)
+        : ticks(std::move(t))
+        , values(std::move(v))
+        , last(std::move(l))
+    {
+        if (ticks.size() != values.size()) abort();
+    }
+
+    std::vector<long> ticks;
+    std::vector<T> values;
+    // the on_completed or on_error, if any
+    rxu::maybe<recorded_type> last;
+
+    // one past the last value that has the tick of the value at first
+    size_t batch_end(size_t first) const {
+        return std::upper_bound(ticks.begin() + first, ticks.end(), ticks[first]) - ticks.begin();
+    }
+
+    std::vector<recorded_type> recorded() const {
+        std::vector<recorded_type> result;
+        result.reserve(ticks.size() + 1);
+        for (size_t i = 0; i != ticks.size(); ++i) {
+            result.push_back(recorded_type(ticks[i], rxn::notification<T>::on_next(values[i])));
+        }
+        if (!last.empty()) {
+            result.push_back(last.get());
+        }
+        return result;
+    }
+};
+
+// schedules one action for each tick, however many values have that tick.
+// Deliver is called with the values of the tick and then with the last
+// notification, and returns false to stop.
+template<class T>
+struct bulk_emitter
+{
+    typedef bulk_messages<T> messages_type;
+
+    template<class Deliver>
+    static void schedule(const std::shared_ptr<test_type::test_type_state>& sc, const worker& controller, const std::shared_ptr<const messages_type>& mv, size_t first, long offset, Deliver deliver) {
+        long when;
+        if (first < mv->ticks.size()) {
+            when = mv->ticks[first];
+        } else if (!mv->last.empty()) {
+            when = mv->last->time();
+        } else {
+            return;
+        }
+        sc->schedule_absolute(offset + when, make_schedulable(
+            controller,
+            [sc, controller, mv, first, offset, when, deliver](const schedulable&) {
+                auto next = first;
+                if (next < mv->ticks.size()) {
+                    next = mv->batch_end(first);
+                    if (!deliver(mv->values.data() + first, next - first)) {
+                        return;
+                    }
+                }
+                if (next == mv->ticks.size() && !mv->last.empty() && mv->last->time() <= when) {
+                    // the end in the same action, so that it keeps its tick
+                    deliver(mv->last->value());
+                    return;
+                }
+                schedule(sc, controller, mv, next, offset, deliver);
+            }));
+    }
+};
+
+template<class T>
+class bulk_cold_observable
+    : public rxt::detail::test_subject_base<T>
+{
+    typedef bulk_cold_observable<T> this_type;
+    typedef bulk_messages<T> messages_type;
+    typedef typename messages_type::recorded_type recorded_type;
+    std::shared_ptr<test_type::test_type_state> sc;
+    // shared by all the subscriptions, each only has a cursor into it
+    std::shared_ptr<const messages_type> mv;
+    mutable std::vector<rxn::subscription> sv;
+    mutable worker controller;
+
+    struct deliver_type
+    {
+        subscriber<T> o;
+        bool operator()(const T* first, size_t count) const {
+            if (o.is_subscribed()) {
+                o.on_next_range(first, count);
+            }
+            return o.is_subscribed();
+        }
+        bool operator()(const typename rxn::notification<T>::type& n) const {
+            if (o.is_subscribed()) {
+                n->accept(o);
+            }
+            return false;
+        }
+    };
+
+public:
+
+    bulk_cold_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, messages_type mv)
+        : sc(sc)
+        , mv(std::make_shared<const messages_type>(std::move(mv)))
+        , controller(w)
+    {
+    }
+
+    virtual void on_subscribe(subscriber<T> o) const {
+        sv.push_back(rxn::subscription(sc->clock()));
+        auto index = sv.size() - 1;
+
+        deliver_type deliver = {o};
+        bulk_emitter<T>::schedule(sc, controller, mv, 0, sc->clock(), deliver);
+
+        auto sharedThis = std::static_pointer_cast<const this_type>(this->shared_from_this());
+        o.add([sharedThis, index]() {
+            sharedThis->sv[index] = rxn::subscription(sharedThis->sv[index].subscribe(), sharedThis->sc->clock());
+        });
+    }
+
+    virtual std::vector<rxn::subscription> subscriptions() const {
+        return sv;
+    }
+
+    virtual std::vector<recorded_type> messages() const {
+        return mv->recorded();
+    }
+};
+
+template<class T>
+class bulk_hot_observable
+    : public rxt::detail::test_subject_base<T>
+{
+    typedef bulk_hot_observable<T> this_type;
+    typedef bulk_messages<T> messages_type;
+    typedef typename messages_type::recorded_type recorded_type;
+    typedef subscriber<T> observer_type;
+    typedef std::vector<observer_type> observers_type;
+    std::shared_ptr<test_type::test_type_state> sc;
+    std::shared_ptr<const messages_type> mv;
+    mutable std::vector<rxn::subscription> sv;
+    std::shared_ptr<observers_type> observers;
+    mutable worker controller;
+
+    struct deliver_type
+    {
+        std::shared_ptr<observers_type> observers;
+        bool operator()(const T* first, size_t count) const {
+            auto local = *observers;
+            for (auto& o : local) {
+                if (o.is_subscribed()) {
+                    o.on_next_range(first, count);
+                }
+            }
+            return true;
+        }
+        bool operator()(const typename rxn::notification<T>::type& n) const {
+            auto local = *observers;
+            for (auto& o : local) {
+                if (o.is_subscribed()) {
+                    n->accept(o);
+                }
+            }
+            return false;
+        }
+    };
+
+public:
+
+    bulk_hot_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, messages_type m)
+        : sc(sc)
+        , mv(std::make_shared<const messages_type>(std::move(m)))
+        , observers(std::make_shared<observers_type>())
+        , controller(w)
+    {
+        deliver_type deliver = {observers};
+        bulk_emitter<T>::schedule(sc, controller, mv, 0, 0, deliver);
+    }
+
+    virtual void on_subscribe(observer_type o) const {
+        observers->push_back(o);
+        sv.push_back(rxn::subscription(sc->clock()));
+        auto index = sv.size() - 1;
+
+        auto sharedThis = std::static_pointer_cast<const this_type>(this->shared_from_this());
+        o.add([sharedThis, index]() {
+            sharedThis->sv[index] = rxn::subscription(sharedThis->sv[index].subscribe(), sharedThis->sc->clock());
+        });
+    }
+
+    virtual std::vector<rxn::subscription> subscriptions() const {
+        return sv;
+    }
+
+    virtual std::vector<recorded_type> messages() const {
+        return mv->recorded();
+    }
+};
+
+template<class T>
+rxt::testable_observable<T> test_type::make_bulk_hot_observable(std::vector<long> ticks, std::vector<T> values, rxu::maybe<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> last) const
+{
+    return rxt::testable_observable<T>(
+        std::make_shared<bulk_hot_observable<T>>(state, create_worker(composite_subscription()), bulk_messages<T>(std::move(ticks), std::move(values), std::move(last))));
+}
+
+template<class T>
+rxt::testable_observable<T> test_type::make_bulk_cold_observable(std::vector<long> ticks, std::vector<T> values, rxu::maybe<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> last) const
+{
+    return rxt::testable_observable<T>(
+        std::make_shared<bulk_cold_observable<T>>(state, create_worker(composite_subscription()), bulk_messages<T>(std::move(ticks), std::move(values), std::move(last))));
+}
+
+// records into arrays that are allocated once for the capacity, so that a
+// benchmark measures the operators rather than the recording
+template<class T>
+class bulk_mock_observer
+    : public rxt::detail::test_subject_base<T>
+{
+    typedef typename rxn::notification<T> notification_type;
+    typedef rxn::recorded<typename notification_type::type> recorded_type;
+
+public:
+    bulk_mock_observer(std::shared_ptr<test_type::test_type_state> sc, size_t capacity)
+        : sc(sc)
+    {
+        m.ticks.reserve(capacity);
+        m.values.reserve(capacity);
+    }
+
+    std::shared_ptr<test_type::test_type_state> sc;
+    bulk_messages<T> m;
+
+    virtual void on_subscribe(subscriber<T>) const {
+        abort();
+    }
+    virtual std::vector<rxn::subscription> subscriptions() const {
+        abort();
+    }
+
+    virtual std::vector<recorded_type> messages() const {
+        return m.recorded();
+    }
+};
+
+template<class T>
+subscriber<T, rxt::testable_observer<T>> test_type::test_type_worker::make_bulk_subscriber(size_t capacity) const
+{
+    typedef typename rxn::notification<T> notification_type;
+    typedef rxn::recorded<typename notification_type::type> recorded_type;
+
+    auto ts = std::make_shared<bulk_mock_observer<T>>(state, capacity);
+
+    return rxcpp::make_subscriber<T>(rxt::testable_observer<T>(ts, make_observer_dynamic<T>(
+          // on_next
+          [ts](T value)
+          {
+              ts->m.ticks.push_back(ts->sc->clock());
+              ts->m.values.push_back(std::move(value));
+          },
+          // on_error
+          [ts](std::exception_ptr e)
+          {
+              ts->m.last.reset(recorded_type(ts->sc->clock(), notification_type::on_error(e)));
+          },
+          // on_completed
+          [ts]()
+          {
+              ts->m.last.reset(recorded_type(ts->sc->clock(), notification_type::on_completed()));
+          })));
+}
+
 template<class F>
 struct is_create_source_function
 {
@@ -435,8 +728,9 @@ public:
             tester->schedule_relative(when, make_schedulable(*this, std::forward<Arg0>(a0), std::forward<ArgN>(an)...));
         }
 
+    private:
         template<class T, class F>
-        auto start(F createSource, long created, long subscribed, long unsubscribed) const
+        auto start_subscriber(F createSource, subscriber<T, rxt::testable_observer<T>> o, long created, long subscribed, long unsubscribed) const
             -> subscriber<T, rxt::testable_observer<T>>
         {
             struct state_type
@@ -453,7 +747,7 @@ public:
                 {
                 }
             };
-            auto state = std::make_shared<state_type>(this->make_subscriber<T>());
+            auto state = std::make_shared<state_type>(std::move(o));
 
             schedule_absolute(created, [createSource, state](const schedulable&) {
                 state->source.reset(new typename state_type::source_type(createSource()));
@@ -470,6 +764,14 @@ public:
             return state->o;
         }
 
+    public:
+        template<class T, class F>
+        auto start(F createSource, long created, long subscribed, long unsubscribed) const
+            -> subscriber<T, rxt::testable_observer<T>>
+        {
+            return start_subscriber<T>(std::move(createSource), this->make_subscriber<T>(), created, subscribed, unsubscribed);
+        }
+
         template<class T, class F>
         auto start(F&& createSource, long unsubscribed) const
             -> subscriber<T, rxt::testable_observer<T>>
@@ -513,14 +815,52 @@ public:
             return start<rxu::value_type_t<start_traits<F>>>(std::move(createSource), created_time, subscribed_time, unsubscribed_time);
         }
 
+        /// like start, but the output is recorded into arrays allocated once
+        /// for capacity values, for benchmarks over many values
+        template<class F>
+        auto start_bulk(F createSource, size_t capacity, long created, long subscribed, long unsubscribed) const
+            -> typename std::enable_if<detail::is_create_source_function<F>::value, start_traits<F>>::type::subscriber_type
+        {
+            typedef rxu::value_type_t<start_traits<F>> value_type;
+            return start_subscriber<value_type>(std::move(createSource), this->make_bulk_subscriber<value_type>(capacity), created, subscribed, unsubscribed);
+        }
+
+        template<class F>
+        auto start_bulk(F createSource, size_t capacity) const
+            -> typename std::enable_if<detail::is_create_source_function<F>::value, start_traits<F>>::type::subscriber_type
+        {
+            return start_bulk(std::move(createSource), capacity, created_time, subscribed_time, unsubscribed_time);
+        }
+
         void start() const {
             tester->start();
         }
 
+        void stop() const {
+            tester->stop();
+        }
+
+        void advance_to(long time) const {
+            tester->advance_to(time);
+        }
+
+        void advance_by(long time) const {
+            tester->advance_by(time);
+        }
+
+        void sleep(long time) const {
+            tester->sleep(time);
+        }
+
         template<class T>
         subscriber<T, rxt::testable_observer<T>> make_subscriber() const {
             return tester->make_subscriber<T>();
         }
+
+        template<class T>
+        subscriber<T, rxt::testable_observer<T>> make_bulk_subscriber(size_t capacity) const {
+            return tester->make_bulk_subscriber<T>(capacity);
+        }
     };
 
     clock_type::time_point now() const {
@@ -567,6 +907,32 @@ public:
         -> decltype(tester->make_cold_observable(std::vector<T>())) {
         return      tester->make_cold_observable(std::vector<T>(il));
     }
+
+    /// a hot observable that holds the values and their ticks in arrays, and
+    /// schedules one action for each tick rather than for each value. the
+    /// ticks are in ascending order, last is an on_completed or on_error.
+    template<class T>
+    rxt::testable_observable<T> make_bulk_hot_observable(std::vector<long> ticks, std::vector<T> values) const {
+        return tester->make_bulk_hot_observable(std::move(ticks), std::move(values), rxu::maybe<typename messages<T>::recorded_type>());
+    }
+
+    template<class T>
+    rxt::testable_observable<T> make_bulk_hot_observable(std::vector<long> ticks, std::vector<T> values, typename messages<T>::recorded_type last) const {
+        return tester->make_bulk_hot_observable(std::move(ticks), std::move(values), rxu::maybe<typename messages<T>::recorded_type>(std::move(last)));
+    }
+
+    /// a cold observable that holds the values and their ticks in arrays,
+    /// shared by the subscriptions, and schedules one action for each tick
+    /// rather than for each value.
+    template<class T>
+    rxt::testable_observable<T> make_bulk_cold_observable(std::vector<long> ticks, std::vector<T> values) const {
+        return tester->make_bulk_cold_observable(std::move(ticks), std::move(values), rxu::maybe<typename messages<T>::recorded_type>());
+    }
+
+    template<class T>
+    rxt::testable_observable<T> make_bulk_cold_observable(std::vector<long> ticks, std::vector<T> values, typename messages<T>::recorded_type last) const {
+        return tester->make_bulk_cold_observable(std::move(ticks), std::move(values), rxu::maybe<typename messages<T>::recorded_type>(std::move(last)));
+    }
 };
 
 
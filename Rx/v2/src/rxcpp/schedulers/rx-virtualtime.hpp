@@ -45,6 +45,9 @@ protected:
     mutable absolute clock_now;
 
     typedef time_schedulable<long> item_type;
+    // an item and its place in the order of the items due at the same time
+    typedef std::pair<item_type, int64_t> due_type;
+    typedef std::vector<due_type> batch_type;
 
     virtual absolute add(absolute, relative) const =0;
 
@@ -55,6 +58,26 @@ protected:
     virtual void pop() const =0;
     virtual bool empty() const =0;
 
+    /// move the items at the earliest time into due, unless that time is
+    /// after limit. returns false when no items were moved.
+    virtual bool take_due(absolute limit, batch_type& due) const {
+        if (empty() || top().when > limit) {
+            return false;
+        }
+        auto when = top().when;
+        while (!empty() && top().when == when) {
+            due.push_back(due_type(top(), 0));
+            pop();
+        }
+        return true;
+    }
+    /// put back the items of due from first on, that did not run
+    virtual void restore(batch_type& due, size_t first) const {
+        for (auto i = first; i != due.size(); ++i) {
+            schedule_absolute(due[i].first.when, due[i].first.what);
+        }
+    }
+
 public:
 
     virtual void schedule_absolute(absolute, const schedulable&) const =0;
@@ -71,21 +94,7 @@ public:
     {
         if (!isenabled) {
             isenabled = true;
-            rxsc::recursion r;
-            r.reset(false);
-            while (!empty() && isenabled) {
-                auto next = top();
-                pop();
-                if (next.what.is_subscribed()) {
-                    if (next.when > clock_now) {
-                        clock_now = next.when;
-                    }
-                    next.what(r.get_recurse());
-                }
-                else {
-                    isenabled = false;
-                }
-            }
+            run_due((std::numeric_limits<absolute>::max)());
         }
     }
 
@@ -106,20 +115,8 @@ public:
 
         if (!isenabled) {
             isenabled = true;
-            rxsc::recursion r;
-            while (!empty() && isenabled) {
-                auto next = top();
-                pop();
-                if (next.what.is_subscribed() && next.when <= time) {
-                    if (next.when > clock_now) {
-                        clock_now = next.when;
-                    }
-                    next.what(r.get_recurse());
-                }
-                else {
-                    isenabled = false;
-                }
-            }
+            run_due(time);
+            isenabled = false;
 
             clock_now = time;
         }
@@ -159,6 +156,32 @@ public:
         clock_now = dt;
     }
 
+private:
+    // runs the items that are due by limit, in order, until stopped. the
+    // items at one time are taken from the queue together and run from due,
+    // which keeps its space from one time to the next. an item that is
+    // scheduled for an earlier time while a batch runs, runs after the batch.
+    void run_due(absolute limit) const
+    {
+        rxsc::recursion r;
+        r.reset(false);
+        while (isenabled && take_due(limit, due)) {
+            for (size_t i = 0; i != due.size(); ++i) {
+                if (!isenabled) {
+                    restore(due, i);
+                    break;
+                }
+                auto& next = due[i].first;
+                if (next.when > clock_now) {
+                    clock_now = next.when;
+                }
+                next.what(r.get_recurse());
+            }
+            due.clear();
+        }
+    }
+
+    mutable batch_type due;
 };
 
 }
@@ -199,24 +222,30 @@ protected:
         return queue.empty();
     }
 
+    virtual bool take_due(typename base::absolute limit, typename base::batch_type& due) const {
+        if (queue.empty() || queue.top().when > limit) {
+            return false;
+        }
+        auto when = queue.top().when;
+        while (!queue.empty() && queue.top().when == when) {
+            due.push_back(queue.take());
+        }
+        return true;
+    }
+    virtual void restore(typename base::batch_type& due, size_t first) const {
+        for (auto i = first; i != due.size(); ++i) {
+            queue.restore(std::move(due[i]));
+        }
+    }
+
     using base::schedule_absolute;
     using base::schedule_relative;
 
+    // the queue holds a itself. an item that is unsubscribed before it is
+    // due does nothing when it is reached.
     virtual void schedule_absolute(typename base::absolute when, const schedulable& a) const
     {
-        // use a separate subscription here so that a's subscription is not affected
-        auto run = make_schedulable(
-            a.get_worker(),
-            composite_subscription(),
-            [a](const schedulable& scbl) {
-                rxsc::recursion r;
-                r.reset(false);
-                if (scbl.is_subscribed()) {
-                    scbl.unsubscribe(); // unsubscribe() run, not a;
-                    a(r.get_recurse());
-                }
-            });
-        queue.push(item_type(when, run));
+        queue.push(item_type(when, a));
     }
 };
 
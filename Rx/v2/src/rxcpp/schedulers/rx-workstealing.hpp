@@ -0,0 +1,477 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_WORK_STEALING_HPP)
+#define RXCPP_RX_SCHEDULER_WORK_STEALING_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+// A fixed set of threads share the work of many workers.
+//
+// Each worker is a strand with its own time ordered queue. A strand with
+// due actions is posted, as a unit, to the lane of one pool thread. A pool
+// thread runs strands from the front of its own lane and, when that is
+// empty, steals from the back of the lanes of the other threads. Only one
+// thread runs a given strand at a time, so the actions scheduled on one
+// worker are still called in order and never concurrently.
+struct work_stealing_pool : public scheduler_interface
+{
+private:
+    typedef work_stealing_pool this_type;
+    work_stealing_pool(const this_type&);
+
+    struct pool_state;
+
+    struct strand_state
+    {
+        typedef detail::schedulable_queue<
+            typename clock_type::time_point> queue_item_time;
+
+        typedef queue_item_time::item_type item_type;
+
+        strand_state(composite_subscription cs, std::shared_ptr<pool_state> p)
+            : lifetime(std::move(cs))
+            , pool(std::move(p))
+            , queued(false)
+            , compact_at(min_compact)
+        {
+        }
+
+        // sweep cancelled items out whenever the queue has doubled since
+        // the last sweep so that the queue only holds live work.
+        enum { min_compact = 64 };
+
+        // call with lock held
+        void push(item_type item) const {
+            if (queue.size() >= compact_at) {
+                queue.compact();
+                compact_at = (std::max)(size_t(min_compact), queue.size() * 2);
+            }
+            queue.push(std::move(item));
+        }
+
+        composite_subscription lifetime;
+        std::shared_ptr<pool_state> pool;
+        mutable std::mutex lock;
+        mutable queue_item_time queue;
+        // true while the strand is in a lane or being run by a pool thread
+        mutable bool queued;
+        mutable size_t compact_at;
+        recursion r;
+    };
+    typedef std::shared_ptr<strand_state> strand_ptr;
+
+    struct lane
+    {
+        std::mutex lock;
+        std::deque<strand_ptr> strands;
+        // set under the lock by the pool thread
+        std::thread::id thread;
+        detail::worker_counters counters;
+    };
+
+    struct timer_item
+    {
+        timer_item(clock_type::time_point when, std::weak_ptr<strand_state> what)
+            : when(when)
+            , what(std::move(what))
+        {
+        }
+        clock_type::time_point when;
+        std::weak_ptr<strand_state> what;
+    };
+    struct timer_later
+    {
+        bool operator()(const timer_item& lhs, const timer_item& rhs) const {
+            return lhs.when > rhs.when;
+        }
+    };
+    typedef std::priority_queue<timer_item, std::vector<timer_item>, timer_later> timer_queue;
+
+    struct pool_state
+    {
+        explicit pool_state(size_t count)
+            : next(0)
+            , pending(0)
+            , idle(0)
+            , stopped(false)
+        {
+            while (count--) {
+                lanes.emplace_back(new lane());
+            }
+        }
+
+        std::vector<std::unique_ptr<lane>> lanes;
+        std::atomic<size_t> next;
+        std::atomic<size_t> pending;
+        std::atomic<size_t> idle;
+        std::atomic<bool> stopped;
+
+        std::mutex park_lock;
+        std::condition_variable park;
+
+        std::mutex timer_lock;
+        std::condition_variable timer_wake;
+        timer_queue timers;
+
+        // identifies the pool and lane owned by the calling thread
+        static const pool_state*& current_pool() {
+            static RXCPP_THREAD_LOCAL const pool_state* pool;
+            return pool;
+        }
+        static size_t& current_lane() {
+            static RXCPP_THREAD_LOCAL size_t index;
+            return index;
+        }
+
+        void post(strand_ptr s) {
+            if (stopped) {
+                return;
+            }
+            size_t index = current_pool() == this ? current_lane() : next++ % lanes.size();
+            {
+                std::unique_lock<std::mutex> guard(lanes[index]->lock);
+                lanes[index]->strands.push_back(std::move(s));
+            }
+            lanes[index]->counters.queued();
+            ++pending;
+            if (idle > 0) {
+                std::unique_lock<std::mutex> guard(park_lock);
+                park.notify_one();
+            }
+        }
+
+        strand_ptr take(size_t index) {
+            strand_ptr result;
+            {
+                auto& own = *lanes[index];
+                std::unique_lock<std::mutex> guard(own.lock);
+                if (!own.strands.empty()) {
+                    result = std::move(own.strands.front());
+                    own.strands.pop_front();
+                }
+            }
+            for (size_t offset = 1; !result && offset < lanes.size(); ++offset) {
+                auto& victim = *lanes[(index + offset) % lanes.size()];
+                std::unique_lock<std::mutex> guard(victim.lock);
+                if (!victim.strands.empty()) {
+                    result = std::move(victim.strands.back());
+                    victim.strands.pop_back();
+                    // the strand leaves the count of the victim
+                    victim.counters.pushed.fetch_sub(1, std::memory_order_relaxed);
+                    lanes[index]->counters.stole();
+                    lanes[index]->counters.queued();
+                }
+            }
+            if (!!result) {
+                lanes[index]->counters.dequeued();
+                --pending;
+            }
+            return result;
+        }
+
+        bool wait_for_work(size_t index) {
+            auto parked = clock_type::now();
+            std::unique_lock<std::mutex> guard(park_lock);
+            ++idle;
+            park.wait(guard, [this](){
+                return stopped || pending > 0;
+            });
+            --idle;
+            guard.unlock();
+            lanes[index]->counters.waited(clock_type::now() - parked);
+            return !stopped;
+        }
+
+        std::vector<worker_stats> stats() const {
+            std::vector<worker_stats> result;
+            for (auto& l : lanes) {
+                std::unique_lock<std::mutex> guard(l->lock);
+                auto s = l->counters.read();
+                s.thread = l->thread;
+                result.push_back(s);
+            }
+            return result;
+        }
+
+        void add_timer(clock_type::time_point when, const strand_ptr& s) {
+            std::unique_lock<std::mutex> guard(timer_lock);
+            timers.push(timer_item(when, s));
+            timer_wake.notify_one();
+        }
+
+        void run_timers() {
+            std::unique_lock<std::mutex> guard(timer_lock);
+            while (!stopped) {
+                if (timers.empty()) {
+                    timer_wake.wait(guard);
+                    continue;
+                }
+                if (clock_type::now() < timers.top().when) {
+                    timer_wake.wait_until(guard, timers.top().when);
+                    continue;
+                }
+                auto s = timers.top().what.lock();
+                timers.pop();
+                guard.unlock();
+                if (!!s) {
+                    wake(s);
+                }
+                guard.lock();
+            }
+        }
+
+        void run(size_t index) {
+            current_pool() = this;
+            current_lane() = index;
+            RXCPP_UNWIND_AUTO([]{
+                current_pool() = nullptr;
+            });
+            auto& own = *lanes[index];
+            {
+                std::unique_lock<std::mutex> guard(own.lock);
+                own.thread = std::this_thread::get_id();
+            }
+            while (!stopped) {
+                if (own.counters.report_due(clock_type::now())) {
+                    auto report = stats()[index];
+                    trace_activity().worker_report(report);
+                }
+                auto s = take(index);
+                if (!s) {
+                    wait_for_work(index);
+                    continue;
+                }
+                drain(s, own.counters);
+            }
+        }
+
+        void wake(const strand_ptr& s) {
+            std::unique_lock<std::mutex> guard(s->lock);
+            if (!s->queued && !s->queue.empty()) {
+                s->queued = true;
+                guard.unlock();
+                post(s);
+            }
+        }
+
+        // call the due actions of one strand. after a few actions the strand
+        // goes to the back of the lane so that one busy worker cannot starve
+        // the other workers that share the lane.
+        void drain(const strand_ptr& s, detail::worker_counters& counters) {
+            int budget = 16;
+            std::unique_lock<std::mutex> guard(s->lock);
+            for (;;) {
+                if (!s->lifetime.is_subscribed() || s->queue.empty()) {
+                    s->queued = false;
+                    return;
+                }
+                auto& peek = s->queue.top();
+                if (!peek.what.is_subscribed()) {
+                    s->queue.pop();
+                    continue;
+                }
+                if (clock_type::now() < peek.when) {
+                    auto when = peek.when;
+                    s->queued = false;
+                    guard.unlock();
+                    add_timer(when, s);
+                    return;
+                }
+                if (budget-- == 0) {
+                    guard.unlock();
+                    post(s);
+                    return;
+                }
+                auto what = peek.what;
+                s->queue.pop();
+                s->r.reset(s->queue.empty());
+                guard.unlock();
+                auto started = clock_type::now();
+                what(s->r.get_recurse());
+                counters.ran(clock_type::now() - started);
+                guard.lock();
+            }
+        }
+
+        void stop() {
+            stopped = true;
+            {
+                std::unique_lock<std::mutex> guard(park_lock);
+                park.notify_all();
+            }
+            {
+                std::unique_lock<std::mutex> guard(timer_lock);
+                timer_wake.notify_all();
+            }
+            for (auto& l : lanes) {
+                std::deque<strand_ptr> expired;
+                {
+                    std::unique_lock<std::mutex> guard(l->lock);
+                    swap(expired, l->strands);
+                }
+            }
+        }
+    };
+
+    struct pool_worker : public worker_interface
+    {
+    private:
+        typedef pool_worker this_type;
+        pool_worker(const this_type&);
+
+        strand_ptr state;
+
+    public:
+        virtual ~pool_worker()
+        {
+        }
+
+        pool_worker(composite_subscription cs, std::shared_ptr<pool_state> p)
+            : state(std::make_shared<strand_state>(cs, std::move(p)))
+        {
+            std::weak_ptr<strand_state> weak = state;
+            state->lifetime.add([weak](){
+                auto s = weak.lock();
+                if (!s) {
+                    return;
+                }
+                typename strand_state::queue_item_time expired;
+                std::unique_lock<std::mutex> guard(s->lock);
+                using std::swap;
+                swap(expired, s->queue);
+            });
+        }
+
+        virtual clock_type::time_point now() const {
+            return clock_type::now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            schedule(now(), scbl);
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->push(typename strand_state::item_type(when, scbl));
+            state->r.reset(false);
+            if (state->queued) {
+                return;
+            }
+            if (when <= clock_type::now()) {
+                state->queued = true;
+                guard.unlock();
+                state->pool->post(state);
+            } else {
+                guard.unlock();
+                state->pool->add_timer(when, state);
+            }
+        }
+
+        virtual void schedule_batch(const std::vector<schedulable>& batch) const {
+            auto when = now();
+            std::unique_lock<std::mutex> guard(state->lock);
+            bool any = false;
+            for (auto& scbl : batch) {
+                if (scbl.is_subscribed()) {
+                    state->push(typename strand_state::item_type(when, scbl));
+                    any = true;
+                }
+            }
+            if (!any) {
+                return;
+            }
+            state->r.reset(false);
+            if (state->queued) {
+                return;
+            }
+            state->queued = true;
+            guard.unlock();
+            state->pool->post(state);
+        }
+    };
+
+    std::shared_ptr<pool_state> state;
+    std::vector<std::thread> threads;
+
+    void start(thread_factory& tf) {
+        auto keepAlive = state;
+        for (size_t index = 0; index < state->lanes.size(); ++index) {
+            threads.push_back(tf([keepAlive, index](){
+                keepAlive->run(index);
+            }));
+        }
+        threads.push_back(tf([keepAlive](){
+            keepAlive->run_timers();
+        }));
+    }
+
+    static size_t default_count() {
+        return std::max(std::thread::hardware_concurrency(), unsigned(2));
+    }
+
+public:
+    work_stealing_pool()
+        : state(std::make_shared<pool_state>(default_count()))
+    {
+        thread_factory tf([](std::function<void()> start){
+            return std::thread(std::move(start));
+        });
+        start(tf);
+    }
+    explicit work_stealing_pool(thread_factory tf, size_t count = default_count())
+        : state(std::make_shared<pool_state>(std::max(count, size_t(1))))
+    {
+        start(tf);
+    }
+    virtual ~work_stealing_pool()
+    {
+        state->stop();
+        for (auto& t : threads) {
+            if (t.joinable() && t.get_id() != std::this_thread::get_id()) {
+                t.join();
+            } else {
+                t.detach();
+            }
+        }
+    }
+
+    virtual clock_type::time_point now() const {
+        return clock_type::now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<pool_worker>(cs, state));
+    }
+
+    /// the stats of each pool thread. the work that is queued and stolen
+    /// is counted in strands, each a run of the actions of one worker.
+    virtual std::vector<worker_stats> stats() const {
+        return state->stats();
+    }
+};
+
+inline scheduler make_work_stealing_pool() {
+    static scheduler instance = make_scheduler<work_stealing_pool>();
+    return instance;
+}
+inline scheduler make_work_stealing_pool(thread_factory tf) {
+    return make_scheduler<work_stealing_pool>(tf);
+}
+inline scheduler make_work_stealing_pool(thread_factory tf, size_t count) {
+    return make_scheduler<work_stealing_pool>(tf, count);
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_FROM_GENERATOR_HPP)
+#define RXCPP_SOURCES_RX_FROM_GENERATOR_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+template<class Maybe>
+struct generated_value;
+template<class T>
+struct generated_value<rxu::detail::maybe<T>>
+{
+    typedef T type;
+};
+
+template<class Generator>
+struct generator_traits
+{
+    typedef rxu::decay_t<Generator> generator_type;
+    typedef rxu::decay_t<decltype((*(generator_type*)nullptr)())> result_type;
+    typedef typename generated_value<result_type>::type value_type;
+};
+
+template<class Generator, class Coordination>
+struct from_generator : public source_base<typename generator_traits<Generator>::value_type>
+{
+    typedef from_generator<Generator, Coordination> this_type;
+    typedef generator_traits<Generator> traits;
+
+    typedef typename traits::generator_type generator_type;
+    typedef typename traits::value_type value_type;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    struct from_generator_initial_type
+    {
+        from_generator_initial_type(generator_type g, coordination_type cn, demand p)
+            : generator(std::move(g))
+            , coordination(std::move(cn))
+            , pull(std::move(p))
+        {
+        }
+        generator_type generator;
+        coordination_type coordination;
+        demand pull;
+    };
+    from_generator_initial_type initial;
+
+    from_generator(generator_type g, coordination_type cn, demand p)
+        : initial(std::move(g), std::move(cn), std::move(p))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct from_generator_state_type
+        {
+            from_generator_state_type(generator_type g, demand p, output_type o)
+                : generator(std::move(g))
+                , pull(std::move(p))
+                , out(std::move(o))
+            {
+            }
+            generator_type generator;
+            demand pull;
+            output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        // each subscription pulls from its own copy of the generator
+        auto state = std::make_shared<from_generator_state_type>(initial.generator, initial.pull, coordinator.out(o));
+
+        auto producer = [state](const rxsc::schedulable& self){
+            auto& out = state->out;
+            if (!out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+
+            if (!state->pull.take()) {
+                // wait for the next request
+                auto resume = self;
+                if (!state->pull.take_or_resume([resume](){resume.schedule();})) {
+                    return;
+                }
+            }
+
+            // pull one value
+            auto next = on_exception(
+                [&](){return state->generator();},
+                out);
+            if (next.empty()) {
+                return;
+            }
+            if (next.get().empty()) {
+                out.on_completed();
+                // o is unsubscribed
+                return;
+            }
+            out.on_next(std::move(next.get().get()));
+
+            // tail recurse this same action to pull the next value
+            self();
+        };
+
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+
+        controller.schedule(selectedProducer.get());
+    }
+};
+
+}
+
+/// sends the values that the generator returns, pulling one in each
+/// scheduled action. the generator is called with no arguments and returns a
+/// rxu::maybe<T> that is empty at the end. each subscription calls its own
+/// copy of the generator.
+template<class Generator>
+auto from_generator(Generator g)
+    ->      observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, identity_one_worker>> {
+    return  observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, identity_one_worker>>(
+                                                                                 detail::from_generator<Generator, identity_one_worker>(std::move(g), identity_current_thread(), demand::unbounded()));
+}
+template<class Generator, class Coordination>
+auto from_generator(Generator g, Coordination cn)
+    ->      observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, Coordination>> {
+    return  observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, Coordination>>(
+                                                                                 detail::from_generator<Generator, Coordination>(std::move(g), std::move(cn), demand::unbounded()));
+}
+/// the generator is only called for values that are requested from pull
+template<class Generator, class Coordination>
+auto from_generator(Generator g, Coordination cn, demand pull)
+    ->      observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, Coordination>> {
+    return  observable<typename detail::generator_traits<Generator>::value_type, detail::from_generator<Generator, Coordination>>(
+                                                                                 detail::from_generator<Generator, Coordination>(std::move(g), std::move(cn), std::move(pull)));
+}
+
+}
+
+}
+
+#endif
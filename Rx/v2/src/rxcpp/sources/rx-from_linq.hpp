@@ -0,0 +1,266 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_FROM_LINQ_HPP)
+#define RXCPP_SOURCES_RX_FROM_LINQ_HPP
+
+// these join cpplinq queries and observables, so they are not included by
+// rx.hpp. include "rxcpp/sources/rx-from_linq.hpp" to use them.
+
+#include "../rx-includes.hpp"
+
+#include "cpplinq/linq.hpp"
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+template<class Query>
+struct from_linq_traits
+{
+    typedef rxu::decay_t<Query> query_type;
+    typedef typename query_type::cursor cursor_type;
+    typedef rxu::decay_t<typename cursor_type::element_type> value_type;
+};
+
+template<class Query, class Coordination>
+struct from_linq : public source_base<rxu::value_type_t<from_linq_traits<Query>>>
+{
+    typedef from_linq<Query, Coordination> this_type;
+    typedef from_linq_traits<Query> traits;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    typedef typename traits::query_type query_type;
+    typedef typename traits::cursor_type cursor_type;
+    typedef typename traits::value_type value_type;
+
+    struct from_linq_initial_type
+    {
+        from_linq_initial_type(query_type q, coordination_type cn, size_t ch)
+            : query(std::move(q))
+            , coordination(std::move(cn))
+            , chunk(ch)
+        {
+        }
+        query_type query;
+        coordination_type coordination;
+        // values sent by one scheduled action, 0 for the default
+        size_t chunk;
+    };
+    from_linq_initial_type initial;
+
+    from_linq(query_type q, coordination_type cn, size_t chunk = 0)
+        : initial(std::move(q), std::move(cn), chunk)
+    {
+    }
+
+    // values sent by one call to on_next_range
+    enum { batch_size = 64 };
+
+    // each scheduled action reads a chunk of values from the cursor. an
+    // observer that accepts on_next_range is sent the chunk in one call, any
+    // other observer is sent one value per scheduled action unless a chunk
+    // was set. an exception from the query is sent to on_error.
+    template<class State>
+    static void send_chunk(const State& state, const rxsc::schedulable& self, std::true_type) {
+        auto chunk = !!state.chunk ? state.chunk : size_t(batch_size);
+        rxu::detail::batch_buffer<value_type> values(chunk);
+        for (size_t count = 0; !state.cursor.empty() && count < chunk; ++count) {
+            try {
+                values.push_back(state.cursor.get());
+                state.cursor.inc();
+            } catch(...) {
+                state.out.on_next_range(values.data(), values.size());
+                state.out.on_error(std::current_exception());
+                return;
+            }
+        }
+        state.out.on_next_range(values.data(), values.size());
+        send_chunk_end(state, self);
+    }
+    template<class State>
+    static void send_chunk(const State& state, const rxsc::schedulable& self, std::false_type) {
+        auto chunk = !!state.chunk ? state.chunk : size_t(1);
+        for (size_t count = 0; !state.cursor.empty() && count < chunk; ++count) {
+            auto value = on_exception(
+                [&](){
+                    value_type v = state.cursor.get();
+                    state.cursor.inc();
+                    return v;},
+                state.out);
+            if (value.empty()) {
+                return;
+            }
+            state.out.on_next(std::move(value.get()));
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+        }
+        send_chunk_end(state, self);
+    }
+    template<class State>
+    static void send_chunk_end(const State& state, const rxsc::schedulable& self) {
+        if (!state.out.is_subscribed()) {
+            // terminate loop
+            return;
+        }
+        if (state.cursor.empty()) {
+            state.out.on_completed();
+            // o is unsubscribed
+            return;
+        }
+        // tail recurse this same action to continue loop
+        self();
+    }
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct from_linq_state_type
+            : public from_linq_initial_type
+        {
+            from_linq_state_type(const from_linq_initial_type& i, cursor_type c, output_type o)
+                : from_linq_initial_type(i)
+                , cursor(std::move(c))
+                , out(std::move(o))
+            {
+            }
+            mutable cursor_type cursor;
+            mutable output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        // the query runs when it is subscribed, each subscription with a
+        // cursor of its own
+        auto cursor = on_exception(
+            [&](){return initial.query.get_cursor();},
+            o);
+        if (cursor.empty()) {
+            return;
+        }
+
+        from_linq_state_type state(initial, std::move(cursor.get()), o);
+
+        auto controller = coordinator.get_worker();
+
+        typedef std::integral_constant<bool, rxcpp::detail::is_range_subscriber<value_type, output_type>::value> batched;
+
+        auto producer = [state](const rxsc::schedulable& self){
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+
+            if (state.cursor.empty()) {
+                state.out.on_completed();
+                // o is unsubscribed
+                return;
+            }
+
+            send_chunk(state, self, batched());
+        };
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+        controller.schedule(selectedProducer.get());
+    }
+};
+
+}
+
+/// sends the results of a cpplinq query. the query is kept by value, so a
+/// query over a container taken with cpplinq::from(container&) requires the
+/// container to outlive the subscriptions.
+template<class Query>
+auto from_linq(Query q)
+    ->      observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, identity_one_worker>> {
+    return  observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, identity_one_worker>>(
+                                                                           detail::from_linq<Query, identity_one_worker>(std::move(q), identity_immediate()));
+}
+template<class Query, class Coordination>
+auto from_linq(Query q, Coordination cn)
+    ->      observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>> {
+    return  observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>>(
+                                                                           detail::from_linq<Query, Coordination>(std::move(q), std::move(cn)));
+}
+/// each scheduled action sends up to chunk values
+template<class Query, class Coordination>
+auto from_linq(Query q, Coordination cn, size_t chunk)
+    ->      observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>> {
+    return  observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>>(
+                                                                           detail::from_linq<Query, Coordination>(std::move(q), std::move(cn), chunk));
+}
+
+}
+
+namespace detail {
+
+// a cpplinq collection of the values sent by an observable. the values are
+// shared by the collection and by every cursor taken from it.
+template<class T>
+class linq_buffer
+{
+    typedef std::vector<T> values_type;
+    typedef typename values_type::const_iterator iterator_type;
+
+    std::shared_ptr<const values_type> values;
+
+public:
+    struct cursor : public cpplinq::iter_cursor<iterator_type>
+    {
+        explicit cursor(std::shared_ptr<const values_type> v)
+            : cpplinq::iter_cursor<iterator_type>(v->begin(), v->end())
+            , values(std::move(v))
+        {
+        }
+    private:
+        std::shared_ptr<const values_type> values;
+    };
+
+    explicit linq_buffer(std::shared_ptr<const values_type> v)
+        : values(std::move(v))
+    {
+    }
+
+    cursor get_cursor() const {
+        return cursor(values);
+    }
+};
+
+}
+
+/// blocks until the source completes and returns a cpplinq query over the
+/// values it sent. an error from the source is rethrown.
+template<class T, class SourceOperator>
+cpplinq::linq_driver<detail::linq_buffer<T>> to_linq(const observable<T, SourceOperator>& source) {
+    auto values = std::make_shared<std::vector<T>>();
+    std::exception_ptr error;
+    source.as_blocking().subscribe(
+        [&](T v){
+            values->push_back(std::move(v));
+        },
+        [&](std::exception_ptr e){
+            error = e;
+        });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return detail::linq_buffer<T>(std::move(values));
+}
+
+}
+
+#endif
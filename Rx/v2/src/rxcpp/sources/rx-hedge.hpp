@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_HEDGE_HPP)
+#define RXCPP_SOURCES_RX_HEDGE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+template<class ObservableFactory>
+struct hedge_traits
+{
+    typedef rxu::decay_t<ObservableFactory> observable_factory_type;
+    typedef rxu::decay_t<decltype(std::declval<observable_factory_type>()(0))> collection_type;
+    typedef typename collection_type::value_type value_type;
+};
+
+/// subscribes to the observable for attempt 0 from the factory, and to the
+/// next attempt each time that delay passes without a notification, until
+/// max_attempts are subscribed. the first attempt to send an item or complete
+/// wins and the others are unsubscribed at once. an attempt that fails before
+/// then starts the next attempt at once, the error is sent when every attempt
+/// has failed.
+template<class ObservableFactory, class Coordination>
+struct hedge : public source_base<rxu::value_type_t<hedge_traits<ObservableFactory>>>
+{
+    typedef hedge_traits<ObservableFactory> traits;
+    typedef typename traits::observable_factory_type observable_factory_type;
+    typedef typename traits::collection_type collection_type;
+    typedef typename traits::value_type value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    struct hedge_initial_type
+    {
+        hedge_initial_type(clock_type::duration d, observable_factory_type of, int m, coordination_type cn)
+            : delay(d)
+            , observable_factory(std::move(of))
+            , max_attempts((std::max)(m, 1))
+            , coordination(std::move(cn))
+        {
+        }
+        clock_type::duration delay;
+        observable_factory_type observable_factory;
+        int max_attempts;
+        coordination_type coordination;
+    };
+    hedge_initial_type initial;
+
+    hedge(clock_type::duration d, observable_factory_type of, int max_attempts, coordination_type cn)
+        : initial(d, std::move(of), max_attempts, std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef Subscriber output_type;
+
+        struct hedge_state_type
+            : public std::enable_shared_from_this<hedge_state_type>
+            , public hedge_initial_type
+        {
+            hedge_state_type(hedge_initial_type i, coordinator_type coor, output_type oarg)
+                : hedge_initial_type(std::move(i))
+                , winner(-1)
+                , live(0)
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            // true when attempt i is the first to send
+            bool win(int i) {
+                if (winner < 0) {
+                    winner = i;
+                    for (int other = 0; other != int(lifetimes.size()); ++other) {
+                        if (other != i) {
+                            lifetimes[other].unsubscribe();
+                        }
+                    }
+                }
+                return winner == i;
+            }
+
+            void fail(int i, std::exception_ptr e) {
+                if (winner >= 0) {
+                    if (winner == i) {
+                        out.on_error(e);
+                    }
+                    return;
+                }
+                --live;
+                if (int(lifetimes.size()) < this->max_attempts) {
+                    start();
+                } else if (live == 0) {
+                    out.on_error(e);
+                }
+            }
+
+            void start() {
+                auto state = this->shared_from_this();
+                int i = int(lifetimes.size());
+
+                composite_subscription innercs;
+
+                // when the out observer is unsubscribed all the
+                // inner subscriptions are unsubscribed as well
+                auto innercstoken = out.add(innercs);
+                innercs.add(make_subscription([state, innercstoken](){
+                    state->out.remove(innercstoken);
+                }));
+                lifetimes.push_back(innercs);
+                ++live;
+
+                auto selectedCollection = on_exception(
+                    [&](){return this->observable_factory(i);},
+                    out);
+                if (selectedCollection.empty()) {
+                    return;
+                }
+                auto source = on_exception(
+                    [&](){return coordinator.in(selectedCollection.get());},
+                    out);
+                if (source.empty()) {
+                    return;
+                }
+
+                auto sink = make_subscriber<value_type>(
+                    out,
+                    innercs,
+                // on_next
+                    [state, i](value_type v) {
+                        if (state->win(i)) {
+                            state->out.on_next(std::move(v));
+                        }
+                    },
+                // on_error
+                    [state, i](std::exception_ptr e) {
+                        state->fail(i, e);
+                    },
+                // on_completed
+                    [state, i]() {
+                        if (state->win(i)) {
+                            state->out.on_completed();
+                        }
+                    }
+                );
+                auto selectedSink = on_exception(
+                    [&](){return coordinator.out(sink);},
+                    out);
+                if (selectedSink.empty()) {
+                    return;
+                }
+
+                if (i + 1 < this->max_attempts) {
+                    // the next attempt, unless this one has been answered or
+                    // has failed and started it before then
+                    auto worker = coordinator.get_worker();
+                    auto selectedNext = on_exception(
+                        [&](){
+                            return coordinator.act([state, i](const rxsc::schedulable&){
+                                if (state->winner < 0 && int(state->lifetimes.size()) == i + 1) {
+                                    state->start();
+                                }
+                            });
+                        },
+                        out);
+                    if (selectedNext.empty()) {
+                        return;
+                    }
+                    worker.schedule(worker.now() + this->delay, selectedNext.get());
+                }
+
+                source->subscribe(std::move(selectedSink.get()));
+            }
+
+            std::vector<composite_subscription> lifetimes;
+            int winner;
+            // the attempts that have not failed
+            int live;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = std::make_shared<hedge_state_type>(initial, std::move(coordinator), std::move(o));
+
+        state->start();
+    }
+};
+
+}
+
+template<class Duration, class ObservableFactory, class Coordination>
+auto hedge(Duration delay, ObservableFactory of, int max_attempts, Coordination cn)
+    ->      observable<rxu::value_type_t<detail::hedge_traits<ObservableFactory>>,    detail::hedge<ObservableFactory, Coordination>> {
+    return  observable<rxu::value_type_t<detail::hedge_traits<ObservableFactory>>,    detail::hedge<ObservableFactory, Coordination>>(
+                                                                                      detail::hedge<ObservableFactory, Coordination>(delay, std::move(of), max_attempts, std::move(cn)));
+}
+
+}
+
+}
+
+#endif
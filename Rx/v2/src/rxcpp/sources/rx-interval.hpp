@@ -13,6 +13,196 @@ namespace sources {
 
 namespace detail {
 
+// one periodic timer on one worker of a scheduler, shared by the intervals
+// with the same period whose ticks fall at the same times. each tick calls
+// every member that has started, so many intervals cost one wakeup per tick.
+// the timer is scheduled at absolute times, so it does not drift.
+struct interval_timer : public std::enable_shared_from_this<interval_timer>
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    struct member
+    {
+        composite_subscription lifetime;
+        clock_type::time_point start;
+        std::function<void(const rxsc::schedulable&)> tick;
+        size_t id;
+    };
+
+    interval_timer(rxsc::scheduler sc, clock_type::time_point first, clock_type::duration p)
+        : factory(std::move(sc))
+        , period(p)
+        , next(first)
+        , closed(false)
+        , ids(0)
+    {
+    }
+
+    const rxsc::scheduler factory;
+    const clock_type::duration period;
+
+    // guards the below
+    std::mutex lock;
+    // the time of the next tick
+    clock_type::time_point next;
+    std::vector<member> members;
+    // set when the last member has left. a closed timer takes no members.
+    bool closed;
+    size_t ids;
+    rxsc::worker controller;
+
+    // call with lock held
+    bool accepts(const rxsc::scheduler& sc, clock_type::time_point start, clock_type::duration p) const {
+        return !closed && p == period && factory == sc &&
+            start >= next && (start - next).count() % period.count() == 0;
+    }
+
+    // call with lock held. returns the id to leave with.
+    size_t add(member m) {
+        m.id = ++ids;
+        members.push_back(std::move(m));
+        return ids;
+    }
+
+    void leave(size_t id) {
+        rxsc::worker expired;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            members.erase(std::remove_if(members.begin(), members.end(), [id](const member& m){
+                return m.id == id;
+            }), members.end());
+            if (!members.empty() || closed) {
+                return;
+            }
+            closed = true;
+            expired = controller;
+        }
+        expired.unsubscribe();
+    }
+
+    void run() {
+        auto keepAlive = this->shared_from_this();
+        auto w = factory.create_worker();
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (closed) {
+                return;
+            }
+            controller = w;
+        }
+        w.schedule_periodically(next, period, [keepAlive](const rxsc::schedulable& self){
+            keepAlive->on_tick(self);
+        });
+    }
+
+    void on_tick(const rxsc::schedulable& self) {
+        std::vector<member> due;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            auto at = next;
+            next += period;
+            for (auto& m : members) {
+                if (m.start <= at) {
+                    due.push_back(m);
+                }
+            }
+        }
+        for (auto& m : due) {
+            if (m.lifetime.is_subscribed()) {
+                m.tick(self);
+            }
+        }
+    }
+};
+
+struct interval_timers
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    std::mutex lock;
+    std::vector<std::weak_ptr<interval_timer>> timers;
+
+    static interval_timers& instance() {
+        static interval_timers r;
+        return r;
+    }
+
+    // adds m to a timer that ticks at m.start, or starts one
+    void join(const rxsc::scheduler& sc, clock_type::duration period, interval_timer::member m) {
+        auto lifetime = m.lifetime;
+        std::shared_ptr<interval_timer> joined;
+        size_t id = 0;
+        bool start = false;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            timers.erase(std::remove_if(timers.begin(), timers.end(), [](const std::weak_ptr<interval_timer>& t){
+                return t.expired();
+            }), timers.end());
+            for (auto& weak : timers) {
+                auto t = weak.lock();
+                if (!t) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> timer_guard(t->lock);
+                if (t->accepts(sc, m.start, period)) {
+                    id = t->add(std::move(m));
+                    joined = std::move(t);
+                    break;
+                }
+            }
+            if (!joined) {
+                joined = std::make_shared<interval_timer>(sc, m.start, period);
+                id = joined->add(std::move(m));
+                timers.push_back(joined);
+                start = true;
+            }
+        }
+        // the member leaves when it is unsubscribed, not at the next tick
+        std::weak_ptr<interval_timer> weak = joined;
+        lifetime.add([weak, id](){
+            auto t = weak.lock();
+            if (!!t) {
+                t->leave(id);
+            }
+        });
+        if (start) {
+            joined->run();
+        }
+    }
+
+    /// the timers that are still ticking
+    size_t size() {
+        std::unique_lock<std::mutex> guard(lock);
+        size_t result = 0;
+        for (auto& weak : timers) {
+            auto t = weak.lock();
+            if (!!t) {
+                std::unique_lock<std::mutex> timer_guard(t->lock);
+                result += t->closed ? 0 : 1;
+            }
+        }
+        return result;
+    }
+};
+
+// the scheduler that a coordination runs the interval on, when the timer can
+// be shared. the trampolines run the timer on the thread that subscribed,
+// so they cannot share it.
+template<class Coordination>
+auto shared_timer_scheduler(const Coordination& cn, int)
+    -> decltype(rxsc::scheduler(cn.get_scheduler()), rxu::maybe<rxsc::scheduler>()) {
+    rxsc::scheduler sc(cn.get_scheduler());
+    if (sc == rxsc::make_current_thread() || sc == rxsc::make_immediate() ||
+        sc == rxsc::make_typed_current_thread() || sc == rxsc::make_typed_immediate()) {
+        return rxu::maybe<rxsc::scheduler>();
+    }
+    return rxu::maybe<rxsc::scheduler>(sc);
+}
+template<class Coordination>
+rxu::maybe<rxsc::scheduler> shared_timer_scheduler(const Coordination&, ...) {
+    return rxu::maybe<rxsc::scheduler>();
+}
+
 template<class Coordination>
 struct interval : public source_base<long>
 {
@@ -62,6 +252,22 @@ struct interval : public source_base<long>
             return;
         }
 
+        // the intervals that tick at the same times share one timer. an
+        // interval that has not started yet joins a timer that ticks at its
+        // start, the others keep their own timer.
+        auto shared = shared_timer_scheduler(initial.coordination, 0);
+        if (!shared.empty() &&
+            initial.period != rxsc::scheduler::clock_type::duration::max() &&
+            initial.period > rxsc::scheduler::clock_type::duration::zero() &&
+            initial.initial >= shared.get().now()) {
+            interval_timer::member m;
+            m.lifetime = o.get_subscription();
+            m.start = initial.initial;
+            m.tick = selectedProducer.get();
+            interval_timers::instance().join(shared.get(), initial.period, std::move(m));
+            return;
+        }
+
         controller.schedule_periodically(initial.initial, initial.period, selectedProducer.get());
     }
 };
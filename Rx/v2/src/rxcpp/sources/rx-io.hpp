@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_IO_HPP)
+#define RXCPP_SOURCES_RX_IO_HPP
+
+// these sources wait on file descriptors, so they are not included by rx.hpp.
+// include "rxcpp/sources/rx-io.hpp" to use them.
+
+#include "../rx-includes.hpp"
+#include "../schedulers/rx-io_event_loop.hpp"
+
+#include <sys/socket.h>
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+inline bool io_would_block(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+}
+
+struct from_fd : public source_base<rxcpp::slice>
+{
+    struct from_fd_initial_type
+    {
+        from_fd_initial_type(int fd, buffer_pool p, std::shared_ptr<rxsc::io_event_loop> l)
+            : fd(fd)
+            , pool(std::move(p))
+            , loop(std::move(l))
+        {
+        }
+        int fd;
+        buffer_pool pool;
+        std::shared_ptr<rxsc::io_event_loop> loop;
+    };
+    from_fd_initial_type initial;
+
+    from_fd(int fd, buffer_pool p, std::shared_ptr<rxsc::io_event_loop> l)
+        : initial(fd, std::move(p), std::move(l))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        // reads fill one buffer from the front. each slice shares the buffer
+        // and a new buffer is taken when little space is left in this one.
+        struct from_fd_state_type
+        {
+            from_fd_state_type(int fd, buffer_pool p, Subscriber o)
+                : fd(fd)
+                , pool(std::move(p))
+                , used(0)
+                , out(std::move(o))
+            {
+            }
+            int fd;
+            buffer_pool pool;
+            buffer bytes;
+            size_t used;
+            Subscriber out;
+        };
+
+        auto state = std::make_shared<from_fd_state_type>(initial.fd, initial.pool, o);
+
+        auto readable = [state](){
+            auto& out = state->out;
+            if (!out.is_subscribed()) {
+                return;
+            }
+            auto capacity = state->bytes.capacity();
+            if (state->bytes.empty() || capacity - state->used < capacity / 4 || state->used == capacity) {
+                // drop the reference before taking so that the block can be reused
+                state->bytes = buffer();
+                state->bytes = state->pool.take();
+                state->used = 0;
+            }
+            auto count = ::read(state->fd, state->bytes.data() + state->used, state->bytes.capacity() - state->used);
+            if (count > 0) {
+                auto part = state->bytes.sub(state->used, count);
+                state->used += count;
+                out.on_next(std::move(part));
+            } else if (count == 0) {
+                out.on_completed();
+            } else if (!io_would_block(errno)) {
+                out.on_error(std::make_exception_ptr(rxsc::detail::io_error("from_fd: read")));
+            }
+        };
+
+        auto loop = initial.loop;
+        auto fd = initial.fd;
+        on_exception(
+            [&](){loop->watch_readable(fd, o.get_subscription(), readable); return true;},
+            o);
+    }
+};
+
+struct accept : public source_base<int>
+{
+    struct accept_initial_type
+    {
+        accept_initial_type(int fd, std::shared_ptr<rxsc::io_event_loop> l)
+            : fd(fd)
+            , loop(std::move(l))
+        {
+        }
+        int fd;
+        std::shared_ptr<rxsc::io_event_loop> loop;
+    };
+    accept_initial_type initial;
+
+    accept(int fd, std::shared_ptr<rxsc::io_event_loop> l)
+        : initial(fd, std::move(l))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        auto fd = initial.fd;
+        auto readable = [fd, o](){
+            if (!o.is_subscribed()) {
+                return;
+            }
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client >= 0) {
+                ::fcntl(client, F_SETFL, ::fcntl(client, F_GETFL) | O_NONBLOCK);
+                ::fcntl(client, F_SETFD, FD_CLOEXEC);
+                o.on_next(client);
+            } else if (!io_would_block(errno) && errno != ECONNABORTED) {
+                o.on_error(std::make_exception_ptr(rxsc::detail::io_error("accept: accept")));
+            }
+        };
+
+        auto loop = initial.loop;
+        on_exception(
+            [&](){loop->watch_readable(fd, o.get_subscription(), readable); return true;},
+            o);
+    }
+};
+
+}
+
+/// sends a slice of the bytes of each read from fd, when fd is readable, and
+/// completes at the end of the file. the slices share buffers taken from the
+/// pool, which get the block back when the last slice into it is gone.
+/// fd should be non-blocking and must stay open until the subscription ends.
+inline auto from_fd(int fd, buffer_pool pool, std::shared_ptr<rxsc::io_event_loop> loop)
+    ->      observable<rxcpp::slice,    detail::from_fd> {
+    return  observable<rxcpp::slice,    detail::from_fd>(
+                                        detail::from_fd(fd, std::move(pool), std::move(loop)));
+}
+/// the buffers are chunk bytes
+inline auto from_fd(int fd, size_t chunk, std::shared_ptr<rxsc::io_event_loop> loop)
+    ->      observable<rxcpp::slice,    detail::from_fd> {
+    return  observable<rxcpp::slice,    detail::from_fd>(
+                                        detail::from_fd(fd, buffer_pool(chunk), std::move(loop)));
+}
+inline auto from_fd(int fd)
+    ->      observable<rxcpp::slice,    detail::from_fd> {
+    return  observable<rxcpp::slice,    detail::from_fd>(
+                                        detail::from_fd(fd, buffer_pool(64 * 1024), rxsc::make_io_event_loop()));
+}
+
+/// sends each connection accepted on listen_fd. each connection is a
+/// non-blocking fd that the subscriber must close. listen_fd should be
+/// non-blocking and must stay open until the subscription ends.
+inline auto accept(int listen_fd, std::shared_ptr<rxsc::io_event_loop> loop)
+    ->      observable<int,     detail::accept> {
+    return  observable<int,     detail::accept>(
+                                detail::accept(listen_fd, std::move(loop)));
+}
+inline auto accept(int listen_fd)
+    ->      observable<int,     detail::accept> {
+    return  observable<int,     detail::accept>(
+                                detail::accept(listen_fd, rxsc::make_io_event_loop()));
+}
+
+}
+
+}
+
+#endif
@@ -27,12 +27,32 @@ struct is_iterable
     static const bool value = !std::is_same<decltype(check<collection_type>(0)), not_void>::value;
 };
 
+// the collections that keep their values next to each other in memory, so
+// that a batch can be sent straight from the collection
+template<class Collection, class Iterator>
+struct is_contiguous_collection : public std::is_pointer<Iterator>
+{
+};
+template<class V, class A, class Iterator>
+struct is_contiguous_collection<std::vector<V, A>, Iterator> : public std::integral_constant<bool, !std::is_same<V, bool>::value>
+{
+};
+template<class V, size_t N, class Iterator>
+struct is_contiguous_collection<std::array<V, N>, Iterator> : public std::true_type
+{
+};
+template<class C, class Traits, class A, class Iterator>
+struct is_contiguous_collection<std::basic_string<C, Traits, A>, Iterator> : public std::true_type
+{
+};
+
 template<class Collection>
 struct iterate_traits
 {
     typedef rxu::decay_t<Collection> collection_type;
     typedef decltype(std::begin(*(collection_type*)nullptr)) iterator_type;
     typedef rxu::value_type_t<std::iterator_traits<iterator_type>> value_type;
+    static const bool contiguous = is_contiguous_collection<collection_type, iterator_type>::value;
 };
 
 template<class Collection, class Coordination>
@@ -49,20 +69,114 @@ struct iterate : public source_base<rxu::value_type_t<iterate_traits<Collection>
 
     struct iterate_initial_type
     {
-        iterate_initial_type(collection_type c, coordination_type cn)
+        iterate_initial_type(collection_type c, coordination_type cn, demand p, size_t ch)
             : collection(std::move(c))
             , coordination(std::move(cn))
+            , pull(std::move(p))
+            , chunk(ch)
+            , skip(0)
+            , count((std::numeric_limits<size_t>::max)())
         {
         }
         collection_type collection;
         coordination_type coordination;
+        demand pull;
+        // values sent by one scheduled action, 0 for the default
+        size_t chunk;
+        // the slice of the collection that is sent
+        size_t skip;
+        size_t count;
     };
     iterate_initial_type initial;
 
-    iterate(collection_type c, coordination_type cn)
-        : initial(std::move(c), std::move(cn))
+    iterate(collection_type c, coordination_type cn, demand p = demand::unbounded(), size_t chunk = 0)
+        : initial(std::move(c), std::move(cn), std::move(p), chunk)
     {
     }
+
+    /// the count values of the collection after the first skip values
+    this_type sliced(size_t skip, size_t count) const {
+        this_type result = *this;
+        auto& slice = result.initial;
+        auto left = slice.count > skip ? slice.count - skip : 0;
+        slice.skip = skip > (std::numeric_limits<size_t>::max)() - slice.skip ? (std::numeric_limits<size_t>::max)() : slice.skip + skip;
+        slice.count = (std::min)(left, count);
+        return result;
+    }
+
+    // a random access iterator moves to the slice at once, any other steps
+    // through the values without sending them
+    static iterator_type advance(iterator_type it, iterator_type end, size_t n, std::random_access_iterator_tag) {
+        return it + static_cast<ptrdiff_t>((std::min)(n, static_cast<size_t>(std::distance(it, end))));
+    }
+    template<class Tag>
+    static iterator_type advance(iterator_type it, iterator_type end, size_t n, Tag) {
+        if (n == (std::numeric_limits<size_t>::max)()) {
+            // not sliced
+            return end;
+        }
+        for (; n != 0 && it != end; --n) {
+            ++it;
+        }
+        return it;
+    }
+    static iterator_type advance(iterator_type it, iterator_type end, size_t n) {
+        return advance(std::move(it), std::move(end), n, typename std::iterator_traits<iterator_type>::iterator_category());
+    }
+
+    // values sent by one call to on_next_range
+    enum { batch_size = 64 };
+
+    // when no demand limits the producer, each scheduled action sends a chunk
+    // of values. an observer that accepts on_next_range is sent the chunk in
+    // one call, straight from the collection when it is contiguous. any other
+    // observer is sent one value per scheduled action unless a chunk was set.
+    template<class State>
+    static void send_chunk(const State& state, const rxsc::schedulable& self, std::true_type, std::true_type) {
+        auto count = (std::min)(static_cast<size_t>(std::distance(state.cursor, state.end)), !!state.chunk ? state.chunk : size_t(batch_size));
+        auto first = std::addressof(*state.cursor);
+        state.cursor += count;
+        state.out.on_next_range(first, count);
+        send_chunk_end(state, self);
+    }
+    template<class State>
+    static void send_chunk(const State& state, const rxsc::schedulable& self, std::true_type, std::false_type) {
+        typedef rxu::decay_t<decltype(*state.cursor)> batch_value_type;
+        auto chunk = !!state.chunk ? state.chunk : size_t(batch_size);
+        rxu::detail::batch_buffer<batch_value_type> values(chunk);
+        for (size_t count = 0; state.cursor != state.end && count < chunk; ++count, ++state.cursor) {
+            values.push_back(*state.cursor);
+        }
+        state.out.on_next_range(values.data(), values.size());
+        send_chunk_end(state, self);
+    }
+    template<class State, class Contiguous>
+    static void send_chunk(const State& state, const rxsc::schedulable& self, std::false_type, Contiguous) {
+        auto chunk = !!state.chunk ? state.chunk : size_t(1);
+        for (size_t count = 0; state.cursor != state.end && count < chunk; ++count) {
+            state.out.on_next(*state.cursor);
+            ++state.cursor;
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+        }
+        send_chunk_end(state, self);
+    }
+    template<class State>
+    static void send_chunk_end(const State& state, const rxsc::schedulable& self) {
+        if (!state.out.is_subscribed()) {
+            // terminate loop
+            return;
+        }
+        if (state.cursor == state.end) {
+            state.out.on_completed();
+            // o is unsubscribed
+            return;
+        }
+        // tail recurse this same action to continue loop
+        self();
+    }
     template<class Subscriber>
     void on_subscribe(Subscriber o) const {
         static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
@@ -74,15 +188,15 @@ struct iterate : public source_base<rxu::value_type_t<iterate_traits<Collection>
         {
             iterate_state_type(const iterate_initial_type& i, output_type o)
                 : iterate_initial_type(i)
-                , cursor(std::begin(iterate_initial_type::collection))
-                , end(std::end(iterate_initial_type::collection))
+                , cursor(advance(std::begin(iterate_initial_type::collection), std::end(iterate_initial_type::collection), this->skip))
+                , end(advance(cursor, std::end(iterate_initial_type::collection), this->count))
                 , out(std::move(o))
             {
             }
             iterate_state_type(const iterate_state_type& o)
                 : iterate_initial_type(o)
-                , cursor(std::begin(iterate_initial_type::collection))
-                , end(std::end(iterate_initial_type::collection))
+                , cursor(advance(std::begin(iterate_initial_type::collection), std::end(iterate_initial_type::collection), this->skip))
+                , end(advance(cursor, std::end(iterate_initial_type::collection), this->count))
                 , out(std::move(o.out)) // since lambda capture does not yet support move
             {
             }
@@ -98,13 +212,29 @@ struct iterate : public source_base<rxu::value_type_t<iterate_traits<Collection>
 
         auto controller = coordinator.get_worker();
 
+        typedef rxu::value_type_t<this_type> value_type;
+        typedef std::integral_constant<bool, rxcpp::detail::is_range_subscriber<value_type, output_type>::value> batched;
+        typedef std::integral_constant<bool, traits::contiguous> contiguous;
+
         auto producer = [state](const rxsc::schedulable& self){
             if (!state.out.is_subscribed()) {
                 // terminate loop
                 return;
             }
 
+            if (state.pull.is_unbounded() && state.cursor != state.end) {
+                send_chunk(state, self, batched(), contiguous());
+                return;
+            }
+
             if (state.cursor != state.end) {
+                if (!state.pull.take()) {
+                    // wait for the next request
+                    auto resume = self;
+                    if (!state.pull.take_or_resume([resume](){resume.schedule();})) {
+                        return;
+                    }
+                }
                 // send next value
                 state.out.on_next(*state.cursor);
                 ++state.cursor;
@@ -144,6 +274,20 @@ auto iterate(Collection c, Coordination cn)
     return  observable<rxu::value_type_t<detail::iterate_traits<Collection>>, detail::iterate<Collection, Coordination>>(
                                                                               detail::iterate<Collection, Coordination>(std::move(c), std::move(cn)));
 }
+/// each scheduled action sends up to chunk values
+template<class Collection, class Coordination>
+auto iterate(Collection c, Coordination cn, size_t chunk)
+    ->      observable<rxu::value_type_t<detail::iterate_traits<Collection>>, detail::iterate<Collection, Coordination>> {
+    return  observable<rxu::value_type_t<detail::iterate_traits<Collection>>, detail::iterate<Collection, Coordination>>(
+                                                                              detail::iterate<Collection, Coordination>(std::move(c), std::move(cn), demand::unbounded(), chunk));
+}
+/// values are only sent as they are requested from pull
+template<class Collection, class Coordination>
+auto iterate(Collection c, Coordination cn, demand pull)
+    ->      observable<rxu::value_type_t<detail::iterate_traits<Collection>>, detail::iterate<Collection, Coordination>> {
+    return  observable<rxu::value_type_t<detail::iterate_traits<Collection>>, detail::iterate<Collection, Coordination>>(
+                                                                              detail::iterate<Collection, Coordination>(std::move(c), std::move(cn), std::move(pull)));
+}
 
 template<class T>
 auto from()
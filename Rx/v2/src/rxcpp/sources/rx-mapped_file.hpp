@@ -0,0 +1,318 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_MAPPED_FILE_HPP)
+#define RXCPP_SOURCES_RX_MAPPED_FILE_HPP
+
+// this source uses the os to map files, so it is not included by rx.hpp.
+// include "rxcpp/sources/rx-mapped_file.hpp" to use it.
+
+#include "../rx-includes.hpp"
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rxcpp {
+
+namespace sources {
+
+/// splits at each '\n'. a '\r' before the '\n' is dropped and the last line
+/// does not need a '\n'.
+struct by_line
+{
+    const char* operator()(const char* first, const char* last, const char*& next) const {
+        auto nl = static_cast<const char*>(std::memchr(first, '\n', last - first));
+        next = !!nl ? nl + 1 : last;
+        auto end = !!nl ? nl : last;
+        if (end != first && *(end - 1) == '\r') {
+            --end;
+        }
+        return end;
+    }
+};
+
+/// splits at each delimiter. the last slice does not need a delimiter.
+struct by_delimiter
+{
+    explicit by_delimiter(char d)
+        : delimiter(d)
+    {
+    }
+    const char* operator()(const char* first, const char* last, const char*& next) const {
+        auto found = static_cast<const char*>(std::memchr(first, delimiter, last - first));
+        next = !!found ? found + 1 : last;
+        return !!found ? found : last;
+    }
+    char delimiter;
+};
+
+/// splits into records of size bytes. the last record can be shorter.
+struct by_record
+{
+    explicit by_record(size_t s)
+        : size((std::max)(s, size_t(1)))
+    {
+    }
+    const char* operator()(const char* first, const char* last, const char*& next) const {
+        next = first + (std::min)(size, static_cast<size_t>(last - first));
+        return next;
+    }
+    size_t size;
+};
+
+namespace detail {
+
+// the bytes of a file mapped into memory for reading. unmapped when the
+// last slice into it is gone.
+class file_mapping
+{
+    const char* first;
+    size_t length;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    file_mapping(const file_mapping&);
+    file_mapping& operator=(const file_mapping&);
+
+    static std::system_error error(const std::string& what, const std::string& path) {
+#if defined(_WIN32)
+        return std::system_error(static_cast<int>(GetLastError()), std::system_category(), "mapped_file: " + what + " " + path);
+#else
+        return std::system_error(errno, std::generic_category(), "mapped_file: " + what + " " + path);
+#endif
+    }
+
+public:
+    explicit file_mapping(const std::string& path)
+        : first(nullptr)
+        , length(0)
+#if defined(_WIN32)
+        , file(INVALID_HANDLE_VALUE)
+        , mapping(nullptr)
+#endif
+    {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw error("open", path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            auto e = error("size", path);
+            CloseHandle(file);
+            throw e;
+        }
+        length = static_cast<size_t>(size.QuadPart);
+        if (length == 0) {
+            return;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            auto e = error("map", path);
+            CloseHandle(file);
+            throw e;
+        }
+        first = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!first) {
+            auto e = error("map", path);
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw e;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw error("open", path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            auto e = error("size", path);
+            ::close(fd);
+            throw e;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length == 0) {
+            ::close(fd);
+            return;
+        }
+        auto p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping does not need the descriptor
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw error("map", path);
+        }
+        ::madvise(p, length, MADV_SEQUENTIAL);
+        first = static_cast<const char*>(p);
+#endif
+    }
+    ~file_mapping()
+    {
+#if defined(_WIN32)
+        if (first) {
+            UnmapViewOfFile(first);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (first) {
+            ::munmap(const_cast<char*>(first), length);
+        }
+#endif
+    }
+
+    const char* data() const {
+        return first;
+    }
+    size_t size() const {
+        return length;
+    }
+};
+
+template<class Chunker, class Coordination>
+struct mapped_file : public source_base<rxcpp::slice>
+{
+    typedef rxu::decay_t<Chunker> chunker_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    struct mapped_file_initial_type
+    {
+        mapped_file_initial_type(std::string p, chunker_type c, coordination_type cn)
+            : path(std::move(p))
+            , chunker(std::move(c))
+            , coordination(std::move(cn))
+        {
+        }
+        std::string path;
+        chunker_type chunker;
+        coordination_type coordination;
+    };
+    mapped_file_initial_type initial;
+
+    mapped_file(std::string path, chunker_type c, coordination_type cn)
+        : initial(std::move(path), std::move(c), std::move(cn))
+    {
+    }
+
+    // slices sent by one scheduled action
+    enum { batch_size = 64 };
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct mapped_file_state_type
+        {
+            mapped_file_state_type(std::shared_ptr<const file_mapping> m, chunker_type c, output_type o)
+                : mapping(std::move(m))
+                , chunker(std::move(c))
+                , cursor(mapping->data())
+                , last(mapping->data() + mapping->size())
+                , out(std::move(o))
+            {
+            }
+            std::shared_ptr<const file_mapping> mapping;
+            chunker_type chunker;
+            const char* cursor;
+            const char* last;
+            output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        auto path = initial.path;
+        auto mapping = on_exception(
+            [&](){return std::shared_ptr<const file_mapping>(std::make_shared<file_mapping>(path));},
+            o);
+        if (mapping.empty()) {
+            return;
+        }
+
+        auto state = std::make_shared<mapped_file_state_type>(std::move(mapping.get()), initial.chunker, coordinator.out(o));
+
+        auto producer = [state](const rxsc::schedulable& self){
+            auto& out = state->out;
+            for (int count = 0; state->cursor != state->last && count < batch_size; ++count) {
+                if (!out.is_subscribed()) {
+                    // terminate loop
+                    return;
+                }
+                const char* next = nullptr;
+                auto end = state->chunker(state->cursor, state->last, next);
+                // send next slice
+                out.on_next(rxcpp::slice(state->mapping, state->cursor, end - state->cursor));
+                state->cursor = next;
+            }
+            if (!out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+            if (state->cursor == state->last) {
+                out.on_completed();
+                // o is unsubscribed
+                return;
+            }
+            // tail recurse this same action so that other actions can run
+            // between batches
+            self();
+        };
+
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+
+        controller.schedule(selectedProducer.get());
+    }
+};
+
+}
+
+/// maps the file at path into memory and sends the slices of it that the
+/// chunker marks, without copying them. by_line, by_delimiter and by_record
+/// are chunkers. the file stays mapped while any of its slices is alive.
+template<class Chunker>
+auto mapped_file(std::string path, Chunker c)
+    ->      observable<rxcpp::slice,    detail::mapped_file<Chunker, identity_one_worker>> {
+    return  observable<rxcpp::slice,    detail::mapped_file<Chunker, identity_one_worker>>(
+                                        detail::mapped_file<Chunker, identity_one_worker>(std::move(path), std::move(c), identity_current_thread()));
+}
+template<class Chunker, class Coordination>
+auto mapped_file(std::string path, Chunker c, Coordination cn)
+    ->      observable<rxcpp::slice,    detail::mapped_file<Chunker, Coordination>> {
+    return  observable<rxcpp::slice,    detail::mapped_file<Chunker, Coordination>>(
+                                        detail::mapped_file<Chunker, Coordination>(std::move(path), std::move(c), std::move(cn)));
+}
+
+}
+
+}
+
+#endif
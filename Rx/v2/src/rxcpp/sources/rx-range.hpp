@@ -21,23 +21,175 @@ struct range : public source_base<T>
 
     struct range_state_type
     {
-        range_state_type(T f, T l, ptrdiff_t s, coordination_type cn)
+        range_state_type(T f, T l, ptrdiff_t s, coordination_type cn, demand p)
             : next(f)
             , last(l)
             , step(s)
             , coordination(std::move(cn))
+            , pull(std::move(p))
+            , empty(false)
         {
         }
         mutable T next;
         T last;
         ptrdiff_t step;
         coordination_type coordination;
+        demand pull;
+        // a slice past the end, only completes
+        bool empty;
     };
     range_state_type initial;
-    range(T f, T l, ptrdiff_t s, coordination_type cn)
-        : initial(f, l, s, std::move(cn))
+    range(T f, T l, ptrdiff_t s, coordination_type cn, demand p = demand::unbounded())
+        : initial(f, l, s, std::move(cn), std::move(p))
     {
     }
+
+    /// the range of the count values after the first skip values of this
+    /// range, computed from the bounds without stepping through them.
+    template<class U = T>
+    auto sliced(size_t skip, size_t count) const
+        -> typename std::enable_if<std::is_integral<U>::value, range>::type {
+        typedef uintmax_t distance_type;
+        const auto max_distance = (std::numeric_limits<distance_type>::max)();
+        range result = *this;
+        auto& state = result.initial;
+        if (state.empty) {
+            return result;
+        }
+        // the values are first + i * step for i in [0, strides], and then
+        // last when it is not on a stride. the arithmetic is modular in
+        // distance_type so that it does not overflow T.
+        distance_type first = static_cast<distance_type>(state.next);
+        distance_type distance = state.next <= state.last ? static_cast<distance_type>(state.last) - first : first - static_cast<distance_type>(state.last);
+        distance_type stride = static_cast<distance_type>(state.step < 0 ? -state.step : state.step);
+        distance_type strides = distance / stride;
+        distance_type size = strides == max_distance ? max_distance : strides + 1;
+        if (distance % stride != 0 && size != max_distance) {
+            ++size;
+        }
+        if (skip >= size || count == 0) {
+            state.empty = true;
+            return result;
+        }
+        auto at = [&](distance_type i) -> T {
+            return i <= strides ? static_cast<T>(first + i * static_cast<distance_type>(state.step)) : state.last;
+        };
+        distance_type taken = (std::min<distance_type>)(count, size - skip);
+        state.next = at(skip);
+        state.last = at(skip + taken - 1);
+        return result;
+    }
+
+    // values sent by one call to on_next_range
+    enum { batch_size = 64 };
+
+    // sends one batch, returns true when the range is done
+    template<class Subscriber>
+    static bool send_values(const range_state_type& state, const Subscriber& dest, std::true_type) {
+        T values[batch_size];
+        size_t count = 0;
+        bool done = false;
+        while (!done && count < batch_size) {
+            values[count++] = state.next;
+            if (std::abs(state.last - state.next) < std::abs(state.step)) {
+                if (state.last == state.next) {
+                    done = true;
+                } else if (count < batch_size) {
+                    values[count++] = state.last;
+                    done = true;
+                } else {
+                    // last starts the next batch
+                    state.next = state.last;
+                }
+            } else {
+                state.next = static_cast<T>(state.step + state.next);
+            }
+        }
+        dest.on_next_range(values, count);
+        if (done && dest.is_subscribed()) {
+            dest.on_completed();
+        }
+        return done;
+    }
+    // an observer that accepts on_next_range is sent the values in batches,
+    // one batch per scheduled action, when no demand limits the producer.
+    template<class Subscriber>
+    static void send_batch(const range_state_type& state, const Subscriber& dest, const rxsc::schedulable& self, std::true_type) {
+        if (send_values(state, dest, std::true_type()) || !dest.is_subscribed()) {
+            // terminate loop
+            return;
+        }
+        // tail recurse this same action to continue loop
+        self();
+    }
+    template<class Subscriber>
+    static void send_batch(const range_state_type&, const Subscriber&, const rxsc::schedulable&, std::false_type) {
+    }
+
+    // the immediate and current_thread schedulers run the producer on the
+    // thread that subscribed, so while nothing else is queued on the current
+    // thread the producer can send in a plain loop instead of recursing
+    // through the scheduler for each value. the values are sent in the same
+    // order as through the scheduler. the loop checks for an unsubscribe once
+    // every batch_size values.
+    static bool is_trampoline(const identity_one_worker& cn) {
+        return cn.get_scheduler() == rxsc::make_current_thread() || cn.get_scheduler() == rxsc::make_immediate();
+    }
+    static bool is_trampoline(const identity_typed_current_thread_worker&) {
+        return true;
+    }
+    static bool is_trampoline(const identity_typed_immediate_worker&) {
+        return true;
+    }
+    template<class OtherCoordination>
+    static bool is_trampoline(const OtherCoordination&) {
+        return false;
+    }
+    static bool is_queued() {
+        return rxsc::detail::action_queue::owned() && !rxsc::detail::action_queue::empty();
+    }
+    template<class Subscriber>
+    static void send_loop(const range_state_type& state, const Subscriber& dest, const rxsc::schedulable& self, std::true_type) {
+        while (!send_values(state, dest, std::true_type())) {
+            if (!dest.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+            if (is_queued()) {
+                // tail recurse this same action after the queued actions
+                self();
+                return;
+            }
+        }
+    }
+    template<class Subscriber>
+    static void send_loop(const range_state_type& state, const Subscriber& dest, const rxsc::schedulable& self, std::false_type) {
+        for (int count = 1;; ++count) {
+            dest.on_next(state.next);
+            if (std::abs(state.last - state.next) < std::abs(state.step)) {
+                if (state.last != state.next) {
+                    dest.on_next(state.last);
+                }
+                dest.on_completed();
+                // o is unsubscribed
+                return;
+            }
+            state.next = static_cast<T>(state.step + state.next);
+            if (count == batch_size) {
+                if (!dest.is_subscribed()) {
+                    // terminate loop
+                    return;
+                }
+                count = 0;
+            }
+            if (is_queued()) {
+                // tail recurse this same action after the queued actions
+                self();
+                return;
+            }
+        }
+    }
+
     template<class Subscriber>
     void on_subscribe(Subscriber o) const {
         static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
@@ -49,6 +201,10 @@ struct range : public source_base<T>
 
         auto state = initial;
 
+        typedef std::integral_constant<bool, rxcpp::detail::is_range_subscriber<T, Subscriber>::value> batched;
+
+        auto loop = state.pull.is_unbounded() && is_trampoline(state.coordination);
+
         auto producer = [=](const rxsc::schedulable& self){
                 auto& dest = o;
                 if (!dest.is_subscribed()) {
@@ -56,6 +212,29 @@ struct range : public source_base<T>
                     return;
                 }
 
+                if (state.empty) {
+                    dest.on_completed();
+                    return;
+                }
+
+                if (loop) {
+                    send_loop(state, dest, self, batched());
+                    return;
+                }
+
+                if (batched::value && state.pull.is_unbounded()) {
+                    send_batch(state, dest, self, batched());
+                    return;
+                }
+
+                if (!state.pull.take()) {
+                    // wait for the next request
+                    auto resume = self;
+                    if (!state.pull.take_or_resume([resume](){resume.schedule();})) {
+                        return;
+                    }
+                }
+
                 // send next value
                 dest.on_next(state.next);
                 if (!dest.is_subscribed()) {
@@ -65,6 +244,12 @@ struct range : public source_base<T>
 
                 if (std::abs(state.last - state.next) < std::abs(state.step)) {
                     if (state.last != state.next) {
+                        if (!state.pull.is_unbounded()) {
+                            // last needs its own request
+                            state.next = state.last;
+                            self();
+                            return;
+                        }
                         dest.on_next(state.last);
                     }
                     dest.on_completed();
@@ -102,6 +287,13 @@ auto range(T first, T last, ptrdiff_t step, Coordination cn)
     return  observable<T,   detail::range<T, Coordination>>(
                             detail::range<T, Coordination>(first, last, step, std::move(cn)));
 }
+/// values are only sent as they are requested from pull
+template<class T, class Coordination>
+auto range(T first, T last, ptrdiff_t step, Coordination cn, demand pull)
+    ->      observable<T,   detail::range<T, Coordination>> {
+    return  observable<T,   detail::range<T, Coordination>>(
+                            detail::range<T, Coordination>(first, last, step, std::move(cn), std::move(pull)));
+}
 template<class T, class Coordination>
 auto range(T first, T last, Coordination cn)
     -> typename std::enable_if<is_coordination<Coordination>::value,
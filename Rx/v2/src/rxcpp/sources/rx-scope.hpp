@@ -89,6 +89,210 @@ struct scope : public source_base<rxu::value_type_t<scope_traits<ResourceFactory
     }
 };
 
+template<class T>
+struct resource_pool_state
+{
+    struct waiter;
+    typedef std::list<std::shared_ptr<waiter>> waiters_type;
+    struct waiter
+    {
+        explicit waiter(std::function<void(T)> g)
+            : grant(std::move(g))
+            , queued(false)
+        {
+        }
+        std::function<void(T)> grant;
+        bool queued;
+        typename waiters_type::iterator position;
+    };
+
+    resource_pool_state(size_t c, std::function<T()> f)
+        : capacity(c)
+        , created(0)
+        , factory(std::move(f))
+    {
+    }
+
+    std::mutex lock;
+    size_t capacity;
+    size_t created;
+    std::function<T()> factory;
+    std::vector<T> idle;
+    waiters_type waiting;
+};
+
+}
+
+/// a bounded set of resources that are leased by scope_pooled. a resource is
+/// created the first time that no idle one is left, until there are capacity
+/// of them, and then kept for the next lease. copies of the pool and copies
+/// of a resource refer to the same thing, as with a shared_ptr to a connection.
+template<class T>
+class resource_pool
+{
+    typedef detail::resource_pool_state<T> state_type;
+    std::shared_ptr<state_type> state;
+
+public:
+    typedef T value_type;
+
+    resource_pool(size_t capacity, std::function<T()> factory)
+        : state(std::make_shared<state_type>(capacity, std::move(factory)))
+    {
+    }
+
+    size_t idle_count() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->idle.size();
+    }
+    size_t created_count() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->created;
+    }
+    size_t waiting_count() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->waiting.size();
+    }
+
+    /// grant is called with a resource now, or later on the thread that
+    /// releases one when all of them are leased. the wait ends without a call
+    /// when lifetime is unsubscribed first. an exception from the factory is
+    /// thrown from lease.
+    void lease(const composite_subscription& lifetime, std::function<void(T)> grant) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (!state->idle.empty()) {
+            T r = std::move(state->idle.back());
+            state->idle.pop_back();
+            guard.unlock();
+            grant(std::move(r));
+            return;
+        }
+        if (state->created < state->capacity) {
+            ++state->created;
+            guard.unlock();
+            rxu::maybe<T> r;
+            try {
+                r.reset(state->factory());
+            } catch(...) {
+                std::unique_lock<std::mutex> failed(state->lock);
+                --state->created;
+                throw;
+            }
+            grant(std::move(r.get()));
+            return;
+        }
+        auto w = std::make_shared<typename state_type::waiter>(std::move(grant));
+        w->position = state->waiting.insert(state->waiting.end(), w);
+        w->queued = true;
+        guard.unlock();
+
+        auto st = state;
+        lifetime.add([st, w](){
+            std::unique_lock<std::mutex> guard(st->lock);
+            if (w->queued) {
+                w->queued = false;
+                st->waiting.erase(w->position);
+            }
+        });
+    }
+
+    /// gives r to the first waiting lease, or keeps it for the next one
+    void release(T r) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->waiting.empty()) {
+            state->idle.push_back(std::move(r));
+            return;
+        }
+        auto w = std::move(state->waiting.front());
+        state->waiting.pop_front();
+        w->queued = false;
+        guard.unlock();
+        w->grant(std::move(r));
+    }
+};
+
+namespace detail {
+
+template<class T, class ObservableFactory>
+struct scope_pooled_traits
+{
+    typedef rxu::decay_t<ObservableFactory> observable_factory_type;
+    typedef decltype((*(observable_factory_type*)nullptr)(std::declval<T>())) collection_type;
+    typedef typename collection_type::value_type value_type;
+};
+
+template<class T, class ObservableFactory>
+struct scope_pooled : public source_base<rxu::value_type_t<scope_pooled_traits<T, ObservableFactory>>>
+{
+    typedef scope_pooled_traits<T, ObservableFactory> traits;
+    typedef typename traits::observable_factory_type observable_factory_type;
+    typedef typename traits::value_type value_type;
+    typedef resource_pool<T> pool_type;
+
+    struct values
+    {
+        values(pool_type p, observable_factory_type of)
+            : pool(std::move(p))
+            , observable_factory(std::move(of))
+        {
+        }
+        pool_type pool;
+        observable_factory_type observable_factory;
+    };
+    values initial;
+
+    scope_pooled(pool_type p, observable_factory_type of)
+        : initial(std::move(p), std::move(of))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+
+        struct state_type
+            : public std::enable_shared_from_this<state_type>
+            , public values
+        {
+            state_type(values i, Subscriber o)
+                : values(i)
+                , out(std::move(o))
+            {
+            }
+            Subscriber out;
+        };
+
+        auto state = std::make_shared<state_type>(state_type(initial, std::move(o)));
+
+        auto grant = [state](T r) {
+            // returned to the pool when the subscription ends, at once when
+            // it ended while the lease was granted
+            auto pool = state->pool;
+            state->out.add([pool, r](){
+                pool.release(r);
+            });
+            if (!state->out.is_subscribed()) {
+                return;
+            }
+
+            auto selectedCollection = on_exception(
+                [&](){return state->observable_factory(std::move(r)); },
+                state->out);
+            if (selectedCollection.empty()) {
+                return;
+            }
+
+            selectedCollection->subscribe(state->out);
+        };
+
+        on_exception(
+            [&](){
+                state->pool.lease(state->out.get_subscription(), std::move(grant));
+                return true;
+            },
+            state->out);
+    }
+};
+
 }
 
 template<class ResourceFactory, class ObservableFactory>
@@ -98,6 +302,17 @@ auto scope(ResourceFactory rf, ObservableFactory of)
                                                                                                     detail::scope<ResourceFactory, ObservableFactory>(std::move(rf), std::move(of)));
 }
 
+/// like scope, but the resource is leased from pool and returned to it when
+/// the subscription ends, instead of being made and disposed of for each
+/// subscription. a subscription waits while every resource is leased and
+/// is subscribed on the thread that returns one.
+template<class T, class ObservableFactory>
+auto scope_pooled(resource_pool<T> pool, ObservableFactory of)
+    ->      observable<rxu::value_type_t<detail::scope_pooled_traits<T, ObservableFactory>>, detail::scope_pooled<T, ObservableFactory>> {
+    return  observable<rxu::value_type_t<detail::scope_pooled_traits<T, ObservableFactory>>, detail::scope_pooled<T, ObservableFactory>>(
+                                                                                             detail::scope_pooled<T, ObservableFactory>(std::move(pool), std::move(of)));
+}
+
 }
 
 }
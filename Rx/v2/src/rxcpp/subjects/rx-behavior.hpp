@@ -19,33 +19,57 @@ class behavior_observer : public detail::multicast_observer<T>
     typedef behavior_observer<T> this_type;
     typedef detail::multicast_observer<T> base_type;
 
-    class behavior_observer_state : public std::enable_shared_from_this<behavior_observer_state>
+    // a scalar no wider than a pointer is held in a std::atomic, so
+    // get_value and on_next do not take a mutex for it. any other type is
+    // copied under a mutex, since a copy of it that overlaps a write is a
+    // data race.
+    template<class V, bool IsScalar = std::is_scalar<V>::value && sizeof(V) <= sizeof(void*)>
+    class behavior_observer_state : public std::enable_shared_from_this<behavior_observer_state<V, IsScalar>>
     {
-        mutable std::mutex lock;
-        mutable T value;
+        mutable std::atomic<V> value;
 
     public:
-        behavior_observer_state(T first)
+        explicit behavior_observer_state(V first)
             : value(first)
         {
         }
 
-        void reset(T v) const {
+        void reset(V v) const {
+            value.store(v, std::memory_order_release);
+        }
+        V get() const {
+            return value.load(std::memory_order_acquire);
+        }
+    };
+
+    template<class V>
+    class behavior_observer_state<V, false> : public std::enable_shared_from_this<behavior_observer_state<V, false>>
+    {
+        mutable std::mutex lock;
+        mutable V value;
+
+    public:
+        explicit behavior_observer_state(V first)
+            : value(std::move(first))
+        {
+        }
+
+        void reset(V v) const {
             std::unique_lock<std::mutex> guard(lock);
             value = std::move(v);
         }
-        T get() const {
+        V get() const {
             std::unique_lock<std::mutex> guard(lock);
             return value;
         }
     };
 
-    std::shared_ptr<behavior_observer_state> state;
+    std::shared_ptr<behavior_observer_state<T>> state;
 
 public:
     behavior_observer(T f, composite_subscription l)
         : base_type(l)
-        , state(std::make_shared<behavior_observer_state>(std::move(f)))
+        , state(std::make_shared<behavior_observer_state<T>>(std::move(f)))
     {
     }
 
@@ -0,0 +1,334 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_GRAPH_HPP)
+#define RXCPP_RX_GRAPH_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+struct graph_vertex
+{
+    explicit graph_vertex(int r)
+        : rank(r)
+        , dirty(false)
+    {
+    }
+    virtual ~graph_vertex()
+    {
+    }
+
+    // call with the lock of the graph held. true when the value changed.
+    virtual bool recompute() = 0;
+    // call without the lock, sends the value from the last recompute
+    virtual void emit() = 0;
+
+    // a source has rank 0, any other vertex is ranked after all its inputs
+    int rank;
+    bool dirty;
+    std::vector<graph_vertex*> dependents;
+};
+
+struct graph_rank_after
+{
+    bool operator()(const graph_vertex* lhs, const graph_vertex* rhs) const {
+        return lhs->rank > rhs->rank;
+    }
+};
+
+struct graph_state
+{
+    graph_state()
+        : depth(0)
+        , draining(false)
+    {
+    }
+
+    std::mutex lock;
+    // owns every vertex, the vertices point at each other without owning
+    std::vector<std::shared_ptr<graph_vertex>> vertices;
+    std::priority_queue<graph_vertex*, std::vector<graph_vertex*>, graph_rank_after> dirty;
+    // the batches that are open
+    int depth;
+    bool draining;
+
+    // call with the lock held
+    void mark(graph_vertex* v) {
+        if (!v->dirty) {
+            v->dirty = true;
+            dirty.push(v);
+        }
+    }
+
+    // each set marks its source, the thread that finds no drain running
+    // becomes the drain. the vertices are recomputed in the order of their
+    // rank, so each vertex is recomputed at most once for each round and only
+    // after all its inputs, and an observer never sees a mix of old and new
+    // inputs. a set from an observer is run in the next round.
+    void drain(std::unique_lock<std::mutex>& guard) {
+        if (draining || depth > 0) {
+            return;
+        }
+        draining = true;
+        RXCPP_UNWIND_AUTO([&](){draining = false;});
+        std::vector<graph_vertex*> changed;
+        while (!dirty.empty() && depth == 0) {
+            while (!dirty.empty()) {
+                auto v = dirty.top();
+                dirty.pop();
+                v->dirty = false;
+                if (v->recompute()) {
+                    changed.push_back(v);
+                    for (auto d : v->dependents) {
+                        mark(d);
+                    }
+                }
+            }
+            guard.unlock();
+            {
+                RXCPP_UNWIND_AUTO([&](){guard.lock();});
+                for (auto v : changed) {
+                    v->emit();
+                }
+            }
+            changed.clear();
+        }
+    }
+};
+
+template<class T>
+struct graph_value : public graph_vertex
+{
+    graph_value(int r, T first)
+        : graph_vertex(r)
+        , value(first)
+        , out(std::move(first))
+    {
+    }
+
+    virtual void emit() {
+        if (!!error) {
+            out.get_subscriber().on_error(error);
+        } else if (!next.empty()) {
+            T v = std::move(next.get());
+            next.reset();
+            out.get_subscriber().on_next(std::move(v));
+        }
+    }
+
+    // the value of the last recompute, used by the dependents
+    T value;
+    rxu::maybe<T> next;
+    std::exception_ptr error;
+    behavior<T> out;
+};
+
+template<class T>
+struct graph_source_value : public graph_value<T>
+{
+    explicit graph_source_value(T first)
+        : graph_value<T>(0, std::move(first))
+    {
+    }
+
+    virtual bool recompute() {
+        if (this->pending.empty()) {
+            return false;
+        }
+        T v = std::move(this->pending.get());
+        this->pending.reset();
+        if (v == this->value) {
+            return false;
+        }
+        this->value = v;
+        this->next.reset(std::move(v));
+        return true;
+    }
+
+    // the last set since the last recompute
+    rxu::maybe<T> pending;
+};
+
+template<class T, class Selector, class... ValueN>
+struct graph_derived_value : public graph_value<T>
+{
+    typedef rxu::decay_t<Selector> selector_type;
+    typedef std::tuple<std::shared_ptr<graph_value<ValueN>>...> inputs_type;
+
+    graph_derived_value(int r, T first, selector_type s, inputs_type i)
+        : graph_value<T>(r, std::move(first))
+        , selector(std::move(s))
+        , inputs(std::move(i))
+    {
+    }
+
+    template<int... IndexN>
+    T select(rxu::values<int, IndexN...>) {
+        return selector(std::get<IndexN>(inputs)->value...);
+    }
+
+    virtual bool recompute() {
+        if (!!this->error) {
+            return false;
+        }
+        try {
+            T v = select(typename rxu::values_from<int, sizeof...(ValueN)>::type());
+            if (v == this->value) {
+                return false;
+            }
+            this->value = v;
+            this->next.reset(std::move(v));
+        } catch(...) {
+            this->error = std::current_exception();
+        }
+        return true;
+    }
+
+    selector_type selector;
+    inputs_type inputs;
+};
+
+}
+
+/// a vertex of a graph. get_observable() emits the current value to each new
+/// subscriber and then each change. all the subscribers share the vertex, so
+/// the value is computed once however many subscribe.
+template<class T>
+class graph_node
+{
+protected:
+    typedef detail::graph_value<T> vertex_type;
+
+    std::shared_ptr<detail::graph_state> state;
+    std::shared_ptr<vertex_type> vertex;
+
+    graph_node(std::shared_ptr<detail::graph_state> st, std::shared_ptr<vertex_type> v)
+        : state(std::move(st))
+        , vertex(std::move(v))
+    {
+    }
+
+    friend class graph;
+
+public:
+    typedef T value_type;
+
+    /// the value that was emitted last
+    T get_value() const {
+        return vertex->out.get_value();
+    }
+
+    observable<T> get_observable() const {
+        return vertex->out.get_observable();
+    }
+};
+
+/// a vertex of a graph that is changed by set()
+template<class T>
+class graph_source : public graph_node<T>
+{
+    typedef detail::graph_source_value<T> source_vertex_type;
+
+    graph_source(std::shared_ptr<detail::graph_state> st, std::shared_ptr<source_vertex_type> v)
+        : graph_node<T>(std::move(st), v)
+        , source(std::move(v))
+    {
+    }
+
+    std::shared_ptr<source_vertex_type> source;
+
+    friend class graph;
+
+public:
+    /// the vertices that depend on this one are recomputed when v is not
+    /// equal to the value
+    void set(T v) const {
+        std::unique_lock<std::mutex> guard(this->state->lock);
+        source->pending.reset(std::move(v));
+        this->state->mark(source.get());
+        this->state->drain(guard);
+    }
+};
+
+/// a graph of values, some set directly and the others computed from them,
+/// like the cells of a spreadsheet. a vertex is only recomputed when one of
+/// its inputs has changed, and only emits when its own value has changed, so
+/// the values must be equality comparable. a change is sent through the graph
+/// in the order of the dependencies, each observer sees each change once and
+/// only after all the vertices that it depends on have taken it in.
+///
+/// unlike a chain of combine_latest, subscribing to a vertex subscribes to
+/// nothing upstream, so shared parts of the graph need no publish.
+class graph
+{
+    std::shared_ptr<detail::graph_state> state;
+
+public:
+    graph()
+        : state(std::make_shared<detail::graph_state>())
+    {
+    }
+
+    /// a vertex that starts with first and changes with set()
+    template<class T>
+    graph_source<rxu::decay_t<T>> source(T first) const {
+        typedef rxu::decay_t<T> value_type;
+        auto v = std::make_shared<detail::graph_source_value<value_type>>(std::move(first));
+        std::unique_lock<std::mutex> guard(state->lock);
+        state->vertices.push_back(v);
+        return graph_source<value_type>(state, std::move(v));
+    }
+
+    /// a vertex that holds the result of s called with the values of the
+    /// inputs. an exception thrown by s is sent to its observers as an error,
+    /// after which the vertex does not change.
+    template<class Selector, class... NodeN>
+    auto derive(Selector s, const NodeN&... in) const
+        -> graph_node<rxu::decay_t<decltype(s(std::declval<typename NodeN::value_type>()...))>> {
+        typedef rxu::decay_t<decltype(s(std::declval<typename NodeN::value_type>()...))> value_type;
+        typedef detail::graph_derived_value<value_type, Selector, typename NodeN::value_type...> vertex_type;
+
+        std::unique_lock<std::mutex> guard(state->lock);
+        // the leading entry allows a vertex without inputs
+        int ranks[] = {0, (in.vertex->rank + 1)...};
+        detail::graph_vertex* inputs[] = {nullptr, in.vertex.get()...};
+        int rank = *std::max_element(std::begin(ranks), std::end(ranks));
+        auto first = s(in.vertex->value...);
+        auto v = std::make_shared<vertex_type>(rank, std::move(first), std::move(s), typename vertex_type::inputs_type(in.vertex...));
+        for (auto input : inputs) {
+            if (!!input) {
+                input->dependents.push_back(v.get());
+            }
+        }
+        state->vertices.push_back(v);
+        return graph_node<value_type>(state, std::move(v));
+    }
+
+    /// the sets in f are sent through the graph together when f returns, so
+    /// a vertex that depends on several of them is recomputed once
+    template<class F>
+    void batch(F f) const {
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            ++state->depth;
+        }
+        RXCPP_UNWIND_AUTO([&](){
+            std::unique_lock<std::mutex> guard(state->lock);
+            --state->depth;
+            state->drain(guard);
+        });
+        f();
+    }
+};
+
+}
+
+}
+
+#endif
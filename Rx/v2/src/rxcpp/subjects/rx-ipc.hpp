@@ -0,0 +1,567 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_IPC_HPP)
+#define RXCPP_RX_IPC_HPP
+
+// this subject uses the os to share memory between processes, so it is not
+// included by rx.hpp. include "rxcpp/subjects/rx-ipc.hpp" to use it.
+
+#include "../rx-includes.hpp"
+
+#if defined(_WIN32)
+#error "ipc_subject needs posix shared memory"
+#endif
+
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+namespace rxcpp {
+
+namespace subjects {
+
+struct ipc_error : public std::runtime_error
+{
+    explicit ipc_error(const std::string& what)
+        : std::runtime_error(what)
+    {
+    }
+};
+
+/// the serializer of ipc_subject for a trivially copyable T
+template<class T>
+struct ipc_copy : public rxu::bitwise_serializer<T>
+{
+};
+
+namespace detail {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "ipc_subject needs lock free atomics to share them between processes");
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "ipc_subject waits on the address of an atomic");
+
+// the position of one side in the ring. seq is bumped after index moves and
+// is the word that the other side waits on. waiting is set while the other
+// side waits, so that a move only wakes it when it sleeps.
+struct ipc_cursor
+{
+    enum attach_type {
+        never = 0,
+        attached_now,
+        // unsubscribed, another subscriber can attach
+        closed
+    };
+
+    std::atomic<std::uint64_t> index;
+    std::atomic<std::uint32_t> seq;
+    std::atomic<std::uint32_t> waiting;
+    std::atomic<std::uint32_t> attached;
+    // the process of the side that attached
+    std::atomic<std::uint32_t> process;
+    // each cursor has a cache line of its own
+    char pad[64 - sizeof(std::uint64_t) - 4 * sizeof(std::uint32_t)];
+};
+
+struct ipc_end
+{
+    enum type {
+        open = 0,
+        completed,
+        errored
+    };
+};
+
+// the start of the shared memory. the slots follow it.
+struct ipc_header
+{
+    enum { magic_value = 0x52786970 };
+    enum { error_size = 256 };
+
+    std::atomic<std::uint32_t> magic;
+    std::atomic<std::uint32_t> end;
+    std::uint64_t capacity;
+    std::uint64_t slot_size;
+    std::uint64_t stride;
+    char pad[64 - 2 * sizeof(std::uint32_t) - 3 * sizeof(std::uint64_t)];
+    // advanced by the process that sends
+    ipc_cursor writer;
+    // advanced by the process that receives
+    ipc_cursor reader;
+    char error[error_size];
+};
+
+#if defined(__linux__)
+inline void ipc_wait(std::atomic<std::uint32_t>& word, std::uint32_t seen) {
+    // the timeout lets the waiter see an unsubscribe
+    struct timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50 * 1000 * 1000;
+    // not FUTEX_PRIVATE_FLAG, the word is shared with another process
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+}
+inline void ipc_wake(std::atomic<std::uint32_t>& word) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#else
+// without a futex the waiter polls
+inline void ipc_wait(std::atomic<std::uint32_t>& word, std::uint32_t seen) {
+    if (word.load() == seen) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+inline void ipc_wake(std::atomic<std::uint32_t>&) {
+}
+#endif
+
+// waits until ready returns true and returns true, or returns false when
+// stop returns true first. the other side bumps the seq of c after it moves.
+// stop is checked after each timed wait.
+template<class Ready, class Stop>
+bool ipc_wait_for(ipc_cursor& c, Ready ready, Stop stop) {
+    while (!ready()) {
+        if (stop()) {
+            return false;
+        }
+        auto seen = c.seq.load();
+        c.waiting.store(1);
+        if (!ready()) {
+            ipc_wait(c.seq, seen);
+        }
+        c.waiting.store(0);
+    }
+    return true;
+}
+
+// true when the side of c that attached has unsubscribed or its process
+// has exited without detaching
+inline bool ipc_detached(const ipc_cursor& c) {
+    auto attached = c.attached.load(std::memory_order_acquire);
+    if (attached == ipc_cursor::closed) {
+        return true;
+    }
+    if (attached != ipc_cursor::attached_now) {
+        // nothing attached yet, the values wait for it
+        return false;
+    }
+    auto process = static_cast<pid_t>(c.process.load(std::memory_order_relaxed));
+    return process != 0 && ::kill(process, 0) != 0 && errno == ESRCH;
+}
+inline void ipc_moved(ipc_cursor& c) {
+    c.seq.fetch_add(1);
+    if (c.waiting.load()) {
+        ipc_wake(c.seq);
+    }
+}
+
+// the shared memory mapped into this process. the process that created it
+// removes its name when it is unmapped.
+class ipc_region
+{
+    std::string name;
+    bool owner;
+    size_t length;
+    char* first;
+
+    ipc_region(const ipc_region&);
+    ipc_region& operator=(const ipc_region&);
+
+    static std::system_error error(const std::string& what, const std::string& name) {
+        return std::system_error(errno, std::generic_category(), "ipc_subject: " + what + " " + name);
+    }
+    static std::string shm_name(std::string n) {
+        return (!n.empty() && n[0] == '/') ? n : "/" + n;
+    }
+    static size_t header_size() {
+        return (sizeof(ipc_header) + 63) & ~size_t(63);
+    }
+
+    void map(int fd) {
+        auto p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        // the mapping does not need the descriptor
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw error("map", name);
+        }
+        first = static_cast<char*>(p);
+    }
+
+public:
+    // creates the memory for capacity slots of slot_size bytes
+    ipc_region(std::string n, size_t capacity, size_t slot_size)
+        : name(shm_name(std::move(n)))
+        , owner(true)
+        , length(0)
+        , first(nullptr)
+    {
+        size_t slots = 1;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        auto stride = (sizeof(std::uint32_t) + slot_size + 7) & ~size_t(7);
+        length = header_size() + slots * stride;
+
+        // a region left behind by a process that did not exit cleanly
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            throw error("create", name);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            auto e = error("size", name);
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw e;
+        }
+        try {
+            map(fd);
+        } catch(...) {
+            ::shm_unlink(name.c_str());
+            throw;
+        }
+        // the new memory is zeroed, which is the state of the cursors
+        auto h = header();
+        h->capacity = slots;
+        h->slot_size = slot_size;
+        h->stride = stride;
+        h->magic.store(ipc_header::magic_value, std::memory_order_release);
+    }
+    // opens the memory that another process created
+    explicit ipc_region(std::string n)
+        : name(shm_name(std::move(n)))
+        , owner(false)
+        , length(0)
+        , first(nullptr)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw error("open", name);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            auto e = error("size", name);
+            ::close(fd);
+            throw e;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length < header_size()) {
+            ::close(fd);
+            throw ipc_error("ipc_subject: not ready " + name);
+        }
+        map(fd);
+        if (header()->magic.load(std::memory_order_acquire) != ipc_header::magic_value) {
+            ::munmap(first, length);
+            throw ipc_error("ipc_subject: not ready " + name);
+        }
+    }
+    ~ipc_region()
+    {
+        if (first) {
+            ::munmap(first, length);
+        }
+        if (owner) {
+            ::shm_unlink(name.c_str());
+        }
+    }
+
+    ipc_header* header() const {
+        return reinterpret_cast<ipc_header*>(first);
+    }
+    // the length of the value followed by its bytes
+    char* slot(std::uint64_t index) const {
+        auto h = header();
+        return first + header_size() + (index & (h->capacity - 1)) * h->stride;
+    }
+};
+
+template<class T, class Serializer>
+class ipc_observer
+    : public observer_base<T>
+{
+    struct state_type
+    {
+        state_type(std::shared_ptr<ipc_region> r, Serializer s, composite_subscription cs)
+            : region(std::move(r))
+            , serializer(std::move(s))
+            , lifetime(std::move(cs))
+            , ended(false)
+        {
+        }
+        std::shared_ptr<ipc_region> region;
+        Serializer serializer;
+        // the subscription of the sender, a wait for room ends with it
+        composite_subscription lifetime;
+        // on_next is not called after on_error or on_completed, but the
+        // value that did not fit ends the stream from inside on_next
+        bool ended;
+    };
+    std::shared_ptr<state_type> state;
+
+    void end(ipc_end::type how, const std::string& what) const {
+        auto h = state->region->header();
+        auto length = (std::min)(what.size(), size_t(ipc_header::error_size - 1));
+        std::memcpy(h->error, what.data(), length);
+        h->error[length] = '\0';
+        state->ended = true;
+        h->end.store(how, std::memory_order_release);
+        ipc_moved(h->writer);
+    }
+
+public:
+    ipc_observer(std::shared_ptr<ipc_region> r, Serializer s, composite_subscription cs)
+        : state(std::make_shared<state_type>(std::move(r), std::move(s), std::move(cs)))
+    {
+    }
+
+    /// blocks while the ring is full. the wait ends without sending when
+    /// the sender is unsubscribed, and with an ipc_error when the receiver
+    /// has unsubscribed or its process has exited.
+    void on_next(const T& v) const {
+        if (state->ended) {
+            return;
+        }
+        auto h = state->region->header();
+        auto head = h->writer.index.load(std::memory_order_relaxed);
+        auto& lifetime = state->lifetime;
+        bool gone = false;
+        auto room = ipc_wait_for(h->reader,
+            [&](){
+                return head - h->reader.index.load(std::memory_order_acquire) < h->capacity;
+            },
+            [&](){
+                gone = ipc_detached(h->reader);
+                return gone || !lifetime.is_subscribed();
+            });
+        if (!room) {
+            if (gone) {
+                throw ipc_error("ipc_subject: the receiver has gone");
+            }
+            return;
+        }
+        auto slot = state->region->slot(head);
+        auto length = state->serializer.write(v, slot + sizeof(std::uint32_t), static_cast<size_t>(h->slot_size));
+        if (length > h->slot_size) {
+            end(ipc_end::errored, "ipc_subject: the value does not fit in a slot");
+            return;
+        }
+        auto stored = static_cast<std::uint32_t>(length);
+        std::memcpy(slot, &stored, sizeof(stored));
+        h->writer.index.store(head + 1, std::memory_order_release);
+        ipc_moved(h->writer);
+    }
+    void on_error(std::exception_ptr e) const {
+        if (state->ended) {
+            return;
+        }
+        std::string what;
+        try {
+            std::rethrow_exception(e);
+        } catch(const std::exception& ex) {
+            what = ex.what();
+        } catch(...) {
+            what = "ipc_subject: unknown error";
+        }
+        end(ipc_end::errored, what);
+    }
+    void on_completed() const {
+        if (state->ended) {
+            return;
+        }
+        end(ipc_end::completed, std::string());
+    }
+};
+
+template<class T, class Serializer, class Coordination>
+struct ipc_source : public rxs::source_base<T>
+{
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    std::shared_ptr<ipc_region> region;
+    Serializer serializer;
+    coordination_type coordination;
+
+    ipc_source(std::shared_ptr<ipc_region> r, Serializer s, coordination_type cn)
+        : region(std::move(r))
+        , serializer(std::move(s))
+        , coordination(std::move(cn))
+    {
+    }
+
+    // values sent by one scheduled action
+    enum { batch_size = 64 };
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct ipc_state_type
+        {
+            ipc_state_type(std::shared_ptr<ipc_region> r, Serializer s, output_type o)
+                : region(std::move(r))
+                , serializer(std::move(s))
+                , out(std::move(o))
+            {
+            }
+            std::shared_ptr<ipc_region> region;
+            Serializer serializer;
+            output_type out;
+        };
+
+        auto h = region->header();
+        std::uint32_t detached = ipc_cursor::never;
+        if (!h->reader.attached.compare_exchange_strong(detached, ipc_cursor::attached_now) &&
+            (detached != ipc_cursor::closed || !h->reader.attached.compare_exchange_strong(detached, ipc_cursor::attached_now))) {
+            o.on_error(std::make_exception_ptr(ipc_error("ipc_subject supports one subscriber")));
+            return;
+        }
+        h->reader.process.store(static_cast<std::uint32_t>(::getpid()), std::memory_order_relaxed);
+        auto r = region;
+        o.add([r](){
+            auto rh = r->header();
+            rh->reader.process.store(0, std::memory_order_relaxed);
+            rh->reader.attached.store(ipc_cursor::closed, std::memory_order_release);
+            // a sender waiting for room sees the close
+            ipc_moved(rh->reader);
+        });
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        auto state = std::make_shared<ipc_state_type>(region, serializer, coordinator.out(o));
+
+        auto receiver = [state](const rxsc::schedulable& self){
+            auto& out = state->out;
+            auto h = state->region->header();
+            for (int count = 0; count < batch_size; ++count) {
+                if (!out.is_subscribed()) {
+                    // terminate loop
+                    return;
+                }
+                auto tail = h->reader.index.load(std::memory_order_relaxed);
+                if (h->writer.index.load(std::memory_order_acquire) == tail) {
+                    // the end is stored after the last value
+                    auto how = h->end.load(std::memory_order_acquire);
+                    if (how != ipc_end::open && h->writer.index.load(std::memory_order_acquire) == tail) {
+                        if (how == ipc_end::completed) {
+                            out.on_completed();
+                        } else {
+                            out.on_error(std::make_exception_ptr(ipc_error(std::string(h->error))));
+                        }
+                        // o is unsubscribed
+                        return;
+                    }
+                    if (count == 0) {
+                        auto seen = h->writer.seq.load();
+                        h->writer.waiting.store(1);
+                        if (h->writer.index.load() == tail && h->end.load() == ipc_end::open) {
+                            ipc_wait(h->writer.seq, seen);
+                        }
+                        h->writer.waiting.store(0);
+                    }
+                    break;
+                }
+                auto slot = state->region->slot(tail);
+                std::uint32_t length = 0;
+                std::memcpy(&length, slot, sizeof(length));
+                auto value = on_exception(
+                    [&](){return state->serializer.read(slot + sizeof(length), length);},
+                    out);
+                // the slot can be reused once the value is read out of it
+                h->reader.index.store(tail + 1, std::memory_order_release);
+                ipc_moved(h->reader);
+                if (value.empty()) {
+                    return;
+                }
+                out.on_next(std::move(value.get()));
+            }
+            // tail recurse this same action so that other actions can run
+            // and an unsubscribe is seen between batches
+            self();
+        };
+
+        auto selectedReceiver = on_exception(
+            [&](){return coordinator.act(receiver);},
+            o);
+        if (selectedReceiver.empty()) {
+            return;
+        }
+
+        controller.schedule(selectedReceiver.get());
+    }
+};
+
+}
+
+/// ipc_subject sends values from one process to another on the same host
+/// through a ring of slots in shared memory. the sending process creates it
+/// and sends to get_subscriber(), the receiving process opens it by name and
+/// subscribes to get_observable(). there is one sender and one subscriber.
+///
+/// T is copied into the slots when it is trivially copyable, otherwise a
+/// Serializer writes it. a full ring blocks the sender and an empty ring
+/// blocks the thread that receives, both on a futex where linux has one.
+/// on_error sends only the what() of the exception, as an ipc_error.
+template<class T, class Serializer = ipc_copy<T>>
+class ipc_subject
+{
+    typedef detail::ipc_observer<T, Serializer> observer_type;
+
+    std::shared_ptr<detail::ipc_region> region;
+    Serializer serializer;
+
+    ipc_subject(std::shared_ptr<detail::ipc_region> r, Serializer s)
+        : region(std::move(r))
+        , serializer(std::move(s))
+    {
+    }
+
+public:
+    typedef observable<T> observable_type;
+
+    /// creates the ring named name with room for capacity values of up to
+    /// slot_size bytes. the name is removed when the last copy is released.
+    static ipc_subject create(std::string name, size_t capacity, size_t slot_size = sizeof(T), Serializer s = Serializer()) {
+        return ipc_subject(std::make_shared<detail::ipc_region>(std::move(name), capacity, slot_size), std::move(s));
+    }
+    /// opens the ring that another process created
+    static ipc_subject open(std::string name, Serializer s = Serializer()) {
+        return ipc_subject(std::make_shared<detail::ipc_region>(std::move(name)), std::move(s));
+    }
+
+    subscriber<T, observer<T, observer_type>> get_subscriber() const {
+        composite_subscription cs;
+        return make_subscriber<T>(cs, observer<T, observer_type>(observer_type(region, serializer, cs)));
+    }
+
+    /// the values are received on a new thread
+    observable<T> get_observable() const {
+        return get_observable(identity_one_worker(rxsc::make_new_thread()));
+    }
+    /// the values are received on a worker of the coordination, which is
+    /// blocked while the ring is empty
+    template<class Coordination>
+    observable<T> get_observable(Coordination cn) const {
+        typedef detail::ipc_source<T, Serializer, Coordination> source_type;
+        return observable<T, source_type>(source_type(region, serializer, std::move(cn))).as_dynamic();
+    }
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,295 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_PARALLEL_SUBJECT_HPP)
+#define RXCPP_RX_PARALLEL_SUBJECT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+// counts the notifications that have been sent to lanes and not yet
+// delivered so that a caller can wait until every lane has caught up.
+struct parallel_barrier
+{
+    parallel_barrier()
+        : pending(0)
+        , running(0)
+        , stopped(false)
+    {
+    }
+
+    void add(size_t n) {
+        std::unique_lock<std::mutex> guard(lock);
+        pending += n;
+    }
+    void remove(size_t n) {
+        std::unique_lock<std::mutex> guard(lock);
+        pending -= n;
+        if (pending == 0) {
+            idle.notify_all();
+        }
+    }
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        idle.wait(guard, [this](){
+            return pending == 0 || stopped;
+        });
+    }
+    // the lanes will not deliver any more
+    void stop() {
+        std::unique_lock<std::mutex> guard(lock);
+        stopped = true;
+        idle.notify_all();
+    }
+
+    std::mutex lock;
+    std::condition_variable idle;
+    size_t pending;
+    // lanes that have not delivered on_error or on_completed
+    std::atomic<size_t> running;
+    bool stopped;
+};
+
+template<class T, class Coordination>
+class parallel_observer
+    : public observer_base<T>
+{
+    typedef parallel_observer<T, Coordination> this_type;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    typedef rxn::notification_value<T> notification_type;
+    typedef std::deque<notification_type> queue_type;
+
+    // each lane owns a share of the observers and a worker that delivers
+    // to them, in order, the notifications queued for the lane.
+    struct lane_state : public std::enable_shared_from_this<lane_state>
+    {
+        lane_state(coordinator_type coor, composite_subscription cs, std::shared_ptr<parallel_barrier> b)
+            : observers(composite_subscription())
+            , processing(false)
+            , coordinator(std::move(coor))
+            , lifetime(std::move(cs))
+            , barrier(std::move(b))
+        {
+        }
+
+        void push(notification_type n) const {
+            std::unique_lock<std::mutex> guard(lock);
+            queue.push_back(std::move(n));
+            if (processing) {
+                return;
+            }
+            processing = true;
+            guard.unlock();
+
+            auto keepAlive = this->shared_from_this();
+            auto drain_queue = [keepAlive, this](const rxsc::schedulable& self){
+                queue_type batch;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (queue.empty()) {
+                        processing = false;
+                        return;
+                    }
+                    swap(batch, queue);
+                }
+                auto count = batch.size();
+                RXCPP_UNWIND_AUTO([&](){
+                    barrier->remove(count);
+                });
+                auto input = observers.get_subscriber();
+                for (auto& n : batch) {
+                    auto last = !n.is_on_next();
+                    n.deliver(input);
+                    if (last) {
+                        // the last lane to finish releases the workers
+                        if (--barrier->running == 0) {
+                            lifetime.unsubscribe();
+                        }
+                        return;
+                    }
+                }
+                self();
+            };
+
+            auto processor = coordinator.get_worker();
+            processor.schedule(coordinator.act(drain_queue));
+        }
+
+        multicast_observer<T> observers;
+        mutable std::mutex lock;
+        mutable queue_type queue;
+        mutable bool processing;
+        coordinator_type coordinator;
+        composite_subscription lifetime;
+        std::shared_ptr<parallel_barrier> barrier;
+    };
+    typedef std::shared_ptr<lane_state> lane_ptr;
+
+    struct parallel_state
+    {
+        explicit parallel_state(composite_subscription cs)
+            : lifetime(std::move(cs))
+            , input(composite_subscription())
+            , barrier(std::make_shared<parallel_barrier>())
+            , next(0)
+            , stopped(false)
+        {
+        }
+        // the lanes and their workers
+        composite_subscription lifetime;
+        // the subscriber returned by get_subscriber. it ends when on_error or
+        // on_completed is called, the lanes end after they have delivered it.
+        composite_subscription input;
+        std::shared_ptr<parallel_barrier> barrier;
+        std::vector<lane_ptr> lanes;
+        mutable std::atomic<size_t> next;
+        // set by the first on_error or on_completed
+        mutable std::atomic<bool> stopped;
+    };
+
+    std::shared_ptr<parallel_state> state;
+
+    void push(const T& v) const {
+        state->barrier->add(state->lanes.size());
+        for (auto& l : state->lanes) {
+            l->push(notification_type::on_next(v));
+        }
+    }
+    void push(notification_type n) const {
+        state->barrier->add(state->lanes.size());
+        for (auto& l : state->lanes) {
+            l->push(n);
+        }
+    }
+
+public:
+    parallel_observer(coordination_type cn, composite_subscription cs, size_t count)
+        : state(std::make_shared<parallel_state>(std::move(cs)))
+    {
+        auto barrier = state->barrier;
+        state->lifetime.add([barrier](){
+            barrier->stop();
+        });
+        state->lifetime.add(state->input);
+        count = (std::max)(count, size_t(1));
+        state->barrier->running = count;
+        while (count--) {
+            // every lane has its own worker, whose lifetime is the subject
+            auto coordinator = cn.create_coordinator(state->lifetime);
+            state->lanes.push_back(std::make_shared<lane_state>(std::move(coordinator), state->lifetime, state->barrier));
+        }
+    }
+
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+    composite_subscription get_input_subscription() const {
+        return state->input;
+    }
+
+    size_t lane_count() const {
+        return state->lanes.size();
+    }
+
+    bool has_observers() const {
+        for (auto& l : state->lanes) {
+            if (l->observers.has_observers()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// observers are assigned to the lanes in turn
+    void add(subscriber<T> o) const {
+        auto& l = state->lanes[state->next++ % state->lanes.size()];
+        l->observers.add(l->observers.get_subscriber(), std::move(o));
+    }
+
+    void wait() const {
+        state->barrier->wait();
+    }
+
+    template<class V>
+    void on_next(V v) const {
+        if (!state->stopped && state->lifetime.is_subscribed()) {
+            push(v);
+        }
+    }
+    void on_error(std::exception_ptr e) const {
+        if (!state->stopped.exchange(true) && state->lifetime.is_subscribed()) {
+            push(notification_type::on_error(e));
+        }
+    }
+    void on_completed() const {
+        if (!state->stopped.exchange(true) && state->lifetime.is_subscribed()) {
+            push(notification_type::on_completed());
+        }
+    }
+};
+
+}
+
+/// a subject that splits its observers between a number of lanes. each lane
+/// delivers on its own worker from the coordination, so one on_next reaches
+/// the observers of different lanes in parallel. each observer still sees
+/// the notifications in order. wait() blocks until every notification sent
+/// so far has been delivered.
+template<class T, class Coordination>
+class parallel_subject
+{
+    typedef detail::parallel_observer<T, Coordination> observer_type;
+    observer_type s;
+
+public:
+    typedef subscriber<T, observer<T, observer_type>> subscriber_type;
+    typedef observable<T> observable_type;
+
+    parallel_subject(Coordination cn, size_t lanes, composite_subscription cs = composite_subscription())
+        : s(std::move(cn), std::move(cs), lanes)
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    size_t lane_count() const {
+        return s.lane_count();
+    }
+
+    void wait() const {
+        s.wait();
+    }
+
+    subscriber_type get_subscriber() const {
+        return make_subscriber<T>(s.get_input_subscription(), observer<T, observer_type>(s));
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(std::move(o));
+        });
+    }
+};
+
+template<class T, class Coordination>
+parallel_subject<T, Coordination> make_parallel_subject(Coordination cn, size_t lanes = std::max(std::thread::hardware_concurrency(), unsigned(2))) {
+    return parallel_subject<T, Coordination>(std::move(cn), lanes);
+}
+
+}
+
+}
+
+#endif
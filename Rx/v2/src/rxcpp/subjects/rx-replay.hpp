@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_REPLAY_HPP)
+#define RXCPP_RX_REPLAY_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+// ring of the most recent values and the time each was sent. a bounded ring
+// is allocated once, an unbounded ring doubles when it is full.
+template<class T, class TimePoint>
+class replay_buffer
+{
+    struct entry
+    {
+        entry(TimePoint when, T value)
+            : when(when)
+            , value(std::move(value))
+        {
+        }
+        TimePoint when;
+        T value;
+    };
+
+    std::vector<rxu::maybe<entry>> ring;
+    size_t limit;
+    size_t first;
+    size_t count;
+
+    rxu::maybe<entry>& at(size_t i) {
+        return ring[(first + i) % ring.size()];
+    }
+
+    void grow() {
+        std::vector<rxu::maybe<entry>> next((std::max)(size_t(16), ring.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            next[i].reset(std::move(at(i).get()));
+        }
+        swap(ring, next);
+        first = 0;
+    }
+
+public:
+    /// limit 0 keeps every value
+    explicit replay_buffer(size_t limit)
+        : ring(limit)
+        , limit(limit)
+        , first(0)
+        , count(0)
+    {
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    void push(TimePoint when, T value) {
+        if (limit != 0 && count == limit) {
+            pop();
+        } else if (count == ring.size()) {
+            grow();
+        }
+        at(count).reset(entry(when, std::move(value)));
+        ++count;
+    }
+
+    void pop() {
+        at(0).reset();
+        first = (first + 1) % ring.size();
+        --count;
+    }
+
+    /// drop the values sent before the given time
+    void expire(TimePoint before) {
+        while (count > 0 && at(0)->when < before) {
+            pop();
+        }
+    }
+
+    template<class F>
+    void for_each(F f) {
+        for (size_t i = 0; i < count; ++i) {
+            f(at(i)->value);
+        }
+    }
+};
+
+template<class T, class Coordination>
+class replay_observer : public detail::multicast_observer<T>
+{
+    typedef replay_observer<T, Coordination> this_type;
+    typedef detail::multicast_observer<T> base_type;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+    typedef replay_buffer<T, clock_type::time_point> buffer_type;
+
+    struct replay_observer_state : public std::enable_shared_from_this<replay_observer_state>
+    {
+        replay_observer_state(size_t count, rxu::maybe<clock_type::duration> period, coordination_type cn)
+            : buffer(count)
+            , period(period)
+            , coordination(std::move(cn))
+        {
+        }
+
+        void expire() const {
+            if (!period.empty()) {
+                buffer.expire(coordination.now() - period.get());
+            }
+        }
+
+        // on_next and subscribe both hold the lock while they deliver so that
+        // a new subscriber sees every value exactly once, first from the
+        // buffer and then live. the lock is recursive so that an observer can
+        // subscribe from inside on_next.
+        mutable std::recursive_mutex lock;
+        mutable buffer_type buffer;
+        rxu::maybe<clock_type::duration> period;
+        coordination_type coordination;
+    };
+
+    std::shared_ptr<replay_observer_state> state;
+
+public:
+    replay_observer(size_t count, rxu::maybe<clock_type::duration> period, coordination_type cn, composite_subscription cs)
+        : base_type(cs)
+        , state(std::make_shared<replay_observer_state>(count, period, std::move(cn)))
+    {
+    }
+
+    subscriber<T> get_subscriber() const {
+        return make_subscriber<T>(this->get_id(), this->get_subscription(), observer<T, detail::replay_observer<T, Coordination>>(*this)).as_dynamic();
+    }
+
+    std::vector<T> get_values() const {
+        std::vector<T> result;
+        std::unique_lock<std::recursive_mutex> guard(state->lock);
+        state->expire();
+        result.reserve(state->buffer.size());
+        state->buffer.for_each([&](const T& v){
+            result.push_back(v);
+        });
+        return result;
+    }
+
+    void replay_and_add(subscriber<T> o) const {
+        std::unique_lock<std::recursive_mutex> guard(state->lock);
+        state->expire();
+        state->buffer.for_each([&](const T& v){
+            if (o.is_subscribed()) {
+                o.on_next(v);
+            }
+        });
+        this->add(get_subscriber(), std::move(o));
+    }
+
+    template<class V>
+    void on_next(V v) const {
+        std::unique_lock<std::recursive_mutex> guard(state->lock);
+        state->buffer.push(state->coordination.now(), v);
+        state->expire();
+        base_type::on_next(std::move(v));
+    }
+    void on_error(std::exception_ptr e) const {
+        std::unique_lock<std::recursive_mutex> guard(state->lock);
+        base_type::on_error(e);
+    }
+    void on_completed() const {
+        std::unique_lock<std::recursive_mutex> guard(state->lock);
+        base_type::on_completed();
+    }
+};
+
+}
+
+/// a subject that keeps the most recent values and sends them to each new
+/// subscriber before the live values. the values can be bounded by count,
+/// by age or by both. the age of a value is measured with the clock of the
+/// coordination.
+template<class T, class Coordination>
+class replay
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+    typedef detail::replay_observer<T, Coordination> observer_type;
+    observer_type s;
+
+public:
+    typedef subscriber<T> subscriber_type;
+    typedef observable<T> observable_type;
+
+    /// keep the last count values
+    replay(size_t count, Coordination cn, composite_subscription cs = composite_subscription())
+        : s(count, rxu::maybe<clock_type::duration>(), std::move(cn), cs)
+    {
+    }
+
+    /// keep the values sent during the last period
+    replay(clock_type::duration period, Coordination cn, composite_subscription cs = composite_subscription())
+        : s(0, rxu::maybe<clock_type::duration>(period), std::move(cn), cs)
+    {
+    }
+
+    /// keep at most count values sent during the last period
+    replay(size_t count, clock_type::duration period, Coordination cn, composite_subscription cs = composite_subscription())
+        : s(count, rxu::maybe<clock_type::duration>(period), std::move(cn), cs)
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    /// the values that a new subscriber would be sent
+    std::vector<T> get_values() const {
+        return s.get_values();
+    }
+
+    subscriber_type get_subscriber() const {
+        return s.get_subscriber();
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.replay_and_add(std::move(o));
+        });
+    }
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,381 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_RING_HPP)
+#define RXCPP_RX_RING_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+template<class T, class Coordination>
+class ring_observer
+    : public observer_base<T>
+{
+    typedef ring_observer<T, Coordination> this_type;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    typedef unsigned long long sequence_type;
+
+    // a reader reschedules itself after this many values so that it does
+    // not hold its worker for as long as the producer keeps up
+    enum { slice_length = 1024 };
+
+    // one subscriber. cursor is the sequence of the next value that it reads,
+    // every slot before it may be written again.
+    struct reader_state
+    {
+        reader_state(coordinator_type coor, subscriber<T> d)
+            : coordinator(std::move(coor))
+            , destination(std::move(d))
+            , cursor(0)
+            , scheduled(false)
+            , done(false)
+        {
+        }
+
+        coordinator_type coordinator;
+        subscriber<T> destination;
+        rxu::detail::cache_line_pad read_pad;
+
+        // written by the reader, read by the producer
+        std::atomic<sequence_type> cursor;
+        // set while a drain is scheduled or running
+        std::atomic<bool> scheduled;
+        std::atomic<bool> done;
+        rxu::detail::cache_line_pad cursor_pad;
+    };
+    typedef std::shared_ptr<reader_state> reader_ptr;
+
+    struct ring_state : public std::enable_shared_from_this<ring_state>
+    {
+        ring_state(coordination_type cn, size_t capacity, composite_subscription cs)
+            : coordination(std::move(cn))
+            , lifetime(std::move(cs))
+            , input(composite_subscription())
+            , slots(round_up(capacity))
+            , mask(slots.size() - 1)
+            , stopped(false)
+            , generation(0)
+            , observers(0)
+            , published(0)
+            , finished(false)
+            , seen_generation(0)
+            , gate(0)
+        {
+        }
+
+        static size_t round_up(size_t capacity) {
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        // set at construction and then only read
+        coordination_type coordination;
+        // the readers
+        composite_subscription lifetime;
+        // the subscriber returned by get_subscriber. it ends when on_error or
+        // on_completed is called, the readers end after they have read it.
+        composite_subscription input;
+        std::vector<rxu::detail::maybe<T>> slots;
+        sequence_type mask;
+        rxu::detail::cache_line_pad read_pad;
+
+        // the subscribers that the producer has not taken yet and the end of
+        // the stream for those that subscribe after it
+        std::mutex lock;
+        std::vector<reader_ptr> pending;
+        bool stopped;
+        std::exception_ptr error;
+        std::atomic<int> generation;
+        std::atomic<size_t> observers;
+        rxu::detail::cache_line_pad pending_pad;
+
+        // written by the producer, read by the readers
+        std::atomic<sequence_type> published;
+        std::atomic<bool> finished;
+        rxu::detail::cache_line_pad published_pad;
+
+        // only used by the producer
+        std::vector<reader_ptr> readers;
+        int seen_generation;
+        // no reader is behind this sequence
+        sequence_type gate;
+
+        // call with the lock held. a new reader starts at the next value
+        void take_pending() {
+            seen_generation = generation;
+            auto next = published.load(std::memory_order_relaxed);
+            for (auto& r : pending) {
+                r->cursor = next;
+                readers.push_back(std::move(r));
+            }
+            pending.clear();
+        }
+
+        void take_pending_if_changed() {
+            if (generation.load(std::memory_order_acquire) != seen_generation) {
+                std::unique_lock<std::mutex> guard(lock);
+                take_pending();
+            }
+        }
+
+        // moves the gate up to the slowest reader and forgets the readers
+        // that have unsubscribed
+        void close_gate(sequence_type next) {
+            gate = next;
+            auto last = std::remove_if(readers.begin(), readers.end(), [](const reader_ptr& r){
+                return r->done.load();
+            });
+            readers.erase(last, readers.end());
+            for (auto& r : readers) {
+                gate = (std::min)(gate, r->cursor.load(std::memory_order_acquire));
+            }
+        }
+
+        // waits until the slot of next has been read by every reader
+        bool claim(sequence_type next) {
+            if (next - gate < slots.size()) {
+                return true;
+            }
+            for (;;) {
+                close_gate(next);
+                if (next - gate < slots.size()) {
+                    return true;
+                }
+                if (!lifetime.is_subscribed()) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        void wake() {
+            for (auto& r : readers) {
+                if (r->done || r->scheduled.load()) {
+                    continue;
+                }
+                if (!r->scheduled.exchange(true)) {
+                    schedule(r);
+                }
+            }
+        }
+
+        void schedule(const reader_ptr& r) {
+            auto keepAlive = this->shared_from_this();
+            r->coordinator.get_worker().schedule(r->coordinator.act(
+                [keepAlive, r](const rxsc::schedulable& self){
+                    keepAlive->drain(r, self);
+                }));
+        }
+
+        // call on the worker of the reader
+        void drain(const reader_ptr& r, const rxsc::schedulable& self) {
+            auto& dest = r->destination;
+            auto next = r->cursor.load(std::memory_order_relaxed);
+            size_t count = 0;
+            for (;;) {
+                auto available = published.load(std::memory_order_acquire);
+                while (next != available) {
+                    if (!dest.is_subscribed()) {
+                        return;
+                    }
+                    try {
+                        dest.on_next(slots[next & mask].get());
+                    } catch(...) {
+                        dest.on_error(std::current_exception());
+                        return;
+                    }
+                    r->cursor.store(++next, std::memory_order_release);
+                    if (++count == slice_length) {
+                        self();
+                        return;
+                    }
+                }
+                if (finished.load(std::memory_order_acquire)) {
+                    if (published.load(std::memory_order_acquire) != next) {
+                        continue;
+                    }
+                    if (error) {
+                        dest.on_error(error);
+                    } else {
+                        dest.on_completed();
+                    }
+                    return;
+                }
+                // the producer checks scheduled after it publishes, so one
+                // of the two sees the value of the other
+                r->scheduled = false;
+                if (published.load() == next && !finished.load()) {
+                    return;
+                }
+                if (r->scheduled.exchange(true)) {
+                    return;
+                }
+            }
+        }
+
+        void stop(std::exception_ptr e) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                take_pending();
+                stopped = true;
+                error = e;
+            }
+            finished = true;
+            wake();
+            readers.clear();
+        }
+    };
+
+    std::shared_ptr<ring_state> state;
+
+public:
+    ring_observer(coordination_type cn, composite_subscription cs, size_t capacity)
+        : state(std::make_shared<ring_state>(std::move(cn), (std::max)(capacity, size_t(1)), std::move(cs)))
+    {
+        state->lifetime.add(state->input);
+    }
+
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+    composite_subscription get_input_subscription() const {
+        return state->input;
+    }
+
+    size_t capacity() const {
+        return state->slots.size();
+    }
+
+    bool has_observers() const {
+        return state->observers != 0;
+    }
+
+    void add(subscriber<T> o) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->stopped) {
+            auto e = state->error;
+            guard.unlock();
+            if (e) {
+                o.on_error(e);
+            } else {
+                o.on_completed();
+            }
+            return;
+        }
+        if (!state->lifetime.is_subscribed()) {
+            guard.unlock();
+            o.unsubscribe();
+            return;
+        }
+        auto coordinator = state->coordination.create_coordinator(o.get_subscription());
+        auto r = std::make_shared<reader_state>(std::move(coordinator), o);
+
+        auto lifetime = state->lifetime;
+        auto token = lifetime.add(o.get_subscription());
+        std::weak_ptr<reader_state> weak = r;
+        auto localState = state;
+        o.add([lifetime, token, weak, localState](){
+            lifetime.remove(token);
+            auto r = weak.lock();
+            if (r && !r->done.exchange(true)) {
+                --localState->observers;
+            }
+        });
+
+        ++state->observers;
+        state->pending.push_back(std::move(r));
+        ++state->generation;
+    }
+
+    template<class V>
+    void on_next(V v) const {
+        auto& s = *state;
+        if (s.finished.load(std::memory_order_relaxed)) {
+            return;
+        }
+        s.take_pending_if_changed();
+        if (s.readers.empty()) {
+            return;
+        }
+        auto next = s.published.load(std::memory_order_relaxed);
+        if (!s.claim(next)) {
+            return;
+        }
+        s.slots[next & s.mask].reset(std::move(v));
+        s.published = next + 1;
+        s.wake();
+    }
+    void on_error(std::exception_ptr e) const {
+        if (!state->finished.load(std::memory_order_relaxed)) {
+            state->stop(e);
+        }
+    }
+    void on_completed() const {
+        if (!state->finished.load(std::memory_order_relaxed)) {
+            state->stop(std::exception_ptr());
+        }
+    }
+};
+
+}
+
+/// a subject that writes each value once into a ring of capacity slots,
+/// rounded up to a power of two. each observer reads the ring on its own
+/// worker from the coordination with a cursor of its own, so a slow observer
+/// does not delay the others until it is capacity values behind. then the
+/// caller of on_next waits for it.
+///
+/// on_next must not be called on a worker that an observer reads on, or it
+/// can wait for itself.
+template<class T, class Coordination>
+class ring_subject
+{
+    typedef detail::ring_observer<T, Coordination> observer_type;
+    observer_type s;
+
+public:
+    typedef subscriber<T, observer<T, observer_type>> subscriber_type;
+    typedef observable<T> observable_type;
+
+    ring_subject(Coordination cn, size_t capacity, composite_subscription cs = composite_subscription())
+        : s(std::move(cn), std::move(cs), capacity)
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    size_t capacity() const {
+        return s.capacity();
+    }
+
+    subscriber_type get_subscriber() const {
+        return make_subscriber<T>(s.get_input_subscription(), observer<T, observer_type>(s));
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(std::move(o));
+        });
+    }
+};
+
+}
+
+}
+
+#endif
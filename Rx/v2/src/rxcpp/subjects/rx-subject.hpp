@@ -40,35 +40,91 @@ class multicast_observer
             , lifetime(cs)
         {
         }
+        // read by each on_next, written when the observers change
         std::atomic<int> generation;
+        rxu::detail::cache_line_pad generation_pad;
         std::mutex lock;
         typename mode::type current;
         std::exception_ptr error;
         composite_subscription lifetime;
     };
 
+    // the observers are held in chunks that are shared between one
+    // completer and the next. adding an observer copies the chunk pointers
+    // and only the observers of the last chunk, and removes the unsubscribed
+    // observers from one more chunk, so subscribing costs O(n / chunk_size
+    // + chunk_size) instead of O(n). a chunk is freed when the last
+    // completer that refers to it is released, which on_next does only after
+    // it has finished using it.
     struct completer_type
         : public std::enable_shared_from_this<completer_type>
     {
+        enum { chunk_size = 64 };
+        typedef std::shared_ptr<const list_type> chunk_type;
+
         ~completer_type()
         {
         }
         completer_type(std::shared_ptr<state_type> s, const std::shared_ptr<completer_type>& old, observer_type o)
             : state(s)
+            , sweep(0)
         {
             if (old) {
-                observers.reserve(old->observers.size() + 1);
-                std::copy_if(
-                    old->observers.begin(), old->observers.end(),
-                    std::inserter(observers, observers.end()),
-                    [](const observer_type& o){
-                        return o.is_subscribed();
-                    });
+                chunks = old->chunks;
+                sweep = old->sweep;
+            }
+            if (chunks.size() > 1) {
+                sweep %= chunks.size() - 1;
+                auto live = subscribed(*chunks[sweep]);
+                if (live.empty()) {
+                    chunks.erase(chunks.begin() + sweep);
+                } else {
+                    if (live.size() != chunks[sweep]->size()) {
+                        chunks[sweep] = std::make_shared<const list_type>(std::move(live));
+                    }
+                    ++sweep;
+                }
+            }
+            if (chunks.empty() || chunks.back()->size() >= chunk_size) {
+                chunks.push_back(std::make_shared<const list_type>(1, o));
+            } else {
+                auto last = subscribed(*chunks.back());
+                last.push_back(o);
+                chunks.back() = std::make_shared<const list_type>(std::move(last));
+            }
+        }
+
+        static list_type subscribed(const list_type& from) {
+            list_type result;
+            result.reserve(from.size() + 1);
+            std::copy_if(
+                from.begin(), from.end(),
+                std::inserter(result, result.end()),
+                [](const observer_type& o){
+                    return o.is_subscribed();
+                });
+            return result;
+        }
+
+        bool empty() const {
+            return chunks.empty();
+        }
+
+        template<class F>
+        void for_each(F f) const {
+            for (auto& c : chunks) {
+                for (auto& o : *c) {
+                    if (o.is_subscribed()) {
+                        f(o);
+                    }
+                }
             }
-            observers.push_back(o);
         }
+
         std::shared_ptr<state_type> state;
-        list_type observers;
+        std::vector<chunk_type> chunks;
+        // the next chunk to remove unsubscribed observers from
+        size_t sweep;
     };
 
     // this type prevents a circular ref between state and completer
@@ -90,6 +146,10 @@ class multicast_observer
         mutable int current_generation;
         mutable std::shared_ptr<completer_type> current_completer;
 
+        // subscribers write this from other threads, so it does not share a
+        // cache line with the members that on_next reads
+        rxu::detail::cache_line_pad completer_pad;
+
         // must only be accessed under state->lock
         mutable std::shared_ptr<completer_type> completer;
     };
@@ -114,7 +174,7 @@ public:
     }
     bool has_observers() const {
         std::unique_lock<std::mutex> guard(b->state->lock);
-        return b->current_completer && !b->current_completer->observers.empty();
+        return b->current_completer && !b->current_completer->empty();
     }
     template<class SubscriberFrom>
     void add(const SubscriberFrom& sf, observer_type o) const {
@@ -155,14 +215,12 @@ public:
             b->current_generation = b->state->generation;
             b->current_completer = b->completer;
         }
-        if (!b->current_completer || b->current_completer->observers.empty()) {
+        if (!b->current_completer || b->current_completer->empty()) {
             return;
         }
-        for (auto& o : b->current_completer->observers) {
-            if (o.is_subscribed()) {
-                o.on_next(v);
-            }
-        }
+        b->current_completer->for_each([&](const observer_type& o){
+            o.on_next(v);
+        });
     }
     void on_error(std::exception_ptr e) const {
         std::unique_lock<std::mutex> guard(b->state->lock);
@@ -175,11 +233,9 @@ public:
             ++b->state->generation;
             guard.unlock();
             if (c) {
-                for (auto& o : c->observers) {
-                    if (o.is_subscribed()) {
-                        o.on_error(e);
-                    }
-                }
+                c->for_each([&](const observer_type& o){
+                    o.on_error(e);
+                });
             }
             s.unsubscribe();
         }
@@ -194,11 +250,9 @@ public:
             ++b->state->generation;
             guard.unlock();
             if (c) {
-                for (auto& o : c->observers) {
-                    if (o.is_subscribed()) {
-                        o.on_completed();
-                    }
-                }
+                c->for_each([](const observer_type& o){
+                    o.on_completed();
+                });
             }
             s.unsubscribe();
         }
@@ -158,8 +158,145 @@ public:
     }
 };
 
+// serializes calls from many threads without a worker. the caller that
+// finds no delivery in progress delivers directly and then delivers, on
+// behalf of the other callers, whatever they queued in the meantime. a call
+// is only queued when another thread is mid-delivery.
+template<class T>
+class combining_observer : public detail::multicast_observer<T>
+{
+    typedef combining_observer<T> this_type;
+    typedef detail::multicast_observer<T> base_type;
+
+    typedef rxn::notification_value<T> notification_type;
+    typedef rxu::maybe<notification_type> queue_item_type;
+
+    struct combining_observer_state
+    {
+        combining_observer_state()
+            : wip(0)
+        {
+        }
+
+        // the number of calls that have not been delivered. the caller that
+        // moves it from 0 delivers until it returns to 0.
+        std::atomic<size_t> wip;
+        rxsc::detail::mpsc_queue<queue_item_type> queue;
+    };
+
+    std::shared_ptr<combining_observer_state> state;
+
+    // a call that throws does not end the drain: the other calls are still
+    // made so that wip returns to 0, then the first exception is rethrown to
+    // the caller that was draining.
+    void drain(std::exception_ptr ex) const {
+        queue_item_type item;
+        size_t missed = 1;
+        for (;;) {
+            while (!state->queue.empty()) {
+                if (!state->queue.pop(item)) {
+                    // a producer is between claiming and linking its node
+                    std::this_thread::yield();
+                    continue;
+                }
+                try {
+                    item->deliver(*static_cast<const base_type*>(this));
+                } catch(...) {
+                    if (!ex) {
+                        ex = std::current_exception();
+                    }
+                }
+                item.reset();
+            }
+            missed = state->wip.fetch_sub(missed) - missed;
+            if (missed == 0) {
+                if (ex) {
+                    std::rethrow_exception(ex);
+                }
+                return;
+            }
+        }
+    }
+
+    template<class Direct, class Make>
+    void deliver(Direct direct, Make make) const {
+        size_t idle = 0;
+        if (state->wip.compare_exchange_strong(idle, 1)) {
+            std::exception_ptr ex;
+            try {
+                direct();
+            } catch(...) {
+                ex = std::current_exception();
+            }
+            drain(ex);
+            return;
+        }
+        state->queue.push(queue_item_type(make()));
+        if (state->wip++ == 0) {
+            drain(std::exception_ptr());
+        }
+    }
+
+public:
+    explicit combining_observer(composite_subscription cs)
+        : base_type(cs)
+        , state(std::make_shared<combining_observer_state>())
+    {
+    }
+
+    subscriber<T> get_subscriber() const {
+        return make_subscriber<T>(this->get_id(), this->get_subscription(), observer<T, detail::combining_observer<T>>(*this)).as_dynamic();
+    }
+
+    template<class V>
+    void on_next(V v) const {
+        deliver(
+            [&](){base_type::on_next(v);},
+            [&](){return notification_type::on_next(v);});
+    }
+    void on_error(std::exception_ptr e) const {
+        deliver(
+            [&](){base_type::on_error(e);},
+            [&](){return notification_type::on_error(e);});
+    }
+    void on_completed() const {
+        deliver(
+            [&](){base_type::on_completed();},
+            [&](){return notification_type::on_completed();});
+    }
+};
+
 }
 
+/// a synchronize subject that delivers on the calling thread. when there is
+/// no contention a value costs one compare and swap more than a subject.
+template<class T>
+class combining_synchronize
+{
+    detail::combining_observer<T> s;
+
+public:
+    explicit combining_synchronize(composite_subscription cs = composite_subscription())
+        : s(std::move(cs))
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    subscriber<T> get_subscriber() const {
+        return s.get_subscriber();
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(s.get_subscriber(), std::move(o));
+        });
+    }
+};
+
 template<class T, class Coordination>
 class synchronize
 {
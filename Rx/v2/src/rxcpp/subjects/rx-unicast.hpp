@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_UNICAST_HPP)
+#define RXCPP_RX_UNICAST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+struct unicast_subscribed_error : public std::runtime_error
+{
+    unicast_subscribed_error()
+        : std::runtime_error("unicast only supports one subscriber")
+    {
+    }
+};
+
+namespace detail {
+
+template<class T>
+class unicast_observer
+    : public observer_base<T>
+{
+    struct mode
+    {
+        enum type {
+            Invalid = 0,
+            Casting,
+            Completed,
+            Errored
+        };
+    };
+
+    // the subscriber is written once, before ready is set, and is never
+    // changed after that. so on_next only reads ready and does not lock.
+    struct state_type
+    {
+        state_type()
+            : ready(false)
+            , current(mode::Casting)
+        {
+        }
+        std::atomic<bool> ready;
+        rxu::detail::spin_lock lock;
+        typename mode::type current;
+        std::exception_ptr error;
+        rxu::maybe<subscriber<T>> o;
+    };
+
+    std::shared_ptr<state_type> state;
+
+public:
+    unicast_observer()
+        : state(std::make_shared<state_type>())
+    {
+    }
+
+    void add(subscriber<T> o) const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        if (!state->o.empty()) {
+            guard.unlock();
+            o.on_error(std::make_exception_ptr(unicast_subscribed_error()));
+            return;
+        }
+        switch (state->current) {
+        case mode::Casting:
+            {
+                state->o.reset(std::move(o));
+                state->ready.store(true, std::memory_order_release);
+            }
+            break;
+        case mode::Completed:
+            {
+                guard.unlock();
+                o.on_completed();
+            }
+            break;
+        case mode::Errored:
+            {
+                auto e = state->error;
+                guard.unlock();
+                o.on_error(e);
+            }
+            break;
+        default:
+            abort();
+        }
+    }
+    template<class V>
+    void on_next(V&& v) const {
+        if (state->ready.load(std::memory_order_acquire)) {
+            state->o->on_next(std::forward<V>(v));
+        }
+    }
+    void on_error(std::exception_ptr e) const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        if (state->current == mode::Casting) {
+            state->error = e;
+            state->current = mode::Errored;
+            auto ready = state->ready.load(std::memory_order_relaxed);
+            guard.unlock();
+            if (ready) {
+                state->o->on_error(e);
+            }
+        }
+    }
+    void on_completed() const {
+        std::unique_lock<rxu::detail::spin_lock> guard(state->lock);
+        if (state->current == mode::Casting) {
+            state->current = mode::Completed;
+            auto ready = state->ready.load(std::memory_order_relaxed);
+            guard.unlock();
+            if (ready) {
+                state->o->on_completed();
+            }
+        }
+    }
+};
+
+}
+
+/// passed to window, window_with_time and window_with_time_or_count to send
+/// each window through a unicast instead of a subject. each window then
+/// supports one subscriber.
+struct unicast_windows {};
+
+/// unicast is a subject for exactly one subscriber. it has no list of
+/// observers and no lifetime of its own, so it is much cheaper to create than
+/// subject. values that are sent before the subscriber arrives are dropped.
+/// a subscriber that arrives after the end is sent the end. any subscriber
+/// after the first is sent unicast_subscribed_error.
+template<class T>
+class unicast
+{
+    typedef detail::unicast_observer<T> observer_type;
+    observer_type s;
+
+public:
+    typedef observable<T> observable_type;
+
+    /// send the values straight to the subscriber
+    template<class V>
+    void on_next(V&& v) const {
+        s.on_next(std::forward<V>(v));
+    }
+    void on_error(std::exception_ptr e) const {
+        s.on_error(e);
+    }
+    void on_completed() const {
+        s.on_completed();
+    }
+
+    subscriber<T, observer<T, observer_type>> get_subscriber() const {
+        return make_subscriber<T>(observer<T, observer_type>(s));
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(std::move(o));
+        });
+    }
+};
+
+}
+
+}
+
+#endif
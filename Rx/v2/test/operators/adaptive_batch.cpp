@@ -0,0 +1,142 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("adaptive_batch grows while delivery is fast and shrinks when batches wait", "[adaptive_batch][buffer][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.next(250, 5),
+            on.next(260, 6),
+            on.next(270, 7),
+            on.next(280, 8),
+            on.next(290, 9),
+            on.next(300, 10),
+            on.next(400, 11),
+            on.completed(600)
+        });
+
+        WHEN("the ints are batched between 1 and 8 with a target of 100"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .adaptive_batch(1, 8, milliseconds(100), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the batches double while they fill and halve after each one that waited"){
+                auto required = rxu::to_vector({
+                    v_on.next(210, rxu::to_vector({ 1 })),
+                    v_on.next(230, rxu::to_vector({ 2, 3 })),
+                    v_on.next(270, rxu::to_vector({ 4, 5, 6, 7 })),
+                    v_on.next(380, rxu::to_vector({ 8, 9, 10 })),
+                    v_on.next(500, rxu::to_vector({ 11 })),
+                    v_on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("adaptive_batch sends the partial batch on completion", "[adaptive_batch][buffer][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.completed(240)
+        });
+
+        WHEN("the ints are batched between 2 and 4 with a target of 100"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .adaptive_batch(2, 4, milliseconds(100), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the full batch and then the rest"){
+                auto required = rxu::to_vector({
+                    v_on.next(220, rxu::to_vector({ 1, 2 })),
+                    v_on.next(240, rxu::to_vector({ 3 })),
+                    v_on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("adaptive_batch fed from a subject outside a trampoline", "[adaptive_batch][buffer][operators]"){
+    GIVEN("a subject batched on the current thread"){
+        rxcpp::subjects::subject<int> s;
+        std::vector<std::vector<int>> batches;
+        bool completed = false;
+
+        s.get_observable()
+            .adaptive_batch(2, 8, std::chrono::milliseconds(10))
+            .subscribe(
+                [&](const std::vector<int>& v){
+                    batches.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("the ints are sent from this thread"){
+            auto o = s.get_subscriber();
+            o.on_next(1);
+            o.on_next(2);
+            o.on_next(3);
+            o.on_completed();
+
+            THEN("each int expires in its own batch before the next is sent"){
+                REQUIRE(batches == rxu::to_vector({
+                    rxu::to_vector({ 1 }),
+                    rxu::to_vector({ 2 }),
+                    rxu::to_vector({ 3 })
+                }));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
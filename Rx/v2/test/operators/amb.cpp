@@ -0,0 +1,98 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("amb sends the items of the first source to send", "[amb][operators]"){
+    GIVEN("3 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs1 = sc.make_hot_observable({
+            on.next(250, 1),
+            on.completed(300)
+        });
+        auto xs2 = sc.make_hot_observable({
+            on.next(220, 2),
+            on.next(260, 3),
+            on.completed(350)
+        });
+        auto xs3 = sc.make_hot_observable({
+            on.next(230, 4),
+            on.completed(400)
+        });
+
+        WHEN("the first to send is taken"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs1
+                        .amb(xs2, xs3)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the items of the second source"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.next(260, 3),
+                    on.completed(350)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the other sources were unsubscribed when it sent"){
+                REQUIRE(xs1.subscriptions() == rxu::to_vector({on.subscribe(200, 220)}));
+                REQUIRE(xs2.subscriptions() == rxu::to_vector({on.subscribe(200, 350)}));
+                REQUIRE(xs3.subscriptions() == rxu::to_vector({on.subscribe(200, 220)}));
+            }
+        }
+    }
+}
+
+SCENARIO("amb sends the error of the first source", "[amb][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("amb on_error from source");
+
+        auto xs1 = sc.make_hot_observable({
+            on.next(250, 1),
+            on.completed(300)
+        });
+        auto xs2 = sc.make_hot_observable({
+            on.error(210, ex)
+        });
+
+        WHEN("the first to send is taken"){
+
+            auto res = w.start(
+                [&]() {
+                    return rx::observable<>::amb(rxu::to_vector({xs1.as_dynamic(), xs2.as_dynamic()}))
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the error"){
+                auto required = rxu::to_vector({
+                    on.error(210, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the other source was unsubscribed"){
+                REQUIRE(xs1.subscriptions() == rxu::to_vector({on.subscribe(200, 210)}));
+            }
+        }
+    }
+}
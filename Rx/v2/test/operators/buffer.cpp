@@ -735,6 +735,61 @@ SCENARIO("buffer with time, overlapping intervals", "[buffer_with_time][operator
     }
 }
 
+SCENARIO("buffer with time on many overlapping intervals", "[buffer_with_time][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(320, 5),
+            on.next(350, 6),
+            on.next(380, 7),
+            on.next(420, 8),
+            on.next(470, 9),
+            on.completed(600)
+        });
+        WHEN("a chunk opens every 35ms and is open for 100ms"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .buffer_with_time(milliseconds(100), milliseconds(35), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each value is in every chunk that was open when it arrived"){
+                auto required = rxu::to_vector({
+                    v_on.next(300, rxu::to_vector({ 2, 3, 4 })),
+                    v_on.next(335, rxu::to_vector({ 3, 4, 5 })),
+                    v_on.next(370, rxu::to_vector({ 4, 5, 6 })),
+                    v_on.next(405, rxu::to_vector({ 5, 6, 7 })),
+                    v_on.next(440, rxu::to_vector({ 6, 7, 8 })),
+                    v_on.next(475, rxu::to_vector({ 7, 8, 9 })),
+                    v_on.next(510, rxu::to_vector({ 8, 9 })),
+                    v_on.next(545, rxu::to_vector({ 9 })),
+                    v_on.next(580, std::vector<int>()),
+                    v_on.next(600, std::vector<int>()),
+                    v_on.next(600, std::vector<int>()),
+                    v_on.next(600, std::vector<int>()),
+                    v_on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
 SCENARIO("buffer with time, intervals with skips", "[buffer_with_time][operators]"){
     GIVEN("1 hot observable of ints."){
         auto sc = rxsc::make_test();
@@ -1179,3 +1234,300 @@ SCENARIO("buffer with time or count, only time triggered", "[buffer_with_time_or
         }
     }
 }
+
+SCENARIO("buffer count reuses recycled chunks", "[buffer][pool][operators]"){
+    GIVEN("a chunk pool"){
+        rx::chunk_pool<int> pool(4);
+
+        WHEN("each chunk is recycled after use"){
+            std::vector<std::vector<int>> results;
+            std::set<const int*> storage;
+
+            rx::observable<>::range(1, 7)
+                .buffer(2, 2, pool)
+                .subscribe(
+                    [&](std::vector<int> v){
+                        results.push_back(v);
+                        storage.insert(v.data());
+                        pool.recycle(std::move(v));
+                    });
+
+            THEN("the chunks have the expected values"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({1, 2}),
+                    rxu::to_vector({3, 4}),
+                    rxu::to_vector({5, 6}),
+                    rxu::to_vector({7})
+                });
+                REQUIRE(required == results);
+            }
+            THEN("every chunk used the same storage"){
+                REQUIRE(storage.size() == 1);
+                REQUIRE(pool.size() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer recycles the chunks it did not emit", "[buffer][pool][operators]"){
+    GIVEN("a chunk pool"){
+        rx::chunk_pool<int> pool(4);
+
+        WHEN("overlapping chunks are open when the consumer unsubscribes"){
+            std::vector<std::vector<int>> results;
+
+            rx::observable<>::range(1, 5)
+                .buffer(3, 1, pool)
+                .take(1)
+                .subscribe(
+                    [&](std::vector<int> v){
+                        results.push_back(v);
+                    });
+
+            THEN("the chunk was emitted and the open chunks went back to the pool"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({1, 2, 3})
+                });
+                REQUIRE(required == results);
+                REQUIRE(pool.size() == 2);
+            }
+        }
+        WHEN("the source fails while a chunk is open"){
+            int errors = 0;
+
+            rx::observable<>::range(1, 2)
+                .concat(rx::observable<>::error<int>(std::runtime_error("buffer on_error from source")))
+                .buffer(3, 3, pool)
+                .subscribe(
+                    [&](std::vector<int>){},
+                    [&](std::exception_ptr){
+                        ++errors;
+                    });
+
+            THEN("the open chunk went back to the pool"){
+                REQUIRE(errors == 1);
+                REQUIRE(pool.size() == 1);
+            }
+        }
+        WHEN("a chunk with a time limit is open when the consumer unsubscribes"){
+            std::vector<std::vector<int>> results;
+
+            rx::observable<>::range(1, 5)
+                .buffer_with_time_or_count(std::chrono::hours(1), 3, rx::identity_current_thread(), pool)
+                .take(1)
+                .subscribe(
+                    [&](std::vector<int> v){
+                        results.push_back(v);
+                    });
+
+            THEN("the chunk was emitted and the next chunk went back to the pool"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({1, 2, 3})
+                });
+                REQUIRE(required == results);
+                REQUIRE(pool.size() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("chunk pool limits the chunks it keeps", "[pool]"){
+    GIVEN("a pool that keeps one chunk"){
+        rx::chunk_pool<int> pool(1);
+
+        WHEN("two chunks are recycled"){
+            pool.recycle(std::vector<int>(4));
+            pool.recycle(std::vector<int>(8));
+
+            THEN("one is kept, empty and with its capacity"){
+                REQUIRE(pool.size() == 1);
+                auto chunk = pool.take();
+                REQUIRE(chunk.empty());
+                REQUIRE(chunk.capacity() >= 4);
+                REQUIRE(pool.size() == 0);
+            }
+        }
+    }
+    GIVEN("a default pool"){
+        rx::chunk_pool<int> pool;
+
+        WHEN("a chunk is recycled"){
+            pool.recycle(std::vector<int>(4));
+
+            THEN("nothing is kept"){
+                REQUIRE(pool.size() == 0);
+                REQUIRE(pool.take(3).capacity() >= 3);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer pool reuses released blocks", "[pool]"){
+    GIVEN("a pool that keeps one block"){
+        rx::buffer_pool pool(16, 1);
+
+        WHEN("a buffer is sliced and released"){
+            auto b = pool.take();
+            auto block = b.data();
+            std::memcpy(b.data(), "hello world", 11);
+            auto hello = b.sub(0, 5);
+            auto world = b.sub(6, 5);
+            b = rx::buffer();
+
+            THEN("the slices keep the block until they are gone"){
+                REQUIRE(hello == std::string("hello"));
+                REQUIRE(world == std::string("world"));
+                REQUIRE(pool.size() == 0);
+                hello = rx::slice();
+                REQUIRE(pool.size() == 0);
+                world = rx::slice();
+                REQUIRE(pool.size() == 1);
+                auto next = pool.take();
+                REQUIRE(next.data() == block);
+                REQUIRE(next.capacity() == 16);
+                REQUIRE(pool.size() == 0);
+            }
+        }
+        WHEN("two buffers are released"){
+            auto first = pool.take();
+            auto second = pool.take();
+            first = rx::buffer();
+            second = rx::buffer();
+
+            THEN("only one block is kept"){
+                REQUIRE(pool.size() == 1);
+            }
+        }
+    }
+}
+
+namespace {
+// counts the copies that were made of the value
+struct copy_counter
+{
+    copy_counter() : count(0) {}
+    copy_counter(const copy_counter& o) : count(o.count + 1) {}
+    copy_counter(copy_counter&& o) : count(o.count) {}
+    copy_counter& operator=(const copy_counter& o) {count = o.count + 1; return *this;}
+    copy_counter& operator=(copy_counter&& o) {count = o.count; return *this;}
+    int count;
+};
+}
+
+SCENARIO("buffer count moves each value into the newest chunk", "[buffer][operators]"){
+    GIVEN("a source of values that count their copies"){
+        auto source = rx::observable<>::create<copy_counter>(
+            [](rx::subscriber<copy_counter> out){
+                for (int i = 0; i != 4; ++i) {
+                    out.on_next(copy_counter());
+                }
+                out.on_completed();
+            });
+        auto count_copies = [](rx::observable<std::vector<copy_counter>> chunks){
+            int copies = 0;
+            chunks
+                .subscribe([&](const std::vector<copy_counter>& chunk){
+                    for (auto& c : chunk) {
+                        copies += c.count;
+                    }
+                });
+            return copies;
+        };
+
+        WHEN("the values are buffered with overlapping chunks"){
+            auto copies = count_copies(source.buffer(2, 1).as_dynamic());
+
+            THEN("a value is only copied into the older chunks"){
+                // 1 | 1 2 | 2 3 | 3 4 | 4
+                REQUIRE(copies == 3);
+            }
+        }
+        WHEN("the values are buffered with chunks that do not overlap"){
+            auto copies = count_copies(source.buffer(2).as_dynamic());
+
+            THEN("no value is copied"){
+                REQUIRE(copies == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer shared holds each value once for the overlapping chunks", "[buffer][operators]"){
+    GIVEN("a source of values that count their copies"){
+        auto source = rx::observable<>::create<copy_counter>(
+            [](rx::subscriber<copy_counter> out){
+                for (int i = 0; i != 4; ++i) {
+                    out.on_next(copy_counter());
+                }
+                out.on_completed();
+            });
+
+        WHEN("the values are buffered with overlapping shared chunks"){
+            std::vector<std::vector<std::shared_ptr<const copy_counter>>> chunks;
+            source
+                .buffer_shared(2, 1)
+                .subscribe([&](std::vector<std::shared_ptr<const copy_counter>> chunk){
+                    chunks.push_back(std::move(chunk));
+                });
+
+            THEN("the overlapping chunks share the value and no value is copied"){
+                // 1 2 | 2 3 | 3 4 | 4
+                REQUIRE(chunks.size() == 4);
+                REQUIRE(chunks[0][1] == chunks[1][0]);
+                REQUIRE(chunks[1][1] == chunks[2][0]);
+                REQUIRE(chunks[2][1] == chunks[3][0]);
+                for (auto& chunk : chunks) {
+                    for (auto& c : chunk) {
+                        REQUIRE(c->count == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("buffer with event time, tumbling windows", "[buffer_with_event_time][operators]"){
+    GIVEN("timestamps that arrive out of order"){
+        auto xs = rxs::from(1, 3, 12, 7, 16, 4, 25);
+
+        WHEN("windows of 10 are kept open for 5 after the greatest timestamp"){
+            std::vector<std::vector<int>> windows;
+            xs.buffer_with_event_time([](int t){return t;}, 10, 5)
+                .subscribe([&](std::vector<int> w){windows.push_back(w);});
+
+            THEN("a value within the lateness joins its window and a later one is dropped"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({ 1, 3, 7 }),
+                    rxu::to_vector({ 12, 16 }),
+                    rxu::to_vector({ 25 })
+                });
+                REQUIRE(required == windows);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer with event time, sliding windows", "[buffer_with_event_time][operators]"){
+    GIVEN("timestamps on the clock of the scheduler"){
+        typedef rxsc::scheduler::clock_type::time_point time_point;
+        using namespace std::chrono;
+        auto at = [](int ms){return time_point() + milliseconds(ms);};
+        auto xs = rxs::from(at(1), at(6), at(12));
+
+        WHEN("windows of 10ms start every 5ms and there is no lateness"){
+            std::vector<std::vector<time_point>> windows;
+            xs.buffer_with_event_time([](time_point t){return t;}, duration_cast<rxsc::scheduler::clock_type::duration>(milliseconds(10)), duration_cast<rxsc::scheduler::clock_type::duration>(milliseconds(5)), rxsc::scheduler::clock_type::duration::zero())
+                .subscribe([&](std::vector<time_point> w){windows.push_back(w);});
+
+            THEN("each window is sent as the timestamps pass its end"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({ at(1) }),
+                    rxu::to_vector({ at(1), at(6) }),
+                    rxu::to_vector({ at(6), at(12) }),
+                    rxu::to_vector({ at(12) })
+                });
+                REQUIRE(required == windows);
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// a cold source of 1..3 that counts the subscriptions to it
+rx::observable<int> counted_range(std::shared_ptr<int> subscribed) {
+    return rx::observable<>::create<int>([subscribed](rx::subscriber<int> out){
+        ++*subscribed;
+        for (int i = 1; i <= 3; ++i) {
+            out.on_next(i);
+        }
+        out.on_completed();
+    });
+}
+}
+
+SCENARIO("cache runs the source once", "[cache][operators]"){
+    GIVEN("a cached cold source"){
+        auto subscribed = std::make_shared<int>(0);
+        auto cached = counted_range(subscribed).cache();
+
+        WHEN("two subscribers come one after the other"){
+            std::vector<int> first, second;
+            bool completed = false;
+            cached.subscribe([&](int v){first.push_back(v);});
+            cached.subscribe([&](int v){second.push_back(v);}, [&](){completed = true;});
+
+            THEN("the source was subscribed once"){
+                REQUIRE(*subscribed == 1);
+            }
+            THEN("both got all the values"){
+                std::vector<int> required{1, 2, 3};
+                REQUIRE(required == first);
+                REQUIRE(required == second);
+            }
+            THEN("the late subscriber completed"){
+                REQUIRE(completed);
+            }
+        }
+    }
+    GIVEN("a cache of the last 2 values"){
+        auto subscribed = std::make_shared<int>(0);
+        auto cached = counted_range(subscribed).cache(2);
+
+        WHEN("a subscriber comes after the source completed"){
+            cached.subscribe([](int){});
+            std::vector<int> late;
+            cached.subscribe([&](int v){late.push_back(v);});
+
+            THEN("it got the last 2 values"){
+                std::vector<int> required{2, 3};
+                REQUIRE(required == late);
+            }
+        }
+    }
+}
+
+SCENARIO("cache keeps the source when the subscribers have gone", "[cache][operators]"){
+    GIVEN("a cached subject"){
+        rxsub::subject<int> s;
+        auto cached = s.get_observable().cache();
+
+        WHEN("the only subscriber leaves before the next value"){
+            std::vector<int> late;
+            rx::composite_subscription first;
+            cached.subscribe(first, [](int){});
+            s.get_subscriber().on_next(1);
+            first.unsubscribe();
+            s.get_subscriber().on_next(2);
+            cached.subscribe([&](int v){late.push_back(v);});
+
+            THEN("the value sent while nobody was subscribed was kept"){
+                std::vector<int> required{1, 2};
+                REQUIRE(required == late);
+            }
+        }
+    }
+}
+
+SCENARIO("share_replay", "[share_replay][cache][operators]"){
+    GIVEN("a subject shared with a replay of 1"){
+        rxsub::subject<int> s;
+        auto ended = std::make_shared<int>(0);
+        auto source = s.get_observable();
+        auto shared = rx::observable<>::create<int>([source, ended](rx::subscriber<int> out){
+                out.add([ended](){++*ended;});
+                source.subscribe(out);
+            })
+            .share_replay(1);
+
+        WHEN("a subscriber joins late"){
+            std::vector<int> late;
+            rx::composite_subscription first, second;
+            shared.subscribe(first, [](int){});
+            s.get_subscriber().on_next(1);
+            s.get_subscriber().on_next(2);
+            shared.subscribe(second, [&](int v){late.push_back(v);});
+            s.get_subscriber().on_next(3);
+
+            THEN("it got the last value and then the live values"){
+                std::vector<int> required{2, 3};
+                REQUIRE(required == late);
+            }
+            THEN("the source is unsubscribed after the last subscriber"){
+                first.unsubscribe();
+                REQUIRE(*ended == 0);
+                second.unsubscribe();
+                REQUIRE(*ended == 1);
+            }
+        }
+    }
+}
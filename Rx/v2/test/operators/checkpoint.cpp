@@ -0,0 +1,125 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxo=rxcpp::operators;
+namespace rxu=rxcpp::util;
+
+#include "catch.hpp"
+
+SCENARIO("checkpoint saves the seed of scan", "[checkpoint][scan][operators]"){
+    GIVEN("a scan with a checkpoint that is requested after the second value"){
+        rxo::checkpoint<int> cp;
+        std::vector<int> saved;
+        cp.on_save([&](const int& s){saved.push_back(s);});
+
+        rx::subjects::subject<int> xs;
+        std::vector<int> out;
+        xs.get_observable()
+            .scan(0, [](int sum, int v){return sum + v;}, cp)
+            .subscribe([&](int v){out.push_back(v);});
+
+        auto o = xs.get_subscriber();
+        o.on_next(1);
+        cp.request();
+        o.on_next(2);
+        o.on_next(3);
+        o.on_next(4);
+        o.on_completed();
+
+        THEN("the sums are not changed"){
+            REQUIRE(out == rxu::to_vector({1, 3, 6, 10}));
+        }
+        THEN("the sum after the second value is saved once"){
+            REQUIRE(saved == rxu::to_vector({3}));
+            REQUIRE(cp.get().get() == 3);
+        }
+        WHEN("the scan is subscribed again"){
+            std::vector<int> again;
+            rx::observable<>::range(3, 4)
+                .scan(0, [](int sum, int v){return sum + v;}, cp)
+                .subscribe([&](int v){again.push_back(v);});
+            THEN("it starts from the saved sum"){
+                REQUIRE(again == rxu::to_vector({6, 10}));
+            }
+        }
+    }
+    GIVEN("a checkpoint restored from a saved sum"){
+        rxo::checkpoint<int> cp(100);
+        std::vector<int> out;
+        rx::observable<>::range(1, 2)
+            .scan(0, [](int sum, int v){return sum + v;}, cp)
+            .subscribe([&](int v){out.push_back(v);});
+        THEN("the scan starts from it"){
+            REQUIRE(out == rxu::to_vector({101, 103}));
+        }
+    }
+}
+
+SCENARIO("checkpoint saves the seed of reduce", "[checkpoint][reduce][operators]"){
+    GIVEN("a reduce that fails after a checkpoint and is retried"){
+        rxo::checkpoint<int> cp;
+        rx::subjects::subject<int> first;
+        int attempt = 0;
+        // the first attempt fails after 1, 2, 3 with the checkpoint after 2,
+        // the retry delivers the rest
+        auto source = rx::observable<>::defer([&](){
+            ++attempt;
+            if (attempt == 1) {
+                return first.get_observable().as_dynamic();
+            }
+            return rx::observable<>::range(3, 4).as_dynamic();
+        });
+
+        std::vector<int> out;
+        source
+            .reduce(0, [](int sum, int v){return sum + v;}, [](int sum){return sum;}, cp)
+            .retry()
+            .subscribe([&](int v){out.push_back(v);});
+
+        auto o = first.get_subscriber();
+        o.on_next(1);
+        cp.request();
+        o.on_next(2);
+        o.on_next(3);
+        o.on_error(std::make_exception_ptr(std::runtime_error("fail")));
+
+        THEN("the retry goes on from the checkpoint"){
+            REQUIRE(attempt == 2);
+            REQUIRE(out == rxu::to_vector({10}));
+        }
+    }
+}
+
+SCENARIO("checkpoint saves the value of distinct_until_changed", "[checkpoint][distinct_until_changed][operators]"){
+    GIVEN("a distinct_until_changed with a checkpoint"){
+        rxo::checkpoint<int> cp;
+        rx::subjects::subject<int> xs;
+        std::vector<int> out;
+        xs.get_observable()
+            .distinct_until_changed(cp)
+            .subscribe([&](int v){out.push_back(v);});
+
+        auto o = xs.get_subscriber();
+        o.on_next(1);
+        o.on_next(1);
+        o.on_next(2);
+        cp.request();
+        o.on_next(2);
+        o.on_completed();
+
+        THEN("the changes are emitted"){
+            REQUIRE(out == rxu::to_vector({1, 2}));
+        }
+        THEN("the last value is saved after a repeat"){
+            REQUIRE(cp.get().get() == 2);
+        }
+        WHEN("it is subscribed again"){
+            std::vector<int> again;
+            rx::observable<>::from(2, 3)
+                .distinct_until_changed(cp)
+                .subscribe([&](int v){again.push_back(v);});
+            THEN("a value equal to the saved one is filtered"){
+                REQUIRE(again == rxu::to_vector({3}));
+            }
+        }
+    }
+}
@@ -927,3 +927,114 @@ SCENARIO("combine_latest typical N", "[combine_latest][join][operators]"){
         }
     }
 }
+
+SCENARIO("combine_latest_changes passes the inputs that changed", "[combine_latest][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 2),
+            on.next(225, 4),
+            on.next(230, 5),
+            on.completed(300)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 3),
+            on.next(240, 6),
+            on.completed(300)
+        });
+
+        WHEN("each int is combined with the latest from the other source and the changes"){
+
+            auto res = w.start(
+                [&]() {
+                    return o1
+                        .combine_latest_changes(
+                            [](const std::bitset<2>& changed, const int& v1, const int& v2) {
+                                return static_cast<int>(changed.to_ulong()) * 100 + v1 * 10 + v2;
+                            },
+                            o2
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output marks the sources that sent a value since the last output"){
+                auto required = rxu::to_vector({
+                    on.next(220, 323),
+                    on.next(225, 143),
+                    on.next(230, 153),
+                    on.next(240, 256),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to each observable"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                REQUIRE(required == o1.subscriptions());
+                REQUIRE(required == o2.subscriptions());
+            }
+        }
+    }
+}
+
+SCENARIO("combine_latest with a coordination and a selector", "[combine_latest][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(230, 3),
+            on.completed(300)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 2),
+            on.next(240, 4),
+            on.completed(310)
+        });
+
+        WHEN("each int is combined with the other source on the identity coordination"){
+
+            auto res = w.start(
+                [&]() {
+                    return o1
+                        .combine_latest(
+                            rxcpp::identity_one_worker(sc),
+                            [](int v1, int v2){
+                                return v1 + v2;
+                            },
+                            o2
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains combined ints"){
+                auto required = rxu::to_vector({
+                    on.next(220, 3),
+                    on.next(230, 5),
+                    on.next(240, 7),
+                    on.completed(310)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -203,3 +203,80 @@ SCENARIO("concat completes", "[concat][join][operators]"){
         }
     }
 }
+
+SCENARIO("concat of many synchronous inners", "[concat][join][operators]"){
+    GIVEN("a range of just sources"){
+        const int count = 100000;
+
+        WHEN("they are concatenated"){
+            int calls = 0;
+            long long sum = 0;
+            bool completed = false;
+            rxs::range(1, count)
+                .map([](int i){return rx::observable<>::just(i);})
+                .concat()
+                .subscribe(
+                    [&](int v){++calls; sum += v;},
+                    [&](){completed = true;});
+
+            THEN("each inner is sent in order without nesting the subscribes"){
+                REQUIRE(calls == count);
+                REQUIRE(sum == (static_cast<long long>(count) * (count + 1)) / 2);
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("they are concatenated and unsubscribed part way"){
+            int calls = 0;
+            rx::composite_subscription lifetime;
+            rxs::range(1, count)
+                .map([](int i){return rx::observable<>::just(i);})
+                .concat()
+                .subscribe(
+                    lifetime,
+                    [&](int v){
+                        ++calls;
+                        if (v == 10) {
+                            lifetime.unsubscribe();
+                        }
+                    });
+
+            THEN("no inner is subscribed after the unsubscribe"){
+                REQUIRE(calls == 10);
+            }
+        }
+    }
+}
+
+SCENARIO("concat of sources that share a demand", "[concat][demand][operators]"){
+    GIVEN("two ranges that honor one demand"){
+        rx::demand pull;
+        std::vector<int> result;
+        bool completed = false;
+
+        rxs::range<int>(1, 3, 1, rx::identity_current_thread(), pull)
+            .concat(rxs::range<int>(11, 13, 1, rx::identity_current_thread(), pull))
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("values are requested across the end of the first source"){
+            pull.request(2);
+            auto first = result;
+            pull.request(2);
+            auto second = result;
+            pull.request(10);
+
+            THEN("each request sent that many values, in order"){
+                REQUIRE(first == rxu::to_vector({1, 2}));
+                REQUIRE(second == rxu::to_vector({1, 2, 3, 11}));
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 11, 12, 13}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("concat_map_eager subscribes ahead and keeps the order", "[concat_map_eager][concat_map][operators]"){
+    GIVEN("two cold observables. one of ints. one of strings."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> i_on;
+        const rxsc::test::messages<std::string> s_on;
+
+        auto xs = sc.make_cold_observable({
+            i_on.next(100, 4),
+            i_on.next(120, 2),
+            i_on.completed(500)
+        });
+
+        auto ys = sc.make_cold_observable({
+            s_on.next(50, "foo"),
+            s_on.next(100, "bar"),
+            s_on.next(150, "baz"),
+            s_on.next(200, "qux"),
+            s_on.completed(250)
+        });
+
+        WHEN("each int is mapped to the strings with a prefetch of 1"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .concat_map_eager(
+                            [&](int){
+                                return ys;},
+                            1)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the strings of the second int were held until the first completed"){
+                auto required = rxu::to_vector({
+                    s_on.next(350, "foo"),
+                    s_on.next(400, "bar"),
+                    s_on.next(450, "baz"),
+                    s_on.next(500, "qux"),
+                    s_on.next(550, "foo"),
+                    s_on.next(550, "bar"),
+                    s_on.next(550, "baz"),
+                    s_on.next(550, "qux"),
+                    s_on.completed(700)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the ints"){
+                auto required = rxu::to_vector({
+                    i_on.subscribe(200, 700)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the strings were subscribed for both ints at once"){
+                auto required = rxu::to_vector({
+                    s_on.subscribe(300, 550),
+                    s_on.subscribe(320, 570)
+                });
+                auto actual = ys.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("streamed each int is mapped to the strings with a prefetch of 0"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs >>
+                        rxo::concat_map_eager(
+                            [&](int){
+                                return ys;},
+                            0,
+                            rx::identity_current_thread()) >>
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        rxo::as_dynamic();
+                }
+            );
+
+            THEN("the output is the same as concat_map"){
+                auto required = rxu::to_vector({
+                    s_on.next(350, "foo"),
+                    s_on.next(400, "bar"),
+                    s_on.next(450, "baz"),
+                    s_on.next(500, "qux"),
+                    s_on.next(600, "foo"),
+                    s_on.next(650, "bar"),
+                    s_on.next(700, "baz"),
+                    s_on.next(750, "qux"),
+                    s_on.completed(800)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the strings were subscribed one at a time"){
+                auto required = rxu::to_vector({
+                    s_on.subscribe(300, 550),
+                    s_on.subscribe(550, 800)
+                });
+                auto actual = ys.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("concat_map_eager of synchronous ranges", "[concat_map_eager][concat_map][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("each int is mapped to a range with a prefetch of 2"){
+            std::vector<int> values;
+            bool completed = false;
+            rxs::range(1, 4)
+                .concat_map_eager([](int i){return rxs::range(i * 10, i * 10 + 2);}, 2)
+                .subscribe([&](int v){values.push_back(v);}, [&](){completed = true;});
+
+            THEN("the ranges were emitted in order"){
+                std::vector<int> required{10, 11, 12, 20, 21, 22, 30, 31, 32, 40, 41, 42};
+                REQUIRE(required == values);
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("concat_map_eager when a later observable completes first", "[concat_map_eager][concat_map][operators]"){
+    GIVEN("two subjects"){
+        rxsub::subject<int> first, second;
+        std::vector<int> values;
+        bool completed = false;
+        rxs::from(0, 1)
+            .concat_map_eager([=](int i){return i == 0 ? first.get_observable() : second.get_observable();}, 1)
+            .subscribe([&](int v){values.push_back(v);}, [&](){completed = true;});
+
+        WHEN("the second completes before the first"){
+            first.get_subscriber().on_next(1);
+            second.get_subscriber().on_next(2);
+            second.get_subscriber().on_completed();
+            first.get_subscriber().on_next(3);
+            auto before = values;
+            first.get_subscriber().on_completed();
+
+            THEN("the values of the second waited for the first"){
+                std::vector<int> required_before{1, 3};
+                REQUIRE(required_before == before);
+                std::vector<int> required{1, 3, 2};
+                REQUIRE(required == values);
+            }
+            THEN("the output completed after both"){
+                REQUIRE(completed);
+            }
+        }
+    }
+}
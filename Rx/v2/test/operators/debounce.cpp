@@ -0,0 +1,123 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("debounce", "[debounce][operators]"){
+    GIVEN("a source with two bursts and a late item"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(300, 3),
+            on.next(310, 4),
+            on.next(320, 5),
+            on.next(500, 6),
+            on.completed(600)
+        });
+
+        WHEN("the period is 50"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .debounce(std::chrono::milliseconds(50), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the last item of each burst was emitted 50 after it"){
+                auto required = rxu::to_vector({
+                    on.next(270, 2),
+                    on.next(370, 5),
+                    on.next(550, 6),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the period is 150"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .debounce(std::chrono::milliseconds(150), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the pending item was emitted when the source completed"){
+                auto required = rxu::to_vector({
+                    on.next(470, 5),
+                    on.next(600, 6),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("debounce observer that sends to the source", "[debounce][operators]"){
+    GIVEN("a subject debounced on the test scheduler"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        rxcpp::subjects::subject<int> s;
+        std::vector<int> values;
+
+        s.get_observable()
+            .debounce(std::chrono::milliseconds(50), so)
+            .subscribe([&](int v){
+                values.push_back(v);
+                if (v == 1) {
+                    // calls the operator again from inside the delivery
+                    s.get_subscriber().on_next(2);
+                }
+            });
+
+        WHEN("a value is sent and the period passes"){
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){
+                s.get_subscriber().on_next(1);
+            });
+            w.schedule_absolute(300, [&](const rxsc::schedulable&){
+                s.get_subscriber().on_completed();
+            });
+            w.start();
+
+            THEN("the value sent from the delivery is debounced as well"){
+                REQUIRE(values == rxu::to_vector({1, 2}));
+            }
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include "rxcpp/rx.hpp"
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("distinct - some repeats", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 2),
+            on.next(240, 1),
+            on.next(250, 3),
+            on.next(260, 4),
+            on.completed(300)
+        });
+
+        WHEN("distinct values are taken"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.distinct();
+                }
+            );
+
+            THEN("the output only contains the first of each value sent while subscribed"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2),
+                    on.next(220, 3),
+                    on.next(240, 1),
+                    on.next(260, 4),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - key and capacity", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 11),
+            on.next(220, 21),
+            on.next(230, 12),
+            on.next(240, 32),
+            on.next(250, 13),
+            on.next(260, 23),
+            on.completed(300)
+        });
+
+        WHEN("values with distinct keys are taken and only two keys are remembered"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.distinct([](int v){return v % 10;}, 2);
+                }
+            );
+
+            THEN("a key is emitted again once it has been forgotten"){
+                auto required = rxu::to_vector({
+                    on.next(210, 11),
+                    on.next(230, 12),
+                    on.next(250, 13),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("values with distinct keys are taken and only one key is remembered"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.distinct([](int v){return v / 10;}, 1);
+                }
+            );
+
+            THEN("only repeats of the last key are removed"){
+                auto required = rxu::to_vector({
+                    on.next(210, 11),
+                    on.next(220, 21),
+                    on.next(230, 12),
+                    on.next(240, 32),
+                    on.next(250, 13),
+                    on.next(260, 23),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - key selector throws", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("distinct key selector error");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.completed(300)
+        });
+
+        WHEN("the key selector throws for the second value"){
+
+            auto res = w.start(
+                [xs, ex]() {
+                    return xs.distinct([ex](int v){
+                        if (v == 2) {
+                            throw ex;
+                        }
+                        return v;
+                    });
+                }
+            );
+
+            THEN("the output contains the first value and the error"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.error(220, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed at the error"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 220)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
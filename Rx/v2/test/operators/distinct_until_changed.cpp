@@ -302,3 +302,74 @@ SCENARIO("distinct_until_changed - some changes", "[distinct_until_changed][oper
         }
     }
 }
+
+SCENARIO("distinct_until_changed - key selector", "[distinct_until_changed][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 11),
+            on.next(220, 12),
+            on.next(230, 21),
+            on.next(240, 22),
+            on.next(250, 13),
+            on.completed(300)
+        });
+
+        WHEN("values are taken when their key changes"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .distinct_until_changed([](int v){return v / 10;})
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains the first value of each run of keys"){
+                auto required = rxu::to_vector({
+                    on.next(210, 11),
+                    on.next(230, 21),
+                    on.next(250, 13),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the keyed operator is fused with map"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .map([](int v){return v + 1;})
+                        .distinct_until_changed([](int v){return v / 10;})
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the keys of the mapped values are compared"){
+                auto required = rxu::to_vector({
+                    on.next(210, 12),
+                    on.next(230, 22),
+                    on.next(250, 14),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -467,6 +467,63 @@ SCENARIO("flat_map source never ends", "[flat_map][map][operators]"){
     }
 }
 
+SCENARIO("flat_map with maxConcurrent waits for a free slot", "[flat_map][map][operators]"){
+    GIVEN("a hot observable of ints and a cold observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(300, 1),
+            on.next(305, 2),
+            on.next(315, 3),
+            on.completed(400)
+        });
+
+        auto ys = sc.make_cold_observable({
+            on.next(10, 10),
+            on.next(20, 20),
+            on.completed(30)
+        });
+
+        WHEN("each int is mapped to the ys one at a time"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .flat_map([&](int){return ys;}, [](int x, int y){return x + y;}, 1)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the ys for each int in turn"){
+                auto required = rxu::to_vector({
+                    on.next(310, 11),
+                    on.next(320, 21),
+                    on.next(340, 12),
+                    on.next(350, 22),
+                    on.next(370, 13),
+                    on.next(380, 23),
+                    on.completed(400)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("each subscription to the ys started when the previous one completed"){
+                auto required = rxu::to_vector({
+                    on.subscribe(300, 330),
+                    on.subscribe(330, 360),
+                    on.subscribe(360, 390)
+                });
+                auto actual = ys.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
 SCENARIO("flat_map inner error", "[flat_map][map][operators]"){
     GIVEN("two cold observables. one of ints. one of strings."){
         auto sc = rxsc::make_test();
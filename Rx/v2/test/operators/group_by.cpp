@@ -261,3 +261,173 @@ SCENARIO("group_by", "[group_by][operators]"){
         }
     }
 }
+
+SCENARIO("group_by with hash_groups and max groups", "[group_by][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 1),
+            on.next(240, 3),
+            on.next(250, 2),
+            on.next(260, 1),
+            on.completed(300)
+        });
+
+        WHEN("the ints are grouped by value with at most 2 open groups"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .group_by(
+                            [](int v){return v;},
+                            [](int v){return v;},
+                            rxcpp::operators::hash_groups<>(),
+                            rxcpp::operators::group_expiry(2))
+                        .map([](const rxcpp::grouped_observable<int, int>& g){return g.get_key();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the least recently used group is removed to make room for a new key"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 2),
+                    on.next(240, 3),
+                    on.next(250, 2),
+                    on.next(260, 1),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("group_by with idle groups", "[group_by][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 1),
+            on.next(260, 2),
+            on.next(270, 1),
+            on.completed(300)
+        });
+
+        WHEN("the values in each group are counted and groups expire after 25 idle ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .group_by(
+                            [](int v){return v;},
+                            [](int v){return v;},
+                            rxu::less(),
+                            rxcpp::operators::group_expiry(std::chrono::milliseconds(25), sc))
+                        .map([](const rxcpp::grouped_observable<int, int>& g){
+                            auto key = g.get_key();
+                            return g.count().map([key](int c){return key * 100 + c;});
+                        })
+                        .merge()
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the idle groups are completed when the next value arrives"){
+                auto required = rxu::to_vector({
+                    on.next(260, 201),
+                    on.next(260, 102),
+                    on.next(300, 101),
+                    on.next(300, 201),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("group_by delivers each key on one worker of the coordination", "[group_by][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("the ints are grouped by value mod 8 on the event loop"){
+
+            std::mutex lock;
+            std::map<int, std::set<std::thread::id>> threads;
+            std::map<int, std::vector<int>> values;
+
+            auto count = rxs::range(0, 99)
+                .group_by(
+                    [](int v){return v % 8;},
+                    [](int v){return v;},
+                    rxcpp::observe_on_event_loop())
+                .map([&](const rxcpp::grouped_observable<int, int>& g){
+                    auto key = g.get_key();
+                    return g.map([&, key](int v){
+                        std::unique_lock<std::mutex> guard(lock);
+                        threads[key].insert(std::this_thread::get_id());
+                        values[key].push_back(v);
+                        return v;
+                    });
+                })
+                .merge(rxcpp::serialize_event_loop())
+                .as_blocking()
+                .count();
+
+            THEN("every value was delivered"){
+                REQUIRE(100 == count);
+            }
+
+            THEN("each key was delivered in order on one thread"){
+                REQUIRE(8u == threads.size());
+                for (auto& t : threads) {
+                    REQUIRE(1u == t.second.size());
+                    auto& v = values[t.first];
+                    REQUIRE(std::is_sorted(v.begin(), v.end()));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("group_by emits statically typed groups", "[group_by][operators]"){
+    GIVEN("a source of ints"){
+        auto xs = rxcpp::observable<>::iterate(rxu::to_vector({1, 2, 3, 4, 5}));
+
+        WHEN("the ints are grouped by parity"){
+            auto groups = xs
+                .group_by(
+                    [](int v){return v % 2;},
+                    [](int v){return v * 10;});
+            typedef rxu::value_type_t<decltype(groups)> group_type;
+
+            THEN("the groups are not dynamic until as_dynamic"){
+                static_assert(!std::is_same<group_type, rxcpp::grouped_observable<int, int>>::value, "group_by should not wrap each group");
+                static_assert(std::is_same<decltype(std::declval<group_type>().as_dynamic()), rxcpp::grouped_observable<int, int>>::value, "as_dynamic should forget the group type");
+            }
+            THEN("the groups keep their key and values through as_dynamic"){
+                std::map<int, std::vector<int>> values;
+                groups
+                    .subscribe([&](const group_type& g){
+                        auto dynamic = g.as_dynamic();
+                        REQUIRE(dynamic.get_key() == g.get_key());
+                        dynamic.subscribe([&values, dynamic](int v){values[dynamic.get_key()].push_back(v);});
+                    });
+                REQUIRE(values[0] == rxu::to_vector({20, 40}));
+                REQUIRE(values[1] == rxu::to_vector({10, 30, 50}));
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("instrument measures the queue of observe_on", "[instrument][observe_on][operators]"){
+    GIVEN("a source with a burst of values"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(220, 4),
+            on.completed(250)
+        });
+
+        WHEN("the values are observed on the test worker one at a time"){
+            rxo::stage_metrics stage("test.observe_on");
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .observe_on(rx::identity_one_worker(sc), 1)
+                        .instrument(stage)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains the values"){
+                auto required = rxu::to_vector({
+                    on.next(211, 1),
+                    on.next(212, 2),
+                    on.next(213, 3),
+                    on.next(221, 4),
+                    on.completed(251)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the burst was queued"){
+                REQUIRE(stage.name() == "test.observe_on");
+                REQUIRE(stage.entered() == 4);
+                REQUIRE(stage.delivered() == 4);
+                REQUIRE(stage.peak() == 3);
+                REQUIRE(stage.current() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("instrument pairs the values of a stage", "[instrument][operators]"){
+    GIVEN("a range"){
+        auto xs = rxs::range(1, 5);
+
+        WHEN("a map is instrumented"){
+            rxo::stage_metrics stage("test.map");
+            std::vector<int> values;
+            xs.map([](int v){return v * 10;})
+                .instrument(stage)
+                .subscribe([&](int v){values.push_back(v);});
+
+            THEN("the values are unchanged"){
+                REQUIRE(values == rxu::to_vector({10, 20, 30, 40, 50}));
+            }
+            THEN("each value left before the next entered"){
+                REQUIRE(stage.entered() == 5);
+                REQUIRE(stage.delivered() == 5);
+                REQUIRE(stage.peak() == 1);
+                REQUIRE(stage.current() == 0);
+            }
+        }
+
+        WHEN("a filter that drops values is instrumented"){
+            rxo::stage_metrics stage("test.filter");
+            xs.filter([](int v){return v % 2 == 0;})
+                .instrument(stage)
+                .subscribe([](int){});
+
+            THEN("the values that did not leave are discarded at the end"){
+                REQUIRE(stage.entered() == 5);
+                REQUIRE(stage.delivered() == 2);
+                REQUIRE(stage.current() == 0);
+            }
+        }
+
+        WHEN("the source itself is instrumented by name"){
+            std::vector<int> values;
+            xs.instrument("test.range")
+                .subscribe([&](int v){values.push_back(v);});
+
+            THEN("the values are unchanged"){
+                REQUIRE(values == rxu::to_vector({1, 2, 3, 4, 5}));
+            }
+        }
+
+        WHEN("the operator is applied with rxo::instrument"){
+            rxo::stage_metrics stage("test.take");
+            xs.take(3)
+                | rxo::instrument(stage)
+                | rxo::subscribe<int>([](int){});
+
+            THEN("the stage is measured"){
+                REQUIRE(stage.entered() == 3);
+                REQUIRE(stage.delivered() == 3);
+            }
+        }
+    }
+}
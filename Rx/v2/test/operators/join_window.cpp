@@ -0,0 +1,143 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("join_window pairs the values with the same key within the window", "[join_window][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(260, 2),
+            on.next(330, 1),
+            on.completed(400)
+        });
+        auto ys = sc.make_hot_observable({
+            on.next(220, 11),
+            on.next(240, 12),
+            on.next(300, 21),
+            on.next(350, 31),
+            on.completed(500)
+        });
+
+        WHEN("they are joined on the last digit with a window of 50ms"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .join_window(ys,
+                            [](int l){return l;},
+                            [](int r){return r % 10;},
+                            milliseconds(50),
+                            [](int l, int r){return l * 100 + r;},
+                            so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains a value for each pair that arrived within 50ms"){
+                auto required = rxu::to_vector({
+                    on.next(220, 111),
+                    on.next(260, 212),
+                    on.next(330, 121),
+                    on.next(350, 131),
+                    on.completed(500)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to each source"){
+                REQUIRE(xs.subscriptions() == rxu::to_vector({on.subscribe(200, 400)}));
+                REQUIRE(ys.subscriptions() == rxu::to_vector({on.subscribe(200, 500)}));
+            }
+        }
+    }
+}
+
+SCENARIO("join_window sends an error from a key selector", "[join_window][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("join_window on_error from key");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(230, 2),
+            on.completed(400)
+        });
+        auto ys = sc.make_hot_observable({
+            on.next(220, 1),
+            on.completed(500)
+        });
+
+        WHEN("the key selector of this observable throws"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .join_window(ys,
+                            [ex](int l){if (l == 2) {throw ex;} return l;},
+                            [](int r){return r;},
+                            milliseconds(50),
+                            [](int l, int r){return l * 100 + r;},
+                            so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the pair before the error"){
+                auto required = rxu::to_vector({
+                    on.next(220, 101),
+                    on.error(230, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("both sources were unsubscribed at the error"){
+                REQUIRE(xs.subscriptions() == rxu::to_vector({on.subscribe(200, 230)}));
+                REQUIRE(ys.subscriptions() == rxu::to_vector({on.subscribe(200, 230)}));
+            }
+        }
+    }
+}
+
+SCENARIO("join_window of synchronous sources", "[join_window][join][operators]"){
+    GIVEN("orders and fills"){
+        auto orders = rxs::iterate(rxu::to_vector({1, 2, 3}));
+        auto fills = rxs::iterate(rxu::to_vector({std::make_pair(2, 20), std::make_pair(3, 30), std::make_pair(4, 40)}));
+
+        WHEN("the fills are joined to the orders with a window of an hour"){
+            using namespace std::chrono;
+
+            std::vector<int> joined;
+            orders
+                .join_window(fills,
+                    [](int order){return order;},
+                    [](std::pair<int, int> fill){return fill.first;},
+                    hours(1),
+                    [](int, std::pair<int, int> fill){return fill.second;})
+                .subscribe([&](int v){joined.push_back(v);});
+
+            THEN("each fill is paired with its order"){
+                REQUIRE(joined == rxu::to_vector({20, 30}));
+            }
+        }
+    }
+}
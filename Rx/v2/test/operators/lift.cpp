@@ -294,3 +294,113 @@ SCENARIO("lift lambda filter stops on disposal", "[where][filter][lift][lambda][
     }
 }
 
+
+SCENARIO("adjacent map, filter and distinct_until_changed are fused", "[map][filter][distinct_until_changed][lift][fuse][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.next(250, 5),
+            on.next(260, 6),
+            on.completed(300)
+        });
+
+        WHEN("the values are mapped, filtered, mapped and made distinct"){
+
+            auto fused = xs
+                .map([](int x) {return x * 10;})
+                .filter([](int x) {return x != 30;})
+                .map([](int x) {return x / 20;})
+                .distinct_until_changed();
+
+            typedef rxo::detail::lift_operator<int, typename decltype(xs)::source_operator_type, rxo::detail::map<int, int(*)(int)>> unfused_type;
+            static_assert(!std::is_same<typename decltype(fused)::source_operator_type, unfused_type>::value, "the chain should be fused");
+            static_assert(std::is_same<typename decltype(fused)::source_operator_type::source_operator_type, typename decltype(xs)::source_operator_type>::value, "the fused chain should be one lift of the source");
+
+            auto res = w.start(
+                [&]() {
+                    return fused;
+                }
+            );
+
+            THEN("the output is the same as the separate operators"){
+                auto required = rxu::to_vector({
+                    on.next(210, 0),
+                    on.next(220, 1),
+                    on.next(240, 2),
+                    on.next(260, 3),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("a fused selector throws"){
+
+            std::runtime_error ex("map on_error from source");
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .filter([](int x) {return x % 2 == 0;})
+                        .map([ex](int x) {
+                            if (x == 4) {
+                                throw ex;
+                            }
+                            return x;
+                        })
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the error is sent and the source is unsubscribed"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.error(240, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+
+                auto subscriptions = rxu::to_vector({
+                    on.subscribe(200, 240)
+                });
+                REQUIRE(subscriptions == xs.subscriptions());
+            }
+        }
+    }
+}
+
+SCENARIO("fused distinct_until_changed keeps state per subscriber", "[distinct_until_changed][lift][fuse][operators]"){
+    GIVEN("a fused chain"){
+        auto values = rxcpp::observable<>::iterate(rxu::to_vector({1, 1, 2, 2, 3}))
+            .map([](int x) {return x;})
+            .distinct_until_changed();
+
+        WHEN("it is subscribed twice"){
+            std::vector<int> first, second;
+            values.subscribe([&](int x){first.push_back(x);});
+            values.subscribe([&](int x){second.push_back(x);});
+
+            THEN("both subscribers get every change"){
+                REQUIRE(first == rxu::to_vector({1, 2, 3}));
+                REQUIRE(second == rxu::to_vector({1, 2, 3}));
+            }
+        }
+    }
+}
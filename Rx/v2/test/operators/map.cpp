@@ -64,3 +64,111 @@ SCENARIO("map stops on completion", "[map][operators]"){
         }
     }
 }
+
+SCENARIO("map, filter, skip and take send move-only values", "[map][filter][skip][take][move][operators]"){
+    GIVEN("a source of unique_ptr"){
+        typedef std::unique_ptr<int> value_type;
+
+        auto xs = rxcpp::observable<>::create<value_type>(
+            [](rxcpp::subscriber<value_type> s){
+                for (int i = 1; i <= 6; ++i) {
+                    s.on_next(value_type(new int(i)));
+                }
+                s.on_completed();
+            });
+
+        WHEN("the values pass through a chain of operators"){
+            std::vector<int> result;
+            bool completed = false;
+
+            xs
+                .map([](value_type p){
+                    *p *= 10;
+                    return p;
+                })
+                .filter([](const value_type& p){
+                    return *p != 30;
+                })
+                .skip(1)
+                .take(3)
+                .subscribe(
+                    [&](value_type p){
+                        result.push_back(*p);
+                    },
+                    [&](){
+                        completed = true;
+                    });
+
+            THEN("every value arrived without a copy"){
+                REQUIRE(result == rxu::to_vector({20, 40, 50}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("map of a batched source to move-only values", "[map][operators]"){
+    GIVEN("a range"){
+        typedef std::unique_ptr<int> value_type;
+
+        WHEN("each value is mapped to a unique_ptr"){
+            std::vector<int> result;
+            bool completed = false;
+
+            rxcpp::sources::range(1, 5)
+                .map([](int i){
+                    return value_type(new int(i));
+                })
+                .subscribe(
+                    [&](value_type p){
+                        result.push_back(*p);
+                    },
+                    [&](){
+                        completed = true;
+                    });
+
+            THEN("the values arrive one at a time"){
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 4, 5}));
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("the range is filtered before it is mapped to a unique_ptr"){
+            std::vector<int> result;
+
+            rxcpp::sources::range(1, 5)
+                .filter([](int i){
+                    return i % 2 == 1;
+                })
+                .map([](int i){
+                    return value_type(new int(i));
+                })
+                .subscribe(
+                    [&](value_type p){
+                        result.push_back(*p);
+                    });
+
+            THEN("the values that passed arrive one at a time"){
+                REQUIRE(result == rxu::to_vector({1, 3, 5}));
+            }
+        }
+
+        WHEN("an iterated vector is mapped to a unique_ptr"){
+            std::vector<int> result;
+
+            rxcpp::sources::iterate(rxu::to_vector({1, 2, 3}))
+                .map([](int i){
+                    return value_type(new int(i));
+                })
+                .as_dynamic()
+                .subscribe(
+                    [&](value_type p){
+                        result.push_back(*p);
+                    });
+
+            THEN("the values arrive one at a time"){
+                REQUIRE(result == rxu::to_vector({1, 2, 3}));
+            }
+        }
+    }
+}
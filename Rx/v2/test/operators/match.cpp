@@ -0,0 +1,161 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("match a followed by b without c", "[match][operators]"){
+    GIVEN("a source of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 1),
+            on.next(230, 9),
+            on.next(240, 2),
+            on.next(250, 1),
+            on.next(260, 3),
+            on.next(270, 2),
+            on.next(300, 1),
+            on.next(360, 2),
+            on.next(370, 1),
+            on.next(380, 2),
+            on.completed(400)
+        });
+
+        WHEN("1 followed by 2 without 3 is matched within 50ms"){
+            using namespace std::chrono;
+
+            auto p = rxo::pattern<int>()
+                .followed_by([](int v){return v == 1;})
+                .followed_by([](int v){return v == 2;}, [](int v){return v == 3;});
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .match(p, milliseconds(50), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the matches that were not ended by 3 or by time"){
+                auto required = rxu::to_vector({
+                    v_on.next(240, rxu::to_vector({1, 2})),
+                    v_on.next(240, rxu::to_vector({1, 2})),
+                    v_on.next(380, rxu::to_vector({1, 2})),
+                    v_on.completed(400)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 400)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("match three steps from many partial matches", "[match][operators]"){
+    GIVEN("a source of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 11),
+            on.next(245, 12),
+            on.next(250, 21),
+            on.completed(300)
+        });
+
+        WHEN("a value below 10, then in the tens, then in the twenties, is matched"){
+            using namespace std::chrono;
+
+            auto p = rxo::pattern<int>()
+                .followed_by([](int v){return v < 10;})
+                .followed_by([](int v){return v / 10 == 1;})
+                .followed_by([](int v){return v / 10 == 2;});
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .match(p, milliseconds(100), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each partial match moves on the first value of each step, oldest first"){
+                auto required = rxu::to_vector({
+                    v_on.next(250, rxu::to_vector({1, 11, 21})),
+                    v_on.next(250, rxu::to_vector({2, 11, 21})),
+                    v_on.next(250, rxu::to_vector({3, 11, 21})),
+                    v_on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("match sends an error from a step", "[match][operators]"){
+    GIVEN("a source of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        std::runtime_error ex("match on_error from step");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.completed(300)
+        });
+
+        WHEN("the step throws"){
+            using namespace std::chrono;
+
+            auto p = rxo::pattern<int>()
+                .followed_by([ex](int v){if (v == 2) {throw ex;} return true;});
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .match(p, milliseconds(100), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains a match and then the error"){
+                auto required = rxu::to_vector({
+                    v_on.next(210, rxu::to_vector({1})),
+                    v_on.error(220, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
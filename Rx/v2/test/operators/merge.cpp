@@ -94,6 +94,83 @@ SCENARIO("serialize merge ranges", "[hide][range][serialize][merge][perf]"){
     }
 }
 
+SCENARIO("serialize_drain merge ranges", "[range][serialize][merge][operators]"){
+    GIVEN("ranges on several threads"){
+        WHEN("merged with serialize_drain_event_loop"){
+            auto so = rx::serialize_drain_event_loop();
+
+            std::atomic<int> inside(0);
+            std::atomic<bool> overlapped(false);
+            long sum = 0;
+            int c = 0;
+            rxs::range(0, 999, 1, so)
+                .merge(
+                    so,
+                    rxs::range(1000, 1999, 1, rx::observe_on_new_thread()),
+                    rxs::range(2000, 2999, 1, rx::observe_on_new_thread()),
+                    rxs::range(3000, 3999, 1, rx::observe_on_event_loop()))
+                .as_blocking()
+                .subscribe([&](int v){
+                    if (inside++ != 0) {
+                        overlapped = true;
+                    }
+                    sum += v;
+                    ++c;
+                    --inside;
+                });
+
+            THEN("every value was delivered, one at a time"){
+                REQUIRE(c == 4000);
+                REQUIRE(sum == 3999L * 4000L / 2);
+                REQUIRE(!overlapped);
+            }
+        }
+    }
+}
+
+SCENARIO("serialize_drain after a call throws", "[serialize][operators]"){
+    GIVEN("the serialized subscriber of a serialize_drain coordinator"){
+        rx::serialize_drain_one_worker so(rxsc::make_current_thread());
+        auto coordinator = so.create_coordinator();
+
+        std::vector<int> received;
+        int errors = 0;
+        std::function<void(int)> reenter;
+        auto out = coordinator.out(rx::make_subscriber<int>(
+            [&](int v){
+                received.push_back(v);
+                if (v == 1 || v == 3) {
+                    throw std::runtime_error("on_next failed");
+                }
+                if (v == 2) {
+                    // queued behind this call and made by the drain
+                    reenter(3);
+                }
+            },
+            [&](std::exception_ptr){
+                ++errors;
+            }));
+        reenter = [&](int v){out.on_next(v);};
+
+        WHEN("the direct call throws"){
+            out.on_next(1);
+
+            THEN("the error that follows is delivered"){
+                REQUIRE((received == std::vector<int>{1}));
+                REQUIRE(errors == 1);
+            }
+        }
+        WHEN("a queued call throws"){
+            out.on_next(2);
+
+            THEN("the drain finished and the error that follows is delivered"){
+                REQUIRE((received == std::vector<int>{2, 3}));
+                REQUIRE(errors == 1);
+            }
+        }
+    }
+}
+
 SCENARIO("merge completes", "[merge][join][operators]"){
     GIVEN("1 hot observable with 3 cold observables of ints."){
         auto sc = rxsc::make_test();
@@ -204,6 +281,98 @@ SCENARIO("merge completes", "[merge][join][operators]"){
     }
 }
 
+SCENARIO("merge with maxConcurrent waits for a free slot", "[merge][join][operators]"){
+    GIVEN("1 hot observable with 3 cold observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<rx::observable<int>> o_on;
+
+        auto ys1 = sc.make_cold_observable({
+            on.next(10, 101),
+            on.next(20, 102),
+            on.next(110, 103),
+            on.next(120, 104),
+            on.next(210, 105),
+            on.next(220, 106),
+            on.completed(230)
+        });
+
+        auto ys2 = sc.make_cold_observable({
+            on.next(10, 201),
+            on.next(20, 202),
+            on.next(30, 203),
+            on.next(40, 204),
+            on.completed(50)
+        });
+
+        auto ys3 = sc.make_cold_observable({
+            on.next(10, 301),
+            on.next(20, 302),
+            on.next(30, 303),
+            on.next(40, 304),
+            on.next(120, 305),
+            on.completed(150)
+        });
+
+        auto xs = sc.make_hot_observable({
+            o_on.next(300, ys1),
+            o_on.next(400, ys2),
+            o_on.next(500, ys3),
+            o_on.completed(600)
+        });
+
+        WHEN("each int is merged one observable at a time"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .merge(1)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the ints of each observable in turn"){
+                auto required = rxu::to_vector({
+                    on.next(310, 101),
+                    on.next(320, 102),
+                    on.next(410, 103),
+                    on.next(420, 104),
+                    on.next(510, 105),
+                    on.next(520, 106),
+                    on.next(540, 201),
+                    on.next(550, 202),
+                    on.next(560, 203),
+                    on.next(570, 204),
+                    on.next(590, 301),
+                    on.next(600, 302),
+                    on.next(610, 303),
+                    on.next(620, 304),
+                    on.next(700, 305),
+                    on.completed(730)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("each of the ys was subscribed when the previous one completed"){
+                REQUIRE(rxu::to_vector({on.subscribe(300, 530)}) == ys1.subscriptions());
+                REQUIRE(rxu::to_vector({on.subscribe(530, 580)}) == ys2.subscriptions());
+                REQUIRE(rxu::to_vector({on.subscribe(580, 730)}) == ys3.subscriptions());
+            }
+        }
+    }
+}
+
 SCENARIO("variadic merge completes", "[merge][join][operators]"){
     GIVEN("1 hot observable with 3 cold observables of ints."){
         auto sc = rxsc::make_test();
@@ -296,3 +465,124 @@ SCENARIO("variadic merge completes", "[merge][join][operators]"){
         }
     }
 }
+
+SCENARIO("merge with an identity coordination creates no worker", "[merge][operators]"){
+    GIVEN("two ranges merged on the current thread"){
+        typedef rx::identity_one_worker identity_type;
+        static_assert(std::is_same<
+            rx::detail::in_out_coordinator<identity_type>::type,
+            rx::detail::identity_pass_coordinator>::value,
+            "identity coordinations must not have a worker");
+        static_assert(std::is_same<
+            rx::detail::in_out_coordinator<rx::serialize_one_worker>::type,
+            rx::serialize_one_worker::coordinator_type>::value,
+            "other coordinations must keep their coordinator");
+
+        std::vector<int> values;
+        rxs::range(1, 3)
+            .merge(rx::identity_current_thread(), rxs::range(4, 6))
+            .subscribe([&](int v){values.push_back(v);});
+        THEN("every value is sent"){
+            std::sort(values.begin(), values.end());
+            REQUIRE(values == std::vector<int>({1, 2, 3, 4, 5, 6}));
+        }
+    }
+}
+
+SCENARIO("merge with an identity coordination unsubscribes the inners", "[merge][operators]"){
+    GIVEN("inners that count their unsubscribes"){
+        int unsubscribed = 0;
+        auto inner = rxs::create<int>([&](rx::subscriber<int> s){
+            s.add([&](){++unsubscribed;});
+            s.on_next(1);
+        });
+        auto completed = rxs::create<int>([&](rx::subscriber<int> s){
+            s.add([&](){++unsubscribed;});
+            s.on_next(2);
+            s.on_completed();
+        });
+        WHEN("the output is unsubscribed after some inners completed"){
+            std::vector<int> values;
+            rx::composite_subscription cs;
+            rxs::from(completed.as_dynamic(), inner.as_dynamic(), completed.as_dynamic(), inner.as_dynamic())
+                .merge(rx::identity_current_thread())
+                .subscribe(cs, [&](int v){values.push_back(v);});
+            REQUIRE(unsubscribed == 2);
+            cs.unsubscribe();
+            THEN("every inner is unsubscribed once"){
+                REQUIRE(values == std::vector<int>({2, 1, 2, 1}));
+                REQUIRE(unsubscribed == 4);
+            }
+        }
+    }
+}
+
+SCENARIO("merge of sources that share a demand", "[merge][demand][operators]"){
+    GIVEN("two ranges that honor one demand"){
+        rx::demand pull;
+        std::vector<int> result;
+        bool completed = false;
+
+        rxs::range<int>(1, 5, 1, rx::identity_current_thread(), pull)
+            .merge(rxs::range<int>(11, 15, 1, rx::identity_current_thread(), pull))
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("values are requested in parts"){
+            auto none = result.size();
+            pull.request(3);
+            auto first = result.size();
+            pull.request(4);
+            auto second = result.size();
+            pull.request(10);
+
+            THEN("the sources together sent no more than was requested"){
+                REQUIRE(none == 0);
+                REQUIRE(first == 3);
+                REQUIRE(second == 7);
+                REQUIRE(result.size() == 10);
+                REQUIRE(completed);
+                std::sort(result.begin(), result.end());
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 4, 5, 11, 12, 13, 14, 15}));
+            }
+        }
+    }
+    GIVEN("two ranges on their own threads that honor one demand"){
+        rx::demand pull;
+        std::atomic<int> count(0);
+        std::atomic<bool> completed(false);
+
+        rxs::range<int>(1, 100, 1, rx::observe_on_new_thread(), pull)
+            .merge(rx::serialize_new_thread(), rxs::range<int>(101, 200, 1, rx::observe_on_new_thread(), pull))
+            .subscribe(
+                [&](int){
+                    ++count;
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("ten values are requested"){
+            pull.request(10);
+            while (count < 10) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            auto inflight = count.load();
+            pull.request(190);
+            while (!completed) {
+                std::this_thread::yield();
+            }
+
+            THEN("no more than ten were sent until more were requested"){
+                REQUIRE(inflight == 10);
+                REQUIRE(count == 200);
+            }
+        }
+    }
+}
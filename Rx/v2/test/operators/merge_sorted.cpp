@@ -0,0 +1,142 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("merge_sorted waits for a value from every source", "[merge_sorted][merge][operators]"){
+    GIVEN("3 hot observables of ordered ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs1 = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(240, 4),
+            on.next(300, 7),
+            on.completed(400)
+        });
+        auto xs2 = sc.make_hot_observable({
+            on.next(220, 2),
+            on.next(250, 5),
+            on.completed(350)
+        });
+        auto xs3 = sc.make_hot_observable({
+            on.next(230, 3),
+            on.next(260, 6),
+            on.next(310, 8),
+            on.completed(500)
+        });
+
+        WHEN("they are merged in order"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs1
+                        .merge_sorted(std::less<int>(), xs2, xs3)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the ints in order"){
+                auto required = rxu::to_vector({
+                    on.next(230, 1),
+                    on.next(240, 2),
+                    on.next(250, 3),
+                    on.next(260, 4),
+                    on.next(300, 5),
+                    on.next(350, 6),
+                    on.next(350, 7),
+                    on.next(400, 8),
+                    on.completed(500)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to each source"){
+                REQUIRE(xs1.subscriptions() == rxu::to_vector({on.subscribe(200, 400)}));
+                REQUIRE(xs2.subscriptions() == rxu::to_vector({on.subscribe(200, 350)}));
+                REQUIRE(xs3.subscriptions() == rxu::to_vector({on.subscribe(200, 500)}));
+            }
+        }
+    }
+}
+
+SCENARIO("merge_sorted passes over an idle source", "[merge_sorted][merge][operators]"){
+    GIVEN("2 hot observables of ordered ints, one of them silent for a while."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs1 = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 3),
+            on.next(230, 5),
+            on.completed(600)
+        });
+        auto xs2 = sc.make_hot_observable({
+            on.next(215, 2),
+            on.next(500, 4),
+            on.completed(550)
+        });
+
+        WHEN("they are merged with an idle time of 50ms"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs1
+                        .merge_sorted(std::less<int>(), milliseconds(50), so, xs2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the values of the active source are sent once the other is idle, and a late value is sent at once"){
+                auto required = rxu::to_vector({
+                    on.next(215, 1),
+                    on.next(220, 2),
+                    on.next(300, 3),
+                    on.next(300, 5),
+                    on.next(500, 4),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("merge_sorted of a vector of sources", "[merge_sorted][merge][operators]"){
+    GIVEN("4 ordered sources that take turns"){
+        std::vector<rx::observable<int>> sources;
+        for (int i = 0; i != 4; ++i) {
+            std::vector<int> values;
+            for (int v = i; v < 40; v += 4) {
+                values.push_back(v);
+            }
+            sources.push_back(rxs::iterate(values).as_dynamic());
+        }
+
+        WHEN("they are merged in order"){
+            std::vector<int> merged;
+            rx::observable<>::merge_sorted(std::less<int>(), sources)
+                .subscribe([&](int v){merged.push_back(v);});
+
+            THEN("the output contains every value in order"){
+                std::vector<int> required;
+                for (int v = 0; v < 40; ++v) {
+                    required.push_back(v);
+                }
+                REQUIRE(merged == required);
+            }
+        }
+    }
+}
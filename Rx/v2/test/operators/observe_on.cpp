@@ -53,3 +53,291 @@ SCENARIO("range observed on current_thread", "[hide][range][observe_on_debug][ob
         }
     }
 }
+
+SCENARIO("observe_on delivers bursts in batches", "[observe_on][operators]"){
+    GIVEN("a source with bursts of values"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(210, 4),
+            on.next(220, 5),
+            on.next(220, 6),
+            on.next(230, 7),
+            on.completed(250)
+        });
+
+        WHEN("the values are observed on the test worker two at a time"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .observe_on(rx::identity_one_worker(sc), 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains all the values in order, each drain delivering two"){
+                // the test scheduler advances one tick each time the drain yields
+                auto required = rxu::to_vector({
+                    on.next(211, 2),
+                    on.next(211, 3),
+                    on.next(212, 4),
+                    on.next(221, 5),
+                    on.next(221, 6),
+                    on.next(231, 7),
+                    on.completed(251)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("bounded observe_on drops the newest values", "[observe_on][operators]"){
+    GIVEN("a source with a burst larger than the queue"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(210, 4),
+            on.next(220, 5),
+            on.completed(250)
+        });
+
+        WHEN("observed with room for two values"){
+            rx::operators::queue_depth depth;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .observe_on(rx::identity_one_worker(sc), 2, rx::operators::overflow_policy::drop_newest, depth)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the values that did not fit were dropped"){
+                auto required = rxu::to_vector({
+                    on.next(211, 1),
+                    on.next(211, 2),
+                    on.next(221, 5),
+                    on.completed(251)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the depth counted the queue"){
+                REQUIRE(depth.current() == 0);
+                REQUIRE(depth.peak() == 2);
+                REQUIRE(depth.dropped() == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("bounded observe_on drops the oldest values", "[observe_on][operators]"){
+    GIVEN("a source with a burst larger than the queue"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(210, 4),
+            on.next(220, 5),
+            on.completed(250)
+        });
+
+        WHEN("observed with room for two values"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .observe_on(rx::identity_one_worker(sc), 2, rx::operators::overflow_policy::drop_oldest)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the newest values were kept"){
+                auto required = rxu::to_vector({
+                    on.next(211, 3),
+                    on.next(211, 4),
+                    on.next(221, 5),
+                    on.completed(251)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("bounded observe_on fails when full", "[observe_on][operators]"){
+    GIVEN("a source with a burst larger than the queue"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(220, 4),
+            on.completed(250)
+        });
+
+        WHEN("observed with room for two values"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .observe_on(rx::identity_one_worker(sc), 2, rx::operators::overflow_policy::error)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains an error"){
+                auto required = rxu::to_vector({
+                    on.error(211, rx::operators::queue_overflow_error())
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed when the error was delivered"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 211)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("bounded observe_on blocks the producer", "[observe_on][operators]"){
+    GIVEN("a range"){
+        WHEN("observed on a new thread with room for four values"){
+            std::atomic<bool> done(false);
+            std::vector<int> result;
+            rx::operators::queue_depth depth;
+
+            rxs::range<int>(1, 1000)
+                .observe_on(rx::observe_on_new_thread(), 4, rx::operators::overflow_policy::block_producer, depth)
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](){
+                        done = true;
+                    });
+            while (!done) {
+                std::this_thread::yield();
+            }
+
+            THEN("every value arrived in order and the queue stayed bounded"){
+                REQUIRE(result.size() == 1000);
+                REQUIRE(result.front() == 1);
+                REQUIRE(result.back() == 1000);
+                REQUIRE(depth.dropped() == 0);
+                // the queue plus the batch being delivered
+                REQUIRE(depth.peak() <= 4 + 16);
+            }
+        }
+    }
+}
+
+SCENARIO("observe_on requests values from its source", "[observe_on][demand][operators]"){
+    GIVEN("a collection that honors demand"){
+        std::vector<int> values;
+        for (int i = 1; i <= 1000; ++i) {
+            values.push_back(i);
+        }
+
+        WHEN("observed on a new thread with a window of four"){
+            std::atomic<bool> done(false);
+            std::vector<int> result;
+            rx::demand pull;
+            size_t most = 0;
+
+            rxs::iterate(values, rx::identity_current_thread(), pull)
+                .observe_on(rx::observe_on_new_thread(), pull, 4)
+                .subscribe(
+                    [&](int v){
+                        most = (std::max)(most, pull.outstanding());
+                        result.push_back(v);
+                    },
+                    [&](){
+                        done = true;
+                    });
+            while (!done) {
+                std::this_thread::yield();
+            }
+
+            THEN("every value arrived in order without more than the window outstanding"){
+                REQUIRE(result == values);
+                REQUIRE(most <= 4);
+            }
+        }
+    }
+}
+
+SCENARIO("observe_on delivers in place on its own worker", "[observe_on][operators]"){
+    GIVEN("a current_thread worker"){
+        auto w = rxsc::make_current_thread().create_worker();
+        std::vector<int> result;
+        std::vector<int> inside;
+        bool completed = false;
+
+        WHEN("values are observed on current_thread from inside an action on it"){
+            w.schedule([&](const rxsc::schedulable&){
+                rxs::create<int>([](rx::subscriber<int> s){
+                        s.on_next(1);
+                        s.on_next(2);
+                        s.on_completed();
+                    })
+                    .observe_on(rx::observe_on_one_worker(rxsc::make_current_thread()))
+                    .subscribe(
+                        [&](int v){
+                            result.push_back(v);
+                        },
+                        [&](){
+                            completed = true;
+                        });
+                inside = result;
+            });
+
+            THEN("the values arrived before subscribe returned"){
+                REQUIRE(inside == rxu::to_vector({1, 2}));
+            }
+            THEN("the stream completed after them"){
+                REQUIRE(result == rxu::to_vector({1, 2}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("observe_on_latest delivers the latest value once per dispatch", "[observe_on_latest][observe_on][operators]"){
+    GIVEN("a subject observed on a run_loop"){
+        rxsc::run_loop rl;
+        rxsub::subject<int> sub;
+        std::vector<int> result;
+        bool completed = false;
+
+        sub.get_observable()
+            .observe_on_latest(rx::observe_on_run_loop(rl))
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+        auto o = sub.get_subscriber();
+
+        WHEN("values arrive faster than the loop is dispatched"){
+            o.on_next(1);
+            o.on_next(2);
+            o.on_next(3);
+            REQUIRE(rl.dispatch() == 1);
+            o.on_next(4);
+            o.on_next(5);
+            o.on_completed();
+            while (!rl.empty()) {
+                rl.dispatch();
+            }
+
+            THEN("each dispatch delivered only the latest value"){
+                REQUIRE(result == rxu::to_vector({3, 5}));
+            }
+            THEN("the completion followed the last value"){
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("observe_on_latest merges the waiting values", "[observe_on_latest][observe_on][operators]"){
+    GIVEN("a subject observed on a run_loop with a sum"){
+        rxsc::run_loop rl;
+        rxsub::subject<int> sub;
+        std::vector<int> result;
+
+        sub.get_observable()
+            .observe_on_latest(rx::observe_on_run_loop(rl), [](int waiting, int next){return waiting + next;})
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                });
+        auto o = sub.get_subscriber();
+
+        WHEN("values arrive between dispatches"){
+            o.on_next(1);
+            o.on_next(2);
+            o.on_next(3);
+            rl.dispatch();
+            o.on_next(4);
+            rl.dispatch();
+
+            THEN("each delivery is the sum of the values since the last one"){
+                REQUIRE(result == rxu::to_vector({6, 4}));
+            }
+        }
+    }
+}
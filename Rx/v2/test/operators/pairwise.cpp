@@ -48,3 +48,26 @@ SCENARIO("pairwise", "[pairwise][operators]") {
         }
     }
 }
+
+SCENARIO("pairwise shared", "[pairwise][operators]") {
+    GIVEN("a source of strings") {
+        auto xs = rxcpp::observable<>::iterate(rxu::to_vector({std::string("a"), std::string("b"), std::string("c")}));
+
+        WHEN("taken pairwise with shared values") {
+            std::vector<std::tuple<std::shared_ptr<const std::string>, std::shared_ptr<const std::string>>> pairs;
+            xs
+                .pairwise_shared()
+                .subscribe([&](std::tuple<std::shared_ptr<const std::string>, std::shared_ptr<const std::string>> p){
+                    pairs.push_back(std::move(p));
+                });
+
+            THEN("the value in the middle is shared by both pairs"){
+                REQUIRE(pairs.size() == 2);
+                REQUIRE(*std::get<0>(pairs[0]) == "a");
+                REQUIRE(*std::get<1>(pairs[0]) == "b");
+                REQUIRE(*std::get<1>(pairs[1]) == "c");
+                REQUIRE(std::get<1>(pairs[0]) == std::get<0>(pairs[1]));
+            }
+        }
+    }
+}
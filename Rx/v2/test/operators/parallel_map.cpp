@@ -0,0 +1,192 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("parallel_map stops on error", "[parallel_map][map][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("parallel_map on_error from selector");
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.completed(300)
+        });
+
+        WHEN("the selector throws for the third item"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_map([ex](int v){
+                            if (v == 4) {
+                                throw ex;
+                            }
+                            return v * 10;
+                        }, so, 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the items before the error, each one tick later on the worker"){
+                auto required = rxu::to_vector({
+                    on.next(211, 20),
+                    on.next(221, 30),
+                    on.error(231, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed at the error"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 231)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_map keeps the source order", "[parallel_map][map][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(220, 4),
+            on.completed(300)
+        });
+
+        WHEN("each item is mapped on one of 3 workers"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_map([](int v){return v + 1;}, so, 3)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the mapped items in order, each one tick later on the worker"){
+                auto required = rxu::to_vector({
+                    on.next(211, 2),
+                    on.next(211, 3),
+                    on.next(211, 4),
+                    on.next(221, 5),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_map on threads", "[parallel_map][map][operators]"){
+    GIVEN("a range of 1000 ints"){
+        auto xs = rx::observable<>::range(1, 1000);
+
+        WHEN("each item is mapped on 4 threads in order"){
+            std::vector<int> actual;
+            xs
+                .parallel_map([](int v){return v * 2;}, rx::observe_on_event_loop(), 4)
+                .as_blocking()
+                .subscribe([&](int v){actual.push_back(v);});
+
+            THEN("every mapped item arrived in order"){
+                std::vector<int> required;
+                for (int i = 1; i <= 1000; ++i) {
+                    required.push_back(i * 2);
+                }
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("each item is mapped on 4 threads without order"){
+            std::vector<int> actual;
+            xs
+                .parallel_map([](int v){return v * 2;}, rx::observe_on_event_loop(), 4, false)
+                .as_blocking()
+                .subscribe([&](int v){actual.push_back(v);});
+
+            THEN("every mapped item arrived once"){
+                std::sort(actual.begin(), actual.end());
+                std::vector<int> required;
+                for (int i = 1; i <= 1000; ++i) {
+                    required.push_back(i * 2);
+                }
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("partition_map keeps the order of each key", "[partition_map][parallel_map][map][operators]"){
+    GIVEN("a range of 1000 ints keyed by the last digit"){
+        auto xs = rx::observable<>::range(1, 1000);
+
+        WHEN("each key keeps a running count on 4 threads"){
+            // each key is only used from the worker of its lane
+            auto counts = std::make_shared<std::vector<int>>(10, 0);
+            std::vector<std::pair<int, int>> actual;
+            xs
+                .partition_map(
+                    [](int v){return v % 10;},
+                    [counts](int v){return std::make_pair(v, ++(*counts)[v % 10]);},
+                    rx::observe_on_event_loop(), 4)
+                .as_blocking()
+                .subscribe([&](std::pair<int, int> v){actual.push_back(v);});
+
+            THEN("the items of each key arrived in order with their count"){
+                REQUIRE(actual.size() == 1000);
+                std::vector<int> last(10, 0);
+                for (auto& v : actual) {
+                    auto key = v.first % 10;
+                    REQUIRE(v.first > last[key]);
+                    last[key] = v.first;
+                    REQUIRE(v.second == (v.first + 9) / 10);
+                }
+            }
+        }
+
+        WHEN("the key selector throws"){
+            std::runtime_error ex("partition_map on_error from key selector");
+            std::vector<int> actual;
+            std::exception_ptr error;
+            xs
+                .partition_map(
+                    [ex](int v){if (v == 500) {throw ex;} return v % 10;},
+                    [](int v){return v;},
+                    rx::observe_on_event_loop(), 4, true)
+                .as_blocking()
+                .subscribe(
+                    [&](int v){actual.push_back(v);},
+                    [&](std::exception_ptr e){error = e;});
+
+            THEN("the output stops on error"){
+                REQUIRE(!!error);
+                REQUIRE(actual.size() < 500);
+            }
+        }
+    }
+}
@@ -367,3 +367,160 @@ SCENARIO("publish basic with initial value", "[publish][multicast][behavior][ope
         }
     }
 }
+
+SCENARIO("publish_ring", "[publish_ring][multicast][subject][operators]"){
+    GIVEN("a range published through a ring"){
+        auto published = rxs::range<int>(1, 1000).publish_ring(16, rx::observe_on_new_thread());
+
+        std::atomic<int> completed(0);
+        long first = 0, second = 0;
+        published.subscribe([&](int v){first += v;}, [&](){++completed;});
+        published.subscribe([&](int v){second += v;}, [&](){++completed;});
+
+        WHEN("connected"){
+            published.connect();
+            while (completed != 2) {
+                std::this_thread::yield();
+            }
+
+            THEN("each subscriber receives every value"){
+                REQUIRE(first == 500500);
+                REQUIRE(second == 500500);
+            }
+        }
+    }
+}
+
+SCENARIO("connect_all", "[publish][multicast][subject][operators]"){
+    GIVEN("two test hot observables of ints"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(230, 2),
+            on.next(250, 3),
+            on.completed(300)
+        });
+        auto ys = sc.make_hot_observable({
+            on.next(220, 10),
+            on.next(240, 20),
+            on.next(260, 30),
+            on.completed(300)
+        });
+
+        auto res = w.make_subscriber<int>();
+
+        WHEN("published, subscribed and connected together"){
+
+            auto xp = xs.publish();
+            auto yp = ys.publish();
+            rx::composite_subscription connection;
+
+            w.schedule_absolute(rxsc::test::subscribed_time,
+                [&](const rxsc::schedulable&){
+                    xp.merge(yp).subscribe(res);
+                });
+
+            w.schedule_absolute(200,
+                [&](const rxsc::schedulable&){
+                    connection = rx::connect_all(xp, yp);
+                    // a second connect of a connected feed is ignored
+                    rx::connect_all(connection, xp);
+                });
+
+            w.schedule_absolute(245,
+                [&](const rxsc::schedulable&){
+                    connection.unsubscribe();
+                });
+
+            w.start();
+
+            THEN("the output contains the values of both until the disconnect"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 10),
+                    on.next(230, 2),
+                    on.next(240, 20)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription to each source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 245)
+                });
+                REQUIRE(required == xs.subscriptions());
+                REQUIRE(required == ys.subscriptions());
+            }
+        }
+
+        WHEN("connected together and one feed ends before the other"){
+
+            auto early = sc.make_hot_observable({
+                on.next(210, 1),
+                on.completed(230)
+            });
+            auto ep = early.publish();
+            auto yp = ys.publish();
+            std::vector<int> values;
+            int completions = 0;
+            ep.subscribe([&](int v){ values.push_back(v); }, [&](){ ++completions; });
+            yp.subscribe([&](int v){ values.push_back(v); }, [&](){ ++completions; });
+
+            w.schedule_absolute(200,
+                [&](const rxsc::schedulable&){
+                    rx::connect_all(ep, yp);
+                });
+
+            w.start();
+
+            THEN("the other feed sends its values and its completion"){
+                REQUIRE(values == rxu::to_vector({1, 10, 20, 30}));
+                REQUIRE(completions == 2);
+            }
+
+            THEN("the other feed stayed subscribed to its source until it completed"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                REQUIRE(required == ys.subscriptions());
+            }
+        }
+
+        WHEN("feeds of one type are connected from a vector"){
+
+            std::vector<decltype(xs.publish())> feeds{xs.publish(), xs.publish()};
+            std::vector<int> values;
+            for (auto& feed : feeds) {
+                feed.subscribe([&](int v){ values.push_back(v); });
+            }
+
+            rx::composite_subscription connection;
+            w.schedule_absolute(200,
+                [&](const rxsc::schedulable&){
+                    rx::connect_all(connection, feeds);
+                });
+            w.schedule_absolute(235,
+                [&](const rxsc::schedulable&){
+                    connection.unsubscribe();
+                });
+
+            w.start();
+
+            THEN("each feed sends the values until the disconnect"){
+                REQUIRE(values == rxu::to_vector({1, 1, 2, 2}));
+            }
+
+            THEN("each feed subscribed to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 235),
+                    on.subscribe(200, 235)
+                });
+                REQUIRE(required == xs.subscriptions());
+            }
+        }
+    }
+}
@@ -104,3 +104,323 @@ SCENARIO("average some data", "[reduce][average][operators]"){
         }
     }
 }
+
+SCENARIO("min and max of some data", "[reduce][min][max][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 3),
+            on.next(220, -2),
+            on.next(230, 7),
+            on.next(240, 0),
+            on.completed(250)
+        });
+
+        WHEN("the smallest int is taken"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .min()
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output is the smallest int"){
+                auto required = rxu::to_vector({
+                    on.next(250, -2),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the largest int is taken"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .max()
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output is the largest int"){
+                auto required = rxu::to_vector({
+                    on.next(250, 7),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+    GIVEN("an empty source"){
+        WHEN("the largest int is taken"){
+            bool failed = false;
+            rxcpp::sources::iterate(std::vector<int>())
+                .max()
+                .subscribe(
+                    [](int){},
+                    [&](std::exception_ptr){failed = true;});
+
+            THEN("the output is an error"){
+                REQUIRE(failed);
+            }
+        }
+    }
+}
+
+SCENARIO("batched sum, min, max and average", "[reduce][min][max][average][operators]"){
+    GIVEN("a collection of floats that is sent in batches"){
+        std::vector<float> samples;
+        for (int i = 0; i < 1000; ++i) {
+            samples.push_back(static_cast<float>((i * 37) % 101));
+        }
+        std::vector<int> counts;
+        for (int i = 0; i < 1000; ++i) {
+            counts.push_back((i * 37) % 101 - 50);
+        }
+
+        WHEN("the floats are reduced"){
+            auto xs = rxcpp::sources::iterate(samples);
+
+            THEN("the results match a fold of each value"){
+                float sum = 0;
+                for (auto v : samples) {
+                    sum += v;
+                }
+                REQUIRE(sum == xs.sum().as_blocking().last());
+                REQUIRE(0.0f == xs.min().as_blocking().last());
+                REQUIRE(100.0f == xs.max().as_blocking().last());
+                REQUIRE(sum / samples.size() == xs.average().as_blocking().last());
+            }
+        }
+
+        WHEN("the ints are reduced"){
+            auto xs = rxcpp::sources::iterate(counts);
+
+            THEN("the results match a fold of each value"){
+                int sum = 0;
+                for (auto v : counts) {
+                    sum += v;
+                }
+                REQUIRE(sum == xs.sum().as_blocking().last());
+                REQUIRE(-50 == xs.min().as_blocking().last());
+                REQUIRE(50 == xs.max().as_blocking().last());
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_reduce a range and a collection", "[reduce][parallel_reduce][operators]"){
+    GIVEN("a range and a vector of strings"){
+        auto el = rxcpp::observe_on_event_loop();
+        auto plus = [](long long s, int v){return s + v;};
+        auto add = [](long long a, long long b){return a + b;};
+
+        std::vector<std::string> words;
+        for (int i = 0; i < 1000; ++i) {
+            words.push_back(std::to_string(i % 10));
+        }
+        std::string joined;
+        for (auto& w : words) {
+            joined += w;
+        }
+
+        WHEN("the range is summed on the event loop"){
+            auto sum = rxcpp::sources::range(1, 100000)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            THEN("the sum is the same as a sequential sum"){
+                REQUIRE(5000050000LL == sum);
+            }
+        }
+
+        WHEN("a range that ends between steps is summed on the event loop"){
+            auto sum = rxcpp::sources::range(1, 100000, 7, rxcpp::identity_current_thread())
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            auto expected = rxcpp::sources::range(1, 100000, 7, rxcpp::identity_current_thread())
+                .reduce(0LL, plus, [](long long s){return s;})
+                .as_blocking()
+                .last();
+
+            THEN("the sum includes the last value"){
+                REQUIRE(expected == sum);
+            }
+        }
+
+        WHEN("the strings are joined on the event loop"){
+            auto result = rxcpp::sources::iterate(words)
+                .parallel_reduce(std::string(),
+                    [](std::string s, std::string w){return s + w;},
+                    [](std::string a, std::string b){return a + b;},
+                    el)
+                .as_blocking()
+                .last();
+
+            THEN("the parts are combined in order"){
+                REQUIRE(joined == result);
+            }
+        }
+
+        WHEN("a source that cannot be partitioned is summed"){
+            auto sum = rxcpp::sources::range(1, 100)
+                .map([](int v){return v;})
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            THEN("the items are reduced in sequence"){
+                REQUIRE(5050 == sum);
+            }
+        }
+
+        WHEN("slices of a collection are summed"){
+            auto v = rxu::to_vector({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+            auto skipped = rxcpp::sources::iterate(v)
+                .skip(5)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+            auto taken = rxcpp::sources::iterate(v)
+                .take(2)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+            auto middle = rxcpp::sources::iterate(v)
+                .skip(2)
+                .take(5)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+            auto past = rxcpp::sources::iterate(v)
+                .skip(50)
+                .parallel_reduce(42LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            THEN("only the values in the slice are summed"){
+                REQUIRE(40 == skipped);
+                REQUIRE(3 == taken);
+                REQUIRE(25 == middle);
+                REQUIRE(42 == past);
+            }
+        }
+
+        WHEN("slices of a range are summed"){
+            auto skipped = rxcpp::sources::range(1, 10)
+                .skip(5)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+            auto taken = rxcpp::sources::range(1, 10)
+                .take(2)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+            auto past = rxcpp::sources::range(1, 10)
+                .skip(50)
+                .parallel_reduce(0LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            THEN("only the values in the slice are summed"){
+                REQUIRE(40 == skipped);
+                REQUIRE(3 == taken);
+                REQUIRE(0 == past);
+            }
+        }
+
+        WHEN("an empty collection is summed"){
+            auto sum = rxcpp::sources::iterate(std::vector<int>())
+                .parallel_reduce(42LL, plus, add, el)
+                .as_blocking()
+                .last();
+
+            THEN("the result is the seed"){
+                REQUIRE(42 == sum);
+            }
+        }
+    }
+}
+
+namespace {
+// counts the copies of the seed
+struct counted_seed
+{
+    explicit counted_seed(std::shared_ptr<int> c)
+        : copies(std::move(c))
+    {
+    }
+    counted_seed(const counted_seed& o)
+        : copies(o.copies)
+        , values(o.values)
+    {
+        ++*copies;
+    }
+    counted_seed& operator=(const counted_seed& o) {
+        copies = o.copies;
+        values = o.values;
+        ++*copies;
+        return *this;
+    }
+    std::shared_ptr<int> copies;
+    std::vector<int> values;
+};
+}
+
+SCENARIO("reduce and scan with an accumulator that updates the seed in place", "[reduce][scan][operators]"){
+    GIVEN("a range of 1000 ints"){
+        auto xs = rxcpp::sources::range(1, 1000);
+        auto push = [](counted_seed& s, int v){s.values.push_back(v);};
+
+        WHEN("reduced into a vector"){
+            auto copies = std::make_shared<int>(0);
+            auto result = xs
+                .reduce(counted_seed(copies), push, [](const counted_seed& s){return s.values.size();})
+                .as_blocking()
+                .last();
+
+            THEN("every item was added and the seed was not copied for each item"){
+                REQUIRE(result == 1000);
+                REQUIRE(*copies < 100);
+            }
+        }
+
+        WHEN("scanned into a running sum in place"){
+            std::vector<int> sums;
+            xs
+                .take(4)
+                .scan(0, [](int& sum, int v){sum += v;})
+                .subscribe([&](int s){sums.push_back(s);});
+
+            THEN("each running sum was emitted"){
+                REQUIRE(sums == std::vector<int>({1, 3, 6, 10}));
+            }
+        }
+
+        WHEN("summed in place on the event loop"){
+            auto sum = xs
+                .parallel_reduce(0LL, [](long long& s, int v){s += v;}, [](long long a, long long b){return a + b;}, rxcpp::observe_on_event_loop())
+                .as_blocking()
+                .last();
+
+            THEN("the sum is the same as a sequential sum"){
+                REQUIRE(500500LL == sum);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// a source that counts the subscriptions to it and the ones that have ended
+struct counted
+{
+    std::shared_ptr<int> subscribed = std::make_shared<int>(0);
+    std::shared_ptr<int> ended = std::make_shared<int>(0);
+
+    rx::observable<int> source() const {
+        auto s = subscribed;
+        auto e = ended;
+        return rx::observable<>::create<int>([s, e](rx::subscriber<int> out){
+            ++*s;
+            out.add([e](){++*e;});
+        });
+    }
+};
+}
+
+SCENARIO("ref_count connects for the first subscriber and disconnects after the last", "[ref_count][publish][operators]"){
+    GIVEN("a published source that counts its subscriptions"){
+        counted c;
+        auto shared = c.source().publish().ref_count();
+
+        WHEN("two subscribers come and go"){
+            rx::composite_subscription first, second;
+            shared.subscribe(first, [](int){});
+            shared.subscribe(second, [](int){});
+            auto connected = *c.subscribed;
+            first.unsubscribe();
+            auto ended_after_first = *c.ended;
+            second.unsubscribe();
+
+            THEN("the source was subscribed once"){
+                REQUIRE(connected == 1);
+            }
+            THEN("the source was unsubscribed after the last subscriber"){
+                REQUIRE(ended_after_first == 0);
+                REQUIRE(*c.ended == 1);
+            }
+        }
+
+        WHEN("a subscriber arrives after the last has gone"){
+            rx::composite_subscription first, second;
+            shared.subscribe(first, [](int){});
+            first.unsubscribe();
+            shared.subscribe(second, [](int){});
+            second.unsubscribe();
+
+            THEN("the source was subscribed again"){
+                REQUIRE(*c.subscribed == 2);
+                REQUIRE(*c.ended == 2);
+            }
+        }
+
+        WHEN("subscribers come and go on several threads"){
+            const int threads = 4;
+            const int subscribes = 500;
+            std::vector<std::thread> workers;
+            for (int t = 0; t != threads; ++t) {
+                workers.push_back(std::thread([&](){
+                    for (int i = 0; i != subscribes; ++i) {
+                        rx::composite_subscription cs;
+                        shared.subscribe(cs, [](int){});
+                        cs.unsubscribe();
+                    }
+                }));
+            }
+            // keep one subscriber until the threads are done
+            rx::composite_subscription held;
+            shared.subscribe(held, [](int){});
+            for (auto& t : workers) {
+                t.join();
+            }
+            auto connected = *c.subscribed - *c.ended;
+            held.unsubscribe();
+
+            THEN("the source was connected for the held subscriber"){
+                REQUIRE(connected == 1);
+            }
+            THEN("the source was disconnected at the end"){
+                REQUIRE(*c.subscribed == *c.ended);
+            }
+        }
+    }
+}
+
+SCENARIO("ref_count with a grace period", "[ref_count][publish][operators]"){
+    GIVEN("a published source that counts its subscriptions and a grace of 100"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        counted c;
+        auto shared = c.source().publish().ref_count(std::chrono::milliseconds(100), rx::identity_one_worker(sc));
+
+        WHEN("a subscriber arrives within the grace after the last has gone"){
+            rx::composite_subscription first, second;
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){shared.subscribe(first, [](int){});});
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){first.unsubscribe();});
+            w.schedule_absolute(250, [&](const rxsc::schedulable&){shared.subscribe(second, [](int){});});
+            w.schedule_absolute(260, [&](const rxsc::schedulable&){second.unsubscribe();});
+
+            w.advance_to(330);
+            auto ended_within_grace = *c.ended;
+            w.advance_to(400);
+
+            THEN("the source was subscribed once"){
+                REQUIRE(*c.subscribed == 1);
+            }
+            THEN("the source was kept until the grace after the last unsubscribe"){
+                REQUIRE(ended_within_grace == 0);
+                REQUIRE(*c.ended == 1);
+            }
+        }
+    }
+}
@@ -345,3 +345,30 @@ SCENARIO("countable repeat, error test", "[repeat][operators]"){
         }
     }
 }
+
+SCENARIO("repeat, finished iterations are released", "[repeat][operators]"){
+    GIVEN("a source of one value repeated forever"){
+        rxcpp::composite_subscription cs;
+        int count = 0;
+        size_t children = 0;
+
+        WHEN("it has run 1000 iterations"){
+            rxcpp::observable<>::just(1)
+                .repeat()
+                .subscribe(
+                    cs,
+                    [&](int){
+                        if (++count == 1000) {
+                            // the index of a new child is the count of the children
+                            children = cs.add(rxcpp::composite_subscription()).index;
+                            cs.unsubscribe();
+                        }
+                    });
+
+            THEN("the outer subscription holds only the current iteration"){
+                REQUIRE(count == 1000);
+                REQUIRE(children <= 2);
+            }
+        }
+    }
+}
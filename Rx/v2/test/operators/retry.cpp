@@ -144,3 +144,155 @@ SCENARIO("retry with failure", "[retry][operators]") {
 }
 
 
+
+SCENARIO("retry with backoff", "[retry][operators]") {
+    GIVEN("hot observable of 3x4x7 ints with errors inbetween the groups. Infinite retry with backoff.") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        std::runtime_error ex("retry on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(300, 1),
+            on.next(325, 2),
+            on.next(350, 3),
+            on.error(400, ex),
+            on.next(405, -1),
+            on.next(425, 1),
+            on.next(450, 2),
+            on.error(525, ex),
+            on.next(540, -1),
+            on.next(550, 1),
+            on.completed(725)
+        });
+
+        WHEN("the backoff starts at 10 ticks without jitter") {
+
+            auto res = w.start(
+                [&]() {
+                return xs
+                    .retry(0, rxcpp::operators::exponential_backoff(std::chrono::milliseconds(10), std::chrono::milliseconds(100), 0), rxcpp::identity_one_worker(sc))
+                    // forget type to workaround lambda deduction bug on msvc 2013
+                    .as_dynamic();
+            }
+            );
+
+            THEN("the values sent while waiting to retry were missed") {
+                auto required = rxu::to_vector({
+                    on.next(300, 1),
+                    on.next(325, 2),
+                    on.next(350, 3),
+                    on.next(425, 1),
+                    on.next(450, 2),
+                    on.next(550, 1),
+                    on.completed(725)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("each retry waited twice as long as the one before") {
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 400),
+                    on.subscribe(410, 525),
+                    on.subscribe(545, 725)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+
+    GIVEN("a cold observable that always fails. Retry twice with backoff.") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        std::runtime_error ex("retry on_error from source");
+
+        auto xs = sc.make_cold_observable({
+            on.next(10, 1),
+            on.error(20, ex)
+        });
+
+        WHEN("the backoff is capped at 30 ticks") {
+
+            auto res = w.start(
+                [&]() {
+                return xs
+                    .retry(3, rxcpp::operators::exponential_backoff(std::chrono::milliseconds(20), std::chrono::milliseconds(30), 0), rxcpp::identity_one_worker(sc))
+                    // forget type to workaround lambda deduction bug on msvc 2013
+                    .as_dynamic();
+            }
+            );
+
+            THEN("the error was sent after the last retry") {
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(250, 1),
+                    on.next(300, 1),
+                    on.next(350, 1),
+                    on.error(360, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the delays grew to the cap") {
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 220),
+                    on.subscribe(240, 260),
+                    on.subscribe(290, 310),
+                    on.subscribe(340, 360)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+
+    GIVEN("a backoff with jitter") {
+        rxcpp::operators::exponential_backoff backoff(std::chrono::milliseconds(100), std::chrono::milliseconds(1000), 0.5);
+        std::minstd_rand random(1);
+
+        WHEN("delays are taken for a few attempts") {
+            THEN("each delay is between half and all of the exponential delay") {
+                for (int attempt = 0; attempt != 6; ++attempt) {
+                    auto full = std::min(std::chrono::milliseconds(100 << attempt), std::chrono::milliseconds(1000));
+                    auto delay = backoff.delay(attempt, random);
+                    REQUIRE(delay <= full);
+                    REQUIRE(delay >= full / 2);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("retry, finished iterations are released", "[retry][operators]") {
+    GIVEN("a source of one value and an error retried forever") {
+        rxcpp::composite_subscription cs;
+        int count = 0;
+        size_t children = 0;
+
+        WHEN("it has run 1000 iterations") {
+            rxcpp::observable<>::create<int>([](rxcpp::subscriber<int> s){
+                    s.on_next(1);
+                    s.on_error(std::make_exception_ptr(std::runtime_error("retry")));
+                })
+                .retry()
+                .subscribe(
+                    cs,
+                    [&](int){
+                        if (++count == 1000) {
+                            // the index of a new child is the count of the children
+                            children = cs.add(rxcpp::composite_subscription()).index;
+                            cs.unsubscribe();
+                        }
+                    });
+
+            THEN("the outer subscription holds only the current iteration") {
+                REQUIRE(count == 1000);
+                REQUIRE(children <= 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("sample", "[sample][operators]"){
+    GIVEN("a source with two bursts and a late item"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(300, 3),
+            on.next(310, 4),
+            on.next(320, 5),
+            on.next(500, 6),
+            on.completed(600)
+        });
+
+        WHEN("the period is 95"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sample(std::chrono::milliseconds(95), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the most recent item was emitted at the end of each period that had one"){
+                auto required = rxu::to_vector({
+                    on.next(295, 2),
+                    on.next(390, 5),
+                    on.next(580, 6),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
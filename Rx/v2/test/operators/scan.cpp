@@ -310,3 +310,33 @@ SCENARIO("scan: seed, accumulator throws", "[scan][operators]"){
         }
     }
 }
+
+SCENARIO("scan: each subscription accumulates from the seed", "[scan][operators]"){
+    GIVEN("a scan over a range"){
+        auto sums = rxcpp::sources::range(1, 100)
+            .scan(0, [](int sum, int x){return sum + x;});
+        WHEN("it is subscribed twice"){
+            std::vector<int> first, second;
+            sums.subscribe([&](int s){first.push_back(s);});
+            sums.subscribe([&](int s){second.push_back(s);});
+            THEN("both receive the same sums"){
+                REQUIRE(first.size() == 100);
+                REQUIRE(first.back() == 5050);
+                REQUIRE(first == second);
+            }
+        }
+        WHEN("it is unsubscribed from an on_next"){
+            std::vector<int> values;
+            rxcpp::composite_subscription cs;
+            sums.subscribe(cs, [&](int s){
+                values.push_back(s);
+                if (values.size() == 3) {
+                    cs.unsubscribe();
+                }
+            });
+            THEN("it stops"){
+                REQUIRE(values == std::vector<int>({1, 3, 6}));
+            }
+        }
+    }
+}
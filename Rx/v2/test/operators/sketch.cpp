@@ -0,0 +1,145 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("approx_distinct_count estimates the distinct items", "[approx_distinct_count][sketch][reduce][operators]"){
+    GIVEN("a range with each value repeated"){
+        auto values = rxs::range(0, 49999).map([](int v){return v % 20000;});
+
+        WHEN("the distinct values are counted"){
+            auto count = values.approx_distinct_count().as_blocking().last();
+
+            THEN("the estimate is within 5% of the count"){
+                REQUIRE(count > 19000);
+                REQUIRE(count < 21000);
+            }
+        }
+    }
+    GIVEN("a few values"){
+        auto values = rxs::from(1, 2, 3, 2, 1, 4, 5, 6, 7, 8);
+
+        WHEN("the distinct values are counted"){
+            auto count = values.approx_distinct_count().as_blocking().last();
+
+            THEN("the estimate is the count"){
+                REQUIRE(8 == count);
+            }
+        }
+    }
+}
+
+SCENARIO("hyperloglog sketches built in parts merge", "[approx_distinct_count][sketch][parallel_reduce][reduce][operators]"){
+    GIVEN("a range on the event loop"){
+        auto el = rx::observe_on_event_loop();
+
+        WHEN("the sketch is built in parts"){
+            auto sketch = rxs::range(1, 100000, 1, rx::identity_current_thread())
+                .parallel_reduce(rxo::hyperloglog<int>(), rxo::sketch_add(), rxo::sketch_merge(), el)
+                .as_blocking()
+                .last();
+
+            THEN("the estimate is within 5% of the count"){
+                REQUIRE(sketch.estimate() > 95000);
+                REQUIRE(sketch.estimate() < 105000);
+            }
+        }
+    }
+}
+
+SCENARIO("heavy_hitters finds the most frequent items", "[heavy_hitters][sketch][reduce][operators]"){
+    GIVEN("two frequent values among many that occur once"){
+        std::vector<int> values;
+        for (int i = 0; i != 2000; ++i) {
+            values.push_back(100 + i);
+            if (i % 4 == 0) {
+                values.push_back(7);
+            }
+            if (i % 8 == 0) {
+                values.push_back(3);
+            }
+        }
+
+        WHEN("the top 2 are found"){
+            auto top = rxs::iterate(values).heavy_hitters(2).as_blocking().last();
+
+            THEN("they are the frequent values, the most frequent first"){
+                REQUIRE(2 == top.size());
+                REQUIRE(7 == top[0].first);
+                REQUIRE(500 <= top[0].second);
+                REQUIRE(3 == top[1].first);
+                REQUIRE(250 <= top[1].second);
+            }
+        }
+
+        WHEN("the sketches of two halves are merged"){
+            rxo::top_k<int> first(2);
+            rxo::top_k<int> second(2);
+            for (size_t i = 0; i != values.size(); ++i) {
+                (i < values.size() / 2 ? first : second).add(values[i]);
+            }
+            first.merge(second);
+            auto top = first.values();
+
+            THEN("they are the frequent values, the most frequent first"){
+                REQUIRE(2 == top.size());
+                REQUIRE(7 == top[0].first);
+                REQUIRE(3 == top[1].first);
+            }
+        }
+    }
+}
+
+SCENARIO("approx_quantiles estimates the quantiles", "[approx_quantiles][sketch][reduce][operators]"){
+    GIVEN("a range"){
+        auto values = rxs::range(1, 10000);
+
+        WHEN("the quantiles are estimated"){
+            auto qs = values.approx_quantiles(rxu::to_vector({0.0, 0.5, 0.99, 1.0})).as_blocking().last();
+
+            THEN("the estimates are close to the values"){
+                REQUIRE(4 == qs.size());
+                REQUIRE(1 == qs[0]);
+                REQUIRE(std::abs(qs[1] - 5000) < 100);
+                REQUIRE(std::abs(qs[2] - 9900) < 20);
+                REQUIRE(10000 == qs[3]);
+            }
+        }
+    }
+    GIVEN("digests of two parts"){
+        rxo::tdigest low;
+        rxo::tdigest high;
+        for (int i = 1; i <= 5000; ++i) {
+            low.add(i);
+            high.add(5000 + i);
+        }
+
+        WHEN("they are merged"){
+            low.merge(high);
+
+            THEN("the median is between the parts"){
+                REQUIRE(10000 == low.count());
+                REQUIRE(std::abs(low.quantile(0.5) - 5000) < 100);
+            }
+        }
+    }
+    GIVEN("an empty source"){
+        WHEN("the quantiles are estimated"){
+            bool failed = false;
+            rxs::iterate(std::vector<int>())
+                .approx_quantiles(rxu::to_vector({0.5}))
+                .subscribe(
+                    [](std::vector<double>){},
+                    [&](std::exception_ptr){failed = true;});
+
+            THEN("the output is an error"){
+                REQUIRE(failed);
+            }
+        }
+    }
+}
@@ -562,3 +562,50 @@ SCENARIO("skip_until, never never", "[skip_until][skip][operators]"){
         }
     }
 }
+
+SCENARIO("skip_until time", "[skip_until][skip][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto so = rxcpp::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        auto start = sc.now();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(230, 2),
+            on.next(250, 3),
+            on.completed(300)
+        });
+
+        WHEN("the time is 240"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .skip_until(start + std::chrono::milliseconds(240), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output skips the items before the time"){
+                auto required = rxu::to_vector({
+                    on.next(250, 3),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("sliding_aggregate over a count", "[sliding_aggregate][operators]") {
+    GIVEN("a cold observable of ints") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_cold_observable({
+            on.next(10, 1),
+            on.next(20, 2),
+            on.next(30, 3),
+            on.next(40, 4),
+            on.next(50, 5),
+            on.next(60, 6),
+            on.completed(70)
+        });
+
+        WHEN("the last 3 values are summed") {
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .sliding_aggregate(3, 0, [](int a, int b){return a + b;})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sum of the window for each value"){
+                auto delay = rxcpp::schedulers::test::subscribed_time;
+                auto required = rxu::to_vector({
+                    on.next(10 + delay, 1),
+                    on.next(20 + delay, 3),
+                    on.next(30 + delay, 6),
+                    on.next(40 + delay, 9),
+                    on.next(50 + delay, 12),
+                    on.next(60 + delay, 15),
+                    on.completed(70 + delay)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 270)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the window combines in order") {
+
+            const rxsc::test::messages<std::string> on_string;
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .map([](int v){return std::to_string(v);})
+                        .sliding_aggregate(2, std::string(), [](std::string a, std::string b){return a + b;})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output concatenates the window from oldest to newest"){
+                auto delay = rxcpp::schedulers::test::subscribed_time;
+                auto required = rxu::to_vector({
+                    on_string.next(10 + delay, "1"),
+                    on_string.next(20 + delay, "12"),
+                    on_string.next(30 + delay, "23"),
+                    on_string.next(40 + delay, "34"),
+                    on_string.next(50 + delay, "45"),
+                    on_string.next(60 + delay, "56"),
+                    on_string.completed(70 + delay)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate over a period", "[sliding_aggregate][operators]") {
+    GIVEN("a hot observable of ints") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(240, 3),
+            on.next(300, 4),
+            on.next(305, 5),
+            on.completed(400)
+        });
+
+        WHEN("the values of the last 50 ticks are summed") {
+
+            auto res = w.start(
+                [sc, xs]() {
+                    return xs
+                        .sliding_aggregate(std::chrono::milliseconds(50), 0, [](int a, int b){return a + b;}, rx::identity_one_worker(sc))
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sum of the recent values for each value"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 3),
+                    on.next(240, 6),
+                    on.next(300, 4),
+                    on.next(305, 9),
+                    on.completed(400)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include "rxcpp/rx.hpp"
+namespace rx = rxcpp;
+namespace rxu = rxcpp::util;
+namespace rxsc = rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("split_lines - lines across chunks", "[split][operators]"){
+    GIVEN("a source of chunks"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::string> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, "zero\n"),
+            on.next(210, "first\nsec"),
+            on.next(220, "o"),
+            on.next(230, "nd\r\n\nthi"),
+            on.next(240, "rd"),
+            on.completed(250)
+        });
+
+        WHEN("the chunks are split into lines"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .split_lines()
+                        .map([](rx::slice s){return s.str();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains each line when it ends"){
+                auto required = rxu::to_vector({
+                    on.next(210, "first"),
+                    on.next(230, "second"),
+                    on.next(230, ""),
+                    on.next(250, "third"),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("split - delimiter", "[split][operators]"){
+    GIVEN("a source of chunks"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::string> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, "a,b\r,"),
+            on.next(220, ",c,"),
+            on.completed(230)
+        });
+
+        WHEN("the chunks are split at commas"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .split(',')
+                        .map([](rx::slice s){return s.str();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains each part and keeps the '\\r'"){
+                auto required = rxu::to_vector({
+                    on.next(210, "a"),
+                    on.next(210, "b\r"),
+                    on.next(220, ""),
+                    on.next(220, "c"),
+                    on.completed(230)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("split_lines - lines share the chunk", "[split][operators]"){
+    GIVEN("a source of slices"){
+        auto chunk = rx::slice(std::string("one\ntwo\nthr"));
+        auto rest = rx::slice(std::string("ee\n"));
+
+        WHEN("the slices are split into lines"){
+            std::vector<rx::slice> lines;
+            rx::observable<>::iterate(rxu::to_vector({chunk, rest}))
+                .split_lines()
+                .subscribe([&](rx::slice s){lines.push_back(s);});
+
+            THEN("the lines inside a chunk are not copied"){
+                REQUIRE(lines.size() == 3);
+                REQUIRE(lines[0] == std::string("one"));
+                REQUIRE(lines[0].get_owner() == chunk.get_owner());
+                REQUIRE(lines[1] == std::string("two"));
+                REQUIRE(lines[1].get_owner() == chunk.get_owner());
+                REQUIRE(lines[2] == std::string("three"));
+                REQUIRE(lines[2].get_owner() != chunk.get_owner());
+                REQUIRE(lines[2].get_owner() != rest.get_owner());
+            }
+        }
+    }
+}
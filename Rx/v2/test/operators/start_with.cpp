@@ -0,0 +1,97 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("start_with", "[start_with][operators]"){
+    GIVEN("a cold observable"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_cold_observable({
+            on.next(10, 3),
+            on.next(20, 4),
+            on.completed(30)
+        });
+
+        WHEN("started with two values"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .start_with(1, 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the values are sent at the subscribe, before those of the source"){
+                auto required = rxu::to_vector({
+                    on.next(200, 1),
+                    on.next(200, 2),
+                    on.next(210, 3),
+                    on.next(220, 4),
+                    on.completed(230)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 230)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("start_with sends the prefix on the subscribing thread", "[start_with][operators]"){
+    GIVEN("a subject"){
+        rxsub::subject<int> s;
+
+        WHEN("started with values inside a scheduled action"){
+            std::vector<int> values;
+            bool sentInside = false;
+
+            auto ct = rxsc::make_current_thread().create_worker();
+            ct.schedule([&](const rxsc::schedulable&){
+                rx::observable<>::start_with(s.get_observable(), 1, 2, 3)
+                    .subscribe([&](int v){ values.push_back(v); });
+                sentInside = values.size() == 3;
+                s.get_subscriber().on_next(4);
+            });
+
+            THEN("the prefix is sent before the subscribe returns"){
+                REQUIRE(sentInside);
+                REQUIRE(values == rxu::to_vector({1, 2, 3, 4}));
+            }
+        }
+
+        WHEN("unsubscribed by a value of the prefix"){
+            std::vector<int> values;
+            rx::composite_subscription lifetime;
+
+            s.get_observable()
+                .start_with(1, 2, 3)
+                .subscribe(lifetime, [&](int v){
+                    values.push_back(v);
+                    if (v == 2) {
+                        lifetime.unsubscribe();
+                    }
+                });
+            s.get_subscriber().on_next(4);
+
+            THEN("the rest of the prefix and the source are not sent"){
+                REQUIRE(values == rxu::to_vector({1, 2}));
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@ namespace rx=rxcpp;
 namespace rxu=rxcpp::util;
 namespace rxsc=rxcpp::schedulers;
 namespace rxn=rx::notifications;
+namespace rxsub=rxcpp::subjects;
 
 #include "rxcpp/rx-test.hpp"
 #include "catch.hpp"
@@ -387,3 +388,133 @@ SCENARIO("switch_on_next - inner completes", "[switch_on_next][operators]"){
         }
     }
 }
+
+SCENARIO("switch_map - some changes", "[switch_map][switch_on_next][operators]"){
+    GIVEN("a source of keys"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto ys1 = sc.make_cold_observable({
+            on.next(10, 101),
+            on.next(20, 102),
+            on.next(110, 103),
+            on.completed(230)
+        });
+
+        auto ys2 = sc.make_cold_observable({
+            on.next(10, 201),
+            on.next(20, 202),
+            on.completed(50)
+        });
+
+        auto xs = sc.make_hot_observable({
+            on.next(300, 1),
+            on.next(400, 2),
+            on.completed(600)
+        });
+
+        WHEN("each key is mapped to an observable"){
+
+            auto res = w.start(
+                [xs, ys1, ys2]() {
+                    return xs
+                        .switch_map([ys1, ys2](int k) -> rx::observable<int> {
+                            return k == 1 ? ys1.as_dynamic() : ys2.as_dynamic();
+                        });
+                }
+            );
+
+            THEN("the output only contains items from the latest observable"){
+                auto required = rxu::to_vector({
+                    on.next(310, 101),
+                    on.next(320, 102),
+                    on.next(410, 201),
+                    on.next(420, 202),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("each observable was unsubscribed when it was replaced or completed"){
+                REQUIRE(rxu::to_vector({on.subscribe(300, 400)}) == ys1.subscriptions());
+                REQUIRE(rxu::to_vector({on.subscribe(400, 450)}) == ys2.subscriptions());
+            }
+        }
+    }
+}
+
+SCENARIO("switch_on_next - many switches", "[switch_on_next][operators]"){
+    GIVEN("a subject of subjects"){
+        rxsub::subject<rx::observable<int>> outer;
+        std::vector<int> values;
+        bool completed = false;
+        outer.get_observable()
+            .switch_on_next()
+            .subscribe([&](int v){values.push_back(v);}, [&](){completed = true;});
+
+        WHEN("the inner is replaced many times"){
+            std::vector<rxsub::subject<int>> inners(1000);
+            for (auto& inner : inners) {
+                outer.get_subscriber().on_next(inner.get_observable());
+                inner.get_subscriber().on_next(1);
+            }
+            // only the last inner is subscribed
+            for (auto& inner : inners) {
+                inner.get_subscriber().on_next(2);
+            }
+            outer.get_subscriber().on_completed();
+
+            THEN("values from replaced inners were dropped"){
+                REQUIRE(values.size() == 1001);
+                REQUIRE(values.back() == 2);
+            }
+            THEN("the output waits for the last inner"){
+                REQUIRE(!completed);
+                inners.back().get_subscriber().on_completed();
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("switch_on_next unsubscribed while inners arrive on another thread", "[switch_on_next][operators]"){
+    GIVEN("an outer subject fed from a thread"){
+        typedef rx::observable<int> inner_type;
+        rxsub::subject<inner_type> outer;
+
+        // counts the inners that are subscribed and not yet unsubscribed
+        std::atomic<int> active(0);
+        auto inner = rx::observable<>::create<int>(
+            [&active](rx::subscriber<int> s){
+                ++active;
+                s.add([&active](){ --active; });
+            });
+
+        WHEN("the output is unsubscribed while the thread sends inners"){
+            rx::composite_subscription lifetime;
+            outer.get_observable()
+                .switch_on_next()
+                .subscribe(lifetime, [](int){});
+
+            std::atomic<bool> started(false);
+            std::thread feed([&](){
+                auto o = outer.get_subscriber();
+                for (int i = 0; i != 20000; ++i) {
+                    o.on_next(inner);
+                    started = true;
+                }
+            });
+            while (!started) {
+                std::this_thread::yield();
+            }
+            lifetime.unsubscribe();
+            feed.join();
+
+            THEN("no inner is left subscribed"){
+                REQUIRE(active == 0);
+            }
+        }
+    }
+}
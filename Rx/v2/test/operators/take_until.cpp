@@ -745,3 +745,163 @@ SCENARIO("take_until, error some", "[take_until][take][operators]"){
         }
     }
 }
+
+SCENARIO("take_until time", "[take_until][take][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto so = rxcpp::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        auto start = sc.now();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(230, 2),
+            on.next(250, 3),
+            on.completed(300)
+        });
+
+        WHEN("the time is 240"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .take_until(start + std::chrono::milliseconds(240), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output stops at the time"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(230, 2),
+                    on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed at the time"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 240)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("take_until a cancellation token", "[take_until][take][operators]"){
+    GIVEN("a source and a cancellation_source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.completed(250)
+        });
+
+        rxcpp::cancellation_source cancel;
+
+        w.schedule_absolute(225, [cancel](const rxsc::schedulable&){
+            cancel.cancel();
+        });
+
+        WHEN("one is taken until the token is cancelled"){
+
+            auto res = w.start(
+                [xs, cancel]() {
+                    return xs
+                        .take_until(cancel.get_token())
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains items sent while not cancelled"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2),
+                    on.next(220, 3),
+                    on.completed(225)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 225)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("take_until a cancelled token", "[take_until][take][operators]"){
+    GIVEN("a cancellation_source that is cancelled before the subscription"){
+        rxcpp::cancellation_source cancel;
+        cancel.cancel();
+
+        int subscribed = 0;
+        auto xs = rxcpp::observable<>::create<int>([&](rxcpp::subscriber<int> s){
+            ++subscribed;
+            s.on_next(1);
+            s.on_completed();
+        });
+
+        WHEN("it is taken until the token is cancelled"){
+            std::vector<int> values;
+            bool completed = false;
+            xs.take_until(cancel.get_token()).subscribe(
+                [&](int v){values.push_back(v);},
+                [&](){completed = true;});
+
+            THEN("it completes without subscribing to the source"){
+                REQUIRE(values.empty());
+                REQUIRE(completed);
+                REQUIRE(subscribed == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("take_until a token shared by many subscriptions", "[take_until][take][operators]"){
+    GIVEN("a subject and a cancellation_source"){
+        rxcpp::subjects::subject<int> sub;
+        rxcpp::cancellation_source cancel;
+        auto token = cancel.get_token();
+
+        std::vector<int> completed(3, 0);
+        std::vector<rxcpp::composite_subscription> lifetimes;
+        for (int i = 0; i != 3; ++i) {
+            lifetimes.push_back(sub.get_observable()
+                .take_until(token)
+                .subscribe([](int){}, [&completed, i](){++completed[i];}));
+        }
+
+        WHEN("one subscription ends and then the token is cancelled"){
+            lifetimes[1].unsubscribe();
+            cancel.cancel();
+
+            THEN("each linked subscription completes once"){
+                REQUIRE(completed == rxu::to_vector({1, 0, 1}));
+                REQUIRE(!lifetimes[0].is_subscribed());
+                REQUIRE(!lifetimes[2].is_subscribed());
+            }
+            THEN("a cancel that is repeated does nothing"){
+                cancel.cancel();
+                REQUIRE(completed == rxu::to_vector({1, 0, 1}));
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("throttle_first", "[throttle_first][operators]"){
+    GIVEN("a source with two bursts and a late item"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(300, 3),
+            on.next(310, 4),
+            on.next(320, 5),
+            on.next(500, 6),
+            on.completed(600)
+        });
+
+        WHEN("the period is 50"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .throttle_first(std::chrono::milliseconds(50), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the first item of each burst was emitted"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(300, 3),
+                    on.next(500, 6),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
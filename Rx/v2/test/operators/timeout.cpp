@@ -0,0 +1,219 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("timeout when the source pauses", "[timeout][operators]"){
+    GIVEN("a source that pauses after 2 items"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 0),
+            on.next(210, 1),
+            on.next(230, 2),
+            on.next(300, 3),
+            on.completed(400)
+        });
+
+        auto ys = sc.make_cold_observable({
+            on.next(10, 7),
+            on.completed(20)
+        });
+
+        WHEN("the period is 50 without a fallback"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .timeout(std::chrono::milliseconds(50), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output stops with an error 50 after the last item"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(230, 2),
+                    on.error(280, std::runtime_error("timeout"))
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed at the timeout"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 280)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the period is 50 with a fallback"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .timeout(std::chrono::milliseconds(50), so, ys)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output continues with the fallback"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(230, 2),
+                    on.next(290, 7),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the fallback was subscribed at the timeout"){
+                auto required = rxu::to_vector({
+                    on.subscribe(280, 300)
+                });
+                auto actual = ys.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the period is longer than each pause"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        >> rxo::timeout(std::chrono::milliseconds(120), so, ys)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        >> rxo::as_dynamic();
+                }
+            );
+
+            THEN("the output is the source"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(230, 2),
+                    on.next(300, 3),
+                    on.completed(400)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the fallback was not subscribed"){
+                REQUIRE(ys.subscriptions().empty());
+            }
+        }
+    }
+}
+
+namespace {
+
+// a worker that keeps the timed action until the test runs it. now() runs
+// a hook once, so the action can run in the middle of an on_next.
+struct manual_worker : public rxsc::worker_interface
+{
+    mutable clock_type::time_point at;
+    mutable clock_type::time_point due;
+    mutable std::function<void()> on_now;
+    mutable rxu::maybe<rxsc::schedulable> timed;
+
+    virtual clock_type::time_point now() const {
+        if (on_now) {
+            auto hook = std::move(on_now);
+            on_now = nullptr;
+            hook();
+        }
+        return at;
+    }
+    virtual void schedule(const rxsc::schedulable& scbl) const {
+        rxsc::recursion r(false);
+        scbl(r.get_recurse());
+    }
+    virtual void schedule(clock_type::time_point when, const rxsc::schedulable& scbl) const {
+        due = when;
+        timed.reset(scbl);
+    }
+    void fire() const {
+        auto what = std::move(timed.get());
+        timed.reset();
+        schedule(what);
+    }
+};
+
+struct manual_scheduler : public rxsc::scheduler_interface
+{
+    explicit manual_scheduler(std::shared_ptr<manual_worker> w)
+        : w(std::move(w))
+    {
+    }
+    virtual clock_type::time_point now() const {
+        return w->at;
+    }
+    virtual rxsc::worker create_worker(rx::composite_subscription cs) const {
+        return rxsc::worker(std::move(cs), w);
+    }
+    std::shared_ptr<manual_worker> w;
+};
+
+}
+
+SCENARIO("timeout when the timer runs during an on_next", "[timeout][operators]"){
+    GIVEN("a subject and a worker that runs the timer when told"){
+        using namespace std::chrono;
+        typedef rxsc::scheduler::clock_type::time_point time_point;
+
+        auto mw = std::make_shared<manual_worker>();
+        mw->at = time_point(seconds(100));
+        auto start = mw->at;
+        auto sc = rxsc::make_scheduler<manual_scheduler>(mw);
+        rxcpp::subjects::subject<int> s;
+        std::vector<int> values;
+        bool timedout = false;
+
+        s.get_observable()
+            .timeout(milliseconds(10), rx::identity_one_worker(sc))
+            .subscribe(
+                [&](int v){
+                    values.push_back(v);
+                },
+                [&](std::exception_ptr){
+                    timedout = true;
+                });
+
+        WHEN("the timer runs while an item reads the clock at the deadline"){
+            auto o = s.get_subscriber();
+            mw->at = start + milliseconds(5);
+            o.on_next(1);
+            mw->at = start + milliseconds(10);
+            mw->on_now = [&](){
+                mw->fire();
+            };
+            o.on_next(2);
+
+            THEN("the timer waits for the period after each item"){
+                REQUIRE(values == rxu::to_vector({ 1, 2 }));
+                REQUIRE(mw->due == start + milliseconds(15));
+
+                mw->at = mw->due;
+                mw->fire();
+                REQUIRE(!timedout);
+                REQUIRE(mw->due == start + milliseconds(20));
+
+                mw->at = mw->due;
+                mw->fire();
+                REQUIRE(timedout);
+            }
+        }
+    }
+}
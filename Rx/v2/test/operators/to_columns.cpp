@@ -0,0 +1,109 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+struct trade
+{
+    int id;
+    double price;
+    std::string symbol;
+};
+
+typedef rx::column_batch<int, double, std::string> trade_columns;
+}
+
+SCENARIO("to_columns scatters the fields into columns", "[to_columns][operators]"){
+    GIVEN("5 trades"){
+        std::vector<trade> trades;
+        for (int i = 0; i != 5; ++i) {
+            trade t = {i, i * 1.5, std::string(1, char('a' + i))};
+            trades.push_back(t);
+        }
+
+        WHEN("the trades are collected 2 at a time"){
+            std::vector<trade_columns> batches;
+            rx::observable<>::iterate(trades)
+                .to_columns(2, std::chrono::hours(1), &trade::id, &trade::price, &trade::symbol)
+                .subscribe([&](trade_columns b){batches.push_back(std::move(b));});
+
+            THEN("two full batches and the rest are sent"){
+                REQUIRE(batches.size() == 3);
+                REQUIRE(batches[0].size() == 2);
+                REQUIRE(batches[2].size() == 1);
+            }
+            THEN("each column holds one field in the order of the trades"){
+                REQUIRE(batches[1].column<0>() == rxu::to_vector({2, 3}));
+                REQUIRE(batches[1].column<1>() == rxu::to_vector({3.0, 4.5}));
+                REQUIRE(batches[1].column<2>() == rxu::to_vector({std::string("c"), std::string("d")}));
+                REQUIRE(batches[2].column<0>() == rxu::to_vector({4}));
+            }
+            THEN("a column can be moved out of the batch"){
+                auto ids = batches[0].release<0>();
+                REQUIRE(ids == rxu::to_vector({0, 1}));
+                REQUIRE(batches[0].column<0>().empty());
+            }
+        }
+        WHEN("only the prices are collected"){
+            std::vector<rx::column_batch<double>> batches;
+            rx::observable<>::iterate(trades)
+                | rxo::to_columns(10, std::chrono::hours(1), &trade::price)
+                | rxo::subscribe<rx::column_batch<double>>([&](rx::column_batch<double> b){batches.push_back(std::move(b));});
+
+            THEN("one batch of prices is sent at the end"){
+                REQUIRE(batches.size() == 1);
+                REQUIRE(batches[0].column<0>() == rxu::to_vector({0.0, 1.5, 3.0, 4.5, 6.0}));
+            }
+        }
+    }
+}
+
+SCENARIO("to_columns sends a batch when the period passes", "[to_columns][operators]"){
+    GIVEN("a hot observable of trades"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<trade> on;
+
+        trade a = {1, 1.0, "a"};
+        trade b = {2, 2.0, "b"};
+        trade c = {3, 3.0, "c"};
+        auto xs = sc.make_hot_observable({
+            on.next(210, a),
+            on.next(220, b),
+            on.next(450, c),
+            on.completed(500)
+        });
+
+        WHEN("the ids are collected every 100 ticks or 10 trades"){
+            std::vector<std::pair<long, std::vector<int>>> batches;
+            bool completed = false;
+            w.start(
+                [&]() {
+                    return xs
+                        .to_columns(10, std::chrono::milliseconds(100), so, &trade::id)
+                        .map([&](rx::column_batch<int> batch){
+                            batches.push_back(std::make_pair(sc.clock(), batch.column<0>()));
+                            return 0;
+                        })
+                        .finally([&](){completed = true;})
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the batches are sent when their period passes and empty periods send nothing"){
+                REQUIRE(completed);
+                REQUIRE(batches.size() == 2);
+                REQUIRE(batches[0].first == 300);
+                REQUIRE(batches[0].second == rxu::to_vector({1, 2}));
+                REQUIRE(batches[1].first == 500);
+                REQUIRE(batches[1].second == rxu::to_vector({3}));
+            }
+        }
+    }
+}
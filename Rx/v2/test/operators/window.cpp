@@ -988,3 +988,97 @@ SCENARIO("window with time or count, only time triggered", "[window_with_time_or
         }
     }
 }
+
+SCENARIO("window count, several subscribers per window", "[window][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("each window is subscribed to twice"){
+            std::vector<std::string> seen;
+            rx::observable<>::range(1, 4)
+                .window(2)
+                .subscribe([&](rx::observable<int> w){
+                    w.subscribe([&](int v){seen.push_back("a" + std::to_string(v));});
+                    w.subscribe([&](int v){seen.push_back("b" + std::to_string(v));});
+                });
+
+            THEN("both subscribers see every value of the window"){
+                std::vector<std::string> required{"a1", "b1", "a2", "b2", "a3", "b3", "a4", "b4"};
+                REQUIRE(required == seen);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast windows", "[window][window_with_time][window_with_time_or_count][unicast][operators]"){
+    GIVEN("a range of ints"){
+        std::vector<int> seen;
+        int rejected = 0;
+        auto subscribe_twice = [&](rx::observable<int> w){
+            w.subscribe([&](int v){seen.push_back(v);});
+            w.subscribe(
+                [](int){},
+                [&](std::exception_ptr ep){
+                    try {
+                        std::rethrow_exception(ep);
+                    } catch (const rx::subjects::unicast_subscribed_error&) {
+                        ++rejected;
+                    }
+                });
+        };
+
+        WHEN("window count is asked for unicast windows"){
+            rx::observable<>::range(1, 4)
+                .window(2, 2, rx::subjects::unicast_windows())
+                .subscribe(subscribe_twice);
+
+            THEN("the first subscriber of each window sees its values and the second is refused"){
+                std::vector<int> required{1, 2, 3, 4};
+                REQUIRE(required == seen);
+                REQUIRE(rejected == 3);
+            }
+        }
+        WHEN("window with time or count is asked for unicast windows"){
+            rx::observable<>::range(1, 4)
+                .window_with_time_or_count(std::chrono::hours(1), 2, rx::identity_current_thread(), rx::subjects::unicast_windows())
+                .subscribe(subscribe_twice);
+
+            THEN("the first subscriber of each window sees its values and the second is refused"){
+                std::vector<int> required{1, 2, 3, 4};
+                REQUIRE(required == seen);
+                REQUIRE(rejected == 3);
+            }
+        }
+        WHEN("window with time is asked for unicast windows"){
+            auto sc = rxsc::make_test();
+            auto so = rx::synchronize_in_one_worker(sc);
+            auto w = sc.create_worker();
+            const rxsc::test::messages<int> on;
+
+            auto xs = sc.make_hot_observable({
+                on.next(210, 1),
+                on.next(240, 2),
+                on.next(320, 3),
+                on.next(360, 4),
+                on.completed(390)
+            });
+
+            w.start(
+                [&]() {
+                    return xs
+                        .window_with_time(std::chrono::milliseconds(100), std::chrono::milliseconds(100), so, rx::subjects::unicast_windows())
+                        .map([&](rx::observable<int> window){
+                            subscribe_twice(window);
+                            return 0;
+                        })
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the first subscriber of each window sees its values and the second is refused"){
+                std::vector<int> required{1, 2, 3, 4};
+                REQUIRE(required == seen);
+                REQUIRE(rejected == 2);
+            }
+        }
+    }
+}
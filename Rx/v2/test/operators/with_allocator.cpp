@@ -0,0 +1,81 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("with_allocator allocates the pipeline state from the arena", "[with_allocator][arena][operators]"){
+    GIVEN("an arena"){
+        rx::arena pool(4096);
+
+        auto xs = rxs::range(1, 3)
+            .map([](int i){
+                return rxs::range(1, i).as_dynamic();
+            })
+            .merge()
+            .observe_on(rx::identity_current_thread());
+
+        WHEN("the pipeline is subscribed without it"){
+            std::vector<int> result;
+            xs.subscribe([&](int v){result.push_back(v);});
+
+            THEN("nothing is taken from the arena"){
+                REQUIRE(result == rxu::to_vector({1, 1, 2, 1, 2, 3}));
+                REQUIRE(pool.allocated() == 0);
+            }
+        }
+
+        WHEN("the pipeline is subscribed with it"){
+            std::vector<int> result;
+            bool completed = false;
+            xs
+                .with_allocator(pool)
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](){
+                        completed = true;
+                    });
+
+            THEN("the values are the same"){
+                REQUIRE(result == rxu::to_vector({1, 1, 2, 1, 2, 3}));
+                REQUIRE(completed);
+            }
+            THEN("the state was taken from the arena"){
+                REQUIRE(pool.allocated() > 0);
+                REQUIRE(pool.reserved() >= pool.allocated());
+            }
+        }
+    }
+}
+
+SCENARIO("arena state freed with the last allocation", "[arena]"){
+    GIVEN("state allocated from an arena"){
+        std::shared_ptr<int> value;
+        std::weak_ptr<rxcpp::detail::arena_state> weak;
+        {
+            rx::arena pool(256);
+            weak = pool.get_state();
+            rxcpp::detail::arena_scope scope(pool.get_state().get());
+            value = rxcpp::detail::allocate_state<int>(42);
+        }
+
+        WHEN("the arena handle is gone"){
+            THEN("the allocation keeps the arena alive"){
+                REQUIRE(*value == 42);
+                REQUIRE(!weak.expired());
+            }
+        }
+        WHEN("the allocation is released"){
+            value.reset();
+
+            THEN("the arena is freed"){
+                REQUIRE(weak.expired());
+            }
+        }
+    }
+}
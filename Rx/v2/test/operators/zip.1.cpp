@@ -940,3 +940,40 @@ SCENARIO("zip error/error", "[zip][join][operators]"){
         }
     }
 }
+
+SCENARIO("zip of sources that honor demand", "[zip][join][demand][operators]"){
+    GIVEN("two ranges that each honor a demand"){
+        rxcpp::demand left;
+        rxcpp::demand right;
+        auto tuples = rxcpp::demand::each(rxu::to_vector({left, right}));
+
+        int sentLeft = 0;
+        int sentRight = 0;
+        std::vector<int> result;
+
+        rxcpp::sources::range<int>(1, 100, 1, rxcpp::identity_current_thread(), left)
+            .map([&](int v){ ++sentLeft; return v; })
+            .zip(
+                [](int l, int r){ return l + r; },
+                rxcpp::sources::range<int>(101, 200, 1, rxcpp::identity_current_thread(), right)
+                    .map([&](int v){ ++sentRight; return v; }))
+            .subscribe([&](int v){ result.push_back(v); });
+
+        WHEN("tuples are requested"){
+            tuples.request(3);
+            auto first = result;
+            auto firstLeft = sentLeft;
+            auto firstRight = sentRight;
+            tuples.request(2);
+
+            THEN("each source sent one value for each requested tuple"){
+                REQUIRE(first == rxu::to_vector({102, 104, 106}));
+                REQUIRE(firstLeft == 3);
+                REQUIRE(firstRight == 3);
+                REQUIRE(result.size() == 5);
+                REQUIRE(sentLeft == 5);
+                REQUIRE(sentRight == 5);
+            }
+        }
+    }
+}
@@ -947,3 +947,101 @@ SCENARIO("zip error after completed right", "[zip][join][operators]"){
         }
     }
 }
+
+SCENARIO("zip waits with many values from one source", "[zip][join][operators]"){
+    GIVEN("two subjects"){
+        rxcpp::subjects::subject<int> xs, ys;
+
+        std::vector<int> result;
+        bool completed = false;
+
+        xs.get_observable()
+            .zip([](int x, int y){return x * 1000 + y;}, ys.get_observable())
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("one source runs ahead, the other catches up in turns"){
+            auto xo = xs.get_subscriber();
+            auto yo = ys.get_subscriber();
+            for (int i = 0; i < 20; ++i) {
+                xo.on_next(i);
+            }
+            for (int i = 0; i < 10; ++i) {
+                yo.on_next(i);
+            }
+            for (int i = 20; i < 50; ++i) {
+                xo.on_next(i);
+                yo.on_next(i - 10);
+            }
+            for (int i = 40; i < 50; ++i) {
+                yo.on_next(i);
+            }
+            xo.on_completed();
+            yo.on_completed();
+
+            THEN("the values are paired in order"){
+                std::vector<int> required;
+                for (int i = 0; i < 50; ++i) {
+                    required.push_back(i * 1000 + i);
+                }
+                REQUIRE(required == result);
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("zip with a coordination and a selector", "[zip][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(230, 3),
+            on.completed(300)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 2),
+            on.next(240, 4),
+            on.completed(310)
+        });
+
+        WHEN("each int is combined with the other source on the identity coordination"){
+
+            auto res = w.start(
+                [&]() {
+                    return o1
+                        .zip(
+                            rxcpp::identity_one_worker(sc),
+                            [](int v1, int v2){
+                                return v1 + v2;
+                            },
+                            o2
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains combined ints"){
+                auto required = rxu::to_vector({
+                    on.next(220, 3),
+                    on.next(240, 7),
+                    on.completed(310)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
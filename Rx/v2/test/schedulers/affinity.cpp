@@ -0,0 +1,87 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("affinity policies", "[affinity][scheduler]"){
+    GIVEN("the cpus that the process may use"){
+        auto cpus = rxsc::detail::allowed_cpus();
+        REQUIRE(!cpus.empty());
+
+        WHEN("a policy is made for each cpu"){
+            auto policy = rxsc::affinity_policy::each_cpu();
+
+            THEN("there is one set with one cpu for each cpu"){
+                REQUIRE(policy.cpu_sets().size() == cpus.size());
+                for (size_t i = 0; i != cpus.size(); ++i) {
+                    REQUIRE(policy.cpu_sets()[i] == std::vector<int>(1, cpus[i]));
+                }
+            }
+        }
+
+        WHEN("a policy is made for each numa node"){
+            auto policy = rxsc::affinity_policy::each_numa_node();
+
+            THEN("the nodes hold each cpu once"){
+                std::vector<int> all;
+                for (auto& node : policy.cpu_sets()) {
+                    all.insert(all.end(), node.begin(), node.end());
+                }
+                std::sort(all.begin(), all.end());
+                REQUIRE(all == cpus);
+            }
+            THEN("there is a policy for the first node"){
+                auto first = rxsc::affinity_policy::numa_node(0);
+                REQUIRE(first.cpu_sets().size() == 1);
+                REQUIRE(first.cpu_sets()[0] == policy.cpu_sets()[0]);
+            }
+            THEN("a node that does not exist is refused"){
+                auto nodes = static_cast<int>(policy.cpu_sets().size());
+                REQUIRE_THROWS_AS(rxsc::affinity_policy::numa_node(nodes), std::out_of_range);
+            }
+        }
+    }
+}
+
+#if defined(__linux__)
+
+SCENARIO("parse a kernel cpu list", "[affinity][scheduler]"){
+    GIVEN("a list of ranges and single cpus"){
+        auto cpus = rxsc::detail::parse_cpu_list("0-2,5,8-9\n");
+
+        THEN("each cpu is listed"){
+            std::vector<int> required{0, 1, 2, 5, 8, 9};
+            REQUIRE(required == cpus);
+        }
+    }
+}
+
+SCENARIO("event_loop pinned to a cpu", "[affinity][scheduler]"){
+    GIVEN("an event_loop with its loop on the last allowed cpu"){
+        auto cpu = rxsc::detail::allowed_cpus().back();
+        auto sc = rxsc::make_event_loop(rxsc::affinity_policy::cpus(std::vector<int>(1, cpu)));
+
+        WHEN("an action asks which cpus it may run on"){
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            std::promise<void> ran;
+            auto w = sc.create_worker();
+            w.schedule([&](const rxsc::schedulable&){
+                pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+                ran.set_value();
+            });
+            ran.get_future().wait();
+            w.unsubscribe();
+
+            THEN("the loop thread may only run on that cpu"){
+                REQUIRE(CPU_COUNT(&set) == 1);
+                REQUIRE(CPU_ISSET(cpu, &set));
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("bulk hot observable", "[bulk][virtual_time][scheduler]"){
+    GIVEN("a bulk hot observable with two values at one tick"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_bulk_hot_observable<int>(
+            rxu::to_vector({150L, 210L, 220L, 220L, 250L}),
+            rxu::to_vector({1, 2, 3, 4, 5}),
+            on.completed(250));
+
+        WHEN("mapped and recorded in bulk"){
+            auto res = w.start_bulk(
+                [xs]() {
+                    return xs
+                        .map([](int x){return x * 10;})
+                        .as_dynamic();
+                },
+                16
+            );
+
+            THEN("the values after the subscription are recorded with their ticks"){
+                auto required = rxu::to_vector({
+                    on.next(210, 20),
+                    on.next(220, 30),
+                    on.next(220, 40),
+                    on.next(250, 50),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the messages are reported like those of a hot observable"){
+                auto required = rxu::to_vector({
+                    on.next(150, 1),
+                    on.next(210, 2),
+                    on.next(220, 3),
+                    on.next(220, 4),
+                    on.next(250, 5),
+                    on.completed(250)
+                });
+                REQUIRE(required == xs.messages());
+            }
+        }
+    }
+}
+
+SCENARIO("bulk cold observable", "[bulk][virtual_time][scheduler]"){
+    GIVEN("a bulk cold observable subscribed twice"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_bulk_cold_observable<int>(
+            rxu::to_vector({10L, 10L, 30L}),
+            rxu::to_vector({1, 2, 3}),
+            on.completed(40));
+
+        WHEN("concatenated with itself"){
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .concat(xs)
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each subscription replays the values from its own start"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(210, 2),
+                    on.next(230, 3),
+                    on.next(250, 1),
+                    on.next(250, 2),
+                    on.next(270, 3),
+                    on.completed(280)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there were two subscriptions"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 240),
+                    on.subscribe(240, 280)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("unsubscribed between the ticks"){
+            auto res = w.start(
+                [xs]() {
+                    return xs.as_dynamic();
+                },
+                220
+            );
+
+            THEN("only the values before it are sent"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(210, 2)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("bulk observable of a million values", "[hide][bulk][virtual_time][scheduler][perf]"){
+    const int count = 1000000;
+    GIVEN("a bulk cold observable with ten values for each tick"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        std::vector<long> ticks(count);
+        std::vector<int> values(count);
+        for (int i = 0; i != count; ++i) {
+            ticks[i] = 1 + i / 10;
+            values[i] = i;
+        }
+        auto xs = sc.make_bulk_cold_observable<int>(std::move(ticks), std::move(values));
+
+        WHEN("filtered and recorded in bulk"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            auto start = clock::now();
+            auto res = w.start_bulk(
+                [xs]() {
+                    return xs
+                        .filter([](int x){return x % 2 == 0;})
+                        .as_dynamic();
+                },
+                count / 2,
+                0, 0, (std::numeric_limits<long>::max)()
+            );
+            auto msElapsed = duration_cast<milliseconds>(clock::now() - start);
+            std::cout << "bulk cold observable : " << count << " values in " << msElapsed.count() << "ms" << std::endl;
+
+            THEN("half of them are recorded"){
+                REQUIRE(res.get_observer().messages().size() == size_t(count / 2));
+            }
+        }
+    }
+}
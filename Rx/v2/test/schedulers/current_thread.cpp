@@ -0,0 +1,154 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("current_thread trampoline order", "[current_thread][scheduler]"){
+    GIVEN("a current_thread worker"){
+        auto w = rxsc::make_current_thread().create_worker();
+        std::vector<int> ran;
+
+        WHEN("an action schedules immediate and timed actions"){
+            w.schedule([&](const rxsc::schedulable&){
+                ran.push_back(0);
+                auto now = w.now();
+                w.schedule(now + std::chrono::milliseconds(20), [&](const rxsc::schedulable&){ran.push_back(4);});
+                w.schedule([&](const rxsc::schedulable&){
+                    ran.push_back(1);
+                    w.schedule([&](const rxsc::schedulable&){ran.push_back(3);});
+                });
+                w.schedule([&](const rxsc::schedulable&){ran.push_back(2);});
+                w.schedule(now - std::chrono::milliseconds(20), [&](const rxsc::schedulable&){ran.push_back(-1);});
+            });
+
+            THEN("a timed action that is already due runs first, then the immediate actions in order and then the later timed action"){
+                std::vector<int> required{0, -1, 1, 2, 3, 4};
+                REQUIRE(required == ran);
+            }
+            THEN("the trampoline has been released"){
+                REQUIRE(rxsc::current_thread::is_schedule_required());
+            }
+        }
+
+        WHEN("an action recurses while nothing else is queued"){
+            w.schedule([&](const rxsc::schedulable& self){
+                ran.push_back(static_cast<int>(ran.size()));
+                if (ran.size() < 5) {
+                    self();
+                }
+            });
+
+            THEN("it ran each time"){
+                std::vector<int> required{0, 1, 2, 3, 4};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("current_thread fifo reuses the space of the actions that ran", "[current_thread][scheduler]"){
+    GIVEN("the fifo of immediate actions"){
+        typedef rxsc::detail::action_queue::item_type item_type;
+        rxsc::detail::immediate_fifo<item_type> fifo;
+        auto now = rxsc::scheduler_base::clock_type::now();
+
+        WHEN("two actions that reschedule themselves run many times"){
+            fifo.push(item_type(now, rxsc::schedulable()));
+            fifo.push(item_type(now, rxsc::schedulable()));
+            size_t peak = 0;
+            for (int i = 0; i != 100000; ++i) {
+                fifo.pop();
+                fifo.push(item_type(now, rxsc::schedulable()));
+                peak = (std::max)(peak, fifo.capacity());
+            }
+
+            THEN("the fifo never held more than a few items"){
+                REQUIRE(fifo.size() == 2);
+                REQUIRE(peak <= 8);
+            }
+        }
+    }
+    GIVEN("a current_thread worker"){
+        auto w = rxsc::make_current_thread().create_worker();
+        std::vector<int> ran;
+
+        WHEN("two actions keep rescheduling themselves"){
+            w.schedule([&](const rxsc::schedulable&){
+                for (int chain = 0; chain != 2; ++chain) {
+                    auto left = std::make_shared<int>(3);
+                    w.schedule([&, chain, left](const rxsc::schedulable& self){
+                        ran.push_back(chain);
+                        if (--*left > 0) {
+                            self.schedule();
+                        }
+                    });
+                }
+            });
+
+            THEN("they take turns"){
+                std::vector<int> required{0, 1, 0, 1, 0, 1};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("typed current_thread", "[current_thread][scheduler]"){
+    GIVEN("a typed current_thread worker"){
+        auto sc = rxsc::make_typed_current_thread();
+        auto w = sc.create_worker();
+        std::vector<int> ran;
+
+        WHEN("an action schedules immediate and timed actions"){
+            w.schedule([&](const rxsc::schedulable&){
+                ran.push_back(0);
+                w.schedule(w.now() + std::chrono::milliseconds(10), [&](const rxsc::schedulable&){ran.push_back(2);});
+                w.schedule([&](const rxsc::schedulable&){ran.push_back(1);});
+            });
+
+            THEN("they ran in the same order as on the current_thread"){
+                std::vector<int> required{0, 1, 2};
+                REQUIRE(required == ran);
+            }
+        }
+
+        WHEN("it is used as a worker"){
+            rxsc::worker erased = w;
+            erased.schedule([&](const rxsc::schedulable&){ran.push_back(0);});
+
+            THEN("the action ran"){
+                REQUIRE(ran.size() == 1);
+            }
+            THEN("the scheduler that it converts to runs actions too"){
+                rxsc::scheduler plain = sc;
+                plain.create_worker().schedule([&](const rxsc::schedulable&){ran.push_back(1);});
+                std::vector<int> required{0, 1};
+                REQUIRE(required == ran);
+            }
+        }
+
+        WHEN("range uses the typed coordination"){
+            rx::observable<>::range(1, 5, rx::identity_typed_current_thread())
+                .subscribe([&](int v){ran.push_back(v);});
+
+            THEN("the values arrived in order"){
+                std::vector<int> required{1, 2, 3, 4, 5};
+                REQUIRE(required == ran);
+            }
+        }
+
+        WHEN("subscribe_on uses the typed coordination"){
+            rx::observable<>::range(1, 3)
+                .subscribe_on(rx::identity_typed_current_thread())
+                .subscribe([&](int v){ran.push_back(v);});
+
+            THEN("the values arrived in order"){
+                std::vector<int> required{1, 2, 3};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// waits until done returns true or five seconds have passed
+template<class F>
+bool wait_for(F done) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done() && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return done();
+}
+}
+
+SCENARIO("edf_scheduler runs the earliest deadline first", "[edf][scheduler]"){
+    GIVEN("an edf_scheduler and a worker with a tighter budget"){
+        auto edf = rxsc::make_edf_scheduler(std::chrono::seconds(1));
+        auto loose = edf->get_scheduler().create_worker();
+        auto tight = edf->with_budget(std::chrono::milliseconds(100)).create_worker();
+
+        WHEN("both schedule while the thread is busy"){
+            std::atomic<bool> go(false);
+            std::atomic<int> done(0);
+            std::mutex lock;
+            std::vector<std::string> order;
+            auto record = [&](std::string name){
+                return [&, name](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    order.push_back(name);
+                    ++done;
+                };
+            };
+            loose.schedule([&](const rxsc::schedulable&){
+                wait_for([&](){return go.load();});
+                ++done;
+            });
+            loose.schedule(record("loose 1"));
+            loose.schedule(record("loose 2"));
+            tight.schedule(record("tight 1"));
+            tight.schedule(record("tight 2"));
+            go = true;
+
+            THEN("the tight budget runs first and each worker keeps its order"){
+                REQUIRE(wait_for([&](){return done == 5;}));
+                std::vector<std::string> expected;
+                expected.push_back("tight 1");
+                expected.push_back("tight 2");
+                expected.push_back("loose 1");
+                expected.push_back("loose 2");
+                REQUIRE(order == expected);
+                REQUIRE(edf->deadline_misses() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("edf_scheduler counts and drops late work", "[edf][scheduler]"){
+    GIVEN("an edf_scheduler with a 1ms budget"){
+        WHEN("an action waits behind one that runs for 20ms"){
+            THEN("the late action is counted and still runs"){
+                auto edf = rxsc::make_edf_scheduler(std::chrono::milliseconds(1));
+                auto w = edf->get_scheduler().create_worker();
+                auto slow = edf->with_budget(std::chrono::seconds(1)).create_worker();
+                std::atomic<int> ran(0);
+                std::atomic<bool> started(false);
+                slow.schedule([&](const rxsc::schedulable&){
+                    started = true;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    ++ran;
+                });
+                REQUIRE(wait_for([&](){return started.load();}));
+                w.schedule([&](const rxsc::schedulable&){
+                    ++ran;
+                });
+                REQUIRE(wait_for([&](){return ran == 2;}));
+                REQUIRE(edf->deadline_misses() == 1);
+                REQUIRE(edf->dropped() == 0);
+            }
+            THEN("the late action is dropped when the scheduler drops late work"){
+                auto edf = rxsc::make_edf_scheduler(std::chrono::milliseconds(1), true);
+                auto w = edf->get_scheduler().create_worker();
+                auto slow = edf->with_budget(std::chrono::seconds(1)).create_worker();
+                std::atomic<int> ran(0);
+                std::atomic<bool> started(false);
+                slow.schedule([&](const rxsc::schedulable&){
+                    started = true;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    ++ran;
+                });
+                REQUIRE(wait_for([&](){return started.load();}));
+                w.schedule([&](const rxsc::schedulable&){
+                    ++ran;
+                });
+                REQUIRE(wait_for([&](){return edf->dropped() == 1;}));
+                REQUIRE(ran == 1);
+                REQUIRE(edf->deadline_misses() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("observe_on an edf_scheduler gives the stream its budget", "[edf][scheduler]"){
+    GIVEN("a range observed on an edf_scheduler with a 50ms budget"){
+        auto edf = rxsc::make_edf_scheduler(std::chrono::seconds(1));
+        auto coordination = rx::observe_on_one_worker(edf->with_budget(std::chrono::milliseconds(50)));
+
+        WHEN("the values are collected"){
+            std::vector<int> values;
+            rx::observable<>::range(1, 5)
+                .observe_on(coordination)
+                .as_blocking()
+                .subscribe([&](int v){values.push_back(v);});
+
+            THEN("the values arrive in order on the edf thread"){
+                std::vector<int> expected;
+                for (int i = 1; i <= 5; ++i) {
+                    expected.push_back(i);
+                }
+                REQUIRE(values == expected);
+                REQUIRE(edf->stats().size() == 1);
+                REQUIRE(edf->stats()[0].actions >= 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// waits until done returns true or five seconds have passed
+template<class F>
+bool wait_for(F done) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done() && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return done();
+}
+}
+
+SCENARIO("elastic_pool grows for blocking work", "[elastic][scheduler]"){
+    GIVEN("an elastic_pool of up to 4 threads"){
+        auto sc = rxsc::make_elastic_pool(0, 4, std::chrono::milliseconds(50));
+
+        WHEN("4 workers each block until all 4 are blocked"){
+            std::atomic<int> blocked(0);
+            std::atomic<int> released(0);
+            std::vector<rxsc::worker> workers;
+            for (int i = 0; i != 4; ++i) {
+                workers.push_back(sc.create_worker());
+                workers.back().schedule([&](const rxsc::schedulable&){
+                    ++blocked;
+                    wait_for([&](){return blocked == 4;});
+                    ++released;
+                });
+            }
+
+            THEN("the pool started a thread for each"){
+                REQUIRE(wait_for([&](){return released == 4;}));
+                REQUIRE(blocked == 4);
+            }
+            THEN("the threads stop after the idle timeout"){
+                REQUIRE(wait_for([&](){return released == 4;}));
+                REQUIRE(wait_for([&](){return sc.stats().empty();}));
+            }
+        }
+    }
+}
+
+SCENARIO("elastic_pool is bounded", "[elastic][scheduler]"){
+    GIVEN("an elastic_pool of 1 to 3 threads"){
+        auto sc = rxsc::make_elastic_pool(1, 3, std::chrono::milliseconds(50));
+
+        WHEN("12 workers each block for a while"){
+            std::mutex lock;
+            std::set<std::thread::id> threads;
+            std::atomic<int> inside(0);
+            std::atomic<int> peak(0);
+            std::atomic<int> done(0);
+            std::vector<rxsc::worker> workers;
+            for (int i = 0; i != 12; ++i) {
+                workers.push_back(sc.create_worker());
+                workers.back().schedule([&](const rxsc::schedulable&){
+                    auto now = ++inside;
+                    auto seen = peak.load();
+                    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                    }
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        threads.insert(std::this_thread::get_id());
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    --inside;
+                    ++done;
+                });
+            }
+
+            THEN("no more than 3 threads ran the work"){
+                REQUIRE(wait_for([&](){return done == 12;}));
+                REQUIRE(peak <= 3);
+                std::unique_lock<std::mutex> guard(lock);
+                REQUIRE(threads.size() <= 3);
+            }
+            THEN("the pool shrinks back to 1 thread"){
+                REQUIRE(wait_for([&](){return done == 12;}));
+                REQUIRE(wait_for([&](){return sc.stats().size() == 1;}));
+            }
+        }
+    }
+}
+
+SCENARIO("elastic_pool worker order", "[elastic][scheduler]"){
+    GIVEN("a worker of an elastic_pool"){
+        auto sc = rxsc::make_elastic_pool(0, 4);
+        auto w = sc.create_worker();
+
+        WHEN("immediate actions follow a timed action"){
+            std::mutex lock;
+            std::vector<int> ran;
+            auto record = [&](int v){
+                std::unique_lock<std::mutex> guard(lock);
+                ran.push_back(v);
+            };
+            w.schedule(w.now() + std::chrono::milliseconds(20), [&](const rxsc::schedulable&){record(0);});
+            for (int i = 1; i <= 100; ++i) {
+                w.schedule([&, i](const rxsc::schedulable&){record(i);});
+            }
+
+            THEN("the immediate actions ran in order and then the timed action"){
+                REQUIRE(wait_for([&](){
+                    std::unique_lock<std::mutex> guard(lock);
+                    return ran.size() == 101;
+                }));
+                std::vector<int> required;
+                for (int i = 1; i <= 100; ++i) {
+                    required.push_back(i);
+                }
+                required.push_back(0);
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("immediate runs shallow schedules in place", "[immediate][scheduler]"){
+    GIVEN("an immediate worker"){
+        auto w = rxsc::make_immediate().create_worker();
+        std::vector<int> ran;
+
+        WHEN("an action schedules another"){
+            w.schedule([&](const rxsc::schedulable&){
+                ran.push_back(0);
+                w.schedule([&](const rxsc::schedulable&){ran.push_back(1);});
+                ran.push_back(2);
+            });
+
+            THEN("the inner action ran inside the outer one"){
+                std::vector<int> required{0, 1, 2};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("immediate queues schedules past the depth", "[immediate][scheduler]"){
+    GIVEN("an immediate worker with a depth of 2"){
+        auto w = rxsc::make_immediate(2).create_worker();
+        std::vector<int> ran;
+
+        WHEN("each action schedules the next in a chain of three"){
+            w.schedule([&](const rxsc::schedulable&){
+                ran.push_back(0);
+                w.schedule([&](const rxsc::schedulable&){
+                    ran.push_back(1);
+                    w.schedule([&](const rxsc::schedulable&){ran.push_back(4);});
+                    ran.push_back(2);
+                });
+                ran.push_back(3);
+            });
+
+            THEN("the third action ran after the outermost returned"){
+                std::vector<int> required{0, 1, 2, 3, 4};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+    GIVEN("an immediate worker with a depth of 8"){
+        auto w = rxsc::make_immediate(8).create_worker();
+        int ran = 0;
+        int nesting = 0;
+        int deepest = 0;
+
+        WHEN("each action schedules the next in a long chain"){
+            std::function<void(int)> step;
+            step = [&](int remaining) {
+                if (remaining == 0) {
+                    return;
+                }
+                w.schedule([&, remaining](const rxsc::schedulable&){
+                    ++ran;
+                    deepest = (std::max)(deepest, ++nesting);
+                    step(remaining - 1);
+                    --nesting;
+                });
+            };
+            step(100000);
+
+            THEN("every action ran without nesting deeper than the depth"){
+                REQUIRE(ran == 100000);
+                REQUIRE(deepest == 8);
+            }
+        }
+    }
+}
+
+SCENARIO("immediate keeps the depth of each instance", "[immediate][scheduler]"){
+    GIVEN("an immediate with a depth of 1 and one with a depth of 8"){
+        auto small = rxsc::make_immediate(1).create_worker();
+        auto large = rxsc::make_immediate(8).create_worker();
+        int nesting = 0;
+        int deepest = 0;
+
+        // a chain of count actions on w that each schedule the next
+        std::function<void(const rxsc::worker&, int)> chain;
+        chain = [&](const rxsc::worker& w, int count) {
+            if (count == 0) {
+                return;
+            }
+            w.schedule([&, count](const rxsc::schedulable&){
+                deepest = (std::max)(deepest, ++nesting);
+                chain(w, count - 1);
+                --nesting;
+            });
+        };
+
+        WHEN("a chain of 8 on the large one runs inside an action of the small one"){
+            small.schedule([&](const rxsc::schedulable&){
+                chain(large, 8);
+            });
+
+            THEN("the whole chain ran nested"){
+                REQUIRE(deepest == 8);
+            }
+        }
+        WHEN("a chain of 2 on the small one runs inside an action of the large one"){
+            int ran_inside = 0;
+            large.schedule([&](const rxsc::schedulable&){
+                chain(small, 2);
+                ran_inside = deepest;
+            });
+
+            THEN("the first action ran in place and the second was queued"){
+                REQUIRE(ran_inside == 1);
+                REQUIRE(deepest == 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/sources/rx-io.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("io_event_loop worker runs actions on the loop thread", "[io_event_loop][scheduler]"){
+    GIVEN("an io_event_loop worker"){
+        auto loop = rxsc::make_io_event_loop([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 1);
+        auto w = loop->get_scheduler().create_worker();
+
+        WHEN("a timed action is scheduled before immediate actions"){
+            std::mutex lock;
+            std::condition_variable wake;
+            std::vector<int> result;
+            std::set<std::thread::id> threads;
+
+            auto push = [&](int v){
+                return [&, v](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    result.push_back(v);
+                    threads.insert(std::this_thread::get_id());
+                    wake.notify_one();
+                };
+            };
+            auto start = w.now();
+            w.schedule(start + std::chrono::milliseconds(50), push(3));
+            w.schedule(push(1));
+            w.schedule(push(2));
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return result.size() == 3;});
+            }
+
+            THEN("the actions ran in time order on one other thread"){
+                REQUIRE(result == rxu::to_vector({1, 2, 3}));
+                REQUIRE(threads.size() == 1);
+                REQUIRE(threads.count(std::this_thread::get_id()) == 0);
+                REQUIRE(w.now() - start >= std::chrono::milliseconds(50));
+            }
+        }
+    }
+}
+
+SCENARIO("from_fd reads a pipe", "[io_event_loop][from_fd][sources]"){
+    GIVEN("a pipe with lines in it"){
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        std::string text("one\ntwo\nthree");
+        REQUIRE(::write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+        ::close(fds[1]);
+
+        WHEN("the pipe is read in chunks of 4 bytes"){
+            std::vector<std::string> lines;
+            rx::sources::from_fd(fds[0], 4, rxsc::make_io_event_loop())
+                .split_lines()
+                .map([](rx::slice s){return s.str();})
+                .as_blocking()
+                .subscribe([&](std::string line){lines.push_back(line);});
+            ::close(fds[0]);
+
+            THEN("each line arrived once the pipe was closed"){
+                REQUIRE(lines == rxu::to_vector({std::string("one"), std::string("two"), std::string("three")}));
+            }
+        }
+    }
+}
+
+SCENARIO("accept sends connections", "[io_event_loop][accept][sources]"){
+    GIVEN("a listening socket with a pending connection"){
+        int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(listener >= 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+        REQUIRE(::listen(listener, 4) == 0);
+        socklen_t length = sizeof(address);
+        REQUIRE(::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0);
+        ::fcntl(listener, F_SETFL, ::fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+        int client = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+        REQUIRE(::write(client, "hi", 2) == 2);
+        ::close(client);
+
+        WHEN("a connection is accepted and read"){
+            std::vector<std::string> received;
+            rx::sources::accept(listener)
+                .take(1)
+                .flat_map([](int connection){
+                    return rx::sources::from_fd(connection)
+                        .finally([connection](){::close(connection);});
+                }, [](int, rx::slice s){return s.str();})
+                .as_blocking()
+                .subscribe([&](std::string s){received.push_back(s);});
+            ::close(listener);
+
+            THEN("the bytes that the client sent arrived"){
+                REQUIRE(received == rxu::to_vector({std::string("hi")}));
+            }
+        }
+    }
+}
@@ -0,0 +1,530 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("new_thread worker fed by many threads", "[new_thread][scheduler]"){
+    GIVEN("a new_thread worker"){
+        auto w = rxsc::make_new_thread().create_worker();
+
+        WHEN("several threads schedule actions at the same time"){
+            const int producers = 4;
+            const int actions = 1000;
+
+            std::mutex lock;
+            std::condition_variable wake;
+            int remaining = producers * actions;
+            // only the worker thread touches the results
+            std::vector<std::vector<int>> results(producers);
+
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.push_back(std::thread([&, p](){
+                    for (int n = 0; n < actions; ++n) {
+                        w.schedule([&, p, n](const rxsc::schedulable&){
+                            results[p].push_back(n);
+                            std::unique_lock<std::mutex> guard(lock);
+                            if (--remaining == 0) {
+                                wake.notify_one();
+                            }
+                        });
+                    }
+                }));
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return remaining == 0;});
+            }
+
+            THEN("each thread's actions ran in the order they were scheduled"){
+                std::vector<int> expected;
+                for (int n = 0; n < actions; ++n) {
+                    expected.push_back(n);
+                }
+                for (auto& result : results) {
+                    REQUIRE(result == expected);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread worker mixes timed and immediate actions", "[new_thread][scheduler]"){
+    GIVEN("a new_thread worker"){
+        auto w = rxsc::make_new_thread().create_worker();
+
+        WHEN("a timed action is scheduled before immediate actions"){
+            std::mutex lock;
+            std::condition_variable wake;
+            std::vector<int> result;
+
+            auto push = [&](int v){
+                return [&, v](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    result.push_back(v);
+                    wake.notify_one();
+                };
+            };
+            auto start = w.now();
+            w.schedule(start + std::chrono::milliseconds(50), push(3));
+            w.schedule(push(1));
+            w.schedule(push(2));
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return result.size() == 3;});
+            }
+
+            THEN("the immediate actions ran first and the timed action waited"){
+                std::vector<int> expected;
+                expected.push_back(1);
+                expected.push_back(2);
+                expected.push_back(3);
+                REQUIRE(result == expected);
+                REQUIRE(w.now() - start >= std::chrono::milliseconds(50));
+            }
+        }
+    }
+}
+
+namespace {
+// waits until the counters have caught up with the actions that ran
+rxsc::worker_stats wait_for_actions(const rxsc::scheduler& sc, std::uint64_t actions) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (;;) {
+        auto all = sc.stats();
+        if ((all.size() == 1 && all[0].actions >= actions) || std::chrono::steady_clock::now() > until) {
+            return all.empty() ? rxsc::worker_stats() : all[0];
+        }
+        std::this_thread::yield();
+    }
+}
+}
+
+SCENARIO("new_thread keeps the stats of each worker", "[new_thread][stats][scheduler]"){
+    GIVEN("a new_thread scheduler with one worker"){
+        auto sc = rxsc::make_new_thread([](std::function<void()> start){
+            return std::thread(std::move(start));
+        });
+        auto w = sc.create_worker();
+
+        WHEN("a slow action delays a timed action"){
+            auto start = w.now();
+            w.schedule(start + std::chrono::milliseconds(2), [](const rxsc::schedulable&){});
+            w.schedule([](const rxsc::schedulable&){
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            });
+            for (int i = 0; i < 3; ++i) {
+                w.schedule([](const rxsc::schedulable&){});
+            }
+
+            auto stats = wait_for_actions(sc, 5);
+
+            THEN("the actions and the late action are counted"){
+                REQUIRE(stats.thread != std::thread::id());
+                REQUIRE(stats.actions == 5);
+                REQUIRE(stats.timed == 1);
+                REQUIRE(stats.late == 1);
+                REQUIRE(stats.max_lateness >= std::chrono::milliseconds(10));
+                REQUIRE(stats.busy >= std::chrono::milliseconds(20));
+                REQUIRE(stats.queued == 0);
+            }
+        }
+        WHEN("the worker is released"){
+            w = rxsc::worker();
+            THEN("its stats are no longer reported"){
+                REQUIRE(sc.stats().empty());
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop reports the stats of each loop", "[event_loop][stats][scheduler]"){
+    GIVEN("an event_loop"){
+        auto sc = rxsc::make_event_loop([](std::function<void()> start){
+            return std::thread(std::move(start));
+        });
+        WHEN("an action runs on a worker"){
+            std::atomic<bool> done(false);
+            sc.create_worker().schedule([&](const rxsc::schedulable&){
+                done = true;
+            });
+            while (!done) {
+                std::this_thread::yield();
+            }
+            THEN("only the loop that was given the worker has started and it ran the action"){
+                auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                std::vector<rxsc::worker_stats> all;
+                std::uint64_t actions = 0;
+                while (actions == 0 && std::chrono::steady_clock::now() < until) {
+                    all = sc.stats();
+                    actions = 0;
+                    for (auto& s : all) {
+                        actions += s.actions;
+                    }
+                }
+                REQUIRE(all.size() == 1);
+                REQUIRE(actions == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop starts the thread of a loop when it is first needed", "[event_loop][scheduler]"){
+    GIVEN("an event_loop of three loops that counts its threads"){
+        auto started = std::make_shared<std::atomic<int>>(0);
+        auto sc = rxsc::make_event_loop([started](std::function<void()> start){
+            ++*started;
+            return std::thread(std::move(start));
+        }, 3);
+        THEN("no thread is started by the event_loop"){
+            REQUIRE(*started == 0);
+            REQUIRE(sc.stats().empty());
+        }
+        WHEN("two workers are created"){
+            auto w1 = sc.create_worker();
+            auto w2 = sc.create_worker();
+            THEN("a thread is started for each of their loops"){
+                REQUIRE(*started == 2);
+            }
+        }
+        WHEN("the event_loop is warmed up"){
+            sc.warm_up();
+            auto w = sc.create_worker();
+            THEN("the threads of all of the loops were started once"){
+                REQUIRE(*started == 3);
+                REQUIRE(sc.stats().size() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop shutdown drains the queued work", "[event_loop][shutdown][scheduler]"){
+    GIVEN("an event_loop with actions queued on a loop"){
+        auto sc = rxsc::make_event_loop([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 2);
+        auto w = sc.create_worker();
+        std::atomic<int> ran(0);
+        for (int i = 0; i != 100; ++i) {
+            w.schedule([&](const rxsc::schedulable&){
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                ++ran;
+            });
+        }
+        WHEN("it is shut down with time to spare"){
+            auto drained = sc.shutdown(sc.now() + std::chrono::seconds(10));
+            THEN("every queued action ran"){
+                REQUIRE(drained);
+                REQUIRE(ran == 100);
+            }
+            THEN("the work scheduled afterwards is refused"){
+                w.schedule([&](const rxsc::schedulable&){++ran;});
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                REQUIRE(ran == 100);
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop runs the high lane first", "[event_loop][priority][scheduler]"){
+    GIVEN("an event_loop of one loop that is busy"){
+        auto sc = rxsc::make_event_loop([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 1);
+        auto bulk = sc.create_worker(rx::composite_subscription(), rxsc::schedule_priority::bulk);
+        auto control = rxsc::make_lane_scheduler(sc, rxsc::schedule_priority::high).create_worker();
+
+        std::mutex lock;
+        std::vector<std::string> ran;
+        std::atomic<bool> open(false);
+        bulk.schedule([&](const rxsc::schedulable&){
+            while (!open) {
+                std::this_thread::yield();
+            }
+        });
+        for (int i = 0; i != 20; ++i) {
+            bulk.schedule([&](const rxsc::schedulable&){
+                std::unique_lock<std::mutex> guard(lock);
+                ran.push_back("bulk");
+            });
+        }
+        WHEN("a control action is scheduled behind the bulk actions"){
+            std::atomic<bool> done(false);
+            control.schedule([&](const rxsc::schedulable&){
+                std::unique_lock<std::mutex> guard(lock);
+                ran.push_back("control");
+            });
+            bulk.schedule([&](const rxsc::schedulable&){
+                done = true;
+            });
+            open = true;
+            while (!done) {
+                std::this_thread::yield();
+            }
+            THEN("it runs before the bulk actions that were waiting"){
+                std::unique_lock<std::mutex> guard(lock);
+                REQUIRE(ran.size() == 21);
+                REQUIRE(ran.front() == "control");
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread shutdown cancels at the deadline", "[new_thread][shutdown][scheduler]"){
+    GIVEN("a new_thread worker running an action that always schedules its next step"){
+        auto sc = rxsc::make_new_thread([](std::function<void()> start){
+            return std::thread(std::move(start));
+        });
+        auto w = sc.create_worker();
+        std::atomic<int> steps(0);
+        w.schedule([&](const rxsc::schedulable& self){
+            ++steps;
+            self.schedule();
+        });
+        while (steps == 0) {
+            std::this_thread::yield();
+        }
+        WHEN("it is shut down"){
+            auto drained = sc.shutdown(sc.now() + std::chrono::milliseconds(20));
+            THEN("the steps run until the deadline and are then cancelled"){
+                REQUIRE(!drained);
+                REQUIRE(!w.is_subscribed());
+                int stopped = steps;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                REQUIRE(steps <= stopped + 1);
+            }
+            THEN("a worker created afterwards is unsubscribed"){
+                REQUIRE(!sc.create_worker().is_subscribed());
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread shutdown after a worker stopped", "[new_thread][shutdown][scheduler]"){
+    GIVEN("a new_thread worker that ran its action and was unsubscribed"){
+        auto sc = rxsc::make_new_thread([](std::function<void()> start){
+            return std::thread(std::move(start));
+        });
+        rx::composite_subscription cs;
+        auto w = sc.create_worker(cs);
+        std::atomic<bool> ran(false);
+        w.schedule([&](const rxsc::schedulable&){
+            ran = true;
+        });
+        while (!ran) {
+            std::this_thread::yield();
+        }
+        cs.unsubscribe();
+        WHEN("it is shut down"){
+            auto drained = sc.shutdown(sc.now() + std::chrono::seconds(1));
+            THEN("nothing was cancelled"){
+                REQUIRE(drained);
+            }
+        }
+    }
+}
+
+SCENARIO("the shared new_thread refuses shutdown", "[new_thread][shutdown][scheduler]"){
+    GIVEN("the new_thread that the process shares"){
+        auto sc = rxsc::make_new_thread();
+        WHEN("it is shut down"){
+            auto drained = sc.shutdown(sc.now());
+            THEN("it reports that it did not drain"){
+                REQUIRE(!drained);
+            }
+            THEN("a worker created afterwards still runs its work"){
+                auto w = sc.create_worker();
+                REQUIRE(w.is_subscribed());
+                std::atomic<bool> ran(false);
+                w.schedule([&](const rxsc::schedulable&){
+                    ran = true;
+                });
+                while (!ran) {
+                    std::this_thread::yield();
+                }
+                REQUIRE(ran);
+                w.unsubscribe();
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread idle strategies", "[new_thread][idle][scheduler]"){
+    GIVEN("a new_thread worker for each idle strategy"){
+        auto tf = [](std::function<void()> start){
+            return std::thread(std::move(start));
+        };
+        std::vector<rxsc::idle_strategy> strategies{
+            rxsc::idle_strategy::park(),
+            rxsc::idle_strategy::spin_yield_park(100, 10),
+            rxsc::idle_strategy::busy_spin()};
+
+        WHEN("actions are handed off one at a time, and then a timed action"){
+            std::vector<int> ran;
+            for (auto& idle : strategies) {
+                auto w = rxsc::make_new_thread(tf, idle).create_worker();
+                std::atomic<int> count(0);
+                for (int expected = 1; expected <= 100; ++expected) {
+                    w.schedule([&](const rxsc::schedulable&){++count;});
+                    while (count != expected) {
+                        std::this_thread::yield();
+                    }
+                }
+                w.schedule(w.now() + std::chrono::milliseconds(10), [&](const rxsc::schedulable&){++count;});
+                auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (count != 101 && std::chrono::steady_clock::now() < until) {
+                    std::this_thread::yield();
+                }
+                w.unsubscribe();
+                ran.push_back(count);
+            }
+
+            THEN("every action ran on each worker"){
+                std::vector<int> required{101, 101, 101};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop with an idle strategy", "[event_loop][idle][scheduler]"){
+    GIVEN("an event_loop of two spinning loops"){
+        auto sc = rxsc::make_event_loop([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 2, rxsc::idle_strategy::spin_yield_park());
+
+        WHEN("each loop runs an action"){
+            std::atomic<int> ran(0);
+            auto w1 = sc.create_worker();
+            auto w2 = sc.create_worker();
+            w1.schedule([&](const rxsc::schedulable&){++ran;});
+            w2.schedule([&](const rxsc::schedulable&){++ran;});
+            while (ran != 2) {
+                std::this_thread::yield();
+            }
+            THEN("there are two loops"){
+                REQUIRE(sc.stats().size() == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread with a thread cache", "[new_thread][cache][scheduler]"){
+    GIVEN("a new_thread scheduler on a thread cache"){
+        auto cache = rxsc::make_thread_cache([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, std::chrono::milliseconds(200), 4);
+        auto sc = rxsc::make_new_thread(cache);
+
+        auto wait_for = [](std::function<bool()> done){
+            auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!done() && std::chrono::steady_clock::now() < until) {
+                std::this_thread::yield();
+            }
+            return done();
+        };
+        auto thread_of = [&](rxsc::worker w){
+            std::mutex lock;
+            std::thread::id id;
+            std::atomic<bool> ran(false);
+            w.schedule([&](const rxsc::schedulable&){
+                std::unique_lock<std::mutex> guard(lock);
+                id = std::this_thread::get_id();
+                ran = true;
+            });
+            wait_for([&](){return ran.load();});
+            std::unique_lock<std::mutex> guard(lock);
+            return id;
+        };
+
+        WHEN("a worker stops and another is created"){
+            auto stopped = sc.create_worker();
+            auto first = thread_of(stopped);
+            stopped.unsubscribe();
+            auto parked = wait_for([&](){return cache->idle_count() == 1;});
+            auto w = sc.create_worker();
+            auto second = thread_of(w);
+
+            THEN("the second worker ran on the thread of the first"){
+                REQUIRE(parked);
+                REQUIRE(first == second);
+                REQUIRE(cache->idle_count() == 0);
+            }
+            THEN("two live workers have their own threads"){
+                auto other = sc.create_worker();
+                REQUIRE(thread_of(other) != second);
+                other.unsubscribe();
+            }
+            w.unsubscribe();
+        }
+
+        WHEN("a worker stops and no other is created"){
+            auto stopped = sc.create_worker();
+            thread_of(stopped);
+            stopped.unsubscribe();
+            auto parked = wait_for([&](){return cache->idle_count() == 1;});
+
+            THEN("its thread stops after keep_alive"){
+                REQUIRE(parked);
+                REQUIRE(wait_for([&](){return cache->idle_count() == 0;}));
+            }
+        }
+    }
+}
+
+SCENARIO("schedule_batch runs the batch in order", "[new_thread][batch][scheduler]"){
+    GIVEN("schedulers that queue and one that does not"){
+        std::vector<rxsc::scheduler> schedulers{
+            rxsc::make_new_thread(),
+            rxsc::make_event_loop(),
+            rxsc::make_work_stealing_pool(),
+            rxsc::make_elastic_pool(0, 2),
+            rxsc::make_current_thread()};
+
+        WHEN("a batch of actions is scheduled on a worker of each"){
+            const int actions = 100;
+            std::vector<std::vector<int>> results(schedulers.size());
+
+            for (size_t s = 0; s != schedulers.size(); ++s) {
+                auto w = schedulers[s].create_worker();
+                std::promise<void> done;
+                auto& result = results[s];
+                std::vector<rxsc::schedulable> batch;
+                for (int n = 0; n < actions; ++n) {
+                    batch.push_back(rxsc::make_schedulable(w, [&, n](const rxsc::schedulable&){
+                        result.push_back(n);
+                        if (n == actions - 1) {
+                            done.set_value();
+                        }
+                    }));
+                }
+                // an unsubscribed action is skipped
+                auto skipped = rxsc::make_schedulable(w, rx::composite_subscription(), [&](const rxsc::schedulable&){
+                    result.push_back(-1);
+                });
+                skipped.unsubscribe();
+                batch.insert(batch.begin() + actions / 2, skipped);
+
+                w.schedule_batch(batch);
+                done.get_future().wait();
+                w.unsubscribe();
+            }
+
+            THEN("each worker ran the batch in order"){
+                std::vector<int> expected;
+                for (int n = 0; n < actions; ++n) {
+                    expected.push_back(n);
+                }
+                for (auto& result : results) {
+                    REQUIRE(result == expected);
+                }
+            }
+        }
+    }
+}
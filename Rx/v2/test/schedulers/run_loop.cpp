@@ -0,0 +1,98 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("run_loop runs actions when dispatched", "[run_loop][scheduler]"){
+    GIVEN("a run_loop worker"){
+        rxsc::run_loop rl;
+        auto w = rxsc::make_run_loop(rl).create_worker();
+        std::vector<int> ran;
+        int notified = 0;
+        rl.set_notify_on_enqueue([&](){++notified;});
+
+        WHEN("three actions are scheduled"){
+            for (int i = 0; i != 3; ++i) {
+                w.schedule([&, i](const rxsc::schedulable&){ran.push_back(i);});
+            }
+
+            THEN("none ran before dispatch and the host was notified of each"){
+                REQUIRE(ran.empty());
+                REQUIRE(!rl.empty());
+                REQUIRE(notified == 3);
+            }
+            THEN("dispatch runs them in order"){
+                REQUIRE(rl.dispatch() == 3);
+                REQUIRE(ran == rxu::to_vector({0, 1, 2}));
+                REQUIRE(rl.empty());
+            }
+            THEN("a spent budget runs one action each dispatch"){
+                REQUIRE(rl.dispatch(std::chrono::milliseconds(0)) == 1);
+                REQUIRE(ran == rxu::to_vector({0}));
+                REQUIRE(rl.dispatch() == 2);
+                REQUIRE(ran == rxu::to_vector({0, 1, 2}));
+            }
+        }
+
+        WHEN("an action recurses"){
+            w.schedule([&](const rxsc::schedulable& self){
+                ran.push_back(static_cast<int>(ran.size()));
+                if (ran.size() < 5) {
+                    self();
+                }
+            });
+
+            THEN("each step is a separate action of the dispatch"){
+                REQUIRE(rl.dispatch(std::chrono::milliseconds(0)) == 1);
+                REQUIRE(rl.dispatch() == 4);
+                REQUIRE(ran == rxu::to_vector({0, 1, 2, 3, 4}));
+            }
+        }
+
+        WHEN("an action is scheduled for later"){
+            auto due = w.now() + std::chrono::milliseconds(20);
+            w.schedule(due, [&](const rxsc::schedulable&){ran.push_back(0);});
+
+            THEN("it runs from the first dispatch after it is due"){
+                REQUIRE(rl.dispatch() == 0);
+                REQUIRE(rl.next_due() == due);
+                std::this_thread::sleep_until(due);
+                REQUIRE(rl.dispatch() == 1);
+                REQUIRE(ran == rxu::to_vector({0}));
+            }
+        }
+    }
+}
+
+SCENARIO("observe_on_run_loop delivers on the dispatching thread", "[run_loop][observe_on][scheduler]"){
+    GIVEN("a run_loop"){
+        rxsc::run_loop rl;
+        std::vector<int> result;
+        bool completed = false;
+
+        WHEN("a range is observed on it"){
+            rxs::range(1, 3)
+                .observe_on(rx::observe_on_run_loop(rl))
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](){
+                        completed = true;
+                    });
+
+            THEN("the values arrive as the loop is dispatched"){
+                REQUIRE(result.empty());
+                while (!rl.empty()) {
+                    rl.dispatch();
+                }
+                REQUIRE(result == rxu::to_vector({1, 2, 3}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("timer_wheel orders items like schedulable_queue", "[timer_wheel][scheduler]"){
+    GIVEN("a wheel and a heap"){
+        typedef rxsc::scheduler::clock_type clock_type;
+        typedef rxsc::detail::timer_wheel<clock_type::time_point> wheel_type;
+        typedef rxsc::detail::schedulable_queue<clock_type::time_point> heap_type;
+
+        auto w = rxsc::make_immediate().create_worker();
+        auto empty = rxsc::make_schedulable(w, [](const rxsc::schedulable&){});
+
+        wheel_type wheel(std::chrono::milliseconds(1));
+        heap_type heap;
+
+        auto start = clock_type::now();
+        std::vector<clock_type::time_point> expected;
+        std::vector<clock_type::time_point> actual;
+
+        WHEN("items are pushed at times spread over hours and popped while pushing more"){
+            unsigned seed = 1;
+            auto next = [&](){
+                seed = seed * 1103515245 + 12345;
+                return (seed >> 8) % 10000000;
+            };
+            for (int round = 0; round < 20; ++round) {
+                for (int n = 0; n < 200; ++n) {
+                    // cluster some items on the same millisecond
+                    auto offset = n % 3 == 0 ? round * 1000 : next();
+                    auto when = start + std::chrono::milliseconds(offset);
+                    wheel.push(wheel_type::item_type(when, empty));
+                    heap.push(heap_type::item_type(when, empty));
+                }
+                for (int n = 0; n < 150; ++n) {
+                    expected.push_back(heap.top().when);
+                    heap.pop();
+                    actual.push_back(wheel.top().when);
+                    wheel.pop();
+                }
+            }
+            while (!heap.empty()) {
+                expected.push_back(heap.top().when);
+                heap.pop();
+                actual.push_back(wheel.top().when);
+                wheel.pop();
+            }
+
+            THEN("the items came out in the same order"){
+                REQUIRE(wheel.empty());
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+}
+
+SCENARIO("timer_wheel keeps items in the same tick in fifo order", "[timer_wheel][scheduler]"){
+    GIVEN("a wheel"){
+        typedef rxsc::scheduler::clock_type clock_type;
+        typedef rxsc::detail::timer_wheel<clock_type::time_point> wheel_type;
+
+        auto w = rxsc::make_immediate().create_worker();
+        std::vector<int> result;
+        auto push = [&](int v){
+            return rxsc::make_schedulable(w, [&result, v](const rxsc::schedulable&){
+                result.push_back(v);
+            });
+        };
+
+        wheel_type wheel(std::chrono::milliseconds(10));
+        auto start = clock_type::now();
+
+        WHEN("items are pushed to two ticks, one far away, and one is erased"){
+            wheel.push(wheel_type::item_type(start + std::chrono::hours(1), push(4)));
+            wheel.push(wheel_type::item_type(start, push(1)));
+            auto erased = wheel.push(wheel_type::item_type(start, push(0)));
+            wheel.push(wheel_type::item_type(start, push(2)));
+            wheel.push(wheel_type::item_type(start + std::chrono::hours(1), push(5)));
+            wheel.push(wheel_type::item_type(start + std::chrono::minutes(1), push(3)));
+            wheel.erase(erased);
+
+            rxsc::recursion r;
+            while (!wheel.empty()) {
+                auto what = wheel.top().what;
+                wheel.pop();
+                what(r.get_recurse());
+            }
+
+            THEN("the items ran in tick order and fifo within a tick"){
+                std::vector<int> expected;
+                for (int i = 1; i <= 5; ++i) {
+                    expected.push_back(i);
+                }
+                REQUIRE(result == expected);
+            }
+        }
+    }
+}
+
+SCENARIO("new_thread with a timer wheel runs delayed actions", "[timer_wheel][new_thread][scheduler]"){
+    GIVEN("a new_thread worker using a timer wheel"){
+        auto w = rxsc::make_new_thread([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, std::chrono::milliseconds(1)).create_worker();
+
+        WHEN("actions are scheduled out of time order"){
+            std::mutex lock;
+            std::condition_variable wake;
+            std::vector<int> result;
+
+            auto push = [&](int v){
+                return [&, v](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    result.push_back(v);
+                    wake.notify_one();
+                };
+            };
+            auto start = w.now();
+            w.schedule(start + std::chrono::milliseconds(60), push(3));
+            w.schedule(start + std::chrono::milliseconds(30), push(2));
+            w.schedule(push(1));
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return result.size() == 3;});
+            }
+
+            THEN("they ran in time order"){
+                std::vector<int> expected;
+                expected.push_back(1);
+                expected.push_back(2);
+                expected.push_back(3);
+                REQUIRE(result == expected);
+                REQUIRE(w.now() - start >= std::chrono::milliseconds(60));
+            }
+        }
+    }
+}
+
+SCENARIO("timed queues drop cancelled items when compacted", "[timer_wheel][scheduler]"){
+    GIVEN("a wheel and a heap holding cancelled and live items"){
+        typedef rxsc::scheduler::clock_type clock_type;
+        typedef rxsc::detail::timer_wheel<clock_type::time_point> wheel_type;
+        typedef rxsc::detail::schedulable_queue<clock_type::time_point> heap_type;
+
+        auto w = rxsc::make_immediate().create_worker();
+
+        wheel_type wheel(std::chrono::milliseconds(1));
+        heap_type heap;
+        std::vector<rx::composite_subscription> lifetimes;
+
+        auto start = clock_type::now();
+        for (int n = 0; n < 100; ++n) {
+            rx::composite_subscription cs;
+            lifetimes.push_back(cs);
+            auto what = rxsc::make_schedulable(w, cs, [](const rxsc::schedulable&){});
+            auto when = start + std::chrono::seconds(100 - n);
+            wheel.push(wheel_type::item_type(when, what));
+            heap.push(heap_type::item_type(when, what));
+        }
+        for (int n = 0; n < 100; n += 2) {
+            lifetimes[n].unsubscribe();
+        }
+
+        WHEN("compacted"){
+            auto wheelRemoved = wheel.compact();
+            auto heapRemoved = heap.compact();
+
+            THEN("only the live items remain, in time order"){
+                REQUIRE(wheelRemoved == 50);
+                REQUIRE(heapRemoved == 50);
+                REQUIRE(wheel.size() == 50);
+                REQUIRE(heap.size() == 50);
+                auto last = start;
+                while (!heap.empty()) {
+                    REQUIRE(heap.top().what.is_subscribed());
+                    REQUIRE(wheel.top().when == heap.top().when);
+                    REQUIRE(last < heap.top().when);
+                    last = heap.top().when;
+                    heap.pop();
+                    wheel.pop();
+                }
+                REQUIRE(wheel.empty());
+            }
+        }
+    }
+}
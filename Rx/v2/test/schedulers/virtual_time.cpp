@@ -0,0 +1,90 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("virtual time advance_to", "[virtual_time][scheduler]"){
+    GIVEN("a test worker with actions at 100, 200 and 300"){
+        auto w = rxsc::make_test().create_worker();
+        std::vector<long> ran;
+        for (long when : {300, 100, 200}) {
+            w.schedule_absolute(when, [&](const rxsc::schedulable&){
+                ran.push_back(w.clock());
+            });
+        }
+
+        WHEN("advanced to 200"){
+            w.advance_to(200);
+
+            THEN("the actions up to 200 have run"){
+                std::vector<long> required{100, 200};
+                REQUIRE(required == ran);
+            }
+            THEN("the clock is at 200 and the worker is not enabled"){
+                REQUIRE(w.clock() == 200);
+                REQUIRE(!w.is_enabled());
+            }
+            THEN("the action at 300 runs when the worker is started"){
+                w.start();
+                std::vector<long> required{100, 200, 300};
+                REQUIRE(required == ran);
+            }
+        }
+
+        WHEN("advanced to 150 and then to 400"){
+            w.advance_to(150);
+            w.advance_to(400);
+
+            THEN("every action has run at its own time"){
+                std::vector<long> required{100, 200, 300};
+                REQUIRE(required == ran);
+                REQUIRE(w.clock() == 400);
+            }
+        }
+    }
+}
+
+SCENARIO("virtual time stop", "[virtual_time][scheduler]"){
+    GIVEN("a test worker with three actions at the same time"){
+        auto w = rxsc::make_test().create_worker();
+        std::vector<int> ran;
+        w.schedule_absolute(100, [&](const rxsc::schedulable&){ran.push_back(1);});
+        w.schedule_absolute(100, [&](const rxsc::schedulable&){ran.push_back(2); w.stop();});
+        w.schedule_absolute(100, [&](const rxsc::schedulable&){ran.push_back(3);});
+
+        WHEN("started"){
+            w.start();
+
+            THEN("the actions after the stop have not run"){
+                std::vector<int> required{1, 2};
+                REQUIRE(required == ran);
+            }
+            THEN("the rest run in order when started again"){
+                w.start();
+                std::vector<int> required{1, 2, 3};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+
+    GIVEN("a test worker with an action that is unsubscribed before it is due"){
+        auto w = rxsc::make_test().create_worker();
+        std::vector<int> ran;
+        rx::composite_subscription cs;
+        w.schedule_absolute(100, cs, [&](const rxsc::schedulable&){ran.push_back(1);});
+        w.schedule_absolute(200, [&](const rxsc::schedulable&){ran.push_back(2);});
+
+        WHEN("started"){
+            cs.unsubscribe();
+            w.start();
+
+            THEN("only the subscribed action has run"){
+                std::vector<int> required{2};
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("work stealing pool keeps each worker in order", "[work_stealing][scheduler]"){
+    GIVEN("a pool with two threads and many workers"){
+        auto sc = rxsc::make_work_stealing_pool([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 2);
+
+        WHEN("each worker is given a sequence of actions"){
+            const int workers = 16;
+            const int actions = 200;
+
+            std::mutex lock;
+            std::condition_variable wake;
+            int remaining = workers;
+            std::vector<std::vector<int>> results(workers);
+            std::vector<rxsc::worker> w;
+
+            for (int i = 0; i < workers; ++i) {
+                w.push_back(sc.create_worker());
+            }
+            for (int n = 0; n < actions; ++n) {
+                for (int i = 0; i < workers; ++i) {
+                    auto& result = results[i];
+                    w[i].schedule([&, i, n](const rxsc::schedulable&){
+                        result.push_back(n);
+                        if (n + 1 == actions) {
+                            std::unique_lock<std::mutex> guard(lock);
+                            --remaining;
+                            wake.notify_one();
+                        }
+                    });
+                }
+            }
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return remaining == 0;});
+            }
+
+            THEN("every worker ran its actions in the order they were scheduled"){
+                std::vector<int> expected;
+                for (int n = 0; n < actions; ++n) {
+                    expected.push_back(n);
+                }
+                for (auto& result : results) {
+                    REQUIRE(result == expected);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("work stealing pool runs delayed actions", "[work_stealing][scheduler]"){
+    GIVEN("a pool"){
+        auto sc = rxsc::make_work_stealing_pool([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 2);
+        auto w = sc.create_worker();
+
+        WHEN("actions are scheduled out of time order"){
+            std::mutex lock;
+            std::condition_variable wake;
+            std::vector<int> result;
+
+            auto push = [&](int v){
+                return [&, v](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    result.push_back(v);
+                    wake.notify_one();
+                };
+            };
+            auto start = w.now();
+            w.schedule(start + std::chrono::milliseconds(60), push(3));
+            w.schedule(start + std::chrono::milliseconds(30), push(2));
+            w.schedule(push(1));
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return result.size() == 3;});
+            }
+
+            THEN("they ran in time order"){
+                std::vector<int> expected;
+                expected.push_back(1);
+                expected.push_back(2);
+                expected.push_back(3);
+                REQUIRE(result == expected);
+                REQUIRE(w.now() - start >= std::chrono::milliseconds(60));
+            }
+        }
+    }
+}
+
+SCENARIO("range observed on the work stealing pool", "[work_stealing][observe_on][scheduler]"){
+    GIVEN("a range"){
+        WHEN("observed on the work stealing pool"){
+            std::atomic<int> count(0);
+            std::atomic<bool> done(false);
+            int last = 0;
+            bool ordered = true;
+
+            rxs::range<int>(1, 1000)
+                .observe_on(rx::observe_on_work_stealing_pool())
+                .subscribe(
+                    [&](int v){
+                        ordered = ordered && v == last + 1;
+                        last = v;
+                        ++count;
+                    },
+                    [&](){
+                        done = true;
+                    });
+            while (!done) {
+                std::this_thread::yield();
+            }
+
+            THEN("all values arrive in order"){
+                REQUIRE(count == 1000);
+                REQUIRE(ordered);
+            }
+        }
+    }
+}
+
+SCENARIO("work stealing pool keeps the stats of each thread", "[work_stealing][stats][scheduler]"){
+    GIVEN("a pool with two threads"){
+        auto sc = rxsc::make_work_stealing_pool([](std::function<void()> start){
+            return std::thread(std::move(start));
+        }, 2);
+
+        WHEN("many workers run actions"){
+            const int workers = 8;
+            const int actions = 50;
+            std::atomic<int> remaining(workers * actions);
+            std::vector<rxsc::worker> w;
+            for (int i = 0; i < workers; ++i) {
+                w.push_back(sc.create_worker());
+            }
+            for (int n = 0; n < actions; ++n) {
+                for (auto& worker : w) {
+                    worker.schedule([&](const rxsc::schedulable&){
+                        --remaining;
+                    });
+                }
+            }
+
+            THEN("each thread reports and all the actions are counted"){
+                auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                std::vector<rxsc::worker_stats> all;
+                std::uint64_t counted = 0;
+                while (counted < std::uint64_t(workers * actions) && std::chrono::steady_clock::now() < until) {
+                    all = sc.stats();
+                    counted = 0;
+                    for (auto& s : all) {
+                        counted += s.actions;
+                    }
+                }
+                REQUIRE(remaining == 0);
+                REQUIRE(all.size() == 2);
+                REQUIRE(counted == std::uint64_t(workers * actions));
+                for (auto& s : all) {
+                    REQUIRE(s.queued == 0);
+                }
+            }
+        }
+    }
+}
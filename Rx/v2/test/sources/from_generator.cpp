@@ -0,0 +1,105 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// counts up from one to last
+struct count_to
+{
+    explicit count_to(int l) : next(0), last(l), pulled(std::make_shared<std::atomic<int>>(0)) {}
+    rxu::maybe<int> operator()() {
+        ++*pulled;
+        if (next == last) {
+            return rxu::maybe<int>();
+        }
+        return rxu::maybe<int>(++next);
+    }
+    int next;
+    int last;
+    std::shared_ptr<std::atomic<int>> pulled;
+};
+}
+
+SCENARIO("from_generator sends each generated value", "[from_generator][sources]"){
+    GIVEN("a generator of five values"){
+        count_to g(5);
+
+        WHEN("it is subscribed twice"){
+            std::vector<int> result;
+            auto xs = rx::observable<>::from_generator(g);
+            xs.subscribe([&](int v){result.push_back(v);});
+            xs.subscribe([&](int v){result.push_back(v);});
+
+            THEN("each subscription pulled from its own copy"){
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 4, 5, 1, 2, 3, 4, 5}));
+            }
+        }
+        WHEN("only two values are taken"){
+            std::vector<int> result;
+            rx::observable<>::from_generator(g)
+                .take(2)
+                .subscribe([&](int v){result.push_back(v);});
+
+            THEN("the generator was only called for the values taken"){
+                REQUIRE(result == rxu::to_vector({1, 2}));
+                REQUIRE(*g.pulled == 2);
+            }
+        }
+    }
+    GIVEN("a generator that throws"){
+        auto g = []() -> rxu::maybe<int> {throw std::runtime_error("generator failed");};
+
+        WHEN("it is subscribed"){
+            std::string error;
+            rx::observable<>::from_generator(g)
+                .subscribe(
+                    [](int){},
+                    [&](std::exception_ptr e){
+                        try {std::rethrow_exception(e);} catch (const std::exception& ex) {error = ex.what();}
+                    });
+
+            THEN("the error was sent"){
+                REQUIRE(error == "generator failed");
+            }
+        }
+    }
+}
+
+SCENARIO("from_generator only pulls values that are requested", "[from_generator][demand][sources]"){
+    GIVEN("a generator that honors demand"){
+        count_to g(1000);
+        rx::demand pull;
+
+        WHEN("observed on a new thread with a window of four"){
+            std::atomic<bool> done(false);
+            std::vector<int> result;
+            int most = 0;
+
+            rxs::from_generator(g, rx::identity_current_thread(), pull)
+                .observe_on(rx::observe_on_new_thread(), pull, 4)
+                .subscribe(
+                    [&](int v){
+                        // values pulled but not yet delivered
+                        most = (std::max)(most, *g.pulled - v);
+                        result.push_back(v);
+                    },
+                    [&](){
+                        done = true;
+                    });
+            while (!done) {
+                std::this_thread::yield();
+            }
+
+            THEN("the generator never ran more than the window ahead"){
+                REQUIRE(result.size() == 1000);
+                REQUIRE(result.back() == 1000);
+                REQUIRE(most <= 4);
+            }
+        }
+    }
+}
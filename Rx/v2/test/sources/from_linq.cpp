@@ -0,0 +1,122 @@
+#include "rxcpp/rx.hpp"
+#include "rxcpp/sources/rx-from_linq.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("from_linq sends the results of a query", "[from_linq][linq][sources]"){
+    GIVEN("a query over a vector"){
+        std::vector<int> values;
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        auto query = cpplinq::from(values)
+            .where([](int v){return v % 2 == 0;})
+            .select([](int v){return v * 10;});
+
+        std::vector<int> expected;
+        for (int i = 0; i < 100; i += 2) {
+            expected.push_back(i * 10);
+        }
+
+        WHEN("an observer that accepts runs of values subscribes"){
+            std::vector<int> result;
+            std::vector<size_t> batches;
+            bool completed = false;
+
+            auto out = rx::make_observer_with_range(
+                rx::make_observer<int>(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](){
+                        completed = true;
+                    }),
+                [&](const int* first, size_t count){
+                    batches.push_back(count);
+                    result.insert(result.end(), first, first + count);
+                });
+
+            rxs::from_linq(query, rx::identity_current_thread(), 20)
+                .subscribe(out);
+
+            THEN("the results arrive in chunks"){
+                REQUIRE(result == expected);
+                REQUIRE(batches == rxu::to_vector<size_t>({20, 20, 10}));
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("some of the results are taken"){
+            std::vector<int> result;
+            int reads = 0;
+            rxs::from_linq(cpplinq::from(values).select([&](int v){++reads; return v;}), rx::identity_current_thread(), 10)
+                .take(5)
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    });
+
+            THEN("the cursor stops after the chunk in which the consumer unsubscribes"){
+                REQUIRE(result == rxu::to_vector<int>({0, 1, 2, 3, 4}));
+                REQUIRE(reads == 10);
+            }
+        }
+
+        WHEN("the query throws"){
+            bool failed = false;
+            std::vector<int> result;
+            rxs::from_linq(cpplinq::from(values).select([](int v){if (v == 3) throw std::runtime_error("3"); return v;}))
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](std::exception_ptr){
+                        failed = true;
+                    });
+
+            THEN("the values before the error are sent and then the error"){
+                REQUIRE(result == rxu::to_vector<int>({0, 1, 2}));
+                REQUIRE(failed);
+            }
+        }
+    }
+}
+
+SCENARIO("to_linq buffers an observable into a query", "[to_linq][linq][sources]"){
+    GIVEN("a range"){
+        WHEN("it is queried"){
+            auto query = rx::to_linq(rxs::range(1, 10));
+
+            THEN("the query sees every value"){
+                REQUIRE(query.count() == 10);
+                REQUIRE(query.where([](int v){return v > 5;}).sum() == 40);
+                REQUIRE(query.to_vector() == rxu::to_vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+            }
+        }
+
+        WHEN("a query is sent back to an observable"){
+            std::vector<int> result;
+            rxs::from_linq(rx::to_linq(rxs::range(1, 5)).select([](int v){return v * v;}))
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    });
+
+            THEN("the values survive the trip"){
+                REQUIRE(result == rxu::to_vector<int>({1, 4, 9, 16, 25}));
+            }
+        }
+    }
+    GIVEN("an observable that fails"){
+        WHEN("it is queried"){
+            THEN("the error is rethrown"){
+                REQUIRE_THROWS_AS(rx::to_linq(rxs::error<int>(std::runtime_error("failed"))), std::runtime_error);
+            }
+        }
+    }
+}
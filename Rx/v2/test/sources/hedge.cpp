@@ -0,0 +1,123 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("hedge takes the first attempt to answer", "[hedge][amb][sources]"){
+    GIVEN("a slow and a fast attempt"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto slow = sc.make_cold_observable({
+            on.next(300, 0),
+            on.completed(310)
+        });
+        auto fast = sc.make_cold_observable({
+            on.next(30, 1),
+            on.completed(40)
+        });
+        auto unused = sc.make_cold_observable({
+            on.next(10, 2),
+            on.completed(20)
+        });
+        auto attempts = rxu::to_vector({slow, fast, unused});
+
+        WHEN("a backup is subscribed after 50ms"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return rx::observable<>::hedge(milliseconds(50), [&](int attempt){return attempts[attempt];}, 3, so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the answer of the backup"){
+                auto required = rxu::to_vector({
+                    on.next(280, 1),
+                    on.completed(290)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the first attempt was unsubscribed when the backup answered"){
+                REQUIRE(slow.subscriptions() == rxu::to_vector({on.subscribe(200, 280)}));
+                REQUIRE(fast.subscriptions() == rxu::to_vector({on.subscribe(250, 290)}));
+            }
+
+            THEN("no further attempt was made"){
+                REQUIRE(unused.subscriptions().empty());
+            }
+        }
+    }
+}
+
+SCENARIO("hedge starts the next attempt when one fails", "[hedge][amb][sources]"){
+    GIVEN("attempts that fail"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("hedge on_error from attempt");
+
+        auto failing = sc.make_cold_observable({
+            on.error(10, ex)
+        });
+        auto answering = sc.make_cold_observable({
+            on.next(20, 1),
+            on.completed(30)
+        });
+
+        WHEN("the first attempt fails"){
+            using namespace std::chrono;
+
+            auto attempts = rxu::to_vector({failing, answering});
+
+            auto res = w.start(
+                [&]() {
+                    return rx::observable<>::hedge(milliseconds(50), [&](int attempt){return attempts[attempt];}, 2, so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the second attempt is subscribed at once"){
+                auto required = rxu::to_vector({
+                    on.next(230, 1),
+                    on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+                REQUIRE(answering.subscriptions() == rxu::to_vector({on.subscribe(210, 240)}));
+            }
+        }
+
+        WHEN("every attempt fails"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return rx::observable<>::hedge(milliseconds(50), [&](int){return failing;}, 2, so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the error of the last attempt"){
+                auto required = rxu::to_vector({
+                    on.error(220, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
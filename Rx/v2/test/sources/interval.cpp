@@ -95,3 +95,98 @@ SCENARIO("intervals", "[hide][periodically][interval][scheduler][long][perf][sou
         }
     }
 }
+
+SCENARIO("intervals that tick together share a timer", "[interval][sources]"){
+    GIVEN("a test scheduler"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        auto so = rx::identity_one_worker(sc);
+        auto start = sc.now() + std::chrono::milliseconds(100);
+        auto period = std::chrono::milliseconds(10);
+
+        WHEN("three intervals start together and one starts two periods later"){
+            std::vector<std::vector<std::pair<long, long>>> ticks(4);
+            rx::composite_subscription cs;
+            for (int i = 0; i != 4; ++i) {
+                auto first = i == 3 ? start + 2 * period : start;
+                auto& record = ticks[i];
+                rx::observable<>::interval(first, period, so)
+                    .subscribe(cs, [&](long v){record.push_back(std::make_pair(sc.clock(), v));});
+            }
+            auto timers = rxcpp::sources::detail::interval_timers::instance().size();
+            w.advance_to(145);
+            cs.unsubscribe();
+            auto left = rxcpp::sources::detail::interval_timers::instance().size();
+
+            THEN("they shared one timer"){
+                REQUIRE(timers == 1);
+            }
+            THEN("each ticked on time with its own count"){
+                std::vector<std::pair<long, long>> together{{100, 1}, {110, 2}, {120, 3}, {130, 4}, {140, 5}};
+                std::vector<std::pair<long, long>> later{{120, 1}, {130, 2}, {140, 3}};
+                REQUIRE(ticks[0] == together);
+                REQUIRE(ticks[1] == together);
+                REQUIRE(ticks[2] == together);
+                REQUIRE(ticks[3] == later);
+            }
+            THEN("the timer stopped when they were unsubscribed"){
+                REQUIRE(left == 0);
+            }
+        }
+
+        WHEN("two intervals start half a period apart"){
+            rx::composite_subscription cs;
+            rx::observable<>::interval(start, period, so).subscribe(cs, [](long){});
+            rx::observable<>::interval(start + period / 2, period, so).subscribe(cs, [](long){});
+            auto timers = rxcpp::sources::detail::interval_timers::instance().size();
+            cs.unsubscribe();
+
+            THEN("each has its own timer"){
+                REQUIRE(timers == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("intervals on an event_loop share a timer", "[interval][sources]"){
+    GIVEN("many intervals on an event_loop with the same start and period"){
+        auto so = rx::identity_one_worker(rxsc::make_event_loop());
+        auto start = so.now() + std::chrono::milliseconds(20);
+        auto period = std::chrono::milliseconds(5);
+
+        WHEN("each takes 3 values"){
+            const int intervals = 50;
+            std::mutex lock;
+            std::condition_variable wake;
+            int completed = 0;
+            std::vector<std::vector<long>> values(intervals);
+            for (int i = 0; i != intervals; ++i) {
+                auto& record = values[i];
+                rx::observable<>::interval(start, period, so)
+                    .take(3)
+                    .subscribe(
+                        [&](long v){record.push_back(v);},
+                        [&](){
+                            std::unique_lock<std::mutex> guard(lock);
+                            ++completed;
+                            wake.notify_one();
+                        });
+            }
+            auto timers = rxcpp::sources::detail::interval_timers::instance().size();
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return completed == intervals;});
+            }
+
+            THEN("they shared one timer"){
+                REQUIRE(timers == 1);
+            }
+            THEN("each got its values in order"){
+                std::vector<long> expected{1, 2, 3};
+                for (auto& v : values) {
+                    REQUIRE(v == expected);
+                }
+            }
+        }
+    }
+}
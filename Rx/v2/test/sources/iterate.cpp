@@ -0,0 +1,125 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+#include <list>
+
+SCENARIO("iterate sends chunks of values", "[iterate][batch][sources]"){
+    GIVEN("an observer that accepts runs of values"){
+        std::vector<int> result;
+        std::vector<size_t> batches;
+        bool completed = false;
+
+        auto out = rx::make_observer_with_range(
+            rx::make_observer<int>(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                }),
+            [&](const int* first, size_t count){
+                batches.push_back(count);
+                result.insert(result.end(), first, first + count);
+            });
+
+        std::vector<int> values;
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+
+        WHEN("a vector is sent in chunks of 30"){
+            rxs::iterate(values, rx::identity_current_thread(), 30)
+                .subscribe(out);
+
+            THEN("the values arrive in 4 runs"){
+                REQUIRE(result == values);
+                REQUIRE(batches == rxu::to_vector<size_t>({30, 30, 30, 10}));
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("a list is sent in chunks of 30"){
+            rxs::iterate(std::list<int>(values.begin(), values.end()), rx::identity_current_thread(), 30)
+                .subscribe(out);
+
+            THEN("the values arrive in 4 runs"){
+                REQUIRE(result == values);
+                REQUIRE(batches == rxu::to_vector<size_t>({30, 30, 30, 10}));
+                REQUIRE(completed);
+            }
+        }
+    }
+    GIVEN("an observer that accepts one value at a time"){
+        std::vector<int> result;
+        bool completed = false;
+
+        std::vector<int> values;
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+
+        WHEN("a vector is sent in chunks of 30 and 45 values are taken"){
+            rxs::iterate(values, rx::identity_current_thread(), 30)
+                .take(45)
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                    },
+                    [&](){
+                        completed = true;
+                    });
+
+            THEN("the chunk stops when the consumer unsubscribes"){
+                REQUIRE(result == std::vector<int>(values.begin(), values.begin() + 45));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("skip and take narrow an iterate", "[iterate][skip][take][sources]"){
+    GIVEN("collections that are sliced"){
+        auto collect = [](rx::observable<int> o){
+            std::vector<int> result;
+            bool completed = false;
+            o.subscribe(
+                [&](int v){result.push_back(v);},
+                [&](){completed = true;});
+            REQUIRE(completed);
+            return result;
+        };
+
+        WHEN("a page of a vector is taken"){
+            std::vector<int> v(1000);
+            for (int i = 0; i != 1000; ++i) {
+                v[i] = i;
+            }
+            auto page = rxs::iterate(v).skip(500).take(3);
+            THEN("the source is an iterate of the page"){
+                static_assert(std::is_same<decltype(page), decltype(rxs::iterate(v))>::value, "skip and take of an iterate must be an iterate");
+                REQUIRE(collect(page.as_dynamic()) == rxu::to_vector({500, 501, 502}));
+            }
+            THEN("a take past the end stops at the end"){
+                REQUIRE(collect(rxs::iterate(v).skip(998).take(5).as_dynamic()) == rxu::to_vector({998, 999}));
+            }
+            THEN("the slices compose"){
+                REQUIRE(collect(rxs::iterate(v).take(10).skip(8).take(5).as_dynamic()) == rxu::to_vector({8, 9}));
+                REQUIRE(collect(rxs::iterate(v).skip(2000).as_dynamic()).empty());
+            }
+        }
+
+        WHEN("a list is sliced"){
+            std::list<int> l{1, 2, 3, 4, 5};
+            THEN("the slice is sent"){
+                REQUIRE(collect(rxs::iterate(l).skip(1).take(3).as_dynamic()) == rxu::to_vector({2, 3, 4}));
+                REQUIRE(collect(rxs::iterate(l).as_dynamic()) == rxu::to_vector({1, 2, 3, 4, 5}));
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#include "rxcpp/rx.hpp"
+#include "rxcpp/sources/rx-mapped_file.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+SCENARIO("mapped_file sends slices of a file", "[mapped_file][sources]"){
+    GIVEN("a file of lines"){
+        const char* path = "rxcpp_mapped_file_test.txt";
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "first\nsecond\r\n\nlast";
+        }
+
+        std::vector<rx::slice> result;
+        bool completed = false;
+
+        WHEN("the file is split into lines"){
+            rxs::mapped_file(path, rxs::by_line())
+                .subscribe(
+                    [&](rx::slice s){result.push_back(s);},
+                    [&](){completed = true;});
+
+            THEN("each line is sent without its end of line"){
+                REQUIRE(completed);
+                REQUIRE(result.size() == 4);
+                REQUIRE(result[0] == std::string("first"));
+                REQUIRE(result[1] == std::string("second"));
+                REQUIRE(result[2] == std::string(""));
+                REQUIRE(result[3] == std::string("last"));
+            }
+            THEN("the slices share the mapping and stay valid after the end"){
+                REQUIRE(result[0].get_owner() == result[3].get_owner());
+                REQUIRE(result[3].str() == "last");
+            }
+        }
+
+        WHEN("the file is split at each 'e'"){
+            rxs::mapped_file(path, rxs::by_delimiter('e'))
+                .map([](rx::slice s){return s.str();})
+                .subscribe(
+                    [&](std::string s){result.push_back(rx::slice(s));},
+                    [&](){completed = true;});
+
+            THEN("the delimiters are dropped"){
+                REQUIRE(completed);
+                REQUIRE(result.size() == 2);
+                REQUIRE(result[0] == std::string("first\ns"));
+                REQUIRE(result[1] == std::string("cond\r\n\nlast"));
+            }
+        }
+
+        WHEN("the file is split into records of 8 bytes"){
+            rxs::mapped_file(path, rxs::by_record(8))
+                .subscribe(
+                    [&](rx::slice s){result.push_back(s);},
+                    [&](){completed = true;});
+
+            THEN("the last record is shorter"){
+                REQUIRE(completed);
+                REQUIRE(result.size() == 3);
+                REQUIRE(result[0] == std::string("first\nse"));
+                REQUIRE(result[1] == std::string("cond\r\n\nl"));
+                REQUIRE(result[2] == std::string("ast"));
+            }
+        }
+
+        std::remove(path);
+    }
+    GIVEN("a path without a file"){
+        WHEN("the file is mapped"){
+            bool failed = false;
+            rxs::mapped_file("rxcpp_mapped_file_missing.txt", rxs::by_line())
+                .subscribe(
+                    [](rx::slice){},
+                    [&](std::exception_ptr){failed = true;});
+
+            THEN("the error is sent"){
+                REQUIRE(failed);
+            }
+        }
+    }
+}
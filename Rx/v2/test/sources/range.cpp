@@ -0,0 +1,249 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("range sends values as they are requested", "[range][demand][sources]"){
+    GIVEN("a range that honors demand"){
+        rx::demand pull;
+        std::vector<int> result;
+        bool completed = false;
+
+        rxs::range<int>(1, 5, 1, rx::identity_current_thread(), pull)
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                });
+
+        WHEN("nothing was requested"){
+            THEN("no values were sent"){
+                REQUIRE(result.empty());
+                REQUIRE(!completed);
+            }
+        }
+        WHEN("values are requested in parts"){
+            pull.request(2);
+            auto first = result;
+            pull.request(2);
+            auto second = result;
+            pull.request(10);
+
+            THEN("each request sent that many values"){
+                REQUIRE(first == rxu::to_vector({1, 2}));
+                REQUIRE(second == rxu::to_vector({1, 2, 3, 4}));
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 4, 5}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("range with a step that does not reach last honors demand", "[range][demand][sources]"){
+    GIVEN("a range that honors demand"){
+        rx::demand pull(3);
+        std::vector<int> result;
+
+        rxs::range<int>(1, 6, 2, rx::identity_current_thread(), pull)
+            .subscribe(
+                [&](int v){
+                    result.push_back(v);
+                });
+
+        WHEN("the rest is requested"){
+            auto first = result;
+            pull.request(1);
+
+            THEN("last was sent only when requested"){
+                REQUIRE(first == rxu::to_vector({1, 3, 5}));
+                REQUIRE(result == rxu::to_vector({1, 3, 5, 6}));
+            }
+        }
+    }
+}
+
+SCENARIO("range requests from its consumer", "[range][demand][sources]"){
+    GIVEN("a consumer that requests one value at a time"){
+        rx::demand pull(1);
+        std::vector<int> result;
+
+        WHEN("subscribed"){
+            rxs::range<int>(1, 100, 1, rx::identity_current_thread(), pull)
+                .subscribe(
+                    [&](int v){
+                        result.push_back(v);
+                        if (v < 10) {
+                            pull.request(1);
+                        }
+                    });
+
+            THEN("only the requested values were sent"){
+                REQUIRE(result.size() == 10);
+                REQUIRE(result.back() == 10);
+                REQUIRE(pull.outstanding() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("range sends batches through map, filter, skip and take", "[range][batch][sources]"){
+    GIVEN("an observer that accepts runs of values"){
+        std::vector<int> result;
+        int batches = 0;
+        bool completed = false;
+
+        auto out = rx::make_observer_with_range(
+            rx::make_observer<int>(
+                [&](int v){
+                    result.push_back(v);
+                },
+                [&](){
+                    completed = true;
+                }),
+            [&](const int* first, size_t count){
+                ++batches;
+                result.insert(result.end(), first, first + count);
+            });
+
+        WHEN("a long range is mapped, filtered, skipped and taken"){
+            rxs::range<int>(1, 1000)
+                .map([](int v){return v * 3;})
+                .filter([](int v){return v % 2 == 0;})
+                .skip(5)
+                .take(100)
+                .subscribe(out);
+
+            THEN("the values are the same as one at a time"){
+                std::vector<int> expected;
+                for (int v = 6 * 6; expected.size() < 100; v += 6) {
+                    expected.push_back(v);
+                }
+                REQUIRE(result == expected);
+                REQUIRE(completed);
+            }
+            THEN("the values arrived in a few batches"){
+                REQUIRE(batches > 0);
+                REQUIRE(batches < 100);
+            }
+        }
+        WHEN("a range is scanned"){
+            rxs::range<int>(1, 100)
+                .scan(0, [](int s, int v){return s + v;})
+                .subscribe(out);
+
+            THEN("every partial sum was sent"){
+                REQUIRE(result.size() == 100);
+                REQUIRE(result.front() == 1);
+                REQUIRE(result.back() == 5050);
+                REQUIRE(completed);
+            }
+        }
+        WHEN("a range ends within a batch"){
+            rxs::range<int>(1, 10, 4, rx::identity_current_thread())
+                .subscribe(out);
+
+            THEN("last is sent"){
+                REQUIRE(result == rxu::to_vector({1, 5, 9, 10}));
+                REQUIRE(batches == 1);
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("range on the current thread keeps the order of queued actions", "[range][sources]"){
+    GIVEN("ranges on the current thread"){
+        auto ct = rx::identity_current_thread();
+        std::vector<int> result;
+
+        WHEN("each value starts another range"){
+            rxs::range(1, 3, 1, ct)
+                .flat_map(
+                    [=](int v){return rxs::range(v * 10, v * 10 + 1, 1, ct);},
+                    [](int, int w){return w;})
+                .subscribe([&](int v){result.push_back(v);});
+
+            THEN("each range runs before the next value is sent"){
+                REQUIRE(result == rxu::to_vector({10, 11, 20, 21, 30, 31}));
+            }
+        }
+
+        WHEN("a few values are taken from an endless range"){
+            bool completed = false;
+            rxs::range(1, ct)
+                .take(5)
+                .subscribe(
+                    [&](int v){result.push_back(v);},
+                    [&](){completed = true;});
+
+            THEN("the range stops"){
+                REQUIRE(result == rxu::to_vector({1, 2, 3, 4, 5}));
+                REQUIRE(completed);
+            }
+        }
+    }
+}
+
+SCENARIO("skip and take narrow a range", "[range][skip][take][sources]"){
+    GIVEN("ranges that are sliced"){
+        auto collect = [](rx::observable<int> o){
+            std::vector<int> result;
+            bool completed = false;
+            o.subscribe(
+                [&](int v){result.push_back(v);},
+                [&](){completed = true;});
+            REQUIRE(completed);
+            return result;
+        };
+
+        WHEN("a page is taken from far into a range"){
+            auto page = rxs::range(0, 1000000000).skip(999999990).take(3);
+            THEN("the source is a range with the bounds of the page"){
+                static_assert(std::is_same<decltype(page), rx::observable<int, rxs::detail::range<int, rx::identity_one_worker>>>::value, "skip and take of a range must be a range");
+                REQUIRE(collect(page.as_dynamic()) == rxu::to_vector({999999990, 999999991, 999999992}));
+            }
+        }
+
+        WHEN("a range with a step that does not end on its last value is sliced"){
+            // 0, 3, 6, 9, 10
+            auto r = rxs::range(0, 10, 3, rx::identity_current_thread());
+            THEN("the slices keep the last value"){
+                REQUIRE(collect(r.as_dynamic()) == rxu::to_vector({0, 3, 6, 9, 10}));
+                REQUIRE(collect(r.skip(3).as_dynamic()) == rxu::to_vector({9, 10}));
+                REQUIRE(collect(r.skip(4).as_dynamic()) == rxu::to_vector({10}));
+                REQUIRE(collect(r.skip(1).take(2).as_dynamic()) == rxu::to_vector({3, 6}));
+                REQUIRE(collect(r.take(4).as_dynamic()) == rxu::to_vector({0, 3, 6, 9}));
+            }
+        }
+
+        WHEN("a descending range is sliced"){
+            auto r = rxs::range(5, 1, -1, rx::identity_current_thread());
+            THEN("the slice descends"){
+                REQUIRE(collect(r.skip(1).take(2).as_dynamic()) == rxu::to_vector({4, 3}));
+            }
+        }
+
+        WHEN("the slice is past the end or empty"){
+            auto r = rxs::range(1, 3);
+            THEN("the range only completes"){
+                REQUIRE(collect(r.skip(3).as_dynamic()).empty());
+                REQUIRE(collect(r.take(0).as_dynamic()).empty());
+                REQUIRE(collect(r.skip(5).take(2).as_dynamic()).empty());
+            }
+        }
+
+        WHEN("the operators are applied with the pipe"){
+            auto page = rxs::range(1, 100) | rxo::skip(10) | rxo::take(2);
+            THEN("the range is sliced as well"){
+                REQUIRE(collect(page.as_dynamic()) == rxu::to_vector({11, 12}));
+            }
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-remote.hpp"
+
+#include <arpa/inet.h>
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+// a connected pair of stream sockets, closed at the end of the scope
+struct socket_pair
+{
+    socket_pair() {
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    }
+    ~socket_pair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+    int sender() const {return fds[0];}
+    int receiver() const {return fds[1];}
+    int fds[2];
+};
+
+struct string_serializer
+{
+    size_t write(const std::string& v, char* out, size_t capacity) const {
+        if (v.size() <= capacity) {
+            std::memcpy(out, v.data(), v.size());
+        }
+        return v.size();
+    }
+    std::string read(const char* in, size_t length) const {
+        return std::string(in, length);
+    }
+};
+}
+
+SCENARIO("remote sends an observable over a socket", "[remote][sources]"){
+    GIVEN("a connected socket pair"){
+        socket_pair sockets;
+
+        WHEN("a range of 10000 ints is sent"){
+            // more than the socket buffers hold, so the sender blocks until
+            // the receiver reads
+            std::thread sending([&](){
+                rx::remote::send(rx::observable<>::range(1, 10000), sockets.sender());
+            });
+
+            std::vector<int> values;
+            rx::remote::receive<int>(sockets.receiver())
+                .as_blocking()
+                .subscribe([&](int v){values.push_back(v);});
+            sending.join();
+
+            THEN("every int arrives in order"){
+                std::vector<int> expected;
+                for (int i = 1; i <= 10000; ++i) {
+                    expected.push_back(i);
+                }
+                REQUIRE(values == expected);
+            }
+        }
+        WHEN("strings longer than the first guess and an error are sent"){
+            auto long_one = std::string(1000, 'x');
+            auto strings = rx::observable<>::from(std::string("short"), long_one)
+                .concat(rx::observable<>::error<std::string>(std::runtime_error("failed")));
+            rx::remote::send(strings, sockets.sender(), string_serializer());
+
+            std::vector<std::string> values;
+            std::string error;
+            rx::remote::receive<std::string>(sockets.receiver(), string_serializer(), rx::demand::unbounded())
+                .as_blocking()
+                .subscribe(
+                    [&](std::string v){values.push_back(v);},
+                    [&](std::exception_ptr e){
+                        try {
+                            std::rethrow_exception(e);
+                        } catch(const rx::remote::remote_error& ex) {
+                            error = ex.what();
+                        }
+                    });
+
+            THEN("the strings and then the message arrive"){
+                std::vector<std::string> expected;
+                expected.push_back("short");
+                expected.push_back(long_one);
+                REQUIRE(values == expected);
+                REQUIRE(error == "failed");
+            }
+        }
+    }
+}
+
+SCENARIO("remote reads the socket only while there is demand", "[remote][demand][sources]"){
+    GIVEN("a connected socket pair and a demand for 10 values"){
+        socket_pair sockets;
+        rx::demand d(10);
+
+        WHEN("100 values are sent"){
+            rx::remote::send(rx::observable<>::range(1, 100), sockets.sender());
+
+            std::mutex lock;
+            std::condition_variable wake;
+            std::vector<int> values;
+            bool done = false;
+            auto wait_for = [&](size_t count){
+                std::unique_lock<std::mutex> guard(lock);
+                return wake.wait_for(guard, std::chrono::seconds(5), [&](){return values.size() >= count;});
+            };
+            rx::remote::receive<int>(sockets.receiver(), rx::subjects::ipc_copy<int>(), d)
+                .subscribe(
+                    [&](int v){
+                        std::unique_lock<std::mutex> guard(lock);
+                        values.push_back(v);
+                        wake.notify_all();
+                    },
+                    [&](){
+                        std::unique_lock<std::mutex> guard(lock);
+                        done = true;
+                        wake.notify_all();
+                    });
+
+            THEN("10 arrive, and the rest after they are requested"){
+                REQUIRE(wait_for(10));
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    REQUIRE(values.size() == 10);
+                }
+                d.request(90);
+                REQUIRE(wait_for(100));
+                std::unique_lock<std::mutex> guard(lock);
+                REQUIRE(values.back() == 100);
+                REQUIRE(wake.wait_for(guard, std::chrono::seconds(5), [&](){return done;}));
+            }
+        }
+    }
+}
+
+SCENARIO("remote serves an observable on a tcp port", "[remote][sources]"){
+    GIVEN("a range served on a port of the loopback interface"){
+        int listening = rx::remote::listen(0, "127.0.0.1");
+        sockaddr_in bound = {};
+        socklen_t length = sizeof(bound);
+        REQUIRE(::getsockname(listening, reinterpret_cast<sockaddr*>(&bound), &length) == 0);
+        auto port = ntohs(bound.sin_port);
+        auto serving = rx::remote::serve(rx::observable<>::range(1, 5), listening);
+
+        WHEN("two clients connect"){
+            std::vector<int> first, second;
+            for (auto values : {&first, &second}) {
+                int client = rx::remote::connect("127.0.0.1", port);
+                rx::remote::receive<int>(client)
+                    .as_blocking()
+                    .subscribe([=](int v){values->push_back(v);});
+                ::close(client);
+            }
+
+            THEN("each receives the whole range"){
+                auto expected = rxu::to_vector({1, 2, 3, 4, 5});
+                REQUIRE(first == expected);
+                REQUIRE(second == expected);
+            }
+        }
+        serving.unsubscribe();
+        ::close(listening);
+    }
+}
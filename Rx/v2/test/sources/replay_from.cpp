@@ -0,0 +1,169 @@
+#include "rxcpp/rx.hpp"
+#include "rxcpp/rx-record.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxo=rxcpp::operators;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+struct string_serializer
+{
+    size_t write(const std::string& v, char* out, size_t capacity) const {
+        if (v.size() <= capacity) {
+            std::memcpy(out, v.data(), v.size());
+        }
+        return v.size();
+    }
+    std::string read(const char* in, size_t length) const {
+        return std::string(in, length);
+    }
+};
+}
+
+SCENARIO("replay_from sends what record_to wrote", "[record_to][replay_from][sources]"){
+    GIVEN("a range of 1000 ints recorded to a file"){
+        const char* path = "rxcpp_record_ints.bin";
+        std::vector<int> passed;
+        bool completed = false;
+        rx::observable<>::range(1, 1000)
+            | rxo::record_to(path)
+            | rxo::subscribe<int>(
+                [&](int v){passed.push_back(v);},
+                [&](){completed = true;});
+
+        std::vector<int> expected;
+        for (int i = 1; i <= 1000; ++i) {
+            expected.push_back(i);
+        }
+
+        WHEN("the file is replayed as fast as possible"){
+            std::vector<int> replayed;
+            bool replay_completed = false;
+            rxs::replay_from<int>(path)
+                .subscribe(
+                    [&](int v){replayed.push_back(v);},
+                    [&](){replay_completed = true;});
+
+            THEN("record_to passed every int on"){
+                REQUIRE(completed);
+                REQUIRE(passed == expected);
+            }
+            THEN("every int and the completion are replayed"){
+                REQUIRE(replay_completed);
+                REQUIRE(replayed == expected);
+            }
+        }
+        WHEN("only the first 10 are taken from the replay"){
+            std::vector<int> replayed;
+            rxs::replay_from<int>(path)
+                .take(10)
+                .subscribe([&](int v){replayed.push_back(v);});
+
+            THEN("the replay stops after 10"){
+                REQUIRE(replayed == std::vector<int>(expected.begin(), expected.begin() + 10));
+            }
+        }
+        std::remove(path);
+    }
+}
+
+SCENARIO("replay_from sends a recorded error", "[record_to][replay_from][sources]"){
+    GIVEN("strings and an error recorded to a file"){
+        const char* path = "rxcpp_record_strings.bin";
+        auto long_one = std::string(1000, 'x');
+        rx::observable<>::from(std::string("short"), long_one)
+            .concat(rx::observable<>::error<std::string>(std::runtime_error("failed")))
+            | rxo::record_to(path, string_serializer())
+            | rxo::subscribe<std::string>([](std::string){}, [](std::exception_ptr){});
+
+        WHEN("the file is replayed"){
+            std::vector<std::string> values;
+            std::string error;
+            rxs::replay_from<std::string>(path, rxs::replay_time::fast, string_serializer())
+                .subscribe(
+                    [&](std::string v){values.push_back(v);},
+                    [&](std::exception_ptr e){
+                        try {
+                            std::rethrow_exception(e);
+                        } catch(const rx::notifications::recorded_error& ex) {
+                            error = ex.what();
+                        }
+                    });
+
+            THEN("the strings and then the message arrive"){
+                std::vector<std::string> expected;
+                expected.push_back("short");
+                expected.push_back(long_one);
+                REQUIRE(values == expected);
+                REQUIRE(error == "failed");
+            }
+        }
+        std::remove(path);
+    }
+}
+
+SCENARIO("replay_from keeps the original spacing", "[record_to][replay_from][sources]"){
+    GIVEN("3 ints recorded 20ms apart"){
+        const char* path = "rxcpp_record_timed.bin";
+        auto period = std::chrono::milliseconds(20);
+        (rx::observable<>::interval(rxsc::scheduler::clock_type::now() + period, period, rx::synchronize_new_thread())
+            .take(3)
+            | rxo::record_to(path))
+            .as_blocking()
+            .subscribe([](long){});
+
+        WHEN("the file is replayed with the original timing"){
+            auto start = rxsc::scheduler::clock_type::now();
+            std::vector<long> values;
+            rxs::replay_from<long>(path, rxs::replay_time::original)
+                .subscribe([&](long v){values.push_back(v);});
+            auto elapsed = rxsc::scheduler::clock_type::now() - start;
+
+            THEN("the replay takes at least as long as the recording"){
+                REQUIRE(values == rxu::to_vector({1L, 2L, 3L}));
+                REQUIRE(elapsed >= std::chrono::milliseconds(40));
+            }
+        }
+        WHEN("the file is replayed as fast as possible"){
+            auto start = rxsc::scheduler::clock_type::now();
+            std::vector<long> values;
+            rxs::replay_from<long>(path)
+                .subscribe([&](long v){values.push_back(v);});
+            auto elapsed = rxsc::scheduler::clock_type::now() - start;
+
+            THEN("the spacing is not kept"){
+                REQUIRE(values == rxu::to_vector({1L, 2L, 3L}));
+                REQUIRE(elapsed < std::chrono::milliseconds(40));
+            }
+        }
+        std::remove(path);
+    }
+}
+
+SCENARIO("replay_from refuses a file that was not recorded", "[replay_from][sources]"){
+    GIVEN("a text file"){
+        const char* path = "rxcpp_record_text.bin";
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "not a record";
+        }
+
+        WHEN("it is replayed"){
+            bool failed = false;
+            rxs::replay_from<int>(path)
+                .subscribe([](int){}, [&](std::exception_ptr){failed = true;});
+
+            THEN("the replay ends with an error"){
+                REQUIRE(failed);
+            }
+        }
+        std::remove(path);
+    }
+}
@@ -428,3 +428,83 @@ SCENARIO("scope, throw resource usage", "[scope][sources]"){
         }
     }
 }
+
+SCENARIO("scope_pooled, leases from a pool", "[scope][sources]"){
+    GIVEN("a pool of one resource"){
+        int created = 0;
+        rx::sources::resource_pool<std::shared_ptr<int>> pool(1, [&](){
+            return std::make_shared<int>(++created);
+        });
+
+        rxcpp::subjects::subject<int> first, second, third;
+        auto leased = [](rxcpp::subjects::subject<int> sub){
+            return [sub](std::shared_ptr<int> r){
+                return sub.get_observable().map([r](int v){return v + *r * 100;});
+            };
+        };
+
+        std::vector<int> values;
+        auto record = [&](int v){values.push_back(v);};
+
+        WHEN("two subscriptions lease one after the other"){
+            auto a = rx::observable<>::scope_pooled(pool, leased(first)).subscribe(record);
+            auto b = rx::observable<>::scope_pooled(pool, leased(second)).subscribe(record);
+
+            THEN("the second waits for the resource of the first"){
+                REQUIRE(created == 1);
+                REQUIRE(pool.waiting_count() == 1);
+
+                second.get_subscriber().on_next(1);
+                first.get_subscriber().on_next(2);
+                first.get_subscriber().on_completed();
+
+                REQUIRE(pool.waiting_count() == 0);
+                second.get_subscriber().on_next(3);
+                REQUIRE(values == rxu::to_vector({102, 103}));
+                REQUIRE(created == 1);
+            }
+            THEN("the resource is kept in the pool after the last subscription"){
+                a.unsubscribe();
+                b.unsubscribe();
+                REQUIRE(pool.idle_count() == 1);
+                REQUIRE(created == 1);
+            }
+        }
+
+        WHEN("a waiting subscription is unsubscribed"){
+            auto a = rx::observable<>::scope_pooled(pool, leased(first)).subscribe(record);
+            auto b = rx::observable<>::scope_pooled(pool, leased(second)).subscribe(record);
+            auto c = rx::observable<>::scope_pooled(pool, leased(third)).subscribe(record);
+            b.unsubscribe();
+
+            THEN("the resource goes to the one after it"){
+                REQUIRE(pool.waiting_count() == 1);
+                a.unsubscribe();
+                second.get_subscriber().on_next(2);
+                third.get_subscriber().on_next(3);
+                REQUIRE(values == rxu::to_vector({103}));
+                c.unsubscribe();
+                REQUIRE(pool.idle_count() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("scope_pooled, resource factory throws", "[scope][sources]"){
+    GIVEN("a pool whose factory throws"){
+        rx::sources::resource_pool<int> pool(2, []() -> int {
+            throw std::runtime_error("unavailable");
+        });
+
+        WHEN("it is subscribed"){
+            bool failed = false;
+            rx::observable<>::scope_pooled(pool, [](int v){return rx::observable<>::just(v);})
+                .subscribe([](int){}, [&](std::exception_ptr){failed = true;});
+
+            THEN("the error is sent and nothing was created"){
+                REQUIRE(failed);
+                REQUIRE(pool.created_count() == 0);
+            }
+        }
+    }
+}
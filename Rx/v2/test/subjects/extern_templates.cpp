@@ -0,0 +1,37 @@
+// the common types are declared extern here and come from rxcpp_core
+#define RXCPP_EXTERN_TEMPLATES
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsub=rxcpp::subjects;
+
+#include "catch.hpp"
+
+SCENARIO("the extern subject and observable types are usable", "[extern][subjects]"){
+    GIVEN("a subject of std::string"){
+        rxsub::subject<std::string> sub;
+        WHEN("the values pass through dynamic observables"){
+            std::vector<std::string> values;
+            rx::observable<std::string> strings = sub.get_observable();
+            rx::observable<int> sizes = strings.map([](const std::string& s){return int(s.size());}).as_dynamic();
+            sizes.subscribe([&](int v){values.push_back(std::to_string(v));});
+            strings.subscribe([&](const std::string& s){values.push_back(s);});
+            rx::subscriber<std::string> o = sub.get_subscriber();
+            o.on_next("ab");
+            o.on_next("cde");
+            o.on_completed();
+            THEN("each observer saw each value"){
+                REQUIRE(values == rxu::to_vector<std::string>({"2", "ab", "3", "cde"}));
+            }
+        }
+    }
+    GIVEN("a behavior of long"){
+        rxsub::behavior<long> b(1);
+        WHEN("a value is sent"){
+            b.get_subscriber().on_next(2);
+            THEN("the latest value is kept"){
+                REQUIRE(b.get_value() == 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsub=rxcpp::subjects;
+
+#include "catch.hpp"
+
+SCENARIO("graph recomputes only what changed", "[graph][subjects]"){
+    GIVEN("a diamond of vertices"){
+        rxsub::graph g;
+        auto a = g.source(1);
+        int doubled_runs = 0, sum_runs = 0, parity_runs = 0;
+        auto doubled = g.derive([&](int x){++doubled_runs; return x * 2;}, a);
+        auto tripled = g.derive([](int x){return x * 3;}, a);
+        auto sum = g.derive([&](int x, int y){++sum_runs; return x + y;}, doubled, tripled);
+        auto parity = g.derive([&](int x){++parity_runs; return x % 2;}, a);
+
+        std::vector<int> sums;
+        sum.get_observable().subscribe([&](int v){sums.push_back(v);});
+        // a second subscriber shares the vertex
+        std::vector<int> shared;
+        sum.get_observable().subscribe([&](int v){shared.push_back(v);});
+
+        WHEN("the source is set"){
+            a.set(2);
+
+            THEN("each observer sees the first value and one glitch free change"){
+                REQUIRE(sums == rxu::to_vector({5, 10}));
+                REQUIRE(shared == sums);
+                REQUIRE(sum.get_value() == 10);
+            }
+            THEN("each vertex was recomputed once"){
+                REQUIRE(doubled_runs == 2);
+                REQUIRE(sum_runs == 2);
+            }
+        }
+        WHEN("the source is set to a value that changes only one branch"){
+            std::vector<int> parities;
+            parity.get_observable().subscribe([&](int v){parities.push_back(v);});
+            a.set(3);
+            THEN("the vertex whose value did not change emits nothing"){
+                REQUIRE(parities == rxu::to_vector({1}));
+                REQUIRE(parity_runs == 2);
+            }
+        }
+        WHEN("the source is set to its value"){
+            a.set(1);
+            THEN("nothing is recomputed"){
+                REQUIRE(doubled_runs == 1);
+                REQUIRE(sums == rxu::to_vector({5}));
+            }
+        }
+    }
+}
+
+SCENARIO("graph batches sets", "[graph][subjects]"){
+    GIVEN("a vertex of two sources"){
+        rxsub::graph g;
+        auto a = g.source(1);
+        auto b = g.source(10);
+        auto sum = g.derive([](int x, int y){return x + y;}, a, b);
+        std::vector<int> sums;
+        sum.get_observable().subscribe([&](int v){sums.push_back(v);});
+
+        WHEN("both are set in a batch"){
+            g.batch([&](){
+                a.set(2);
+                b.set(20);
+            });
+            THEN("the sum changes once"){
+                REQUIRE(sums == rxu::to_vector({11, 22}));
+            }
+        }
+        WHEN("an observer sets a source"){
+            sum.get_observable().subscribe([&](int v){
+                if (v == 12) {
+                    b.set(0);
+                }
+            });
+            a.set(2);
+            THEN("the set runs after the change is sent"){
+                REQUIRE(sums == rxu::to_vector({11, 12, 2}));
+            }
+        }
+    }
+}
+
+SCENARIO("graph sends an exception as an error", "[graph][subjects]"){
+    GIVEN("a vertex that throws"){
+        rxsub::graph g;
+        auto a = g.source(1);
+        auto checked = g.derive([](int x){ if (x < 0) throw std::runtime_error("negative"); return x; }, a);
+        bool failed = false;
+        checked.get_observable().subscribe([](int){}, [&](std::exception_ptr){failed = true;});
+        a.set(-1);
+        THEN("the error is sent"){
+            REQUIRE(failed);
+        }
+    }
+}
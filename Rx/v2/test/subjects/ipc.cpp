@@ -0,0 +1,192 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+namespace rxsub=rxcpp::subjects;
+
+#include "rxcpp/subjects/rx-ipc.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+namespace {
+std::string ipc_name(const char* what) {
+    return std::string("/rxcpp-test-") + what + "-" + std::to_string(::getpid());
+}
+
+struct point
+{
+    int x;
+    double y;
+};
+
+// writes the length of the string and then its characters
+struct string_serializer
+{
+    size_t write(const std::string& v, char* out, size_t capacity) const {
+        if (v.size() <= capacity) {
+            std::memcpy(out, v.data(), v.size());
+        }
+        return v.size();
+    }
+    std::string read(const char* in, size_t length) const {
+        return std::string(in, length);
+    }
+};
+}
+
+SCENARIO("ipc_subject sends values through shared memory", "[ipc][subjects]"){
+    GIVEN("an ipc_subject with room for 8 points, created and opened"){
+        auto name = ipc_name("points");
+        auto sender = rxsub::ipc_subject<point>::create(name, 8);
+        auto receiver = rxsub::ipc_subject<point>::open(name);
+
+        WHEN("1000 points are sent from another thread"){
+            std::thread sending([&](){
+                auto out = sender.get_subscriber();
+                for (int i = 0; i != 1000; ++i) {
+                    point p = {i, i / 2.0};
+                    out.on_next(p);
+                }
+                out.on_completed();
+            });
+
+            std::vector<point> all;
+            receiver.get_observable()
+                .as_blocking()
+                .subscribe([&](point p){all.push_back(p);});
+            sending.join();
+
+            THEN("each point arrives in order"){
+                REQUIRE(all.size() == 1000);
+                bool ordered = true;
+                for (int i = 0; i != 1000; ++i) {
+                    ordered = ordered && all[i].x == i && all[i].y == i / 2.0;
+                }
+                REQUIRE(ordered);
+            }
+        }
+    }
+}
+
+SCENARIO("ipc_subject sends the error as an ipc_error", "[ipc][subjects]"){
+    GIVEN("an ipc_subject of strings"){
+        auto name = ipc_name("strings");
+        auto sender = rxsub::ipc_subject<std::string, string_serializer>::create(name, 4, 16);
+        auto receiver = rxsub::ipc_subject<std::string, string_serializer>::open(name);
+
+        WHEN("two strings and an error are sent"){
+            auto out = sender.get_subscriber();
+            out.on_next(std::string("hello"));
+            out.on_next(std::string("world"));
+            out.on_error(std::make_exception_ptr(std::runtime_error("failed")));
+
+            std::vector<std::string> values;
+            std::string error;
+            receiver.get_observable()
+                .as_blocking()
+                .subscribe(
+                    [&](std::string v){values.push_back(v);},
+                    [&](std::exception_ptr e){
+                        try {
+                            std::rethrow_exception(e);
+                        } catch(const rxsub::ipc_error& ex) {
+                            error = ex.what();
+                        }
+                    });
+
+            THEN("the strings and then the message arrive"){
+                std::vector<std::string> expected;
+                expected.push_back("hello");
+                expected.push_back("world");
+                REQUIRE(values == expected);
+                REQUIRE(error == "failed");
+            }
+        }
+        WHEN("a string longer than a slot is sent"){
+            auto out = sender.get_subscriber();
+            out.on_next(std::string("this does not fit in 16 bytes"));
+
+            std::string error;
+            receiver.get_observable()
+                .as_blocking()
+                .subscribe(
+                    [](std::string){},
+                    [&](std::exception_ptr e){
+                        try {
+                            std::rethrow_exception(e);
+                        } catch(const rxsub::ipc_error& ex) {
+                            error = ex.what();
+                        }
+                    });
+
+            THEN("the stream ends with an error"){
+                REQUIRE(error == "ipc_subject: the value does not fit in a slot");
+            }
+        }
+        WHEN("it is subscribed twice"){
+            auto first = receiver.get_observable().subscribe([](std::string){});
+            bool refused = false;
+            receiver.get_observable().subscribe(
+                [](std::string){},
+                [&](std::exception_ptr){refused = true;});
+            first.unsubscribe();
+
+            THEN("the second subscriber is refused"){
+                REQUIRE(refused);
+            }
+        }
+    }
+}
+
+SCENARIO("ipc_subject sender waiting for room", "[ipc][subjects]"){
+    GIVEN("an ipc_subject with room for 2 ints"){
+        auto name = ipc_name("room");
+        auto sender = rxsub::ipc_subject<int>::create(name, 2);
+        auto receiver = rxsub::ipc_subject<int>::open(name);
+
+        WHEN("the receiver unsubscribes while the sender waits for room"){
+            auto out = sender.get_subscriber();
+            int sent = 0;
+            std::thread sending([&](){
+                for (int i = 0; i != 10 && out.is_subscribed(); ++i) {
+                    out.on_next(i);
+                    ++sent;
+                }
+            });
+
+            std::vector<int> received;
+            receiver.get_observable()
+                .take(1)
+                .as_blocking()
+                .subscribe([&](int v){received.push_back(v);});
+            sending.join();
+
+            THEN("the sender is ended instead of waiting forever"){
+                REQUIRE(received == rxu::to_vector({0}));
+                REQUIRE(!out.is_subscribed());
+                REQUIRE(sent < 10);
+            }
+        }
+
+        WHEN("the sender is unsubscribed while it waits for room"){
+            auto out = sender.get_subscriber();
+            std::atomic<bool> returned(false);
+            std::thread sending([&](){
+                for (int i = 0; i != 3; ++i) {
+                    out.on_next(i);
+                }
+                returned = true;
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            auto waited = !returned;
+            out.unsubscribe();
+            sending.join();
+
+            THEN("the wait ends"){
+                REQUIRE(waited);
+                REQUIRE(returned);
+            }
+        }
+    }
+}
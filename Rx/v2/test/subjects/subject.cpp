@@ -706,3 +706,449 @@ SCENARIO("subject - on_error in source", "[subject][subjects]"){
         }
     }
 }
+
+SCENARIO("subject - many subscribers with churn", "[subject][subjects]"){
+    GIVEN("a subject with more subscribers than fit in one chunk"){
+        rxsub::subject<int> s;
+        auto o = s.get_subscriber();
+
+        const int count = 300;
+        std::vector<int> received(count, 0);
+        std::vector<rx::composite_subscription> lifetimes;
+        for (int i = 0; i < count; ++i) {
+            lifetimes.push_back(rx::composite_subscription());
+            s.get_observable().subscribe(rx::make_subscriber<int>(lifetimes.back(), [&received, i](int){
+                ++received[i];}));
+        }
+
+        WHEN("every other subscriber unsubscribes and more subscribe"){
+            o.on_next(1);
+            for (int i = 0; i < count; i += 2) {
+                lifetimes[i].unsubscribe();
+            }
+            o.on_next(2);
+            int late = 0;
+            for (int i = 0; i < count; ++i) {
+                s.get_observable().subscribe([&late](int){
+                    ++late;});
+            }
+            o.on_next(3);
+            THEN("each subscriber receives only the values sent while subscribed"){
+                for (int i = 0; i < count; ++i) {
+                    REQUIRE(received[i] == (i % 2 == 0 ? 1 : 3));
+                }
+                REQUIRE(late == count);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_subject - delivers in order to every lane", "[subject][subjects][parallel_subject]"){
+    GIVEN("a parallel subject with four lanes and ten subscribers"){
+        auto s = rxsub::make_parallel_subject<int>(rx::observe_on_new_thread(), 4);
+        auto o = s.get_subscriber();
+
+        const int count = 10;
+        std::vector<std::vector<int>> received(count);
+        std::vector<int> completed(count, 0);
+        std::vector<std::thread::id> threads(count);
+        for (int i = 0; i < count; ++i) {
+            s.get_observable().subscribe(
+                [&received, &threads, i](int v){
+                    threads[i] = std::this_thread::get_id();
+                    received[i].push_back(v);},
+                [&completed, i](){
+                    ++completed[i];});
+        }
+
+        WHEN("values are published and the caller waits"){
+            for (int v = 0; v < 100; ++v) {
+                o.on_next(v);
+            }
+            o.on_completed();
+            s.wait();
+
+            THEN("every subscriber receives every value in order"){
+                std::vector<int> required;
+                for (int v = 0; v < 100; ++v) {
+                    required.push_back(v);
+                }
+                for (int i = 0; i < count; ++i) {
+                    REQUIRE(received[i] == required);
+                    REQUIRE(completed[i] == 1);
+                }
+            }
+            THEN("subscribers in different lanes are called on different threads"){
+                REQUIRE(s.lane_count() == 4);
+                REQUIRE(threads[0] != threads[1]);
+                REQUIRE(threads[0] == threads[4]);
+            }
+        }
+    }
+}
+
+SCENARIO("replay - count and time bounds", "[replay][subjects]"){
+    GIVEN("a source and replay subjects bounded by count and by time"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(290, 4),
+            on.next(410, 5),
+            on.completed(500)
+        });
+
+        auto so = rx::identity_one_worker(sc);
+        rxsub::replay<int, decltype(so)> by_count(2, so);
+        rxsub::replay<int, decltype(so)> by_time(std::chrono::milliseconds(75), so);
+
+        auto counted = w.make_subscriber<int>();
+        auto timed = w.make_subscriber<int>();
+        auto late = w.make_subscriber<int>();
+
+        WHEN("subscribers join after values were sent"){
+
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){
+                xs.subscribe(by_count.get_subscriber());
+                xs.subscribe(by_time.get_subscriber());});
+            w.schedule_absolute(300, [&](const rxsc::schedulable&){
+                by_count.get_observable().subscribe(counted);
+                by_time.get_observable().subscribe(timed);});
+            w.schedule_absolute(600, [&](const rxsc::schedulable&){
+                by_count.get_observable().subscribe(late);});
+
+            w.start();
+
+            THEN("the count bound subscriber gets the last two values and then the live values"){
+                auto required = rxu::to_vector({
+                    on.next(300, 3),
+                    on.next(300, 4),
+                    on.next(410, 5),
+                    on.completed(500)
+                });
+                auto actual = counted.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the time bound subscriber gets the values sent in the last 75 ticks"){
+                auto required = rxu::to_vector({
+                    on.next(300, 3),
+                    on.next(300, 4),
+                    on.next(410, 5),
+                    on.completed(500)
+                });
+                auto actual = timed.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("a subscriber after completion gets the values and the completion"){
+                auto required = rxu::to_vector({
+                    on.next(600, 4),
+                    on.next(600, 5),
+                    on.completed(600)
+                });
+                auto actual = late.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast - one subscriber", "[unicast][subjects]"){
+    GIVEN("a source and a unicast subject"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(320, 2),
+            on.next(330, 3),
+            on.completed(500)
+        });
+
+        rxsub::unicast<int> u;
+
+        auto first = w.make_subscriber<int>();
+        auto late = w.make_subscriber<int>();
+        bool rejected = false;
+
+        WHEN("the subscriber joins after a value was sent"){
+
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){
+                xs.subscribe(u.get_subscriber());});
+            w.schedule_absolute(300, [&](const rxsc::schedulable&){
+                u.get_observable().subscribe(first);});
+            w.schedule_absolute(400, [&](const rxsc::schedulable&){
+                u.get_observable().subscribe(
+                    [](int){},
+                    [&](std::exception_ptr e){
+                        try {
+                            std::rethrow_exception(e);
+                        } catch (const rxsub::unicast_subscribed_error&) {
+                            rejected = true;
+                        }
+                    });});
+            w.schedule_absolute(600, [&](const rxsc::schedulable&){
+                rxsub::unicast<int> ended;
+                ended.on_completed();
+                ended.get_observable().subscribe(late);});
+
+            w.start();
+
+            THEN("the subscriber gets the values sent after it joined"){
+                auto required = rxu::to_vector({
+                    on.next(320, 2),
+                    on.next(330, 3),
+                    on.completed(500)
+                });
+                auto actual = first.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("a second subscriber is sent an error"){
+                REQUIRE(rejected);
+            }
+
+            THEN("a subscriber after completion gets the completion"){
+                auto required = rxu::to_vector({
+                    on.completed(600)
+                });
+                auto actual = late.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("behavior - values read while written", "[behavior][subjects]"){
+    GIVEN("behavior subjects holding a scalar and a string"){
+        rxsub::behavior<long> number(0);
+        rxsub::behavior<std::string> text(std::string(64, 'a'));
+        WHEN("one thread writes while others read"){
+            std::atomic<bool> done(false);
+            std::atomic<int> torn(0);
+            std::vector<std::thread> readers;
+            for (int r = 0; r < 3; ++r) {
+                readers.emplace_back([&](){
+                    long last = 0;
+                    while (!done) {
+                        auto n = number.get_value();
+                        auto t = text.get_value();
+                        if (n < last || t.size() != 64 || t != std::string(64, t[0])) {
+                            ++torn;
+                        }
+                        last = n;
+                    }
+                });
+            }
+            auto outn = number.get_subscriber();
+            auto outt = text.get_subscriber();
+            for (long i = 1; i <= 10000; ++i) {
+                outn.on_next(i);
+                outt.on_next(std::string(64, static_cast<char>('a' + i % 26)));
+            }
+            done = true;
+            for (auto& t : readers) {
+                t.join();
+            }
+            THEN("every read sees a whole value and scalar values never go back"){
+                REQUIRE(torn == 0);
+                REQUIRE(number.get_value() == 10000);
+                REQUIRE(text.get_value() == std::string(64, static_cast<char>('a' + 10000 % 26)));
+            }
+        }
+    }
+}
+
+SCENARIO("combining_synchronize - serializes concurrent callers", "[synchronize][subjects]"){
+    GIVEN("a combining synchronize subject with one subscriber"){
+        rxsub::combining_synchronize<int> s;
+        std::atomic<int> inside(0);
+        std::atomic<int> overlapped(0);
+        std::vector<int> received;
+        int completed = 0;
+        s.get_observable().subscribe(
+            [&](int v){
+                if (++inside != 1) {
+                    ++overlapped;
+                }
+                received.push_back(v);
+                --inside;},
+            [&](){
+                ++completed;});
+
+        WHEN("four threads call on_next at the same time"){
+            auto o = s.get_subscriber();
+            const int count = 10000;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&, t](){
+                    for (int i = 0; i < count; ++i) {
+                        o.on_next(t * count + i);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            o.on_completed();
+
+            THEN("calls never overlap and every value arrives once, in order per thread"){
+                REQUIRE(overlapped == 0);
+                REQUIRE(received.size() == 4 * count);
+                REQUIRE(completed == 1);
+                std::vector<int> last(4, -1);
+                bool ordered = true;
+                for (auto v : received) {
+                    ordered = ordered && v > last[v / count];
+                    last[v / count] = v;
+                }
+                REQUIRE(ordered);
+            }
+        }
+
+        WHEN("a value is sent without contention"){
+            s.get_subscriber().on_next(1);
+            THEN("it is delivered before on_next returns"){
+                REQUIRE(received == std::vector<int>(1, 1));
+            }
+        }
+    }
+}
+
+
+SCENARIO("combining_synchronize - after an observer throws", "[synchronize][subjects]"){
+    GIVEN("a combining synchronize subject with an observer that throws and one that records"){
+        rxsub::combining_synchronize<int> s;
+        auto o = s.get_subscriber();
+        s.get_observable().subscribe(
+            [&](int v){
+                if (v == 1 || v == 3) {
+                    throw std::runtime_error("on_next failed");
+                }
+                if (v == 2) {
+                    // queued behind this call and made by the drain
+                    o.on_next(3);
+                }
+            },
+            [](std::exception_ptr e){
+                std::rethrow_exception(e);
+            });
+        std::vector<int> received;
+        int errors = 0;
+        s.get_observable().subscribe(
+            [&](int v){
+                received.push_back(v);},
+            [&](std::exception_ptr){
+                ++errors;});
+
+        WHEN("the direct call throws"){
+            o.on_next(1);
+
+            THEN("the error that follows is delivered"){
+                REQUIRE(received.empty());
+                REQUIRE(errors == 1);
+            }
+        }
+        WHEN("a queued call throws"){
+            o.on_next(2);
+
+            THEN("the drain finished and the error that follows is delivered"){
+                REQUIRE((received == std::vector<int>{2}));
+                REQUIRE(errors == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("ring_subject - each subscriber reads at its own pace", "[subject][subjects][ring_subject]"){
+    GIVEN("a ring subject with room for 8 values, a fast and a slow subscriber"){
+        rxsub::ring_subject<int, rx::observe_on_one_worker> s(rx::observe_on_new_thread(), 5);
+        auto o = s.get_subscriber();
+
+        std::vector<int> fast, slow;
+        std::atomic<int> completed(0);
+        std::thread::id fast_thread, slow_thread;
+        s.get_observable().subscribe(
+            [&](int v){
+                fast_thread = std::this_thread::get_id();
+                fast.push_back(v);},
+            [&](){
+                ++completed;});
+        s.get_observable().subscribe(
+            [&](int v){
+                slow_thread = std::this_thread::get_id();
+                if (v % 100 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                slow.push_back(v);},
+            [&](){
+                ++completed;});
+
+        WHEN("more values than the ring holds are sent"){
+            for (int v = 0; v < 1000; ++v) {
+                o.on_next(v);
+            }
+            o.on_completed();
+            while (completed != 2) {
+                std::this_thread::yield();
+            }
+
+            THEN("the ring is rounded up to a power of two"){
+                REQUIRE(s.capacity() == 8);
+            }
+            THEN("both subscribers receive every value in order"){
+                std::vector<int> required;
+                for (int v = 0; v < 1000; ++v) {
+                    required.push_back(v);
+                }
+                REQUIRE(fast == required);
+                REQUIRE(slow == required);
+            }
+            THEN("each subscriber reads on its own thread"){
+                REQUIRE(fast_thread != slow_thread);
+                REQUIRE(fast_thread != std::this_thread::get_id());
+            }
+            THEN("a subscriber after completion gets the completion"){
+                bool late = false;
+                s.get_observable().subscribe([](int){}, [&](){late = true;});
+                REQUIRE(late);
+            }
+        }
+    }
+}
+
+SCENARIO("ring_subject - sends the error after the values", "[subject][subjects][ring_subject]"){
+    GIVEN("a ring subject with one subscriber"){
+        rxsub::ring_subject<int, rx::observe_on_one_worker> s(rx::observe_on_new_thread(), 4);
+        auto o = s.get_subscriber();
+
+        std::vector<int> received;
+        std::atomic<bool> failed(false);
+        s.get_observable().subscribe(
+            [&](int v){
+                received.push_back(v);},
+            [&](std::exception_ptr){
+                failed = true;});
+
+        WHEN("values and then an error are sent"){
+            for (int v = 0; v < 10; ++v) {
+                o.on_next(v);
+            }
+            o.on_error(std::make_exception_ptr(std::runtime_error("ring")));
+            while (!failed) {
+                std::this_thread::yield();
+            }
+
+            THEN("the subscriber receives the values and then the error"){
+                REQUIRE(received.size() == 10);
+                REQUIRE(received.back() == 9);
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxs=rxcpp::sources;
+namespace rxsc=rxcpp::schedulers;
+
+#include "catch.hpp"
+
+SCENARIO("blocking waits for values sent from another thread", "[blocking][subscriptions]"){
+    GIVEN("a range that is sent from a new thread"){
+        auto xs = rxs::range(1, 100, 1, rx::observe_on_new_thread());
+
+        WHEN("it is waited on"){
+            THEN("each method sees every value"){
+                REQUIRE(100 == xs.as_blocking().last());
+                REQUIRE(100 == xs.as_blocking().count());
+                REQUIRE(5050 == xs.as_blocking().sum());
+            }
+        }
+
+        WHEN("only the first value is waited on"){
+            THEN("the first value is returned"){
+                REQUIRE(1 == rxs::interval(rxsc::scheduler::clock_type::now(), std::chrono::milliseconds(1), rx::observe_on_new_thread()).as_blocking().first());
+            }
+        }
+
+        WHEN("blocking subscribes run one after another"){
+            int total = 0;
+            for (int i = 0; i < 100; ++i) {
+                total += xs.take(1).as_blocking().last();
+            }
+            THEN("every subscribe returns"){
+                REQUIRE(100 == total);
+            }
+        }
+    }
+}
+
+SCENARIO("futures hold the result of an observable", "[future][subscriptions]"){
+    GIVEN("a range that is sent from a new thread"){
+        auto xs = rxs::range(1, 10, 1, rx::observe_on_new_thread());
+
+        WHEN("futures are taken"){
+            auto last = xs.to_future();
+            auto first = xs.first_async();
+            auto also_last = xs.last_async();
+
+            THEN("they hold the first and last values"){
+                REQUIRE(10 == last.get());
+                REQUIRE(1 == first.get());
+                REQUIRE(10 == also_last.get());
+            }
+        }
+    }
+    GIVEN("an observable that fails"){
+        auto xs = rxs::error<int>(std::runtime_error("failed"), rx::observe_on_new_thread());
+
+        WHEN("futures are taken"){
+            THEN("they hold the error"){
+                REQUIRE_THROWS_AS(xs.first_async().get(), std::runtime_error);
+                REQUIRE_THROWS_AS(xs.to_future().get(), std::runtime_error);
+            }
+        }
+    }
+    GIVEN("an observable that sends no values"){
+        auto xs = rx::observable<>::empty<int>();
+
+        WHEN("futures are taken"){
+            THEN("they hold an error"){
+                REQUIRE_THROWS_AS(xs.first_async().get(), std::runtime_error);
+                REQUIRE_THROWS_AS(xs.last_async().get(), std::runtime_error);
+            }
+        }
+    }
+}
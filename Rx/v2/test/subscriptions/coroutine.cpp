@@ -0,0 +1,150 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-coroutine.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+// these tests only run when the test is built for c++20
+#if defined(__cpp_impl_coroutine)
+
+namespace {
+// a coroutine that starts at once and keeps its frame until it is destroyed
+struct task
+{
+    struct promise_type
+    {
+        task get_return_object() {
+            return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_never initial_suspend() {return {};}
+        std::suspend_always final_suspend() noexcept {return {};}
+        void return_void() {}
+        void unhandled_exception() {error = std::current_exception();}
+        std::exception_ptr error;
+    };
+    task(const task&) = delete;
+    task(task&& o) : h(o.h) {o.h = nullptr;}
+    explicit task(std::coroutine_handle<promise_type> c) : h(c) {}
+    ~task() {if (h) {h.destroy();}}
+    bool done() const {return h.done();}
+    std::coroutine_handle<promise_type> h;
+};
+}
+
+SCENARIO("co_await an observable", "[coroutine][subscriptions]"){
+    GIVEN("a range"){
+        auto xs = rx::observable<>::range(1, 5);
+
+        WHEN("the first and last values are awaited"){
+            int first = 0, last = 0;
+            auto t = [&]() -> task {
+                first = co_await xs.first();
+                last = co_await xs.last();
+            }();
+
+            THEN("the coroutine ran to the end with the values"){
+                REQUIRE(t.done());
+                REQUIRE(first == 1);
+                REQUIRE(last == 5);
+            }
+        }
+        WHEN("a value is awaited from another thread"){
+            std::mutex lock;
+            std::condition_variable wake;
+            bool finished = false;
+            std::thread::id resumed;
+            int value = 0;
+            auto t = [&]() -> task {
+                value = co_await xs.subscribe_on(rx::observe_on_new_thread()).last();
+                std::unique_lock<std::mutex> guard(lock);
+                resumed = std::this_thread::get_id();
+                finished = true;
+                wake.notify_one();
+            }();
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&](){return finished;});
+            }
+
+            THEN("the coroutine was resumed on the delivering thread"){
+                REQUIRE(value == 5);
+                REQUIRE(resumed != std::this_thread::get_id());
+            }
+        }
+    }
+    GIVEN("an error and an empty source"){
+        WHEN("they are awaited"){
+            std::vector<std::string> errors;
+            auto t = [&]() -> task {
+                try {
+                    co_await rx::observable<>::error<int>(std::runtime_error("failed"));
+                } catch (const std::exception& e) {
+                    errors.push_back(e.what());
+                }
+                try {
+                    co_await rx::observable<>::empty<int>();
+                } catch (const std::runtime_error&) {
+                    errors.push_back("empty");
+                }
+            }();
+
+            THEN("each was thrown out of the co_await"){
+                REQUIRE(t.done());
+                REQUIRE(errors == rxu::to_vector({std::string("failed"), std::string("empty")}));
+            }
+        }
+    }
+}
+
+SCENARIO("async_generator hands out values one at a time", "[coroutine][subscriptions]"){
+    GIVEN("a subject"){
+        rx::subjects::subject<int> s;
+        auto out = s.get_subscriber();
+
+        WHEN("values are sent while the coroutine waits"){
+            std::vector<int> values;
+            auto t = [&]() -> task {
+                auto g = rx::make_async_generator(s.get_observable());
+                for (auto v = co_await g.next(); !v.empty(); v = co_await g.next()) {
+                    values.push_back(v.get());
+                }
+            }();
+            out.on_next(1);
+            REQUIRE(values == rxu::to_vector({1}));
+            out.on_next(2);
+            out.on_next(3);
+            REQUIRE(!t.done());
+            out.on_completed();
+
+            THEN("the coroutine got each value as it was sent"){
+                REQUIRE(t.done());
+                REQUIRE(values == rxu::to_vector({1, 2, 3}));
+            }
+        }
+    }
+    GIVEN("a range"){
+        WHEN("the coroutine stops early"){
+            std::vector<int> values;
+            auto t = [&]() -> task {
+                auto g = rx::make_async_generator(rx::observable<>::range(1, 1000000));
+                for (auto v = co_await g.next(); !v.empty(); v = co_await g.next()) {
+                    values.push_back(v.get());
+                    if (values.size() == 3) {
+                        break;
+                    }
+                }
+            }();
+
+            THEN("the range only sent the values that were taken"){
+                REQUIRE(t.done());
+                REQUIRE(values == rxu::to_vector({1, 2, 3}));
+            }
+        }
+    }
+}
+
+#endif
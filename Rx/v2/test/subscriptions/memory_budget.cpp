@@ -0,0 +1,106 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxu=rxcpp::util;
+namespace rxsc=rxcpp::schedulers;
+namespace rxo=rxcpp::operators;
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("memory_budget counts the chunks of buffer", "[memory_budget][buffer][subscriptions]"){
+    GIVEN("a budget and a subject"){
+        rx::memory_budget budget("tenant", 0);
+        rx::subjects::subject<int> sub;
+        std::vector<std::vector<int>> chunks;
+
+        auto lifetime = sub.get_observable()
+            .buffer(3, 3, budget)
+            .subscribe([&](std::vector<int> c){chunks.push_back(std::move(c));});
+
+        WHEN("a chunk is open"){
+            sub.get_subscriber().on_next(1);
+            THEN("its capacity is charged"){
+                REQUIRE(budget.items() == 1);
+                REQUIRE(budget.bytes() == 3 * sizeof(int));
+            }
+            THEN("it is refunded when the chunk is emitted"){
+                sub.get_subscriber().on_next(2);
+                sub.get_subscriber().on_next(3);
+                REQUIRE(chunks.size() == 1);
+                REQUIRE(budget.items() == 0);
+                REQUIRE(budget.bytes() == 0);
+                REQUIRE(budget.peak_bytes() == 3 * sizeof(int));
+            }
+            THEN("it is refunded when the subscription ends"){
+                lifetime.unsubscribe();
+                REQUIRE(budget.items() == 0);
+                REQUIRE(budget.bytes() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("memory_budget counts the queue of observe_on", "[memory_budget][observe_on][subscriptions]"){
+    GIVEN("a budget charged by observe_on on a test scheduler"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        auto so = rx::synchronize_in_one_worker(sc);
+        rx::memory_budget budget("tenant", 0);
+        rxo::queue_depth depth(budget);
+        rx::subjects::subject<int> sub;
+        std::vector<int> values;
+
+        sub.get_observable()
+            .observe_on(so, 0, rxo::overflow_policy::block_producer, depth)
+            .subscribe([&](int v){values.push_back(v);});
+
+        WHEN("values are queued"){
+            sub.get_subscriber().on_next(1);
+            sub.get_subscriber().on_next(2);
+            THEN("each queued notification is charged"){
+                REQUIRE(budget.items() == 2);
+                REQUIRE(budget.bytes() >= 2 * sizeof(int));
+                REQUIRE(depth.current() == 2);
+            }
+            THEN("they are refunded as they are delivered"){
+                w.advance_by(1);
+                REQUIRE(values == rxu::to_vector({1, 2}));
+                REQUIRE(budget.items() == 0);
+                REQUIRE(budget.bytes() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("memory_budget sheds when exceeded", "[memory_budget][buffer][subscriptions]"){
+    GIVEN("a budget of two chunks whose callback unsubscribes the root"){
+        rx::memory_budget budget("tenant", 2 * 4 * sizeof(int));
+        rx::composite_subscription root;
+        int exceeded = 0;
+        budget.on_exceeded([&](const rx::memory_budget& b){
+            ++exceeded;
+            REQUIRE(b.name() == "tenant");
+            root.unsubscribe();
+        });
+        rx::subjects::subject<int> sub;
+
+        sub.get_observable()
+            .buffer(4, 1, budget)
+            .subscribe(root, [](std::vector<int>){});
+
+        WHEN("a third overlapping chunk is opened"){
+            sub.get_subscriber().on_next(1);
+            sub.get_subscriber().on_next(2);
+            REQUIRE(exceeded == 0);
+            sub.get_subscriber().on_next(3);
+
+            THEN("the callback sheds the pipeline and its charges are refunded"){
+                REQUIRE(exceeded == 1);
+                REQUIRE(!root.is_subscribed());
+                REQUIRE(budget.bytes() == 0);
+                REQUIRE(!budget.is_exceeded());
+                REQUIRE(budget.peak_bytes() == 3 * 4 * sizeof(int));
+            }
+        }
+    }
+}
@@ -182,3 +182,147 @@ SCENARIO("subscriber behavior", "[observer][traits]"){
         }
     }
 }
+
+SCENARIO("dynamic_observer storage", "[observer]"){
+    GIVEN("dynamic observers erasing a small and a large observer"){
+        int result = 0;
+        std::array<int, 16> padding;
+        padding.fill(1);
+        auto small = rx::dynamic_observer<int>(rx::make_observer<int>(
+            [&result](int i){result += i;}));
+        auto large = rx::dynamic_observer<int>(rx::make_observer<int>(
+            [&result, padding](int i){result += i * padding[15];}));
+        WHEN("values are delivered one at a time and as a range"){
+            const int values[] = {1, 2, 3, 4};
+            small.on_next(1);
+            small.on_next_range(values, 4);
+            large.on_next(100);
+            large.on_next_range(values, 4);
+            THEN("every value reaches the erased observer"){
+                REQUIRE(result == 1 + 10 + 100 + 10);
+            }
+        }
+        WHEN("the dynamic observers are copied and moved"){
+            auto small_copy = small;
+            auto large_copy = large;
+            rx::dynamic_observer<int> moved(std::move(small_copy));
+            rx::dynamic_observer<int> assigned;
+            assigned = large_copy;
+            moved.on_next(1);
+            assigned.on_next(10);
+            small.on_next(100);
+            large.on_next(1000);
+            THEN("each copy calls the same functions"){
+                REQUIRE(result == 1111);
+            }
+        }
+        WHEN("a dynamic observer is empty"){
+            rx::dynamic_observer<int> empty;
+            empty.on_next(1);
+            empty.on_completed();
+            THEN("nothing is called"){
+                REQUIRE(result == 0);
+            }
+        }
+    }
+}
+
+namespace {
+// an observer that counts in its own member and one that counts through a
+// pointer. both are small enough to be stored in a dynamic_observer. each
+// call records the count that it made.
+struct counting_member_observer : public rx::observer_base<int>
+{
+    explicit counting_member_observer(std::vector<int>* counts) : count(0), counts(counts) {}
+    mutable int count;
+    std::vector<int>* counts;
+    void on_next(int) const {counts->push_back(++count);}
+    void on_error(std::exception_ptr) const {}
+    void on_completed() const {}
+};
+struct counting_shared_observer : public rx::observer_base<int>
+{
+    explicit counting_shared_observer(std::vector<int>* counts) : count(std::make_shared<int>(0)), counts(counts) {}
+    std::shared_ptr<int> count;
+    std::vector<int>* counts;
+    void on_next(int) const {counts->push_back(++*count);}
+    void on_error(std::exception_ptr) const {}
+    void on_completed() const {}
+};
+}
+
+SCENARIO("copies of a dynamic_observer", "[observer]"){
+    GIVEN("dynamic observers erasing observers that count the values"){
+        std::vector<int> counts;
+        WHEN("an observer that counts in its own member is copied"){
+            auto original = rx::dynamic_observer<int>(counting_member_observer(&counts));
+            original.on_next(1);
+            auto copy = original;
+            original.on_next(1);
+            copy.on_next(1);
+            copy.on_next(1);
+            THEN("each copy goes on from the count it was copied with, as a copied static observer does"){
+                REQUIRE((counts == std::vector<int>{1, 2, 2, 3}));
+
+                counts.clear();
+                auto so = rx::observer<int, counting_member_observer>(counting_member_observer(&counts));
+                so.on_next(1);
+                auto socopy = so;
+                so.on_next(1);
+                socopy.on_next(1);
+                socopy.on_next(1);
+                REQUIRE((counts == std::vector<int>{1, 2, 2, 3}));
+            }
+        }
+        WHEN("an observer that counts through a pointer is copied"){
+            auto original = rx::dynamic_observer<int>(counting_shared_observer(&counts));
+            original.on_next(1);
+            auto copy = original;
+            original.on_next(1);
+            copy.on_next(1);
+            copy.on_next(1);
+            THEN("every copy adds to the same count"){
+                REQUIRE((counts == std::vector<int>{1, 2, 3, 4}));
+            }
+        }
+    }
+}
+
+SCENARIO("noexcept on_next is detected through the observer types", "[observer][noexcept]"){
+    GIVEN("observers with and without noexcept on_next"){
+        int result = 0;
+        auto safe = rx::make_observer<int>([&result](int i) noexcept {result += i;});
+        auto unsafe = rx::make_observer<int>([&result](int i){result += i;});
+        auto ranged = rx::make_observer_with_range(safe, [&result](const int* first, size_t count){result += first[0] * static_cast<int>(count);});
+
+        WHEN("tested"){
+            THEN("noexcept is passed through"){
+                REQUIRE((rx::detail::is_nothrow_on_next<decltype(safe), int>::value));
+                REQUIRE(!(rx::detail::is_nothrow_on_next<decltype(unsafe), int>::value));
+                REQUIRE((rx::detail::is_nothrow_on_next<decltype(ranged), int>::value));
+                REQUIRE((rx::detail::is_nothrow_on_next<rx::observer<int, void>, int>::value));
+            }
+        }
+        WHEN("values are sent through subscribers"){
+            rx::make_subscriber<int>(safe).on_next(1);
+            rx::make_subscriber<int>(unsafe).on_next(10);
+            rx::make_subscriber<int>(ranged).on_next(100);
+            THEN("each observer receives its value"){
+                REQUIRE(result == 111);
+            }
+        }
+    }
+    GIVEN("an observer whose on_next may throw"){
+        bool failed = false;
+        auto throwing = rx::make_subscriber<int>(
+            [](int){throw std::runtime_error("on_next");},
+            [&failed](std::exception_ptr){failed = true;});
+        WHEN("a value is sent"){
+            throwing.on_next(1);
+            THEN("the exception is sent to on_error and the subscriber is unsubscribed"){
+                REQUIRE(failed);
+                REQUIRE(!throwing.is_subscribed());
+            }
+        }
+    }
+}
@@ -440,3 +440,161 @@ SCENARIO("subscription composite", "[subscription]"){
     }
 }
 
+
+SCENARIO("subscription composite remove", "[subscription]"){
+    GIVEN("a composite with more children than fit inline"){
+        int i=0;
+        rx::composite_subscription s;
+        std::vector<rx::composite_subscription::weak_subscription> tokens;
+        for (int n = 0; n < 8; ++n) {
+            tokens.push_back(s.add([&i](){++i;}));
+        }
+        WHEN("children are removed in a different order than added"){
+            s.remove(tokens[0]);
+            s.remove(tokens[5]);
+            s.remove(tokens[7]);
+            s.remove(tokens[0]);
+            THEN("only the remaining children are unsubscribed"){
+                s.unsubscribe();
+                REQUIRE(i == 5);
+            }
+        }
+        WHEN("all children are removed"){
+            for (auto& t : tokens) {
+                s.remove(t);
+            }
+            THEN("no child is unsubscribed"){
+                s.unsubscribe();
+                REQUIRE(i == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("subscription composite add races unsubscribe", "[subscription]"){
+    GIVEN("threads that add children while another thread unsubscribes"){
+        const int adders = 4;
+        const int count = 1000;
+        std::atomic<int> added(0);
+        std::atomic<int> unsubscribed(0);
+        rx::composite_subscription s;
+        WHEN("the composite is unsubscribed part way through"){
+            std::vector<std::thread> threads;
+            for (int t = 0; t < adders; ++t) {
+                threads.emplace_back([&](){
+                    for (int n = 0; n < count; ++n) {
+                        ++added;
+                        s.add([&](){++unsubscribed;});
+                    }
+                });
+            }
+            threads.emplace_back([&](){
+                while (added < count) {
+                    std::this_thread::yield();
+                }
+                s.unsubscribe();
+            });
+            for (auto& t : threads) {
+                t.join();
+            }
+            THEN("every child added is unsubscribed"){
+                REQUIRE(unsubscribed == adders * count);
+            }
+        }
+    }
+}
+
+SCENARIO("subscription composite shares one state", "[subscription]"){
+    GIVEN("a composite with a child and a plain subscription copied from it"){
+        int i=0;
+        rx::composite_subscription cs;
+        cs.add([&i](){++i;});
+        rx::subscription s = cs;
+        WHEN("unsubscribed through the plain subscription"){
+            s.unsubscribe();
+            THEN("the composite is unsubscribed and its child is called once"){
+                REQUIRE(!cs.is_subscribed());
+                REQUIRE(i == 1);
+                cs.unsubscribe();
+                REQUIRE(i == 1);
+            }
+            THEN("a child added later is unsubscribed at once"){
+                cs.add([&i](){++i;});
+                REQUIRE(i == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("subscription composite borrow", "[subscription]"){
+    GIVEN("a composite with a child and a copy of a borrowed handle"){
+        int i=0;
+        rx::composite_subscription copy;
+        {
+            rx::composite_subscription cs;
+            cs.add([&i](){++i;});
+            auto borrowed = cs.borrow();
+            copy = borrowed;
+        }
+        WHEN("the owner is released"){
+            THEN("the copy keeps the subscription"){
+                REQUIRE(copy.is_subscribed());
+                REQUIRE(i == 0);
+                copy.unsubscribe();
+                REQUIRE(i == 1);
+            }
+        }
+    }
+    GIVEN("a subscriber through map and filter"){
+        int i=0;
+        rx::composite_subscription cs;
+        cs.add([&i](){++i;});
+        auto values = std::make_shared<std::vector<int>>();
+        auto subject = rx::subjects::subject<int>();
+        subject.get_observable()
+            .map([](int v){return v * 2;})
+            .filter([](int v){return v % 4 == 0;})
+            .subscribe(cs, [values](int v){values->push_back(v);});
+        WHEN("values are sent and the subscription is unsubscribed"){
+            auto o = subject.get_subscriber();
+            o.on_next(1);
+            o.on_next(2);
+            cs.unsubscribe();
+            o.on_next(4);
+            THEN("the values before the unsubscribe are received"){
+                REQUIRE(*values == std::vector<int>({4}));
+                REQUIRE(i == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("trace ids are unique across threads", "[trace][subscriber]"){
+    GIVEN("4 threads that each take 10000 ids"){
+        std::vector<std::vector<unsigned long>> ids(4);
+        std::vector<std::thread> threads;
+        for (auto& mine : ids) {
+            threads.emplace_back([&mine](){
+                for (int i = 0; i != 10000; ++i) {
+                    mine.push_back(rx::detail::trace_id_block::next());
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        WHEN("the ids are compared"){
+            std::vector<unsigned long> all;
+            bool increasing = true;
+            for (auto& mine : ids) {
+                increasing = increasing && std::is_sorted(mine.begin(), mine.end());
+                all.insert(all.end(), mine.begin(), mine.end());
+            }
+            std::sort(all.begin(), all.end());
+            THEN("the ids of each thread increase and no id is taken twice"){
+                REQUIRE(increasing);
+                REQUIRE(std::unique(all.begin(), all.end()) == all.end());
+            }
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-trace_metrics.hpp"
+
+#include <sstream>
+
+#include "catch.hpp"
+
+// the tests call the hooks of their own trace_metrics, the tracer of this
+// program stays trace_noop
+
+SCENARIO("trace_histogram buckets hold their values", "[trace][metrics]"){
+    GIVEN("values across the range"){
+        WHEN("each is placed in a bucket"){
+            THEN("the bucket bounds contain the value"){
+                for (std::uint64_t v : {std::uint64_t(0), std::uint64_t(1), std::uint64_t(7), std::uint64_t(8), std::uint64_t(15), std::uint64_t(16),
+                                        std::uint64_t(1000), std::uint64_t(123456789), ~std::uint64_t(0)}) {
+                    auto i = rx::trace_histogram::index(v);
+                    REQUIRE(i < int(rx::trace_histogram::bucket_count));
+                    REQUIRE(rx::trace_histogram::lowest(i) <= v);
+                    REQUIRE(v <= rx::trace_histogram::highest(i));
+                }
+            }
+            THEN("the buckets do not overlap"){
+                for (int i = 1; i < int(rx::trace_histogram::bucket_count); ++i) {
+                    REQUIRE(rx::trace_histogram::highest(i - 1) + 1 == rx::trace_histogram::lowest(i));
+                }
+            }
+        }
+        WHEN("1 to 1000 are recorded"){
+            rx::trace_histogram h;
+            for (std::uint64_t v = 1; v <= 1000; ++v) {
+                h.record(v);
+            }
+            THEN("the quantiles are within the bucket precision"){
+                REQUIRE(h.count() == 1000);
+                REQUIRE(h.max() == 1000);
+                auto median = h.value_at(0.5);
+                REQUIRE(median >= 500);
+                REQUIRE(median <= 500 + 500 / 8);
+                REQUIRE(h.value_at(1.0) == 1000);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_metrics counts the hooks", "[trace][metrics]"){
+    GIVEN("a trace_metrics that times every call"){
+        rx::trace_metrics metrics;
+        metrics.set_sample_period(1);
+        WHEN("nested on_next calls are traced"){
+            int subscriber = 0;
+            metrics.on_next_enter(subscriber, 1);
+            metrics.on_next_enter(subscriber, 1);
+            metrics.on_next_return(subscriber);
+            metrics.on_next_return(subscriber);
+            metrics.on_completed_enter(subscriber);
+            metrics.on_completed_return(subscriber);
+            THEN("each call is counted and timed"){
+                auto s = metrics.snapshot();
+                REQUIRE(s.threads == 1);
+                REQUIRE(s.on_next == 2);
+                REQUIRE(s.on_completed == 1);
+                REQUIRE(s.on_error == 0);
+                REQUIRE(s.on_next_latency.count() == 2);
+            }
+        }
+        WHEN("a sample period is set"){
+            metrics.set_sample_period(5);
+            THEN("it is rounded up to a power of two"){
+                REQUIRE(metrics.sample_period() == 8);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_metrics times the wait for a scheduled action", "[trace][metrics]"){
+    GIVEN("a trace_metrics that times every call"){
+        rx::trace_metrics metrics;
+        metrics.set_sample_period(1);
+        auto w = rxsc::make_current_thread().create_worker();
+        auto scbl = rxsc::make_schedulable(w, [](const rxsc::schedulable&){});
+        WHEN("an action starts 2ms after it is scheduled"){
+            metrics.schedule_enter(w, scbl);
+            metrics.schedule_return(w);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            metrics.action_enter(scbl);
+            metrics.action_recurse(scbl);
+            metrics.action_return(scbl);
+            THEN("the wait is recorded once"){
+                auto s = metrics.snapshot();
+                REQUIRE(s.schedule == 1);
+                REQUIRE(s.action == 1);
+                REQUIRE(s.action_recurse == 1);
+                REQUIRE(s.queue_wait.count() == 1);
+                REQUIRE(s.queue_wait.max() >= 2000000);
+                REQUIRE(s.action_run_time.count() == 2);
+            }
+        }
+        WHEN("an action starts without being scheduled"){
+            metrics.action_enter(scbl);
+            metrics.action_return(scbl);
+            THEN("no wait is recorded"){
+                REQUIRE(metrics.snapshot().queue_wait.count() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_metrics keeps the counts of threads that exit", "[trace][metrics]"){
+    GIVEN("a trace_metrics"){
+        rx::trace_metrics metrics;
+        WHEN("four threads send values and exit"){
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&metrics](){
+                    int subscriber = 0;
+                    for (int i = 0; i < 1000; ++i) {
+                        metrics.on_next_enter(subscriber, i);
+                        metrics.on_next_return(subscriber);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            THEN("the snapshot has all the values"){
+                auto s = metrics.snapshot();
+                REQUIRE(s.threads == 4);
+                REQUIRE(s.on_next == 4000);
+                // one in 64 is timed
+                REQUIRE(s.on_next_latency.count() == 4 * (1000 / 64 + 1));
+            }
+            THEN("the snapshot can be written for prometheus"){
+                std::ostringstream out;
+                rx::write_prometheus(out, metrics.snapshot());
+                auto text = out.str();
+                REQUIRE(text.find("rxcpp_on_next_total 4000\n") != std::string::npos);
+                REQUIRE(text.find("rxcpp_on_next_latency_seconds_bucket{le=\"+Inf\"} 64\n") != std::string::npos);
+                REQUIRE(text.find("rxcpp_on_next_latency_seconds_count 64\n") != std::string::npos);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_counters adds up the counts of each thread", "[trace][counters]"){
+    GIVEN("a trace_counters"){
+        rx::trace_counters counters;
+        WHEN("hooks are called on this thread and on a thread that exits"){
+            int subscriber = 0;
+            auto trace = [&](){
+                counters.subscribe_enter(subscriber, subscriber);
+                counters.subscription_add_enter(subscriber, subscriber);
+                counters.on_next_enter(subscriber, 1);
+                counters.on_next_return(subscriber);
+            };
+            trace();
+            std::thread(trace).join();
+            THEN("the snapshot holds the counts of both threads"){
+                auto s = counters.snapshot();
+                REQUIRE(s.threads == 2);
+                REQUIRE(s.subscribe == 2);
+                REQUIRE(s.subscription_add == 2);
+                REQUIRE(s.on_next == 2);
+                REQUIRE(s.overhead() == 4);
+            }
+            THEN("the overhead is given for each emitted value"){
+                auto s = counters.snapshot();
+                REQUIRE(s.overhead_per_value(2) == 2.0);
+                REQUIRE(s.overhead_per_value(0) == 0.0);
+            }
+        }
+    }
+}
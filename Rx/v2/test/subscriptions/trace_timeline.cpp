@@ -0,0 +1,107 @@
+#include "rxcpp/rx.hpp"
+namespace rx=rxcpp;
+namespace rxsc=rxcpp::schedulers;
+
+#include "rxcpp/rx-trace_timeline.hpp"
+
+#include <sstream>
+
+#include "catch.hpp"
+
+// the tests call the hooks of their own trace_timeline, the tracer of this
+// program stays trace_noop
+
+SCENARIO("trace_timeline records the spans of a thread", "[trace][timeline]"){
+    GIVEN("a trace_timeline"){
+        rx::trace_timeline timeline;
+        auto w = rxsc::make_current_thread().create_worker();
+        auto scbl = rxsc::make_schedulable(w, [](const rxsc::schedulable&){});
+        auto o = rx::make_subscriber<int>([](int){});
+        WHEN("an action that sends a value is traced"){
+            timeline.schedule_enter(w, scbl);
+            timeline.schedule_return(w);
+            timeline.action_enter(scbl);
+            timeline.on_next_enter(o, 1);
+            timeline.on_next_return(o);
+            timeline.on_completed_enter(o);
+            timeline.on_completed_return(o);
+            timeline.action_return(scbl);
+            THEN("the events are recorded in order"){
+                auto records = timeline.records();
+                REQUIRE(records.size() == 1);
+                auto& events = records.front();
+                REQUIRE(events.size() == 6);
+                REQUIRE(events[0].kind == rx::detail::timeline_schedule);
+                REQUIRE(events[1].kind == rx::detail::timeline_action_begin);
+                REQUIRE(events[0].id == events[1].id);
+                REQUIRE(events[2].kind == rx::detail::timeline_on_next_begin);
+                REQUIRE(events[2].id == o.get_id().id);
+                REQUIRE(events[5].kind == rx::detail::timeline_action_end);
+                for (size_t i = 1; i < events.size(); ++i) {
+                    REQUIRE(events[i - 1].at <= events[i].at);
+                }
+            }
+            THEN("the chrome trace has the spans and the handoff"){
+                std::ostringstream out;
+                timeline.write_chrome_trace(out);
+                auto text = out.str();
+                REQUIRE(text.find("{\"traceEvents\":[") == 0);
+                REQUIRE(text.find("\"name\":\"thread_name\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"action\",\"cat\":\"rx\",\"ph\":\"B\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"action\",\"cat\":\"rx\",\"ph\":\"E\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"on_next\",\"cat\":\"rx\",\"ph\":\"B\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"handoff\",\"cat\":\"rx\",\"ph\":\"s\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"handoff\",\"cat\":\"rx\",\"ph\":\"f\"") != std::string::npos);
+                REQUIRE(text.find("\"name\":\"on_completed\",\"cat\":\"rx\",\"ph\":\"i\"") != std::string::npos);
+                REQUIRE(text.rfind("]}\n") == text.size() - 3);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_timeline keeps the newest events", "[trace][timeline]"){
+    GIVEN("a trace_timeline with room for 8 events on each thread"){
+        rx::trace_timeline timeline(8);
+        auto o = rx::make_subscriber<int>([](int){});
+        WHEN("10 values are traced"){
+            for (int i = 0; i < 10; ++i) {
+                timeline.on_next_enter(o, i);
+                timeline.on_next_return(o);
+            }
+            THEN("only the last 7 events are kept"){
+                auto records = timeline.records();
+                REQUIRE(records.size() == 1);
+                REQUIRE(records.front().size() == 7);
+                REQUIRE(records.front().front().kind == rx::detail::timeline_on_next_end);
+                REQUIRE(records.front().back().kind == rx::detail::timeline_on_next_end);
+            }
+        }
+    }
+}
+
+SCENARIO("trace_timeline keeps the events of threads that exit", "[trace][timeline]"){
+    GIVEN("a trace_timeline"){
+        rx::trace_timeline timeline;
+        WHEN("two threads send values and exit"){
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 2; ++t) {
+                threads.emplace_back([&timeline](){
+                    auto o = rx::make_subscriber<int>([](int){});
+                    for (int i = 0; i < 100; ++i) {
+                        timeline.on_next_enter(o, i);
+                        timeline.on_next_return(o);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            THEN("each thread has its own events"){
+                auto records = timeline.records();
+                REQUIRE(records.size() == 2);
+                REQUIRE(records[0].size() == 200);
+                REQUIRE(records[1].size() == 200);
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#!/bin/sh
+#
+# compile-bench.sh <c++ compiler> [flags...]
+#
+# compiles each file in Rx/v2/benchmark/compile and prints, as csv, the
+# seconds that it took, the size of the object and the number and total
+# length of its symbols. the mangled names of long operator chains are the
+# bulk of the symbols.
+#
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+CXX=${1:-c++}
+[ $# -gt 0 ] && shift
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+echo "file,seconds,object_bytes,symbols,symbol_bytes"
+for f in "$ROOT"/Rx/v2/benchmark/compile/*.cpp; do
+    name=$(basename "$f" .cpp)
+    start=$(date +%s.%N)
+    "$CXX" -std=c++11 -I"$ROOT/Rx/v2/src" -I"$ROOT/Ix/CPP/src" "$@" -c "$f" -o "$OUT/$name.o"
+    end=$(date +%s.%N)
+    bytes=$(wc -c < "$OUT/$name.o" | tr -d ' ')
+    symbols=$(nm -P "$OUT/$name.o" | awk '{n += 1; s += length($1)} END {print n "," s}')
+    seconds=$(awk "BEGIN {printf \"%.2f\", $end - $start}")
+    echo "$name,$seconds,$bytes,$symbols"
+done